@@ -358,7 +358,7 @@ Kentec320x240x16_SSD2119PixelDraw(void *pvDisplayData, int32_t i32X,
 //! \param i32X0 is sub-pixel offset within the pixel data, which is valid for
 //! 1 or 4 bit per pixel formats.
 //! \param i32Count is the number of pixels to draw.
-//! \param i32BPP is the number of bits per pixel; must be 1, 4, or 8.
+//! \param i32BPP is the number of bits per pixel; must be 1, 4, 8, 16 or 24.
 //! \param pui8Data is a pointer to the pixel data.  For 1 and 4 bit per pixel
 //! formats, the most significant bit(s) represent the left-most pixel.
 //! \param pui8Palette is a pointer to the palette used to draw the pixels.
@@ -551,6 +551,52 @@ Kentec320x240x16_SSD2119PixelDrawMultiple(void *pvDisplayData, int32_t i32X,
             //
             break;
         }
+
+        //
+        // The pixel data is in the native 5-6-5 RGB format.
+        //
+        case 16:
+        {
+            //
+            // Loop while there are more pixels to draw, writing each pixel
+            // to the screen without translation.
+            //
+            while(i32Count--)
+            {
+                WriteData(*(uint16_t *)pui8Data);
+                pui8Data += 2;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 8-8-8 RGB format.
+        //
+        case 24:
+        {
+            //
+            // Loop while there are more pixels to draw.
+            //
+            while(i32Count--)
+            {
+                //
+                // Get the next pixel, translate it and write it to the screen.
+                //
+                ui32Byte = (pui8Data[0] | (pui8Data[1] << 8) |
+                            (pui8Data[2] << 16));
+                WriteData(DPYCOLORTRANSLATE(ui32Byte));
+                pui8Data += 3;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
     }
 }
 
@@ -41,6 +41,8 @@
 //! Draws the contents of a canvas.
 //!
 //! \param psWidget is a pointer to the canvas widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws the contents of a canvas on the display.  This is
 //! called in response to a \b #WIDGET_MSG_PAINT message.
@@ -49,11 +51,13 @@
 //
 //*****************************************************************************
 static void
-CanvasPaint(tWidget *psWidget)
+CanvasPaint(tWidget *psWidget, tRectangle *psClip)
 {
     tCanvasWidget *psCanvas;
     tContext sCtx;
+    tRectangle sRect;
     int32_t i32X, i32Y, i32Size;
+    bool bVisible;
 
     //
     // Check the arguments.
@@ -73,7 +77,7 @@ CanvasPaint(tWidget *psWidget)
     //
     // Initialize the clipping region based on the extents of this canvas.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // See if the canvas fill style is selected.
@@ -115,22 +119,31 @@ CanvasPaint(tWidget *psWidget)
                 psWidget->sPosition.i16YMin + 1) / 2));
 
         //
-        // If the canvas outline style is selected then shrink the clipping
-        // region by one pixel on each side so that the outline is not
-        // overwritten by the text or image.
+        // The text or image is positioned within the extents of the canvas.
+        // If the canvas outline style is selected then shrink this area by
+        // one pixel on each side so that the outline is not overwritten by
+        // the text or image.
         //
+        sRect = psWidget->sPosition;
         if(psCanvas->ui32Style & CANVAS_STYLE_OUTLINE)
         {
-            sCtx.sClipRegion.i16XMin++;
-            sCtx.sClipRegion.i16YMin++;
-            sCtx.sClipRegion.i16XMax--;
-            sCtx.sClipRegion.i16YMax--;
+            sRect.i16XMin++;
+            sRect.i16YMin++;
+            sRect.i16XMax--;
+            sRect.i16YMax--;
         }
 
+        //
+        // Restrict the clipping region to the portion of this area that is
+        // being drawn.  There is no text or image to draw if there is none.
+        //
+        bVisible = GrRectIntersectGet(&sRect, &(sCtx.sClipRegion),
+                                      &(sCtx.sClipRegion)) ? true : false;
+
         //
         // See if the canvas image style is selected.
         //
-        if(psCanvas->ui32Style & CANVAS_STYLE_IMG)
+        if(bVisible && (psCanvas->ui32Style & CANVAS_STYLE_IMG))
         {
             //
             // Set the foreground and background colors to use for 1 BPP
@@ -150,7 +163,7 @@ CanvasPaint(tWidget *psWidget)
         //
         // See if the canvas text style is selected.
         //
-        if(psCanvas->ui32Style & CANVAS_STYLE_TEXT)
+        if(bVisible && (psCanvas->ui32Style & CANVAS_STYLE_TEXT))
         {
             //
             // Set the relevant font and colors.
@@ -174,11 +187,11 @@ CanvasPaint(tWidget *psWidget)
             {
                 //
                 // The string is to be aligned with the left edge of
-                // the widget.  Use the clipping rectangle as reference
-                // since this will ensure that the string doesn't
-                // encroach on any border that is set.
+                // the widget.  Use the text area as reference since this
+                // will ensure that the string doesn't encroach on any
+                // border that is set.
                 //
-                i32X = sCtx.sClipRegion.i16XMin;
+                i32X = sRect.i16XMin;
             }
             else
             {
@@ -186,11 +199,11 @@ CanvasPaint(tWidget *psWidget)
                 {
                     //
                     // The string is to be aligned with the right edge of
-                    // the widget.  Use the clipping rectangle as reference
-                    // since this will ensure that the string doesn't
-                    // encroach on any border that is set.
+                    // the widget.  Use the text area as reference since this
+                    // will ensure that the string doesn't encroach on any
+                    // border that is set.
                     //
-                    i32X = sCtx.sClipRegion.i16XMax - i32Size;
+                    i32X = sRect.i16XMax - i32Size;
                 }
                 else
                 {
@@ -215,11 +228,11 @@ CanvasPaint(tWidget *psWidget)
             {
                 //
                 // The string is to be aligned with the top edge of
-                // the widget.  Use the clipping rectangle as reference
-                // since this will ensure that the string doesn't
-                // encroach on any border that is set.
+                // the widget.  Use the text area as reference since this
+                // will ensure that the string doesn't encroach on any
+                // border that is set.
                 //
-                i32Y = sCtx.sClipRegion.i16YMin;
+                i32Y = sRect.i16YMin;
             }
             else
             {
@@ -227,11 +240,11 @@ CanvasPaint(tWidget *psWidget)
                 {
                     //
                     // The string is to be aligned with the bottom edge of
-                    // the widget.  Use the clipping rectangle as reference
-                    // since this will ensure that the string doesn't
-                    // encroach on any border that is set.
+                    // the widget.  Use the text area as reference since this
+                    // will ensure that the string doesn't encroach on any
+                    // border that is set.
                     //
-                    i32Y = sCtx.sClipRegion.i16YMax - i32Size;
+                    i32Y = sRect.i16YMax - i32Size;
                 }
                 else
                 {
@@ -286,6 +299,8 @@ int32_t
 CanvasMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
               uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -302,9 +317,14 @@ CanvasMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            CanvasPaint(psWidget);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                CanvasPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
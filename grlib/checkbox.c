@@ -43,6 +43,8 @@
 //! \param psWidget is a pointer to the check box widget to be drawn.
 //! \param bClick is a boolean that is \b true if the paint request is a result
 //! of a pointer click and \b false if not.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a check box widget on the display.  This is called in
 //! response to a \b #WIDGET_MSG_PAINT message.
@@ -51,12 +53,14 @@
 //
 //*****************************************************************************
 static void
-CheckBoxPaint(tWidget *psWidget, bool bClick)
+CheckBoxPaint(tWidget *psWidget, bool bClick, tRectangle *psClip)
 {
     tCheckBoxWidget *pCheck;
     tRectangle i16Rect;
     tContext sCtx;
+    tRectangle sRect;
     int32_t i32Y;
+    bool bVisible;
 
     //
     // Check the arguments.
@@ -76,7 +80,7 @@ CheckBoxPaint(tWidget *psWidget, bool bClick)
     //
     // Initialize the clipping region based on the extents of this check box.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // See if the check box fill style is selected.
@@ -144,27 +148,36 @@ CheckBoxPaint(tWidget *psWidget, bool bClick)
     if((pCheck->ui16Style & (CB_STYLE_TEXT | CB_STYLE_IMG)) && !bClick)
     {
         //
-        // Shrink the clipping region by the size of the check box so that it
-        // is not overwritten by further "decorative" portions of the widget.
+        // The text or image is positioned to the right of the check box, so
+        // that it is not overwritten by further "decorative" portions of the
+        // widget.
         //
-        sCtx.sClipRegion.i16XMin += pCheck->ui16BoxSize + 4;
+        sRect = psWidget->sPosition;
+        sRect.i16XMin += pCheck->ui16BoxSize + 4;
 
         //
-        // If the check box outline style is selected then shrink the clipping
-        // region by one pixel on each side so that the outline is not
-        // overwritten by the text or image.
+        // If the check box outline style is selected then shrink this area by
+        // one pixel on each side so that the outline is not overwritten by
+        // the text or image.
         //
         if(pCheck->ui16Style & CB_STYLE_OUTLINE)
         {
-            sCtx.sClipRegion.i16YMin++;
-            sCtx.sClipRegion.i16XMax--;
-            sCtx.sClipRegion.i16YMax--;
+            sRect.i16YMin++;
+            sRect.i16XMax--;
+            sRect.i16YMax--;
         }
 
+        //
+        // Restrict the clipping region to the portion of this area that is
+        // being drawn.  There is no text or image to draw if there is none.
+        //
+        bVisible = GrRectIntersectGet(&sRect, &(sCtx.sClipRegion),
+                                      &(sCtx.sClipRegion)) ? true : false;
+
         //
         // See if the check box image style is selected.
         //
-        if(pCheck->ui16Style & CB_STYLE_IMG)
+        if(bVisible && (pCheck->ui16Style & CB_STYLE_IMG))
         {
             //
             // Determine where along the Y extent of the widget to draw the
@@ -173,14 +186,14 @@ CheckBoxPaint(tWidget *psWidget, bool bClick)
             // it takes less than the Y extent.
             //
             if(GrImageHeightGet(pCheck->pui8Image) >
-               (sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin))
+               (sRect.i16YMax - sRect.i16YMin))
             {
-                i32Y = sCtx.sClipRegion.i16YMin;
+                i32Y = sRect.i16YMin;
             }
             else
             {
-                i32Y = (sCtx.sClipRegion.i16YMin +
-                      ((sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin -
+                i32Y = (sRect.i16YMin +
+                      ((sRect.i16YMax - sRect.i16YMin -
                         GrImageHeightGet(pCheck->pui8Image) + 1) / 2));
             }
 
@@ -194,14 +207,13 @@ CheckBoxPaint(tWidget *psWidget, bool bClick)
             //
             // Draw the image next to the check box.
             //
-            GrImageDraw(&sCtx, pCheck->pui8Image, sCtx.sClipRegion.i16XMin,
-                        i32Y);
+            GrImageDraw(&sCtx, pCheck->pui8Image, sRect.i16XMin, i32Y);
         }
 
         //
         // See if the check box text style is selected.
         //
-        if(pCheck->ui16Style & CB_STYLE_TEXT)
+        if(bVisible && (pCheck->ui16Style & CB_STYLE_TEXT))
         {
             //
             // Determine where along the Y extent of the widget to draw the
@@ -210,14 +222,14 @@ CheckBoxPaint(tWidget *psWidget, bool bClick)
             // it takes less than the Y extent.
             //
             if(GrFontHeightGet(pCheck->psFont) >
-               (sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin))
+               (sRect.i16YMax - sRect.i16YMin))
             {
-                i32Y = sCtx.sClipRegion.i16YMin;
+                i32Y = sRect.i16YMin;
             }
             else
             {
-                i32Y = (sCtx.sClipRegion.i16YMin +
-                      ((sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin -
+                i32Y = (sRect.i16YMin +
+                      ((sRect.i16YMax - sRect.i16YMin -
                         GrFontHeightGet(pCheck->psFont) + 1) / 2));
             }
 
@@ -227,7 +239,7 @@ CheckBoxPaint(tWidget *psWidget, bool bClick)
             GrContextFontSet(&sCtx, pCheck->psFont);
             GrContextForegroundSet(&sCtx, pCheck->ui32TextColor);
             GrContextBackgroundSet(&sCtx, pCheck->ui32FillColor);
-            GrStringDraw(&sCtx, pCheck->pcText, -1, sCtx.sClipRegion.i16XMin,
+            GrStringDraw(&sCtx, pCheck->pcText, -1, sRect.i16XMin,
                          i32Y, pCheck->ui16Style & CB_STYLE_TEXT_OPAQUE);
         }
     }
@@ -290,7 +302,7 @@ CheckBoxClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X, int32_t i32Y)
             //
             // Redraw the check box based on the new selected state.
             //
-            CheckBoxPaint(psWidget, 1);
+            CheckBoxPaint(psWidget, 1, &(psWidget->sPosition));
 
             //
             // If there is an OnChange callback for this widget then call the
@@ -337,6 +349,8 @@ int32_t
 CheckBoxMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
                 uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -353,9 +367,14 @@ CheckBoxMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            CheckBoxPaint(psWidget, 0);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                CheckBoxPaint(psWidget, 0, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
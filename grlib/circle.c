@@ -36,238 +36,282 @@
 
 //*****************************************************************************
 //
-//! Draws a circle.
-//!
-//! \param pContext is a pointer to the drawing context to use.
-//! \param i32X is the X coordinate of the center of the circle.
-//! \param i32Y is the Y coordinate of the center of the circle.
-//! \param i32Radius is the radius of the circle.
-//!
-//! This function draws a circle, utilizing the Bresenham circle drawing
-//! algorithm.  The extent of the circle is from \e i32X - \e i32Radius to
-//! \e i32X + \e i32Radius and \e i32Y - \e i32Radius to \e i32Y +
-//! \e i32Radius, inclusive.
-//!
-//! \return None.
+// The sine of each angle from 0 to 90 degrees, in 2.14 fixed-point format.
+// This is used to find the directions of the ends of an arc.
 //
 //*****************************************************************************
-void
-GrCircleDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
-             int32_t i32Radius)
+static const uint16_t g_pui16Sine[91] =
 {
-    int_fast32_t i32A, i32B, i32D, i32X1, i32Y1;
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563, 2845, 3126, 3406,
+    3686, 3964, 4240, 4516, 4790, 5063, 5334, 5604, 5872, 6138, 6402, 6664,
+    6924, 7182, 7438, 7692, 7943, 8192, 8438, 8682, 8923, 9162, 9397, 9630,
+    9860, 10087, 10311, 10531, 10749, 10963, 11174, 11381, 11585, 11786,
+    11982, 12176, 12365, 12551, 12733, 12911, 13085, 13255, 13421, 13583,
+    13741, 13894, 14044, 14189, 14330, 14466, 14598, 14726, 14849, 14968,
+    15082, 15191, 15296, 15396, 15491, 15582, 15668, 15749, 15826, 15897,
+    15964, 16026, 16083, 16135, 16182, 16225, 16262, 16294, 16322, 16344,
+    16362, 16374, 16382, 16384
+};
 
+//*****************************************************************************
+//
+// The extent of an arc, described by the directions from the center of the
+// circle to the start and the end of the arc.
+//
+//*****************************************************************************
+typedef struct
+{
     //
-    // Check the arguments.
+    // The direction of the start of the arc.
     //
-    ASSERT(pContext);
+    int32_t i32StartX;
+    int32_t i32StartY;
 
     //
-    // Initialize the variables that control the Bresenham circle drawing
-    // algorithm.
+    // The direction of the end of the arc.
     //
-    i32A = 0;
-    i32B = i32Radius;
-    i32D = 3 - (2 * i32Radius);
+    int32_t i32EndX;
+    int32_t i32EndY;
 
     //
-    // Loop until the A delta is greater than the B delta, meaning that the
-    // entire circle has been drawn.
+    // Indicates that the arc sweeps through more than 180 degrees.
     //
-    while(i32A <= i32B)
+    bool bReflex;
+}
+tArcExtent;
+
+//*****************************************************************************
+//
+// Finds the direction of an angle, in degrees clockwise from the positive X
+// axis, as a vector in 2.14 fixed-point format.
+//
+//*****************************************************************************
+static void
+ArcDirectionGet(int32_t i32Angle, int32_t *pi32X, int32_t *pi32Y)
+{
+    //
+    // Reduce the angle to the range 0 to 359 degrees.
+    //
+    i32Angle %= 360;
+    if(i32Angle < 0)
     {
-        //
-        // Determine the row when subtracting the A delta.
-        //
-        i32Y1 = i32Y - i32A;
+        i32Angle += 360;
+    }
 
-        //
-        // See if this row is within the clipping region.
-        //
-        if((i32Y1 >= pContext->sClipRegion.i16YMin) &&
-           (i32Y1 <= pContext->sClipRegion.i16YMax))
-        {
-            //
-            // Determine the column when subtracting the B delta.
-            //
-            i32X1 = i32X - i32B;
+    //
+    // Find the direction by reflecting the angle into the first quadrant.
+    //
+    if(i32Angle < 90)
+    {
+        *pi32X = g_pui16Sine[90 - i32Angle];
+        *pi32Y = g_pui16Sine[i32Angle];
+    }
+    else if(i32Angle < 180)
+    {
+        *pi32X = -(int32_t)g_pui16Sine[i32Angle - 90];
+        *pi32Y = g_pui16Sine[180 - i32Angle];
+    }
+    else if(i32Angle < 270)
+    {
+        *pi32X = -(int32_t)g_pui16Sine[270 - i32Angle];
+        *pi32Y = -(int32_t)g_pui16Sine[i32Angle - 180];
+    }
+    else
+    {
+        *pi32X = g_pui16Sine[i32Angle - 270];
+        *pi32Y = -(int32_t)g_pui16Sine[360 - i32Angle];
+    }
+}
 
-            //
-            // If this column is within the clipping region, then draw a pixel
-            // at that position.
-            //
-            if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-               (i32X1 <= pContext->sClipRegion.i16XMax))
-            {
-                GrPixelDraw(pContext, i32X1, i32Y1);
-            }
+//*****************************************************************************
+//
+// Determines if a point, relative to the center of the circle, lies within
+// the extent of an arc.  The point is clockwise from the start of the arc if
+// the cross product of the start direction and the point is not negative,
+// and counter-clockwise from the end of the arc if the cross product of the
+// point and the end direction is not negative.
+//
+//*****************************************************************************
+static bool
+ArcContains(const tArcExtent *psArc, int32_t i32X, int32_t i32Y)
+{
+    bool bAfterStart, bBeforeEnd;
 
-            //
-            // Determine the column when adding the B delta.
-            //
-            i32X1 = i32X + i32B;
+    bAfterStart = (((psArc->i32StartX * i32Y) -
+                    (psArc->i32StartY * i32X)) >= 0);
+    bBeforeEnd = (((i32X * psArc->i32EndY) - (i32Y * psArc->i32EndX)) >= 0);
 
-            //
-            // If this column is within the clipping region, then draw a pixel
-            // at that position.
-            //
-            if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-               (i32X1 <= pContext->sClipRegion.i16XMax))
-            {
-                GrPixelDraw(pContext, i32X1, i32Y1);
-            }
-        }
+    //
+    // An arc of 180 degrees or less contains the points which are both after
+    // the start and before the end, and a larger arc contains the points
+    // which are either.
+    //
+    if(psArc->bReflex)
+    {
+        return(bAfterStart || bBeforeEnd);
+    }
+    else
+    {
+        return(bAfterStart && bBeforeEnd);
+    }
+}
 
-        //
-        // Determine the row when adding the A delta.
-        //
-        i32Y1 = i32Y + i32A;
+//*****************************************************************************
+//
+// Draws a span of a circle, which is a horizontal or vertical run of points
+// relative to the center of the circle.  If an arc extent is supplied, only
+// the portions of the span which lie within the arc are drawn.
+//
+//*****************************************************************************
+static void
+CircleSpanDraw(const tContext *pContext, const tArcExtent *psArc,
+               int32_t i32X, int32_t i32Y, int32_t i32Fixed, int32_t i32Start,
+               int32_t i32End, bool bVertical)
+{
+    int32_t i32Pos, i32RunStart;
+    bool bInside;
 
-        //
-        // See if this row is within the clipping region, and the A delta is
-        // not zero (otherwise, it will be the same row as when the A delta was
-        // subtracted).
-        //
-        if((i32Y1 >= pContext->sClipRegion.i16YMin) &&
-           (i32Y1 <= pContext->sClipRegion.i16YMax) &&
-           (i32A != 0))
+    //
+    // Split the span into the runs of points which lie within the arc, if
+    // there is one.  Each run is drawn when the first point past its end is
+    // found.
+    //
+    i32RunStart = i32Start;
+    for(i32Pos = i32Start; psArc && (i32Pos <= i32End); i32Pos++)
+    {
+        if(bVertical)
         {
-            //
-            // Determine the column when subtracting the B delta.
-            //
-            i32X1 = i32X - i32B;
+            bInside = ArcContains(psArc, i32Fixed, i32Pos);
+        }
+        else
+        {
+            bInside = ArcContains(psArc, i32Pos, i32Fixed);
+        }
+        if(bInside)
+        {
+            continue;
+        }
 
-            //
-            // If this column is within the clipping region, then draw a pixel
-            // at that position.
-            //
-            if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-               (i32X1 <= pContext->sClipRegion.i16XMax))
-            {
-                GrPixelDraw(pContext, i32X1, i32Y1);
-            }
+        if(i32RunStart < i32Pos)
+        {
+            CircleSpanDraw(pContext, 0, i32X, i32Y, i32Fixed, i32RunStart,
+                           i32Pos - 1, bVertical);
+        }
+        i32RunStart = i32Pos + 1;
+    }
 
-            //
-            // Determine the column when adding the B delta.
-            //
-            i32X1 = i32X + i32B;
+    //
+    // Draw the remainder of the span as a single line.
+    //
+    if(i32RunStart > i32End)
+    {
+        return;
+    }
+    if(bVertical)
+    {
+        GrLineDrawV(pContext, i32X + i32Fixed, i32Y + i32RunStart,
+                    i32Y + i32End);
+    }
+    else
+    {
+        GrLineDrawH(pContext, i32X + i32RunStart, i32X + i32End,
+                    i32Y + i32Fixed);
+    }
+}
 
-            //
-            // If this column is within the clipping region, then draw a pixel
-            // at that position.
-            //
-            if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-               (i32X1 <= pContext->sClipRegion.i16XMax))
-            {
-                GrPixelDraw(pContext, i32X1, i32Y1);
-            }
-        }
+//*****************************************************************************
+//
+// Draws the points of a circle generated while the B delta has a single
+// value and the A delta runs from i32A1 to i32A2.  Reflected into the eight
+// octants of the circle, these are two horizontal spans above and two below
+// the center, and two vertical spans to each side of it.
+//
+//*****************************************************************************
+static void
+CircleRunDraw(const tContext *pContext, const tArcExtent *psArc, int32_t i32X,
+              int32_t i32Y, int32_t i32A1, int32_t i32A2, int32_t i32B)
+{
+    int32_t i32Fixed;
 
+    //
+    // Draw the spans on each side of the center.  If the B delta is zero, the
+    // two sides are the same and the vertical spans describe the same points
+    // as the horizontal spans, so they are only drawn once.
+    //
+    for(i32Fixed = -i32B; i32Fixed <= i32B; i32Fixed += 2 * i32B)
+    {
         //
-        // Only draw the complementary pixels if the A and B deltas are
-        // different (otherwise, they describe the same set of pixels).
+        // If the run starts at zero, the spans on each side of the axis meet
+        // and are drawn as a single span.
         //
-        if(i32A != i32B)
+        if(i32A1 == 0)
         {
-            //
-            // Determine the row when subtracting the B delta.
-            //
-            i32Y1 = i32Y - i32B;
-
-            //
-            // See if this row is within the clipping region.
-            //
-            if((i32Y1 >= pContext->sClipRegion.i16YMin) &&
-               (i32Y1 <= pContext->sClipRegion.i16YMax))
+            CircleSpanDraw(pContext, psArc, i32X, i32Y, i32Fixed, -i32A2,
+                           i32A2, false);
+            if(i32B != 0)
             {
-                //
-                // Determine the column when subtracting the a delta.
-                //
-                i32X1 = i32X - i32A;
-
-                //
-                // If this column is within the clipping region, then draw a
-                // pixel at that position.
-                //
-                if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-                   (i32X1 <= pContext->sClipRegion.i16XMax))
-                {
-                    GrPixelDraw(pContext, i32X1, i32Y1);
-                }
-
-                //
-                // Only draw the mirrored pixel if the A delta is non-zero
-                // (otherwise, it will be the same pixel).
-                //
-                if(i32A != 0)
-                {
-                    //
-                    // Determine the column when adding the A delta.
-                    //
-                    i32X1 = i32X + i32A;
-
-                    //
-                    // If this column is within the clipping region, then draw
-                    // a pixel at that position.
-                    //
-                    if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-                       (i32X1 <= pContext->sClipRegion.i16XMax))
-                    {
-                        GrPixelDraw(pContext, i32X1, i32Y1);
-                    }
-                }
+                CircleSpanDraw(pContext, psArc, i32X, i32Y, i32Fixed, -i32A2,
+                               i32A2, true);
             }
+        }
+        else
+        {
+            CircleSpanDraw(pContext, psArc, i32X, i32Y, i32Fixed, -i32A2,
+                           -i32A1, false);
+            CircleSpanDraw(pContext, psArc, i32X, i32Y, i32Fixed, i32A1,
+                           i32A2, false);
+            CircleSpanDraw(pContext, psArc, i32X, i32Y, i32Fixed, -i32A2,
+                           -i32A1, true);
+            CircleSpanDraw(pContext, psArc, i32X, i32Y, i32Fixed, i32A1,
+                           i32A2, true);
+        }
 
-            //
-            // Determine the row when adding the B delta.
-            //
-            i32Y1 = i32Y + i32B;
+        if(i32B == 0)
+        {
+            break;
+        }
+    }
+}
 
-            //
-            // See if this row is within the clipping region.
-            //
-            if((i32Y1 >= pContext->sClipRegion.i16YMin) &&
-               (i32Y1 <= pContext->sClipRegion.i16YMax))
-            {
-                //
-                // Determine the column when subtracting the A delta.
-                //
-                i32X1 = i32X - i32A;
+//*****************************************************************************
+//
+// Draws the outline of a circle, or of the portion of it within an arc
+// extent, using the Bresenham circle drawing algorithm.
+//
+//*****************************************************************************
+static void
+CircleOutlineDraw(const tContext *pContext, const tArcExtent *psArc,
+                  int32_t i32X, int32_t i32Y, int32_t i32Radius)
+{
+    int_fast32_t i32A, i32A1, i32B, i32D;
 
-                //
-                // If this column is within the clipping region, then draw a
-                // pixel at that position.
-                //
-                if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-                   (i32X1 <= pContext->sClipRegion.i16XMax))
-                {
-                    GrPixelDraw(pContext, i32X1, i32Y1);
-                }
+    //
+    // Return without drawing anything if the circle lies entirely outside
+    // the clipping region.
+    //
+    if(((i32X + i32Radius) < pContext->sClipRegion.i16XMin) ||
+       ((i32X - i32Radius) > pContext->sClipRegion.i16XMax) ||
+       ((i32Y + i32Radius) < pContext->sClipRegion.i16YMin) ||
+       ((i32Y - i32Radius) > pContext->sClipRegion.i16YMax))
+    {
+        return;
+    }
 
-                //
-                // Only draw the mirrored pixel if the A delta is non-zero
-                // (otherwise, it will be the same pixel).
-                //
-                if(i32A != 0)
-                {
-                    //
-                    // Determine the column when adding the A delta.
-                    //
-                    i32X1 = i32X + i32A;
-
-                    //
-                    // If this column is within the clipping region, then draw
-                    // a pixel at that position.
-                    //
-                    if((i32X1 >= pContext->sClipRegion.i16XMin) &&
-                       (i32X1 <= pContext->sClipRegion.i16XMax))
-                    {
-                        GrPixelDraw(pContext, i32X1, i32Y1);
-                    }
-                }
-            }
-        }
+    //
+    // Initialize the variables that control the Bresenham circle drawing
+    // algorithm.
+    //
+    i32A = 0;
+    i32A1 = 0;
+    i32B = i32Radius;
+    i32D = 3 - (2 * i32Radius);
 
+    //
+    // Loop until the A delta is greater than the B delta, meaning that the
+    // entire circle has been drawn.
+    //
+    while(i32A <= i32B)
+    {
         //
         // See if the error term is negative.
         //
@@ -287,6 +331,13 @@ GrCircleDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
             //
             i32D += (4 * (i32A - i32B)) + 10;
 
+            //
+            // The B delta is about to change, so draw the run of points which
+            // share the current B delta.
+            //
+            CircleRunDraw(pContext, psArc, i32X, i32Y, i32A1, i32A, i32B);
+            i32A1 = i32A + 1;
+
             //
             // Decrement the B delta.
             //
@@ -298,6 +349,48 @@ GrCircleDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
         //
         i32A++;
     }
+
+    //
+    // Draw the final run of points, if there is one.
+    //
+    if(i32A1 < i32A)
+    {
+        CircleRunDraw(pContext, psArc, i32X, i32Y, i32A1, i32A - 1, i32B);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a circle.
+//!
+//! \param pContext is a pointer to the drawing context to use.
+//! \param i32X is the X coordinate of the center of the circle.
+//! \param i32Y is the Y coordinate of the center of the circle.
+//! \param i32Radius is the radius of the circle.
+//!
+//! This function draws a circle, utilizing the Bresenham circle drawing
+//! algorithm.  The extent of the circle is from \e i32X - \e i32Radius to
+//! \e i32X + \e i32Radius and \e i32Y - \e i32Radius to \e i32Y +
+//! \e i32Radius, inclusive.  Points which lie in the same row or column are
+//! gathered into horizontal or vertical lines, so that the display driver is
+//! called once per run of points rather than once per point.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrCircleDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
+             int32_t i32Radius)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pContext);
+
+    //
+    // Draw the entire outline of the circle.
+    //
+    CircleOutlineDraw(pContext, 0, i32X, i32Y, i32Radius);
 }
 
 //*****************************************************************************
@@ -556,6 +649,78 @@ GrCircleFill(const tContext *pContext, int32_t i32X, int32_t i32Y,
     }
 }
 
+//*****************************************************************************
+//
+//! Draws an arc.
+//!
+//! \param pContext is a pointer to the drawing context to use.
+//! \param i32X is the X coordinate of the center of the arc.
+//! \param i32Y is the Y coordinate of the center of the arc.
+//! \param i32Radius is the radius of the arc.
+//! \param i32StartAngle is the angle of the start of the arc.
+//! \param i32EndAngle is the angle of the end of the arc.
+//!
+//! This function draws the portion of the circle drawn by GrCircleDraw()
+//! which runs clockwise from \e i32StartAngle to \e i32EndAngle.  Angles are
+//! in degrees, measured clockwise from the positive X axis to match the
+//! direction of the Y axis of the display; an angle of 0 is to the right of
+//! the center and an angle of 90 is below it.  If \e i32EndAngle is less
+//! than \e i32StartAngle, the arc passes through 0 degrees.  If
+//! \e i32EndAngle is 360 or more degrees past \e i32StartAngle, the entire
+//! circle is drawn, and if they are equal, nothing is drawn.
+//!
+//! As with GrCircleDraw(), the points of the arc are drawn as horizontal and
+//! vertical runs.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrArcDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
+          int32_t i32Radius, int32_t i32StartAngle, int32_t i32EndAngle)
+{
+    tArcExtent sArc;
+    int32_t i32Sweep;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pContext);
+
+    //
+    // Draw the entire circle if the arc covers all of it.
+    //
+    i32Sweep = i32EndAngle - i32StartAngle;
+    if(i32Sweep >= 360)
+    {
+        CircleOutlineDraw(pContext, 0, i32X, i32Y, i32Radius);
+        return;
+    }
+
+    //
+    // Reduce the angle swept by the arc to the range 0 to 359 degrees, and
+    // return without drawing anything if it is empty.
+    //
+    i32Sweep %= 360;
+    if(i32Sweep < 0)
+    {
+        i32Sweep += 360;
+    }
+    if(i32Sweep == 0)
+    {
+        return;
+    }
+
+    //
+    // Find the directions of the ends of the arc, and draw the portion of the
+    // circle that lies between them.
+    //
+    ArcDirectionGet(i32StartAngle, &sArc.i32StartX, &sArc.i32StartY);
+    ArcDirectionGet(i32EndAngle, &sArc.i32EndX, &sArc.i32EndY);
+    sArc.bReflex = (i32Sweep > 180) ? true : false;
+    CircleOutlineDraw(pContext, &sArc, i32X, i32Y, i32Radius);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -0,0 +1,237 @@
+//*****************************************************************************
+//
+// colorcache.c - Cache of translated display colors.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The value used to mark an unused cache entry.  This is not a 24-bit RGB
+// color, so a color with this value is translated without using the cache.
+//
+//*****************************************************************************
+#define COLOR_CACHE_EMPTY       0xffffffff
+
+//*****************************************************************************
+//
+// Returns the cache entry which holds the given color, if it is cached.  The
+// color is multiplied by a large odd constant so that the red, green, and
+// blue channels all contribute to the most significant bits, as many of
+// which as are needed to number the entries select the entry.
+//
+//*****************************************************************************
+#define ColorHash(psCache, ui32Value)                                         \
+        (((ui32Value) * 0x9e3779b1) >> (psCache)->ui32Shift)
+
+//*****************************************************************************
+//
+//! Removes all colors from a color cache.
+//!
+//! \param psCache is a pointer to the color cache.
+//!
+//! This function empties a color cache.  It is called automatically when the
+//! palette of a palette based off-screen display is changed with
+//! GrOffScreen4BPPPaletteSet() or GrOffScreen8BPPPaletteSet(), and must be
+//! called by the application if it changes the way that a display translates
+//! colors by any other means (for example, by writing to the palette of an
+//! off-screen buffer directly).
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrColorCacheFlush(tColorCache *psCache)
+{
+    uint32_t ui32Idx;
+
+    ASSERT(psCache);
+
+    for(ui32Idx = 0; ui32Idx < psCache->ui32NumEntries; ui32Idx++)
+    {
+        psCache->psEntries[ui32Idx].ui32Color = COLOR_CACHE_EMPTY;
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes a color cache.
+//!
+//! \param psCache is a pointer to the color cache to initialize.
+//! \param psEntries is a pointer to the array which holds the entries of the
+//! cache.
+//! \param ui32NumEntries is the number of entries in \e psEntries, which must
+//! be a power of two and at least two.
+//!
+//! This function initializes an empty color cache, which may then be attached
+//! to a display with GrDisplayColorCacheSet().  A color cache must only be
+//! attached to one display at a time.  Each entry holds a single color; a
+//! color which is translated replaces the color held by the entry it maps
+//! to, so the cache should have several entries for each color in regular
+//! use.  Sixteen entries suffice for a typical set of widgets.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrColorCacheInit(tColorCache *psCache, tColorCacheEntry *psEntries,
+                 uint32_t ui32NumEntries)
+{
+    uint32_t ui32Shift;
+
+    ASSERT(psCache);
+    ASSERT(psEntries);
+    ASSERT(ui32NumEntries >= 2);
+    ASSERT((ui32NumEntries & (ui32NumEntries - 1)) == 0);
+
+    //
+    // Find the shift which leaves as many bits of the hash as are needed to
+    // number the entries.
+    //
+    for(ui32Shift = 32; (1 << (32 - ui32Shift)) < ui32NumEntries; ui32Shift--)
+    {
+    }
+
+    psCache->psEntries = psEntries;
+    psCache->ui32NumEntries = ui32NumEntries;
+    psCache->ui32Shift = ui32Shift;
+    psCache->ui32Hits = 0;
+    psCache->ui32Misses = 0;
+
+    GrColorCacheFlush(psCache);
+}
+
+//*****************************************************************************
+//
+//! Sets the color cache used by a display.
+//!
+//! \param psDisplay is a pointer to the display.
+//! \param psCache is a pointer to the color cache, or 0 to stop caching the
+//! colors translated by the display.
+//!
+//! This function attaches a color cache to a display, after which the colors
+//! translated by DpyColorTranslate() (and therefore those set with
+//! GrContextForegroundSet() and GrContextBackgroundSet()) are looked up in the
+//! cache before being passed to the display driver.  This is worthwhile for
+//! displays whose color translation is expensive, such as the 4 BPP and 8 BPP
+//! off-screen displays, which search their palette for the closest match to
+//! each color; displays which translate colors with a few shifts do not
+//! benefit.
+//!
+//! The display must be initialized before the cache is attached, since the
+//! off-screen display initialization functions detach any color cache.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrDisplayColorCacheSet(tDisplay *psDisplay, tColorCache *psCache)
+{
+    ASSERT(psDisplay);
+
+    psDisplay->psColorCache = psCache;
+
+    //
+    // The cache may hold colors translated by a different display.
+    //
+    if(psCache)
+    {
+        GrColorCacheFlush(psCache);
+    }
+}
+
+//*****************************************************************************
+//
+//! Translates a color using the color cache of a display.
+//!
+//! \param psDisplay is a pointer to the display, which must have a color
+//! cache.
+//! \param ui32Value is the 24-bit RGB color.
+//!
+//! This function returns the display driver-specific color for a 24-bit RGB
+//! color from the display's color cache, calling the display driver to
+//! translate the color (and replacing the entry previously holding a color
+//! with the same hash) if it is not in the cache.  It is called by
+//! DpyColorTranslate() and is not normally called by applications.
+//!
+//! \return Returns the display driver-specific color.
+//
+//*****************************************************************************
+uint32_t
+GrColorCacheTranslate(const tDisplay *psDisplay, uint32_t ui32Value)
+{
+    tColorCache *psCache;
+    tColorCacheEntry *psEntry;
+
+    ASSERT(psDisplay);
+    ASSERT(psDisplay->psColorCache);
+
+    psCache = psDisplay->psColorCache;
+
+    //
+    // A color which cannot be distinguished from an unused entry is never
+    // cached.
+    //
+    if(ui32Value == COLOR_CACHE_EMPTY)
+    {
+        return(psDisplay->pfnColorTranslate(psDisplay->pvDisplayData,
+                                            ui32Value));
+    }
+
+    //
+    // Return the translated color if it is in the cache.
+    //
+    psEntry = &psCache->psEntries[ColorHash(psCache, ui32Value)];
+    if(psEntry->ui32Color == ui32Value)
+    {
+        psCache->ui32Hits++;
+        return(psEntry->ui32Value);
+    }
+
+    //
+    // Otherwise, have the display driver translate the color and save it in
+    // the entry, replacing any color which was there.
+    //
+    psCache->ui32Misses++;
+    psEntry->ui32Color = ui32Value;
+    psEntry->ui32Value =
+        psDisplay->pfnColorTranslate(psDisplay->pvDisplayData, ui32Value);
+
+    return(psEntry->ui32Value);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -41,6 +41,8 @@
 //! Draws a container widget.
 //!
 //! \param psWidget is a pointer to the container widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a container widget on the display.  This is called in
 //! response to a \b #WIDGET_MSG_PAINT message.
@@ -49,7 +51,7 @@
 //
 //*****************************************************************************
 static void
-ContainerPaint(tWidget *psWidget)
+ContainerPaint(tWidget *psWidget, tRectangle *psClip)
 {
     tContainerWidget *pContainer;
     int32_t i32X1, i32X2, i32Y;
@@ -73,7 +75,7 @@ ContainerPaint(tWidget *psWidget)
     //
     // Initialize the clipping region based on the extents of this container.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // See if the container fill style is selected.
@@ -201,6 +203,8 @@ int32_t
 ContainerMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
                  uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -217,9 +221,14 @@ ContainerMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            ContainerPaint(psWidget);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                ContainerPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
@@ -66,8 +66,8 @@ const tCodePointMap g_psDefaultCodePointMapTable[] =
 //! This function allows an application to set global default values that the
 //! graphics library will use when initializing any graphics context.  These
 //! values set the source text codepage, the rendering function to use for
-//! strings and mapping functions used to allow extraction of the correct
-//! glyphs from fonts.
+//! strings, mapping functions used to allow extraction of the correct glyphs
+//! from fonts and the glyph cache used when rendering strings.
 //!
 //! If this function is not called by an application, the graphics library
 //! assumes that text strings are ISO8859-1 encoded and that the default string
@@ -138,6 +138,8 @@ GrContextInit(tContext *psContext, const tDisplay *psDisplay)
     //
     psContext->ui32Foreground = 0;
     psContext->ui32Background = 0;
+    psContext->ui32ForegroundRGB = 0;
+    psContext->ui32BackgroundRGB = 0;
     psContext->psFont = 0;
 
 #ifndef GRLIB_REMOVE_WIDE_FONT_SUPPORT
@@ -151,6 +153,8 @@ GrContextInit(tContext *psContext, const tDisplay *psDisplay)
         psContext->ui16Codepage = g_psGrLibDefaults->ui16Codepage;
         psContext->ui8NumCodePointMaps = g_psGrLibDefaults->ui8NumCodePointMaps;
         psContext->ui8Reserved = g_psGrLibDefaults->ui8Reserved;
+        psContext->psGlyphCache = g_psGrLibDefaults->psGlyphCache;
+        psContext->psFontIndex = g_psGrLibDefaults->psFontIndex;
     }
     else
     {
@@ -159,6 +163,8 @@ GrContextInit(tContext *psContext, const tDisplay *psDisplay)
         psContext->ui16Codepage = CODEPAGE_ISO8859_1;
         psContext->ui8NumCodePointMaps = NUM_DEFAULT_CODEPOINT_MAPS;
         psContext->ui8Reserved = 0;
+        psContext->psGlyphCache = 0;
+        psContext->psFontIndex = 0;
     }
     psContext->ui8CodePointMap = 0;
 #endif
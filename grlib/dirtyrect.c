@@ -0,0 +1,677 @@
+//*****************************************************************************
+//
+// dirtyrect.c - Display driver wrapper that tracks damaged screen regions.
+//
+// Copyright (c) 2008-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+//
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+//
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Make sure min and max are defined.
+//
+//*****************************************************************************
+#ifndef min
+#define min(a, b)               (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef max
+#define max(a, b)               (((a) < (b)) ? (b) : (a))
+#endif
+
+//*****************************************************************************
+//
+// Computes the number of pixels contained in a rectangle.
+//
+//*****************************************************************************
+#define RectArea(psRect)                                                      \
+        (((psRect)->i16XMax - (psRect)->i16XMin + 1) *                        \
+         ((psRect)->i16YMax - (psRect)->i16YMin + 1))
+
+//*****************************************************************************
+//
+// Adds a damaged region to the list held by the dirty display.  Regions which
+// overlap or touch an existing region are merged with it.  If the list is full
+// the new region is merged with whichever existing region grows the least as a
+// result.  Returns the number of pixels in the region.
+//
+//*****************************************************************************
+static uint32_t
+DirtyRectAdd(tDirtyDisplay *psDirty, int32_t i32XMin, int32_t i32YMin,
+             int32_t i32XMax, int32_t i32YMax)
+{
+    tRectangle sRect, *psRect;
+    uint32_t ui32Idx, ui32Best;
+    int32_t i32Growth, i32BestGrowth, i32Area;
+
+    //
+    // Ignore empty regions, which can be passed to the driver when a span is
+    // entirely clipped.
+    //
+    if((i32XMin > i32XMax) || (i32YMin > i32YMax))
+    {
+        return(0);
+    }
+
+    sRect.i16XMin = i32XMin;
+    sRect.i16YMin = i32YMin;
+    sRect.i16XMax = i32XMax;
+    sRect.i16YMax = i32YMax;
+
+    //
+    // Loop until the new region has been stored.  Each pass either stores the
+    // region or merges it with (and removes) an existing region, so this loop
+    // runs at most ui32MaxDirty + 1 times.
+    //
+    while(1)
+    {
+        //
+        // Look for an existing region that overlaps or touches the new one.
+        //
+        for(ui32Idx = 0; ui32Idx < psDirty->ui32NumDirty; ui32Idx++)
+        {
+            psRect = &psDirty->psDirtyRects[ui32Idx];
+            if((sRect.i16XMin <= (psRect->i16XMax + 1)) &&
+               ((sRect.i16XMax + 1) >= psRect->i16XMin) &&
+               (sRect.i16YMin <= (psRect->i16YMax + 1)) &&
+               ((sRect.i16YMax + 1) >= psRect->i16YMin))
+            {
+                break;
+            }
+        }
+
+        //
+        // See if no neighboring region was found.
+        //
+        if(ui32Idx == psDirty->ui32NumDirty)
+        {
+            //
+            // If there is space in the list, simply add the new region.
+            //
+            if(psDirty->ui32NumDirty < psDirty->ui32MaxDirty)
+            {
+                psDirty->psDirtyRects[psDirty->ui32NumDirty++] = sRect;
+                return((i32XMax - i32XMin + 1) * (i32YMax - i32YMin + 1));
+            }
+
+            //
+            // The list is full, so find the region whose area grows the least
+            // when the new region is merged into it.
+            //
+            ui32Best = 0;
+            i32BestGrowth = 0x7fffffff;
+            for(ui32Idx = 0; ui32Idx < psDirty->ui32NumDirty; ui32Idx++)
+            {
+                psRect = &psDirty->psDirtyRects[ui32Idx];
+                i32Area = RectArea(psRect);
+                i32Growth = (((max(psRect->i16XMax, sRect.i16XMax) -
+                               min(psRect->i16XMin, sRect.i16XMin)) + 1) *
+                             ((max(psRect->i16YMax, sRect.i16YMax) -
+                               min(psRect->i16YMin, sRect.i16YMin)) + 1)) -
+                            i32Area;
+                if(i32Growth < i32BestGrowth)
+                {
+                    i32BestGrowth = i32Growth;
+                    ui32Best = ui32Idx;
+                }
+            }
+            ui32Idx = ui32Best;
+        }
+
+        //
+        // Merge the selected existing region into the new region and remove
+        // it from the list.  The merged region is then re-added since it may
+        // now touch other regions in the list.
+        //
+        psRect = &psDirty->psDirtyRects[ui32Idx];
+        sRect.i16XMin = min(sRect.i16XMin, psRect->i16XMin);
+        sRect.i16YMin = min(sRect.i16YMin, psRect->i16YMin);
+        sRect.i16XMax = max(sRect.i16XMax, psRect->i16XMax);
+        sRect.i16YMax = max(sRect.i16YMax, psRect->i16YMax);
+        *psRect = psDirty->psDirtyRects[--psDirty->ui32NumDirty];
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a pixel on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the pixel.
+//! \param i32Y is the Y coordinate of the pixel.
+//! \param ui32Value is the color of the pixel.
+//!
+//! This function sets the given pixel to a particular color in the off-screen
+//! buffer and marks the pixel as damaged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                        uint32_t ui32Value)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Draw the pixel into the off-screen buffer and record the damage.
+    //
+    DpyPixelDraw(psDirty->psBuffer, i32X, i32Y, ui32Value);
+    psDirty->ui32PixelsDrawn += DirtyRectAdd(psDirty, i32X, i32Y, i32X, i32Y);
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the first pixel.
+//! \param i32Y is the Y coordinate of the first pixel.
+//! \param i32X0 is sub-pixel offset within the pixel data, which is valid for
+//! 1 or 4 bit per pixel formats.
+//! \param i32Count is the number of pixels to draw.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this run represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function passes the sequence of pixels on to the off-screen buffer
+//! and marks the pixels as damaged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayPixelDrawMultiple(void *pvDisplayData, int32_t i32X,
+                                int32_t i32Y, int32_t i32X0, int32_t i32Count,
+                                int32_t i32BPP, const uint8_t *pui8Data,
+                                const uint8_t *pui8Palette)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Draw the pixels into the off-screen buffer and record the damage.
+    //
+    DpyPixelDrawMultiple(psDirty->psBuffer, i32X, i32Y, i32X0, i32Count,
+                         i32BPP, pui8Data, pui8Palette);
+    psDirty->ui32PixelsDrawn += DirtyRectAdd(psDirty, i32X, i32Y,
+                                             i32X + i32Count - 1, i32Y);
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X1 is the X coordinate of the start of the line.
+//! \param i32X2 is the X coordinate of the end of the line.
+//! \param i32Y is the Y coordinate of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a horizontal line in the off-screen buffer and marks
+//! the line as damaged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2,
+                        int32_t i32Y, uint32_t ui32Value)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Draw the line into the off-screen buffer and record the damage.
+    //
+    DpyLineDrawH(psDirty->psBuffer, i32X1, i32X2, i32Y, ui32Value);
+    psDirty->ui32PixelsDrawn += DirtyRectAdd(psDirty, i32X1, i32Y, i32X2,
+                                             i32Y);
+}
+
+//*****************************************************************************
+//
+//! Draws a vertical line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the line.
+//! \param i32Y1 is the Y coordinate of the start of the line.
+//! \param i32Y2 is the Y coordinate of the end of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a vertical line in the off-screen buffer and marks the
+//! line as damaged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1,
+                        int32_t i32Y2, uint32_t ui32Value)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Draw the line into the off-screen buffer and record the damage.
+    //
+    DpyLineDrawV(psDirty->psBuffer, i32X, i32Y1, i32Y2, ui32Value);
+    psDirty->ui32PixelsDrawn += DirtyRectAdd(psDirty, i32X, i32Y1, i32X,
+                                             i32Y2);
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle.
+//! \param ui32Value is the color of the rectangle.
+//!
+//! This function fills a rectangle in the off-screen buffer and marks the
+//! rectangle as damaged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayRectFill(void *pvDisplayData, const tRectangle *psRect,
+                       uint32_t ui32Value)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Fill the rectangle in the off-screen buffer and record the damage.
+    //
+    DpyRectFill(psDirty->psBuffer, psRect, ui32Value);
+    psDirty->ui32PixelsDrawn += DirtyRectAdd(psDirty, psRect->i16XMin,
+                                             psRect->i16YMin, psRect->i16XMax,
+                                             psRect->i16YMax);
+}
+
+//*****************************************************************************
+//
+//! Draws a rectangle of pixels.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this rectangle represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function passes the rectangle of pixels on to the off-screen buffer
+//! and marks the rectangle as damaged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayBlit(void *pvDisplayData, const tRectangle *psRect,
+                   int32_t i32X0, int32_t i32BPP, const uint8_t *pui8Data,
+                   int32_t i32Stride, const uint8_t *pui8Palette)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Draw the pixels into the off-screen buffer and record the damage.
+    //
+    DpyBlit(psDirty->psBuffer, psRect, i32X0, i32BPP, pui8Data, i32Stride,
+            pui8Palette);
+    psDirty->ui32PixelsDrawn += DirtyRectAdd(psDirty, psRect->i16XMin,
+                                             psRect->i16YMin, psRect->i16XMax,
+                                             psRect->i16YMax);
+}
+
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies the rectangle within the off-screen buffer and marks
+//! the destination as damaged.  It is only used if the off-screen buffer can
+//! copy rectangles.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                       int32_t i32X, int32_t i32Y)
+{
+    tDirtyDisplay *psDirty;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Copy the rectangle in the off-screen buffer and record the damage.
+    //
+    DpyRectCopy(psDirty->psBuffer, psRect, i32X, i32Y);
+    psDirty->ui32PixelsDrawn +=
+        DirtyRectAdd(psDirty, i32X, i32Y,
+                     i32X + psRect->i16XMax - psRect->i16XMin,
+                     i32Y + psRect->i16YMax - psRect->i16YMin);
+}
+
+//*****************************************************************************
+//
+//! Translates a 24-bit RGB color to a display driver-specific color.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param ui32Value is the 24-bit RGB color.  The least-significant byte is
+//! the blue channel, the next byte is the green channel, and the third byte is
+//! the red channel.
+//!
+//! This function translates a 24-bit RGB color into the color format used by
+//! the off-screen buffer.
+//!
+//! \return Returns the display-driver specific color.
+//
+//*****************************************************************************
+static uint32_t
+GrDirtyDisplayColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Colors are written into the off-screen buffer so use its translation.
+    //
+    return(DpyColorTranslate(((tDirtyDisplay *)pvDisplayData)->psBuffer,
+                             ui32Value));
+}
+
+//*****************************************************************************
+//
+//! Flushes any cached drawing operations.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//!
+//! This functions copies each damaged region of the off-screen buffer to the
+//! target display, then flushes the target display.  The list of damaged
+//! regions is empty on return.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrDirtyDisplayFlush(void *pvDisplayData)
+{
+    tDirtyDisplay *psDirty;
+    tContext sContext;
+    uint32_t ui32Idx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psDirty = (tDirtyDisplay *)pvDisplayData;
+
+    //
+    // Only bother with the copy if something has changed.
+    //
+    if(psDirty->ui32NumDirty)
+    {
+        //
+        // Set up a drawing context on the target display.  The foreground
+        // and background colors are only used when the off-screen buffer is
+        // a 1 BPP image.
+        //
+        GrContextInit(&sContext, psDirty->psTarget);
+        GrContextForegroundSet(&sContext, ClrWhite);
+        GrContextBackgroundSet(&sContext, ClrBlack);
+
+        //
+        // Copy each damaged region by drawing the off-screen buffer image
+        // with the clipping region set to the damaged region.
+        //
+        for(ui32Idx = 0; ui32Idx < psDirty->ui32NumDirty; ui32Idx++)
+        {
+            GrContextClipRegionSet(&sContext, &psDirty->psDirtyRects[ui32Idx]);
+            GrImageDraw(&sContext, psDirty->psBuffer->pvDisplayData, 0, 0);
+            psDirty->ui32PixelsFlushed +=
+                RectArea(&psDirty->psDirtyRects[ui32Idx]);
+        }
+
+        //
+        // All damage has now been repaired.
+        //
+        psDirty->ui32NumDirty = 0;
+    }
+
+    //
+    // Pass the flush on to the target display.
+    //
+    DpyFlush(psDirty->psTarget);
+}
+
+//*****************************************************************************
+//
+//! Initializes a dirty rectangle tracking display.
+//!
+//! \param psDisplay is a pointer to the display structure to be configured.
+//! \param psDirty is a pointer to the state structure used by the display.
+//! \param psBuffer is a pointer to an initialized off-screen display into
+//! which all drawing is performed.
+//! \param psTarget is a pointer to the display to which damaged regions of
+//! the off-screen buffer are copied.
+//! \param psRects is a pointer to the array in which the damaged regions are
+//! held.
+//! \param ui32NumRects is the number of entries in \e psRects.
+//!
+//! This function initializes a display structure which wraps an off-screen
+//! buffer and a real display driver.  All drawing operations performed on
+//! \e psDisplay are passed on to \e psBuffer and the extents of the pixels
+//! affected are recorded as a list of merged damage rectangles.  When the
+//! display is flushed (via GrFlush() or DpyFlush()), only the damaged regions
+//! of the off-screen buffer are transferred to \e psTarget.
+//!
+//! Up to \e ui32NumRects separate damaged regions are held in \e psRects,
+//! which must remain valid for as long as the display is in use.  When more
+//! regions than this are damaged, the regions which grow the least are
+//! merged, resulting in some undamaged pixels being copied to the target
+//! display on the next flush.
+//!
+//! The off-screen buffer must have the same dimensions as the target display
+//! and must use an image format supported by the target display's
+//! PixelDrawMultiple function.  The \e ui32PixelsDrawn and
+//! \e ui32PixelsFlushed fields of \e psDirty count the pixels drawn into the
+//! buffer and copied to the target respectively; an application may clear
+//! these at any time.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrDirtyDisplayInit(tDisplay *psDisplay, tDirtyDisplay *psDirty,
+                   const tDisplay *psBuffer, const tDisplay *psTarget,
+                   tRectangle *psRects, uint32_t ui32NumRects)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDisplay);
+    ASSERT(psDirty);
+    ASSERT(psBuffer);
+    ASSERT(psTarget);
+    ASSERT(psRects);
+    ASSERT(ui32NumRects != 0);
+    ASSERT(psBuffer->ui16Width == psTarget->ui16Width);
+    ASSERT(psBuffer->ui16Height == psTarget->ui16Height);
+
+    //
+    // Initialize the dirty display state.
+    //
+    psDirty->psBuffer = psBuffer;
+    psDirty->psTarget = psTarget;
+    psDirty->psDirtyRects = psRects;
+    psDirty->ui32MaxDirty = ui32NumRects;
+    psDirty->ui32NumDirty = 0;
+    psDirty->ui32PixelsDrawn = 0;
+    psDirty->ui32PixelsFlushed = 0;
+
+    //
+    // Initialize the display structure.
+    //
+    psDisplay->i32Size = sizeof(tDisplay);
+    psDisplay->pvDisplayData = psDirty;
+    psDisplay->ui16Width = psBuffer->ui16Width;
+    psDisplay->ui16Height = psBuffer->ui16Height;
+    psDisplay->pfnPixelDraw = GrDirtyDisplayPixelDraw;
+    psDisplay->pfnPixelDrawMultiple = GrDirtyDisplayPixelDrawMultiple;
+    psDisplay->pfnLineDrawH = GrDirtyDisplayLineDrawH;
+    psDisplay->pfnLineDrawV = GrDirtyDisplayLineDrawV;
+    psDisplay->pfnRectFill = GrDirtyDisplayRectFill;
+    psDisplay->pfnColorTranslate = GrDirtyDisplayColorTranslate;
+    psDisplay->pfnFlush = GrDirtyDisplayFlush;
+    psDisplay->pfnBlit = GrDirtyDisplayBlit;
+    psDisplay->pfnRectCopy = (DpyRectCopySupported(psBuffer) ?
+                              GrDirtyDisplayRectCopy : 0);
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = 0;
+}
+
+//*****************************************************************************
+//
+//! Marks a region of a dirty rectangle tracking display as damaged.
+//!
+//! \param psDirty is a pointer to the state structure of the display.
+//! \param psRect is a pointer to the region to be marked as damaged, or 0 to
+//! mark the whole display as damaged.
+//!
+//! This function adds a region to the list of damaged regions without drawing
+//! anything.  This is useful when the off-screen buffer has been modified by
+//! some means other than the dirty display (for example, after changing the
+//! palette of the buffer) or when the target display has been overwritten.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrDirtyDisplayInvalidate(tDirtyDisplay *psDirty, const tRectangle *psRect)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDirty);
+
+    //
+    // Record the damage.
+    //
+    if(psRect)
+    {
+        DirtyRectAdd(psDirty, psRect->i16XMin, psRect->i16YMin,
+                     psRect->i16XMax, psRect->i16YMax);
+    }
+    else
+    {
+        DirtyRectAdd(psDirty, 0, 0, psDirty->psBuffer->ui16Width - 1,
+                     psDirty->psBuffer->ui16Height - 1);
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,752 @@
+//*****************************************************************************
+//
+// glyphcache.c - Cache of pre-decoded font glyphs.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+//
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+//
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+#ifndef GRLIB_REMOVE_WIDE_FONT_SUPPORT
+
+//*****************************************************************************
+//
+// The value used to indicate the absence of an entry in the hash chains and
+// the least recently used list.
+//
+//*****************************************************************************
+#define GLYPH_CACHE_NONE        0xffff
+
+//*****************************************************************************
+//
+// Returns a pointer to the entry with the given index.
+//
+//*****************************************************************************
+#define EntryGet(psCache, ui32Idx)                                            \
+        ((tGlyphCacheEntry *)((psCache)->pui8Entries +                        \
+                              ((ui32Idx) * (psCache)->ui16EntrySize)))
+
+//*****************************************************************************
+//
+// Returns a pointer to the runs that follow an entry header.
+//
+//*****************************************************************************
+#define EntryRunsGet(psEntry)   ((tGlyphRun *)((psEntry) + 1))
+
+//*****************************************************************************
+//
+// The state used while decoding a glyph into runs.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The runs produced so far.
+    //
+    tGlyphRun *psRuns;
+
+    //
+    // The number of runs produced so far.
+    //
+    uint32_t ui32NumRuns;
+
+    //
+    // The maximum number of runs that may be produced.
+    //
+    uint32_t ui32MaxRuns;
+
+    //
+    // The position of the next pixel within the glyph.
+    //
+    uint32_t ui32X;
+    uint32_t ui32Y;
+
+    //
+    // The width of the glyph data.
+    //
+    uint32_t ui32Width;
+}
+tGlyphDecode;
+
+//*****************************************************************************
+//
+// Computes the hash bucket for a glyph.
+//
+//*****************************************************************************
+static uint32_t
+HashGet(const tGlyphCache *psCache, const tFont *psFont,
+        uint32_t ui32CodePoint)
+{
+    uint32_t ui32Hash;
+
+    ui32Hash = (uint32_t)psFont ^ (ui32CodePoint * 0x9e3779b1);
+    return((ui32Hash ^ (ui32Hash >> 16)) & (psCache->ui16NumBuckets - 1));
+}
+
+//*****************************************************************************
+//
+// Removes an entry from the least recently used list.
+//
+//*****************************************************************************
+static void
+ListRemove(tGlyphCache *psCache, uint32_t ui32Idx)
+{
+    tGlyphCacheEntry *psEntry;
+
+    psEntry = EntryGet(psCache, ui32Idx);
+
+    if(psEntry->ui16Newer == GLYPH_CACHE_NONE)
+    {
+        psCache->ui16Newest = psEntry->ui16Older;
+    }
+    else
+    {
+        EntryGet(psCache, psEntry->ui16Newer)->ui16Older = psEntry->ui16Older;
+    }
+
+    if(psEntry->ui16Older == GLYPH_CACHE_NONE)
+    {
+        psCache->ui16Oldest = psEntry->ui16Newer;
+    }
+    else
+    {
+        EntryGet(psCache, psEntry->ui16Older)->ui16Newer = psEntry->ui16Newer;
+    }
+}
+
+//*****************************************************************************
+//
+// Inserts an entry at either the most or least recently used end of the
+// least recently used list.
+//
+//*****************************************************************************
+static void
+ListInsert(tGlyphCache *psCache, uint32_t ui32Idx, bool bNewest)
+{
+    tGlyphCacheEntry *psEntry;
+
+    psEntry = EntryGet(psCache, ui32Idx);
+
+    if(bNewest)
+    {
+        psEntry->ui16Newer = GLYPH_CACHE_NONE;
+        psEntry->ui16Older = psCache->ui16Newest;
+        if(psCache->ui16Newest == GLYPH_CACHE_NONE)
+        {
+            psCache->ui16Oldest = ui32Idx;
+        }
+        else
+        {
+            EntryGet(psCache, psCache->ui16Newest)->ui16Newer = ui32Idx;
+        }
+        psCache->ui16Newest = ui32Idx;
+    }
+    else
+    {
+        psEntry->ui16Older = GLYPH_CACHE_NONE;
+        psEntry->ui16Newer = psCache->ui16Oldest;
+        if(psCache->ui16Oldest == GLYPH_CACHE_NONE)
+        {
+            psCache->ui16Newest = ui32Idx;
+        }
+        else
+        {
+            EntryGet(psCache, psCache->ui16Oldest)->ui16Older = ui32Idx;
+        }
+        psCache->ui16Oldest = ui32Idx;
+    }
+}
+
+//*****************************************************************************
+//
+// Removes an entry from its hash chain, if it is in one.
+//
+//*****************************************************************************
+static void
+HashRemove(tGlyphCache *psCache, uint32_t ui32Idx)
+{
+    tGlyphCacheEntry *psEntry;
+    uint16_t *pui16Link;
+
+    psEntry = EntryGet(psCache, ui32Idx);
+
+    //
+    // Entries which do not hold a glyph are not in any hash chain.
+    //
+    if(!psEntry->psFont)
+    {
+        return;
+    }
+
+    //
+    // Find the link which refers to this entry and replace it with the link
+    // to the following entry.
+    //
+    pui16Link = &psCache->pui16Hash[HashGet(psCache, psEntry->psFont,
+                                            psEntry->ui32CodePoint)];
+    while(*pui16Link != GLYPH_CACHE_NONE)
+    {
+        if(*pui16Link == ui32Idx)
+        {
+            *pui16Link = psEntry->ui16HashNext;
+            break;
+        }
+        pui16Link = &EntryGet(psCache, *pui16Link)->ui16HashNext;
+    }
+}
+
+//*****************************************************************************
+//
+// Adds a number of pixels of the same color to the runs of a glyph being
+// decoded, splitting them at the right edge of the glyph.  Returns false if
+// the glyph requires more runs than are available.
+//
+//*****************************************************************************
+static bool
+DecodePixelsAdd(tGlyphDecode *psDecode, uint32_t ui32Count, bool bForeground)
+{
+    tGlyphRun *psRun;
+    uint32_t ui32Num;
+
+    while(ui32Count)
+    {
+        //
+        // Determine the number of pixels that fit on this row.
+        //
+        ui32Num = psDecode->ui32Width - psDecode->ui32X;
+        if(ui32Num > ui32Count)
+        {
+            ui32Num = ui32Count;
+        }
+
+        //
+        // Extend the previous run if these pixels continue it, otherwise
+        // start a new run.
+        //
+        psRun = psDecode->psRuns + psDecode->ui32NumRuns - 1;
+        if(psDecode->ui32NumRuns && (psRun->ui8Y == psDecode->ui32Y) &&
+           ((psRun->ui8X + psRun->ui8Count) == psDecode->ui32X) &&
+           ((psRun->ui8Foreground ? true : false) == bForeground))
+        {
+            psRun->ui8Count += ui32Num;
+        }
+        else
+        {
+            if((psDecode->ui32NumRuns == psDecode->ui32MaxRuns) ||
+               (psDecode->ui32Y > 255))
+            {
+                return(false);
+            }
+            psRun++;
+            psRun->ui8X = psDecode->ui32X;
+            psRun->ui8Y = psDecode->ui32Y;
+            psRun->ui8Count = ui32Num;
+            psRun->ui8Foreground = bForeground ? 1 : 0;
+            psDecode->ui32NumRuns++;
+        }
+
+        //
+        // Move past these pixels, wrapping to the next row at the right edge
+        // of the glyph.
+        //
+        psDecode->ui32X += ui32Num;
+        if(psDecode->ui32X == psDecode->ui32Width)
+        {
+            psDecode->ui32X = 0;
+            psDecode->ui32Y++;
+        }
+        ui32Count -= ui32Num;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Decodes the data for a glyph into an array of runs.  Returns the number of
+// runs, or -1 if the glyph requires more than ui32MaxRuns runs.
+//
+//*****************************************************************************
+static int32_t
+GlyphDecode(const uint8_t *pui8Data, bool bCompressed, tGlyphRun *psRuns,
+            uint32_t ui32MaxRuns)
+{
+    tGlyphDecode sDecode;
+    uint32_t ui32Idx, ui32Bit, ui32Off, ui32On;
+
+    sDecode.psRuns = psRuns;
+    sDecode.ui32NumRuns = 0;
+    sDecode.ui32MaxRuns = ui32MaxRuns;
+    sDecode.ui32X = 0;
+    sDecode.ui32Y = 0;
+    sDecode.ui32Width = pui8Data[1];
+
+    //
+    // A glyph with no width has no pixels.
+    //
+    if(!sDecode.ui32Width)
+    {
+        return(0);
+    }
+
+    //
+    // Loop through the bytes in the encoded data for this glyph.
+    //
+    for(ui32Idx = 2; ui32Idx < pui8Data[0]; )
+    {
+        if(!bCompressed)
+        {
+            //
+            // Each byte of an uncompressed glyph holds eight pixels, most
+            // significant bit first.
+            //
+            for(ui32Bit = 0; ui32Bit < 8; ui32Bit++)
+            {
+                if(!DecodePixelsAdd(&sDecode, 1,
+                                    ((pui8Data[ui32Idx] << ui32Bit) & 0x80) ?
+                                    true : false))
+                {
+                    return(-1);
+                }
+            }
+            ui32Idx++;
+            continue;
+        }
+
+        //
+        // See if this is a byte that encodes some on and off pixels.
+        //
+        if(pui8Data[ui32Idx])
+        {
+            ui32Off = (pui8Data[ui32Idx] >> 4) & 15;
+            ui32On = pui8Data[ui32Idx] & 15;
+            ui32Idx++;
+        }
+
+        //
+        // Otherwise, see if this is a repeated on pixel byte.
+        //
+        else if(pui8Data[ui32Idx + 1] & 0x80)
+        {
+            ui32Off = 0;
+            ui32On = (pui8Data[ui32Idx + 1] & 0x7f) * 8;
+            ui32Idx += 2;
+        }
+
+        //
+        // Otherwise, this is a repeated off pixel byte.
+        //
+        else
+        {
+            ui32Off = pui8Data[ui32Idx + 1] * 8;
+            ui32On = 0;
+            ui32Idx += 2;
+        }
+
+        if(!DecodePixelsAdd(&sDecode, ui32Off, false) ||
+           !DecodePixelsAdd(&sDecode, ui32On, true))
+        {
+            return(-1);
+        }
+    }
+
+    return(sDecode.ui32NumRuns);
+}
+
+//*****************************************************************************
+//
+// Draws a glyph held in the cache.
+//
+//*****************************************************************************
+static void
+GlyphRunsDraw(const tContext *pContext, const tGlyphCacheEntry *psEntry,
+              int32_t i32X, int32_t i32Y, bool bOpaque)
+{
+    const tGlyphRun *psRun;
+    int32_t i32X1, i32X2, i32Row;
+    uint32_t ui32Idx, ui32Color;
+
+    //
+    // Stop drawing the string if the right edge of the clipping region has
+    // been exceeded, or if the entire character is to the left of the
+    // clipping region.
+    //
+    if((i32X > pContext->sClipRegion.i16XMax) ||
+       ((i32X + psEntry->ui8DataWidth) < pContext->sClipRegion.i16XMin))
+    {
+        return;
+    }
+
+    //
+    // Loop through the runs of the glyph, which are in row order.
+    //
+    psRun = EntryRunsGet(psEntry);
+    for(ui32Idx = 0; ui32Idx < psEntry->ui16NumRuns; ui32Idx++, psRun++)
+    {
+        //
+        // Background runs are only drawn for opaque text.
+        //
+        if(!psRun->ui8Foreground && !bOpaque)
+        {
+            continue;
+        }
+
+        //
+        // Skip rows above the clipping region and stop at the first row below
+        // it.
+        //
+        i32Row = i32Y + psRun->ui8Y;
+        if(i32Row < pContext->sClipRegion.i16YMin)
+        {
+            continue;
+        }
+        if(i32Row > pContext->sClipRegion.i16YMax)
+        {
+            break;
+        }
+
+        //
+        // Clip the run to the clipping region.
+        //
+        i32X1 = i32X + psRun->ui8X;
+        i32X2 = i32X1 + psRun->ui8Count - 1;
+        if(i32X1 < pContext->sClipRegion.i16XMin)
+        {
+            i32X1 = pContext->sClipRegion.i16XMin;
+        }
+        if(i32X2 > pContext->sClipRegion.i16XMax)
+        {
+            i32X2 = pContext->sClipRegion.i16XMax;
+        }
+
+        //
+        // Draw whatever remains of the run.
+        //
+        ui32Color = (psRun->ui8Foreground ? pContext->ui32Foreground :
+                     pContext->ui32Background);
+        if(i32X1 == i32X2)
+        {
+            DpyPixelDraw(pContext->psDisplay, i32X1, i32Row, ui32Color);
+        }
+        else if(i32X1 < i32X2)
+        {
+            DpyLineDrawH(pContext->psDisplay, i32X1, i32X2, i32Row,
+                         ui32Color);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes a glyph cache.
+//!
+//! \param psCache is a pointer to the glyph cache to initialize.
+//! \param pvBuffer is a pointer to the memory used to hold the cached glyphs.
+//! This must be aligned on a 32-bit word boundary.
+//! \param ui32Size is the size of the memory pointed to by \e pvBuffer in
+//! bytes.
+//! \param ui32MaxRuns is the maximum number of runs of pixels that are stored
+//! for each glyph.
+//! \param pui16Hash is a pointer to the array which holds the hash buckets
+//! used to look up glyphs.
+//! \param ui32NumBuckets is the number of entries in \e pui16Hash, which must
+//! be a power of two.
+//!
+//! This function prepares a glyph cache for use.  Once a cache has been
+//! assigned to a drawing context (via GrContextGlyphCacheSet(), or by setting
+//! the \e psGlyphCache field of the structure passed to GrLibInit()), the
+//! default string renderer stores each glyph it draws in the cache as a list
+//! of horizontal runs of pixels.  When the same glyph is drawn again, it is
+//! drawn directly from these runs rather than being decoded from the font
+//! data.
+//!
+//! The buffer is divided into entries of GrGlyphCacheEntrySize(ui32MaxRuns)
+//! bytes, each of which holds a single glyph; when all entries are in use, the
+//! least recently drawn glyph is discarded.  A glyph that requires more than
+//! \e ui32MaxRuns runs is drawn from the font data as usual and is not cached.
+//! Each row of a glyph requires at least one run (two when drawing opaque
+//! text) so \e ui32MaxRuns should typically be at least twice the height of
+//! the largest font in use.
+//!
+//! Glyphs are found in the cache by way of a hash table with \e ui32NumBuckets
+//! buckets, held in \e pui16Hash.  Around one bucket for every two entries
+//! keeps lookups short; 32 is sufficient for most caches.
+//!
+//! The \e ui32Hits, \e ui32Misses and \e ui32Evictions fields of the cache
+//! count the glyphs drawn from the cache, the glyphs not found in the cache,
+//! and the glyphs discarded from the cache respectively.  The application may
+//! clear these at any time.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrGlyphCacheInit(tGlyphCache *psCache, void *pvBuffer, uint32_t ui32Size,
+                 uint32_t ui32MaxRuns, uint16_t *pui16Hash,
+                 uint32_t ui32NumBuckets)
+{
+    uint32_t ui32NumEntries;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psCache);
+    ASSERT(pvBuffer);
+    ASSERT(((uint32_t)pvBuffer & 3) == 0);
+    ASSERT(ui32MaxRuns && (ui32MaxRuns <= 0xffff));
+    ASSERT(pui16Hash);
+    ASSERT(ui32NumBuckets && (ui32NumBuckets <= 0x8000));
+    ASSERT((ui32NumBuckets & (ui32NumBuckets - 1)) == 0);
+
+    //
+    // Determine the number of entries that fit in the buffer.  The number of
+    // entries is limited so that an index never matches GLYPH_CACHE_NONE.
+    //
+    ui32NumEntries = ui32Size / GrGlyphCacheEntrySize(ui32MaxRuns);
+    if(ui32NumEntries > (GLYPH_CACHE_NONE - 1))
+    {
+        ui32NumEntries = GLYPH_CACHE_NONE - 1;
+    }
+
+    //
+    // Initialize the cache state.
+    //
+    psCache->pui8Entries = pvBuffer;
+    psCache->ui16EntrySize = GrGlyphCacheEntrySize(ui32MaxRuns);
+    psCache->ui16MaxRuns = ui32MaxRuns;
+    psCache->ui16NumEntries = ui32NumEntries;
+    psCache->ui16NumBuckets = ui32NumBuckets;
+    psCache->pui16Hash = pui16Hash;
+    psCache->ui32Hits = 0;
+    psCache->ui32Misses = 0;
+    psCache->ui32Evictions = 0;
+
+    //
+    // Start with an empty cache.
+    //
+    GrGlyphCacheFlush(psCache);
+}
+
+//*****************************************************************************
+//
+//! Discards all glyphs held in a glyph cache.
+//!
+//! \param psCache is a pointer to the glyph cache to flush.
+//!
+//! This function empties a glyph cache.  Glyphs are identified in the cache by
+//! the font pointer and the codepoint, so this must be called if the data
+//! associated with a font pointer changes (for example, if the memory holding
+//! a font is reused for a different font).
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrGlyphCacheFlush(tGlyphCache *psCache)
+{
+    uint32_t ui32Idx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psCache);
+
+    //
+    // Mark every entry and hash chain as unused.
+    //
+    psCache->ui16NumUsed = 0;
+    psCache->ui16Newest = GLYPH_CACHE_NONE;
+    psCache->ui16Oldest = GLYPH_CACHE_NONE;
+    for(ui32Idx = 0; ui32Idx < psCache->ui16NumBuckets; ui32Idx++)
+    {
+        psCache->pui16Hash[ui32Idx] = GLYPH_CACHE_NONE;
+    }
+}
+
+//*****************************************************************************
+//
+//! Renders a single character glyph using the glyph cache.
+//!
+//! \param pContext points to the graphics context in use.
+//! \param ui32CodePoint is the codepoint of the glyph in the current font.
+//! \param i32X is the X coordinate of the top left pixel of the glyph.
+//! \param i32Y is the Y coordinate of the top left pixel of the glyph.
+//! \param bCompressed is \b true if the font glyph data is in compressed
+//!        format or \b false if uncompressed.
+//! \param bOpaque is \b true of background pixels are to be written or \b
+//!        false if only foreground pixels are drawn.
+//! \param pui8Width points to storage which will be written with the width of
+//!        the glyph in pixels.
+//!
+//! This function is included as an aid to language-specific string rendering
+//! functions and is called by the default string renderer.  It draws the glyph
+//! for \e ui32CodePoint in the current font from the glyph cache assigned to
+//! \e pContext, decoding the glyph and adding it to the cache first if it is
+//! not already present.  The rendered glyph is subject to the clipping
+//! rectangle currently set in the graphics context.
+//!
+//! \return Returns \b true if the glyph was drawn, or \b false if the font
+//! does not contain a glyph for \e ui32CodePoint.
+//
+//*****************************************************************************
+bool
+GrGlyphCacheRender(const tContext *pContext, uint32_t ui32CodePoint,
+                   int32_t i32X, int32_t i32Y, bool bCompressed, bool bOpaque,
+                   uint8_t *pui8Width)
+{
+    tGlyphCache *psCache;
+    tGlyphCacheEntry *psEntry;
+    const uint8_t *pui8Data;
+    uint32_t ui32Hash, ui32Idx;
+    int32_t i32NumRuns;
+    uint8_t ui8Width;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pContext);
+    ASSERT(pContext->psGlyphCache);
+    ASSERT(pui8Width);
+
+    psCache = pContext->psGlyphCache;
+
+    //
+    // Look for the glyph in the cache.
+    //
+    ui32Hash = HashGet(psCache, pContext->psFont, ui32CodePoint);
+    for(ui32Idx = psCache->pui16Hash[ui32Hash]; ui32Idx != GLYPH_CACHE_NONE;
+        ui32Idx = psEntry->ui16HashNext)
+    {
+        psEntry = EntryGet(psCache, ui32Idx);
+        if((psEntry->psFont == pContext->psFont) &&
+           (psEntry->ui32CodePoint == ui32CodePoint))
+        {
+            //
+            // The glyph was found, so make it the most recently used entry
+            // and draw it.
+            //
+            psCache->ui32Hits++;
+            ListRemove(psCache, ui32Idx);
+            ListInsert(psCache, ui32Idx, true);
+            GlyphRunsDraw(pContext, psEntry, i32X, i32Y, bOpaque);
+            *pui8Width = psEntry->ui8Width;
+            return(true);
+        }
+    }
+
+    //
+    // The glyph is not in the cache, so get its data from the font.
+    //
+    psCache->ui32Misses++;
+    pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex, pContext->psFont,
+                                       ui32CodePoint, &ui8Width);
+    if(!pui8Data)
+    {
+        return(false);
+    }
+    *pui8Width = ui8Width;
+
+    //
+    // If the cache has no entries, simply draw the glyph from the font data.
+    //
+    if(!psCache->ui16NumEntries)
+    {
+        GrFontGlyphRender(pContext, pui8Data, i32X, i32Y, bCompressed,
+                          bOpaque);
+        return(true);
+    }
+
+    //
+    // Use an unused entry if there is one, otherwise discard the least
+    // recently used entry.
+    //
+    if(psCache->ui16NumUsed < psCache->ui16NumEntries)
+    {
+        ui32Idx = psCache->ui16NumUsed++;
+    }
+    else
+    {
+        ui32Idx = psCache->ui16Oldest;
+        ListRemove(psCache, ui32Idx);
+        if(EntryGet(psCache, ui32Idx)->psFont)
+        {
+            HashRemove(psCache, ui32Idx);
+            psCache->ui32Evictions++;
+        }
+    }
+    psEntry = EntryGet(psCache, ui32Idx);
+
+    //
+    // Decode the glyph into the entry.
+    //
+    i32NumRuns = GlyphDecode(pui8Data, bCompressed, EntryRunsGet(psEntry),
+                             psCache->ui16MaxRuns);
+    if(i32NumRuns < 0)
+    {
+        //
+        // The glyph is too complex to be cached.  Leave the entry empty and
+        // make it the first to be reused, then draw the glyph from the font
+        // data.
+        //
+        psEntry->psFont = 0;
+        ListInsert(psCache, ui32Idx, false);
+        GrFontGlyphRender(pContext, pui8Data, i32X, i32Y, bCompressed,
+                          bOpaque);
+        return(true);
+    }
+
+    //
+    // Fill in the entry and add it to the cache as the most recently used.
+    //
+    psEntry->psFont = pContext->psFont;
+    psEntry->ui32CodePoint = ui32CodePoint;
+    psEntry->ui16NumRuns = i32NumRuns;
+    psEntry->ui8Width = ui8Width;
+    psEntry->ui8DataWidth = pui8Data[1];
+    psEntry->ui16HashNext = psCache->pui16Hash[ui32Hash];
+    psCache->pui16Hash[ui32Hash] = ui32Idx;
+    ListInsert(psCache, ui32Idx, true);
+
+    //
+    // Draw the glyph from the newly cached runs.
+    //
+    GlyphRunsDraw(pContext, psEntry, i32X, i32Y, bOpaque);
+
+    return(true);
+}
+
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -75,6 +75,94 @@ typedef struct
 }
 tRectangle;
 
+//*****************************************************************************
+//
+//! This structure defines a point, such as a vertex of a polygon.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The X coordinate of the point.
+    //
+    int16_t i16X;
+
+    //
+    //! The Y coordinate of the point.
+    //
+    int16_t i16Y;
+}
+tPoint;
+
+//*****************************************************************************
+//
+//! The maximum number of vertices in a polygon drawn by GrPolygonFill().  The
+//! edges of the polygon are held on the stack while it is drawn, using
+//! twenty bytes per vertex.  This limit is compiled into the graphics
+//! library; a different value is used only once grlib is rebuilt with it.
+//
+//*****************************************************************************
+#ifndef GRLIB_POLYGON_MAX_POINTS
+#define GRLIB_POLYGON_MAX_POINTS 16
+#endif
+
+//*****************************************************************************
+//
+//! This structure holds a single entry of a color cache.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The 24-bit RGB color held by the entry.
+    //
+    uint32_t ui32Color;
+
+    //
+    //! The display driver-specific color for the entry.
+    //
+    uint32_t ui32Value;
+}
+tColorCacheEntry;
+
+//*****************************************************************************
+//
+//! This structure holds a cache of colors recently translated by a display
+//! driver, so that displays with an expensive color translation (such as the
+//! palette based off-screen displays, which search their palette for the
+//! closest color) only translate each color once.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The entries of the cache.
+    //
+    tColorCacheEntry *psEntries;
+
+    //
+    //! The number of entries in the cache, which is a power of two.
+    //
+    uint32_t ui32NumEntries;
+
+    //
+    //! The number of bits by which the hash of a color is shifted to select
+    //! its entry.
+    //
+    uint32_t ui32Shift;
+
+    //
+    //! The number of colors found in the cache.
+    //
+    uint32_t ui32Hits;
+
+    //
+    //! The number of colors which were not found in the cache.
+    //
+    uint32_t ui32Misses;
+}
+tColorCache;
+
 //*****************************************************************************
 //
 //! This structure defines the characteristics of a display driver.
@@ -149,6 +237,42 @@ typedef struct
     //! this display.
     //
     void (*pfnFlush)(void *pvDisplayData);
+
+    //
+    //! A pointer to the function to draw a rectangle of pixels on this
+    //! display, or 0 if the display does not provide one.  The pixel data
+    //! is in any of the formats accepted by pfnPixelDrawMultiple, with each
+    //! row starting i32Stride bytes after the previous one.
+    //
+    void (*pfnBlit)(void *pvDisplayData, const tRectangle *psRect,
+                    int32_t i32X0, int32_t i32BPP, const uint8_t *pui8Data,
+                    int32_t i32Stride, const uint8_t *pui8Palette);
+
+    //
+    //! A pointer to the function to copy a rectangle of pixels to another
+    //! position on this display, or 0 if the display does not provide one.
+    //
+    void (*pfnRectCopy)(void *pvDisplayData, const tRectangle *psRect,
+                        int32_t i32X, int32_t i32Y);
+
+    //
+    //! A pointer to the cache of colors translated by pfnColorTranslate, or
+    //! 0 if colors are not cached.  This is set with GrDisplayColorCacheSet().
+    //
+    tColorCache *psColorCache;
+
+    //
+    //! A pointer to the function to draw a rotated rectangle of pixels on
+    //! this display, or 0 if the display does not provide one.  The pixel
+    //! data is as for pfnBlit, but describes the rectangle before it is
+    //! rotated clockwise by ui32Rotation (one of the GRLIB_ROTATE_* values)
+    //! onto psRect.  The rows of psRect are written in order, so the pixels
+    //! are written in the memory order of the display.
+    //
+    void (*pfnBlitRotated)(void *pvDisplayData, const tRectangle *psRect,
+                           int32_t i32X0, int32_t i32BPP,
+                           const uint8_t *pui8Data, int32_t i32Stride,
+                           const uint8_t *pui8Palette, uint32_t ui32Rotation);
 }
 tDisplay;
 
@@ -617,6 +741,42 @@ tFontWrapper;
 //*****************************************************************************
 #define FONT_FMT_WIDE_PIXEL_RLE      (FONT_FMT_PIXEL_RLE | FONT_WIDE_MARKER)
 
+//*****************************************************************************
+//
+//! Indicates that the font data is stored as 4-bit anti-aliased coverage
+//! values using a run-length encoding.  Following the size and width bytes,
+//! each glyph is a sequence of codes, with runs wrapping from one row of the
+//! glyph to the next:
+//!
+//! - 0x00 marks the end of the glyph data.
+//! - 00nnnnnn (n from 1 to 63) is a run of n pixels with no coverage.
+//! - 01nnnnnn is a run of n + 1 pixels with full coverage.
+//! - 10nnnnnn is followed by n + 1 4-bit coverage values, packed two per byte
+//!   with the first pixel in the upper nibble.
+//! - 11rrcccc is a run of rr + 1 pixels with coverage cccc.
+//!
+//! The size byte of an anti-aliased glyph is informational only and is
+//! limited to 255.
+//
+//*****************************************************************************
+#define FONT_FMT_AA4_RLE        0x02
+
+//*****************************************************************************
+//
+//! Indicates that the font data is stored as 4-bit anti-aliased coverage
+//! values and uses the tFontEx structure format.
+//
+//*****************************************************************************
+#define FONT_FMT_EX_AA4_RLE        (FONT_FMT_AA4_RLE | FONT_EX_MARKER)
+
+//*****************************************************************************
+//
+//! Indicates that the font data is stored as 4-bit anti-aliased coverage
+//! values and uses the tFontWide structure format.
+//
+//*****************************************************************************
+#define FONT_FMT_WIDE_AA4_RLE        (FONT_FMT_AA4_RLE | FONT_WIDE_MARKER)
+
 //*****************************************************************************
 //
 //! Indicates that the font data is stored in offline storage (file system,
@@ -674,6 +834,56 @@ tFontWrapper;
 //*****************************************************************************
 #define IMAGE_FMT_8BPP_COMP     0x88
 
+//*****************************************************************************
+//
+//! Indicates that the image data is compressed in bands of rows and represents
+//! each pixel with a single bit.
+//!
+//! The image data of a banded image (which follows the palette, if any) starts
+//! with a byte that gives the number of rows in each band, followed by the
+//! 32-bit little-endian offset of the compressed data for each band, measured
+//! from the band size byte.  Each band is compressed as a separate stream that
+//! starts with an empty dictionary, which allows drawing to start at the first
+//! band that lies within the clipping region.
+//
+//*****************************************************************************
+#define IMAGE_FMT_1BPP_COMP_BANDED 0xc1
+
+//*****************************************************************************
+//
+//! Indicates that the image data is compressed in bands of rows and represents
+//! each pixel with four bits.
+//
+//*****************************************************************************
+#define IMAGE_FMT_4BPP_COMP_BANDED 0xc4
+
+//*****************************************************************************
+//
+//! Indicates that the image data is compressed in bands of rows and represents
+//! each pixel with eight bits.
+//
+//*****************************************************************************
+#define IMAGE_FMT_8BPP_COMP_BANDED 0xc8
+
+//*****************************************************************************
+//
+//! Indicates that the image data is not compressed and represents each pixel
+//! with sixteen bits in 5-6-5 RGB format.  The image header is followed by a
+//! single reserved byte rather than a palette.
+//
+//*****************************************************************************
+#define IMAGE_FMT_16BPP_UNCOMP  0x10
+
+//*****************************************************************************
+//
+//! Indicates that the image data is not compressed and represents each pixel
+//! with twenty four bits in 8-8-8 RGB format, stored with the blue component
+//! first.  The image header is followed by a single reserved byte rather than
+//! a palette.
+//
+//*****************************************************************************
+#define IMAGE_FMT_24BPP_UNCOMP  0x18
+
 #ifndef GRLIB_REMOVE_WIDE_FONT_SUPPORT
 //*****************************************************************************
 //
@@ -775,6 +985,255 @@ struct _tContext;
 typedef void (*tStringRenderer)(const struct _tContext *, const char *,
                                 int32_t, int32_t, int32_t, bool);
 
+//*****************************************************************************
+//
+//! This structure describes a single horizontal run of pixels within a glyph
+//! held in a glyph cache.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The X offset of the first pixel of the run from the left of the glyph.
+    //
+    uint8_t ui8X;
+
+    //
+    //! The Y offset of the run from the top of the glyph.
+    //
+    uint8_t ui8Y;
+
+    //
+    //! The number of pixels in the run.
+    //
+    uint8_t ui8Count;
+
+    //
+    //! Non-zero if the run is drawn in the foreground color, or zero if it is
+    //! drawn in the background color (and only when drawing opaque text).
+    //
+    uint8_t ui8Foreground;
+}
+tGlyphRun;
+
+//*****************************************************************************
+//
+//! This structure is the header of each entry in a glyph cache.  It is
+//! followed in memory by the runs which make up the glyph.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The font containing the glyph.
+    //
+    const tFont *psFont;
+
+    //
+    //! The codepoint of the glyph within the font.
+    //
+    uint32_t ui32CodePoint;
+
+    //
+    //! The index of the next entry in the same hash bucket.
+    //
+    uint16_t ui16HashNext;
+
+    //
+    //! The index of the next more recently used entry.
+    //
+    uint16_t ui16Newer;
+
+    //
+    //! The index of the next less recently used entry.
+    //
+    uint16_t ui16Older;
+
+    //
+    //! The number of runs which make up the glyph.
+    //
+    uint16_t ui16NumRuns;
+
+    //
+    //! The width of the glyph, which is the distance to advance to the next
+    //! character.
+    //
+    uint8_t ui8Width;
+
+    //
+    //! The width of the glyph data, as used when clipping.
+    //
+    uint8_t ui8DataWidth;
+}
+tGlyphCacheEntry;
+
+//*****************************************************************************
+//
+//! Determines the number of bytes of memory needed for each entry in a glyph
+//! cache.
+//!
+//! \param ui32MaxRuns is the maximum number of runs held by each entry.
+//!
+//! This macro determines the size of each entry of a glyph cache; the size of
+//! the buffer passed to GrGlyphCacheInit() should be a multiple of this.
+//!
+//! \return Returns the number of bytes required by each entry.
+//
+//*****************************************************************************
+#define GrGlyphCacheEntrySize(ui32MaxRuns)                                    \
+        ((sizeof(tGlyphCacheEntry) + ((ui32MaxRuns) * sizeof(tGlyphRun)) +   \
+          3) & ~3)
+
+//*****************************************************************************
+//
+//! This structure holds the state of a glyph cache, which stores recently
+//! drawn glyphs in a pre-decoded form so that they do not need to be decoded
+//! from the font data each time they are drawn.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The memory holding the cache entries.
+    //
+    uint8_t *pui8Entries;
+
+    //
+    //! The size of each cache entry in bytes.
+    //
+    uint16_t ui16EntrySize;
+
+    //
+    //! The maximum number of runs which can be held by each entry.  Glyphs
+    //! which require more runs than this are not cached.
+    //
+    uint16_t ui16MaxRuns;
+
+    //
+    //! The number of entries in the cache.
+    //
+    uint16_t ui16NumEntries;
+
+    //
+    //! The hash table, which holds the number of the first entry in each
+    //! bucket (or 0xffff if the bucket is empty).  Strings are placed in a
+    //! bucket by their language and index.
+    //
+    uint16_t *pui16Buckets;
+
+    //
+    //! The number of buckets in the hash table, less one.  The number of
+    //! buckets is a power of two.
+    //
+    uint16_t ui16BucketMask;
+
+    //
+    //! The number of entries currently in use.
+    //
+    uint16_t ui16NumUsed;
+
+    //
+    //! The index of the most recently used entry.
+    //
+    uint16_t ui16Newest;
+
+    //
+    //! The index of the least recently used entry.
+    //
+    uint16_t ui16Oldest;
+
+    //
+    //! The number of hash buckets used to look up glyphs, which is a power
+    //! of two.
+    //
+    uint16_t ui16NumBuckets;
+
+    //
+    //! The index of the first entry in each hash bucket.
+    //
+    uint16_t *pui16Hash;
+
+    //
+    //! The number of glyphs drawn from the cache.
+    //
+    uint32_t ui32Hits;
+
+    //
+    //! The number of glyphs which were not found in the cache.
+    //
+    uint32_t ui32Misses;
+
+    //
+    //! The number of entries which were discarded to make room for new
+    //! glyphs.
+    //
+    uint32_t ui32Evictions;
+}
+tGlyphCache;
+
+//*****************************************************************************
+//
+//! This structure holds an index of the codepoint blocks of a wide or wrapped
+//! font, sorted by starting codepoint, so that the block containing a given
+//! codepoint may be found with a binary search rather than by walking the
+//! font's block table.  The block which satisfied the most recent lookup is
+//! remembered, since consecutive characters of a string usually fall within
+//! the same block.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The font described by the index, or 0 if the index is empty.
+    //
+    const tFont *psFont;
+
+    //
+    //! The sorted block table.  This is either the font's own block table,
+    //! if that is already sorted, or the storage provided to
+    //! GrFontIndexInit().
+    //
+    const tFontBlock *psBlocks;
+
+    //
+    //! The storage used to hold the block table when the font's own table
+    //! cannot be used directly.
+    //
+    tFontBlock *psStorage;
+
+    //
+    //! The number of blocks which fit in the storage.
+    //
+    uint16_t ui16MaxBlocks;
+
+    //
+    //! The number of blocks in the sorted block table.
+    //
+    uint16_t ui16NumBlocks;
+
+    //
+    //! The position within the sorted block table of the block which
+    //! satisfied the most recent lookup.
+    //
+    uint16_t ui16LastBlock;
+
+    //
+    //! Reserved for future expansion.
+    //
+    uint16_t ui16Reserved;
+
+    //
+    //! The number of lookups satisfied by the most recently used block.
+    //
+    uint32_t ui32Hits;
+
+    //
+    //! The number of lookups which required a search of the block table.
+    //
+    uint32_t ui32Searches;
+}
+tFontIndex;
+
 //*****************************************************************************
 //
 //! This structure contains default values that are set in any new context
@@ -814,6 +1273,16 @@ typedef struct
     //! Reserved for future expansion.
     //
     uint8_t ui8Reserved;
+
+    //
+    //! The default glyph cache, or 0 if glyphs are not to be cached.
+    //
+    tGlyphCache *psGlyphCache;
+
+    //
+    //! The default font block index, or 0 if fonts are not to be indexed.
+    //
+    tFontIndex *psFontIndex;
 }
 tGrLibDefaults;
 
@@ -852,53 +1321,162 @@ typedef struct _tContext
     uint32_t ui32Foreground;
 
     //
-    //! The background color used to draw primitives onto the screen.
+    //! The background color used to draw primitives onto the screen.
+    //
+    uint32_t ui32Background;
+
+    //
+    //! The 24-bit RGB value of the foreground color, used to blend the
+    //! foreground and background colors when drawing anti-aliased text.
+    //
+    uint32_t ui32ForegroundRGB;
+
+    //
+    //! The 24-bit RGB value of the background color, used to blend the
+    //! foreground and background colors when drawing anti-aliased text.
+    //
+    uint32_t ui32BackgroundRGB;
+
+    //
+    //! The font used to render text onto the screen.
+    //
+    const tFont *psFont;
+
+#ifndef GRLIB_REMOVE_WIDE_FONT_SUPPORT
+    //
+    //! A pointer to a replacement string rendering function.  Applications
+    //! can use this for language-specific string rendering support.  If
+    //! set, this function is passed control whenever GrStringDraw is called.
+    //
+    void (*pfnStringRenderer)(const struct _tContext *, const char *, int32_t,
+                              int32_t, int32_t, bool);
+
+    //
+    //! A table of functions used to map between the various supported
+    //! source codepages and the codepages supported by fonts in use.
+    //
+    const tCodePointMap *pCodePointMapTable;
+
+    //
+    //! The currently selected source text codepage.
+    //
+    uint16_t ui16Codepage;
+
+    //
+    //! The number of entries in the pCodePointMapTable array.
+    //
+    uint8_t ui8NumCodePointMaps;
+
+    //
+    //! The index of the codepoint map table entry which is currently in use
+    //! based on the selected source codepage and the current font.
+    //
+    uint8_t ui8CodePointMap;
+
+    //
+    //! Reserved for future expansion.
+    //
+    uint8_t ui8Reserved;
+
+    //
+    //! The cache used to hold pre-decoded glyphs, or 0 if glyphs are decoded
+    //! from the font each time they are drawn.
+    //
+    tGlyphCache *psGlyphCache;
+
+    //
+    //! The index used to find glyphs in wide and wrapped fonts, or 0 if the
+    //! font's block table is searched for each glyph.
+    //
+    tFontIndex *psFontIndex;
+#endif
+}
+tContext;
+
+//*****************************************************************************
+//
+//! This structure holds the state of a dirty rectangle tracking display, which
+//! routes drawing into an off-screen buffer and copies only the damaged
+//! regions of that buffer to a real display when flushed.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The off-screen display into which all drawing is performed.
+    //
+    const tDisplay *psBuffer;
+
+    //
+    //! The display to which damaged regions of the off-screen buffer are
+    //! copied when the display is flushed.
     //
-    uint32_t ui32Background;
+    const tDisplay *psTarget;
 
     //
-    //! The font used to render text onto the screen.
+    //! The regions of the off-screen buffer which have been drawn to since
+    //! the last flush.
     //
-    const tFont *psFont;
+    tRectangle *psDirtyRects;
 
-#ifndef GRLIB_REMOVE_WIDE_FONT_SUPPORT
     //
-    //! A pointer to a replacement string rendering function.  Applications
-    //! can use this for language-specific string rendering support.  If
-    //! set, this function is passed control whenever GrStringDraw is called.
+    //! The number of entries in psDirtyRects.  When more regions than this
+    //! are damaged, regions are merged, resulting in some undamaged pixels
+    //! being copied to the target display on the next flush.
     //
-    void (*pfnStringRenderer)(const struct _tContext *, const char *, int32_t,
-                              int32_t, int32_t, bool);
+    uint32_t ui32MaxDirty;
 
     //
-    //! A table of functions used to map between the various supported
-    //! source codepages and the codepages supported by fonts in use.
+    //! The number of valid entries in psDirtyRects.
     //
-    const tCodePointMap *pCodePointMapTable;
+    uint32_t ui32NumDirty;
 
     //
-    //! The currently selected source text codepage.
+    //! The number of pixels drawn into the off-screen buffer.
     //
-    uint16_t ui16Codepage;
+    uint32_t ui32PixelsDrawn;
 
     //
-    //! The number of entries in the pCodePointMapTable array.
+    //! The number of pixels copied from the off-screen buffer to the target
+    //! display.
     //
-    uint8_t ui8NumCodePointMaps;
+    uint32_t ui32PixelsFlushed;
+}
+tDirtyDisplay;
+
+//*****************************************************************************
+//
+// Values that can be passed to GrRotatedDisplayInit() as the ui32Rotation
+// parameter (and to the pfnBlitRotated function of a display), giving the
+// clockwise rotation applied to drawing.
+//
+//*****************************************************************************
+#define GRLIB_ROTATE_0          0
+#define GRLIB_ROTATE_90         1
+#define GRLIB_ROTATE_180        2
+#define GRLIB_ROTATE_270        3
 
+//*****************************************************************************
+//
+//! This structure holds the state of a rotated display, which writes drawing
+//! into another display (typically an off-screen buffer) at rotated positions
+//! so that the buffer is already in the memory order of the panel.
+//
+//*****************************************************************************
+typedef struct
+{
     //
-    //! The index of the codepoint map table entry which is currently in use
-    //! based on the selected source codepage and the current font.
+    //! The display into which all drawing is performed.
     //
-    uint8_t ui8CodePointMap;
+    const tDisplay *psBuffer;
 
     //
-    //! Reserved for future expansion.
+    //! The clockwise rotation applied to drawing, which is one of the
+    //! GRLIB_ROTATE_* values.
     //
-    uint8_t ui8Reserved;
-#endif
+    uint32_t ui32Rotation;
 }
-tContext;
+tRotatedDisplay;
 
 //*****************************************************************************
 //
@@ -918,6 +1496,7 @@ tContext;
         {                                                                     \
             tContext *pC = psContext;                                         \
             pC->ui32Background = DpyColorTranslate(pC->psDisplay, ui32Value);  \
+            pC->ui32BackgroundRGB = ui32Value;                                \
         }                                                                     \
         while(0)
 
@@ -933,6 +1512,9 @@ tContext;
 //! translated to a driver-specific color (for example, via
 //! DpyColorTranslate()).
 //!
+//! The RGB background color used to draw anti-aliased text is not changed by
+//! this function.
+//!
 //! \return None.
 //
 //*****************************************************************************
@@ -999,6 +1581,30 @@ tContext;
         while(0)
 #else
 extern void GrContextFontSet(tContext *psContext, const tFont *pFnt);
+extern void GrContextFontIndexSet(tContext *psContext, tFontIndex *psIndex);
+
+//*****************************************************************************
+//
+//! Sets the glyph cache to be used.
+//!
+//! \param psContext is a pointer to the drawing context to modify.
+//! \param psCache is a pointer to the glyph cache to be used, or 0 to disable
+//! glyph caching.
+//!
+//! This function sets the glyph cache used by the default string renderer for
+//! the specified drawing context.  A single cache may be shared by any number
+//! of drawing contexts.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define GrContextGlyphCacheSet(psContext, psCache)                            \
+        do                                                                    \
+        {                                                                     \
+            tContext *pC = psContext;                                         \
+            pC->psGlyphCache = psCache;                                       \
+        }                                                                     \
+        while(0)
 #endif
 
 //*****************************************************************************
@@ -1019,6 +1625,7 @@ extern void GrContextFontSet(tContext *psContext, const tFont *pFnt);
         {                                                                     \
             tContext *pC = psContext;                                         \
             pC->ui32Foreground = DpyColorTranslate(pC->psDisplay, ui32Value);  \
+            pC->ui32ForegroundRGB = ui32Value;                                \
         }                                                                     \
         while(0)
 
@@ -1034,6 +1641,9 @@ extern void GrContextFontSet(tContext *psContext, const tFont *pFnt);
 //! translated to a driver-specific color (for example, via
 //! DpyColorTranslate()).
 //!
+//! The RGB foreground color used to draw anti-aliased text is not changed by
+//! this function.
+//!
 //! \return None.
 //
 //*****************************************************************************
@@ -1209,6 +1819,38 @@ extern void GrContextFontSet(tContext *psContext, const tFont *pFnt);
 #define GrOffScreen8BPPSize(i32Width, i32Height)                              \
         (6 + (256 * 3) + (i32Width * i32Height))
 
+//*****************************************************************************
+//
+//! Determines the size of the buffer for a 16 BPP off-screen image.
+//!
+//! \param i32Width is the width of the image in pixels.
+//! \param i32Height is the height of the image in pixels.
+//!
+//! This function determines the size of the memory buffer required to hold a
+//! 16 BPP off-screen image of the specified geometry.
+//!
+//! \return Returns the number of bytes required by the image.
+//
+//*****************************************************************************
+#define GrOffScreen16BPPSize(i32Width, i32Height)                             \
+        (6 + (i32Width * i32Height * 2))
+
+//*****************************************************************************
+//
+//! Determines the size of the buffer for a 24 BPP off-screen image.
+//!
+//! \param i32Width is the width of the image in pixels.
+//! \param i32Height is the height of the image in pixels.
+//!
+//! This function determines the size of the memory buffer required to hold a
+//! 24 BPP off-screen image of the specified geometry.
+//!
+//! \return Returns the number of bytes required by the image.
+//
+//*****************************************************************************
+#define GrOffScreen24BPPSize(i32Width, i32Height)                             \
+        (6 + (i32Width * i32Height * 3))
+
 //*****************************************************************************
 //
 //! Draws a pixel.
@@ -1827,6 +2469,282 @@ extern const tFont g_sFontFixed6x8;
 #define GrLangUrIN              0x0820      // Urdu (India)
 #define GrLangUrPK              0x0420      // Urdu (Pakistan)
 
+//*****************************************************************************
+//
+//! This structure describes an extended string table.  Each string is stored
+//! once per language as a sequence of codes, and is located directly through
+//! an offset table indexed by language and string index.  Substrings which
+//! occur frequently across the table (in any language) are stored once in a
+//! dictionary, and are replaced in the strings by a one or two byte
+//! reference.  Each string is a sequence of tokens, each starting with a
+//! code byte:
+//!
+//! - 0x00 through \b STRING_CODE_WORD - 1: a run of (code + 1) literal
+//!   characters, which follow the code.
+//! - \b STRING_CODE_WORD through \b STRING_CODE_LONG_WORD - 1: a reference to
+//!   dictionary word (code - \b STRING_CODE_WORD).
+//! - \b STRING_CODE_LONG_WORD through 0xff: a reference to dictionary word
+//!   \b STRING_NUM_SHORT_WORDS + ((code - \b STRING_CODE_LONG_WORD) * 256) +
+//!   the following byte.
+//!
+//! Every token therefore maps to a block of characters which can be copied
+//! as a whole when the string is decoded.
+//!
+//! The strings are not null terminated.  Tables in this format are generated
+//! by the mkstrtab utility and are selected with GrStringTableExSet().
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The number of strings in each language.
+    //
+    uint16_t ui16NumStrings;
+
+    //
+    //! The number of languages in the table.
+    //
+    uint16_t ui16NumLanguages;
+
+    //
+    //! The number of words in the dictionary.
+    //
+    uint16_t ui16NumWords;
+
+    //
+    //! The language identifiers (one of the \b GrLang values) of the
+    //! languages in the table.
+    //
+    const uint16_t *pui16Languages;
+
+    //
+    //! The offset of each string within pui8Strings.  The string with index
+    //! \e i in the language at position \e l of pui16Languages starts at
+    //! entry ((\e l * ui16NumStrings) + \e i) and ends at the following entry,
+    //! so there is one more entry than there are strings in the table.
+    //
+    const uint32_t *pui32StringOffsets;
+
+    //
+    //! The encoded strings.
+    //
+    const uint8_t *pui8Strings;
+
+    //
+    //! The offset of each word within pui8Words.  As with the strings, there
+    //! is one more entry than there are words.
+    //
+    const uint16_t *pui16WordOffsets;
+
+    //
+    //! The characters of the dictionary words.
+    //
+    const uint8_t *pui8Words;
+}
+tStringTableEx;
+
+//*****************************************************************************
+//
+// The codes used in the strings of an extended string table.
+//
+//*****************************************************************************
+#define STRING_CODE_WORD        0x80
+#define STRING_CODE_LONG_WORD   0xf0
+#define STRING_MAX_RUN          STRING_CODE_WORD
+#define STRING_NUM_SHORT_WORDS  (STRING_CODE_LONG_WORD - STRING_CODE_WORD)
+#define STRING_MAX_WORDS        (STRING_NUM_SHORT_WORDS +                     \
+                                 ((0x100 - STRING_CODE_LONG_WORD) * 256))
+
+//*****************************************************************************
+//
+//! This structure describes an entry in a string cache.  The characters of
+//! the string, followed by a null terminator, are stored immediately after
+//! the structure.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The number of the lookup which last used this entry, which is zero if
+    //! the entry is not in use.
+    //
+    uint32_t ui32Used;
+
+    //
+    //! The index of the string held by this entry.
+    //
+    uint16_t ui16Index;
+
+    //
+    //! The position of the string's language in the string table.
+    //
+    uint16_t ui16Language;
+
+    //
+    //! The length of the string.
+    //
+    uint16_t ui16Length;
+
+    //
+    //! The number of the next entry in the same hash bucket, or 0xffff if
+    //! this is the last entry in the bucket.
+    //
+    uint16_t ui16Next;
+}
+tStringCacheEntry;
+
+//*****************************************************************************
+//
+//! Determines the number of bytes of memory needed for each entry in a string
+//! cache.
+//!
+//! \param ui32MaxLength is the length of the longest string which can be held
+//! by each entry.
+//!
+//! This macro determines the size of each entry of a string cache, not
+//! including the share of the hash table used to find the entries; use
+//! GrStringCacheSize() to size the buffer passed to GrStringCacheInit().
+//!
+//! \return Returns the number of bytes required by each entry.
+//
+//*****************************************************************************
+#define GrStringCacheEntrySize(ui32MaxLength)                                 \
+        ((sizeof(tStringCacheEntry) + (ui32MaxLength) + 1 + 3) & ~3)
+
+//*****************************************************************************
+//
+//! Determines the number of bytes of memory needed for a string cache.
+//!
+//! \param ui32NumEntries is the number of strings held by the cache.
+//! \param ui32MaxLength is the length of the longest string which can be held
+//! by each entry.
+//!
+//! This macro determines the size of the buffer to pass to
+//! GrStringCacheInit() for a cache holding the given number of strings.
+//! Besides the entries, the buffer holds a hash table with (at most) one
+//! two byte bucket per entry.
+//!
+//! \return Returns the number of bytes required by the cache.
+//
+//*****************************************************************************
+#define GrStringCacheSize(ui32NumEntries, ui32MaxLength)                      \
+        ((ui32NumEntries) * (GrStringCacheEntrySize(ui32MaxLength) + 2))
+
+//*****************************************************************************
+//
+//! This structure holds the state of a string cache, which stores recently
+//! retrieved strings from the current string table so that they do not need
+//! to be decoded each time they are used.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The memory holding the cache entries.
+    //
+    uint8_t *pui8Entries;
+
+    //
+    //! The size of each cache entry in bytes.
+    //
+    uint16_t ui16EntrySize;
+
+    //
+    //! The length of the longest string which can be cached.
+    //
+    uint16_t ui16MaxLength;
+
+    //
+    //! The number of entries in the cache.
+    //
+    uint16_t ui16NumEntries;
+
+    //
+    //! The hash table, which holds the number of the first entry in each
+    //! bucket (or 0xffff if the bucket is empty).  Strings are placed in a
+    //! bucket by their language and index.
+    //
+    uint16_t *pui16Buckets;
+
+    //
+    //! The number of buckets in the hash table, less one.  The number of
+    //! buckets is a power of two.
+    //
+    uint16_t ui16BucketMask;
+
+    //
+    //! The number of lookups made in the cache, used to find the least
+    //! recently used entry.
+    //
+    uint32_t ui32Lookups;
+
+    //
+    //! The number of strings found in the cache.
+    //
+    uint32_t ui32Hits;
+
+    //
+    //! The number of strings which were not found in the cache.
+    //
+    uint32_t ui32Misses;
+}
+tStringCache;
+
+//*****************************************************************************
+//
+//! Draws a rectangle of pixels on a display.
+//!
+//! \param psDisplay is the pointer to the display driver structure for the
+//! display to operate upon.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! draw.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel, optionally ORed with
+//! \b GRLIB_DRIVER_FLAG_NEW_IMAGE.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a rectangle of pixels on a display, using the pixel
+//! and palette formats described for DpyPixelDrawMultiple().  If the display
+//! driver does not provide a blit function, each row is drawn with its pixel
+//! draw multiple function instead.  This assumes that clipping has already
+//! been performed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define DpyBlit(psDisplay, psRect, i32X0, i32BPP, pui8Data, i32Stride,        \
+                pui8Palette)                                                  \
+        do                                                                    \
+        {                                                                     \
+            const tDisplay *pD = psDisplay;                                   \
+            const tRectangle *pR = psRect;                                    \
+            const uint8_t *pui8Row = pui8Data;                                \
+            int32_t i32Row, i32Flags = i32BPP;                                \
+            if(pD->pfnBlit)                                                   \
+            {                                                                 \
+                pD->pfnBlit(pD->pvDisplayData, pR, i32X0, i32Flags, pui8Row,  \
+                            i32Stride, pui8Palette);                          \
+            }                                                                 \
+            else                                                              \
+            {                                                                 \
+                for(i32Row = pR->i16YMin; i32Row <= pR->i16YMax; i32Row++)   \
+                {                                                             \
+                    pD->pfnPixelDrawMultiple(pD->pvDisplayData, pR->i16XMin,  \
+                                             i32Row, i32X0,                   \
+                                             (pR->i16XMax - pR->i16XMin +     \
+                                              1), i32Flags, pui8Row,          \
+                                             pui8Palette);                    \
+                    i32Flags &= ~GRLIB_DRIVER_FLAG_NEW_IMAGE;                 \
+                    pui8Row += i32Stride;                                     \
+                }                                                             \
+            }                                                                 \
+        }                                                                     \
+        while(0)
+
 //*****************************************************************************
 //
 //! Translates a 24-bit RGB color to a display driver-specific color.
@@ -1839,13 +2757,18 @@ extern const tFont g_sFontFixed6x8;
 //!
 //! This function translates a 24-bit RGB color into a value that can be
 //! written into the display's frame buffer in order to reproduce that color,
-//! or the closest possible approximation of that color.
+//! or the closest possible approximation of that color.  If a color cache has
+//! been attached to the display with GrDisplayColorCacheSet(), the color is
+//! looked up in the cache before it is passed to the display driver.
 //!
 //! \return Returns the display-driver specific color.
 //
 //*****************************************************************************
 #define DpyColorTranslate(psDisplay, ui32Value)                                \
-        ((psDisplay)->pfnColorTranslate((psDisplay)->pvDisplayData, ui32Value))
+        (((psDisplay)->psColorCache) ?                                        \
+         GrColorCacheTranslate(psDisplay, ui32Value) :                        \
+         (psDisplay)->pfnColorTranslate((psDisplay)->pvDisplayData,           \
+                                        ui32Value))
 
 //*****************************************************************************
 //
@@ -1971,7 +2894,7 @@ extern const tFont g_sFontFixed6x8;
 //! \param i32X0 is sub-pixel offset within the pixel data, which is valid for
 //! 1 or 4 bit per pixel formats.
 //! \param i32Count is the number of pixels to draw.
-//! \param i32BPP is the number of bits per pixel; must be 1, 4, or 8.
+//! \param i32BPP is the number of bits per pixel; must be 1, 4, 8, 16 or 24.
 //! \param pui8Data is a pointer to the pixel data.  For 1 and 4 bit per pixel
 //! formats, the most significant bit(s) represent the left-most pixel.
 //! \param pui8Palette is a pointer to the palette used to draw the pixels.
@@ -1980,7 +2903,10 @@ extern const tFont g_sFontFixed6x8;
 //! supplied palette.  For 1 bit per pixel format, the palette contains
 //! pre-translated colors; for 4 and 8 bit per pixel formats, the palette
 //! contains 24-bit RGB values that must be translated before being written to
-//! the display.
+//! the display.  The 16 (5-6-5 RGB) and 24 (8-8-8 RGB) bit per pixel formats
+//! carry colors directly and do not use a palette; they are only used with
+//! drivers that support \b IMAGE_FMT_16BPP_UNCOMP and
+//! \b IMAGE_FMT_24BPP_UNCOMP images.
 //!
 //! \return None.
 //
@@ -1996,6 +2922,53 @@ extern const tFont g_sFontFixed6x8;
         }                                                                     \
         while(0)
 
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on a display.
+//!
+//! \param psDisplay is the pointer to the display driver structure for the
+//! display to operate upon.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies a rectangle of pixels to another position on a
+//! display; the source and destination may overlap.  This assumes that
+//! clipping has already been performed, and that the display driver provides
+//! a rectangle copy function (see DpyRectCopySupported()).
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define DpyRectCopy(psDisplay, psRect, i32X, i32Y)                            \
+        do                                                                    \
+        {                                                                     \
+            const tDisplay *pD = psDisplay;                                   \
+            pD->pfnRectCopy(pD->pvDisplayData, psRect, i32X, i32Y);           \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+//! Determines if a display can copy rectangles of pixels.
+//!
+//! \param psDisplay is the pointer to the display driver structure for the
+//! display to query.
+//!
+//! This function determines whether the display driver provides a rectangle
+//! copy function.  There is no fallback for displays which do not, since the
+//! display drivers provide no means of reading pixels back from the display.
+//!
+//! \return Returns \b true if DpyRectCopy() may be used on the display and
+//! \b false otherwise.
+//
+//*****************************************************************************
+#define DpyRectCopySupported(psDisplay)                                       \
+        (((psDisplay)->pfnRectCopy) ? true : false)
+
 //*****************************************************************************
 //
 //! Fills a rectangle on a display.
@@ -2091,6 +3064,18 @@ extern const tFont g_sFontFixed6x8;
 //
 #define NumLeadingZeros(x)      _norm(x)
 #endif
+#if !defined(NumLeadingZeros) && defined(__GNUC__)
+//
+// When building for a host machine (for example, the host-side graphics
+// library tools), use the GCC builtin.  Unlike the CLZ instruction, the result
+// of the builtin is undefined for zero, so handle that case explicitly.
+//
+#define NumLeadingZeros(x) __extension__                                      \
+        ({                                                                    \
+            uint32_t __inp = x;                                               \
+            (__inp ? (uint32_t)__builtin_clz(__inp) : 32);                    \
+        })
+#endif
 
 //*****************************************************************************
 //
@@ -2100,12 +3085,21 @@ extern const tFont g_sFontFixed6x8;
 #ifndef GRLIB_REMOVE_WIDE_FONT_SUPPORT
 extern void GrLibInit(const tGrLibDefaults *pDefaults);
 #endif
+extern void GrArcDraw(const tContext *psContext, int32_t i32X, int32_t i32Y,
+                      int32_t i32Radius, int32_t i32StartAngle,
+                      int32_t i32EndAngle);
 extern void GrCircleDraw(const tContext *psContext, int32_t i32X, int32_t i32Y,
                          int32_t i32Radius);
 extern void GrCircleFill(const tContext *psContext, int32_t i32X, int32_t i32Y,
                          int32_t i32Radius);
 extern void GrContextClipRegionSet(tContext *psContext, tRectangle *psRect);
 extern void GrContextInit(tContext *psContext, const tDisplay *psDisplay);
+extern void GrDirtyDisplayInit(tDisplay *psDisplay, tDirtyDisplay *psDirty,
+                               const tDisplay *psBuffer,
+                               const tDisplay *psTarget,
+                               tRectangle *psRects, uint32_t ui32NumRects);
+extern void GrDirtyDisplayInvalidate(tDirtyDisplay *psDirty,
+                                     const tRectangle *psRect);
 extern void GrImageDraw(const tContext *psContext,
                         const uint8_t *pui8Image, int32_t i32X, int32_t i32Y);
 extern void GrTransparentImageDraw(const tContext *psContext,
@@ -2132,16 +3126,47 @@ extern void GrOffScreen8BPPPaletteSet(tDisplay *psDisplay,
                                       uint32_t *pui32Palette,
                                       uint32_t ui32Offset,
                                       uint32_t ui32Count);
+extern void GrOffScreen16BPPInit(tDisplay *psDisplay, uint8_t *pui8Image,
+                                 int32_t i32Width, int32_t i32Height);
+extern void GrOffScreen24BPPInit(tDisplay *psDisplay, uint8_t *pui8Image,
+                                 int32_t i32Width, int32_t i32Height);
+extern void GrOffScreenBlit(const tDisplay *psDst, const tDisplay *psSrc,
+                            const tRectangle *psRect, int32_t i32X,
+                            int32_t i32Y);
+extern void GrOffScreenTransparentBlit(const tDisplay *psDst,
+                                       const tDisplay *psSrc,
+                                       const tRectangle *psRect,
+                                       int32_t i32X, int32_t i32Y,
+                                       uint32_t ui32Transparent);
+extern void GrPolygonFill(const tContext *psContext,
+                          const tPoint *psPoints, uint32_t ui32NumPoints);
+extern bool GrRectCopy(const tContext *psContext, const tRectangle *psRect,
+                       int32_t i32X, int32_t i32Y);
 extern void GrRectDraw(const tContext *psContext, const tRectangle *psRect);
 extern void GrRectFill(const tContext *psContext, const tRectangle *psRect);
+extern void GrRotatedDisplayInit(tDisplay *psDisplay,
+                                 tRotatedDisplay *psRotated,
+                                 const tDisplay *psBuffer,
+                                 uint32_t ui32Rotation);
+extern void GrRoundRectFill(const tContext *psContext,
+                            const tRectangle *psRect, int32_t i32Radius);
 extern void GrStringDraw(const tContext *psContext, const char *pcString,
                          int32_t i32Length, int32_t i32X, int32_t i32Y,
                          uint32_t bOpaque);
 extern int32_t GrStringWidthGet(const tContext *psContext, const char *pcString,
                                 int32_t i32Length);
 extern void GrStringTableSet(const void *pvTable);
+extern void GrStringTableExSet(const tStringTableEx *psTable);
 uint32_t GrStringLanguageSet(uint16_t ui16LangID);
 uint32_t GrStringGet(int32_t i32Index, char *pcData, uint32_t ui32Size);
+extern uint32_t GrStringTableExGet(const tStringTableEx *psTable,
+                                   uint32_t ui32Language, uint32_t ui32Index,
+                                   char *pcData, uint32_t ui32Size);
+extern void GrStringCacheInit(tStringCache *psCache, void *pvBuffer,
+                              uint32_t ui32Size, uint32_t ui32MaxLength);
+extern void GrStringCacheSet(tStringCache *psCache);
+extern void GrStringCacheFlush(tStringCache *psCache);
+extern const char *GrStringCachedGet(int32_t i32Index);
 extern int32_t GrRectOverlapCheck(tRectangle *psRect1, tRectangle *psRect2);
 extern int32_t GrRectIntersectGet(tRectangle *psRect1, tRectangle *psRect2,
                                   tRectangle *psIntersect);
@@ -2180,6 +3205,46 @@ GrDefaultStringRenderer(const tContext *psContext, const char *pcString,
                         int32_t i32Length, int32_t i32X, int32_t i32Y,
                         bool bOpaque);
 
+//*****************************************************************************
+//
+// Glyph cache functions.
+//
+//*****************************************************************************
+extern void GrGlyphCacheInit(tGlyphCache *psCache, void *pvBuffer,
+                             uint32_t ui32Size, uint32_t ui32MaxRuns,
+                             uint16_t *pui16Hash, uint32_t ui32NumBuckets);
+extern void GrGlyphCacheFlush(tGlyphCache *psCache);
+extern bool GrGlyphCacheRender(const tContext *psContext,
+                               uint32_t ui32CodePoint, int32_t i32X,
+                               int32_t i32Y, bool bCompressed, bool bOpaque,
+                               uint8_t *pui8Width);
+
+//*****************************************************************************
+//
+// Color cache functions.
+//
+//*****************************************************************************
+extern void GrColorCacheInit(tColorCache *psCache,
+                             tColorCacheEntry *psEntries,
+                             uint32_t ui32NumEntries);
+extern void GrColorCacheFlush(tColorCache *psCache);
+extern void GrDisplayColorCacheSet(tDisplay *psDisplay, tColorCache *psCache);
+extern uint32_t GrColorCacheTranslate(const tDisplay *psDisplay,
+                                      uint32_t ui32Value);
+
+//*****************************************************************************
+//
+// Font block index functions.
+//
+//*****************************************************************************
+extern void GrFontIndexInit(tFontIndex *psIndex, tFontBlock *psStorage,
+                            uint32_t ui32MaxBlocks);
+extern bool GrFontIndexBuild(tFontIndex *psIndex, const tFont *psFont);
+extern const uint8_t *GrFontIndexGlyphDataGet(tFontIndex *psIndex,
+                                              const tFont *psFont,
+                                              uint32_t ui32CodePoint,
+                                              uint8_t *pui8Width);
+
 //*****************************************************************************
 //
 // Codepage translation functions.
@@ -446,6 +446,84 @@ PixelTransparentDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
             }
         }
         break;
+
+        //
+        // 16 or 24 bit per pixel (native color) bitmap.
+        //
+        case 16:
+        case 24:
+        {
+            //
+            // Determine the number of bytes in each pixel.
+            //
+            i32NumBytes = (i32BPP & 0xFF) / 8;
+
+            //
+            // Scan all pixels in the line of data provided, plus one extra
+            // pass to draw any run that extends to the end of the line.
+            //
+            i32Start = 0;
+            i32Len = 0;
+            for(i32Index = 0; i32Index <= i32Count; i32Index++)
+            {
+                //
+                // Read the next pixel and determine whether it is transparent.
+                // The position after the end of the line is treated as being
+                // transparent so that the final run is drawn.
+                //
+                if(i32Index < i32Count)
+                {
+                    ui32Mask = pui8Data[i32Index * i32NumBytes] |
+                               (pui8Data[(i32Index * i32NumBytes) + 1] << 8);
+                    if(i32NumBytes == 3)
+                    {
+                        ui32Mask |= pui8Data[(i32Index * 3) + 2] << 16;
+                    }
+                    bSkip = (ui32Mask == ui32Transparent) ? true : false;
+                }
+                else
+                {
+                    bSkip = true;
+                }
+
+                //
+                // Is this pixel a transparent one?
+                //
+                if(!bSkip)
+                {
+                    //
+                    // It's not transparent.  Start a new run if we were
+                    // skipping pixels, then add this pixel to the run.
+                    //
+                    if(!i32Len)
+                    {
+                        i32Start = i32Index;
+                    }
+                    i32Len++;
+                }
+                else if(i32Len)
+                {
+                    //
+                    // Pixel is transparent and a run has ended, so draw it.
+                    //
+                    DpyPixelDrawMultiple(pContext->psDisplay, i32X + i32Start,
+                                         i32Y, 0, i32Len, i32BPP,
+                                         &pui8Data[i32Start * i32NumBytes],
+                                         pui8Palette);
+
+                    //
+                    // Reset for the transparent run.
+                    //
+                    i32Len = 0;
+
+                    //
+                    // Remember that we actually drew something.
+                    //
+                    bRet = true;
+                }
+            }
+        }
+        break;
     }
 
     //
@@ -454,6 +532,335 @@ PixelTransparentDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
     return(bRet);
 }
 
+//*****************************************************************************
+//
+// Decompresses a block of image data that was compressed as a single stream,
+// drawing the portion of each row that lies within the clipping region.  The
+// rows of the block start at the given Y coordinate; those above the clipping
+// region are decompressed but not drawn.
+//
+//*****************************************************************************
+static void
+CompressedRowsDraw(const tContext *pContext, const uint8_t *pui8Data,
+                   int32_t i32X, int32_t i32Y, int32_t i32Width,
+                   int32_t i32Rows, int32_t i32X0, int32_t i32X2,
+                   int32_t i32BPP, const uint8_t *pui8Palette,
+                   uint32_t ui32Transparent, bool bTransparent,
+                   int32_t *pi32Flag)
+{
+    uint32_t ui32Byte, ui32Bits, ui32Match, ui32Size, ui32Idx, ui32Count;
+    uint32_t ui32Num;
+    int32_t i32X1, i32XMask;
+
+    //
+    // Reset the dictionary used to uncompress the image.
+    //
+    for(ui32Bits = 0; ui32Bits < sizeof(g_pui8Dictionary); ui32Bits += 4)
+    {
+        *(uint32_t *)(g_pui8Dictionary + ui32Bits) = 0;
+    }
+
+    //
+    // Determine the number of bytes of data to decompress.
+    //
+    ui32Count = (((i32Width * i32BPP) + 7) / 8) * i32Rows;
+
+    //
+    // Initialize the pointer into the dictionary.
+    //
+    ui32Idx = 0;
+
+    //
+    // Start off with no encoding byte.
+    //
+    ui32Bits = 0;
+    ui32Byte = 0;
+
+    //
+    // Start from the upper left corner of the image.
+    //
+    i32X1 = 0;
+
+    //
+    // Loop while there are more rows or more data in the image.
+    //
+    while(i32Rows && ui32Count)
+    {
+        //
+        // See if an encoding byte needs to be read.
+        //
+        if(ui32Bits == 0)
+        {
+            //
+            // Read the encoding byte, which indicates if each of the
+            // following eight bytes are encoded or literal.
+            //
+            ui32Byte = *pui8Data++;
+            ui32Bits = 8;
+        }
+
+        //
+        // See if the next byte is encoded or literal.
+        //
+        if(ui32Byte & (1 << (ui32Bits - 1)))
+        {
+            //
+            // This byte is encoded, so extract the location and size of
+            // the encoded data within the dictionary.
+            //
+            ui32Match = *pui8Data >> 3;
+            ui32Size = (*pui8Data++ & 7) + 2;
+
+            //
+            // Decrement the count of bytes to decode by the number of
+            // copied bytes.
+            //
+            ui32Count -= ui32Size;
+        }
+        else
+        {
+            //
+            // This byte is a literal, so copy it into the dictionary.
+            //
+            g_pui8Dictionary[ui32Idx++] = *pui8Data++;
+
+            //
+            // Decrement the count of bytes to decode.
+            //
+            ui32Count--;
+
+            //
+            // Clear any previous encoded data information.
+            //
+            ui32Match = 0;
+            ui32Size = 0;
+        }
+
+        //
+        // Loop while there are bytes to copy for the encoded data, or
+        // once for literal data.
+        //
+        while(ui32Size || !(ui32Byte & (1 << (ui32Bits - 1))))
+        {
+            //
+            // Set the encoded data bit for this data so that this loop
+            // will only be executed once for literal data.
+            //
+            ui32Byte |= 1 << (ui32Bits - 1);
+
+            //
+            // Loop while there is more encoded data to copy and there is
+            // additional space in the dictionary (before the buffer
+            // wraps).
+            //
+            while(ui32Size && (ui32Idx != sizeof(g_pui8Dictionary)))
+            {
+                //
+                // Copy this byte.
+                //
+                g_pui8Dictionary[ui32Idx] =
+                    g_pui8Dictionary[(ui32Idx + ui32Match) %
+                                    sizeof(g_pui8Dictionary)];
+
+                //
+                // Increment the dictionary pointer.
+                //
+                ui32Idx++;
+
+                //
+                // Decrement the encoded data size.
+                //
+                ui32Size--;
+            }
+
+            //
+            // See if the dictionary pointer is about to wrap, or if there
+            // is no more data to decompress.
+            //
+            if((ui32Idx == sizeof(g_pui8Dictionary)) || !ui32Count)
+            {
+                //
+                // Loop through the data in the dictionary buffer.
+                //
+                for(ui32Idx = 0;
+                    (ui32Idx < sizeof(g_pui8Dictionary)) && i32Rows; )
+                {
+                    //
+                    // Compute the number of pixels that remain in the
+                    // dictionary buffer.
+                    //
+                    ui32Num = ((sizeof(g_pui8Dictionary) - ui32Idx) * 8) /
+                              i32BPP;
+
+                    //
+                    // See if any of the pixels in the dictionary buffer
+                    // are within the clipping region.
+                    //
+                    if((i32Y >= pContext->sClipRegion.i16YMin) &&
+                       ((i32X1 + ui32Num) > i32X0) && (i32X1 <= i32X2))
+                    {
+                        //
+                        // Skip some pixels at the start of the scan line
+                        // if required to stay within the clipping region.
+                        //
+                        if(i32X1 < i32X0)
+                        {
+                            ui32Idx += ((i32X0 - i32X1) * i32BPP) / 8;
+                            i32X1 = i32X0;
+
+                            //
+                            // Recompute the number of pixels that remain
+                            // in the dictionary buffer from the new
+                            // starting pixel.
+                            //
+                            ui32Num = ((((sizeof(g_pui8Dictionary) -
+                                          ui32Idx) * 8) -
+                                        ((i32X1 * i32BPP) & 7)) / i32BPP);
+                        }
+
+                        //
+                        // Shorten the scan line if required to stay within
+                        // the clipping region.
+                        //
+                        if(ui32Num > (i32X2 - i32X1 + 1))
+                        {
+                            ui32Num = i32X2 - i32X1 + 1;
+                        }
+
+                        //
+                        // Determine the starting offset for the first
+                        // source pixel within the byte.
+                        //
+                        switch(i32BPP)
+                        {
+
+                            case 1:
+                            {
+                                i32XMask = i32X1 & 7;
+                                break;
+                            }
+
+                            case 4:
+                            {
+                                i32XMask = i32X1 & 1;
+                                break;
+                            }
+
+                            default:
+                            {
+                                i32XMask = 0;
+                                break;
+                            }
+                        }
+
+                        //
+                        // Draw this row of image pixels.
+                        //
+                        if(bTransparent)
+                        {
+                            bool bRet;
+
+                            bRet = PixelTransparentDraw(pContext,
+                                                        i32X + i32X1,
+                                                        i32Y, i32XMask,
+                                                        ui32Num,
+                                                        i32BPP | *pi32Flag,
+                                                        g_pui8Dictionary +
+                                                        ui32Idx,
+                                                        pui8Palette,
+                                                        ui32Transparent);
+
+                            //
+                            // Clear the flag only if we actually drew
+                            // something.
+                            //
+                            if(bRet)
+                            {
+                                //
+                                // We drew something so that NEW_IMAGE
+                                // flag is no longer needed.
+                                //
+                                *pi32Flag = 0;
+                            }
+                        }
+                        else
+                        {
+                            DpyPixelDrawMultiple(pContext->psDisplay,
+                                                 i32X + i32X1, i32Y,
+                                                 i32XMask, ui32Num,
+                                                 i32BPP | *pi32Flag,
+                                                 g_pui8Dictionary + ui32Idx,
+                                                 pui8Palette);
+
+                            //
+                            // We've drawn the first line so clear the flag.
+                            //
+                            *pi32Flag = 0;
+                        }
+                    }
+
+                    //
+                    // Move the X coordinate back to the start of the first
+                    // data byte in this portion of the dictionary buffer.
+                    //
+                    i32X1 = ((i32X1 * i32BPP) & ~7) / i32BPP;
+
+                    //
+                    // See if the remainder of this scan line resides
+                    // within the dictionary buffer.
+                    //
+                    if(((((i32Width - i32X1) * i32BPP) + 7) / 8) >
+                       (sizeof(g_pui8Dictionary) - ui32Idx))
+                    {
+                        //
+                        // There is more to this scan line than is in the
+                        // dictionary buffer at this point, so move the
+                        // X coordinate by by the number of pixels in the
+                        // dictionary buffer.
+                        //
+                        i32X1 += (((sizeof(g_pui8Dictionary) - ui32Idx) *
+                                   8) / i32BPP);
+
+                        //
+                        // The entire dictionary buffer has been scanned.
+                        //
+                        ui32Idx = sizeof(g_pui8Dictionary);
+                    }
+                    else
+                    {
+                        //
+                        // The remainder of this scan line resides in the
+                        // dictionary buffer, so skip past it.
+                        //
+                        ui32Idx += (((i32Width - i32X1) * i32BPP) + 7) / 8;
+
+                        //
+                        // Move to the start of the next scan line.
+                        //
+                        i32X1 = 0;
+                        i32Y++;
+
+                        //
+                        // There is one less scan line to process.
+                        //
+                        i32Rows--;
+                    }
+                }
+
+                //
+                // Start over from the beginning of the dictionary buffer.
+                //
+                ui32Idx = 0;
+            }
+        }
+
+        //
+        // Advance to the next bit in the encoding byte.
+        //
+        ui32Bits--;
+    }
+}
+
 //*****************************************************************************
 //
 // Internal function implementing both normal and transparent image drawing.
@@ -464,11 +871,11 @@ InternalImageDraw(const tContext *pContext, const uint8_t *pui8Image,
                   int32_t i32X, int32_t i32Y, uint32_t ui32Transparent,
                   bool bTransparent)
 {
-    uint32_t ui32Byte, ui32Bits, ui32Match, ui32Size, ui32Idx, ui32Count;
-    uint32_t ui32Num;
     int32_t i32BPP, i32Width, i32Height, i32X0, i32X1, i32X2, i32XMask;
-    const uint8_t *pui8Palette;
-    uint32_t pui32BWPalette[2];
+    int32_t i32Band, i32BandRows, i32Rows;
+    const uint8_t *pui8Palette, *pui8Data;
+    uint32_t pui32BWPalette[2], ui32Offset;
+    tRectangle sRect;
     int32_t i32Flag;
 
     //
@@ -550,7 +957,7 @@ InternalImageDraw(const tContext *pContext, const uint8_t *pui8Image,
     //
     // Determine the color palette for the image based on the image format.
     //
-    if((i32BPP & 0x7f) == IMAGE_FMT_1BPP_UNCOMP)
+    if((i32BPP & 0x3f) == IMAGE_FMT_1BPP_UNCOMP)
     {
         //
         // Construct a local "black & white" palette based on the foreground
@@ -564,6 +971,16 @@ InternalImageDraw(const tContext *pContext, const uint8_t *pui8Image,
         //
         pui8Palette = (uint8_t *)pui32BWPalette;
     }
+    else if((i32BPP == IMAGE_FMT_16BPP_UNCOMP) ||
+            (i32BPP == IMAGE_FMT_24BPP_UNCOMP))
+    {
+        //
+        // 16 and 24 BPP images contain the pixel colors directly, so there is
+        // no palette.  Skip the reserved byte that follows the image header.
+        //
+        pui8Palette = 0;
+        pui8Image++;
+    }
     else
     {
         //
@@ -634,14 +1051,14 @@ InternalImageDraw(const tContext *pContext, const uint8_t *pui8Image,
         }
 
         //
-        // Loop while there are more rows to draw.
+        // See if the image is being drawn with a transparent color.
         //
-        while(i32Height--)
+        if(bTransparent)
         {
             //
-            // Draw this row of image pixels.
+            // Loop while there are more rows to draw.
             //
-            if(bTransparent)
+            while(i32Height--)
             {
                 bool bRet;
 
@@ -668,336 +1085,97 @@ InternalImageDraw(const tContext *pContext, const uint8_t *pui8Image,
                     //
                     i32Flag = 0;
                 }
-            }
-            else
-            {
-                DpyPixelDrawMultiple(pContext->psDisplay, i32X + i32X0,
-                                     i32Y, i32XMask, i32X2 - i32X0 + 1,
-                                     i32BPP | i32Flag, pui8Image +
-                                     ((i32X0 * i32BPP) / 8), pui8Palette);
 
                 //
-                // Clear the flag since we've drawn the first line now.
+                // Skip past the data for this row.
                 //
-                i32Flag = 0;
-            }
-
-            //
-            // Skip past the data for this row.
-            //
-            pui8Image += ((i32Width * i32BPP) + 7) / 8;
+                pui8Image += ((i32Width * i32BPP) + 7) / 8;
 
+                //
+                // Increment the Y coordinate.
+                //
+                i32Y++;
+            }
+        }
+        else
+        {
             //
-            // Increment the Y coordinate.
+            // Draw the visible portion of the image as a single rectangle of
+            // pixels, which the display driver can stream to the display if
+            // it provides a blit function.
             //
-            i32Y++;
+            sRect.i16XMin = i32X + i32X0;
+            sRect.i16YMin = i32Y;
+            sRect.i16XMax = i32X + i32X2;
+            sRect.i16YMax = i32Y + i32Height - 1;
+            DpyBlit(pContext->psDisplay, &sRect, i32XMask, i32BPP | i32Flag,
+                    pui8Image + ((i32X0 * i32BPP) / 8),
+                    ((i32Width * i32BPP) + 7) / 8, pui8Palette);
         }
     }
+    else if(!(i32BPP & 0x40))
+    {
+        //
+        // The image is compressed as a single stream, which must be
+        // decompressed from the start up to the last visible row.
+        //
+        CompressedRowsDraw(pContext, pui8Image, i32X, i32Y, i32Width,
+                           i32Height, i32X0, i32X2, i32BPP & 0x3f,
+                           pui8Palette, ui32Transparent, bTransparent,
+                           &i32Flag);
+    }
     else
     {
         //
-        // The image is compressed.  Clear the compressed flag in the format
-        // specifier so that the bits per pixel remains.
+        // The image is compressed in bands of rows, each of which is a
+        // separate stream that starts with an empty dictionary.  Get the
+        // number of rows in each band; the offsets of the bands follow,
+        // measured from this byte.
         //
-        i32BPP &= 0x7f;
+        i32BandRows = pui8Image[0];
 
         //
-        // Reset the dictionary used to uncompress the image.
+        // Skip the bands which lie entirely above the clipping region.
         //
-        for(ui32Bits = 0; ui32Bits < sizeof(g_pui8Dictionary); ui32Bits += 4)
+        if(i32Y < pContext->sClipRegion.i16YMin)
         {
-            *(uint32_t *)(g_pui8Dictionary + ui32Bits) = 0;
+            i32Band = (pContext->sClipRegion.i16YMin - i32Y) / i32BandRows;
         }
+        else
+        {
+            i32Band = 0;
+        }
+        i32Y += i32Band * i32BandRows;
+        i32Height -= i32Band * i32BandRows;
 
         //
-        // Determine the number of bytes of data to decompress.
-        //
-        ui32Count = (((i32Width * i32BPP) + 7) / 8) * i32Height;
-
-        //
-        // Initialize the pointer into the dictionary.
-        //
-        ui32Idx = 0;
-
-        //
-        // Start off with no encoding byte.
-        //
-        ui32Bits = 0;
-        ui32Byte = 0;
-
-        //
-        // Start from the upper left corner of the image.
-        //
-        i32X1 = 0;
-
-        //
-        // Loop while there are more rows or more data in the image.
+        // Loop while there are more rows to draw.
         //
-        while(i32Height && ui32Count)
+        while(i32Height > 0)
         {
             //
-            // See if an encoding byte needs to be read.
+            // Get the offset of the compressed data for this band.
             //
-            if(ui32Bits == 0)
-            {
-                //
-                // Read the encoding byte, which indicates if each of the
-                // following eight bytes are encoded or literal.
-                //
-                ui32Byte = *pui8Image++;
-                ui32Bits = 8;
-            }
+            pui8Data = pui8Image + 1 + (i32Band * 4);
+            ui32Offset = (pui8Data[0] | (pui8Data[1] << 8) |
+                          (pui8Data[2] << 16) | (pui8Data[3] << 24));
 
             //
-            // See if the next byte is encoded or literal.
+            // Draw the visible rows of this band, stopping at the bottom of
+            // the clipping region.
             //
-            if(ui32Byte & (1 << (ui32Bits - 1)))
-            {
-                //
-                // This byte is encoded, so extract the location and size of
-                // the encoded data within the dictionary.
-                //
-                ui32Match = *pui8Image >> 3;
-                ui32Size = (*pui8Image++ & 7) + 2;
-
-                //
-                // Decrement the count of bytes to decode by the number of
-                // copied bytes.
-                //
-                ui32Count -= ui32Size;
-            }
-            else
-            {
-                //
-                // This byte is a literal, so copy it into the dictionary.
-                //
-                g_pui8Dictionary[ui32Idx++] = *pui8Image++;
-
-                //
-                // Decrement the count of bytes to decode.
-                //
-                ui32Count--;
-
-                //
-                // Clear any previous encoded data information.
-                //
-                ui32Match = 0;
-                ui32Size = 0;
-            }
+            i32Rows = (i32Height < i32BandRows) ? i32Height : i32BandRows;
+            CompressedRowsDraw(pContext, pui8Image + ui32Offset, i32X, i32Y,
+                               i32Width, i32Rows, i32X0, i32X2, i32BPP & 0x3f,
+                               pui8Palette, ui32Transparent, bTransparent,
+                               &i32Flag);
 
             //
-            // Loop while there are bytes to copy for the encoded data, or
-            // once for literal data.
+            // Move to the next band.
             //
-            while(ui32Size || !(ui32Byte & (1 << (ui32Bits - 1))))
-            {
-                //
-                // Set the encoded data bit for this data so that this loop
-                // will only be executed once for literal data.
-                //
-                ui32Byte |= 1 << (ui32Bits - 1);
-
-                //
-                // Loop while there is more encoded data to copy and there is
-                // additional space in the dictionary (before the buffer
-                // wraps).
-                //
-                while(ui32Size && (ui32Idx != sizeof(g_pui8Dictionary)))
-                {
-                    //
-                    // Copy this byte.
-                    //
-                    g_pui8Dictionary[ui32Idx] =
-                        g_pui8Dictionary[(ui32Idx + ui32Match) %
-                                        sizeof(g_pui8Dictionary)];
-
-                    //
-                    // Increment the dictionary pointer.
-                    //
-                    ui32Idx++;
-
-                    //
-                    // Decrement the encoded data size.
-                    //
-                    ui32Size--;
-                }
-
-                //
-                // See if the dictionary pointer is about to wrap, or if there
-                // is no more data to decompress.
-                //
-                if((ui32Idx == sizeof(g_pui8Dictionary)) || !ui32Count)
-                {
-                    //
-                    // Loop through the data in the dictionary buffer.
-                    //
-                    for(ui32Idx = 0;
-                        (ui32Idx < sizeof(g_pui8Dictionary)) && i32Height; )
-                    {
-                        //
-                        // Compute the number of pixels that remain in the
-                        // dictionary buffer.
-                        //
-                        ui32Num = ((sizeof(g_pui8Dictionary) - ui32Idx) * 8) /
-                                  i32BPP;
-
-                        //
-                        // See if any of the pixels in the dictionary buffer
-                        // are within the clipping region.
-                        //
-                        if((i32Y >= pContext->sClipRegion.i16YMin) &&
-                           ((i32X1 + ui32Num) >= i32X0) && (i32X1 <= i32X2))
-                        {
-                            //
-                            // Skip some pixels at the start of the scan line
-                            // if required to stay within the clipping region.
-                            //
-                            if(i32X1 < i32X0)
-                            {
-                                ui32Idx += ((i32X0 - i32X1) * i32BPP) / 8;
-                                i32X1 = i32X0;
-                            }
-
-                            //
-                            // Shorten the scan line if required to stay within
-                            // the clipping region.
-                            //
-                            if(ui32Num > (i32X2 - i32X1 + 1))
-                            {
-                                ui32Num = i32X2 - i32X1 + 1;
-                            }
-
-                            //
-                            // Determine the starting offset for the first
-                            // source pixel within the byte.
-                            //
-                            switch(i32BPP)
-                            {
-
-                                case 1:
-                                {
-                                    i32XMask = i32X1 & 7;
-                                    break;
-                                }
-
-                                case 4:
-                                {
-                                    i32XMask = i32X1 & 1;
-                                    break;
-                                }
-
-                                default:
-                                {
-                                    i32XMask = 0;
-                                    break;
-                                }
-                            }
-
-                            //
-                            // Draw this row of image pixels.
-                            //
-                            if(bTransparent)
-                            {
-                                bool bRet;
-
-                                bRet = PixelTransparentDraw(pContext,
-                                                            i32X + i32X1,
-                                                            i32Y, i32XMask,
-                                                            ui32Num,
-                                                            i32BPP | i32Flag,
-                                                            g_pui8Dictionary +
-                                                            ui32Idx,
-                                                            pui8Palette,
-                                                            ui32Transparent);
-
-                                //
-                                // Clear the flag only if we actually drew
-                                // something.
-                                //
-                                if(bRet)
-                                {
-                                    //
-                                    // We drew something so that NEW_IMAGE
-                                    // flag is no longer needed.
-                                    //
-                                    i32Flag = 0;
-                                }
-                            }
-                            else
-                            {
-                                DpyPixelDrawMultiple(pContext->psDisplay,
-                                                     i32X + i32X1, i32Y,
-                                                     i32XMask, ui32Num,
-                                                     i32BPP | i32Flag,
-                                                     g_pui8Dictionary + ui32Idx,
-                                                     pui8Palette);
-
-                                //
-                                // We've drawn the first line so clear the flag.
-                                //
-                                i32Flag = 0;
-                            }
-                        }
-
-                        //
-                        // Move the X coordinate back to the start of the first
-                        // data byte in this portion of the dictionary buffer.
-                        //
-                        i32X1 = ((i32X1 * i32BPP) & ~7) / i32BPP;
-
-                        //
-                        // See if the remainder of this scan line resides
-                        // within the dictionary buffer.
-                        //
-                        if(((((i32Width - i32X1) * i32BPP) + 7) / 8) >
-                           (sizeof(g_pui8Dictionary) - ui32Idx))
-                        {
-                            //
-                            // There is more to this scan line than is in the
-                            // dictionary buffer at this point, so move the
-                            // X coordinate by by the number of pixels in the
-                            // dictionary buffer.
-                            //
-                            i32X1 += (((sizeof(g_pui8Dictionary) - ui32Idx) *
-                                       8) / i32BPP);
-
-                            //
-                            // The entire dictionary buffer has been scanned.
-                            //
-                            ui32Idx = sizeof(g_pui8Dictionary);
-                        }
-                        else
-                        {
-                            //
-                            // The remainder of this scan line resides in the
-                            // dictionary buffer, so skip past it.
-                            //
-                            ui32Idx += (((i32Width - i32X1) * i32BPP) + 7) / 8;
-
-                            //
-                            // Move to the start of the next scan line.
-                            //
-                            i32X1 = 0;
-                            i32Y++;
-
-                            //
-                            // There is one less scan line to process.
-                            //
-                            i32Height--;
-                        }
-                    }
-
-                    //
-                    // Start over from the beginning of the dictionary buffer.
-                    //
-                    ui32Idx = 0;
-                }
-            }
-
-            //
-            // Advance to the next bit in the encoding byte.
-            //
-            ui32Bits--;
+            i32Y += i32Rows;
+            i32Height -= i32Rows;
+            i32Band++;
         }
     }
 }
@@ -1024,7 +1202,9 @@ InternalImageDraw(const tContext *pContext, const uint8_t *pui8Image,
 //! images, the \b ui32Transparent parameter contains the palette index of the
 //! colour which is to be considered transparent.  For 1bpp images, the
 //! \b ui32Transparent parameter should be set to 0 to draw only foreground
-//! pixels or 1 to draw only background pixels.
+//! pixels or 1 to draw only background pixels.  For uncompressed 16bpp and
+//! 24bpp images, the \b ui32Transparent parameter contains the 5-6-5 RGB or
+//! 24-bit RGB pixel value which is to be considered transparent.
 //!
 //! \return None.
 //
@@ -1052,7 +1232,15 @@ GrTransparentImageDraw(const tContext *pContext, const uint8_t *pui8Image,
 //! pixel (using a palette supplied in the image data).  It can be uncompressed
 //! data, or it can be compressed using the Lempel-Ziv-Storer-Szymanski
 //! algorithm (as published in the Journal of the ACM, 29(4):928-951, October
-//! 1982).
+//! 1982).  Compressed images may be divided into bands of rows which are
+//! compressed separately (\b IMAGE_FMT_1BPP_COMP_BANDED,
+//! \b IMAGE_FMT_4BPP_COMP_BANDED and \b IMAGE_FMT_8BPP_COMP_BANDED), in which
+//! case only the bands that lie within the clipping region are decompressed.
+//!
+//! Uncompressed 16 bit per pixel (5-6-5 RGB) and 24 bit per pixel (8-8-8 RGB)
+//! images, such as those produced by the 16 BPP and 24 BPP off-screen display
+//! drivers, may also be drawn provided that the target display driver
+//! supports these formats in its PixelDrawMultiple function.
 //!
 //! \return None.
 //
@@ -41,6 +41,8 @@
 //! Draws an image button.
 //!
 //! \param psWidget is a pointer to the image button widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a rectangular image button on the display.  This is
 //! called in response to a \b #WIDGET_MSG_PAINT message.
@@ -49,7 +51,7 @@
 //
 //*****************************************************************************
 static void
-ImageButtonPaint(tWidget *psWidget)
+ImageButtonPaint(tWidget *psWidget, tRectangle *psClip)
 {
     const uint8_t *pui8Image;
     tImageButtonWidget *psPush;
@@ -75,7 +77,7 @@ ImageButtonPaint(tWidget *psWidget)
     // Initialize the clipping region based on the extents of this rectangular
     // image button.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // Compute the center of the image button.
@@ -216,7 +218,7 @@ ImageButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
         //
         // Redraw the button in the released state.
         //
-        ImageButtonPaint(psWidget);
+        ImageButtonPaint(psWidget, &(psWidget->sPosition));
 
         //
         // If the pointer is still within the button bounds, and it is a
@@ -247,7 +249,7 @@ ImageButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
             //
             // Draw the button in the pressed state.
             //
-            ImageButtonPaint(psWidget);
+            ImageButtonPaint(psWidget, &(psWidget->sPosition));
         }
 
         //
@@ -339,6 +341,8 @@ int32_t
 ImageButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
                    uint32_t ui32Param1, uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -355,9 +359,14 @@ ImageButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            ImageButtonPaint(psWidget);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                ImageButtonPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
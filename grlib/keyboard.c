@@ -449,12 +449,65 @@ const tKeyboard g_psKeyboardUSEnglish[NUM_KEYBOARD_US_ENGLISH] =
 #define FLAG_KEY_PRESSED        0x00000001
 #define FLAG_KEY_CAPSLOCK       0x00000002
 
+//*****************************************************************************
+//
+// The number of columns and rows in the grid used to find the key under the
+// pointer, and the value stored in the grid for a cell which no key overlaps.
+//
+//*****************************************************************************
+#define GRID_COLUMNS            16
+#define GRID_ROWS               8
+#define GRID_NO_KEY             0xff
+
+//*****************************************************************************
+//
+// The grid used to find the key under the pointer.  Each cell records the
+// index of the first and last keys which overlap it.  Only one keyboard is
+// used at a time, so the grid is shared by all keyboard widgets and is built
+// for the keyboard, widget, and widget position most recently searched.
+//
+//*****************************************************************************
+static uint8_t g_pui8GridFirst[GRID_COLUMNS * GRID_ROWS];
+static uint8_t g_pui8GridLast[GRID_COLUMNS * GRID_ROWS];
+static const tKeyboardWidget *g_psGridWidget;
+static const tKeyboard *g_psGridKeyboard;
+static tRectangle g_sGridPosition;
+
+//*****************************************************************************
+//
+// Computes the rectangle drawn for a key on the keyboard.
+//
+//*****************************************************************************
+static void
+KeyRectGet(tWidget *psWidget, const tKeyText *psKey, tRectangle *psRect)
+{
+    uint32_t ui32Range;
+
+    ui32Range = psWidget->sPosition.i16XMax - psWidget->sPosition.i16XMin + 1;
+    psRect->i16XMin = psWidget->sPosition.i16XMin + 1;
+    psRect->i16XMin += (ui32Range * (uint32_t)psKey->ui16XPos) / 10000;
+
+    psRect->i16XMax = psRect->i16XMin - 3 +
+                      ((ui32Range * (uint32_t)psKey->ui16Width) / 10000);
+
+    ui32Range = psWidget->sPosition.i16YMax - psWidget->sPosition.i16YMin + 1;
+    psRect->i16YMin = psWidget->sPosition.i16YMin + 1;
+    psRect->i16YMin += (ui32Range * (uint32_t)psKey->ui16YPos) / 10000;
+
+    psRect->i16YMax = psRect->i16YMin - 3 +
+                      ((ui32Range * (uint32_t)psKey->ui16Height) / 10000);
+}
+
 //*****************************************************************************
 //
 //! Draws a key on the keyboard.
 //!
 //! \param psWidget is a pointer to the keyboard widget to be drawn.
 //! \param psKey is a pointer to the key to draw.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
+//! \param bPressed is \b true if the key should be drawn in its pressed
+//! state.
 //!
 //! This function draws a single key on the display.  This is called whenever
 //! a key on the keyboard needs to be updated.
@@ -463,12 +516,13 @@ const tKeyboard g_psKeyboardUSEnglish[NUM_KEYBOARD_US_ENGLISH] =
 //
 //*****************************************************************************
 static void
-ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
+ButtonPaintText(tWidget *psWidget, const tKeyText *psKey,
+                tRectangle *psClip, bool bPressed)
 {
     tKeyboardWidget *psKeyboard;
     tContext sCtx;
     int32_t i32X, i32Y;
-    uint32_t ui32Range, ui32Size;
+    uint32_t ui32Size;
     tRectangle sRect;
     char pcKeyCap[4];
 
@@ -490,24 +544,12 @@ ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
     //
     // Initialize the clipping region based on the extents of this keyboard.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // Calculate a keys bounding box.
     //
-    ui32Range = psWidget->sPosition.i16XMax - psWidget->sPosition.i16XMin + 1;
-    sRect.i16XMin = psWidget->sPosition.i16XMin + 1;
-    sRect.i16XMin += (ui32Range * (uint32_t)psKey->ui16XPos) / 10000;
-
-    sRect.i16XMax = sRect.i16XMin - 3 +
-                    ((ui32Range * (uint32_t)psKey->ui16Width) / 10000);
-
-    ui32Range = psWidget->sPosition.i16YMax - psWidget->sPosition.i16YMin + 1;
-    sRect.i16YMin = psWidget->sPosition.i16YMin + 1;
-    sRect.i16YMin += (ui32Range * (uint32_t)psKey->ui16YPos) / 10000;
-
-    sRect.i16YMax = sRect.i16YMin - 3 +
-                    ((ui32Range * (uint32_t)psKey->ui16Height) / 10000);
+    KeyRectGet(psWidget, psKey, &sRect);
 
     //
     // See if the keyboard fill style is selected.
@@ -517,10 +559,9 @@ ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
         //
         // Fill the key with the fill color.
         //
-        GrContextForegroundSet(&sCtx,
-                               ((psKeyboard->ui32Flags & FLAG_KEY_PRESSED) ?
-                                psKeyboard->ui32PressFillColor :
-                                psKeyboard->ui32FillColor));
+        GrContextForegroundSet(&sCtx, (bPressed ?
+                                       psKeyboard->ui32PressFillColor :
+                                       psKeyboard->ui32FillColor));
         GrRectFill(&sCtx, &sRect);
     }
 
@@ -545,14 +586,21 @@ ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
     //
     // If the keyboard outline style is selected then shrink the
     // clipping region by one pixel on each side so that the outline is not
-    // overwritten by the text or image.
+    // overwritten by the text or image.  There is no text to draw if none of
+    // the remaining region is being drawn.
     //
     if(psKeyboard->ui32Style & KEYBOARD_STYLE_OUTLINE)
     {
-        sCtx.sClipRegion.i16XMin++;
-        sCtx.sClipRegion.i16YMin++;
-        sCtx.sClipRegion.i16XMax--;
-        sCtx.sClipRegion.i16YMax--;
+        sRect = psWidget->sPosition;
+        sRect.i16XMin++;
+        sRect.i16YMin++;
+        sRect.i16XMax--;
+        sRect.i16YMax--;
+        if(!GrRectIntersectGet(&sRect, &(sCtx.sClipRegion),
+                               &(sCtx.sClipRegion)))
+        {
+            return;
+        }
     }
 
     //
@@ -560,10 +608,8 @@ ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
     //
     GrContextFontSet(&sCtx, psKeyboard->psFont);
     GrContextForegroundSet(&sCtx, psKeyboard->ui32TextColor);
-    GrContextBackgroundSet(&sCtx,
-                           ((psKeyboard->ui32Flags & FLAG_KEY_PRESSED) ?
-                            psKeyboard->ui32PressFillColor :
-                            psKeyboard->ui32FillColor));
+    GrContextBackgroundSet(&sCtx, (bPressed ? psKeyboard->ui32PressFillColor :
+                                   psKeyboard->ui32FillColor));
 
     ui32Size = 0;
 
@@ -608,6 +654,8 @@ ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
 //! Draws a the full keyboard.
 //!
 //! \param psWidget is a pointer to the keyboard widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a the full keyboard.  This is called whenever
 //! the full keyboard needs to be updated.
@@ -616,11 +664,12 @@ ButtonPaintText(tWidget *psWidget, const tKeyText *psKey)
 //
 //*****************************************************************************
 static void
-KeyboardPaint(tWidget *psWidget)
+KeyboardPaint(tWidget *psWidget, tRectangle *psClip)
 {
     int32_t i32Key;
     tKeyboardWidget *psKeyboardWidget;
     const tKeyboard *psKeyboard;
+    tRectangle sRect;
     tContext sCtx;
 
     //
@@ -638,7 +687,7 @@ KeyboardPaint(tWidget *psWidget)
     //
     // Initialize the clipping region based on the extents of this keyboard.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // Fill the keyboard with the fill color.
@@ -649,10 +698,231 @@ KeyboardPaint(tWidget *psWidget)
         GrRectFill(&sCtx, &psWidget->sPosition);
     }
 
+    //
+    // Draw the keys which lie within the region being drawn, showing the key
+    // which is being held down, if any, in its pressed state.
+    //
     for(i32Key = 0; i32Key < psKeyboard->ui16NumKeys; i32Key++)
     {
-        ButtonPaintText(psWidget, &psKeyboard->uKeys.psKeysText[i32Key]);
+        KeyRectGet(psWidget, &psKeyboard->uKeys.psKeysText[i32Key], &sRect);
+        if(!GrRectOverlapCheck(&sRect, psClip))
+        {
+            continue;
+        }
+        ButtonPaintText(psWidget, &psKeyboard->uKeys.psKeysText[i32Key],
+                        psClip,
+                        ((psKeyboardWidget->ui32Flags & FLAG_KEY_PRESSED) &&
+                         (psKeyboardWidget->ui32KeyPressed ==
+                          (uint32_t)i32Key)));
+    }
+}
+
+//*****************************************************************************
+//
+// Draws the keyboard after the active keyboard has been changed.
+//
+// \param psWidget is a pointer to the keyboard widget.
+// \param ui32Previous is the index of the keyboard that was active before.
+//
+// When the new keyboard has the same arrangement of keys as the previous one
+// (as the upper and lower case keyboards do), only the keys which show a
+// different character are drawn.  Otherwise the full keyboard is drawn.
+//
+// \return None.
+//
+//*****************************************************************************
+static void
+KeyboardSwitchPaint(tWidget *psWidget, uint32_t ui32Previous)
+{
+    tKeyboardWidget *psKeyboardWidget;
+    const tKeyboard *psKeyboard, *psPrevious;
+    const tKeyText *psOld, *psNew;
+    uint32_t ui32Key, ui32NumKeys;
+
+    //
+    // Convert the generic widget pointer into a keyboard widget pointer.
+    //
+    psKeyboardWidget = (tKeyboardWidget *)psWidget;
+
+    psKeyboard = &psKeyboardWidget->psKeyboards[psKeyboardWidget->ui32Active];
+    psPrevious = &psKeyboardWidget->psKeyboards[ui32Previous];
+
+    //
+    // Draw the full keyboard if the number of keys differs.
+    //
+    ui32NumKeys = psKeyboard->ui16NumKeys;
+    if(ui32NumKeys != psPrevious->ui16NumKeys)
+    {
+        KeyboardPaint(psWidget, &(psWidget->sPosition));
+        return;
+    }
+
+    //
+    // Draw the full keyboard if any of the keys have moved.
+    //
+    psOld = psPrevious->uKeys.psKeysText;
+    psNew = psKeyboard->uKeys.psKeysText;
+    for(ui32Key = 0; ui32Key < ui32NumKeys; ui32Key++)
+    {
+        if((psOld[ui32Key].ui16XPos != psNew[ui32Key].ui16XPos) ||
+           (psOld[ui32Key].ui16YPos != psNew[ui32Key].ui16YPos) ||
+           (psOld[ui32Key].ui16Width != psNew[ui32Key].ui16Width) ||
+           (psOld[ui32Key].ui16Height != psNew[ui32Key].ui16Height))
+        {
+            KeyboardPaint(psWidget, &(psWidget->sPosition));
+            return;
+        }
+    }
+
+    //
+    // Draw the keys whose character has changed.
+    //
+    for(ui32Key = 0; ui32Key < ui32NumKeys; ui32Key++)
+    {
+        if(psOld[ui32Key].ui32Code != psNew[ui32Key].ui32Code)
+        {
+            ButtonPaintText(psWidget, &psNew[ui32Key], &(psWidget->sPosition),
+                            false);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Determines if a given X/Y position, scaled by 10000, is within the bounds of
+// a key on the keyboard.
+//
+//*****************************************************************************
+static bool
+KeyContains(tKeyboardWidget *psKeyWidget, const tKeyText *psKey,
+            int32_t i32X, int32_t i32Y)
+{
+    uint32_t ui32Range;
+    int32_t i32XMin, i32XMax, i32YMin, i32YMax;
+
+    //
+    // Find the X bounds of the key.
+    //
+    ui32Range = psKeyWidget->sBase.sPosition.i16XMax -
+                psKeyWidget->sBase.sPosition.i16XMin + 1;
+    i32XMin = psKeyWidget->sBase.sPosition.i16XMin * 10000;
+    i32XMin += (ui32Range * (uint32_t)psKey->ui16XPos);
+
+    i32XMax = i32XMin + (ui32Range * (uint32_t)psKey->ui16Width);
+
+    //
+    // Find the Y bounds of the key.
+    //
+    ui32Range = psKeyWidget->sBase.sPosition.i16YMax -
+                psKeyWidget->sBase.sPosition.i16YMin + 1;
+    i32YMin = psKeyWidget->sBase.sPosition.i16YMin * 10000;
+    i32YMin += (ui32Range * (uint32_t)psKey->ui16YPos);
+
+    i32YMax = i32YMin + (ui32Range * (uint32_t)psKey->ui16Height);
+
+    return((i32X >= i32XMin) && (i32X <= i32XMax) &&
+           (i32Y >= i32YMin) && (i32Y <= i32YMax));
+}
+
+//*****************************************************************************
+//
+// Finds the range of pixels, relative to the edge of the keyboard, which lie
+// within a key along one axis, and converts them to a range of grid cells.
+// Returns false if no pixel within the keyboard lies within the key.
+//
+//*****************************************************************************
+static bool
+KeyGridRangeGet(uint32_t ui32Range, uint32_t ui32Pos, uint32_t ui32Size,
+                uint32_t ui32Cells, uint32_t *pui32First, uint32_t *pui32Last)
+{
+    uint32_t ui32Min, ui32Max;
+
+    //
+    // Find the first and last pixels whose scaled position lies within the
+    // key, using the same bounds as KeyContains().
+    //
+    ui32Min = ((ui32Range * ui32Pos) + 9999) / 10000;
+    ui32Max = (ui32Range * (ui32Pos + ui32Size)) / 10000;
+    if(ui32Max >= ui32Range)
+    {
+        ui32Max = ui32Range - 1;
+    }
+    if(ui32Min > ui32Max)
+    {
+        return(false);
     }
+
+    //
+    // Convert the pixels to grid cells.
+    //
+    *pui32First = (ui32Min * ui32Cells) / ui32Range;
+    *pui32Last = (ui32Max * ui32Cells) / ui32Range;
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Builds the grid used to find the key under the pointer for the active
+// keyboard.  Each cell of the grid records the first and last keys which
+// overlap it; since keys are searched in order, only the keys in that range
+// need to be checked for a position within the cell.
+//
+//*****************************************************************************
+static void
+KeyGridBuild(tKeyboardWidget *psKeyWidget, const tKeyboard *psKeyboard)
+{
+    uint32_t ui32Key, ui32Cell, ui32Col, ui32Row, ui32XRange, ui32YRange;
+    uint32_t ui32ColFirst, ui32ColLast, ui32RowFirst, ui32RowLast;
+    const tKeyText *psKey;
+
+    //
+    // Start with no keys in any of the cells.
+    //
+    for(ui32Cell = 0; ui32Cell < (GRID_COLUMNS * GRID_ROWS); ui32Cell++)
+    {
+        g_pui8GridFirst[ui32Cell] = GRID_NO_KEY;
+        g_pui8GridLast[ui32Cell] = 0;
+    }
+
+    ui32XRange = psKeyWidget->sBase.sPosition.i16XMax -
+                 psKeyWidget->sBase.sPosition.i16XMin + 1;
+    ui32YRange = psKeyWidget->sBase.sPosition.i16YMax -
+                 psKeyWidget->sBase.sPosition.i16YMin + 1;
+
+    //
+    // Add each key to the cells which it overlaps.  Keys are added in order,
+    // so the first key to reach a cell is the first in its range.
+    //
+    for(ui32Key = 0; ui32Key < psKeyboard->ui16NumKeys; ui32Key++)
+    {
+        psKey = &psKeyboard->uKeys.psKeysText[ui32Key];
+        if(!KeyGridRangeGet(ui32XRange, psKey->ui16XPos, psKey->ui16Width,
+                            GRID_COLUMNS, &ui32ColFirst, &ui32ColLast) ||
+           !KeyGridRangeGet(ui32YRange, psKey->ui16YPos, psKey->ui16Height,
+                            GRID_ROWS, &ui32RowFirst, &ui32RowLast))
+        {
+            continue;
+        }
+        for(ui32Row = ui32RowFirst; ui32Row <= ui32RowLast; ui32Row++)
+        {
+            for(ui32Col = ui32ColFirst; ui32Col <= ui32ColLast; ui32Col++)
+            {
+                ui32Cell = (ui32Row * GRID_COLUMNS) + ui32Col;
+                if(g_pui8GridFirst[ui32Cell] == GRID_NO_KEY)
+                {
+                    g_pui8GridFirst[ui32Cell] = ui32Key;
+                }
+                g_pui8GridLast[ui32Cell] = ui32Key;
+            }
+        }
+    }
+
+    //
+    // The grid is now valid for this keyboard in this widget.
+    //
+    g_psGridWidget = psKeyWidget;
+    g_psGridKeyboard = psKeyboard;
+    g_sGridPosition = psKeyWidget->sBase.sPosition;
 }
 
 //*****************************************************************************
@@ -669,6 +939,13 @@ KeyboardPaint(tWidget *psWidget)
 // key is returned if the key is not found the value is maximum number of keys
 // for the given keyboard indicated by psKeyboard->ui16NumKeys.
 //
+// Positions within the keyboard are looked up in the key grid, which is built
+// the first time the active keyboard is searched, so that only the keys which
+// overlap that part of the keyboard are checked.  Positions outside of the
+// keyboard (which are only seen while the pointer is dragged) and keyboards
+// with too many keys to be recorded in the grid are checked against every
+// key.
+//
 // \return The key found or psKeyboard->ui16NumKeys if no key was found.
 //
 //*****************************************************************************
@@ -676,49 +953,81 @@ static uint32_t
 FindKey(tKeyboardWidget *psKeyWidget, const tKeyboard *psKeyboard,
         int32_t i32X, int32_t i32Y)
 {
-    uint32_t ui32Key;
-    uint32_t ui32Range;
-    int32_t i32XMin, i32XMax, i32YMin, i32YMax;
-    const tKeyText *psKey;
+    uint32_t ui32Key, ui32End, ui32Cell, ui32XRange, ui32YRange;
+    int32_t i32XOff, i32YOff;
 
     //
-    // Pre-scale the positions to multiples of 10000.
+    // Start with every key as a candidate.
     //
-    i32X *= 10000;
-    i32Y *= 10000;
+    ui32Key = 0;
+    ui32End = psKeyboard->ui16NumKeys;
 
-    for(ui32Key = 0; ui32Key < psKeyboard->ui16NumKeys; ui32Key++)
-    {
-        psKey = &psKeyboard->uKeys.psKeysText[ui32Key];
+    //
+    // Get the position relative to the keyboard.
+    //
+    ui32XRange = psKeyWidget->sBase.sPosition.i16XMax -
+                 psKeyWidget->sBase.sPosition.i16XMin + 1;
+    ui32YRange = psKeyWidget->sBase.sPosition.i16YMax -
+                 psKeyWidget->sBase.sPosition.i16YMin + 1;
+    i32XOff = i32X - psKeyWidget->sBase.sPosition.i16XMin;
+    i32YOff = i32Y - psKeyWidget->sBase.sPosition.i16YMin;
 
+    //
+    // Use the key grid if the position is within the keyboard and the key
+    // indices fit in the grid.
+    //
+    if((psKeyboard->ui16NumKeys < GRID_NO_KEY) && (i32XOff >= 0) &&
+       (i32XOff < (int32_t)ui32XRange) && (i32YOff >= 0) &&
+       (i32YOff < (int32_t)ui32YRange))
+    {
         //
-        // Find the X bounds of the key.
+        // Build the grid if it was built for a different keyboard or widget,
+        // or before the widget was moved.
         //
-        ui32Range = psKeyWidget->sBase.sPosition.i16XMax -
-                    psKeyWidget->sBase.sPosition.i16XMin + 1;
-        i32XMin = psKeyWidget->sBase.sPosition.i16XMin * 10000;
-        i32XMin += (ui32Range * (uint32_t)psKey->ui16XPos);
-
-        i32XMax = i32XMin + (ui32Range * (uint32_t)psKey->ui16Width);
+        if((g_psGridWidget != psKeyWidget) ||
+           (g_psGridKeyboard != psKeyboard) ||
+           (g_sGridPosition.i16XMin != psKeyWidget->sBase.sPosition.i16XMin) ||
+           (g_sGridPosition.i16YMin != psKeyWidget->sBase.sPosition.i16YMin) ||
+           (g_sGridPosition.i16XMax != psKeyWidget->sBase.sPosition.i16XMax) ||
+           (g_sGridPosition.i16YMax != psKeyWidget->sBase.sPosition.i16YMax))
+        {
+            KeyGridBuild(psKeyWidget, psKeyboard);
+        }
 
         //
-        // Find the Y bounds of the key.
+        // Find the range of keys which overlap the cell containing this
+        // position.
         //
-        ui32Range = psKeyWidget->sBase.sPosition.i16YMax -
-                    psKeyWidget->sBase.sPosition.i16YMin + 1;
-        i32YMin = psKeyWidget->sBase.sPosition.i16YMin * 10000;
-        i32YMin += (ui32Range * (uint32_t)psKey->ui16YPos);
+        ui32Cell = ((((uint32_t)i32YOff * GRID_ROWS) / ui32YRange) *
+                    GRID_COLUMNS) +
+                   (((uint32_t)i32XOff * GRID_COLUMNS) / ui32XRange);
+        if(g_pui8GridFirst[ui32Cell] == GRID_NO_KEY)
+        {
+            return(psKeyboard->ui16NumKeys);
+        }
+        ui32Key = g_pui8GridFirst[ui32Cell];
+        ui32End = g_pui8GridLast[ui32Cell] + 1;
+    }
 
-        i32YMax = i32YMin + (ui32Range * (uint32_t)psKey->ui16Height);
+    //
+    // Pre-scale the positions to multiples of 10000.
+    //
+    i32X *= 10000;
+    i32Y *= 10000;
 
-        if((i32X >= i32XMin) && (i32X <= i32XMax) &&
-           (i32Y >= i32YMin) && (i32Y <= i32YMax))
+    //
+    // Check each of the candidate keys in turn.
+    //
+    for(; ui32Key < ui32End; ui32Key++)
+    {
+        if(KeyContains(psKeyWidget, &psKeyboard->uKeys.psKeysText[ui32Key],
+                       i32X, i32Y))
         {
-            break;
+            return(ui32Key);
         }
     }
 
-    return(ui32Key);
+    return(psKeyboard->ui16NumKeys);
 }
 
 //*****************************************************************************
@@ -748,7 +1057,7 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
 {
     tKeyboardWidget *psKeyWidget;
     const tKeyboard *psKeyboard;
-    uint32_t ui32Key;
+    uint32_t ui32Key, ui32Previous;
 
     //
     // Check the arguments.
@@ -778,7 +1087,7 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
 
         //
         // If filling is enabled for the keyboard button, then redraw the
-        // keyboard to show it in its non-pressed state.
+        // key to show it in its non-pressed state.
         //
         if((psKeyWidget->ui32Style & KEYBOARD_STYLE_FILL) ||
            ((psKeyWidget->ui32Style & KEYBOARD_STYLE_IMG)))
@@ -792,7 +1101,8 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
                 // Always clear the key that was last marked pressed.
                 //
                 ButtonPaintText(psWidget,
-                   &psKeyboard->uKeys.psKeysText[psKeyWidget->ui32KeyPressed]);
+                   &psKeyboard->uKeys.psKeysText[psKeyWidget->ui32KeyPressed],
+                   &(psWidget->sPosition), false);
             }
         }
 
@@ -823,6 +1133,7 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
             //
             // Handle a shift to update the keyboard.
             //
+            ui32Previous = psKeyWidget->ui32Active;
             if(psKeyboard->uKeys.psKeysText[ui32Key].ui32Code ==
                UNICODE_CUSTOM_SHIFT)
             {
@@ -848,9 +1159,9 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
                 }
 
                 //
-                // Handle the widget paint request.
+                // Draw the keys which have changed.
                 //
-                KeyboardPaint(psWidget);
+                KeyboardSwitchPaint(psWidget, ui32Previous);
                 return(1);
             }
             if(psKeyboard->uKeys.psKeysText[ui32Key].ui32Code ==
@@ -866,9 +1177,9 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
                 }
 
                 //
-                // Handle the widget paint request.
+                // Draw the keys which have changed.
                 //
-                KeyboardPaint(psWidget);
+                KeyboardSwitchPaint(psWidget, ui32Previous);
 
                 return(1);
             }
@@ -879,31 +1190,29 @@ TextButtonEvent(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
                 psKeyWidget->ui32Active = 0;
 
                 //
-                // Handle the widget paint request.
+                // Draw the keys which have changed.
                 //
-                KeyboardPaint(psWidget);
+                KeyboardSwitchPaint(psWidget, ui32Previous);
             }
 
             //
-            // Indicate that a key is pressed.
+            // Indicate that a key is pressed, and save the key that was
+            // pressed.
             //
             psKeyWidget->ui32Flags |= FLAG_KEY_PRESSED;
+            psKeyWidget->ui32KeyPressed = ui32Key;
 
             //
             // If filling is enabled for this keyboard, or if an image is
             // being used and a pressed button image is provided, then redraw
-            // the keyboard to show it in its pressed state.
+            // the key to show it in its pressed state.
             //
             if((psKeyWidget->ui32Style & KEYBOARD_STYLE_FILL) ||
                ((psKeyWidget->ui32Style & KEYBOARD_STYLE_IMG)))
             {
-                //
-                // Save the key that was pressed.
-                //
-                psKeyWidget->ui32KeyPressed = ui32Key;
-
                 ButtonPaintText(psWidget,
-                                &psKeyboard->uKeys.psKeysText[ui32Key]);
+                                &psKeyboard->uKeys.psKeysText[ui32Key],
+                                &(psWidget->sPosition), true);
             }
         }
 
@@ -1002,15 +1311,13 @@ int32_t
 KeyboardMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
                 uint32_t ui32Param2)
 {
-    tKeyboardWidget *psKeyWidget;
+    tRectangle sClip;
 
     //
     // Check the arguments.
     //
     ASSERT(psWidget);
 
-    psKeyWidget = (tKeyboardWidget *)psWidget;
-
     //
     // Determine which message is being sent.
     //
@@ -1022,14 +1329,16 @@ KeyboardMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Only redraw if no buttons are pressed.
+            // Redraw the region being repainted.  A key which is held down is
+            // drawn in its pressed state.
             //
-            if((psKeyWidget->ui32Flags & FLAG_KEY_PRESSED) == 0)
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2, &sClip))
             {
                 //
-                // Handle the widget paint request.
+                // Handle the widget paint request, limited to the region being
+                // repainted.
                 //
-                KeyboardPaint(psWidget);
+                KeyboardPaint(psWidget, &sClip);
             }
 
             //
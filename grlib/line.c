@@ -458,7 +458,11 @@ GrLineClip(const tContext *pContext, int32_t *pi32X1, int32_t *pi32Y1,
 //! This function draws a line, utilizing GrLineDrawH() and GrLineDrawV() to
 //! draw the line as efficiently as possible.  The line is clipped to the
 //! clippping rectangle using the Cohen-Sutherland clipping algorithm, and then
-//! scan converted using Bresenham's line drawing algorithm.
+//! scan converted using Bresenham's line drawing algorithm.  Rather than
+//! plotting each point separately, the line is drawn as a series of
+//! horizontal or vertical runs of points, using the display driver's line
+//! drawing routines, so a line which is nearly horizontal or nearly vertical
+//! needs only a few calls to the display driver.
 //!
 //! \return None.
 //
@@ -467,7 +471,7 @@ void
 GrLineDraw(const tContext *pContext, int32_t i32X1, int32_t i32Y1,
            int32_t i32X2, int32_t i32Y2)
 {
-    int32_t i32Error, i32DeltaX, i32DeltaY, i32YStep, bSteep;
+    int32_t i32Error, i32DeltaX, i32DeltaY, i32YStep, i32Run, bSteep;
 
     //
     // Check the arguments.
@@ -584,50 +588,83 @@ GrLineDraw(const tContext *pContext, int32_t i32X1, int32_t i32Y1,
     }
 
     //
-    // Loop through all the points along the X axis of the line.
+    // Loop through the runs of the line.  A run is a set of consecutive
+    // points along the X axis which have the same Y coordinate, so it can be
+    // drawn with a single horizontal (or, for a steep line, vertical) line
+    // instead of a pixel at a time.
     //
-    for(; i32X1 <= i32X2; i32X1++)
+    while(i32X1 <= i32X2)
     {
         //
-        // See if this is a steep line.
+        // Compute the length of this run directly from the error term.  The
+        // error term is incremented by the Y delta for each point along the
+        // X axis, and a step is taken in the Y axis once it is greater than
+        // zero, so this plots the same points as stepping through the line one
+        // point at a time.  If clipping has reduced the line to a single row,
+        // the remainder of the line is a single run.
         //
-        if(bSteep)
+        if(i32DeltaY == 0)
         {
-            //
-            // Plot this point of the line, swapping the X and Y coordinates.
-            //
-            DpyPixelDraw(pContext->psDisplay, i32Y1, i32X1,
-                           pContext->ui32Foreground);
+            i32Run = i32X2 - i32X1 + 1;
         }
         else
         {
-            //
-            // Plot this point of the line, using the coordinates as is.
-            //
-            DpyPixelDraw(pContext->psDisplay, i32X1, i32Y1,
-                         pContext->ui32Foreground);
+            i32Run = (-i32Error / i32DeltaY) + 1;
+            if(i32Run > (i32X2 - i32X1 + 1))
+            {
+                i32Run = i32X2 - i32X1 + 1;
+            }
         }
 
         //
-        // Increment the error term by the Y delta.
+        // See if this run is a single point.
         //
-        i32Error += i32DeltaY;
+        if(i32Run == 1)
+        {
+            //
+            // Plot this point of the line, swapping the X and Y coordinates
+            // if this is a steep line.
+            //
+            if(bSteep)
+            {
+                DpyPixelDraw(pContext->psDisplay, i32Y1, i32X1,
+                             pContext->ui32Foreground);
+            }
+            else
+            {
+                DpyPixelDraw(pContext->psDisplay, i32X1, i32Y1,
+                             pContext->ui32Foreground);
+            }
+        }
 
         //
-        // See if the error term is now greater than zero.
+        // Otherwise, see if this is a steep line.
         //
-        if(i32Error > 0)
+        else if(bSteep)
         {
             //
-            // Take a step in the Y axis.
+            // Draw this run as a vertical line, swapping the X and Y
+            // coordinates.
             //
-            i32Y1 += i32YStep;
-
+            DpyLineDrawV(pContext->psDisplay, i32Y1, i32X1,
+                         i32X1 + i32Run - 1, pContext->ui32Foreground);
+        }
+        else
+        {
             //
-            // Decrement the error term by the X delta.
+            // Draw this run as a horizontal line, using the coordinates as is.
             //
-            i32Error -= i32DeltaX;
+            DpyLineDrawH(pContext->psDisplay, i32X1, i32X1 + i32Run - 1,
+                         i32Y1, pContext->ui32Foreground);
         }
+
+        //
+        // Advance past this run, taking a step in the Y axis and adjusting the
+        // error term to match.
+        //
+        i32X1 += i32Run;
+        i32Y1 += i32YStep;
+        i32Error += (i32Run * i32DeltaY) - i32DeltaX;
     }
 }
 
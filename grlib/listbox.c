@@ -58,27 +58,60 @@
 #define max(a, b) (((a) < (b)) ? (b) : (a))
 #endif
 
+//*****************************************************************************
+//
+// Returns the string for an entry of a listbox, from either the string table
+// or the data source.
+//
+//*****************************************************************************
+static const char *
+ListBoxTextGet(tListBoxWidget *pListBox, uint32_t ui32Index)
+{
+    const char *pcText;
+
+    //
+    // If the listbox has a data source, ask it for the string.  A source which
+    // cannot supply the string results in an empty line.
+    //
+    if(pListBox->pfnItemGet)
+    {
+        pcText = pListBox->pfnItemGet((tWidget *)pListBox, ui32Index);
+        return(pcText ? pcText : "");
+    }
+
+    //
+    // Otherwise, the string is in the string table.
+    //
+    return(pListBox->ppcText[ui32Index]);
+}
+
 //*****************************************************************************
 //
 //! Draws the contents of a listbox.
 //!
 //! \param psWidget is a pointer to the listbox widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws the contents of a listbox on the display.  This is
-//! called in response to a \b #WIDGET_MSG_PAINT message.
+//! called in response to a \b #WIDGET_MSG_PAINT message, and to draw the
+//! lines exposed when the contents are scrolled.  Only the lines of text which
+//! lie within \e psClip are drawn, so the strings of the other lines are not
+//! fetched.
 //!
 //! \return None.
 //
 //*****************************************************************************
 static void
-ListBoxPaint(tWidget *psWidget)
+ListBoxPaint(tWidget *psWidget, tRectangle *psClip)
 {
     tListBoxWidget *pListBox;
     tContext sCtx;
-    tRectangle sWidgetRect, sLineRect;
+    tRectangle sWidgetRect, sLineRect, sClipRect;
     int16_t i16Height;
-    int32_t i32Width;
+    int32_t i32Width, i32Line, i32Lines;
     uint16_t ui16String;
+    const char *pcText;
 
     //
     // Check the arguments.
@@ -100,7 +133,8 @@ ListBoxPaint(tWidget *psWidget)
     // Initialize the clipping region based on the extents of this listbox.
     //
     sWidgetRect = psWidget->sPosition;
-    GrContextClipRegionSet(&sCtx, &sWidgetRect);
+    sClipRect = *psClip;
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // See if the listbox outline style is selected.
@@ -133,23 +167,73 @@ ListBoxPaint(tWidget *psWidget)
         sWidgetRect.i16YMin++;
         sWidgetRect.i16XMax--;
         sWidgetRect.i16YMax--;
-        GrContextClipRegionSet(&sCtx, &sWidgetRect);
+
+        //
+        // Limit the clipping region to this area and the region being drawn,
+        // and return if nothing inside the border is to be drawn.
+        //
+        if(sClipRect.i16XMin < sWidgetRect.i16XMin)
+        {
+            sClipRect.i16XMin = sWidgetRect.i16XMin;
+        }
+        if(sClipRect.i16YMin < sWidgetRect.i16YMin)
+        {
+            sClipRect.i16YMin = sWidgetRect.i16YMin;
+        }
+        if(sClipRect.i16XMax > sWidgetRect.i16XMax)
+        {
+            sClipRect.i16XMax = sWidgetRect.i16XMax;
+        }
+        if(sClipRect.i16YMax > sWidgetRect.i16YMax)
+        {
+            sClipRect.i16YMax = sWidgetRect.i16YMax;
+        }
+        if((sClipRect.i16XMin > sClipRect.i16XMax) ||
+           (sClipRect.i16YMin > sClipRect.i16YMax))
+        {
+            return;
+        }
+        GrContextClipRegionSet(&sCtx, &sClipRect);
     }
 
     //
-    // Start drawing at the top of the widget.
+    // Determine how many lines of text there are from the entry at the top of
+    // the listbox to the newest entry, remembering that the index may wrap.
+    //
+    i32Lines = ((int32_t)pListBox->ui16StartEntry -
+                (int32_t)pListBox->ui16OldestEntry);
+    if(i32Lines < 0)
+    {
+        i32Lines += pListBox->ui16MaxEntries;
+    }
+    i32Lines = (int32_t)pListBox->ui16Populated - i32Lines;
+
+    //
+    // Start drawing at the first line of the widget which lies within the
+    // region being drawn.
     //
-    sLineRect = sWidgetRect;
-    ui16String = pListBox->ui16StartEntry;
     i16Height = GrFontHeightGet(pListBox->psFont);
+    i32Line = 0;
+    if(sClipRect.i16YMin > sWidgetRect.i16YMin)
+    {
+        i32Line = (sClipRect.i16YMin - sWidgetRect.i16YMin) / i16Height;
+    }
+    sLineRect = sWidgetRect;
+    sLineRect.i16YMin = sWidgetRect.i16YMin + (i32Line * i16Height);
 
     //
-    // Keep drawing until we reach the bottom of the listbox or run out of
-    // strings to draw.
+    // Keep drawing until we reach the bottom of the region being drawn or run
+    // out of strings to draw.
     //
-    while((sLineRect.i16YMin < sWidgetRect.i16YMax) &&
-          (ui16String < pListBox->ui16Populated))
+    while((sLineRect.i16YMin <= sClipRect.i16YMax) && (i32Line < i32Lines))
     {
+        //
+        // Find the entry shown on this line and get its string.
+        //
+        ui16String = (((uint32_t)pListBox->ui16StartEntry + i32Line) %
+                      pListBox->ui16MaxEntries);
+        pcText = ListBoxTextGet(pListBox, ui16String);
+
         //
         // Calculate the rectangle that will enclose this line of text.
         //
@@ -168,13 +252,13 @@ ListBoxPaint(tWidget *psWidget)
         //
         // Draw the text.
         //
-        GrStringDraw(&sCtx, pListBox->ppcText[ui16String], -1,
-                     sLineRect.i16XMin, sLineRect.i16YMin, 1);
+        GrStringDraw(&sCtx, pcText, -1, sLineRect.i16XMin, sLineRect.i16YMin,
+                     1);
 
         //
         // Determine the width of the string we just rendered.
         //
-        i32Width = GrStringWidthGet(&sCtx, pListBox->ppcText[ui16String], -1);
+        i32Width = GrStringWidthGet(&sCtx, pcText, -1);
 
         //
         // Do we need to clear the area to the right of the string?
@@ -195,28 +279,16 @@ ListBoxPaint(tWidget *psWidget)
         }
 
         //
-        // Move on to the next string, wrapping if necessary.
+        // Move on to the next line.
         //
-        ui16String++;
-        if(ui16String == pListBox->ui16MaxEntries)
-        {
-            ui16String = 0;
-        }
+        i32Line++;
         sLineRect.i16YMin += i16Height;
-
-        //
-        // If we are wrapping and got back at the oldest entry, we drop out.
-        //
-        if(ui16String == pListBox->ui16OldestEntry)
-        {
-            break;
-        }
     }
 
     //
     // Fill the remainder of the listbox area with the background color.
     //
-    if(sLineRect.i16YMin < sWidgetRect.i16YMax)
+    if(sLineRect.i16YMin <= sClipRect.i16YMax)
     {
         //
         // Determine the rectangle to be filled.
@@ -231,6 +303,82 @@ ListBoxPaint(tWidget *psWidget)
     }
 }
 
+//*****************************************************************************
+//
+// Scrolls the contents of a listbox by a number of lines, after the start
+// entry has been changed to match.  A positive number of lines moves the
+// contents up.  If the display can copy rectangles, the lines which remain
+// visible are moved by copying their pixels and only the exposed lines are
+// drawn; otherwise, the entire listbox is repainted.
+//
+//*****************************************************************************
+static void
+ListBoxScroll(tListBoxWidget *pListBox, int32_t i32Lines)
+{
+    tRectangle sArea, sSource, sExposed;
+    tContext sCtx;
+    int32_t i32Pixels, i32Y;
+
+    //
+    // Find the area in which the text is drawn, which lies inside the outline
+    // if there is one.
+    //
+    sArea = pListBox->sBase.sPosition;
+    if(pListBox->ui32Style & LISTBOX_STYLE_OUTLINE)
+    {
+        sArea.i16XMin += 2;
+        sArea.i16YMin += 2;
+        sArea.i16XMax -= 2;
+        sArea.i16YMax -= 2;
+    }
+
+    //
+    // If the scroll moves every line out of view, there is nothing to copy.
+    //
+    i32Pixels = i32Lines * GrFontHeightGet(pListBox->psFont);
+    if(abs(i32Pixels) > (sArea.i16YMax - sArea.i16YMin))
+    {
+        WidgetPaint((tWidget *)pListBox);
+        return;
+    }
+
+    //
+    // Determine the part of the text area which remains visible, where it
+    // moves to, and the part of the text area which is exposed.
+    //
+    sSource = sArea;
+    sExposed = sArea;
+    if(i32Pixels > 0)
+    {
+        sSource.i16YMin += i32Pixels;
+        i32Y = sArea.i16YMin;
+        sExposed.i16YMin = sArea.i16YMax - i32Pixels + 1;
+    }
+    else
+    {
+        sSource.i16YMax += i32Pixels;
+        i32Y = sArea.i16YMin - i32Pixels;
+        sExposed.i16YMax = sArea.i16YMin - i32Pixels - 1;
+    }
+
+    //
+    // Move the visible part of the text, and repaint the entire listbox
+    // instead if the display does not support this.
+    //
+    GrContextInit(&sCtx, pListBox->sBase.psDisplay);
+    GrContextClipRegionSet(&sCtx, &sArea);
+    if(!GrRectCopy(&sCtx, &sSource, sArea.i16XMin, i32Y))
+    {
+        WidgetPaint((tWidget *)pListBox);
+        return;
+    }
+
+    //
+    // Draw the lines which have been exposed.
+    //
+    ListBoxPaint((tWidget *)pListBox, &sExposed);
+}
+
 //*****************************************************************************
 //
 // Handles pointer messages for a listbox widget.
@@ -463,9 +611,9 @@ ListBoxPointer(tListBoxWidget *pListBox, uint32_t ui32Msg, int32_t i32X,
                                             GrFontHeightGet(pListBox->psFont));
 
                     //
-                    // Repaint the contents of the widget.
+                    // Scroll the contents of the widget.
                     //
-                    WidgetPaint((tWidget *)pListBox);
+                    ListBoxScroll(pListBox, i32Scroll);
                 }
             }
 
@@ -502,6 +650,7 @@ ListBoxMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
               uint32_t ui32Param2)
 {
     tListBoxWidget *pListBox;
+    tRectangle sClip;
 
     //
     // Check the arguments.
@@ -533,9 +682,14 @@ ListBoxMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            ListBoxPaint(psWidget);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                ListBoxPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
@@ -665,13 +819,21 @@ ListBoxInit(tListBoxWidget *psWidget, const tDisplay *psDisplay,
 //!
 //! \return Returns the string table index into which the new string has been
 //! placed if successful or -1 if the string table is full and
-//! \b #LISTBOX_STYLE_WRAP is not set.
+//! \b #LISTBOX_STYLE_WRAP is not set, or if the listbox has a data source.
 //
 //*****************************************************************************
 int32_t ListBoxTextAdd(tListBoxWidget *pListBox, const char *pcTxt)
 {
     uint32_t ui32Index;
 
+    //
+    // Strings can not be added to a listbox which has a data source.
+    //
+    if(pListBox->pfnItemGet)
+    {
+        return(-1);
+    }
+
     //
     // Is the list box full?
     //
@@ -742,6 +904,123 @@ int32_t ListBoxTextAdd(tListBoxWidget *pListBox, const char *pcTxt)
     return((int32_t)ui32Index);
 }
 
+//*****************************************************************************
+//
+//! Sets a data source which supplies the strings of a listbox.
+//!
+//! \param pListBox is a pointer to the listbox widget to modify.
+//! \param pfnItemGet is a pointer to the function which returns the string
+//! for an item.
+//! \param ui32NumItems is the number of items supplied by the data source.
+//!
+//! This function makes a listbox display items supplied by the application
+//! instead of the strings in its string table, which suits lists with a large
+//! number of items, such as a log.  The listbox stores nothing per item;
+//! whenever a line is drawn, \e pfnItemGet is called with the index of the
+//! item to be shown on it, and must return a string which remains valid until
+//! the next call.  Only the lines which must be drawn are requested, so
+//! scrolling requests only the lines which are exposed when the display can
+//! copy rectangles (see GrRectCopy()).
+//!
+//! Item indices run from 0 to \e ui32NumItems - 1, and are the indices used
+//! for the selection.  At most \b #LISTBOX_MAX_SOURCE_ITEMS items may be
+//! supplied.  The listbox is scrolled to the first item and the selection is
+//! cleared.  The display is not updated until the next paint request.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ListBoxDataSourceSet(tListBoxWidget *pListBox,
+                     const char *(*pfnItemGet)(tWidget *psWidget,
+                                               uint32_t ui32Index),
+                     uint32_t ui32NumItems)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pListBox);
+    ASSERT(pfnItemGet);
+    ASSERT(ui32NumItems <= LISTBOX_MAX_SOURCE_ITEMS);
+
+    //
+    // Switch the listbox to the data source.  Making the maximum number of
+    // entries larger than the number of items means that entry indices never
+    // wrap.
+    //
+    pListBox->pfnItemGet = pfnItemGet;
+    pListBox->ppcText = 0;
+    pListBox->ui16MaxEntries = LISTBOX_MAX_SOURCE_ITEMS + 1;
+    pListBox->ui16Populated = min(ui32NumItems, LISTBOX_MAX_SOURCE_ITEMS);
+    pListBox->ui16OldestEntry = 0;
+    pListBox->ui16StartEntry = 0;
+    pListBox->i16Selected = (int16_t)0xFFFF;
+}
+
+//*****************************************************************************
+//
+//! Changes the number of items supplied by the data source of a listbox.
+//!
+//! \param pListBox is a pointer to the listbox widget to modify.
+//! \param ui32NumItems is the new number of items.
+//!
+//! This function tells a listbox which has a data source (see
+//! ListBoxDataSourceSet()) that the number of items it supplies has changed,
+//! for example because entries have been added to a log.  If the last item
+//! was visible at the bottom of the listbox, the listbox is scrolled so that
+//! the new last item is visible instead, so that a listbox showing the end of
+//! a log follows it as it grows.  If items are removed, the listbox is
+//! scrolled back as required, and the selection is cleared if the selected
+//! item was removed.
+//!
+//! The display is not updated until the next paint request.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ListBoxItemCountSet(tListBoxWidget *pListBox, uint32_t ui32NumItems)
+{
+    int32_t i32Visible, i32Start;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pListBox);
+    ASSERT(pListBox->pfnItemGet);
+    ASSERT(ui32NumItems <= LISTBOX_MAX_SOURCE_ITEMS);
+
+    //
+    // Determine how many lines are visible, in the same way as when
+    // scrolling.
+    //
+    i32Visible = ((pListBox->sBase.sPosition.i16YMax -
+                   pListBox->sBase.sPosition.i16YMin) /
+                  (int32_t)GrFontHeightGet(pListBox->psFont));
+
+    //
+    // If the last item is visible, keep it visible; otherwise, only scroll if
+    // the items at the top of the listbox have been removed.
+    //
+    ui32NumItems = min(ui32NumItems, LISTBOX_MAX_SOURCE_ITEMS);
+    i32Start = pListBox->ui16StartEntry;
+    if(((i32Start + i32Visible) >= (int32_t)pListBox->ui16Populated) ||
+       ((i32Start + i32Visible) > (int32_t)ui32NumItems))
+    {
+        i32Start = max((int32_t)ui32NumItems - i32Visible, 0);
+    }
+    pListBox->ui16StartEntry = i32Start;
+    pListBox->ui16Populated = ui32NumItems;
+
+    //
+    // Clear the selection if the selected item no longer exists.
+    //
+    if(pListBox->i16Selected >= (int32_t)ui32NumItems)
+    {
+        pListBox->i16Selected = (int16_t)0xFFFF;
+    }
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
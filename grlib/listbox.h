@@ -96,18 +96,22 @@ typedef struct
 
     //
     //! A pointer to the array of string pointers representing the contents of
-    //! the list box.
+    //! the list box.  This is 0 if the list box obtains its strings from the
+    //! pfnItemGet callback.
     //
     const char **ppcText;
 
     //
-    //! The number of elements in the array pointed to by pci8Text.
+    //! The number of elements in the array pointed to by pci8Text.  If the
+    //! list box obtains its strings from the pfnItemGet callback, this is
+    //! LISTBOX_MAX_SOURCE_ITEMS.
     //
     uint16_t ui16MaxEntries;
 
     //
     //! The number of elements in the array pointed to by pci8Text which are
-    //! currently populated with strings.
+    //! currently populated with strings, or the number of items supplied by
+    //! the pfnItemGet callback.
     //
     uint16_t ui16Populated;
 
@@ -157,9 +161,27 @@ typedef struct
     //! ppcText array or, if no element is selected, 0xFFFF (-1).
     //
     void (*pfnOnChange)(tWidget *psWidget, int16_t ui16SelIndex);
+
+    //
+    //! A pointer to the application-supplied function which returns the
+    //! string for an item, if the list box has been given a data source by
+    //! ListBoxDataSourceSet().  The ui32Index parameter is the index of the
+    //! item, and the returned string need only remain valid until the next
+    //! call to the function.  If this is 0, the strings are taken from the
+    //! ppcText array.
+    //
+    const char *(*pfnItemGet)(tWidget *psWidget, uint32_t ui32Index);
 }
 tListBoxWidget;
 
+//*****************************************************************************
+//
+//! The maximum number of items which a data source may supply to a listbox
+//! widget, which is limited by the range of the selected item index.
+//
+//*****************************************************************************
+#define LISTBOX_MAX_SOURCE_ITEMS 0x7FFF
+
 //*****************************************************************************
 //
 //! This flag indicates that the listbox should be outlined.  If enabled, the
@@ -556,7 +578,8 @@ tListBoxWidget sName =                                                        \
 //! This function replaces the string associated with one of the listbox
 //! elements.  This call should only be used to replace a string for an
 //! already-populated element.  To add a new string, use ListBoxTextAdd().
-//! The display is not updated until the next paint request.
+//! The display is not updated until the next paint request.  This call has
+//! no effect if the listbox obtains its strings from a data source.
 //!
 //! \return None.
 //
@@ -566,7 +589,7 @@ tListBoxWidget sName =                                                        \
         {                                                                     \
             tListBoxWidget *psW = psWidget;                                   \
             const char *pcT = pcTxt;                                          \
-            if(ui32Index < psW->ui16MaxEntries)                               \
+            if(psW->ppcText && (ui32Index < psW->ui16MaxEntries))             \
             {                                                                 \
                 psW->ppcText[ui32Index] = pcT;                                \
             }                                                                 \
@@ -738,6 +761,12 @@ extern void ListBoxInit(tListBoxWidget *psWidget, const tDisplay *psDisplay,
                         int32_t i32X, int32_t i32Y,
                         int32_t i32Width, int32_t i32Height);
 extern int32_t ListBoxTextAdd(tListBoxWidget *psWidget, const char *pcTxt);
+extern void ListBoxDataSourceSet(tListBoxWidget *psWidget,
+                                 const char *(*pfnItemGet)(tWidget *psWidget,
+                                                           uint32_t ui32Index),
+                                 uint32_t ui32NumItems);
+extern void ListBoxItemCountSet(tListBoxWidget *psWidget,
+                                uint32_t ui32NumItems);
 
 //*****************************************************************************
 //
@@ -0,0 +1,1074 @@
+//*****************************************************************************
+//
+// offscr16bpp.c - 16 BPP off-screen display buffer driver.
+//
+// Copyright (c) 2008-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Translates a 24-bit RGB color to a 5-6-5 RGB color as stored in the 16 BPP
+// off-screen buffer.
+//
+//*****************************************************************************
+#define DPYCOLORTRANSLATE16(c)  ((((c) & 0x00f80000) >> 8) |                  \
+                                 (((c) & 0x0000fc00) >> 5) |                  \
+                                 (((c) & 0x000000f8) >> 3))
+
+//*****************************************************************************
+//
+// Returns a pointer to the pixel at a given position within the image buffer.
+// The pixel data starts after the six byte image header, and is stored as one
+// half-word per pixel.
+//
+//*****************************************************************************
+#define PIXEL_PTR16(pui8Buf, i32X, i32Y)                                      \
+        ((uint16_t *)((pui8Buf) + 6) +                                        \
+         (*(uint16_t *)((pui8Buf) + 1) * (i32Y)) + (i32X))
+
+//*****************************************************************************
+//
+// Fills a horizontal span of pixels in the image buffer, writing two pixels
+// per word access wherever possible.
+//
+//*****************************************************************************
+static void
+SpanFill16(uint16_t *pui16Data, int32_t i32Count, uint32_t ui32Value)
+{
+    //
+    // Copy the pixel value into both half-words of the uint32_t.  This will be
+    // used to write two pixels into memory at a time.
+    //
+    ui32Value = (ui32Value & 0xffff) | (ui32Value << 16);
+
+    //
+    // See if the buffer pointer is not word aligned.
+    //
+    if(((uint32_t)pui16Data & 2) && i32Count)
+    {
+        //
+        // Draw one pixel to word align the buffer pointer.
+        //
+        *pui16Data++ = ui32Value & 0xffff;
+        i32Count--;
+    }
+
+    //
+    // Loop while there are at least eight pixels left to draw.
+    //
+    while(i32Count >= 8)
+    {
+        //
+        // Draw eight pixels.
+        //
+        ((uint32_t *)pui16Data)[0] = ui32Value;
+        ((uint32_t *)pui16Data)[1] = ui32Value;
+        ((uint32_t *)pui16Data)[2] = ui32Value;
+        ((uint32_t *)pui16Data)[3] = ui32Value;
+        pui16Data += 8;
+        i32Count -= 8;
+    }
+
+    //
+    // Loop while there are at least two pixels left to draw.
+    //
+    while(i32Count >= 2)
+    {
+        //
+        // Draw two pixels.
+        //
+        *(uint32_t *)pui16Data = ui32Value;
+        pui16Data += 2;
+        i32Count -= 2;
+    }
+
+    //
+    // See if there is one pixel left to draw.
+    //
+    if(i32Count)
+    {
+        //
+        // Draw the final pixel.
+        //
+        *pui16Data = ui32Value & 0xffff;
+    }
+}
+
+//*****************************************************************************
+//
+// Draws a horizontal span of pixels in the image buffer from pixel data which
+// is read out of order.  The position of each pixel within the pixel data is
+// given in bits, starting at i32Pos and advancing by i32Step bits per pixel,
+// so that a span can be read along a column of the pixel data or backwards
+// along a row.  The pixel and palette formats are those accepted by
+// GrOffScreen16BPPPixelDrawMultiple().
+//
+//*****************************************************************************
+static void
+SpanGather16(uint16_t *pui16Ptr, int32_t i32Count, const uint8_t *pui8Data,
+             int32_t i32Pos, int32_t i32Step, int32_t i32Bits,
+             const uint8_t *pui8Palette)
+{
+    const uint8_t *pui8Pixel;
+    uint32_t ui32Color;
+
+    switch(i32Bits)
+    {
+        //
+        // The palette holds translated colors for 1 bit per pixel data.
+        //
+        case 1:
+        {
+            while(i32Count--)
+            {
+                *pui16Ptr++ = (((uint32_t *)pui8Palette)
+                               [(pui8Data[i32Pos >> 3] >>
+                                 (7 - (i32Pos & 7))) & 1]);
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        //
+        // The palette holds 24-bit RGB colors for 4 and 8 bit per pixel data.
+        //
+        case 4:
+        {
+            while(i32Count--)
+            {
+                ui32Color = (((pui8Data[i32Pos >> 3] >> (4 - (i32Pos & 7))) &
+                              15) * 3);
+                ui32Color = (*(uint32_t *)(pui8Palette + ui32Color) &
+                             0x00ffffff);
+                *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Color);
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        case 8:
+        {
+            while(i32Count--)
+            {
+                ui32Color = pui8Data[i32Pos >> 3] * 3;
+                ui32Color = (*(uint32_t *)(pui8Palette + ui32Color) &
+                             0x00ffffff);
+                *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Color);
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        //
+        // The native 5-6-5 RGB pixels are copied.
+        //
+        case 16:
+        {
+            while(i32Count--)
+            {
+                *pui16Ptr++ = *(uint16_t *)(pui8Data + (i32Pos >> 3));
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        case 24:
+        {
+            while(i32Count--)
+            {
+                pui8Pixel = pui8Data + (i32Pos >> 3);
+                ui32Color = (pui8Pixel[0] | (pui8Pixel[1] << 8) |
+                             (pui8Pixel[2] << 16));
+                *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Color);
+                i32Pos += i32Step;
+            }
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Translates a 24-bit RGB color to a display driver-specific color.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param ui32Value is the 24-bit RGB color.  The least-significant byte is
+//! the blue channel, the next byte is the green channel, and the third byte is
+//! the red channel.
+//!
+//! This function translates a 24-bit RGB color into a value that can be
+//! written into the display's frame buffer in order to reproduce that color,
+//! or the closest possible approximation of that color.
+//!
+//! \return Returns the display-driver specific color.
+//
+//*****************************************************************************
+static uint32_t
+GrOffScreen16BPPColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    //
+    // Translate from a 24-bit RGB color to a 5-6-5 RGB color.
+    //
+    return(DPYCOLORTRANSLATE16(ui32Value));
+}
+
+//*****************************************************************************
+//
+//! Draws a pixel on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the pixel.
+//! \param i32Y is the Y coordinate of the pixel.
+//! \param ui32Value is the color of the pixel.
+//!
+//! This function sets the given pixel to a particular color.  The coordinates
+//! of the pixel are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                          uint32_t ui32Value)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Write this pixel into the image buffer.
+    //
+    *PIXEL_PTR16((uint8_t *)pvDisplayData, i32X, i32Y) = ui32Value;
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the first pixel.
+//! \param i32Y is the Y coordinate of the first pixel.
+//! \param i32X0 is sub-pixel offset within the pixel data, which is valid for
+//! 1 or 4 bit per pixel formats.
+//! \param i32Count is the number of pixels to draw.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this run represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data.  For 1 and 4 bit per pixel
+//! formats, the most significant bit(s) represent the left-most pixel.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a horizontal sequence of pixels on the screen, using
+//! the supplied palette.  For 1 bit per pixel format, the palette contains
+//! pre-translated colors; for 4 and 8 bit per pixel formats, the palette
+//! contains 24-bit RGB values that must be translated before being written to
+//! the display.  For 16 bit per pixel format, the data is 5-6-5 RGB and is
+//! copied directly; for 24 bit per pixel format, the data is 8-8-8 RGB and is
+//! translated.  No palette is used for the 16 and 24 bit per pixel formats.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPPixelDrawMultiple(void *pvDisplayData, int32_t i32X,
+                                  int32_t i32Y, int32_t i32X0,
+                                  int32_t i32Count, int32_t i32BPP,
+                                  const uint8_t *pui8Data,
+                                  const uint8_t *pui8Palette)
+{
+    uint16_t *pui16Ptr;
+    uint32_t ui32Byte, ui32Next;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(pui8Data);
+
+    //
+    // Get a pointer to the starting pixel within the image buffer.
+    //
+    pui16Ptr = PIXEL_PTR16((uint8_t *)pvDisplayData, i32X, i32Y);
+
+    //
+    // Determine how to interpret the pixel data based on the number of bits
+    // per pixel.
+    //
+    switch(i32BPP & 0xFF)
+    {
+        //
+        // The pixel data is in 1 bit per pixel format.
+        //
+        case 1:
+        {
+            //
+            // Loop while there are more pixels to draw.
+            //
+            while(i32Count)
+            {
+                //
+                // Get the next byte of image data.
+                //
+                ui32Byte = *pui8Data++;
+
+                //
+                // Loop through the pixels in this byte of image data.
+                //
+                for(; (i32X0 < 8) && i32Count; i32X0++, i32Count--)
+                {
+                    //
+                    // Draw this pixel in the appropriate color.
+                    //
+                    *pui16Ptr++ = (((uint32_t *)pui8Palette)[(ui32Byte >>
+                                                                (7 - i32X0)) &
+                                                               1]);
+                }
+
+                //
+                // Start at the beginning of the next byte of image data.
+                //
+                i32X0 = 0;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 4 bit per pixel format.
+        //
+        case 4:
+        {
+            //
+            // Loop while there are more pixels to draw.  "Duff's device" is
+            // used to jump into the middle of the loop if the first nibble of
+            // the pixel data should not be used.  Duff's device makes use of
+            // the fact that a case statement is legal anywhere within a
+            // sub-block of a switch statement.  See
+            // http://en.wikipedia.org/wiki/Duff's_device for detailed
+            // information about Duff's device.
+            //
+            switch(i32X0 & 1)
+            {
+                case 0:
+                    while(i32Count)
+                    {
+                        //
+                        // Get the upper nibble of the next byte of pixel data
+                        // and extract the corresponding entry from the
+                        // palette.
+                        //
+                        ui32Byte = (*pui8Data >> 4) * 3;
+                        ui32Byte = (*(uint32_t *)(pui8Palette + ui32Byte) &
+                                    0x00ffffff);
+
+                        //
+                        // Translate this palette entry and write it to the
+                        // screen.
+                        //
+                        *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Byte);
+
+                        //
+                        // Decrement the count of pixels to draw.
+                        //
+                        i32Count--;
+
+                        //
+                        // See if there is another pixel to draw.
+                        //
+                        if(i32Count)
+                        {
+                case 1:
+                            //
+                            // Get the lower nibble of the next byte of pixel
+                            // data and extract the corresponding entry from
+                            // the palette.
+                            //
+                            ui32Byte = (*pui8Data++ & 15) * 3;
+                            ui32Byte = (*(uint32_t *)(pui8Palette + ui32Byte) &
+                                        0x00ffffff);
+
+                            //
+                            // Translate this palette entry and write it to the
+                            // screen.
+                            //
+                            *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Byte);
+
+                            //
+                            // Decrement the count of pixels to draw.
+                            //
+                            i32Count--;
+                        }
+                    }
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 8 bit per pixel format.
+        //
+        case 8:
+        {
+            //
+            // See if the buffer pointer is not word aligned.
+            //
+            if(((uint32_t)pui16Ptr & 2) && i32Count)
+            {
+                //
+                // Draw one pixel to word align the buffer pointer.
+                //
+                ui32Byte = *pui8Data++ * 3;
+                ui32Byte = *(uint32_t *)(pui8Palette + ui32Byte) & 0x00ffffff;
+                *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Byte);
+                i32Count--;
+            }
+
+            //
+            // Loop while there are at least two pixels left to draw.
+            //
+            while(i32Count >= 2)
+            {
+                //
+                // Get the next two bytes of pixel data and extract the
+                // corresponding entries from the palette.
+                //
+                ui32Byte = pui8Data[0] * 3;
+                ui32Byte = *(uint32_t *)(pui8Palette + ui32Byte) & 0x00ffffff;
+                ui32Next = pui8Data[1] * 3;
+                ui32Next = *(uint32_t *)(pui8Palette + ui32Next) & 0x00ffffff;
+                pui8Data += 2;
+
+                //
+                // Translate both palette entries and write them to the screen
+                // with a single word access.
+                //
+                *(uint32_t *)pui16Ptr = (DPYCOLORTRANSLATE16(ui32Byte) |
+                                         (DPYCOLORTRANSLATE16(ui32Next) << 16));
+                pui16Ptr += 2;
+                i32Count -= 2;
+            }
+
+            //
+            // See if there is one pixel left to draw.
+            //
+            if(i32Count)
+            {
+                ui32Byte = *pui8Data * 3;
+                ui32Byte = *(uint32_t *)(pui8Palette + ui32Byte) & 0x00ffffff;
+                *pui16Ptr = DPYCOLORTRANSLATE16(ui32Byte);
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in the native 5-6-5 RGB format.
+        //
+        case 16:
+        {
+            //
+            // See if the buffer pointer is not word aligned.
+            //
+            if(((uint32_t)pui16Ptr & 2) && i32Count)
+            {
+                //
+                // Copy one pixel to word align the buffer pointer.
+                //
+                *pui16Ptr++ = *(uint16_t *)pui8Data;
+                pui8Data += 2;
+                i32Count--;
+            }
+
+            //
+            // Loop while there are at least two pixels left to copy.
+            //
+            while(i32Count >= 2)
+            {
+                //
+                // Copy two pixels.
+                //
+                *(uint32_t *)pui16Ptr = *(uint32_t *)pui8Data;
+                pui16Ptr += 2;
+                pui8Data += 4;
+                i32Count -= 2;
+            }
+
+            //
+            // See if there is one pixel left to copy.
+            //
+            if(i32Count)
+            {
+                *pui16Ptr = *(uint16_t *)pui8Data;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 8-8-8 RGB format.
+        //
+        case 24:
+        {
+            //
+            // Loop while there are more pixels to draw.
+            //
+            while(i32Count--)
+            {
+                //
+                // Get the next pixel, translate it and write it to the screen.
+                //
+                ui32Byte = (pui8Data[0] | (pui8Data[1] << 8) |
+                            (pui8Data[2] << 16));
+                *pui16Ptr++ = DPYCOLORTRANSLATE16(ui32Byte);
+                pui8Data += 3;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X1 is the X coordinate of the start of the line.
+//! \param i32X2 is the X coordinate of the end of the line.
+//! \param i32Y is the Y coordinate of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a horizontal line on the display.  The coordinates of
+//! the line are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2,
+                          int32_t i32Y, uint32_t ui32Value)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Fill the span of pixels covered by the line.
+    //
+    SpanFill16(PIXEL_PTR16((uint8_t *)pvDisplayData, i32X1, i32Y),
+               i32X2 - i32X1 + 1, ui32Value);
+}
+
+//*****************************************************************************
+//
+//! Draws a vertical line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the line.
+//! \param i32Y1 is the Y coordinate of the start of the line.
+//! \param i32Y2 is the Y coordinate of the end of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a vertical line on the display.  The coordinates of the
+//! line are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1,
+                          int32_t i32Y2, uint32_t ui32Value)
+{
+    uint16_t *pui16Data;
+    int32_t i32Width;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Get the number of pixels per row in the image buffer.
+    //
+    i32Width = *(uint16_t *)((uint8_t *)pvDisplayData + 1);
+
+    //
+    // Get a pointer to the starting pixel.
+    //
+    pui16Data = PIXEL_PTR16((uint8_t *)pvDisplayData, i32X, i32Y1);
+
+    //
+    // Loop over the rows of the line.
+    //
+    for(; i32Y1 <= i32Y2; i32Y1++)
+    {
+        *pui16Data = ui32Value;
+        pui16Data += i32Width;
+    }
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param pRect is a pointer to the structure describing the rectangle.
+//! \param ui32Value is the color of the rectangle.
+//!
+//! This function fills a rectangle on the display.  The coordinates of the
+//! rectangle are assumed to be within the extents of the display, and the
+//! rectangle specification is fully inclusive (in other words, both i16XMin
+//! and i16XMax are drawn, along with i16YMin and i16YMax).
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPRectFill(void *pvDisplayData, const tRectangle *pRect,
+                         uint32_t ui32Value)
+{
+    uint16_t *pui16Data;
+    int32_t i32Width, i32Count, i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(pRect);
+
+    //
+    // Get the number of pixels per row in the image buffer.
+    //
+    i32Width = *(uint16_t *)((uint8_t *)pvDisplayData + 1);
+
+    //
+    // Get a pointer to the upper left pixel of the rectangle.
+    //
+    pui16Data = PIXEL_PTR16((uint8_t *)pvDisplayData, pRect->i16XMin,
+                            pRect->i16YMin);
+
+    //
+    // Determine the number of pixels in each row of the rectangle.
+    //
+    i32Count = pRect->i16XMax - pRect->i16XMin + 1;
+
+    //
+    // Fill each row of the rectangle in turn.
+    //
+    for(i32Y = pRect->i16YMin; i32Y <= pRect->i16YMax; i32Y++)
+    {
+        SpanFill16(pui16Data, i32Count, ui32Value);
+        pui16Data += i32Width;
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a rectangle of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this rectangle represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a rectangle of pixels on the screen, using the pixel
+//! and palette formats accepted by GrOffScreen16BPPPixelDrawMultiple().  When
+//! the pixel data is in the native 5-6-5 RGB format and spans entire rows of
+//! the image buffer, the rectangle is contiguous in both the pixel data and
+//! the image buffer and is copied as a single run of pixels.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPBlit(void *pvDisplayData, const tRectangle *psRect,
+                     int32_t i32X0, int32_t i32BPP, const uint8_t *pui8Data,
+                     int32_t i32Stride, const uint8_t *pui8Palette)
+{
+    int32_t i32Width, i32Rows, i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+    ASSERT(pui8Data);
+
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+
+    //
+    // See if the rectangle is a contiguous block of native pixels.
+    //
+    if(((i32BPP & 0xFF) == 16) &&
+       (i32Width == *(uint16_t *)((uint8_t *)pvDisplayData + 1)) &&
+       (i32Stride == (i32Width * 2)))
+    {
+        //
+        // Copy the entire rectangle as one run of pixels.
+        //
+        GrOffScreen16BPPPixelDrawMultiple(pvDisplayData, 0, psRect->i16YMin,
+                                          0, i32Width * i32Rows, i32BPP,
+                                          pui8Data, pui8Palette);
+        return;
+    }
+
+    //
+    // Otherwise, draw the rectangle a row at a time.
+    //
+    for(i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++)
+    {
+        GrOffScreen16BPPPixelDrawMultiple(pvDisplayData, psRect->i16XMin,
+                                          i32Y, i32X0, i32Width, i32BPP,
+                                          pui8Data, pui8Palette);
+        pui8Data += i32Stride;
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a rotated rectangle of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle on the
+//! screen.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this rectangle represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//! \param ui32Rotation is the clockwise rotation of the pixel data onto the
+//! screen, which is one of the \b GRLIB_ROTATE_* values.
+//!
+//! This function draws a rectangle of pixels which is rotated onto the
+//! screen, using the pixel and palette formats accepted by
+//! GrOffScreen16BPPPixelDrawMultiple().  The image buffer is written a row at
+//! a time, reading each row from a column of the pixel data for the 90 and
+//! 270 degree rotations, or from a row of the pixel data in reverse for the
+//! 180 degree rotation.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPBlitRotated(void *pvDisplayData, const tRectangle *psRect,
+                            int32_t i32X0, int32_t i32BPP,
+                            const uint8_t *pui8Data, int32_t i32Stride,
+                            const uint8_t *pui8Palette, uint32_t ui32Rotation)
+{
+    int32_t i32Width, i32Rows, i32Bits, i32Pos, i32Step, i32RowStep, i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+    ASSERT(pui8Data);
+    ASSERT(ui32Rotation <= GRLIB_ROTATE_270);
+
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+
+    //
+    // The sub-pixel offset only applies to the packed formats.
+    //
+    i32Bits = i32BPP & 0xFF;
+    i32X0 = (i32Bits < 8) ? (i32X0 & ((8 / i32Bits) - 1)) : 0;
+
+    //
+    // Find the position (in bits) in the pixel data of the first pixel of the
+    // first row on the screen, and the steps to the next pixel in the row and
+    // to the first pixel of the next row.
+    //
+    switch(ui32Rotation)
+    {
+        case GRLIB_ROTATE_90:
+        {
+            i32Pos = ((i32Width - 1) * i32Stride * 8) + (i32X0 * i32Bits);
+            i32Step = -i32Stride * 8;
+            i32RowStep = i32Bits;
+            break;
+        }
+
+        case GRLIB_ROTATE_180:
+        {
+            i32Pos = (((i32Rows - 1) * i32Stride * 8) +
+                      ((i32X0 + i32Width - 1) * i32Bits));
+            i32Step = -i32Bits;
+            i32RowStep = -i32Stride * 8;
+            break;
+        }
+
+        case GRLIB_ROTATE_270:
+        {
+            i32Pos = (i32X0 + i32Rows - 1) * i32Bits;
+            i32Step = i32Stride * 8;
+            i32RowStep = -i32Bits;
+            break;
+        }
+
+        default:
+        {
+            i32Pos = i32X0 * i32Bits;
+            i32Step = i32Bits;
+            i32RowStep = i32Stride * 8;
+            break;
+        }
+    }
+
+    //
+    // Draw each row of the rectangle on the screen.
+    //
+    for(i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++)
+    {
+        SpanGather16(PIXEL_PTR16((uint8_t *)pvDisplayData, psRect->i16XMin,
+                                 i32Y), i32Width, pui8Data, i32Pos, i32Step,
+                     i32Bits, pui8Palette);
+        i32Pos += i32RowStep;
+    }
+}
+
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies a rectangle of pixels within the off-screen buffer.
+//! The rows, and the pixels within each row, are copied in the order that
+//! allows the source and destination to overlap.  The coordinates of both
+//! rectangles are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                         int32_t i32X, int32_t i32Y)
+{
+    uint16_t *pui16Src, *pui16Dst;
+    int32_t i32Width, i32Rows, i32Count, i32Step, i32Stride;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    //
+    // Get pointers to the first pixel of the source and destination, and the
+    // distance between rows of the image buffer.
+    //
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+    pui16Src = PIXEL_PTR16((uint8_t *)pvDisplayData, psRect->i16XMin,
+                    psRect->i16YMin);
+    pui16Dst = PIXEL_PTR16((uint8_t *)pvDisplayData, i32X, i32Y);
+    i32Stride = *(uint16_t *)((uint8_t *)pvDisplayData + 1);
+    i32Step = 1;
+
+    //
+    // If the destination is below the source, copy the rows from the bottom
+    // up so that each source row is copied before it is overwritten.
+    //
+    if(i32Y > psRect->i16YMin)
+    {
+        pui16Src += (i32Rows - 1) * i32Stride;
+        pui16Dst += (i32Rows - 1) * i32Stride;
+        i32Stride = -i32Stride;
+    }
+
+    //
+    // Likewise, if the destination is to the right of the source, copy each
+    // row from right to left.
+    //
+    if(i32X > psRect->i16XMin)
+    {
+        pui16Src += (i32Width - 1) * i32Step;
+        pui16Dst += (i32Width - 1) * i32Step;
+        i32Step = -i32Step;
+    }
+
+    //
+    // Loop through the rows of the rectangle.
+    //
+    while(i32Rows--)
+    {
+        //
+        // Copy the pixels of this row.
+        //
+        for(i32Count = 0; i32Count < i32Width; i32Count++)
+        {
+            pui16Dst[i32Count * i32Step] = pui16Src[i32Count * i32Step];
+        }
+
+        //
+        // Move to the next row.
+        //
+        pui16Src += i32Stride;
+        pui16Dst += i32Stride;
+    }
+}
+
+//*****************************************************************************
+//
+//! Flushes any cached drawing operations.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//!
+//! This functions flushes any cached drawing operations to the display.  This
+//! is useful when a local frame buffer is used for drawing operations, and the
+//! flush would copy the local frame buffer to the display.  For the off-screen
+//! display buffer driver, the flush is a no operation.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen16BPPFlush(void *pvDisplayData)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+}
+
+//*****************************************************************************
+//
+//! Initializes a 16 BPP off-screen buffer.
+//!
+//! \param psDisplay is a pointer to the display structure to be configured for
+//! the 16 BPP off-screen buffer.
+//! \param pui8Image is a pointer to the image buffer to be used for the
+//! off-screen buffer.
+//! \param i32Width is the width of the image buffer in pixels.
+//! \param i32Height is the height of the image buffer in pixels.
+//!
+//! This function initializes a display structure, preparing it to draw into
+//! the supplied image buffer.  The image buffer is assumed to be large enough
+//! to hold an image of the specified geometry, as returned by
+//! GrOffScreen16BPPSize(), and to be at least half-word aligned.
+//!
+//! Pixels are stored in 5-6-5 RGB format, which matches the native format of
+//! most 16-bit color displays, so the buffer contents may be written to such
+//! a display without any further color translation.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrOffScreen16BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
+                     int32_t i32Height)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDisplay);
+    ASSERT(pui8Image);
+    ASSERT(((uint32_t)pui8Image & 1) == 0);
+
+    //
+    // Initialize the display structure.
+    //
+    psDisplay->i32Size = sizeof(tDisplay);
+    psDisplay->pvDisplayData = pui8Image;
+    psDisplay->ui16Width = i32Width;
+    psDisplay->ui16Height = i32Height;
+    psDisplay->pfnPixelDraw = GrOffScreen16BPPPixelDraw;
+    psDisplay->pfnPixelDrawMultiple = GrOffScreen16BPPPixelDrawMultiple;
+    psDisplay->pfnLineDrawH = GrOffScreen16BPPLineDrawH;
+    psDisplay->pfnLineDrawV = GrOffScreen16BPPLineDrawV;
+    psDisplay->pfnRectFill = GrOffScreen16BPPRectFill;
+    psDisplay->pfnColorTranslate = GrOffScreen16BPPColorTranslate;
+    psDisplay->pfnFlush = GrOffScreen16BPPFlush;
+    psDisplay->pfnBlit = GrOffScreen16BPPBlit;
+    psDisplay->pfnRectCopy = GrOffScreen16BPPRectCopy;
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = GrOffScreen16BPPBlitRotated;
+
+    //
+    // Initialize the image buffer.  The sixth byte of the header is reserved
+    // so that the pixel data is half-word aligned.
+    //
+    pui8Image[0] = IMAGE_FMT_16BPP_UNCOMP;
+    *(uint16_t *)(pui8Image + 1) = i32Width;
+    *(uint16_t *)(pui8Image + 3) = i32Height;
+    pui8Image[5] = 0;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -826,6 +826,94 @@ GrOffScreen1BPPColorTranslate(void *pvDisplayData, uint32_t ui32Value)
     return(DPYCOLORTRANSLATE(ui32Value));
 }
 
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies a rectangle of pixels within the off-screen buffer.
+//! The rows, and the pixels within each row, are copied in the order that
+//! allows the source and destination to overlap.  The coordinates of both
+//! rectangles are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen1BPPRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                        int32_t i32X, int32_t i32Y)
+{
+    int32_t i32BytesPerRow, i32Width, i32Rows, i32Row, i32Col;
+    int32_t i32SrcX, i32SrcY, i32DstX, i32DstY;
+    uint8_t *pui8Data, *pui8Src, *pui8Dst;
+    uint32_t ui32Value;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    //
+    // Create a character pointer for the display-specific data (which points
+    // to the image buffer), and compute the number of bytes per row in the
+    // image buffer.
+    //
+    pui8Data = (uint8_t *)pvDisplayData;
+    i32BytesPerRow = (*(uint16_t *)(pui8Data + 1) + 7) / 8;
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+
+    //
+    // Loop through the rows of the rectangle.  If the destination is below
+    // the source, the rows are copied from the bottom up so that each source
+    // row is copied before it is overwritten.
+    //
+    for(i32Row = 0; i32Row < i32Rows; i32Row++)
+    {
+        i32SrcY = ((i32Y > psRect->i16YMin) ? (i32Rows - 1 - i32Row) :
+                   i32Row);
+        i32DstY = i32Y + i32SrcY;
+        i32SrcY += psRect->i16YMin;
+
+        //
+        // Loop through the pixels of this row, working from right to left if
+        // the destination is to the right of the source.
+        //
+        for(i32Col = 0; i32Col < i32Width; i32Col++)
+        {
+            i32SrcX = ((i32X > psRect->i16XMin) ? (i32Width - 1 - i32Col) :
+                       i32Col);
+            i32DstX = i32X + i32SrcX;
+            i32SrcX += psRect->i16XMin;
+
+            //
+            // Read the source pixel.
+            //
+            pui8Src = (pui8Data + (i32BytesPerRow * i32SrcY) + (i32SrcX / 8) +
+                       5);
+            ui32Value = (*pui8Src >> (7 - (i32SrcX & 7))) & 1;
+
+            //
+            // Write it to the destination pixel.
+            //
+            pui8Dst = (pui8Data + (i32BytesPerRow * i32DstY) + (i32DstX / 8) +
+                       5);
+            i32DstX = 7 - (i32DstX & 7);
+            *pui8Dst = ((*pui8Dst & ~(1 << i32DstX)) |
+                        (ui32Value << i32DstX));
+        }
+    }
+}
+
 //*****************************************************************************
 //
 //! Flushes any cached drawing operations.
@@ -892,6 +980,10 @@ GrOffScreen1BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
     psDisplay->pfnRectFill = GrOffScreen1BPPRectFill;
     psDisplay->pfnColorTranslate = GrOffScreen1BPPColorTranslate;
     psDisplay->pfnFlush = GrOffScreen1BPPFlush;
+    psDisplay->pfnBlit = 0;
+    psDisplay->pfnRectCopy = GrOffScreen1BPPRectCopy;
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = 0;
 
     //
     // Initialize the image buffer.
@@ -0,0 +1,1042 @@
+//*****************************************************************************
+//
+// offscr24bpp.c - 24 BPP off-screen display buffer driver.
+//
+// Copyright (c) 2008-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Returns a pointer to the first byte of the pixel at a given position within
+// the image buffer.  The pixel data starts after the six byte image header,
+// and is stored as three bytes per pixel in blue, green, red order (the same
+// order used for palette entries in 4 BPP and 8 BPP images).
+//
+//*****************************************************************************
+#define PIXEL_PTR24(pui8Buf, i32X, i32Y)                                      \
+        ((pui8Buf) + 6 +                                                      \
+         (((*(uint16_t *)((pui8Buf) + 1) * (i32Y)) + (i32X)) * 3))
+
+//*****************************************************************************
+//
+// Fills a horizontal span of pixels in the image buffer.  Once the buffer
+// pointer is word aligned, four pixels are written with three word accesses.
+//
+//*****************************************************************************
+static void
+SpanFill24(uint8_t *pui8Data, int32_t i32Count, uint32_t ui32Value)
+{
+    uint32_t ui32Word0, ui32Word1, ui32Word2;
+
+    //
+    // Draw single pixels until the buffer pointer is word aligned.  Since a
+    // pixel is three bytes, this takes at most three pixels.
+    //
+    while(((uint32_t)pui8Data & 3) && i32Count)
+    {
+        pui8Data[0] = ui32Value & 0xff;
+        pui8Data[1] = (ui32Value >> 8) & 0xff;
+        pui8Data[2] = (ui32Value >> 16) & 0xff;
+        pui8Data += 3;
+        i32Count--;
+    }
+
+    //
+    // Build the three words that hold four consecutive pixels of this color.
+    //
+    ui32Value &= 0x00ffffff;
+    ui32Word0 = ui32Value | (ui32Value << 24);
+    ui32Word1 = (ui32Value >> 8) | (ui32Value << 16);
+    ui32Word2 = (ui32Value >> 16) | (ui32Value << 8);
+
+    //
+    // Loop while there are at least four pixels left to draw.
+    //
+    while(i32Count >= 4)
+    {
+        //
+        // Draw four pixels.
+        //
+        ((uint32_t *)pui8Data)[0] = ui32Word0;
+        ((uint32_t *)pui8Data)[1] = ui32Word1;
+        ((uint32_t *)pui8Data)[2] = ui32Word2;
+        pui8Data += 12;
+        i32Count -= 4;
+    }
+
+    //
+    // Draw any remaining pixels.
+    //
+    while(i32Count--)
+    {
+        pui8Data[0] = ui32Value & 0xff;
+        pui8Data[1] = (ui32Value >> 8) & 0xff;
+        pui8Data[2] = (ui32Value >> 16) & 0xff;
+        pui8Data += 3;
+    }
+}
+
+//*****************************************************************************
+//
+// Draws a horizontal span of pixels in the image buffer from pixel data which
+// is read out of order.  The position of each pixel within the pixel data is
+// given in bits, starting at i32Pos and advancing by i32Step bits per pixel,
+// so that a span can be read along a column of the pixel data or backwards
+// along a row.  The pixel and palette formats are those accepted by
+// GrOffScreen24BPPPixelDrawMultiple().
+//
+//*****************************************************************************
+static void
+SpanGather24(uint8_t *pui8Ptr, int32_t i32Count, const uint8_t *pui8Data,
+             int32_t i32Pos, int32_t i32Step, int32_t i32Bits,
+             const uint8_t *pui8Palette)
+{
+    const uint8_t *pui8Color;
+    uint32_t ui32Pixel;
+
+    switch(i32Bits)
+    {
+        //
+        // The palette holds translated colors for 1 bit per pixel data, and
+        // 24-bit RGB colors (which are the native format) for 4 and 8 bit
+        // per pixel data.
+        //
+        case 1:
+        {
+            while(i32Count--)
+            {
+                pui8Color = pui8Palette + (((pui8Data[i32Pos >> 3] >>
+                                             (7 - (i32Pos & 7))) & 1) * 4);
+                *pui8Ptr++ = pui8Color[0];
+                *pui8Ptr++ = pui8Color[1];
+                *pui8Ptr++ = pui8Color[2];
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        case 4:
+        {
+            while(i32Count--)
+            {
+                pui8Color = pui8Palette + (((pui8Data[i32Pos >> 3] >>
+                                             (4 - (i32Pos & 7))) & 15) * 3);
+                *pui8Ptr++ = pui8Color[0];
+                *pui8Ptr++ = pui8Color[1];
+                *pui8Ptr++ = pui8Color[2];
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        case 8:
+        {
+            while(i32Count--)
+            {
+                pui8Color = pui8Palette + (pui8Data[i32Pos >> 3] * 3);
+                *pui8Ptr++ = pui8Color[0];
+                *pui8Ptr++ = pui8Color[1];
+                *pui8Ptr++ = pui8Color[2];
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        //
+        // The 5-6-5 RGB pixels are expanded to eight bits per component.
+        //
+        case 16:
+        {
+            while(i32Count--)
+            {
+                ui32Pixel = *(uint16_t *)(pui8Data + (i32Pos >> 3));
+                *pui8Ptr++ = (((ui32Pixel << 3) & 0xf8) |
+                              ((ui32Pixel >> 2) & 7));
+                *pui8Ptr++ = (((ui32Pixel >> 3) & 0xfc) |
+                              ((ui32Pixel >> 9) & 3));
+                *pui8Ptr++ = (((ui32Pixel >> 8) & 0xf8) |
+                              ((ui32Pixel >> 13) & 7));
+                i32Pos += i32Step;
+            }
+            break;
+        }
+
+        //
+        // The native 8-8-8 RGB pixels are copied.
+        //
+        case 24:
+        {
+            while(i32Count--)
+            {
+                pui8Color = pui8Data + (i32Pos >> 3);
+                *pui8Ptr++ = pui8Color[0];
+                *pui8Ptr++ = pui8Color[1];
+                *pui8Ptr++ = pui8Color[2];
+                i32Pos += i32Step;
+            }
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Translates a 24-bit RGB color to a display driver-specific color.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param ui32Value is the 24-bit RGB color.  The least-significant byte is
+//! the blue channel, the next byte is the green channel, and the third byte is
+//! the red channel.
+//!
+//! This function translates a 24-bit RGB color into a value that can be
+//! written into the display's frame buffer in order to reproduce that color,
+//! or the closest possible approximation of that color.
+//!
+//! \return Returns the display-driver specific color.
+//
+//*****************************************************************************
+static uint32_t
+GrOffScreen24BPPColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    //
+    // The off-screen buffer holds 24-bit RGB colors directly.
+    //
+    return(ui32Value & 0x00ffffff);
+}
+
+//*****************************************************************************
+//
+//! Draws a pixel on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the pixel.
+//! \param i32Y is the Y coordinate of the pixel.
+//! \param ui32Value is the color of the pixel.
+//!
+//! This function sets the given pixel to a particular color.  The coordinates
+//! of the pixel are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                          uint32_t ui32Value)
+{
+    uint8_t *pui8Data;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Get a pointer to the pixel in question.
+    //
+    pui8Data = PIXEL_PTR24((uint8_t *)pvDisplayData, i32X, i32Y);
+
+    //
+    // Write this pixel into the image buffer.
+    //
+    pui8Data[0] = ui32Value & 0xff;
+    pui8Data[1] = (ui32Value >> 8) & 0xff;
+    pui8Data[2] = (ui32Value >> 16) & 0xff;
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the first pixel.
+//! \param i32Y is the Y coordinate of the first pixel.
+//! \param i32X0 is sub-pixel offset within the pixel data, which is valid for
+//! 1 or 4 bit per pixel formats.
+//! \param i32Count is the number of pixels to draw.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this run represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data.  For 1 and 4 bit per pixel
+//! formats, the most significant bit(s) represent the left-most pixel.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a horizontal sequence of pixels on the screen, using
+//! the supplied palette.  For 1 bit per pixel format, the palette contains
+//! pre-translated colors; for 4 and 8 bit per pixel formats, the palette
+//! contains 24-bit RGB values that are written to the display directly.  For
+//! 16 bit per pixel format, the data is 5-6-5 RGB and is expanded; for 24 bit
+//! per pixel format, the data is copied directly.  No palette is used for the
+//! 16 and 24 bit per pixel formats.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPPixelDrawMultiple(void *pvDisplayData, int32_t i32X,
+                                  int32_t i32Y, int32_t i32X0,
+                                  int32_t i32Count, int32_t i32BPP,
+                                  const uint8_t *pui8Data,
+                                  const uint8_t *pui8Palette)
+{
+    uint8_t *pui8Ptr;
+    const uint8_t *pui8Color;
+    uint32_t ui32Byte;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(pui8Data);
+
+    //
+    // Get a pointer to the starting pixel within the image buffer.
+    //
+    pui8Ptr = PIXEL_PTR24((uint8_t *)pvDisplayData, i32X, i32Y);
+
+    //
+    // Determine how to interpret the pixel data based on the number of bits
+    // per pixel.
+    //
+    switch(i32BPP & 0xFF)
+    {
+        //
+        // The pixel data is in 1 bit per pixel format.
+        //
+        case 1:
+        {
+            //
+            // Loop while there are more pixels to draw.
+            //
+            while(i32Count)
+            {
+                //
+                // Get the next byte of image data.
+                //
+                ui32Byte = *pui8Data++;
+
+                //
+                // Loop through the pixels in this byte of image data.
+                //
+                for(; (i32X0 < 8) && i32Count; i32X0++, i32Count--)
+                {
+                    //
+                    // Draw this pixel in the appropriate color.
+                    //
+                    pui8Color = pui8Palette +
+                                (((ui32Byte >> (7 - i32X0)) & 1) * 4);
+                    *pui8Ptr++ = pui8Color[0];
+                    *pui8Ptr++ = pui8Color[1];
+                    *pui8Ptr++ = pui8Color[2];
+                }
+
+                //
+                // Start at the beginning of the next byte of image data.
+                //
+                i32X0 = 0;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 4 bit per pixel format.
+        //
+        case 4:
+        {
+            //
+            // Loop while there are more pixels to draw.  "Duff's device" is
+            // used to jump into the middle of the loop if the first nibble of
+            // the pixel data should not be used.  Duff's device makes use of
+            // the fact that a case statement is legal anywhere within a
+            // sub-block of a switch statement.  See
+            // http://en.wikipedia.org/wiki/Duff's_device for detailed
+            // information about Duff's device.
+            //
+            switch(i32X0 & 1)
+            {
+                case 0:
+                    while(i32Count)
+                    {
+                        //
+                        // Get the upper nibble of the next byte of pixel data
+                        // and copy the corresponding palette entry to the
+                        // screen.  Palette entries are already stored in the
+                        // order used by the image buffer.
+                        //
+                        pui8Color = pui8Palette + ((*pui8Data >> 4) * 3);
+                        *pui8Ptr++ = pui8Color[0];
+                        *pui8Ptr++ = pui8Color[1];
+                        *pui8Ptr++ = pui8Color[2];
+
+                        //
+                        // Decrement the count of pixels to draw.
+                        //
+                        i32Count--;
+
+                        //
+                        // See if there is another pixel to draw.
+                        //
+                        if(i32Count)
+                        {
+                case 1:
+                            //
+                            // Get the lower nibble of the next byte of pixel
+                            // data and copy the corresponding palette entry to
+                            // the screen.
+                            //
+                            pui8Color = pui8Palette + ((*pui8Data++ & 15) * 3);
+                            *pui8Ptr++ = pui8Color[0];
+                            *pui8Ptr++ = pui8Color[1];
+                            *pui8Ptr++ = pui8Color[2];
+
+                            //
+                            // Decrement the count of pixels to draw.
+                            //
+                            i32Count--;
+                        }
+                    }
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 8 bit per pixel format.
+        //
+        case 8:
+        {
+            //
+            // Loop while there are more pixels to draw.
+            //
+            while(i32Count--)
+            {
+                //
+                // Get the next byte of pixel data and copy the corresponding
+                // palette entry to the screen.
+                //
+                pui8Color = pui8Palette + (*pui8Data++ * 3);
+                *pui8Ptr++ = pui8Color[0];
+                *pui8Ptr++ = pui8Color[1];
+                *pui8Ptr++ = pui8Color[2];
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in 5-6-5 RGB format.
+        //
+        case 16:
+        {
+            //
+            // Loop while there are more pixels to draw.
+            //
+            while(i32Count--)
+            {
+                //
+                // Get the next pixel and expand each color component to eight
+                // bits, replicating the most significant bits into the newly
+                // created least significant bits.
+                //
+                ui32Byte = *(uint16_t *)pui8Data;
+                pui8Data += 2;
+                *pui8Ptr++ = ((ui32Byte << 3) & 0xf8) | ((ui32Byte >> 2) & 7);
+                *pui8Ptr++ = (((ui32Byte >> 3) & 0xfc) |
+                              ((ui32Byte >> 9) & 3));
+                *pui8Ptr++ = (((ui32Byte >> 8) & 0xf8) |
+                              ((ui32Byte >> 13) & 7));
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+
+        //
+        // The pixel data is in the native 8-8-8 RGB format.
+        //
+        case 24:
+        {
+            //
+            // Determine the number of bytes to copy.
+            //
+            i32Count *= 3;
+
+            //
+            // If the source and destination pointers share the same word
+            // alignment, copy single bytes until both are word aligned and
+            // then copy a word at a time.
+            //
+            if((((uint32_t)pui8Ptr ^ (uint32_t)pui8Data) & 3) == 0)
+            {
+                while(((uint32_t)pui8Ptr & 3) && i32Count)
+                {
+                    *pui8Ptr++ = *pui8Data++;
+                    i32Count--;
+                }
+                while(i32Count >= 4)
+                {
+                    *(uint32_t *)pui8Ptr = *(uint32_t *)pui8Data;
+                    pui8Ptr += 4;
+                    pui8Data += 4;
+                    i32Count -= 4;
+                }
+            }
+
+            //
+            // Copy any remaining bytes.
+            //
+            while(i32Count--)
+            {
+                *pui8Ptr++ = *pui8Data++;
+            }
+
+            //
+            // The image data has been drawn.
+            //
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X1 is the X coordinate of the start of the line.
+//! \param i32X2 is the X coordinate of the end of the line.
+//! \param i32Y is the Y coordinate of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a horizontal line on the display.  The coordinates of
+//! the line are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2,
+                          int32_t i32Y, uint32_t ui32Value)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Fill the span of pixels covered by the line.
+    //
+    SpanFill24(PIXEL_PTR24((uint8_t *)pvDisplayData, i32X1, i32Y),
+               i32X2 - i32X1 + 1, ui32Value);
+}
+
+//*****************************************************************************
+//
+//! Draws a vertical line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the line.
+//! \param i32Y1 is the Y coordinate of the start of the line.
+//! \param i32Y2 is the Y coordinate of the end of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a vertical line on the display.  The coordinates of the
+//! line are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1,
+                          int32_t i32Y2, uint32_t ui32Value)
+{
+    uint8_t *pui8Data;
+    int32_t i32BytesPerRow;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Compute the number of bytes per row in the image buffer.
+    //
+    i32BytesPerRow = *(uint16_t *)((uint8_t *)pvDisplayData + 1) * 3;
+
+    //
+    // Get a pointer to the starting pixel.
+    //
+    pui8Data = PIXEL_PTR24((uint8_t *)pvDisplayData, i32X, i32Y1);
+
+    //
+    // Loop over the rows of the line.
+    //
+    for(; i32Y1 <= i32Y2; i32Y1++)
+    {
+        pui8Data[0] = ui32Value & 0xff;
+        pui8Data[1] = (ui32Value >> 8) & 0xff;
+        pui8Data[2] = (ui32Value >> 16) & 0xff;
+        pui8Data += i32BytesPerRow;
+    }
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param pRect is a pointer to the structure describing the rectangle.
+//! \param ui32Value is the color of the rectangle.
+//!
+//! This function fills a rectangle on the display.  The coordinates of the
+//! rectangle are assumed to be within the extents of the display, and the
+//! rectangle specification is fully inclusive (in other words, both i16XMin
+//! and i16XMax are drawn, along with i16YMin and i16YMax).
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPRectFill(void *pvDisplayData, const tRectangle *pRect,
+                         uint32_t ui32Value)
+{
+    uint8_t *pui8Data;
+    int32_t i32BytesPerRow, i32Count, i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(pRect);
+
+    //
+    // Compute the number of bytes per row in the image buffer.
+    //
+    i32BytesPerRow = *(uint16_t *)((uint8_t *)pvDisplayData + 1) * 3;
+
+    //
+    // Get a pointer to the upper left pixel of the rectangle.
+    //
+    pui8Data = PIXEL_PTR24((uint8_t *)pvDisplayData, pRect->i16XMin,
+                           pRect->i16YMin);
+
+    //
+    // Determine the number of pixels in each row of the rectangle.
+    //
+    i32Count = pRect->i16XMax - pRect->i16XMin + 1;
+
+    //
+    // Fill each row of the rectangle in turn.
+    //
+    for(i32Y = pRect->i16YMin; i32Y <= pRect->i16YMax; i32Y++)
+    {
+        SpanFill24(pui8Data, i32Count, ui32Value);
+        pui8Data += i32BytesPerRow;
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a rectangle of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this rectangle represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a rectangle of pixels on the screen, using the pixel
+//! and palette formats accepted by GrOffScreen24BPPPixelDrawMultiple().  When
+//! the pixel data is in the native 8-8-8 RGB format and spans entire rows of
+//! the image buffer, the rectangle is contiguous in both the pixel data and
+//! the image buffer and is copied as a single run of pixels.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPBlit(void *pvDisplayData, const tRectangle *psRect,
+                     int32_t i32X0, int32_t i32BPP, const uint8_t *pui8Data,
+                     int32_t i32Stride, const uint8_t *pui8Palette)
+{
+    int32_t i32Width, i32Rows, i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+    ASSERT(pui8Data);
+
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+
+    //
+    // See if the rectangle is a contiguous block of native pixels.
+    //
+    if(((i32BPP & 0xFF) == 24) &&
+       (i32Width == *(uint16_t *)((uint8_t *)pvDisplayData + 1)) &&
+       (i32Stride == (i32Width * 3)))
+    {
+        //
+        // Copy the entire rectangle as one run of pixels.
+        //
+        GrOffScreen24BPPPixelDrawMultiple(pvDisplayData, 0, psRect->i16YMin,
+                                          0, i32Width * i32Rows, i32BPP,
+                                          pui8Data, pui8Palette);
+        return;
+    }
+
+    //
+    // Otherwise, draw the rectangle a row at a time.
+    //
+    for(i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++)
+    {
+        GrOffScreen24BPPPixelDrawMultiple(pvDisplayData, psRect->i16XMin,
+                                          i32Y, i32X0, i32Width, i32BPP,
+                                          pui8Data, pui8Palette);
+        pui8Data += i32Stride;
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a rotated rectangle of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle on the
+//! screen.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this rectangle represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//! \param ui32Rotation is the clockwise rotation of the pixel data onto the
+//! screen, which is one of the \b GRLIB_ROTATE_* values.
+//!
+//! This function draws a rectangle of pixels which is rotated onto the
+//! screen, using the pixel and palette formats accepted by
+//! GrOffScreen24BPPPixelDrawMultiple().  The image buffer is written a row at
+//! a time, reading each row from a column of the pixel data for the 90 and
+//! 270 degree rotations, or from a row of the pixel data in reverse for the
+//! 180 degree rotation.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPBlitRotated(void *pvDisplayData, const tRectangle *psRect,
+                            int32_t i32X0, int32_t i32BPP,
+                            const uint8_t *pui8Data, int32_t i32Stride,
+                            const uint8_t *pui8Palette, uint32_t ui32Rotation)
+{
+    int32_t i32Width, i32Rows, i32Bits, i32Pos, i32Step, i32RowStep, i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+    ASSERT(pui8Data);
+    ASSERT(ui32Rotation <= GRLIB_ROTATE_270);
+
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+
+    //
+    // The sub-pixel offset only applies to the packed formats.
+    //
+    i32Bits = i32BPP & 0xFF;
+    i32X0 = (i32Bits < 8) ? (i32X0 & ((8 / i32Bits) - 1)) : 0;
+
+    //
+    // Find the position (in bits) in the pixel data of the first pixel of the
+    // first row on the screen, and the steps to the next pixel in the row and
+    // to the first pixel of the next row.
+    //
+    switch(ui32Rotation)
+    {
+        case GRLIB_ROTATE_90:
+        {
+            i32Pos = ((i32Width - 1) * i32Stride * 8) + (i32X0 * i32Bits);
+            i32Step = -i32Stride * 8;
+            i32RowStep = i32Bits;
+            break;
+        }
+
+        case GRLIB_ROTATE_180:
+        {
+            i32Pos = (((i32Rows - 1) * i32Stride * 8) +
+                      ((i32X0 + i32Width - 1) * i32Bits));
+            i32Step = -i32Bits;
+            i32RowStep = -i32Stride * 8;
+            break;
+        }
+
+        case GRLIB_ROTATE_270:
+        {
+            i32Pos = (i32X0 + i32Rows - 1) * i32Bits;
+            i32Step = i32Stride * 8;
+            i32RowStep = -i32Bits;
+            break;
+        }
+
+        default:
+        {
+            i32Pos = i32X0 * i32Bits;
+            i32Step = i32Bits;
+            i32RowStep = i32Stride * 8;
+            break;
+        }
+    }
+
+    //
+    // Draw each row of the rectangle on the screen.
+    //
+    for(i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++)
+    {
+        SpanGather24(PIXEL_PTR24((uint8_t *)pvDisplayData, psRect->i16XMin,
+                                 i32Y), i32Width, pui8Data, i32Pos, i32Step,
+                     i32Bits, pui8Palette);
+        i32Pos += i32RowStep;
+    }
+}
+
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies a rectangle of pixels within the off-screen buffer.
+//! The rows, and the pixels within each row, are copied in the order that
+//! allows the source and destination to overlap.  The coordinates of both
+//! rectangles are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                         int32_t i32X, int32_t i32Y)
+{
+    uint8_t *pui8Src, *pui8Dst;
+    int32_t i32Width, i32Rows, i32Count, i32Step, i32Stride, i32Idx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    //
+    // Get pointers to the first pixel of the source and destination, and the
+    // distance between rows of the image buffer.
+    //
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+    pui8Src = PIXEL_PTR24((uint8_t *)pvDisplayData, psRect->i16XMin,
+                    psRect->i16YMin);
+    pui8Dst = PIXEL_PTR24((uint8_t *)pvDisplayData, i32X, i32Y);
+    i32Stride = *(uint16_t *)((uint8_t *)pvDisplayData + 1) * 3;
+    i32Step = 3;
+
+    //
+    // If the destination is below the source, copy the rows from the bottom
+    // up so that each source row is copied before it is overwritten.
+    //
+    if(i32Y > psRect->i16YMin)
+    {
+        pui8Src += (i32Rows - 1) * i32Stride;
+        pui8Dst += (i32Rows - 1) * i32Stride;
+        i32Stride = -i32Stride;
+    }
+
+    //
+    // Likewise, if the destination is to the right of the source, copy each
+    // row from right to left.
+    //
+    if(i32X > psRect->i16XMin)
+    {
+        pui8Src += (i32Width - 1) * i32Step;
+        pui8Dst += (i32Width - 1) * i32Step;
+        i32Step = -i32Step;
+    }
+
+    //
+    // Loop through the rows of the rectangle.
+    //
+    while(i32Rows--)
+    {
+        //
+        // Copy the pixels of this row.
+        //
+        for(i32Count = 0; i32Count < i32Width; i32Count++)
+        {
+            i32Idx = i32Count * i32Step;
+            pui8Dst[i32Idx] = pui8Src[i32Idx];
+            pui8Dst[i32Idx + 1] = pui8Src[i32Idx + 1];
+            pui8Dst[i32Idx + 2] = pui8Src[i32Idx + 2];
+        }
+
+        //
+        // Move to the next row.
+        //
+        pui8Src += i32Stride;
+        pui8Dst += i32Stride;
+    }
+}
+
+//*****************************************************************************
+//
+//! Flushes any cached drawing operations.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//!
+//! This functions flushes any cached drawing operations to the display.  This
+//! is useful when a local frame buffer is used for drawing operations, and the
+//! flush would copy the local frame buffer to the display.  For the off-screen
+//! display buffer driver, the flush is a no operation.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen24BPPFlush(void *pvDisplayData)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+}
+
+//*****************************************************************************
+//
+//! Initializes a 24 BPP off-screen buffer.
+//!
+//! \param psDisplay is a pointer to the display structure to be configured for
+//! the 24 BPP off-screen buffer.
+//! \param pui8Image is a pointer to the image buffer to be used for the
+//! off-screen buffer.
+//! \param i32Width is the width of the image buffer in pixels.
+//! \param i32Height is the height of the image buffer in pixels.
+//!
+//! This function initializes a display structure, preparing it to draw into
+//! the supplied image buffer.  The image buffer is assumed to be large enough
+//! to hold an image of the specified geometry, as returned by
+//! GrOffScreen24BPPSize().
+//!
+//! Pixels are stored as 24-bit RGB values, so no color information is lost
+//! when drawing into the buffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrOffScreen24BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
+                     int32_t i32Height)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDisplay);
+    ASSERT(pui8Image);
+
+    //
+    // Initialize the display structure.
+    //
+    psDisplay->i32Size = sizeof(tDisplay);
+    psDisplay->pvDisplayData = pui8Image;
+    psDisplay->ui16Width = i32Width;
+    psDisplay->ui16Height = i32Height;
+    psDisplay->pfnPixelDraw = GrOffScreen24BPPPixelDraw;
+    psDisplay->pfnPixelDrawMultiple = GrOffScreen24BPPPixelDrawMultiple;
+    psDisplay->pfnLineDrawH = GrOffScreen24BPPLineDrawH;
+    psDisplay->pfnLineDrawV = GrOffScreen24BPPLineDrawV;
+    psDisplay->pfnRectFill = GrOffScreen24BPPRectFill;
+    psDisplay->pfnColorTranslate = GrOffScreen24BPPColorTranslate;
+    psDisplay->pfnFlush = GrOffScreen24BPPFlush;
+    psDisplay->pfnBlit = GrOffScreen24BPPBlit;
+    psDisplay->pfnRectCopy = GrOffScreen24BPPRectCopy;
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = GrOffScreen24BPPBlitRotated;
+
+    //
+    // Initialize the image buffer.  The sixth byte of the header is reserved
+    // so that the header has the same size as the 16 BPP format.
+    //
+    pui8Image[0] = IMAGE_FMT_24BPP_UNCOMP;
+    *(uint16_t *)(pui8Image + 1) = i32Width;
+    *(uint16_t *)(pui8Image + 3) = i32Height;
+    pui8Image[5] = 0;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -857,6 +857,94 @@ GrOffScreen4BPPRectFill(void *pvDisplayData, const tRectangle *pRect,
     }
 }
 
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies a rectangle of pixels within the off-screen buffer.
+//! The rows, and the pixels within each row, are copied in the order that
+//! allows the source and destination to overlap.  The coordinates of both
+//! rectangles are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen4BPPRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                        int32_t i32X, int32_t i32Y)
+{
+    int32_t i32BytesPerRow, i32Width, i32Rows, i32Row, i32Col;
+    int32_t i32SrcX, i32SrcY, i32DstX, i32DstY;
+    uint8_t *pui8Data, *pui8Src, *pui8Dst;
+    uint32_t ui32Value;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    //
+    // Create a character pointer for the display-specific data (which points
+    // to the image buffer), and compute the number of bytes per row in the
+    // image buffer.
+    //
+    pui8Data = (uint8_t *)pvDisplayData;
+    i32BytesPerRow = (*(uint16_t *)(pui8Data + 1) + 1) / 2;
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+
+    //
+    // Loop through the rows of the rectangle.  If the destination is below
+    // the source, the rows are copied from the bottom up so that each source
+    // row is copied before it is overwritten.
+    //
+    for(i32Row = 0; i32Row < i32Rows; i32Row++)
+    {
+        i32SrcY = ((i32Y > psRect->i16YMin) ? (i32Rows - 1 - i32Row) :
+                   i32Row);
+        i32DstY = i32Y + i32SrcY;
+        i32SrcY += psRect->i16YMin;
+
+        //
+        // Loop through the pixels of this row, working from right to left if
+        // the destination is to the right of the source.
+        //
+        for(i32Col = 0; i32Col < i32Width; i32Col++)
+        {
+            i32SrcX = ((i32X > psRect->i16XMin) ? (i32Width - 1 - i32Col) :
+                       i32Col);
+            i32DstX = i32X + i32SrcX;
+            i32SrcX += psRect->i16XMin;
+
+            //
+            // Read the source pixel.
+            //
+            pui8Src = (pui8Data + (i32BytesPerRow * i32SrcY) + (i32SrcX / 2) +
+                       6 + (16 * 3));
+            ui32Value = (*pui8Src >> ((1 - (i32SrcX & 1)) * 4)) & 15;
+
+            //
+            // Write it to the destination pixel.
+            //
+            pui8Dst = (pui8Data + (i32BytesPerRow * i32DstY) + (i32DstX / 2) +
+                       6 + (16 * 3));
+            i32DstX = (1 - (i32DstX & 1)) * 4;
+            *pui8Dst = ((*pui8Dst & ~(15 << i32DstX)) |
+                        (ui32Value << i32DstX));
+        }
+    }
+}
+
 //*****************************************************************************
 //
 //! Flushes any cached drawing operations.
@@ -923,6 +1011,10 @@ GrOffScreen4BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
     psDisplay->pfnRectFill = GrOffScreen4BPPRectFill;
     psDisplay->pfnColorTranslate = GrOffScreen4BPPColorTranslate;
     psDisplay->pfnFlush = GrOffScreen4BPPFlush;
+    psDisplay->pfnBlit = 0;
+    psDisplay->pfnRectCopy = GrOffScreen4BPPRectCopy;
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = 0;
 
     //
     // Initialize the image buffer.
@@ -947,7 +1039,8 @@ GrOffScreen4BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
 //! This function sets the entries of the palette used by the 4 BPP off-screen
 //! buffer.  The palette is used to select colors for drawing via
 //! GrOffScreen4BPPColorTranslate(), and for the final rendering of the image
-//! to a real display via GrImageDraw().
+//! to a real display via GrImageDraw().  Any color cache attached to the
+//! display with GrDisplayColorCacheSet() is flushed.
 //!
 //! \return None.
 //
@@ -988,6 +1081,14 @@ GrOffScreen4BPPPaletteSet(tDisplay *psDisplay, uint32_t *pui32Palette,
         *pui8Data++ = (*pui32Palette >> ClrGreenShift) & 0xff;
         *pui8Data++ = (*pui32Palette++ >> ClrRedShift) & 0xff;
     }
+
+    //
+    // Colors translated with the previous palette may no longer be correct.
+    //
+    if(psDisplay->psColorCache)
+    {
+        GrColorCacheFlush(psDisplay->psColorCache);
+    }
 }
 
 //*****************************************************************************
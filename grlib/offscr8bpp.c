@@ -698,6 +698,96 @@ GrOffScreen8BPPRectFill(void *pvDisplayData, const tRectangle *pRect,
     }
 }
 
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies a rectangle of pixels within the off-screen buffer.
+//! The rows, and the pixels within each row, are copied in the order that
+//! allows the source and destination to overlap.  The coordinates of both
+//! rectangles are assumed to be within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrOffScreen8BPPRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                        int32_t i32X, int32_t i32Y)
+{
+    uint8_t *pui8Src, *pui8Dst;
+    int32_t i32Width, i32Rows, i32Count, i32Step, i32Stride;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    //
+    // Get pointers to the first pixel of the source and destination, and the
+    // distance between rows of the image buffer.
+    //
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+    i32Rows = psRect->i16YMax - psRect->i16YMin + 1;
+    i32Stride = *(uint16_t *)((uint8_t *)pvDisplayData + 1);
+    pui8Src = ((uint8_t *)pvDisplayData + (i32Stride * psRect->i16YMin) +
+               psRect->i16XMin + 6 + (256 * 3));
+    pui8Dst = ((uint8_t *)pvDisplayData + (i32Stride * i32Y) + i32X + 6 +
+               (256 * 3));
+    i32Step = 1;
+
+    //
+    // If the destination is below the source, copy the rows from the bottom
+    // up so that each source row is copied before it is overwritten.
+    //
+    if(i32Y > psRect->i16YMin)
+    {
+        pui8Src += (i32Rows - 1) * i32Stride;
+        pui8Dst += (i32Rows - 1) * i32Stride;
+        i32Stride = -i32Stride;
+    }
+
+    //
+    // Likewise, if the destination is to the right of the source, copy each
+    // row from right to left.
+    //
+    if(i32X > psRect->i16XMin)
+    {
+        pui8Src += (i32Width - 1) * i32Step;
+        pui8Dst += (i32Width - 1) * i32Step;
+        i32Step = -i32Step;
+    }
+
+    //
+    // Loop through the rows of the rectangle.
+    //
+    while(i32Rows--)
+    {
+        //
+        // Copy the pixels of this row.
+        //
+        for(i32Count = 0; i32Count < i32Width; i32Count++)
+        {
+            pui8Dst[i32Count * i32Step] = pui8Src[i32Count * i32Step];
+        }
+
+        //
+        // Move to the next row.
+        //
+        pui8Src += i32Stride;
+        pui8Dst += i32Stride;
+    }
+}
+
 //*****************************************************************************
 //
 //! Flushes any cached drawing operations.
@@ -764,6 +854,10 @@ GrOffScreen8BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
     psDisplay->pfnRectFill = GrOffScreen8BPPRectFill;
     psDisplay->pfnColorTranslate = GrOffScreen8BPPColorTranslate;
     psDisplay->pfnFlush = GrOffScreen8BPPFlush;
+    psDisplay->pfnBlit = 0;
+    psDisplay->pfnRectCopy = GrOffScreen8BPPRectCopy;
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = 0;
 
     //
     // Initialize the image buffer.
@@ -788,7 +882,8 @@ GrOffScreen8BPPInit(tDisplay *psDisplay, uint8_t *pui8Image, int32_t i32Width,
 //! This function sets the entries of the palette used by the 8 BPP off-screen
 //! buffer.  The palette is used to select colors for drawing via
 //! GrOffScreen4BPPColorTranslate(), and for the final rendering of the image
-//! to a real display via GrImageDraw().
+//! to a real display via GrImageDraw().  Any color cache attached to the
+//! display with GrDisplayColorCacheSet() is flushed.
 //!
 //! \return None.
 //
@@ -829,6 +924,14 @@ GrOffScreen8BPPPaletteSet(tDisplay *psDisplay, uint32_t *pui32Palette,
         *pui8Data++ = (*pui32Palette >> ClrGreenShift) & 0xff;
         *pui8Data++ = (*pui32Palette++ >> ClrRedShift) & 0xff;
     }
+
+    //
+    // Colors translated with the previous palette may no longer be correct.
+    //
+    if(psDisplay->psColorCache)
+    {
+        GrColorCacheFlush(psDisplay->psColorCache);
+    }
 }
 
 //*****************************************************************************
@@ -0,0 +1,892 @@
+//*****************************************************************************
+//
+// offscrblit.c - Copies rectangles between off-screen displays.
+//
+// Copyright (c) 2008-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+//
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+//
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The ways in which a pixel value read from the source image is converted
+// into a pixel value for the destination image.
+//
+//*****************************************************************************
+#define BLIT_CONVERT_NONE       0       // The formats match; copy unchanged.
+#define BLIT_CONVERT_MAP        1       // Remap a palette index via a table.
+#define BLIT_CONVERT_565        2       // Translate a 5-6-5 RGB pixel.
+#define BLIT_CONVERT_RGB        3       // Translate a 24-bit RGB pixel.
+#define BLIT_CONVERT_565_TO_RGB 4       // Expand 5-6-5 RGB to 24-bit RGB.
+#define BLIT_CONVERT_RGB_TO_565 5       // Reduce 24-bit RGB to 5-6-5 RGB.
+
+//*****************************************************************************
+//
+// Converts between 5-6-5 RGB and 24-bit RGB colors.  When expanding, each
+// color component is extended to eight bits by replicating its most
+// significant bits into the new least significant bits.
+//
+//*****************************************************************************
+#define Color565ToRGB(c)        (((((c) << 3) & 0xf8) |                       \
+                                  (((c) >> 2) & 7)) |                         \
+                                 (((((c) >> 3) & 0xfc) |                      \
+                                   (((c) >> 9) & 3)) << 8) |                  \
+                                 (((((c) >> 8) & 0xf8) |                      \
+                                   (((c) >> 13) & 7)) << 16))
+#define ColorRGBTo565(c)        ((((c) & 0x00f80000) >> 8) |                  \
+                                 (((c) & 0x0000fc00) >> 5) |                  \
+                                 (((c) & 0x000000f8) >> 3))
+
+//*****************************************************************************
+//
+// A value which is neither a pixel value of an off-screen image nor returned
+// by the color translation function of an off-screen display.  It marks
+// entries of the palette remapping table which have not yet been computed and
+// transparent pixels which are not to be written.
+//
+//*****************************************************************************
+#define PIXEL_NONE              0xffffffff
+
+//*****************************************************************************
+//
+// The number of pixels which are read, converted, and written as a group when
+// the pixels of a blit must be converted.
+//
+//*****************************************************************************
+#define BLIT_CHUNK              32
+
+//*****************************************************************************
+//
+// Returns the number of bits per pixel of an uncompressed off-screen image.
+// The image format values of the uncompressed formats are equal to the
+// number of bits per pixel.
+//
+//*****************************************************************************
+#define ImageBPPGet(pui8Image)  ((uint32_t)(pui8Image)[0])
+
+//*****************************************************************************
+//
+// Returns a pointer to the first byte of the given row of an off-screen image.
+// The pixel data follows the image header and, for 4 BPP and 8 BPP images,
+// the palette.
+//
+//*****************************************************************************
+static uint8_t *
+ImageRowGet(uint8_t *pui8Image, uint32_t ui32BPP, int32_t i32Y)
+{
+    int32_t i32Width;
+
+    i32Width = *(uint16_t *)(pui8Image + 1);
+
+    switch(ui32BPP)
+    {
+        case 1:
+        {
+            return(pui8Image + 5 + (((i32Width + 7) / 8) * i32Y));
+        }
+
+        case 4:
+        {
+            return(pui8Image + 6 + (16 * 3) + (((i32Width + 1) / 2) * i32Y));
+        }
+
+        case 8:
+        {
+            return(pui8Image + 6 + (256 * 3) + (i32Width * i32Y));
+        }
+
+        default:
+        {
+            return(pui8Image + 6 + (i32Width * (ui32BPP / 8) * i32Y));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Reads the value of a pixel from a row of an off-screen image.
+//
+//*****************************************************************************
+static uint32_t
+PixelGet(const uint8_t *pui8Row, int32_t i32X, uint32_t ui32BPP)
+{
+    switch(ui32BPP)
+    {
+        case 1:
+        {
+            return((pui8Row[i32X >> 3] >> (7 - (i32X & 7))) & 1);
+        }
+
+        case 4:
+        {
+            return((pui8Row[i32X >> 1] >> ((i32X & 1) ? 0 : 4)) & 15);
+        }
+
+        case 8:
+        {
+            return(pui8Row[i32X]);
+        }
+
+        case 16:
+        {
+            return(((uint16_t *)pui8Row)[i32X]);
+        }
+
+        default:
+        {
+            pui8Row += i32X * 3;
+            return(pui8Row[0] | (pui8Row[1] << 8) | (pui8Row[2] << 16));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Writes the value of a pixel into a row of an off-screen image.
+//
+//*****************************************************************************
+static void
+PixelSet(uint8_t *pui8Row, int32_t i32X, uint32_t ui32BPP,
+         uint32_t ui32Value)
+{
+    switch(ui32BPP)
+    {
+        case 1:
+        {
+            pui8Row += i32X >> 3;
+            *pui8Row = ((*pui8Row & ~(0x80 >> (i32X & 7))) |
+                        ((ui32Value & 1) << (7 - (i32X & 7))));
+            break;
+        }
+
+        case 4:
+        {
+            pui8Row += i32X >> 1;
+            if(i32X & 1)
+            {
+                *pui8Row = (*pui8Row & 0xf0) | (ui32Value & 15);
+            }
+            else
+            {
+                *pui8Row = (*pui8Row & 0x0f) | ((ui32Value & 15) << 4);
+            }
+            break;
+        }
+
+        case 8:
+        {
+            pui8Row[i32X] = ui32Value;
+            break;
+        }
+
+        case 16:
+        {
+            ((uint16_t *)pui8Row)[i32X] = ui32Value;
+            break;
+        }
+
+        default:
+        {
+            pui8Row += i32X * 3;
+            pui8Row[0] = ui32Value;
+            pui8Row[1] = ui32Value >> 8;
+            pui8Row[2] = ui32Value >> 16;
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Reads the values of a run of pixels from a row of an off-screen image.
+//
+//*****************************************************************************
+static void
+RowRead(const uint8_t *pui8Row, int32_t i32X, int32_t i32Count,
+        uint32_t ui32BPP, uint32_t *pui32Values)
+{
+    int32_t i32Idx;
+
+    switch(ui32BPP)
+    {
+        case 1:
+        {
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++, i32X++)
+            {
+                pui32Values[i32Idx] = ((pui8Row[i32X >> 3] >>
+                                        (7 - (i32X & 7))) & 1);
+            }
+            break;
+        }
+
+        case 4:
+        {
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++, i32X++)
+            {
+                pui32Values[i32Idx] = ((pui8Row[i32X >> 1] >>
+                                        ((i32X & 1) ? 0 : 4)) & 15);
+            }
+            break;
+        }
+
+        case 8:
+        {
+            pui8Row += i32X;
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+            {
+                pui32Values[i32Idx] = pui8Row[i32Idx];
+            }
+            break;
+        }
+
+        case 16:
+        {
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+            {
+                pui32Values[i32Idx] = ((uint16_t *)pui8Row)[i32X + i32Idx];
+            }
+            break;
+        }
+
+        default:
+        {
+            pui8Row += i32X * 3;
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++, pui8Row += 3)
+            {
+                pui32Values[i32Idx] = (pui8Row[0] | (pui8Row[1] << 8) |
+                                       (pui8Row[2] << 16));
+            }
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Writes the values of a run of pixels into a row of an off-screen image,
+// skipping any pixel whose value is PIXEL_NONE.
+//
+//*****************************************************************************
+static void
+RowWrite(uint8_t *pui8Row, int32_t i32X, int32_t i32Count, uint32_t ui32BPP,
+         const uint32_t *pui32Values)
+{
+    int32_t i32Idx;
+
+    switch(ui32BPP)
+    {
+        case 1:
+        case 4:
+        {
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+            {
+                if(pui32Values[i32Idx] != PIXEL_NONE)
+                {
+                    PixelSet(pui8Row, i32X + i32Idx, ui32BPP,
+                             pui32Values[i32Idx]);
+                }
+            }
+            break;
+        }
+
+        case 8:
+        {
+            pui8Row += i32X;
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+            {
+                if(pui32Values[i32Idx] != PIXEL_NONE)
+                {
+                    pui8Row[i32Idx] = pui32Values[i32Idx];
+                }
+            }
+            break;
+        }
+
+        case 16:
+        {
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+            {
+                if(pui32Values[i32Idx] != PIXEL_NONE)
+                {
+                    ((uint16_t *)pui8Row)[i32X + i32Idx] =
+                        pui32Values[i32Idx];
+                }
+            }
+            break;
+        }
+
+        default:
+        {
+            pui8Row += i32X * 3;
+            for(i32Idx = 0; i32Idx < i32Count; i32Idx++, pui8Row += 3)
+            {
+                if(pui32Values[i32Idx] != PIXEL_NONE)
+                {
+                    pui8Row[0] = pui32Values[i32Idx];
+                    pui8Row[1] = pui32Values[i32Idx] >> 8;
+                    pui8Row[2] = pui32Values[i32Idx] >> 16;
+                }
+            }
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Copies a run of bytes between two images, which must not overlap.  Once the
+// destination is word aligned, the bulk of the run is copied a word at a
+// time; as in the 16 BPP driver, the source may be unaligned.
+//
+//*****************************************************************************
+static void
+BytesCopy(uint8_t *pui8Dst, const uint8_t *pui8Src, int32_t i32Count)
+{
+    //
+    // Copy bytes until the destination pointer is word aligned.
+    //
+    while(((uint32_t)pui8Dst & 3) && i32Count)
+    {
+        *pui8Dst++ = *pui8Src++;
+        i32Count--;
+    }
+
+    //
+    // Copy as many whole words as possible.
+    //
+    while(i32Count >= 4)
+    {
+        *(uint32_t *)pui8Dst = *(uint32_t *)pui8Src;
+        pui8Dst += 4;
+        pui8Src += 4;
+        i32Count -= 4;
+    }
+
+    //
+    // Copy any remaining bytes.
+    //
+    while(i32Count--)
+    {
+        *pui8Dst++ = *pui8Src++;
+    }
+}
+
+//*****************************************************************************
+//
+// Determines if two palette based images of the same format share the same
+// palette, in which case their pixel values may be copied unchanged.
+//
+//*****************************************************************************
+static bool
+PaletteCompare(const uint8_t *pui8Src, const uint8_t *pui8Dst,
+               uint32_t ui32BPP)
+{
+    uint32_t ui32Idx;
+
+    //
+    // 1 BPP images have no palette; their pixels are black or white.
+    //
+    if(ui32BPP == 1)
+    {
+        return(true);
+    }
+
+    //
+    // Compare the palettes, which follow the six byte image header.
+    //
+    for(ui32Idx = 6; ui32Idx < (6 + ((1 << ui32BPP) * 3)); ui32Idx++)
+    {
+        if(pui8Src[ui32Idx] != pui8Dst[ui32Idx])
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Copies a rectangle between two off-screen images, converting the pixel
+// format and dropping out a transparent color as required.  The rectangle has
+// already been clipped to both images.
+//
+//*****************************************************************************
+static void
+OffScreenBlit(const tDisplay *psDst, const tDisplay *psSrc,
+              const tRectangle *psRect, int32_t i32X, int32_t i32Y,
+              uint32_t ui32Transparent, bool bTransparent)
+{
+    uint32_t pui32Map[256], pui32Values[BLIT_CHUNK], ui32SrcBPP, ui32DstBPP;
+    uint32_t ui32Convert, ui32Value, ui32Color;
+    uint8_t *pui8Src, *pui8Dst, *pui8SrcRow, *pui8DstRow;
+    const uint8_t *pui8Palette;
+    int32_t i32Width, i32Row, i32Col, i32Idx, i32Count, i32RowStep;
+    int32_t i32ColStep;
+
+    pui8Src = psSrc->pvDisplayData;
+    pui8Dst = psDst->pvDisplayData;
+    ui32SrcBPP = ImageBPPGet(pui8Src);
+    ui32DstBPP = ImageBPPGet(pui8Dst);
+    i32Width = psRect->i16XMax - psRect->i16XMin + 1;
+
+    //
+    // Determine how the source pixels are converted.  Palette based source
+    // pixels are remapped through a table which is filled in as each palette
+    // entry is first used; direct color source pixels are translated as they
+    // are copied.
+    //
+    if((ui32SrcBPP == ui32DstBPP) &&
+       ((ui32SrcBPP >= 16) || (pui8Src == pui8Dst) ||
+        PaletteCompare(pui8Src, pui8Dst, ui32SrcBPP)))
+    {
+        ui32Convert = BLIT_CONVERT_NONE;
+    }
+    else if(ui32SrcBPP <= 8)
+    {
+        ui32Convert = BLIT_CONVERT_MAP;
+        for(i32Idx = 0; i32Idx < (1 << ui32SrcBPP); i32Idx++)
+        {
+            pui32Map[i32Idx] = PIXEL_NONE;
+        }
+    }
+    else if(ui32SrcBPP == 16)
+    {
+        ui32Convert = ((ui32DstBPP == 24) ? BLIT_CONVERT_565_TO_RGB :
+                       BLIT_CONVERT_565);
+    }
+    else
+    {
+        ui32Convert = ((ui32DstBPP == 16) ? BLIT_CONVERT_RGB_TO_565 :
+                       BLIT_CONVERT_RGB);
+    }
+
+    //
+    // Unconverted, opaque copies are performed a run of bytes at a time.
+    // For 1 BPP and 4 BPP images this requires the source and destination
+    // pixels to start at the same position within a byte.
+    //
+    if((ui32Convert == BLIT_CONVERT_NONE) && !bTransparent &&
+       (((psRect->i16XMin * ui32SrcBPP) & 7) == ((i32X * ui32DstBPP) & 7)))
+    {
+        for(i32Row = 0; i32Row <= (psRect->i16YMax - psRect->i16YMin);
+            i32Row++)
+        {
+            pui8SrcRow = ImageRowGet(pui8Src, ui32SrcBPP,
+                                     psRect->i16YMin + i32Row);
+            pui8DstRow = ImageRowGet(pui8Dst, ui32DstBPP, i32Y + i32Row);
+
+            //
+            // Copy any leading pixels which do not fill a whole byte.
+            //
+            for(i32Col = 0;
+                (i32Col < i32Width) && ((i32X + i32Col) * ui32DstBPP) & 7;
+                i32Col++)
+            {
+                PixelSet(pui8DstRow, i32X + i32Col, ui32DstBPP,
+                         PixelGet(pui8SrcRow, psRect->i16XMin + i32Col,
+                                  ui32SrcBPP));
+            }
+
+            //
+            // Copy the whole bytes.
+            //
+            i32Idx = ((i32Width - i32Col) * ui32SrcBPP) / 8;
+            BytesCopy(pui8DstRow + (((i32X + i32Col) * ui32DstBPP) / 8),
+                      pui8SrcRow +
+                      (((psRect->i16XMin + i32Col) * ui32SrcBPP) / 8),
+                      i32Idx);
+            i32Col += (i32Idx * 8) / ui32SrcBPP;
+
+            //
+            // Copy any trailing pixels which do not fill a whole byte.
+            //
+            for(; i32Col < i32Width; i32Col++)
+            {
+                PixelSet(pui8DstRow, i32X + i32Col, ui32DstBPP,
+                         PixelGet(pui8SrcRow, psRect->i16XMin + i32Col,
+                                  ui32SrcBPP));
+            }
+        }
+
+        return;
+    }
+
+    //
+    // Otherwise copy the pixels in chunks, each of which is read, converted,
+    // and written in turn.  When copying within a single image, work from the
+    // bottom up and/or right to left as needed so that each source pixel is
+    // read before it is overwritten.
+    //
+    i32Row = 0;
+    i32RowStep = 1;
+    if((pui8Src == pui8Dst) && (i32Y > psRect->i16YMin))
+    {
+        i32Row = psRect->i16YMax - psRect->i16YMin;
+        i32RowStep = -1;
+    }
+    i32ColStep = BLIT_CHUNK;
+    if((pui8Src == pui8Dst) && (i32X > psRect->i16XMin))
+    {
+        i32ColStep = -BLIT_CHUNK;
+    }
+
+    for(; (i32Row >= 0) && (i32Row <= (psRect->i16YMax - psRect->i16YMin));
+        i32Row += i32RowStep)
+    {
+        pui8SrcRow = ImageRowGet(pui8Src, ui32SrcBPP,
+                                 psRect->i16YMin + i32Row);
+        pui8DstRow = ImageRowGet(pui8Dst, ui32DstBPP, i32Y + i32Row);
+
+        for(i32Col = ((i32ColStep > 0) ? 0 :
+                      (((i32Width - 1) / BLIT_CHUNK) * BLIT_CHUNK));
+            (i32Col >= 0) && (i32Col < i32Width); i32Col += i32ColStep)
+        {
+            //
+            // Read this chunk of pixels.
+            //
+            i32Count = i32Width - i32Col;
+            if(i32Count > BLIT_CHUNK)
+            {
+                i32Count = BLIT_CHUNK;
+            }
+            RowRead(pui8SrcRow, psRect->i16XMin + i32Col, i32Count,
+                    ui32SrcBPP, pui32Values);
+
+            //
+            // Drop out the transparent pixels.
+            //
+            if(bTransparent)
+            {
+                for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+                {
+                    if(pui32Values[i32Idx] == ui32Transparent)
+                    {
+                        pui32Values[i32Idx] = PIXEL_NONE;
+                    }
+                }
+            }
+
+            //
+            // Convert the remaining pixels to the format of the destination.
+            //
+            switch(ui32Convert)
+            {
+                case BLIT_CONVERT_MAP:
+                {
+                    for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+                    {
+                        ui32Value = pui32Values[i32Idx];
+                        if(ui32Value == PIXEL_NONE)
+                        {
+                            continue;
+                        }
+
+                        //
+                        // Translate this palette entry if it has not been
+                        // used before.
+                        //
+                        if(pui32Map[ui32Value] == PIXEL_NONE)
+                        {
+                            if(ui32SrcBPP == 1)
+                            {
+                                ui32Color = ui32Value ? ClrWhite : ClrBlack;
+                            }
+                            else
+                            {
+                                pui8Palette = pui8Src + 6 + (ui32Value * 3);
+                                ui32Color = (pui8Palette[0] |
+                                             (pui8Palette[1] << 8) |
+                                             (pui8Palette[2] << 16));
+                            }
+                            pui32Map[ui32Value] = DpyColorTranslate(psDst,
+                                                                    ui32Color);
+                        }
+                        pui32Values[i32Idx] = pui32Map[ui32Value];
+                    }
+                    break;
+                }
+
+                case BLIT_CONVERT_565:
+                case BLIT_CONVERT_RGB:
+                {
+                    for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+                    {
+                        ui32Value = pui32Values[i32Idx];
+                        if(ui32Value != PIXEL_NONE)
+                        {
+                            if(ui32Convert == BLIT_CONVERT_565)
+                            {
+                                ui32Value = Color565ToRGB(ui32Value);
+                            }
+                            pui32Values[i32Idx] = DpyColorTranslate(psDst,
+                                                                    ui32Value);
+                        }
+                    }
+                    break;
+                }
+
+                case BLIT_CONVERT_565_TO_RGB:
+                {
+                    for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+                    {
+                        if(pui32Values[i32Idx] != PIXEL_NONE)
+                        {
+                            pui32Values[i32Idx] =
+                                Color565ToRGB(pui32Values[i32Idx]);
+                        }
+                    }
+                    break;
+                }
+
+                case BLIT_CONVERT_RGB_TO_565:
+                {
+                    for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+                    {
+                        if(pui32Values[i32Idx] != PIXEL_NONE)
+                        {
+                            pui32Values[i32Idx] =
+                                ColorRGBTo565(pui32Values[i32Idx]);
+                        }
+                    }
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+
+            //
+            // Write this chunk of pixels.
+            //
+            RowWrite(pui8DstRow, i32X + i32Col, i32Count, ui32DstBPP,
+                     pui32Values);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Clips a blit to the source and destination images, then performs it.
+//
+//*****************************************************************************
+static void
+OffScreenBlitClip(const tDisplay *psDst, const tDisplay *psSrc,
+                  const tRectangle *psRect, int32_t i32X, int32_t i32Y,
+                  uint32_t ui32Transparent, bool bTransparent)
+{
+    tRectangle sRect;
+    int32_t i32XMin, i32YMin, i32XMax, i32YMax;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDst);
+    ASSERT(psSrc);
+    ASSERT((((uint8_t *)psDst->pvDisplayData)[0] & 0x80) == 0);
+    ASSERT((((uint8_t *)psSrc->pvDisplayData)[0] & 0x80) == 0);
+
+    //
+    // Get the source rectangle, which defaults to the entire source image.
+    //
+    if(psRect)
+    {
+        i32XMin = psRect->i16XMin;
+        i32YMin = psRect->i16YMin;
+        i32XMax = psRect->i16XMax;
+        i32YMax = psRect->i16YMax;
+    }
+    else
+    {
+        i32XMin = 0;
+        i32YMin = 0;
+        i32XMax = psSrc->ui16Width - 1;
+        i32YMax = psSrc->ui16Height - 1;
+    }
+
+    //
+    // Clip the source rectangle to the source image, moving the destination
+    // by the amount clipped from the top left.
+    //
+    if(i32XMin < 0)
+    {
+        i32X -= i32XMin;
+        i32XMin = 0;
+    }
+    if(i32YMin < 0)
+    {
+        i32Y -= i32YMin;
+        i32YMin = 0;
+    }
+    if(i32XMax >= psSrc->ui16Width)
+    {
+        i32XMax = psSrc->ui16Width - 1;
+    }
+    if(i32YMax >= psSrc->ui16Height)
+    {
+        i32YMax = psSrc->ui16Height - 1;
+    }
+
+    //
+    // Clip the destination to the destination image.
+    //
+    if(i32X < 0)
+    {
+        i32XMin -= i32X;
+        i32X = 0;
+    }
+    if(i32Y < 0)
+    {
+        i32YMin -= i32Y;
+        i32Y = 0;
+    }
+    if((i32X + (i32XMax - i32XMin)) >= psDst->ui16Width)
+    {
+        i32XMax = i32XMin + psDst->ui16Width - 1 - i32X;
+    }
+    if((i32Y + (i32YMax - i32YMin)) >= psDst->ui16Height)
+    {
+        i32YMax = i32YMin + psDst->ui16Height - 1 - i32Y;
+    }
+
+    //
+    // Nothing is copied if the rectangle has been clipped away.
+    //
+    if((i32XMin > i32XMax) || (i32YMin > i32YMax))
+    {
+        return;
+    }
+
+    sRect.i16XMin = i32XMin;
+    sRect.i16YMin = i32YMin;
+    sRect.i16XMax = i32XMax;
+    sRect.i16YMax = i32YMax;
+
+    //
+    // An opaque copy within a single image is passed to the driver, which
+    // correctly handles overlapping source and destination rectangles.
+    //
+    if((psSrc->pvDisplayData == psDst->pvDisplayData) && !bTransparent &&
+       DpyRectCopySupported(psDst))
+    {
+        DpyRectCopy(psDst, &sRect, i32X, i32Y);
+        return;
+    }
+
+    OffScreenBlit(psDst, psSrc, &sRect, i32X, i32Y, ui32Transparent,
+                  bTransparent);
+}
+
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels from one off-screen display to another.
+//!
+//! \param psDst is a pointer to the off-screen display to copy to.
+//! \param psSrc is a pointer to the off-screen display to copy from.
+//! \param psRect is a pointer to the rectangle of \e psSrc to copy, or 0 to
+//! copy the entire source image.
+//! \param i32X is the X coordinate in \e psDst of the upper left corner of
+//! the copied rectangle.
+//! \param i32Y is the Y coordinate in \e psDst of the upper left corner of
+//! the copied rectangle.
+//!
+//! This function copies a rectangle of pixels directly between the image
+//! buffers of two off-screen displays (created with GrOffScreen1BPPInit(),
+//! GrOffScreen4BPPInit(), GrOffScreen8BPPInit(), GrOffScreen16BPPInit(), or
+//! GrOffScreen24BPPInit()), which allows a background to be restored from a
+//! saved copy rather than redrawn.  The rectangle is clipped to both
+//! displays.
+//!
+//! When both displays have the same format (and, for 4 BPP and 8 BPP
+//! displays, the same palette), the pixel data is copied unchanged, a word at
+//! a time where the alignment of the two buffers allows.  Otherwise, each
+//! source color is translated to the closest color available in the
+//! destination; the colors of a palette based source are translated once per
+//! palette entry used.  Translating direct color pixels into a palette based
+//! destination is slow unless a color cache has been attached to the
+//! destination with GrDisplayColorCacheSet().
+//!
+//! The source and destination may be the same display, in which case the
+//! rectangles may overlap.  This function uses a little over 1 KB of stack
+//! for the palette remapping table and a buffer of pixel values.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrOffScreenBlit(const tDisplay *psDst, const tDisplay *psSrc,
+                const tRectangle *psRect, int32_t i32X, int32_t i32Y)
+{
+    OffScreenBlitClip(psDst, psSrc, psRect, i32X, i32Y, 0, false);
+}
+
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels from one off-screen display to another,
+//! dropping out a single transparent color.
+//!
+//! \param psDst is a pointer to the off-screen display to copy to.
+//! \param psSrc is a pointer to the off-screen display to copy from.
+//! \param psRect is a pointer to the rectangle of \e psSrc to copy, or 0 to
+//! copy the entire source image.
+//! \param i32X is the X coordinate in \e psDst of the upper left corner of
+//! the copied rectangle.
+//! \param i32Y is the Y coordinate in \e psDst of the upper left corner of
+//! the copied rectangle.
+//! \param ui32Transparent is the source pixel value which is to be considered
+//! transparent.
+//!
+//! This function copies a rectangle of pixels in the same way as
+//! GrOffScreenBlit() but leaves the destination unchanged wherever the source
+//! pixel has the value \e ui32Transparent, allowing one layer to be composed
+//! over another.  As with GrTransparentImageDraw(), \e ui32Transparent is a
+//! palette index for 4 BPP and 8 BPP sources, 0 or 1 for 1 BPP sources, and
+//! the 5-6-5 RGB or 24-bit RGB pixel value for 16 BPP and 24 BPP sources.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrOffScreenTransparentBlit(const tDisplay *psDst, const tDisplay *psSrc,
+                           const tRectangle *psRect, int32_t i32X,
+                           int32_t i32Y, uint32_t ui32Transparent)
+{
+    OffScreenBlitClip(psDst, psSrc, psRect, i32X, i32Y, ui32Transparent,
+                      true);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,422 @@
+//*****************************************************************************
+//
+// polygon.c - Routines for filling polygons.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// An edge of a polygon, oriented so that it runs down the display.  The
+// position at which the edge crosses the current row is X + (Rem / DY), which
+// is stepped from row to row without division in the same way as Bresenham's
+// line drawing algorithm.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The integer portion of the X coordinate of the edge on the current row.
+    //
+    int32_t i32X;
+
+    //
+    // The integer portion of the change in X from one row to the next.
+    //
+    int32_t i32Step;
+
+    //
+    // The fractional portion of the X coordinate of the edge on the current
+    // row, in units of 1 / DY.
+    //
+    uint16_t ui16Rem;
+
+    //
+    // The fractional portion of the change in X from one row to the next, in
+    // units of 1 / DY.
+    //
+    uint16_t ui16RemStep;
+
+    //
+    // The change in Y from the top to the bottom of the edge.
+    //
+    uint16_t ui16DY;
+
+    //
+    // The first and last rows crossed by the edge.
+    //
+    int16_t i16YMin;
+    int16_t i16YMax;
+
+    //
+    // The direction of the edge in the order of the vertices, which is 1 if
+    // it runs down the display and -1 if it runs up.
+    //
+    int8_t i8Dir;
+}
+tPolygonEdge;
+
+//*****************************************************************************
+//
+// Moves an edge down by a number of rows.
+//
+//*****************************************************************************
+static void
+PolygonEdgeAdvance(tPolygonEdge *psEdge, uint32_t ui32Rows)
+{
+    uint32_t ui32Rem;
+
+    //
+    // The number of rows is no more than the height of the edge, so neither
+    // of these products overflows.
+    //
+    ui32Rem = (ui32Rows * psEdge->ui16RemStep) + psEdge->ui16Rem;
+    psEdge->i32X += ((int32_t)ui32Rows * psEdge->i32Step) +
+                    (ui32Rem / psEdge->ui16DY);
+    psEdge->ui16Rem = ui32Rem % psEdge->ui16DY;
+}
+
+//*****************************************************************************
+//
+// Determines if the first edge crosses the current row to the left of the
+// second edge.  Since the fractional portions have different denominators,
+// they are compared by cross multiplication.
+//
+//*****************************************************************************
+static bool
+PolygonEdgeLess(const tPolygonEdge *psEdge1, const tPolygonEdge *psEdge2)
+{
+    if(psEdge1->i32X != psEdge2->i32X)
+    {
+        return(psEdge1->i32X < psEdge2->i32X);
+    }
+    return(((uint32_t)psEdge1->ui16Rem * psEdge2->ui16DY) <
+           ((uint32_t)psEdge2->ui16Rem * psEdge1->ui16DY));
+}
+
+//*****************************************************************************
+//
+//! Draws a filled polygon.
+//!
+//! \param pContext is a pointer to the drawing context to use.
+//! \param psPoints is a pointer to the array of vertices of the polygon.
+//! \param ui32NumPoints is the number of vertices in the polygon, which must
+//! be no more than \b GRLIB_POLYGON_MAX_POINTS.
+//!
+//! This function draws a filled polygon, joining each vertex to the next and
+//! the last vertex back to the first.  The polygon may be concave or
+//! self-intersecting; a point is filled if a line from it to the edge of the
+//! display crosses the polygon an odd number of times.
+//!
+//! The polygon is scan converted one row at a time, keeping a list of the
+//! edges which cross the current row sorted by the position at which they
+//! cross it.  Each run of filled points in a row is drawn with the display
+//! driver's horizontal line drawing routine, and the rows outside the
+//! clipping region are skipped.  A point is filled if it lies inside the
+//! polygon or on its boundary, so a polygon whose vertices are the corners of
+//! a rectangle fills the same points as GrRectFill().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrPolygonFill(const tContext *pContext, const tPoint *psPoints,
+              uint32_t ui32NumPoints)
+{
+    tPolygonEdge psEdges[GRLIB_POLYGON_MAX_POINTS], *psEdge;
+    uint8_t pui8Sorted[GRLIB_POLYGON_MAX_POINTS];
+    uint8_t pui8Active[GRLIB_POLYGON_MAX_POINTS];
+    uint32_t ui32Idx, ui32Next, ui32NumEdges, ui32NumActive, ui32Pos, ui32Rem;
+    int32_t i32X1, i32Y1, i32X2, i32Y2, i32Y, i32YMin, i32YMax;
+    int32_t i32Start, i32End, i32Left, i32Right;
+    uint8_t ui8Edge;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pContext);
+    ASSERT(psPoints || (ui32NumPoints == 0));
+    ASSERT(ui32NumPoints <= GRLIB_POLYGON_MAX_POINTS);
+
+    //
+    // Return without drawing anything if there are too many vertices to fit
+    // in the edge list.
+    //
+    if(ui32NumPoints > GRLIB_POLYGON_MAX_POINTS)
+    {
+        return;
+    }
+
+    //
+    // Build the list of edges and find the rows covered by the polygon.
+    // Horizontal edges do not cross any rows, so they are drawn as lines
+    // instead.
+    //
+    ui32NumEdges = 0;
+    i32YMin = 0x7fff;
+    i32YMax = -0x8000;
+    for(ui32Idx = 0; ui32Idx < ui32NumPoints; ui32Idx++)
+    {
+        ui32Next = ((ui32Idx + 1) == ui32NumPoints) ? 0 : (ui32Idx + 1);
+        i32X1 = psPoints[ui32Idx].i16X;
+        i32Y1 = psPoints[ui32Idx].i16Y;
+        i32X2 = psPoints[ui32Next].i16X;
+        i32Y2 = psPoints[ui32Next].i16Y;
+        if(i32Y1 == i32Y2)
+        {
+            GrLineDrawH(pContext, i32X1, i32X2, i32Y1);
+            continue;
+        }
+
+        //
+        // Order the ends of the edge from top to bottom, remembering which
+        // way it runs.
+        //
+        psEdge = &psEdges[ui32NumEdges];
+        psEdge->i8Dir = 1;
+        if(i32Y1 > i32Y2)
+        {
+            i32Start = i32X1;
+            i32X1 = i32X2;
+            i32X2 = i32Start;
+            i32Start = i32Y1;
+            i32Y1 = i32Y2;
+            i32Y2 = i32Start;
+            psEdge->i8Dir = -1;
+        }
+
+        //
+        // Split the change in X from one row to the next into integer and
+        // fractional portions, rounding the integer portion down so that the
+        // fractional portion is never negative.
+        //
+        psEdge->ui16DY = i32Y2 - i32Y1;
+        psEdge->i32Step = (i32X2 - i32X1) / (int32_t)psEdge->ui16DY;
+        if((psEdge->i32Step * (int32_t)psEdge->ui16DY) > (i32X2 - i32X1))
+        {
+            psEdge->i32Step--;
+        }
+        psEdge->ui16RemStep = ((i32X2 - i32X1) -
+                               (psEdge->i32Step * (int32_t)psEdge->ui16DY));
+
+        //
+        // The edge starts at its top end.
+        //
+        psEdge->i32X = i32X1;
+        psEdge->ui16Rem = 0;
+        psEdge->i16YMin = i32Y1;
+        psEdge->i16YMax = i32Y2;
+        pui8Sorted[ui32NumEdges] = ui32NumEdges;
+        ui32NumEdges++;
+
+        if(i32Y1 < i32YMin)
+        {
+            i32YMin = i32Y1;
+        }
+        if(i32Y2 > i32YMax)
+        {
+            i32YMax = i32Y2;
+        }
+    }
+
+    //
+    // Where two edges meet at a vertex and continue in the same direction,
+    // the row through the vertex must only be crossed once, so it is removed
+    // from the edge which has its bottom end at the vertex.  Where the
+    // direction changes, the vertex is a peak or a valley of the polygon and
+    // both edges cross the row, which fills the point at the vertex.  Any
+    // horizontal edges between the two edges do not affect this.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32NumEdges; ui32Idx++)
+    {
+        ui32Next = ((ui32Idx + 1) == ui32NumEdges) ? 0 : (ui32Idx + 1);
+        if(psEdges[ui32Idx].i8Dir != psEdges[ui32Next].i8Dir)
+        {
+            continue;
+        }
+        if(psEdges[ui32Idx].i8Dir > 0)
+        {
+            psEdges[ui32Idx].i16YMax--;
+        }
+        else
+        {
+            psEdges[ui32Next].i16YMax--;
+        }
+    }
+
+    //
+    // Sort the edges by their top row.  There are few edges, so an insertion
+    // sort is used.
+    //
+    for(ui32Idx = 1; ui32Idx < ui32NumEdges; ui32Idx++)
+    {
+        ui8Edge = pui8Sorted[ui32Idx];
+        for(ui32Pos = ui32Idx;
+            (ui32Pos > 0) && (psEdges[pui8Sorted[ui32Pos - 1]].i16YMin >
+                              psEdges[ui8Edge].i16YMin);
+            ui32Pos--)
+        {
+            pui8Sorted[ui32Pos] = pui8Sorted[ui32Pos - 1];
+        }
+        pui8Sorted[ui32Pos] = ui8Edge;
+    }
+
+    //
+    // Only the rows within the clipping region need to be scan converted.
+    //
+    if(i32YMin < pContext->sClipRegion.i16YMin)
+    {
+        i32YMin = pContext->sClipRegion.i16YMin;
+    }
+    if(i32YMax > pContext->sClipRegion.i16YMax)
+    {
+        i32YMax = pContext->sClipRegion.i16YMax;
+    }
+
+    //
+    // Loop through the rows of the polygon.
+    //
+    ui32NumActive = 0;
+    ui32Next = 0;
+    for(i32Y = i32YMin; i32Y <= i32YMax; i32Y++)
+    {
+        //
+        // Add the edges which start on or above this row to the active list.
+        // An edge which starts above the clipping region is moved down to
+        // this row, and one which also ends above it is discarded.
+        //
+        while((ui32Next < ui32NumEdges) &&
+              (psEdges[pui8Sorted[ui32Next]].i16YMin <= i32Y))
+        {
+            ui8Edge = pui8Sorted[ui32Next++];
+            psEdge = &psEdges[ui8Edge];
+            if(psEdge->i16YMax < i32Y)
+            {
+                continue;
+            }
+            if(psEdge->i16YMin < i32Y)
+            {
+                PolygonEdgeAdvance(psEdge, i32Y - psEdge->i16YMin);
+            }
+            pui8Active[ui32NumActive++] = ui8Edge;
+        }
+
+        //
+        // Remove the edges which ended on the previous row from the active
+        // list, and sort the remainder by the position at which they cross
+        // this row.  The order changes little from one row to the next, so
+        // an insertion sort is quick.
+        //
+        for(ui32Idx = 0, ui32Pos = 0; ui32Idx < ui32NumActive; ui32Idx++)
+        {
+            if(psEdges[pui8Active[ui32Idx]].i16YMax >= i32Y)
+            {
+                pui8Active[ui32Pos++] = pui8Active[ui32Idx];
+            }
+        }
+        ui32NumActive = ui32Pos;
+        for(ui32Idx = 1; ui32Idx < ui32NumActive; ui32Idx++)
+        {
+            ui8Edge = pui8Active[ui32Idx];
+            for(ui32Pos = ui32Idx; ui32Pos > 0; ui32Pos--)
+            {
+                if(!PolygonEdgeLess(&psEdges[ui8Edge],
+                                    &psEdges[pui8Active[ui32Pos - 1]]))
+                {
+                    break;
+                }
+                pui8Active[ui32Pos] = pui8Active[ui32Pos - 1];
+            }
+            pui8Active[ui32Pos] = ui8Edge;
+        }
+
+        //
+        // Fill between each pair of edges, from the first point on or to the
+        // right of the left edge to the last point on or to the left of the
+        // right edge.  Spans which touch are merged so that each run of
+        // filled points is drawn with a single horizontal line.
+        //
+        i32Start = 0;
+        i32End = -1;
+        for(ui32Idx = 0; (ui32Idx + 1) < ui32NumActive; ui32Idx += 2)
+        {
+            psEdge = &psEdges[pui8Active[ui32Idx]];
+            i32Left = psEdge->i32X + ((psEdge->ui16Rem != 0) ? 1 : 0);
+            i32Right = psEdges[pui8Active[ui32Idx + 1]].i32X;
+            if(i32Left > i32Right)
+            {
+                continue;
+            }
+            if((i32Start <= i32End) && (i32Left <= (i32End + 1)))
+            {
+                if(i32Right > i32End)
+                {
+                    i32End = i32Right;
+                }
+                continue;
+            }
+            if(i32Start <= i32End)
+            {
+                GrLineDrawH(pContext, i32Start, i32End, i32Y);
+            }
+            i32Start = i32Left;
+            i32End = i32Right;
+        }
+        if(i32Start <= i32End)
+        {
+            GrLineDrawH(pContext, i32Start, i32End, i32Y);
+        }
+
+        //
+        // Move each active edge down to the next row.
+        //
+        for(ui32Idx = 0; ui32Idx < ui32NumActive; ui32Idx++)
+        {
+            psEdge = &psEdges[pui8Active[ui32Idx]];
+            ui32Rem = psEdge->ui16Rem + psEdge->ui16RemStep;
+            psEdge->i32X += psEdge->i32Step;
+            if(ui32Rem >= psEdge->ui16DY)
+            {
+                ui32Rem -= psEdge->ui16DY;
+                psEdge->i32X++;
+            }
+            psEdge->ui16Rem = ui32Rem;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
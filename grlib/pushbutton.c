@@ -41,6 +41,8 @@
 //! Draws a rectangular push button.
 //!
 //! \param psWidget is a pointer to the push button widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a rectangular push button on the display.  This is
 //! called in response to a \b #WIDGET_MSG_PAINT message.
@@ -49,12 +51,14 @@
 //
 //*****************************************************************************
 static void
-RectangularButtonPaint(tWidget *psWidget)
+RectangularButtonPaint(tWidget *psWidget, tRectangle *psClip)
 {
     const uint8_t *pui8Image;
     tPushButtonWidget *pPush;
     tContext sCtx;
+    tRectangle sRect;
     int32_t i32X, i32Y;
+    bool bVisible;
 
     //
     // Check the arguments.
@@ -75,7 +79,7 @@ RectangularButtonPaint(tWidget *psWidget)
     // Initialize the clipping region based on the extents of this rectangular
     // push button.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // See if the push button fill style is selected.
@@ -119,22 +123,31 @@ RectangularButtonPaint(tWidget *psWidget)
                 psWidget->sPosition.i16YMin + 1) / 2));
 
         //
-        // If the push button outline style is selected then shrink the
-        // clipping region by one pixel on each side so that the outline is not
-        // overwritten by the text or image.
+        // The text or image is drawn within the extents of the push button.
+        // If the push button outline style is selected then shrink this area
+        // by one pixel on each side so that the outline is not overwritten by
+        // the text or image.
         //
+        sRect = psWidget->sPosition;
         if(pPush->ui32Style & PB_STYLE_OUTLINE)
         {
-            sCtx.sClipRegion.i16XMin++;
-            sCtx.sClipRegion.i16YMin++;
-            sCtx.sClipRegion.i16XMax--;
-            sCtx.sClipRegion.i16YMax--;
+            sRect.i16XMin++;
+            sRect.i16YMin++;
+            sRect.i16XMax--;
+            sRect.i16YMax--;
         }
 
+        //
+        // Restrict the clipping region to the portion of this area that is
+        // being drawn.  There is no text or image to draw if there is none.
+        //
+        bVisible = GrRectIntersectGet(&sRect, &(sCtx.sClipRegion),
+                                      &(sCtx.sClipRegion)) ? true : false;
+
         //
         // See if the push button image style is selected.
         //
-        if(pPush->ui32Style & PB_STYLE_IMG)
+        if(bVisible && (pPush->ui32Style & PB_STYLE_IMG))
         {
             //
             // Set the foreground and background colors to use for 1 BPP
@@ -164,7 +177,7 @@ RectangularButtonPaint(tWidget *psWidget)
         //
         // See if the push button text style is selected.
         //
-        if(pPush->ui32Style & PB_STYLE_TEXT)
+        if(bVisible && (pPush->ui32Style & PB_STYLE_TEXT))
         {
             //
             // Draw the text centered in the middle of the push button.
@@ -236,7 +249,7 @@ RectangularButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
         if((pPush->ui32Style & PB_STYLE_FILL) ||
            ((pPush->ui32Style & PB_STYLE_IMG) && pPush->pui8PressImage))
         {
-            RectangularButtonPaint(psWidget);
+            RectangularButtonPaint(psWidget, &(psWidget->sPosition));
         }
 
         //
@@ -273,7 +286,7 @@ RectangularButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
             if((pPush->ui32Style & PB_STYLE_FILL) ||
                ((pPush->ui32Style & PB_STYLE_IMG) && pPush->pui8PressImage))
             {
-                RectangularButtonPaint(psWidget);
+                RectangularButtonPaint(psWidget, &(psWidget->sPosition));
             }
         }
 
@@ -366,6 +379,8 @@ int32_t
 RectangularButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
                          uint32_t ui32Param1, uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -382,9 +397,14 @@ RectangularButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            RectangularButtonPaint(psWidget);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                RectangularButtonPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
@@ -499,6 +519,8 @@ RectangularButtonInit(tPushButtonWidget *psWidget, const tDisplay *psDisplay,
 //! Draws a circular push button.
 //!
 //! \param psWidget is a pointer to the push button widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a circular push button on the display.  This is called
 //! in response to a \b #WIDGET_MSG_PAINT message.
@@ -507,12 +529,14 @@ RectangularButtonInit(tPushButtonWidget *psWidget, const tDisplay *psDisplay,
 //
 //*****************************************************************************
 static void
-CircularButtonPaint(tWidget *psWidget)
+CircularButtonPaint(tWidget *psWidget, tRectangle *psClip)
 {
     const uint8_t *pui8Image;
     tPushButtonWidget *pPush;
     tContext sCtx;
+    tRectangle sRect;
     int32_t i32X, i32Y, i32R;
+    bool bVisible;
 
     //
     // Check the arguments.
@@ -533,7 +557,7 @@ CircularButtonPaint(tWidget *psWidget)
     // Initialize the clipping region based on the extents of this circular
     // push button.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // Get the radius of the circular push button, along with the X and Y
@@ -575,22 +599,31 @@ CircularButtonPaint(tWidget *psWidget)
     if(pPush->ui32Style & (PB_STYLE_TEXT | PB_STYLE_IMG))
     {
         //
-        // If the push button outline style is selected then shrink the
-        // clipping region by one pixel on each side so that the outline is not
-        // overwritten by the text or image.
+        // The text or image is drawn within the extents of the push button.
+        // If the push button outline style is selected then shrink this area
+        // by one pixel on each side so that the outline is not overwritten by
+        // the text or image.
         //
+        sRect = psWidget->sPosition;
         if(pPush->ui32Style & PB_STYLE_OUTLINE)
         {
-            sCtx.sClipRegion.i16XMin++;
-            sCtx.sClipRegion.i16YMin++;
-            sCtx.sClipRegion.i16XMax--;
-            sCtx.sClipRegion.i16YMax--;
+            sRect.i16XMin++;
+            sRect.i16YMin++;
+            sRect.i16XMax--;
+            sRect.i16YMax--;
         }
 
+        //
+        // Restrict the clipping region to the portion of this area that is
+        // being drawn.  There is no text or image to draw if there is none.
+        //
+        bVisible = GrRectIntersectGet(&sRect, &(sCtx.sClipRegion),
+                                      &(sCtx.sClipRegion)) ? true : false;
+
         //
         // See if the push button image style is selected.
         //
-        if(pPush->ui32Style & PB_STYLE_IMG)
+        if(bVisible && (pPush->ui32Style & PB_STYLE_IMG))
         {
             //
             // Set the foreground and background colors to use for 1 BPP
@@ -619,7 +652,7 @@ CircularButtonPaint(tWidget *psWidget)
         //
         // See if the push button text style is selected.
         //
-        if(pPush->ui32Style & PB_STYLE_TEXT)
+        if(bVisible && (pPush->ui32Style & PB_STYLE_TEXT))
         {
             //
             // Draw the text centered in the middle of the push button.
@@ -692,7 +725,7 @@ CircularButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
         if((pPush->ui32Style & PB_STYLE_FILL) ||
            ((pPush->ui32Style & PB_STYLE_IMG) && pPush->pui8PressImage))
         {
-            CircularButtonPaint(psWidget);
+            CircularButtonPaint(psWidget, &(psWidget->sPosition));
         }
     }
 
@@ -728,7 +761,7 @@ CircularButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
             if((pPush->ui32Style & PB_STYLE_FILL) ||
                ((pPush->ui32Style & PB_STYLE_IMG) && pPush->pui8PressImage))
             {
-                CircularButtonPaint(psWidget);
+                CircularButtonPaint(psWidget, &(psWidget->sPosition));
             }
         }
 
@@ -825,6 +858,8 @@ int32_t
 CircularButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
                       uint32_t ui32Param1, uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -841,9 +876,14 @@ CircularButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            CircularButtonPaint(psWidget);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                CircularButtonPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
@@ -43,6 +43,8 @@
 //! \param psWidget is a pointer to the radio button widget to be drawn.
 //! \param bClick is a boolean that is \b true if the paint request is a result
 //! of a pointer click and \b false if not.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
 //!
 //! This function draws a radio button widget on the display.  This is called
 //! in response to a \b #WIDGET_MSG_PAINT message.
@@ -51,11 +53,13 @@
 //
 //*****************************************************************************
 static void
-RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
+RadioButtonPaint(tWidget *psWidget, uint32_t bClick, tRectangle *psClip)
 {
     tRadioButtonWidget *pRadio;
     tContext sCtx;
+    tRectangle sRect;
     int32_t i32X, i32Y;
+    bool bVisible;
 
     //
     // Check the arguments.
@@ -76,7 +80,7 @@ RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
     // Initialize the clipping region based on the extents of this radio
     // button.
     //
-    GrContextClipRegionSet(&sCtx, &(psWidget->sPosition));
+    GrContextClipRegionSet(&sCtx, psClip);
 
     //
     // See if the radio button fill style is selected.
@@ -138,28 +142,36 @@ RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
     if((pRadio->ui16Style & (RB_STYLE_TEXT | RB_STYLE_IMG)) && !bClick)
     {
         //
-        // Shrink the clipping region by the size of the radio button so that
-        // it is not overwritten by further "decorative" portions of the
-        // widget.
+        // The text or image is positioned to the right of the radio button,
+        // so that it is not overwritten by further "decorative" portions of
+        // the widget.
         //
-        sCtx.sClipRegion.i16XMin += pRadio->ui16CircleSize + 4;
+        sRect = psWidget->sPosition;
+        sRect.i16XMin += pRadio->ui16CircleSize + 4;
 
         //
-        // If the radio button outline style is selected then shrink the
-        // clipping region by one pixel on each side so that the outline is not
-        // overwritten by the text or image.
+        // If the radio button outline style is selected then shrink this area
+        // by one pixel on each side so that the outline is not overwritten by
+        // the text or image.
         //
         if(pRadio->ui16Style & RB_STYLE_OUTLINE)
         {
-            sCtx.sClipRegion.i16YMin++;
-            sCtx.sClipRegion.i16XMax--;
-            sCtx.sClipRegion.i16YMax--;
+            sRect.i16YMin++;
+            sRect.i16XMax--;
+            sRect.i16YMax--;
         }
 
+        //
+        // Restrict the clipping region to the portion of this area that is
+        // being drawn.  There is no text or image to draw if there is none.
+        //
+        bVisible = GrRectIntersectGet(&sRect, &(sCtx.sClipRegion),
+                                      &(sCtx.sClipRegion)) ? true : false;
+
         //
         // See if the radio button image style is selected.
         //
-        if(pRadio->ui16Style & RB_STYLE_IMG)
+        if(bVisible && (pRadio->ui16Style & RB_STYLE_IMG))
         {
             //
             // Determine where along the Y extent of the widget to draw the
@@ -168,14 +180,14 @@ RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
             // it takes less than the Y extent.
             //
             if(GrImageHeightGet(pRadio->pui8Image) >
-               (sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin))
+               (sRect.i16YMax - sRect.i16YMin))
             {
-                i32Y = sCtx.sClipRegion.i16YMin;
+                i32Y = sRect.i16YMin;
             }
             else
             {
-                i32Y = (sCtx.sClipRegion.i16YMin +
-                      ((sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin -
+                i32Y = (sRect.i16YMin +
+                      ((sRect.i16YMax - sRect.i16YMin -
                         GrImageHeightGet(pRadio->pui8Image) + 1) / 2));
             }
 
@@ -189,14 +201,13 @@ RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
             //
             // Draw the image next to the radio button.
             //
-            GrImageDraw(&sCtx, pRadio->pui8Image, sCtx.sClipRegion.i16XMin,
-                        i32Y);
+            GrImageDraw(&sCtx, pRadio->pui8Image, sRect.i16XMin, i32Y);
         }
 
         //
         // See if the radio button text style is selected.
         //
-        if(pRadio->ui16Style & RB_STYLE_TEXT)
+        if(bVisible && (pRadio->ui16Style & RB_STYLE_TEXT))
         {
             //
             // Determine where along the Y extent of the widget to draw the
@@ -205,14 +216,14 @@ RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
             // it takes less than the Y extent.
             //
             if(GrFontHeightGet(pRadio->psFont) >
-               (sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin))
+               (sRect.i16YMax - sRect.i16YMin))
             {
-                i32Y = sCtx.sClipRegion.i16YMin;
+                i32Y = sRect.i16YMin;
             }
             else
             {
-                i32Y = (sCtx.sClipRegion.i16YMin +
-                      ((sCtx.sClipRegion.i16YMax - sCtx.sClipRegion.i16YMin -
+                i32Y = (sRect.i16YMin +
+                      ((sRect.i16YMax - sRect.i16YMin -
                         GrFontHeightGet(pRadio->psFont) + 1) / 2));
             }
 
@@ -222,7 +233,7 @@ RadioButtonPaint(tWidget *psWidget, uint32_t bClick)
             GrContextFontSet(&sCtx, pRadio->psFont);
             GrContextForegroundSet(&sCtx, pRadio->ui32TextColor);
             GrContextBackgroundSet(&sCtx, pRadio->ui32FillColor);
-            GrStringDraw(&sCtx, pRadio->pcText, -1, sCtx.sClipRegion.i16XMin,
+            GrStringDraw(&sCtx, pRadio->pcText, -1, sRect.i16XMin,
                          i32Y, pRadio->ui16Style & RB_STYLE_TEXT_OPAQUE);
         }
     }
@@ -319,7 +330,7 @@ RadioButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
                     //
                     // Redraw the sibling radio button.
                     //
-                    RadioButtonPaint(pSibling, 1);
+                    RadioButtonPaint(pSibling, 1, &(pSibling->sPosition));
 
                     //
                     // If there is an OnChange callback for the sibling radio
@@ -340,7 +351,7 @@ RadioButtonClick(tWidget *psWidget, uint32_t ui32Msg, int32_t i32X,
             //
             // Redraw the radio button.
             //
-            RadioButtonPaint(psWidget, 1);
+            RadioButtonPaint(psWidget, 1, &(psWidget->sPosition));
 
             //
             // If there is an OnChange callback for this widget then call the
@@ -386,6 +397,8 @@ int32_t
 RadioButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
                    uint32_t ui32Param1, uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -402,9 +415,14 @@ RadioButtonMsgProc(tWidget *psWidget, uint32_t ui32Msg,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            RadioButtonPaint(psWidget, 0);
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                RadioButtonPaint(psWidget, 0, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
@@ -116,6 +116,115 @@ GrRectDraw(const tContext *pContext, const tRectangle *pRect)
                 pRect->i16YMin + 1);
 }
 
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position on the display.
+//!
+//! \param pContext is a pointer to the drawing context to use.
+//! \param pRect is a pointer to the structure containing the extents of the
+//! rectangle to copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies the pixels within a rectangle of the display to
+//! another position on the display, for example to scroll part of the
+//! screen.  The source and destination may overlap.  The destination is
+//! clipped to the clipping region, and the source to the extents of the
+//! display; pixels of the destination for which there is no source pixel are
+//! left unchanged.  The display driver's rectangle copy routine is used to
+//! perform the copy.
+//!
+//! The display drivers provide no means of reading pixels back, so the copy
+//! can only be performed on displays which provide a rectangle copy routine.
+//! If the display does not, nothing is drawn and the caller must redraw the
+//! destination instead.
+//!
+//! \return Returns \b true if the copy was performed (or there was nothing to
+//! copy) and \b false if the display does not support copying rectangles.
+//
+//*****************************************************************************
+bool
+GrRectCopy(const tContext *pContext, const tRectangle *pRect, int32_t i32X,
+           int32_t i32Y)
+{
+    int32_t i32XMin, i32YMin, i32XMax, i32YMax, i32DX, i32DY;
+    tRectangle sTemp;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pContext);
+    ASSERT(pRect);
+
+    //
+    // Fail if the display can not copy rectangles.
+    //
+    if(!DpyRectCopySupported(pContext->psDisplay))
+    {
+        return(false);
+    }
+
+    //
+    // Determine the offset from the source to the destination.
+    //
+    i32DX = i32X - pRect->i16XMin;
+    i32DY = i32Y - pRect->i16YMin;
+
+    //
+    // Clip the source rectangle to the extents of the display.
+    //
+    i32XMin = (pRect->i16XMin < 0) ? 0 : pRect->i16XMin;
+    i32YMin = (pRect->i16YMin < 0) ? 0 : pRect->i16YMin;
+    i32XMax = pRect->i16XMax;
+    if(i32XMax >= DpyWidthGet(pContext->psDisplay))
+    {
+        i32XMax = DpyWidthGet(pContext->psDisplay) - 1;
+    }
+    i32YMax = pRect->i16YMax;
+    if(i32YMax >= DpyHeightGet(pContext->psDisplay))
+    {
+        i32YMax = DpyHeightGet(pContext->psDisplay) - 1;
+    }
+
+    //
+    // Clip the source rectangle so that the destination lies within the
+    // clipping region.
+    //
+    if((i32XMin + i32DX) < pContext->sClipRegion.i16XMin)
+    {
+        i32XMin = pContext->sClipRegion.i16XMin - i32DX;
+    }
+    if((i32YMin + i32DY) < pContext->sClipRegion.i16YMin)
+    {
+        i32YMin = pContext->sClipRegion.i16YMin - i32DY;
+    }
+    if((i32XMax + i32DX) > pContext->sClipRegion.i16XMax)
+    {
+        i32XMax = pContext->sClipRegion.i16XMax - i32DX;
+    }
+    if((i32YMax + i32DY) > pContext->sClipRegion.i16YMax)
+    {
+        i32YMax = pContext->sClipRegion.i16YMax - i32DY;
+    }
+
+    //
+    // Copy the rectangle if anything is left of it after clipping.
+    //
+    if((i32XMin <= i32XMax) && (i32YMin <= i32YMax))
+    {
+        sTemp.i16XMin = i32XMin;
+        sTemp.i16YMin = i32YMin;
+        sTemp.i16XMax = i32XMax;
+        sTemp.i16YMax = i32YMax;
+        DpyRectCopy(pContext->psDisplay, &sTemp, i32XMin + i32DX,
+                    i32YMin + i32DY);
+    }
+
+    return(true);
+}
+
 //*****************************************************************************
 //
 //! Draws a filled rectangle.
@@ -214,6 +323,114 @@ GrRectFill(const tContext *pContext, const tRectangle *pRect)
     DpyRectFill(pContext->psDisplay, &sTemp, pContext->ui32Foreground);
 }
 
+//*****************************************************************************
+//
+//! Draws a filled rectangle with rounded corners.
+//!
+//! \param pContext is a pointer to the drawing context to use.
+//! \param pRect is a pointer to the structure containing the extents of the
+//! rectangle.
+//! \param i32Radius is the radius of the corners of the rectangle.
+//!
+//! This function draws a filled rectangle whose corners are quarter circles
+//! of radius \e i32Radius.  The radius is reduced if necessary so that the
+//! corners fit within the rectangle, and a radius of zero draws the same
+//! rectangle as GrRectFill().  The portion of the rectangle between the
+//! corners is drawn with a single rectangle fill, and each row of the
+//! corners is drawn with a single horizontal line.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrRoundRectFill(const tContext *pContext, const tRectangle *pRect,
+                int32_t i32Radius)
+{
+    int32_t i32XMin, i32XMax, i32YMin, i32YMax, i32DX, i32DY, i32Limit;
+    tRectangle sTemp;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pContext);
+    ASSERT(pRect);
+
+    //
+    // Order the coordinates of the rectangle.
+    //
+    i32XMin = min(pRect->i16XMin, pRect->i16XMax);
+    i32XMax = max(pRect->i16XMin, pRect->i16XMax);
+    i32YMin = min(pRect->i16YMin, pRect->i16YMax);
+    i32YMax = max(pRect->i16YMin, pRect->i16YMax);
+
+    //
+    // Return without drawing anything if the entire rectangle is out of the
+    // clipping region.
+    //
+    if((i32XMin > pContext->sClipRegion.i16XMax) ||
+       (i32XMax < pContext->sClipRegion.i16XMin) ||
+       (i32YMin > pContext->sClipRegion.i16YMax) ||
+       (i32YMax < pContext->sClipRegion.i16YMin))
+    {
+        return;
+    }
+
+    //
+    // Limit the radius so that the corners do not overlap.
+    //
+    if(i32Radius > ((i32XMax - i32XMin) / 2))
+    {
+        i32Radius = (i32XMax - i32XMin) / 2;
+    }
+    if(i32Radius > ((i32YMax - i32YMin) / 2))
+    {
+        i32Radius = (i32YMax - i32YMin) / 2;
+    }
+    if(i32Radius < 0)
+    {
+        i32Radius = 0;
+    }
+
+    //
+    // Fill the full width portion of the rectangle between the corners.
+    //
+    sTemp.i16XMin = i32XMin;
+    sTemp.i16YMin = i32YMin + i32Radius;
+    sTemp.i16XMax = i32XMax;
+    sTemp.i16YMax = i32YMax - i32Radius;
+    GrRectFill(pContext, &sTemp);
+
+    //
+    // Fill the rows of the corners, working outwards from the rows next to
+    // the full width portion.  A point of a corner is filled if it lies
+    // within half a pixel of the quarter circle, which is the case when the
+    // sum of the squares of its offsets from the center of the quarter circle
+    // is no more than the square of the radius plus the radius.
+    //
+    i32Limit = (i32Radius * i32Radius) + i32Radius;
+    i32DX = i32Radius;
+    for(i32DY = 1; i32DY <= i32Radius; i32DY++)
+    {
+        //
+        // Move the end of this row in until it lies within the circle.
+        //
+        while(((i32DX * i32DX) + (i32DY * i32DY)) > i32Limit)
+        {
+            i32DX--;
+        }
+
+        //
+        // Draw this row at the top and at the bottom of the rectangle.
+        //
+        GrLineDrawH(pContext, i32XMin + i32Radius - i32DX,
+                    i32XMax - i32Radius + i32DX,
+                    i32YMin + i32Radius - i32DY);
+        GrLineDrawH(pContext, i32XMin + i32Radius - i32DX,
+                    i32XMax - i32Radius + i32DX,
+                    i32YMax - i32Radius + i32DY);
+    }
+}
+
 //*****************************************************************************
 //
 //! Determines if two rectangles overlap.
@@ -267,10 +484,10 @@ GrRectIntersectGet(tRectangle *psRect1, tRectangle *psRect2,
     //
     // Make sure we were passed valid rectangles.
     //
-    if((psRect1->i16XMax <= psRect1->i16XMin) ||
-       (psRect1->i16YMax <= psRect1->i16YMin) ||
-       (psRect2->i16XMax <= psRect2->i16XMin) ||
-       (psRect2->i16YMax <= psRect2->i16YMin))
+    if((psRect1->i16XMax < psRect1->i16XMin) ||
+       (psRect1->i16YMax < psRect1->i16YMin) ||
+       (psRect2->i16XMax < psRect2->i16XMin) ||
+       (psRect2->i16YMax < psRect2->i16YMin))
     {
         return(0);
     }
@@ -0,0 +1,670 @@
+//*****************************************************************************
+//
+// rotated.c - Display driver wrapper that rotates drawing into a buffer.
+//
+// Copyright (c) 2008-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+//
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+//
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+//! \addtogroup primitives_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Make sure min and max are defined.
+//
+//*****************************************************************************
+#ifndef min
+#define min(a, b)               (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef max
+#define max(a, b)               (((a) < (b)) ? (b) : (a))
+#endif
+
+//*****************************************************************************
+//
+// Converts a point on the rotated display into the corresponding point in the
+// buffer.  The rotation is clockwise, so for a 90 degree rotation the top row
+// of the rotated display becomes the right-most column of the buffer.
+//
+//*****************************************************************************
+static void
+RotatedPointMap(const tRotatedDisplay *psRotated, int32_t *pi32X,
+                int32_t *pi32Y)
+{
+    int32_t i32X, i32Y;
+
+    i32X = *pi32X;
+    i32Y = *pi32Y;
+
+    switch(psRotated->ui32Rotation)
+    {
+        case GRLIB_ROTATE_90:
+        {
+            *pi32X = psRotated->psBuffer->ui16Width - 1 - i32Y;
+            *pi32Y = i32X;
+            break;
+        }
+
+        case GRLIB_ROTATE_180:
+        {
+            *pi32X = psRotated->psBuffer->ui16Width - 1 - i32X;
+            *pi32Y = psRotated->psBuffer->ui16Height - 1 - i32Y;
+            break;
+        }
+
+        case GRLIB_ROTATE_270:
+        {
+            *pi32X = i32Y;
+            *pi32Y = psRotated->psBuffer->ui16Height - 1 - i32X;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Converts a rectangle on the rotated display into the corresponding
+// rectangle in the buffer.  The corners are swapped as required so that the
+// minimum coordinates of the result are less than the maximum coordinates.
+//
+//*****************************************************************************
+static void
+RotatedRectMap(const tRotatedDisplay *psRotated, int32_t i32XMin,
+               int32_t i32YMin, int32_t i32XMax, int32_t i32YMax,
+               tRectangle *psRect)
+{
+    RotatedPointMap(psRotated, &i32XMin, &i32YMin);
+    RotatedPointMap(psRotated, &i32XMax, &i32YMax);
+
+    psRect->i16XMin = min(i32XMin, i32XMax);
+    psRect->i16YMin = min(i32YMin, i32YMax);
+    psRect->i16XMax = max(i32XMin, i32XMax);
+    psRect->i16YMax = max(i32YMin, i32YMax);
+}
+
+//*****************************************************************************
+//
+//! Draws a pixel on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the pixel.
+//! \param i32Y is the Y coordinate of the pixel.
+//! \param ui32Value is the color of the pixel.
+//!
+//! This function sets the given pixel to a particular color at its rotated
+//! position in the buffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                          uint32_t ui32Value)
+{
+    tRotatedDisplay *psRotated;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // Draw the pixel at its position in the buffer.
+    //
+    RotatedPointMap(psRotated, &i32X, &i32Y);
+    DpyPixelDraw(psRotated->psBuffer, i32X, i32Y, ui32Value);
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the first pixel.
+//! \param i32Y is the Y coordinate of the first pixel.
+//! \param i32X0 is sub-pixel offset within the pixel data, which is valid for
+//! 1 or 4 bit per pixel formats.
+//! \param i32Count is the number of pixels to draw.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this run represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a horizontal sequence of pixels at its rotated
+//! position in the buffer.  When the display is rotated, the sequence is
+//! passed to the buffer as a one row rectangle of pixels to be rotated, which
+//! becomes a column of the buffer for the 90 and 270 degree rotations and a
+//! reversed row of the buffer for the 180 degree rotation.  If the buffer
+//! cannot draw rotated rectangles, each pixel is passed to the buffer
+//! individually along with the offset of its data.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayPixelDrawMultiple(void *pvDisplayData, int32_t i32X,
+                                  int32_t i32Y, int32_t i32X0,
+                                  int32_t i32Count, int32_t i32BPP,
+                                  const uint8_t *pui8Data,
+                                  const uint8_t *pui8Palette)
+{
+    tRotatedDisplay *psRotated;
+    int32_t i32Idx, i32Bits, i32Pos, i32PX, i32PY;
+    tRectangle sRect;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(pui8Data);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // An unrotated sequence can be passed straight on to the buffer.
+    //
+    if(psRotated->ui32Rotation == GRLIB_ROTATE_0)
+    {
+        DpyPixelDrawMultiple(psRotated->psBuffer, i32X, i32Y, i32X0, i32Count,
+                             i32BPP, pui8Data, pui8Palette);
+        return;
+    }
+
+    //
+    // Let the buffer write the rotated sequence if it can.
+    //
+    if(psRotated->psBuffer->pfnBlitRotated)
+    {
+        if(i32Count > 0)
+        {
+            RotatedRectMap(psRotated, i32X, i32Y, i32X + i32Count - 1, i32Y,
+                           &sRect);
+            psRotated->psBuffer->pfnBlitRotated(
+                psRotated->psBuffer->pvDisplayData, &sRect, i32X0, i32BPP,
+                pui8Data, 0, pui8Palette, psRotated->ui32Rotation);
+        }
+        return;
+    }
+
+    //
+    // Get the number of bits per pixel in the source data.  For the packed
+    // formats, fold the sub-pixel offset into the pixel index below.
+    //
+    i32Bits = i32BPP & 0xff;
+    if(i32Bits < 8)
+    {
+        i32X0 &= (8 / i32Bits) - 1;
+    }
+
+    //
+    // Loop through the pixels in this sequence.
+    //
+    for(i32Idx = 0; i32Idx < i32Count; i32Idx++)
+    {
+        //
+        // Find the position of this pixel in the buffer.
+        //
+        i32PX = i32X + i32Idx;
+        i32PY = i32Y;
+        RotatedPointMap(psRotated, &i32PX, &i32PY);
+
+        //
+        // Draw this pixel, starting from the byte of data that contains it.
+        //
+        if(i32Bits < 8)
+        {
+            i32Pos = i32X0 + i32Idx;
+            psRotated->psBuffer->pfnPixelDrawMultiple(
+                psRotated->psBuffer->pvDisplayData, i32PX, i32PY,
+                i32Pos & ((8 / i32Bits) - 1), 1, i32BPP,
+                pui8Data + ((i32Pos * i32Bits) / 8), pui8Palette);
+        }
+        else
+        {
+            psRotated->psBuffer->pfnPixelDrawMultiple(
+                psRotated->psBuffer->pvDisplayData, i32PX, i32PY, i32X0, 1,
+                i32BPP, pui8Data + ((i32Idx * i32Bits) / 8), pui8Palette);
+        }
+
+        //
+        // Only the first pixel starts a new image.
+        //
+        i32BPP &= ~GRLIB_DRIVER_FLAG_NEW_IMAGE;
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X1 is the X coordinate of the start of the line.
+//! \param i32X2 is the X coordinate of the end of the line.
+//! \param i32Y is the Y coordinate of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a horizontal line at its rotated position in the
+//! buffer, which is a vertical line in the buffer for 90 and 270 degree
+//! rotations.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2,
+                          int32_t i32Y, uint32_t ui32Value)
+{
+    tRotatedDisplay *psRotated;
+    tRectangle sRect;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // Find the line in the buffer and draw it.
+    //
+    RotatedRectMap(psRotated, i32X1, i32Y, i32X2, i32Y, &sRect);
+    if(psRotated->ui32Rotation & 1)
+    {
+        DpyLineDrawV(psRotated->psBuffer, sRect.i16XMin, sRect.i16YMin,
+                     sRect.i16YMax, ui32Value);
+    }
+    else
+    {
+        DpyLineDrawH(psRotated->psBuffer, sRect.i16XMin, sRect.i16XMax,
+                     sRect.i16YMin, ui32Value);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a vertical line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param i32X is the X coordinate of the line.
+//! \param i32Y1 is the Y coordinate of the start of the line.
+//! \param i32Y2 is the Y coordinate of the end of the line.
+//! \param ui32Value is the color of the line.
+//!
+//! This function draws a vertical line at its rotated position in the
+//! buffer, which is a horizontal line in the buffer for 90 and 270 degree
+//! rotations.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1,
+                          int32_t i32Y2, uint32_t ui32Value)
+{
+    tRotatedDisplay *psRotated;
+    tRectangle sRect;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // Find the line in the buffer and draw it.
+    //
+    RotatedRectMap(psRotated, i32X, i32Y1, i32X, i32Y2, &sRect);
+    if(psRotated->ui32Rotation & 1)
+    {
+        DpyLineDrawH(psRotated->psBuffer, sRect.i16XMin, sRect.i16XMax,
+                     sRect.i16YMin, ui32Value);
+    }
+    else
+    {
+        DpyLineDrawV(psRotated->psBuffer, sRect.i16XMin, sRect.i16YMin,
+                     sRect.i16YMax, ui32Value);
+    }
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle.
+//! \param ui32Value is the color of the rectangle.
+//!
+//! This function fills a rectangle at its rotated position in the buffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayRectFill(void *pvDisplayData, const tRectangle *psRect,
+                         uint32_t ui32Value)
+{
+    tRotatedDisplay *psRotated;
+    tRectangle sRect;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // Find the rectangle in the buffer and fill it.
+    //
+    RotatedRectMap(psRotated, psRect->i16XMin, psRect->i16YMin,
+                   psRect->i16XMax, psRect->i16YMax, &sRect);
+    DpyRectFill(psRotated->psBuffer, &sRect, ui32Value);
+}
+
+//*****************************************************************************
+//
+//! Draws a rectangle of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle.
+//! \param i32X0 is sub-pixel offset within the pixel data of each row, which
+//! is valid for 1 or 4 bit per pixel formats.
+//! \param i32BPP is the number of bits per pixel ORed with a flag indicating
+//! whether or not this rectangle represents the start of a new image.
+//! \param pui8Data is a pointer to the pixel data for the first row.
+//! \param i32Stride is the number of bytes from the start of one row of pixel
+//! data to the start of the next.
+//! \param pui8Palette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws the rectangle of pixels at its rotated position in the
+//! buffer.  When the display is rotated, the rectangle is passed to the
+//! buffer's rotated blit function, which writes the buffer a row at a time in
+//! its memory order.  If the buffer has no such function, the rectangle is
+//! drawn a row at a time via GrRotatedDisplayPixelDrawMultiple().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayBlit(void *pvDisplayData, const tRectangle *psRect,
+                     int32_t i32X0, int32_t i32BPP, const uint8_t *pui8Data,
+                     int32_t i32Stride, const uint8_t *pui8Palette)
+{
+    tRotatedDisplay *psRotated;
+    tRectangle sRect;
+    int32_t i32Y;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // An unrotated rectangle can be passed straight on to the buffer.
+    //
+    if(psRotated->ui32Rotation == GRLIB_ROTATE_0)
+    {
+        DpyBlit(psRotated->psBuffer, psRect, i32X0, i32BPP, pui8Data,
+                i32Stride, pui8Palette);
+        return;
+    }
+
+    //
+    // Find the rectangle in the buffer and let the buffer rotate the pixels
+    // into it, if it can.
+    //
+    if(psRotated->psBuffer->pfnBlitRotated)
+    {
+        RotatedRectMap(psRotated, psRect->i16XMin, psRect->i16YMin,
+                       psRect->i16XMax, psRect->i16YMax, &sRect);
+        psRotated->psBuffer->pfnBlitRotated(
+            psRotated->psBuffer->pvDisplayData, &sRect, i32X0, i32BPP,
+            pui8Data, i32Stride, pui8Palette, psRotated->ui32Rotation);
+        return;
+    }
+
+    //
+    // Otherwise, draw the rectangle a row at a time.
+    //
+    for(i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++)
+    {
+        GrRotatedDisplayPixelDrawMultiple(pvDisplayData, psRect->i16XMin,
+                                          i32Y, i32X0,
+                                          (psRect->i16XMax -
+                                           psRect->i16XMin + 1),
+                                          i32BPP, pui8Data, pui8Palette);
+        i32BPP &= ~GRLIB_DRIVER_FLAG_NEW_IMAGE;
+        pui8Data += i32Stride;
+    }
+}
+
+//*****************************************************************************
+//
+//! Copies a rectangle of pixels to another position.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param psRect is a pointer to the structure describing the rectangle to
+//! copy.
+//! \param i32X is the X coordinate of the destination of the upper left
+//! corner of the rectangle.
+//! \param i32Y is the Y coordinate of the destination of the upper left
+//! corner of the rectangle.
+//!
+//! This function copies the rotated rectangle within the buffer.  Since a
+//! rectangle rotates onto a rectangle, the copy is still a single rectangle
+//! copy in the buffer.  It is only used if the buffer can copy rectangles.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayRectCopy(void *pvDisplayData, const tRectangle *psRect,
+                         int32_t i32X, int32_t i32Y)
+{
+    tRotatedDisplay *psRotated;
+    tRectangle sSrc, sDst;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+    ASSERT(psRect);
+
+    psRotated = (tRotatedDisplay *)pvDisplayData;
+
+    //
+    // Find the source and destination rectangles in the buffer and copy.
+    //
+    RotatedRectMap(psRotated, psRect->i16XMin, psRect->i16YMin,
+                   psRect->i16XMax, psRect->i16YMax, &sSrc);
+    RotatedRectMap(psRotated, i32X, i32Y,
+                   i32X + psRect->i16XMax - psRect->i16XMin,
+                   i32Y + psRect->i16YMax - psRect->i16YMin, &sDst);
+    DpyRectCopy(psRotated->psBuffer, &sSrc, sDst.i16XMin, sDst.i16YMin);
+}
+
+//*****************************************************************************
+//
+//! Translates a 24-bit RGB color to a display driver-specific color.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param ui32Value is the 24-bit RGB color.  The least-significant byte is
+//! the blue channel, the next byte is the green channel, and the third byte is
+//! the red channel.
+//!
+//! This function translates a 24-bit RGB color into the color format used by
+//! the buffer.
+//!
+//! \return Returns the display-driver specific color.
+//
+//*****************************************************************************
+static uint32_t
+GrRotatedDisplayColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Colors are written into the buffer so use its translation.
+    //
+    return(DpyColorTranslate(((tRotatedDisplay *)pvDisplayData)->psBuffer,
+                             ui32Value));
+}
+
+//*****************************************************************************
+//
+//! Flushes any cached drawing operations.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//!
+//! This functions passes the flush on to the buffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+GrRotatedDisplayFlush(void *pvDisplayData)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(pvDisplayData);
+
+    //
+    // Pass the flush on to the buffer.
+    //
+    DpyFlush(((tRotatedDisplay *)pvDisplayData)->psBuffer);
+}
+
+//*****************************************************************************
+//
+//! Initializes a rotated display.
+//!
+//! \param psDisplay is a pointer to the display structure to be configured.
+//! \param psRotated is a pointer to the state structure used by the display.
+//! \param psBuffer is a pointer to an initialized display, typically an
+//! off-screen buffer, into which all drawing is performed.
+//! \param ui32Rotation is the clockwise rotation applied to drawing, which is
+//! one of \b GRLIB_ROTATE_0, \b GRLIB_ROTATE_90, \b GRLIB_ROTATE_180, or
+//! \b GRLIB_ROTATE_270.
+//!
+//! This function initializes a display structure which presents \e psBuffer
+//! in a different orientation.  Drawing operations performed on
+//! \e psDisplay are written into \e psBuffer at their rotated positions, so
+//! that the contents of the buffer are already in the memory order of the
+//! panel.  This allows, for example, an application to draw in portrait
+//! orientation into an off-screen buffer that matches a landscape panel and
+//! then stream the buffer to the panel with GrImageDraw() or a DMA transfer,
+//! without rotating each pixel as it is copied.
+//!
+//! The buffer may be an off-screen display of any color depth.  For the
+//! 90 and 270 degree rotations, the width and height of \e psDisplay are the
+//! height and width of \e psBuffer respectively.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrRotatedDisplayInit(tDisplay *psDisplay, tRotatedDisplay *psRotated,
+                     const tDisplay *psBuffer, uint32_t ui32Rotation)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDisplay);
+    ASSERT(psRotated);
+    ASSERT(psBuffer);
+    ASSERT(ui32Rotation <= GRLIB_ROTATE_270);
+
+    //
+    // Initialize the rotated display state.
+    //
+    psRotated->psBuffer = psBuffer;
+    psRotated->ui32Rotation = ui32Rotation;
+
+    //
+    // Initialize the display structure.  The width and height are swapped
+    // when the rotation is a quarter turn.
+    //
+    psDisplay->i32Size = sizeof(tDisplay);
+    psDisplay->pvDisplayData = psRotated;
+    if(ui32Rotation & 1)
+    {
+        psDisplay->ui16Width = psBuffer->ui16Height;
+        psDisplay->ui16Height = psBuffer->ui16Width;
+    }
+    else
+    {
+        psDisplay->ui16Width = psBuffer->ui16Width;
+        psDisplay->ui16Height = psBuffer->ui16Height;
+    }
+    psDisplay->pfnPixelDraw = GrRotatedDisplayPixelDraw;
+    psDisplay->pfnPixelDrawMultiple = GrRotatedDisplayPixelDrawMultiple;
+    psDisplay->pfnLineDrawH = GrRotatedDisplayLineDrawH;
+    psDisplay->pfnLineDrawV = GrRotatedDisplayLineDrawV;
+    psDisplay->pfnRectFill = GrRotatedDisplayRectFill;
+    psDisplay->pfnColorTranslate = GrRotatedDisplayColorTranslate;
+    psDisplay->pfnFlush = GrRotatedDisplayFlush;
+    psDisplay->pfnBlit = GrRotatedDisplayBlit;
+    psDisplay->pfnRectCopy = (DpyRectCopySupported(psBuffer) ?
+                              GrRotatedDisplayRectCopy : 0);
+    psDisplay->psColorCache = 0;
+    psDisplay->pfnBlitRotated = 0;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
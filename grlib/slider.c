@@ -749,6 +749,8 @@ int32_t
 SliderMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
               uint32_t ui32Param2)
 {
+    tRectangle sClip;
+
     //
     // Check the arguments.
     //
@@ -765,9 +767,14 @@ SliderMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
         case WIDGET_MSG_PAINT:
         {
             //
-            // Handle the widget paint request.
+            // Handle the widget paint request, limited to the region being
+            // repainted.
             //
-            SliderPaint(psWidget, &(psWidget->sPosition));
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                    &sClip))
+            {
+                SliderPaint(psWidget, &sClip);
+            }
 
             //
             // Return one to indicate that the message was successfully
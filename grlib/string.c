@@ -44,6 +44,294 @@
 //*****************************************************************************
 #define ABSENT_CHAR_REPLACEMENT '.'
 
+//*****************************************************************************
+//
+// The number of coverage levels in an anti-aliased font glyph, and the
+// coverage value which indicates a fully covered pixel.
+//
+//*****************************************************************************
+#define AA_NUM_LEVELS           16
+#define AA_COVERED              15
+
+//*****************************************************************************
+//
+// Determines if a font format uses anti-aliased glyph data.
+//
+//*****************************************************************************
+#define FontFormatIsAA(ui8Format)                                             \
+        (((ui8Format) & ~(FONT_EX_MARKER | FONT_WIDE_MARKER)) ==              \
+         FONT_FMT_AA4_RLE)
+
+//*****************************************************************************
+//
+// The colors used to draw an anti-aliased glyph, with one entry for each
+// coverage level.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The blended colors in the 24-bit RGB palette format expected by
+    // DpyPixelDrawMultiple() for 4 bit per pixel data.  The extra byte
+    // allows drivers to read the last entry as a 32-bit value.
+    //
+    uint8_t pui8Palette[(AA_NUM_LEVELS * 3) + 1];
+
+    //
+    // The blended colors, translated for the display.
+    //
+    uint32_t pui32Color[AA_NUM_LEVELS];
+}
+tAAColors;
+
+//*****************************************************************************
+//
+// Computes the colors used to draw anti-aliased glyphs by blending the
+// foreground color of the context with its background color.
+//
+//*****************************************************************************
+static void
+AAColorsGet(const tContext *pContext, tAAColors *psColors)
+{
+    uint32_t ui32Level, ui32Shift, ui32Color;
+    int32_t i32Fore, i32Back, i32Diff;
+
+    //
+    // Loop through the coverage levels.
+    //
+    for(ui32Level = 0; ui32Level < AA_NUM_LEVELS; ui32Level++)
+    {
+        //
+        // Blend each of the red, green and blue components, rounding to the
+        // nearest value.
+        //
+        for(ui32Shift = 0, ui32Color = 0; ui32Shift < 24; ui32Shift += 8)
+        {
+            i32Fore = (pContext->ui32ForegroundRGB >> ui32Shift) & 0xff;
+            i32Back = (pContext->ui32BackgroundRGB >> ui32Shift) & 0xff;
+            i32Diff = (i32Fore - i32Back) * (int32_t)ui32Level;
+            i32Diff += (i32Diff < 0) ? -(AA_COVERED / 2) : (AA_COVERED / 2);
+            ui32Color |= (i32Back + (i32Diff / AA_COVERED)) << ui32Shift;
+        }
+
+        //
+        // Save the blended color in the palette and in display form.
+        //
+        psColors->pui8Palette[(ui32Level * 3) + 0] = ui32Color;
+        psColors->pui8Palette[(ui32Level * 3) + 1] = ui32Color >> 8;
+        psColors->pui8Palette[(ui32Level * 3) + 2] = ui32Color >> 16;
+        psColors->pui32Color[ui32Level] =
+            DpyColorTranslate(pContext->psDisplay, ui32Color);
+    }
+    psColors->pui8Palette[AA_NUM_LEVELS * 3] = 0;
+
+    //
+    // Use the context colors directly for no and full coverage so that they
+    // match other drawing operations exactly, even if the RGB values were
+    // not set.
+    //
+    psColors->pui32Color[0] = pContext->ui32Background;
+    psColors->pui32Color[AA_COVERED] = pContext->ui32Foreground;
+}
+
+//*****************************************************************************
+//
+// Draws a horizontal run of pixels from an anti-aliased glyph, clipping it to
+// the clipping region of the context.  The run either has a single coverage
+// level or, if pui8Literal is not NULL, takes its coverage from the packed
+// 4-bit values starting at pixel i32Pixel of pui8Literal.
+//
+//*****************************************************************************
+static void
+AARunDraw(const tContext *pContext, int32_t i32X, int32_t i32Y,
+          int32_t i32Count, uint32_t ui32Level, const uint8_t *pui8Literal,
+          int32_t i32Pixel, bool bOpaque, const tAAColors *psColors)
+{
+    int32_t i32X1;
+
+    //
+    // Clip the run to the clipping region.
+    //
+    if((i32Y < pContext->sClipRegion.i16YMin) ||
+       (i32Y > pContext->sClipRegion.i16YMax))
+    {
+        return;
+    }
+    i32X1 = i32X + i32Count - 1;
+    if(i32X < pContext->sClipRegion.i16XMin)
+    {
+        i32Pixel += pContext->sClipRegion.i16XMin - i32X;
+        i32X = pContext->sClipRegion.i16XMin;
+    }
+    if(i32X1 > pContext->sClipRegion.i16XMax)
+    {
+        i32X1 = pContext->sClipRegion.i16XMax;
+    }
+    if(i32X > i32X1)
+    {
+        return;
+    }
+
+    //
+    // See if this is a run of literal coverage values.
+    //
+    if(pui8Literal)
+    {
+        //
+        // In opaque mode, the coverage values can be drawn directly as 4 bit
+        // per pixel data using the blended palette.
+        //
+        if(bOpaque)
+        {
+            DpyPixelDrawMultiple(pContext->psDisplay, i32X, i32Y, i32Pixel & 1,
+                                 i32X1 - i32X + 1, 4,
+                                 pui8Literal + (i32Pixel / 2),
+                                 psColors->pui8Palette);
+            return;
+        }
+
+        //
+        // Otherwise, draw the pixels individually, skipping those with no
+        // coverage.
+        //
+        for(; i32X <= i32X1; i32X++, i32Pixel++)
+        {
+            ui32Level = ((pui8Literal[i32Pixel / 2] >>
+                          ((i32Pixel & 1) ? 0 : 4)) & 15);
+            if(ui32Level)
+            {
+                DpyPixelDraw(pContext->psDisplay, i32X, i32Y,
+                             psColors->pui32Color[ui32Level]);
+            }
+        }
+    }
+
+    //
+    // Otherwise, draw the run as a line.  This is the common case for the
+    // fully covered interior of a glyph, and for its background when drawing
+    // in opaque mode.
+    //
+    else if(ui32Level || bOpaque)
+    {
+        if(i32X == i32X1)
+        {
+            DpyPixelDraw(pContext->psDisplay, i32X, i32Y,
+                         psColors->pui32Color[ui32Level]);
+        }
+        else
+        {
+            DpyLineDrawH(pContext->psDisplay, i32X, i32X1, i32Y,
+                         psColors->pui32Color[ui32Level]);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Draws an anti-aliased glyph, as described by FONT_FMT_AA4_RLE, with its
+// upper left corner at the given position.  Partially covered pixels are
+// blended against the background color of the context, even when the
+// background is not being drawn.
+//
+//*****************************************************************************
+static void
+AAGlyphRender(const tContext *pContext, const uint8_t *pui8Data,
+              int32_t i32X, int32_t i32Y, bool bOpaque,
+              const tAAColors *psColors)
+{
+    int32_t i32Idx, i32X0, i32Y0, i32Width, i32Count, i32Run, i32Pixel;
+    const uint8_t *pui8Literal;
+    uint32_t ui32Level;
+    uint8_t ui8Code;
+
+    //
+    // Ignore this glyph if it is empty or is entirely outside the clipping
+    // region.
+    //
+    i32Width = pui8Data[1];
+    if((i32Width == 0) || (i32X > pContext->sClipRegion.i16XMax) ||
+       ((i32X + i32Width) <= pContext->sClipRegion.i16XMin))
+    {
+        return;
+    }
+
+    //
+    // Loop through the codes in the glyph data.
+    //
+    for(i32Idx = 2, i32X0 = 0, i32Y0 = 0;
+        (i32Y + i32Y0) <= pContext->sClipRegion.i16YMax; )
+    {
+        //
+        // Get the next code, stopping at the end of the glyph.
+        //
+        ui8Code = pui8Data[i32Idx++];
+        if(ui8Code == 0)
+        {
+            break;
+        }
+
+        //
+        // Decode the length and coverage of this run.
+        //
+        pui8Literal = 0;
+        ui32Level = 0;
+        switch(ui8Code & 0xc0)
+        {
+            case 0x00:
+            {
+                i32Count = ui8Code;
+                break;
+            }
+
+            case 0x40:
+            {
+                i32Count = (ui8Code & 0x3f) + 1;
+                ui32Level = AA_COVERED;
+                break;
+            }
+
+            case 0x80:
+            {
+                i32Count = (ui8Code & 0x3f) + 1;
+                pui8Literal = pui8Data + i32Idx;
+                i32Idx += (i32Count + 1) / 2;
+                break;
+            }
+
+            default:
+            {
+                i32Count = ((ui8Code >> 4) & 3) + 1;
+                ui32Level = ui8Code & 15;
+                break;
+            }
+        }
+
+        //
+        // Draw the run, splitting it where it wraps onto the next row.
+        //
+        for(i32Pixel = 0; i32Count; )
+        {
+            i32Run = i32Width - i32X0;
+            if(i32Run > i32Count)
+            {
+                i32Run = i32Count;
+            }
+
+            AARunDraw(pContext, i32X + i32X0, i32Y + i32Y0, i32Run,
+                      ui32Level, pui8Literal, i32Pixel, bOpaque, psColors);
+
+            i32Pixel += i32Run;
+            i32Count -= i32Run;
+            i32X0 += i32Run;
+            if(i32X0 == i32Width)
+            {
+                i32X0 = 0;
+                i32Y0++;
+            }
+        }
+    }
+}
+
 //*****************************************************************************
 //
 //! Determines the width of a string.
@@ -216,7 +504,9 @@ GrStringWidthGet(const tContext *pContext, const char *pcString,
         //
         // Get information on this glyph.
         //
-        pui8Data = GrFontGlyphDataGet(pContext->psFont, ui32Char, &ui8Width);
+        pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex,
+                                           pContext->psFont, ui32Char,
+                                           &ui8Width);
 
         //
         // Does the glyph exist?
@@ -226,8 +516,10 @@ GrStringWidthGet(const tContext *pContext, const char *pcString,
             //
             // No - get the absent character replacement information.
             //
-            pui8Data = GrFontGlyphDataGet(pContext->psFont,
-                                          ABSENT_CHAR_REPLACEMENT, &ui8Width);
+            pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex,
+                                               pContext->psFont,
+                                               ABSENT_CHAR_REPLACEMENT,
+                                               &ui8Width);
 
             //
             // Does this character exist in the font?
@@ -237,8 +529,9 @@ GrStringWidthGet(const tContext *pContext, const char *pcString,
                 //
                 // No - look for the ASCII/Unicode space character.
                 //
-                pui8Data = GrFontGlyphDataGet(pContext->psFont, 0x20,
-                                              &ui8Width);
+                pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex,
+                                                   pContext->psFont, 0x20,
+                                                   &ui8Width);
 
                 //
                 // Does this exist?
@@ -311,6 +604,7 @@ GrStringDraw(const tContext *pContext, const char *pcString, int32_t i32Length,
     const uint8_t *pui8Glyphs;
     const uint16_t *pui16Offset;
     uint8_t ui8First, ui8Last, ui8Absent;
+    tAAColors sAAColors;
     tContext i16Con;
 
     //
@@ -375,6 +669,15 @@ GrStringDraw(const tContext *pContext, const char *pcString, int32_t i32Length,
         ui8Absent = ABSENT_CHAR_REPLACEMENT;
     }
 
+    //
+    // If the font is anti-aliased, compute the blended colors used to draw
+    // its glyphs.
+    //
+    if(FontFormatIsAA(pContext->psFont->ui8Format))
+    {
+        AAColorsGet(pContext, &sAAColors);
+    }
+
     //
     // Loop through the characters in the string.
     //
@@ -420,6 +723,17 @@ GrStringDraw(const tContext *pContext, const char *pcString, int32_t i32Length,
             continue;
         }
 
+        //
+        // Anti-aliased glyphs are drawn separately.
+        //
+        if(FontFormatIsAA(i16Con.psFont->ui8Format))
+        {
+            AAGlyphRender(&i16Con, pui8Data, i32X, i32Y,
+                          bOpaque ? true : false, &sAAColors);
+            i32X += pui8Data[1];
+            continue;
+        }
+
         //
         // Loop through the bytes in the encoded data for this glyph.
         //
@@ -899,6 +1213,8 @@ GrDefaultStringRenderer(const tContext *pContext, const char *pcString,
     uint8_t ui8Format, ui8Width, ui8MaxWidth, ui8Height, ui8Baseline;
     uint32_t ui32Char, ui32Count, ui32Skip;
     const uint8_t *pui8Data;
+    tAAColors sAAColors;
+    bool bAA;
 
     //
     // Check the arguments.
@@ -922,6 +1238,16 @@ GrDefaultStringRenderer(const tContext *pContext, const char *pcString,
         return;
     }
 
+    //
+    // If the font is anti-aliased, compute the blended colors used to draw
+    // its glyphs.
+    //
+    bAA = FontFormatIsAA(ui8Format);
+    if(bAA)
+    {
+        AAColorsGet(pContext, &sAAColors);
+    }
+
     //
     // Set the maximum number of characters we should render.  Note that the
     // value -1 is used to indicate that the function should render until it
@@ -958,10 +1284,30 @@ GrDefaultStringRenderer(const tContext *pContext, const char *pcString,
             return;
         }
 
+        //
+        // If a glyph cache is in use, try to draw the character from it.  The
+        // cache only holds 1 bit per pixel glyphs.
+        //
+        if(pContext->psGlyphCache && !bAA &&
+           GrGlyphCacheRender(pContext, ui32Char, i32X, i32Y,
+                              (ui8Format & FONT_FMT_PIXEL_RLE) ? true : false,
+                              bOpaque, &ui8Width))
+        {
+            //
+            // Move on to the next character.
+            //
+            i32X += ui8Width;
+            pcString += ui32Skip;
+            ui32Count -= ui32Skip;
+            continue;
+        }
+
         //
         // Get the glyph data pointer for this character.
         //
-        pui8Data = GrFontGlyphDataGet(pContext->psFont, ui32Char, &ui8Width);
+        pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex,
+                                           pContext->psFont, ui32Char,
+                                           &ui8Width);
 
         //
         // Does this glyph exist in the font?
@@ -972,8 +1318,10 @@ GrDefaultStringRenderer(const tContext *pContext, const char *pcString,
             // Look for the character we are supposed to use in place of absent
             // glyphs.
             //
-            pui8Data = GrFontGlyphDataGet(pContext->psFont,
-                                          ABSENT_CHAR_REPLACEMENT, &ui8Width);
+            pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex,
+                                               pContext->psFont,
+                                               ABSENT_CHAR_REPLACEMENT,
+                                               &ui8Width);
 
             //
             // Does this glyph exist in the font?
@@ -983,8 +1331,9 @@ GrDefaultStringRenderer(const tContext *pContext, const char *pcString,
                 //
                 // Last chance - look for the space character.
                 //
-                pui8Data = GrFontGlyphDataGet(pContext->psFont, ' ',
-                                              &ui8Width);
+                pui8Data = GrFontIndexGlyphDataGet(pContext->psFontIndex,
+                                                   pContext->psFont, ' ',
+                                                   &ui8Width);
             }
         }
 
@@ -993,9 +1342,17 @@ GrDefaultStringRenderer(const tContext *pContext, const char *pcString,
         //
         if(pui8Data)
         {
-            GrFontGlyphRender(pContext, pui8Data, i32X, i32Y,
-                              (ui8Format & FONT_FMT_PIXEL_RLE) ? true : false,
-                              bOpaque);
+            if(bAA)
+            {
+                AAGlyphRender(pContext, pui8Data, i32X, i32Y, bOpaque,
+                              &sAAColors);
+            }
+            else
+            {
+                GrFontGlyphRender(pContext, pui8Data, i32X, i32Y,
+                                  (ui8Format & FONT_FMT_PIXEL_RLE) ? true :
+                                  false, bOpaque);
+            }
             i32X += ui8Width;
         }
         else
@@ -1401,8 +1758,16 @@ GrFontGlyphRender(const tContext *pContext, const uint8_t *pui8Data,
                         i32ClipX2 = i32X + i32X0 + i32Count - 1;
                     }
 
-                    DpyLineDrawH(pContext->psDisplay, i32ClipX1, i32ClipX2,
-                                 i32Y + i32Y0, pContext->ui32Background);
+                    //
+                    // The run may lie entirely outside the clipping region,
+                    // in which case there is nothing to draw.
+                    //
+                    if(i32ClipX1 <= i32ClipX2)
+                    {
+                        DpyLineDrawH(pContext->psDisplay, i32ClipX1,
+                                     i32ClipX2, i32Y + i32Y0,
+                                     pContext->ui32Background);
+                    }
                 }
 
                 //
@@ -1521,8 +1886,16 @@ GrFontGlyphRender(const tContext *pContext, const uint8_t *pui8Data,
                         i32ClipX2 = i32X + i32X0 + i32Count - 1;
                     }
 
-                    DpyLineDrawH(pContext->psDisplay, i32ClipX1, i32ClipX2,
-                                 i32Y + i32Y0, pContext->ui32Foreground);
+                    //
+                    // The run may lie entirely outside the clipping region,
+                    // in which case there is nothing to draw.
+                    //
+                    if(i32ClipX1 <= i32ClipX2)
+                    {
+                        DpyLineDrawH(pContext->psDisplay, i32ClipX1,
+                                     i32ClipX2, i32Y + i32Y0,
+                                     pContext->ui32Foreground);
+                    }
                 }
 
                 //
@@ -1826,6 +2199,61 @@ FontGlyphDataGet(const tFont *psFont, uint32_t ui32CodePoint,
     }
 }
 
+//*****************************************************************************
+//
+// Retrieves a pointer to the data for a glyph within a given block of a
+// tFontWide font.
+//
+// \param psFont points to the font whose glyph is to be queried.
+// \param pBlock points to the description of the block containing the glyph.
+// \param ui32CodePoint idenfities the specific glyph whose data is being
+//        queried.
+// \param pui8Width points to storage which will be written with the
+//        width of the requested glyph in pixels.
+//
+// \return Returns a pointer to the data for the requested glyph or NULL if
+// the glyph is not encoded in the font.
+//
+//*****************************************************************************
+static const uint8_t *
+FontWideBlockGlyphGet(const tFontWide *psFont, const tFontBlock *pBlock,
+                      uint32_t ui32CodePoint, uint8_t *pui8Width)
+{
+    const uint8_t *pui8Data;
+    uint32_t *pui32OffsetTable;
+    uint32_t ui32Offset;
+
+    //
+    // Get the offset to the glyph data via the block's offset table.
+    //
+    pui32OffsetTable = (uint32_t *)((uint8_t *)psFont +
+                                    pBlock->ui32GlyphTableOffset);
+    ui32Offset = pui32OffsetTable[ui32CodePoint - pBlock->ui32StartCodepoint];
+
+    //
+    // Is the offset non-zero? Zero offset indicates that the glyph is not
+    // encoded in the font.
+    //
+    if(ui32Offset)
+    {
+        //
+        // The offset is not 0 so this glyph does exist. Return a pointer to
+        // its data.
+        //
+        pui8Data = (const uint8_t *)pui32OffsetTable + ui32Offset;
+        *pui8Width = pui8Data[1];
+        return(pui8Data);
+    }
+    else
+    {
+        //
+        // The glyph offset was 0 so this implies that the glyph does not
+        // exist.  Return NULL to indicate this.
+        //
+        return(0);
+    }
+}
+
 //*****************************************************************************
 //
 // Retrieves a pointer to the data for a specific glyph in a tFontWide font.
@@ -1847,11 +2275,8 @@ static const uint8_t *
 FontWideGlyphDataGet(const tFontWide *psFont, uint32_t ui32CodePoint,
                      uint8_t *pui8Width)
 {
-    const uint8_t *pui8Data;
     tFontBlock *pBlock;
-    uint32_t *pui32OffsetTable;
     uint32_t ui32Loop;
-    uint32_t ui32Offset;
 
     //
     // Get a pointer to the first block description in the font.
@@ -1890,36 +2315,11 @@ FontWideGlyphDataGet(const tFontWide *psFont, uint32_t ui32CodePoint,
     }
 
     //
-    // Get the offset to the glyph data via the block's offset table.
+    // Look up the glyph within the block.
     //
-    pui32OffsetTable = (uint32_t *)((uint8_t *)psFont +
-                                    pBlock[ui32Loop].ui32GlyphTableOffset);
-    ui32Offset = pui32OffsetTable[ui32CodePoint -
-                                  pBlock[ui32Loop].ui32StartCodepoint];
-
-    //
-    // Is the offset non-zero? Zero offset indicates that the glyph is not
-    // encoded in the font.
-    //
-    if(ui32Offset)
-    {
-        //
-        // The offset is not 0 so this glyph does exist. Return a pointer to
-        // its data.
-        //
-        pui8Data = (const uint8_t *)pui32OffsetTable + ui32Offset;
-        *pui8Width = pui8Data[1];
-        return(pui8Data);
-    }
-    else
-    {
-        //
-        // The glyph offset was 0 so this implies that the glyph does not
-        // exist.  Return NULL to indicate this.
-        //
-        return(0);
-    }
-}
+    return(FontWideBlockGlyphGet(psFont, &pBlock[ui32Loop], ui32CodePoint,
+                                 pui8Width));
+}
 
 //*****************************************************************************
 //
@@ -2265,6 +2665,344 @@ GrFontBlockCodepointsGet(const tFont *psFont, uint16_t ui16BlockIndex,
     }
 }
 
+//*****************************************************************************
+//
+// Determines whether a block table is sorted by starting codepoint with no
+// two blocks overlapping, as required for it to be binary searched.
+//
+//*****************************************************************************
+static bool
+FontBlocksSorted(const tFontBlock *pBlock, uint32_t ui32NumBlocks)
+{
+    uint32_t ui32Loop;
+
+    for(ui32Loop = 1; ui32Loop < ui32NumBlocks; ui32Loop++)
+    {
+        if((pBlock[ui32Loop].ui32StartCodepoint <
+            pBlock[ui32Loop - 1].ui32StartCodepoint) ||
+           ((pBlock[ui32Loop].ui32StartCodepoint -
+             pBlock[ui32Loop - 1].ui32StartCodepoint) <
+            pBlock[ui32Loop - 1].ui32NumCodepoints))
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Initializes a font block index.
+//!
+//! \param psIndex is a pointer to the font block index to initialize.
+//! \param psStorage is a pointer to the memory used to hold a sorted copy of
+//! a font's block table, or 0 if no memory is provided.
+//! \param ui32MaxBlocks is the number of blocks which fit in \e psStorage.
+//!
+//! This function prepares a font block index for use.  A font block index
+//! allows the glyphs of wide fonts (those described by a tFontWide structure)
+//! and wrapped fonts to be found using a binary search of the font's blocks
+//! rather than by walking the font's block table for every character drawn.
+//! Once initialized, the index should be passed to GrContextFontIndexSet();
+//! it is then rebuilt each time a new font is selected into the context.
+//!
+//! Wide fonts whose block tables are already sorted by codepoint, which is
+//! the case for fonts produced by the ftrasterize tool, are indexed in place
+//! and need no storage.  Storage is needed to index a wrapped font, or a wide
+//! font whose block table is not sorted; such a font is not indexed if it
+//! contains more than \e ui32MaxBlocks blocks, and its glyphs are then found
+//! as if no index was in use.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrFontIndexInit(tFontIndex *psIndex, tFontBlock *psStorage,
+                uint32_t ui32MaxBlocks)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psIndex);
+    ASSERT(psStorage || !ui32MaxBlocks);
+    ASSERT(ui32MaxBlocks <= 0xffff);
+
+    //
+    // Save the storage and mark the index as empty.
+    //
+    psIndex->psFont = 0;
+    psIndex->psBlocks = 0;
+    psIndex->psStorage = psStorage;
+    psIndex->ui16MaxBlocks = ui32MaxBlocks;
+    psIndex->ui16NumBlocks = 0;
+    psIndex->ui16LastBlock = 0;
+    psIndex->ui16Reserved = 0;
+    psIndex->ui32Hits = 0;
+    psIndex->ui32Searches = 0;
+}
+
+//*****************************************************************************
+//
+//! Builds a font block index for a font.
+//!
+//! \param psIndex is a pointer to the font block index to build.
+//! \param psFont is a pointer to the font to be indexed.
+//!
+//! This function builds the block index for a font, replacing any font
+//! previously described by the index.  Nothing is done if the index already
+//! describes the font.  This function is called by GrContextFontSet() for
+//! contexts which have a font block index, so applications need only call it
+//! directly when using GrFontIndexGlyphDataGet() without a context.
+//!
+//! Only wide and wrapped fonts are indexed.  A wrapped font's block table is
+//! read once, using GrFontBlockCodepointsGet(), when the index is built.
+//!
+//! \return Returns \b true if the font is indexed or \b false if its glyphs
+//! will be found without using the index.
+//
+//*****************************************************************************
+bool
+GrFontIndexBuild(tFontIndex *psIndex, const tFont *psFont)
+{
+    const tFontBlock *pBlock;
+    tFontBlock *psEntry, sBlock;
+    uint32_t ui32NumBlocks, ui32Loop, ui32Pos;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psIndex);
+    ASSERT(psFont);
+
+    //
+    // There is nothing to do if the index already describes this font.
+    //
+    if(psIndex->psFont == psFont)
+    {
+        return(true);
+    }
+
+    //
+    // Empty the index.
+    //
+    psIndex->psFont = 0;
+    psIndex->psBlocks = 0;
+    psIndex->ui16NumBlocks = 0;
+    psIndex->ui16LastBlock = 0;
+
+    //
+    // Determine the font's block table.
+    //
+    if(psFont->ui8Format == FONT_FMT_WRAPPED)
+    {
+        //
+        // The block table of a wrapped font is held by the wrapper so it
+        // must be read into the index's storage.
+        //
+        ui32NumBlocks = GrFontNumBlocksGet(psFont);
+        if(!ui32NumBlocks || (ui32NumBlocks > psIndex->ui16MaxBlocks))
+        {
+            return(false);
+        }
+        for(ui32Loop = 0; ui32Loop < ui32NumBlocks; ui32Loop++)
+        {
+            psEntry = psIndex->psStorage + ui32Loop;
+            psEntry->ui32NumCodepoints =
+                GrFontBlockCodepointsGet(psFont, ui32Loop,
+                                         &psEntry->ui32StartCodepoint);
+            psEntry->ui32GlyphTableOffset = 0;
+        }
+        pBlock = psIndex->psStorage;
+    }
+    else if(psFont->ui8Format & FONT_WIDE_MARKER)
+    {
+        //
+        // Use the wide font's own block table if it is sorted.
+        //
+        ui32NumBlocks = ((tFontWide *)psFont)->ui16NumBlocks;
+        pBlock = (tFontBlock *)((tFontWide *)psFont + 1);
+        if(!ui32NumBlocks)
+        {
+            return(false);
+        }
+        if(!FontBlocksSorted(pBlock, ui32NumBlocks))
+        {
+            //
+            // The table is not sorted so copy it into the index's storage.
+            //
+            if(ui32NumBlocks > psIndex->ui16MaxBlocks)
+            {
+                return(false);
+            }
+            for(ui32Loop = 0; ui32Loop < ui32NumBlocks; ui32Loop++)
+            {
+                psIndex->psStorage[ui32Loop] = pBlock[ui32Loop];
+            }
+            pBlock = psIndex->psStorage;
+        }
+    }
+    else
+    {
+        //
+        // Fonts with a single block of 8-bit codepoints are not indexed.
+        //
+        return(false);
+    }
+
+    //
+    // If the blocks were copied into the index's storage, sort them by
+    // starting codepoint.  An insertion sort is used since this is done only
+    // when the font is selected and the tables are typically nearly sorted.
+    //
+    if(pBlock == psIndex->psStorage)
+    {
+        for(ui32Loop = 1; ui32Loop < ui32NumBlocks; ui32Loop++)
+        {
+            sBlock = psIndex->psStorage[ui32Loop];
+            for(ui32Pos = ui32Loop;
+                (ui32Pos > 0) &&
+                (psIndex->psStorage[ui32Pos - 1].ui32StartCodepoint >
+                 sBlock.ui32StartCodepoint); ui32Pos--)
+            {
+                psIndex->psStorage[ui32Pos] = psIndex->psStorage[ui32Pos - 1];
+            }
+            psIndex->psStorage[ui32Pos] = sBlock;
+        }
+
+        //
+        // Blocks which overlap can not be searched, so do not index the
+        // font.
+        //
+        if(!FontBlocksSorted(pBlock, ui32NumBlocks))
+        {
+            return(false);
+        }
+    }
+
+    //
+    // The index now describes this font.
+    //
+    psIndex->psFont = psFont;
+    psIndex->psBlocks = pBlock;
+    psIndex->ui16NumBlocks = ui32NumBlocks;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Retrieves a pointer to the data for a font glyph using a font block index.
+//!
+//! \param psIndex is a pointer to the font block index to use, or 0 if none
+//! is available.
+//! \param psFont points to the font whose glyph is to be queried.
+//! \param ui32CodePoint idenfities the specific glyph whose data is being
+//!        queried.
+//! \param pui8Width points to storage which will be written with the
+//!        width of the requested glyph in pixels.
+//!
+//! This function performs the same lookup as GrFontGlyphDataGet(), using the
+//! font block index to find the block containing the glyph if the index
+//! describes \e psFont.  The block which satisfies each lookup is remembered
+//! and checked first on the next lookup, so strings whose characters are
+//! drawn from a single block require no search at all.  If the index does not
+//! describe \e psFont, GrFontGlyphDataGet() is used instead.
+//!
+//! \return Returns a pointer to the data for the requested glyph or NULL if
+//! the glyph does not exist in the font.
+//
+//*****************************************************************************
+const uint8_t *
+GrFontIndexGlyphDataGet(tFontIndex *psIndex, const tFont *psFont,
+                        uint32_t ui32CodePoint, uint8_t *pui8Width)
+{
+    const tFontBlock *pBlock;
+    uint32_t ui32Low, ui32High, ui32Mid;
+
+    ASSERT(psFont);
+    ASSERT(pui8Width);
+
+    //
+    // Use the font's own lookup if the index does not describe this font.
+    //
+    if(!psIndex || (psIndex->psFont != psFont))
+    {
+        return(GrFontGlyphDataGet(psFont, ui32CodePoint, pui8Width));
+    }
+
+    //
+    // Does the codepoint lie within the block used by the last lookup?
+    //
+    pBlock = psIndex->psBlocks + psIndex->ui16LastBlock;
+    if((ui32CodePoint - pBlock->ui32StartCodepoint) <
+       pBlock->ui32NumCodepoints)
+    {
+        psIndex->ui32Hits++;
+    }
+    else
+    {
+        //
+        // No - perform a binary search for the block containing the
+        // codepoint.
+        //
+        psIndex->ui32Searches++;
+        ui32Low = 0;
+        ui32High = psIndex->ui16NumBlocks;
+        while(1)
+        {
+            //
+            // If the range is empty, the codepoint is not in any block.
+            //
+            if(ui32Low >= ui32High)
+            {
+                return(0);
+            }
+
+            //
+            // Determine which side of the middle block the codepoint lies.
+            //
+            ui32Mid = (ui32Low + ui32High) / 2;
+            pBlock = psIndex->psBlocks + ui32Mid;
+            if(ui32CodePoint < pBlock->ui32StartCodepoint)
+            {
+                ui32High = ui32Mid;
+            }
+            else if((ui32CodePoint - pBlock->ui32StartCodepoint) >=
+                    pBlock->ui32NumCodepoints)
+            {
+                ui32Low = ui32Mid + 1;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        //
+        // Remember the block for the next lookup.
+        //
+        psIndex->ui16LastBlock = ui32Mid;
+    }
+
+    //
+    // The glyphs of a wrapped font are retrieved through the wrapper, which
+    // is known to contain the codepoint.
+    //
+    if(psFont->ui8Format == FONT_FMT_WRAPPED)
+    {
+        return(((tFontWrapper *)psFont)->pFuncs->
+               pfnFontGlyphDataGet(((tFontWrapper *)psFont)->pui8FontId,
+                                   ui32CodePoint, pui8Width));
+    }
+
+    //
+    // Look up the glyph within the wide font's block.
+    //
+    return(FontWideBlockGlyphGet((const tFontWide *)psFont, pBlock,
+                                 ui32CodePoint, pui8Width));
+}
+
 //*****************************************************************************
 //
 //! Provides GrLib with a table of source/font codepage mapping functions.
@@ -2385,11 +3123,56 @@ GrContextFontSet(tContext *pContext, const tFont *psFont)
     //
     pContext->psFont = psFont;
 
+    //
+    // Index the font's blocks if the context has a font block index.
+    //
+    if(pContext->psFontIndex)
+    {
+        GrFontIndexBuild(pContext->psFontIndex, psFont);
+    }
+
     //
     // Update the character mapping to ensure that we show the right glyphs.
     //
     UpdateContextCharMapping(pContext);
 }
+
+//*****************************************************************************
+//
+//! Sets the font block index to be used.
+//!
+//! \param pContext is a pointer to the drawing context to modify.
+//! \param psIndex is a pointer to the font block index to be used, or 0 to
+//! search each font's block table directly.
+//!
+//! This function sets the font block index used to find glyphs in wide and
+//! wrapped fonts drawn using the specified drawing context, and builds the
+//! index for the context's current font.  The index is rebuilt whenever
+//! GrContextFontSet() selects a different font.  An index may be shared by
+//! drawing contexts which use the same font, but giving each context its own
+//! index avoids rebuilding the index when the contexts are used alternately.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrContextFontIndexSet(tContext *pContext, tFontIndex *psIndex)
+{
+    ASSERT(pContext);
+
+    //
+    // Remember the index to be used.
+    //
+    pContext->psFontIndex = psIndex;
+
+    //
+    // Index the current font, if there is one.
+    //
+    if(psIndex && pContext->psFont)
+    {
+        GrFontIndexBuild(psIndex, pContext->psFont);
+    }
+}
 #endif
 
 //*****************************************************************************
@@ -2421,6 +3204,15 @@ static uint16_t g_ui16Language;
 static uint16_t g_ui16NumLanguages;
 static uint16_t g_ui16NumStrings;
 
+//*****************************************************************************
+//
+// The current string table if it is in the extended format, and the cache of
+// strings retrieved from the current string table.
+//
+//*****************************************************************************
+static const tStringTableEx *g_psStringTableEx;
+static tStringCache *g_psStringCache;
+
 //*****************************************************************************
 //
 //! This function sets the location of the current string table.
@@ -2462,6 +3254,58 @@ GrStringTableSet(const void *pvTable)
     //
     g_pui8StringData = (uint8_t *)(g_pui32StringTable +
                                    (g_ui16NumStrings * g_ui16NumLanguages));
+
+    //
+    // This table is not in the extended format, and any cached strings came
+    // from a different table.
+    //
+    g_psStringTableEx = 0;
+    if(g_psStringCache)
+    {
+        GrStringCacheFlush(g_psStringCache);
+    }
+}
+
+//*****************************************************************************
+//
+//! This function sets the location of the current string table, when the
+//! table is in the extended format.
+//!
+//! \param psTable is a pointer to a string table that was generated by the
+//! mkstrtab utility.
+//!
+//! This function is used in place of GrStringTableSet() to select a string
+//! table in the extended format, which indexes each string directly and
+//! compresses the strings with a dictionary shared by all languages.  Once
+//! selected, the languages and strings in the table are accessed in the same
+//! way as those in any other string table, with GrStringLanguageSet() and
+//! GrStringGet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrStringTableExSet(const tStringTableEx *psTable)
+{
+    ASSERT(psTable);
+
+    //
+    // Save the table, along with the number of languages and strings and
+    // the language identifier table, which are used in the same way as for
+    // any other string table.
+    //
+    g_psStringTableEx = psTable;
+    g_ui16NumStrings = psTable->ui16NumStrings;
+    g_ui16NumLanguages = psTable->ui16NumLanguages;
+    g_pui16LanguageTable = psTable->pui16Languages;
+
+    //
+    // Any cached strings came from a different table.
+    //
+    if(g_psStringCache)
+    {
+        GrStringCacheFlush(g_psStringCache);
+    }
 }
 
 //*****************************************************************************
@@ -2516,32 +3360,20 @@ GrStringLanguageSet(uint16_t ui16LangID)
 
 //*****************************************************************************
 //
-//! This function returns a string from the current string table.
-//!
-//! \param i32Index is the index of the string to retrieve.
-//! \param pcData is the pointer to the buffer to store the string into.
-//! \param ui32Size is the size of the buffer provided by pcData.
-//!
-//! This function will return a string from the string table in the language
-//! set by the GrStringLanguageSet() function.  The value passed in \e iIndex
-//! parameter is the string that is being requested and will be returned in
-//! the buffer provided in the \e pcData parameter.  The amount of data
-//! returned will be limited by the ui32Size parameter.
-//!
-//! \return Returns the number of valid bytes returned in the \e pcData buffer.
+// Decodes a string from the current string table, which is in the format
+// generated by the string compression utility, into the buffer provided.
+// Returns the number of bytes written to the buffer (not counting the null
+// terminator, which is written if there is room).
 //
 //*****************************************************************************
-uint32_t
-GrStringGet(int32_t i32Index, char *pcData, uint32_t ui32Size)
+static uint32_t
+StringTableGet(int32_t i32Index, char *pcData, uint32_t ui32Size)
 {
     uint32_t ui32Len, ui32Offset, ui32SubCode[16];
     int32_t i32Pos, i32Idx, i32Bit, i32Skip, i32Buf;
     uint8_t *pui8BufferOut;
     const uint8_t *pui8String;
 
-    ASSERT(i32Index < g_ui16NumStrings);
-    ASSERT(pcData != 0);
-
     //
     // Initialize the output buffer state.
     //
@@ -2599,9 +3431,22 @@ GrStringGet(int32_t i32Index, char *pcData, uint32_t ui32Size)
         if(ui32Offset == SC_IS_NULL)
         {
             //
-            // An empty string.
+            // An empty string, which ends any pieces of other strings copied
+            // so far.  Null terminate the string if there is room.
+            //
+            if(i32Idx < ui32Size)
+            {
+                pcData[i32Idx] = 0;
+            }
+
+            //
+            // If this is the last piece of the string, initialize the output
+            // pointer so that the length of the string is returned.
             //
-            pcData[i32Idx] = 0;
+            if(!i32Pos)
+            {
+                pui8BufferOut = (uint8_t *)pcData + i32Idx;
+            }
         }
         else if(ui32Offset & SC_FLAG_COMPRESSED)
         {
@@ -2785,6 +3630,16 @@ GrStringGet(int32_t i32Index, char *pcData, uint32_t ui32Size)
                     break;
                 }
             }
+
+            //
+            // This is the last piece of the string, so initialize the output
+            // pointer if it has not been (as is the case for an uncompressed
+            // string table) so that the length is returned.
+            //
+            if(!pui8BufferOut)
+            {
+                pui8BufferOut = (uint8_t *)pcData + (i32Idx + i32Buf);
+            }
         }
         else
         {
@@ -2845,6 +3700,474 @@ GrStringGet(int32_t i32Index, char *pcData, uint32_t ui32Size)
     return(ui32Len);
 }
 
+//*****************************************************************************
+//
+//! Decodes a string from a string table in the extended format.
+//!
+//! \param psTable is a pointer to the string table.
+//! \param ui32Language is the position of the string's language within the
+//! table's language identifier table.
+//! \param ui32Index is the index of the string to retrieve.
+//! \param pcData is the pointer to the buffer to store the string into.
+//! \param ui32Size is the size of the buffer provided by pcData.
+//!
+//! This function decodes a string from the given table into the caller's
+//! buffer, independently of the current string table and language.  The
+//! string is located directly from its language and index, and the decoding
+//! stops as soon as the buffer is full.  The string is null terminated if
+//! there is room in the buffer.
+//!
+//! \return Returns the number of bytes written to the \e pcData buffer, not
+//! counting the null terminator.  If this is equal to \e ui32Size, the string
+//! may have been truncated.
+//
+//*****************************************************************************
+uint32_t
+GrStringTableExGet(const tStringTableEx *psTable, uint32_t ui32Language,
+                   uint32_t ui32Index, char *pcData, uint32_t ui32Size)
+{
+    const uint8_t *pui8Code, *pui8End, *pui8Copy, *pui8Words;
+    const uint16_t *pui16WordOffsets;
+    uint32_t ui32Len, ui32Word, ui32CopyLen;
+    char *pcOut, *pcOutEnd;
+    uint8_t ui8Code;
+
+    ASSERT(psTable);
+    ASSERT(ui32Language < psTable->ui16NumLanguages);
+    ASSERT(ui32Index < psTable->ui16NumStrings);
+    ASSERT(pcData != 0);
+
+    //
+    // Find the start and end of the encoded string.
+    //
+    ui32Index += ui32Language * psTable->ui16NumStrings;
+    pui8Code = (psTable->pui8Strings +
+                psTable->pui32StringOffsets[ui32Index]);
+    pui8End = (psTable->pui8Strings +
+               psTable->pui32StringOffsets[ui32Index + 1]);
+    pui16WordOffsets = psTable->pui16WordOffsets;
+    pui8Words = psTable->pui8Words;
+
+    //
+    // Decode the string until it ends or the buffer is full.  Each token is
+    // a block of characters (a run of literals or a dictionary word) which
+    // is copied as a whole.
+    //
+    pcOut = pcData;
+    pcOutEnd = pcData + ui32Size;
+    while((pui8Code < pui8End) && (pcOut < pcOutEnd))
+    {
+        ui8Code = *pui8Code++;
+        if(ui8Code < STRING_CODE_WORD)
+        {
+            //
+            // The literal characters follow the code.
+            //
+            pui8Copy = pui8Code;
+            ui32CopyLen = ui8Code + 1;
+            pui8Code += ui32CopyLen;
+        }
+        else
+        {
+            //
+            // Find the dictionary word which is referenced.
+            //
+            if(ui8Code >= STRING_CODE_LONG_WORD)
+            {
+                ui32Word = (STRING_NUM_SHORT_WORDS +
+                            ((ui8Code - STRING_CODE_LONG_WORD) << 8) +
+                            *pui8Code++);
+            }
+            else
+            {
+                ui32Word = ui8Code - STRING_CODE_WORD;
+            }
+            ASSERT(ui32Word < psTable->ui16NumWords);
+
+            pui8Copy = pui8Words + pui16WordOffsets[ui32Word];
+            ui32CopyLen = (pui16WordOffsets[ui32Word + 1] -
+                           pui16WordOffsets[ui32Word]);
+        }
+
+        //
+        // Copy as much of the block as fits into the buffer.
+        //
+        if(ui32CopyLen > (uint32_t)(pcOutEnd - pcOut))
+        {
+            ui32CopyLen = pcOutEnd - pcOut;
+        }
+        while(ui32CopyLen--)
+        {
+            *pcOut++ = *pui8Copy++;
+        }
+    }
+    ui32Len = pcOut - pcData;
+
+    //
+    // Null terminate the string if there is room.
+    //
+    if(ui32Len < ui32Size)
+    {
+        pcData[ui32Len] = 0;
+    }
+
+    return(ui32Len);
+}
+
+//*****************************************************************************
+//
+// Decodes a string from the current string table, in the current language,
+// into the buffer provided.
+//
+//*****************************************************************************
+static uint32_t
+StringDecode(int32_t i32Index, char *pcData, uint32_t ui32Size)
+{
+    if(g_psStringTableEx)
+    {
+        return(GrStringTableExGet(g_psStringTableEx, g_ui16Language, i32Index,
+                                  pcData, ui32Size));
+    }
+
+    return(StringTableGet(i32Index, pcData, ui32Size));
+}
+
+//*****************************************************************************
+//
+// The value of a hash bucket or entry link which marks the end of a bucket.
+//
+//*****************************************************************************
+#define STRING_CACHE_NONE       0xffff
+
+//*****************************************************************************
+//
+// Returns a pointer to an entry of a string cache.
+//
+//*****************************************************************************
+static tStringCacheEntry *
+StringCacheEntry(tStringCache *psCache, uint32_t ui32Idx)
+{
+    return((tStringCacheEntry *)(psCache->pui8Entries +
+                                 (ui32Idx * psCache->ui16EntrySize)));
+}
+
+//*****************************************************************************
+//
+// Returns the hash bucket of a string cache which holds a string.
+//
+//*****************************************************************************
+static uint16_t *
+StringCacheBucket(tStringCache *psCache, uint32_t ui32Language,
+                  uint32_t ui32Index)
+{
+    return(&psCache->pui16Buckets[((ui32Language * g_ui16NumStrings) +
+                                   ui32Index) & psCache->ui16BucketMask]);
+}
+
+//*****************************************************************************
+//
+//! Removes all strings from a string cache.
+//!
+//! \param psCache is a pointer to the string cache.
+//!
+//! This function empties a string cache.  It is called automatically when
+//! the string table is changed, and only needs to be called by the
+//! application if the contents of the current string table are changed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrStringCacheFlush(tStringCache *psCache)
+{
+    uint32_t ui32Idx;
+
+    ASSERT(psCache);
+
+    for(ui32Idx = 0; ui32Idx < psCache->ui16NumEntries; ui32Idx++)
+    {
+        StringCacheEntry(psCache, ui32Idx)->ui32Used = 0;
+    }
+    for(ui32Idx = 0; ui32Idx <= psCache->ui16BucketMask; ui32Idx++)
+    {
+        psCache->pui16Buckets[ui32Idx] = STRING_CACHE_NONE;
+    }
+    psCache->ui32Lookups = 0;
+}
+
+//*****************************************************************************
+//
+//! Initializes a string cache.
+//!
+//! \param psCache is a pointer to the string cache to initialize.
+//! \param pvBuffer is a pointer to the memory used to hold the cache entries.
+//! This must be word aligned.
+//! \param ui32Size is the size of the memory pointed to by \e pvBuffer, in
+//! bytes, which must be enough for at least one string.
+//! \param ui32MaxLength is the length of the longest string which can be
+//! cached.  Longer strings are decoded from the string table each time that
+//! they are retrieved.
+//!
+//! This function initializes a cache for the strings retrieved from the
+//! current string table.  The number of strings that the cache can hold is
+//! the size of the buffer divided by the value returned by
+//! GrStringCacheEntrySize() for \e ui32MaxLength, plus two bytes per entry
+//! for the hash table used to find the strings; GrStringCacheSize() gives
+//! the size of buffer needed for a number of strings.  The cache is used
+//! once it has been passed to GrStringCacheSet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrStringCacheInit(tStringCache *psCache, void *pvBuffer, uint32_t ui32Size,
+                  uint32_t ui32MaxLength)
+{
+    uint32_t ui32Buckets;
+
+    ASSERT(psCache);
+    ASSERT(pvBuffer);
+    ASSERT(ui32MaxLength < 0xffff);
+    ASSERT(ui32Size >= GrStringCacheSize(1, ui32MaxLength));
+    ASSERT((ui32Size / GrStringCacheSize(1, ui32MaxLength)) <
+           STRING_CACHE_NONE);
+
+    psCache->pui8Entries = pvBuffer;
+    psCache->ui16EntrySize = GrStringCacheEntrySize(ui32MaxLength);
+    psCache->ui16MaxLength = ui32MaxLength;
+    psCache->ui16NumEntries = ui32Size / (psCache->ui16EntrySize + 2);
+
+    //
+    // The hash table follows the entries, with the largest power of two
+    // buckets that is no more than the number of entries, so that each
+    // bucket holds few strings.
+    //
+    for(ui32Buckets = 1; (ui32Buckets * 2) <= psCache->ui16NumEntries;
+        ui32Buckets *= 2)
+    {
+    }
+    psCache->pui16Buckets =
+        (uint16_t *)StringCacheEntry(psCache, psCache->ui16NumEntries);
+    psCache->ui16BucketMask = ui32Buckets - 1;
+    psCache->ui32Hits = 0;
+    psCache->ui32Misses = 0;
+
+    GrStringCacheFlush(psCache);
+}
+
+//*****************************************************************************
+//
+//! Sets the cache used for strings retrieved from the string table.
+//!
+//! \param psCache is a pointer to the string cache, or 0 to stop caching
+//! strings.
+//!
+//! This function sets the cache used by GrStringGet() and
+//! GrStringCachedGet().  Strings retrieved from the current string table are
+//! kept in the cache, so that a string which is used repeatedly (such as the
+//! text of a widget that is repainted) is only decoded once.  The cache
+//! applies to string tables in any format.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GrStringCacheSet(tStringCache *psCache)
+{
+    g_psStringCache = psCache;
+
+    //
+    // The cache may hold strings from a different table.
+    //
+    if(psCache)
+    {
+        GrStringCacheFlush(psCache);
+    }
+}
+
+//*****************************************************************************
+//
+// Finds a string from the current string table, in the current language, in
+// the string cache.  If it is not present, it is decoded into the least
+// recently used entry.  Returns a pointer to the entry holding the string, or
+// 0 if the string is too long to be cached.
+//
+//*****************************************************************************
+static tStringCacheEntry *
+StringCacheLookup(tStringCache *psCache, int32_t i32Index)
+{
+    tStringCacheEntry *psEntry, *psOldest;
+    uint32_t ui32Idx, ui32Oldest, ui32Len;
+    uint16_t *pui16Link;
+
+    //
+    // Start again with an empty cache if the lookup count wraps, so that the
+    // least recently used entry can still be found by its count.
+    //
+    if(++psCache->ui32Lookups == 0)
+    {
+        GrStringCacheFlush(psCache);
+        psCache->ui32Lookups = 1;
+    }
+
+    //
+    // Search the string's hash bucket for the string.
+    //
+    for(ui32Idx = *StringCacheBucket(psCache, g_ui16Language, i32Index);
+        ui32Idx != STRING_CACHE_NONE; ui32Idx = psEntry->ui16Next)
+    {
+        psEntry = StringCacheEntry(psCache, ui32Idx);
+        if((psEntry->ui16Index == i32Index) &&
+           (psEntry->ui16Language == g_ui16Language))
+        {
+            psEntry->ui32Used = psCache->ui32Lookups;
+            psCache->ui32Hits++;
+            return(psEntry);
+        }
+    }
+
+    psCache->ui32Misses++;
+
+    //
+    // Find the least recently used entry (or an unused entry), and remove it
+    // from its bucket if it is in use.
+    //
+    ui32Oldest = 0;
+    psOldest = StringCacheEntry(psCache, 0);
+    for(ui32Idx = 1; ui32Idx < psCache->ui16NumEntries; ui32Idx++)
+    {
+        psEntry = StringCacheEntry(psCache, ui32Idx);
+        if(psEntry->ui32Used < psOldest->ui32Used)
+        {
+            ui32Oldest = ui32Idx;
+            psOldest = psEntry;
+        }
+    }
+    if(psOldest->ui32Used)
+    {
+        pui16Link = StringCacheBucket(psCache, psOldest->ui16Language,
+                                      psOldest->ui16Index);
+        while(*pui16Link != ui32Oldest)
+        {
+            pui16Link = &StringCacheEntry(psCache, *pui16Link)->ui16Next;
+        }
+        *pui16Link = psOldest->ui16Next;
+        psOldest->ui32Used = 0;
+    }
+
+    //
+    // Decode the string into the entry.  If it fills the entry (leaving no
+    // room for the terminator) then it is too long to be cached.
+    //
+    ui32Len = StringDecode(i32Index, (char *)(psOldest + 1),
+                           psCache->ui16MaxLength + 1);
+    if(ui32Len > psCache->ui16MaxLength)
+    {
+        return(0);
+    }
+
+    psOldest->ui32Used = psCache->ui32Lookups;
+    psOldest->ui16Index = i32Index;
+    psOldest->ui16Language = g_ui16Language;
+    psOldest->ui16Length = ui32Len;
+    pui16Link = StringCacheBucket(psCache, g_ui16Language, i32Index);
+    psOldest->ui16Next = *pui16Link;
+    *pui16Link = ui32Oldest;
+    return(psOldest);
+}
+
+//*****************************************************************************
+//
+//! This function returns a string from the current string table.
+//!
+//! \param i32Index is the index of the string to retrieve.
+//! \param pcData is the pointer to the buffer to store the string into.
+//! \param ui32Size is the size of the buffer provided by pcData.
+//!
+//! This function will return a string from the string table in the language
+//! set by the GrStringLanguageSet() function.  The value passed in \e iIndex
+//! parameter is the string that is being requested and will be returned in
+//! the buffer provided in the \e pcData parameter.  The amount of data
+//! returned will be limited by the ui32Size parameter.  If a string cache has
+//! been set with GrStringCacheSet(), the string is copied from the cache
+//! when it is present.
+//!
+//! \return Returns the number of valid bytes returned in the \e pcData buffer.
+//
+//*****************************************************************************
+uint32_t
+GrStringGet(int32_t i32Index, char *pcData, uint32_t ui32Size)
+{
+    tStringCacheEntry *psEntry;
+    const char *pcString;
+    uint32_t ui32Len, ui32Idx;
+
+    ASSERT(i32Index < g_ui16NumStrings);
+    ASSERT(pcData != 0);
+
+    //
+    // Copy the string from the cache if it is there, or can be put there.
+    //
+    psEntry = g_psStringCache ? StringCacheLookup(g_psStringCache,
+                                                  i32Index) : 0;
+    if(psEntry)
+    {
+        pcString = (const char *)(psEntry + 1);
+        ui32Len = (psEntry->ui16Length < ui32Size) ? psEntry->ui16Length :
+                                                     ui32Size;
+        for(ui32Idx = 0; ui32Idx < ui32Len; ui32Idx++)
+        {
+            pcData[ui32Idx] = pcString[ui32Idx];
+        }
+
+        //
+        // Null terminate the string if there is room.
+        //
+        if(ui32Len < ui32Size)
+        {
+            pcData[ui32Len] = 0;
+        }
+
+        return(ui32Len);
+    }
+
+    return(StringDecode(i32Index, pcData, ui32Size));
+}
+
+//*****************************************************************************
+//
+//! Returns a string from the current string table via the string cache.
+//!
+//! \param i32Index is the index of the string to retrieve.
+//!
+//! This function returns a pointer to a string from the string table, in the
+//! language set by the GrStringLanguageSet() function, held in the cache set
+//! by GrStringCacheSet().  This avoids both decoding and copying a string
+//! which is used repeatedly.  The string remains valid until it is evicted
+//! from the cache; this can only happen once as many other strings have
+//! been retrieved as there are entries in the cache (less one), or when the
+//! string table is changed or the cache is flushed.
+//!
+//! \return Returns a pointer to the null terminated string, or 0 if there is
+//! no string cache or the string is too long to be cached.
+//
+//*****************************************************************************
+const char *
+GrStringCachedGet(int32_t i32Index)
+{
+    tStringCacheEntry *psEntry;
+
+    ASSERT(i32Index < g_ui16NumStrings);
+
+    if(!g_psStringCache)
+    {
+        return(0);
+    }
+
+    psEntry = StringCacheLookup(g_psStringCache, i32Index);
+    return(psEntry ? (const char *)(psEntry + 1) : 0);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -0,0 +1,742 @@
+//*****************************************************************************
+//
+// trendchart.c - A scrolling trend chart widget.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+#include "grlib/trendchart.h"
+
+//*****************************************************************************
+//
+//! \addtogroup trendchart_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The trend chart shows one or more series of samples which scroll from right
+// to left as new samples are added.  Rather than keeping the samples and
+// redrawing the whole chart for each new one, the chart is scrolled by
+// copying the existing pixels one column to the left and only the new column
+// is drawn.  Each column shows the range of the samples added for it (and
+// reaches back to the last sample of the previous column, so that the trace
+// is continuous), which allows many samples to be shown in each column
+// without losing short peaks.
+//
+// Copying the pixels requires a display which can copy rectangles; all of
+// the off-screen displays can.  If an off-screen display is supplied, the
+// chart is kept in it so that the chart can be repainted, and it is used to
+// redraw the chart if the widget's display can not copy rectangles.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Local defines for the flags in tTrendChartWidget.ui32Flags.
+//
+//*****************************************************************************
+#define FLAG_OFFSCREEN_DRAWN    0x00000001
+
+//*****************************************************************************
+//
+// Converts a value into a row of the chart, counted up from the bottom row.
+//
+//*****************************************************************************
+static int32_t
+TrendChartValueRow(tTrendChartWidget *psChart, int32_t i32Value,
+                   int32_t i32Rows)
+{
+    uint32_t ui32Value, ui32Range;
+
+    //
+    // Values outside of the range of the chart are drawn at its edges.
+    //
+    if(i32Value <= psChart->i32ValueMin)
+    {
+        return(0);
+    }
+    if(i32Value >= psChart->i32ValueMax)
+    {
+        return(i32Rows - 1);
+    }
+
+    //
+    // Find the offset of the value within the range, reducing the precision
+    // of both until they can be scaled without overflowing.
+    //
+    ui32Value = (uint32_t)i32Value - (uint32_t)psChart->i32ValueMin;
+    ui32Range = ((uint32_t)psChart->i32ValueMax -
+                 (uint32_t)psChart->i32ValueMin);
+    while(ui32Range > 0xffff)
+    {
+        ui32Value >>= 1;
+        ui32Range >>= 1;
+    }
+
+    //
+    // Scale the value to the nearest row.
+    //
+    return(((ui32Value * (i32Rows - 1)) + (ui32Range / 2)) / ui32Range);
+}
+
+//*****************************************************************************
+//
+// Draws a column of the chart.  The column is filled with the background
+// color, or the grid color if it has a vertical grid line, the horizontal
+// grid lines are drawn, and then the range of each series is drawn if
+// requested.
+//
+//*****************************************************************************
+static void
+TrendChartColumnDraw(tTrendChartWidget *psChart, tContext *psContext,
+                     const tRectangle *psArea, int32_t i32X, bool bGrid,
+                     bool bSeries)
+{
+    tTrendChartSeries *psSeries;
+    int32_t i32Rows, i32Value, i32Y0, i32Y1;
+
+    i32Rows = psArea->i16YMax - psArea->i16YMin + 1;
+
+    //
+    // Fill the column.
+    //
+    GrContextForegroundSet(psContext, (bGrid ? psChart->ui32GridColor :
+                                       psChart->ui32BackgroundColor));
+    GrLineDrawV(psContext, i32X, psArea->i16YMin, psArea->i16YMax);
+
+    //
+    // Draw the horizontal grid lines, at each multiple of the grid spacing
+    // within the range of the chart.  These are already drawn if the column
+    // has a vertical grid line.
+    //
+    if(!bGrid && (psChart->i32GridValue > 0) &&
+       (psChart->i32ValueMax > psChart->i32ValueMin))
+    {
+        i32Value = ((psChart->i32ValueMin / psChart->i32GridValue) *
+                    psChart->i32GridValue);
+        if(i32Value < psChart->i32ValueMin)
+        {
+            i32Value += psChart->i32GridValue;
+        }
+        GrContextForegroundSet(psContext, psChart->ui32GridColor);
+        while(i32Value <= psChart->i32ValueMax)
+        {
+            GrPixelDraw(psContext, i32X,
+                        (psArea->i16YMax -
+                         TrendChartValueRow(psChart, i32Value, i32Rows)));
+            if((psChart->i32ValueMax - i32Value) < psChart->i32GridValue)
+            {
+                break;
+            }
+            i32Value += psChart->i32GridValue;
+        }
+    }
+
+    //
+    // Draw each series which has samples as a vertical line covering the
+    // range of its samples.
+    //
+    for(psSeries = psChart->psSeries; bSeries && psSeries;
+        psSeries = psSeries->psNext)
+    {
+        if(psSeries->i32Min > psSeries->i32Max)
+        {
+            continue;
+        }
+        i32Y0 = (psArea->i16YMax -
+                 TrendChartValueRow(psChart, psSeries->i32Max, i32Rows));
+        i32Y1 = (psArea->i16YMax -
+                 TrendChartValueRow(psChart, psSeries->i32Min, i32Rows));
+        GrContextForegroundSet(psContext, psSeries->ui32Color);
+        if(i32Y0 == i32Y1)
+        {
+            GrPixelDraw(psContext, i32X, i32Y0);
+        }
+        else
+        {
+            GrLineDrawV(psContext, i32X, i32Y0, i32Y1);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Draws the background and grid of the chart over a range of its columns.
+// The vertical grid lines are placed to match the columns already drawn, so
+// that the grid continues to scroll with the data.
+//
+//*****************************************************************************
+static void
+TrendChartBackgroundDraw(tTrendChartWidget *psChart, tContext *psContext,
+                         const tRectangle *psArea)
+{
+    int32_t i32X, i32Age;
+
+    for(i32X = psContext->sClipRegion.i16XMin;
+        i32X <= psContext->sClipRegion.i16XMax; i32X++)
+    {
+        //
+        // A column has a vertical grid line if it was drawn a multiple of the
+        // grid spacing before the last grid line.
+        //
+        i32Age = psArea->i16XMax - i32X;
+        TrendChartColumnDraw(psChart, psContext, psArea, i32X,
+                             ((psChart->ui16GridColumns != 0) &&
+                              (((i32Age + psChart->ui16GridColumns -
+                                 psChart->ui16GridCount) %
+                                psChart->ui16GridColumns) == 0)), false);
+    }
+}
+
+//*****************************************************************************
+//
+// Draws the background and grid of the chart into the off-screen display, if
+// this has not already been done.
+//
+//*****************************************************************************
+static void
+TrendChartOffscreenInit(tTrendChartWidget *psChart, tContext *psContext,
+                        tRectangle *psArea)
+{
+    //
+    // Get the extents of the chart within the off-screen display.
+    //
+    GrContextInit(psContext, psChart->psOffscreen);
+    psArea->i16XMin = 0;
+    psArea->i16YMin = 0;
+    psArea->i16XMax = (psChart->sBase.sPosition.i16XMax -
+                       psChart->sBase.sPosition.i16XMin);
+    psArea->i16YMax = (psChart->sBase.sPosition.i16YMax -
+                       psChart->sBase.sPosition.i16YMin);
+    GrContextClipRegionSet(psContext, psArea);
+
+    if(!(psChart->ui32Flags & FLAG_OFFSCREEN_DRAWN))
+    {
+        TrendChartBackgroundDraw(psChart, psContext, psArea);
+        psChart->ui32Flags |= FLAG_OFFSCREEN_DRAWN;
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws the trend chart.
+//!
+//! \param psWidget is a pointer to the trend chart widget to be drawn.
+//! \param psClip is the region of the display to be drawn, which lies
+//! within the extents of the widget.
+//!
+//! This function draws the trend chart on the display.  If there is an
+//! off-screen display the chart is copied from it; otherwise the samples that
+//! were shown have been lost, so only the background and grid are drawn.
+//! This is called in response to a \b #WIDGET_MSG_PAINT message.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+TrendChartPaint(tWidget *psWidget, tRectangle *psClip)
+{
+    tTrendChartWidget *psChart;
+    tRectangle sArea;
+    tContext sCtx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+
+    //
+    // Convert the generic widget pointer into a trend chart widget pointer.
+    //
+    psChart = (tTrendChartWidget *)psWidget;
+
+    if(psChart->psOffscreen)
+    {
+        //
+        // Make sure the off-screen display holds the chart, then draw it on
+        // the display.
+        //
+        TrendChartOffscreenInit(psChart, &sCtx, &sArea);
+        GrContextInit(&sCtx, psWidget->psDisplay);
+        GrContextClipRegionSet(&sCtx, psClip);
+        GrImageDraw(&sCtx, psChart->psOffscreen->pvDisplayData,
+                    psWidget->sPosition.i16XMin, psWidget->sPosition.i16YMin);
+    }
+    else
+    {
+        //
+        // Draw the background and grid on the display.
+        //
+        GrContextInit(&sCtx, psWidget->psDisplay);
+        GrContextClipRegionSet(&sCtx, psClip);
+        TrendChartBackgroundDraw(psChart, &sCtx, &(psWidget->sPosition));
+    }
+}
+
+//*****************************************************************************
+//
+//! Adds a column to a trend chart.
+//!
+//! \param psWidget is a pointer to the trend chart widget.
+//!
+//! This function scrolls the trend chart one column to the left and draws the
+//! samples added since the last column was drawn in the new column at the
+//! right of the chart.  The existing columns are moved by copying their
+//! pixels, so only the new column is drawn.
+//!
+//! This is called by TrendChartSampleAdd() once the number of samples shown
+//! in each column have been added.  It may also be called directly, for
+//! example to advance the chart at a fixed rate regardless of the number of
+//! samples added.
+//!
+//! The widget's display must be able to copy rectangles (as the off-screen
+//! displays can), or the chart must have an off-screen display, which is
+//! then copied to the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TrendChartAdvance(tTrendChartWidget *psWidget)
+{
+    tTrendChartSeries *psSeries;
+    tRectangle sArea, sSource;
+    tContext sCtx;
+    bool bGrid, bCopied;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+
+    //
+    // Determine if the new column has a vertical grid line.
+    //
+    bGrid = false;
+    if(psWidget->ui16GridColumns)
+    {
+        psWidget->ui16GridCount++;
+        if(psWidget->ui16GridCount >= psWidget->ui16GridColumns)
+        {
+            psWidget->ui16GridCount = 0;
+            bGrid = true;
+        }
+    }
+
+    //
+    // Scroll the chart kept in the off-screen display, if there is one, and
+    // draw the new column.
+    //
+    if(psWidget->psOffscreen)
+    {
+        TrendChartOffscreenInit(psWidget, &sCtx, &sArea);
+        sSource = sArea;
+        sSource.i16XMin++;
+        GrRectCopy(&sCtx, &sSource, sArea.i16XMin, sArea.i16YMin);
+        TrendChartColumnDraw(psWidget, &sCtx, &sArea, sArea.i16XMax, bGrid,
+                             true);
+    }
+
+    //
+    // Scroll the chart on the display and draw the new column there too.
+    //
+    GrContextInit(&sCtx, psWidget->sBase.psDisplay);
+    GrContextClipRegionSet(&sCtx, &(psWidget->sBase.sPosition));
+    sArea = psWidget->sBase.sPosition;
+    sSource = sArea;
+    sSource.i16XMin++;
+    bCopied = GrRectCopy(&sCtx, &sSource, sArea.i16XMin, sArea.i16YMin);
+    if(bCopied || !psWidget->psOffscreen)
+    {
+        TrendChartColumnDraw(psWidget, &sCtx, &sArea, sArea.i16XMax, bGrid,
+                             true);
+    }
+    else
+    {
+        //
+        // The display can not copy, so draw the whole chart from the
+        // off-screen display instead.
+        //
+        GrImageDraw(&sCtx, psWidget->psOffscreen->pvDisplayData,
+                    sArea.i16XMin, sArea.i16YMin);
+    }
+
+    //
+    // Start the next column of each series from the last sample, so that the
+    // trace is continuous.
+    //
+    for(psSeries = psWidget->psSeries; psSeries; psSeries = psSeries->psNext)
+    {
+        if(psSeries->i32Min <= psSeries->i32Max)
+        {
+            psSeries->i32Min = psSeries->i32Last;
+            psSeries->i32Max = psSeries->i32Last;
+        }
+    }
+    psWidget->ui16Samples = 0;
+}
+
+//*****************************************************************************
+//
+//! Adds a sample to each series of a trend chart.
+//!
+//! \param psWidget is a pointer to the trend chart widget.
+//! \param pi32Values is a pointer to an array of values, one for each series
+//! on the chart in the order in which they were added.
+//!
+//! This function adds a sample to each of the series on the trend chart.
+//! Once the number of samples shown in each column have been added, the
+//! chart is scrolled and a new column is drawn for them.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TrendChartSampleAdd(tTrendChartWidget *psWidget, const int32_t *pi32Values)
+{
+    tTrendChartSeries *psSeries;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+    ASSERT(pi32Values);
+
+    //
+    // Add the sample to the range of samples for each series.
+    //
+    for(psSeries = psWidget->psSeries; psSeries; psSeries = psSeries->psNext)
+    {
+        if(psSeries->i32Min > psSeries->i32Max)
+        {
+            psSeries->i32Min = *pi32Values;
+            psSeries->i32Max = *pi32Values;
+        }
+        else if(*pi32Values < psSeries->i32Min)
+        {
+            psSeries->i32Min = *pi32Values;
+        }
+        else if(*pi32Values > psSeries->i32Max)
+        {
+            psSeries->i32Max = *pi32Values;
+        }
+        psSeries->i32Last = *pi32Values++;
+    }
+
+    //
+    // Draw a new column once enough samples have been added.
+    //
+    psWidget->ui16Samples++;
+    if(psWidget->ui16Samples >= psWidget->ui16Decimation)
+    {
+        TrendChartAdvance(psWidget);
+    }
+}
+
+//*****************************************************************************
+//
+//! Clears a trend chart.
+//!
+//! \param psWidget is a pointer to the trend chart widget.
+//!
+//! This function removes all of the samples from the trend chart, leaving
+//! only the background and grid, and discards any samples which have not yet
+//! been drawn.  The chart is redrawn on the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TrendChartClear(tTrendChartWidget *psWidget)
+{
+    tTrendChartSeries *psSeries;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+
+    //
+    // Discard the samples of each series.
+    //
+    for(psSeries = psWidget->psSeries; psSeries; psSeries = psSeries->psNext)
+    {
+        psSeries->i32Min = 1;
+        psSeries->i32Max = 0;
+    }
+    psWidget->ui16Samples = 0;
+    psWidget->ui16GridCount = 0;
+
+    //
+    // Redraw the off-screen display, if there is one, and the display.
+    //
+    psWidget->ui32Flags &= ~FLAG_OFFSCREEN_DRAWN;
+    TrendChartPaint((tWidget *)psWidget, &(psWidget->sBase.sPosition));
+}
+
+//*****************************************************************************
+//
+//! Adds a data series to a trend chart.
+//!
+//! \param psWidget is a pointer to the trend chart widget.
+//! \param psSeries is a pointer to the series to be added.
+//!
+//! This function adds a data series to the end of the list of series shown
+//! on the trend chart.  Only the color of the series needs to be set before
+//! it is added; the series has no samples until the next call to
+//! TrendChartSampleAdd().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TrendChartSeriesAdd(tTrendChartWidget *psWidget, tTrendChartSeries *psSeries)
+{
+    tTrendChartSeries **ppsLink;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+    ASSERT(psSeries);
+
+    //
+    // The series has no samples yet.
+    //
+    psSeries->psNext = 0;
+    psSeries->i32Min = 1;
+    psSeries->i32Max = 0;
+
+    //
+    // Link the series to the end of the list.
+    //
+    for(ppsLink = &(psWidget->psSeries); *ppsLink;
+        ppsLink = &((*ppsLink)->psNext))
+    {
+    }
+    *ppsLink = psSeries;
+}
+
+//*****************************************************************************
+//
+//! Removes a data series from a trend chart.
+//!
+//! \param psWidget is a pointer to the trend chart widget.
+//! \param psSeries is a pointer to the series to be removed.
+//!
+//! This function removes a data series from the trend chart.  The columns
+//! already drawn for it remain until they scroll off the chart.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TrendChartSeriesRemove(tTrendChartWidget *psWidget,
+                       tTrendChartSeries *psSeries)
+{
+    tTrendChartSeries **ppsLink;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+    ASSERT(psSeries);
+
+    //
+    // Find the series in the list and unlink it.
+    //
+    for(ppsLink = &(psWidget->psSeries); *ppsLink;
+        ppsLink = &((*ppsLink)->psNext))
+    {
+        if(*ppsLink == psSeries)
+        {
+            *ppsLink = psSeries->psNext;
+            break;
+        }
+    }
+    psSeries->psNext = 0;
+}
+
+//*****************************************************************************
+//
+//! Handles messages for a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget.
+//! \param ui32Msg is the message.
+//! \param ui32Param1 is the first parameter to the message.
+//! \param ui32Param2 is the second parameter to the message.
+//!
+//! This function receives messages intended for this trend chart widget and
+//! processes them accordingly.  The processing of the message varies based on
+//! the message in question.
+//!
+//! Unrecognized messages are handled by calling WidgetDefaultMsgProc().
+//!
+//! \return Returns a value appropriate to the supplied message.
+//
+//*****************************************************************************
+int32_t
+TrendChartMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
+                  uint32_t ui32Param2)
+{
+    tRectangle sClip;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+
+    //
+    // Determine which message is being sent.
+    //
+    switch(ui32Msg)
+    {
+        //
+        // The widget paint request has been sent.
+        //
+        case WIDGET_MSG_PAINT:
+        {
+            //
+            // Handle the widget paint request, limited to the region being
+            // repainted.
+            //
+            if(WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2, &sClip))
+            {
+                TrendChartPaint(psWidget, &sClip);
+            }
+
+            //
+            // Return one to indicate that the message was successfully
+            // processed.
+            //
+            return(1);
+        }
+
+        //
+        // An unknown request has been sent.
+        //
+        default:
+        {
+            //
+            // Let the default message handler process this message.
+            //
+            return(WidgetDefaultMsgProc(psWidget, ui32Msg, ui32Param1,
+                                        ui32Param2));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget to initialize.
+//! \param psDisplay is a pointer to the display on which to draw the chart.
+//! \param i32X is the X coordinate of the upper left corner of the chart.
+//! \param i32Y is the Y coordinate of the upper left corner of the chart.
+//! \param i32Width is the width of the chart.
+//! \param i32Height is the height of the chart.
+//! \param psOffscreen is a pointer to an off-screen display, the same size as
+//! the chart, which holds a copy of the chart, or 0 for none.
+//!
+//! This function initializes the provided trend chart widget.  The chart has
+//! a black background, a gray grid, a range of values from 0 to 100 with no
+//! grid lines, and shows one sample in each column; these can be changed with
+//! the TrendChartXxxSet() macros.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TrendChartInit(tTrendChartWidget *psWidget, const tDisplay *psDisplay,
+               int32_t i32X, int32_t i32Y, int32_t i32Width,
+               int32_t i32Height, const tDisplay *psOffscreen)
+{
+    uint32_t ui32Idx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+    ASSERT(psDisplay);
+
+    //
+    // Clear out the widget structure.
+    //
+    for(ui32Idx = 0; ui32Idx < sizeof(tTrendChartWidget); ui32Idx += 4)
+    {
+        ((uint32_t *)psWidget)[ui32Idx / 4] = 0;
+    }
+
+    //
+    // Set the size of the trend chart widget structure.
+    //
+    psWidget->sBase.i32Size = sizeof(tTrendChartWidget);
+
+    //
+    // Mark this widget as fully disconnected.
+    //
+    psWidget->sBase.psParent = 0;
+    psWidget->sBase.psNext = 0;
+    psWidget->sBase.psChild = 0;
+
+    //
+    // Save the display pointer.
+    //
+    psWidget->sBase.psDisplay = psDisplay;
+
+    //
+    // Set the extents of this trend chart.
+    //
+    psWidget->sBase.sPosition.i16XMin = i32X;
+    psWidget->sBase.sPosition.i16YMin = i32Y;
+    psWidget->sBase.sPosition.i16XMax = i32X + i32Width - 1;
+    psWidget->sBase.sPosition.i16YMax = i32Y + i32Height - 1;
+
+    //
+    // Set the default appearance of the chart.
+    //
+    psWidget->psOffscreen = psOffscreen;
+    psWidget->ui32BackgroundColor = ClrBlack;
+    psWidget->ui32GridColor = ClrGray;
+    psWidget->i32ValueMax = 100;
+    psWidget->ui16Decimation = 1;
+
+    //
+    // Use the trend chart message handler to process messages to this
+    // widget.
+    //
+    psWidget->sBase.pfnMsgProc = TrendChartMsgProc;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,440 @@
+//*****************************************************************************
+//
+// trendchart.h - Prototypes for the trend chart widget.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+
+#ifndef __TRENDCHART_H__
+#define __TRENDCHART_H__
+
+//*****************************************************************************
+//
+//! \addtogroup trendchart_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! The structure that describes a data series shown on a trend chart.
+//
+//*****************************************************************************
+typedef struct _TrendChartSeries
+{
+    //
+    //! A pointer to the next series on the chart.  This is maintained by
+    //! TrendChartSeriesAdd() and TrendChartSeriesRemove().
+    //
+    struct _TrendChartSeries *psNext;
+
+    //
+    //! The 24-bit RGB color used to draw the series.
+    //
+    uint32_t ui32Color;
+
+    //
+    //! The smallest value added since the last column was drawn.  This is
+    //! maintained by the trend chart.
+    //
+    int32_t i32Min;
+
+    //
+    //! The largest value added since the last column was drawn.  This is
+    //! maintained by the trend chart.
+    //
+    int32_t i32Max;
+
+    //
+    //! The most recent value added.  This is maintained by the trend chart.
+    //
+    int32_t i32Last;
+}
+tTrendChartSeries;
+
+//*****************************************************************************
+//
+//! The structure that describes a trend chart widget.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The generic widget information.
+    //
+    tWidget sBase;
+
+    //
+    //! A pointer to an off-screen display, the same size as the widget, which
+    //! holds a copy of the chart so that it can be repainted, or 0 if the
+    //! chart is only drawn on the widget's display.
+    //
+    const tDisplay *psOffscreen;
+
+    //
+    //! The 24-bit RGB color used as the background for the chart.
+    //
+    uint32_t ui32BackgroundColor;
+
+    //
+    //! The 24-bit RGB color used to draw the grid.
+    //
+    uint32_t ui32GridColor;
+
+    //
+    //! The value shown at the bottom of the chart.
+    //
+    int32_t i32ValueMin;
+
+    //
+    //! The value shown at the top of the chart.
+    //
+    int32_t i32ValueMax;
+
+    //
+    //! The spacing of the horizontal grid lines, in the same units as the
+    //! values, or 0 for no horizontal grid lines.  A grid line is drawn at
+    //! each multiple of this spacing.
+    //
+    int32_t i32GridValue;
+
+    //
+    //! The number of columns between the vertical grid lines, or 0 for no
+    //! vertical grid lines.  The vertical grid lines scroll with the data.
+    //
+    uint16_t ui16GridColumns;
+
+    //
+    //! The number of samples shown in each column of the chart.  When this is
+    //! more than one, each column shows the range of the samples within it.
+    //
+    uint16_t ui16Decimation;
+
+    //
+    //! A pointer to the first data series on the chart.
+    //
+    tTrendChartSeries *psSeries;
+
+    //
+    //! The number of samples added since the last column was drawn.
+    //
+    uint16_t ui16Samples;
+
+    //
+    //! The number of columns drawn since the last vertical grid line.
+    //
+    uint16_t ui16GridCount;
+
+    //
+    //! Internal state flags for the chart.
+    //
+    uint32_t ui32Flags;
+}
+tTrendChartWidget;
+
+//*****************************************************************************
+//
+//! Declares an initialized trend chart widget data structure.
+//!
+//! \param psParent is a pointer to the parent widget.
+//! \param psNext is a pointer to the sibling widget.
+//! \param psChild is a pointer to the first child widget.
+//! \param psDisplay is a pointer to the display on which to draw the chart.
+//! \param i32X is the X coordinate of the upper left corner of the chart.
+//! \param i32Y is the Y coordinate of the upper left corner of the chart.
+//! \param i32Width is the width of the chart.
+//! \param i32Height is the height of the chart.
+//! \param psOffscreen is a pointer to an off-screen display, the same size as
+//! the chart, which holds a copy of the chart, or 0 for none.
+//! \param ui32BackgroundColor is the background color of the chart.
+//! \param ui32GridColor is the color of the grid.
+//! \param i32ValueMin is the value shown at the bottom of the chart.
+//! \param i32ValueMax is the value shown at the top of the chart.
+//! \param i32GridValue is the spacing of the horizontal grid lines, or 0 for
+//! none.
+//! \param ui16GridColumns is the number of columns between the vertical grid
+//! lines, or 0 for none.
+//! \param ui16Decimation is the number of samples shown in each column.
+//!
+//! This macro provides an initialized trend chart widget data structure,
+//! which can be used to construct the widget tree at compile time in global
+//! variables (as opposed to run-time via function calls).  This must be
+//! assigned to a variable, such as:
+//!
+//! \verbatim
+//!     tTrendChartWidget g_sTrendChart = TrendChartStruct(...);
+//! \endverbatim
+//!
+//! Or, in an array of variables:
+//!
+//! \verbatim
+//!     tTrendChartWidget g_psTrendCharts[] =
+//!     {
+//!         TrendChartStruct(...),
+//!         TrendChartStruct(...)
+//!     };
+//! \endverbatim
+//!
+//! \return Nothing; this is not a function.
+//
+//*****************************************************************************
+#define TrendChartStruct(psParent, psNext, psChild, psDisplay, i32X, i32Y,    \
+                         i32Width, i32Height, psOffscreen,                    \
+                         ui32BackgroundColor, ui32GridColor, i32ValueMin,     \
+                         i32ValueMax, i32GridValue, ui16GridColumns,          \
+                         ui16Decimation)                                      \
+        {                                                                     \
+            {                                                                 \
+                sizeof(tTrendChartWidget),                                    \
+                (tWidget *)(psParent),                                        \
+                (tWidget *)(psNext),                                          \
+                (tWidget *)(psChild),                                         \
+                psDisplay,                                                    \
+                {                                                             \
+                    i32X,                                                     \
+                    i32Y,                                                     \
+                    (i32X) + (i32Width) - 1,                                  \
+                    (i32Y) + (i32Height) - 1                                  \
+                },                                                            \
+                TrendChartMsgProc                                             \
+            },                                                                \
+            psOffscreen,                                                      \
+            ui32BackgroundColor,                                              \
+            ui32GridColor,                                                    \
+            i32ValueMin,                                                      \
+            i32ValueMax,                                                      \
+            i32GridValue,                                                     \
+            ui16GridColumns,                                                  \
+            ui16Decimation,                                                   \
+            0,                                                                \
+            0,                                                                \
+            0,                                                                \
+            0                                                                 \
+        }
+
+//*****************************************************************************
+//
+//! Declares an initialized variable containing a trend chart widget data
+//! structure.
+//!
+//! \param sName is the name of the variable to be declared.
+//! \param psParent is a pointer to the parent widget.
+//! \param psNext is a pointer to the sibling widget.
+//! \param psChild is a pointer to the first child widget.
+//! \param psDisplay is a pointer to the display on which to draw the chart.
+//! \param i32X is the X coordinate of the upper left corner of the chart.
+//! \param i32Y is the Y coordinate of the upper left corner of the chart.
+//! \param i32Width is the width of the chart.
+//! \param i32Height is the height of the chart.
+//! \param psOffscreen is a pointer to an off-screen display, the same size as
+//! the chart, which holds a copy of the chart, or 0 for none.
+//! \param ui32BackgroundColor is the background color of the chart.
+//! \param ui32GridColor is the color of the grid.
+//! \param i32ValueMin is the value shown at the bottom of the chart.
+//! \param i32ValueMax is the value shown at the top of the chart.
+//! \param i32GridValue is the spacing of the horizontal grid lines, or 0 for
+//! none.
+//! \param ui16GridColumns is the number of columns between the vertical grid
+//! lines, or 0 for none.
+//! \param ui16Decimation is the number of samples shown in each column.
+//!
+//! This macro declares a variable containing an initialized trend chart
+//! widget data structure, which can be used to construct the widget tree at
+//! compile time in global variables (as opposed to run-time via function
+//! calls).
+//!
+//! \return Nothing; this is not a function.
+//
+//*****************************************************************************
+#define TrendChart(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y,   \
+                   i32Width, i32Height, psOffscreen, ui32BackgroundColor,     \
+                   ui32GridColor, i32ValueMin, i32ValueMax, i32GridValue,     \
+                   ui16GridColumns, ui16Decimation)                           \
+        tTrendChartWidget sName =                                             \
+            TrendChartStruct(psParent, psNext, psChild, psDisplay, i32X,      \
+                             i32Y, i32Width, i32Height, psOffscreen,          \
+                             ui32BackgroundColor, ui32GridColor, i32ValueMin, \
+                             i32ValueMax, i32GridValue, ui16GridColumns,      \
+                             ui16Decimation)
+
+//*****************************************************************************
+//
+//! Sets the background color of a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget to be modified.
+//! \param ui32Color is the 24-bit RGB color to use for the background.
+//!
+//! This function changes the color used for the background of the chart.
+//! Columns already drawn are unchanged until TrendChartClear() is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define TrendChartBackgroundColorSet(psWidget, ui32Color)                     \
+        do                                                                    \
+        {                                                                     \
+            tTrendChartWidget *psW = psWidget;                                \
+            psW->ui32BackgroundColor = ui32Color;                             \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+//! Sets the grid color of a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget to be modified.
+//! \param ui32Color is the 24-bit RGB color to use for the grid.
+//!
+//! This function changes the color used for the grid of the chart.  Columns
+//! already drawn are unchanged until TrendChartClear() is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define TrendChartGridColorSet(psWidget, ui32Color)                           \
+        do                                                                    \
+        {                                                                     \
+            tTrendChartWidget *psW = psWidget;                                \
+            psW->ui32GridColor = ui32Color;                                   \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+//! Sets the range of values shown on a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget to be modified.
+//! \param i32Min is the value shown at the bottom of the chart.
+//! \param i32Max is the value shown at the top of the chart.
+//!
+//! This function changes the range of values shown on the chart.  Values
+//! outside of the range are drawn at the top or bottom of the chart.  Columns
+//! already drawn are unchanged until TrendChartClear() is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define TrendChartRangeSet(psWidget, i32Min, i32Max)                          \
+        do                                                                    \
+        {                                                                     \
+            tTrendChartWidget *psW = psWidget;                                \
+            psW->i32ValueMin = i32Min;                                        \
+            psW->i32ValueMax = i32Max;                                        \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+//! Sets the grid of a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget to be modified.
+//! \param i32Value is the spacing of the horizontal grid lines, in the same
+//! units as the values, or 0 for no horizontal grid lines.
+//! \param ui16Columns is the number of columns between the vertical grid
+//! lines, or 0 for no vertical grid lines.
+//!
+//! This function changes the grid drawn behind the data.  Columns already
+//! drawn are unchanged until TrendChartClear() is called.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define TrendChartGridSet(psWidget, i32Value, ui16Columns)                    \
+        do                                                                    \
+        {                                                                     \
+            tTrendChartWidget *psW = psWidget;                                \
+            psW->i32GridValue = i32Value;                                     \
+            psW->ui16GridColumns = ui16Columns;                               \
+            psW->ui16GridCount = 0;                                           \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+//! Sets the number of samples shown in each column of a trend chart widget.
+//!
+//! \param psWidget is a pointer to the trend chart widget to be modified.
+//! \param ui16Samples is the number of samples shown in each column.
+//!
+//! This function changes the number of samples added with
+//! TrendChartSampleAdd() for each column drawn.  When more than one sample
+//! is shown in a column, the column shows the range of those samples, so
+//! that short peaks are not lost at high sample rates.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#define TrendChartDecimationSet(psWidget, ui16Samples)                        \
+        do                                                                    \
+        {                                                                     \
+            tTrendChartWidget *psW = psWidget;                                \
+            psW->ui16Decimation = ui16Samples;                                \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+// Prototypes for the trend chart widget APIs.
+//
+//*****************************************************************************
+extern int32_t TrendChartMsgProc(tWidget *psWidget, uint32_t ui32Msg,
+                                 uint32_t ui32Param1, uint32_t ui32Param2);
+extern void TrendChartInit(tTrendChartWidget *psWidget,
+                           const tDisplay *psDisplay, int32_t i32X,
+                           int32_t i32Y, int32_t i32Width, int32_t i32Height,
+                           const tDisplay *psOffscreen);
+extern void TrendChartSeriesAdd(tTrendChartWidget *psWidget,
+                                tTrendChartSeries *psSeries);
+extern void TrendChartSeriesRemove(tTrendChartWidget *psWidget,
+                                   tTrendChartSeries *psSeries);
+extern void TrendChartSampleAdd(tTrendChartWidget *psWidget,
+                                const int32_t *pi32Values);
+extern void TrendChartAdvance(tTrendChartWidget *psWidget);
+extern void TrendChartClear(tTrendChartWidget *psWidget);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+#endif // __TRENDCHART_H__
@@ -47,35 +47,80 @@
 
 //*****************************************************************************
 //
-// The size of the message queue.  In order to make the queue pointer
-// arithmetic more efficient, this should be a power of two.
+// The message queue offsets are free-running counters which are masked to
+// find the entry in the queue, so the queue size must be a power of two.  It
+// must also be at least four, so that the states of an entry (below) are not
+// confused with the free state of the entry on the next pass around the queue.
 //
 //*****************************************************************************
-#define QUEUE_SIZE              16
+#if ((WIDGET_MSG_QUEUE_SIZE < 4) ||                                           \
+     ((WIDGET_MSG_QUEUE_SIZE & (WIDGET_MSG_QUEUE_SIZE - 1)) != 0))
+#error "WIDGET_MSG_QUEUE_SIZE must be a power of two and at least four!"
+#endif
 
-#ifdef DEBUG_MSGQ
 //*****************************************************************************
 //
-// In debug builds, keep track of the number of cases where a message was
-// lost due to the queue being full.  We count the following occurrences:
+// The states of an entry in the message queue.  An entry is free until a
+// producer has written a message into it, at which point it is ready.  It is
+// busy while the message is being read by WidgetMessageQueueProcess() or
+// updated by a producer that is coalescing a message with it.
+//
+//*****************************************************************************
+#define MQ_STATE_FREE           0
+#define MQ_STATE_READY          1
+#define MQ_STATE_BUSY           2
+
+//*****************************************************************************
 //
-// 1. All messages discarded due to queue overflow (g_ui32MQOverflow)
-// 2. Messages other than WIDGET_MSG_PTR_MOVE discarded due to queue
-//    overflow (g_ui32MQNonMouseOverflow).  In this case, we also remember the
-//    last message that was discarded (g_ui32MQLastLostMsg).
-// 3. The number of calls to WidgetMessageQueueAdd that fail due to the queue
-//    mutex already being held.
-// 4. The number of cases where WidgetMessageQueueAdd reused an unread
-//    WIDGET_MSG_PTR_MOVE message when a second one arrived before the previous
-//    one had been processed.
+// Computes the sequence value of an entry in the message queue, given the
+// offset of the message in the queue and the state of the entry.  Including
+// the pass around the queue (the upper bits of the offset) in the sequence
+// value allows a producer or the consumer to detect that an entry has been
+// reused while it was being examined.
 //
 //*****************************************************************************
-uint32_t g_ui32MQOverflow = 0;
-uint32_t g_ui32MQNonMouseOverflow = 0;
-uint32_t g_ui32MQLastLostMsg = 0;
-uint32_t g_ui32MQMutexClash = 0;
-uint32_t g_ui32MQMoveOverwrite = 0;
-#endif
+#define MQ_SEQ(ui32Offset, ui32State)                                         \
+        (((ui32Offset) & ~(WIDGET_MSG_QUEUE_SIZE - 1)) + (ui32State))
+
+//*****************************************************************************
+//
+// Returns a pointer to the message queue entry for a given offset.
+//
+//*****************************************************************************
+#define MQ_ENTRY(ui32Offset)                                                  \
+        (&(g_psMQ[(ui32Offset) & (WIDGET_MSG_QUEUE_SIZE - 1)]))
+
+//*****************************************************************************
+//
+// Macros to pack a pair of display coordinates into a single paint message
+// parameter, and to extract them again.  The coordinates are stored as 16-bit
+// values, with the X coordinate in the lower half and the Y coordinate in the
+// upper half.  The bottom right corner of a region is stored with one added
+// to each coordinate, so that the parameters of a region can never both be
+// zero (which requests a paint of the whole widget), even for the single
+// pixel region at the origin.
+//
+//*****************************************************************************
+#define PAINT_PARAM(i16X, i16Y)                                               \
+        (((uint32_t)(uint16_t)(i16X)) | ((uint32_t)(uint16_t)(i16Y) << 16))
+#define PAINT_PARAM_X(ui32Param)                                              \
+        ((int16_t)((ui32Param) & 0xffff))
+#define PAINT_PARAM_Y(ui32Param)                                              \
+        ((int16_t)((ui32Param) >> 16))
+#define PAINT_PARAM_END(i16X, i16Y)                                           \
+        PAINT_PARAM((i16X) + 1, (i16Y) + 1)
+#define PAINT_PARAM_END_X(ui32Param)                                          \
+        ((int16_t)(((ui32Param) - 1) & 0xffff))
+#define PAINT_PARAM_END_Y(ui32Param)                                          \
+        ((int16_t)((((ui32Param) >> 16) - 1) & 0xffff))
+
+//*****************************************************************************
+//
+// Macros to return the smaller or larger of two values.
+//
+//*****************************************************************************
+#define WidgetMin(a, b)         (((a) < (b)) ? (a) : (b))
+#define WidgetMax(a, b)         (((a) > (b)) ? (a) : (b))
 
 //*****************************************************************************
 //
@@ -84,6 +129,12 @@ uint32_t g_ui32MQMoveOverwrite = 0;
 //*****************************************************************************
 typedef struct
 {
+    //
+    // The sequence value of this entry, which indicates the state of the
+    // entry; this is computed by the MQ_SEQ macro.
+    //
+    uint32_t ui32Seq;
+
     //
     // The flags that describe how this message should be processed; this is
     // defined by the MQ_FLAG_xxx flags.
@@ -150,34 +201,71 @@ static tWidget *g_psPointerWidget = 0;
 //*****************************************************************************
 //
 // The message queue that holds messages that are waiting to be processed.
+// Messages are added by any number of producers (which may interrupt one
+// another) and removed by WidgetMessageQueueProcess(), without the use of a
+// mutex.  A producer reserves an entry by advancing g_ui32MQWrite, writes the
+// message into it, then marks it as ready by updating its sequence value.
 //
 //*****************************************************************************
-static volatile tWidgetMessageQueue g_psMQ[QUEUE_SIZE];
+static volatile tWidgetMessageQueue g_psMQ[WIDGET_MSG_QUEUE_SIZE];
 
 //*****************************************************************************
 //
-// The offset to the next message to be read from the message queue.  The
-// message queue is empty when this has the same value as g_ui32MQWrite.
+// The offset of the next message to be read from the message queue.  The
+// message queue is empty when this has the same value as g_ui32MQWrite.  This
+// is only modified by WidgetMessageQueueProcess().
 //
 //*****************************************************************************
-static uint32_t g_ui32MQRead = 0;
+static volatile uint32_t g_ui32MQRead = 0;
 
 //*****************************************************************************
 //
-// The offset to the next message to be written to the message queue.  The
-// message queue is full when this value is one less than g_ui32MQRead (modulo
-// the queue size).
+// The offset of the next entry to be reserved in the message queue.  The
+// message queue is full when this is the queue size more than g_ui32MQRead.
 //
 //*****************************************************************************
 static volatile uint32_t g_ui32MQWrite = 0;
 
 //*****************************************************************************
 //
-// The mutex used to protect access to the message queue.
+// The statistics kept for the message queue.
+//
+//*****************************************************************************
+static volatile tWidgetMessageQueueStats g_sMQStats;
+
+//*****************************************************************************
+//
+// The messages for which the application has set a coalescing rule, the rule
+// for each, and the number of rules that have been set.
+//
+//*****************************************************************************
+static volatile uint32_t g_pui32CoalesceMsg[WIDGET_NUM_COALESCE_RULES];
+static volatile uint8_t g_pui8CoalesceRule[WIDGET_NUM_COALESCE_RULES];
+static volatile uint32_t g_ui32NumCoalesceRules = 0;
+
+//*****************************************************************************
+//
+// The mutex used to protect access to the list of invalidated regions.
 //
 //*****************************************************************************
 static uint8_t g_ui8MQMutex = 0;
 
+//*****************************************************************************
+//
+// The regions of the display that have been invalidated by WidgetInvalidate()
+// and are waiting to be repainted by WidgetMessageQueueProcess().  These are
+// protected by g_ui8MQMutex.
+//
+//*****************************************************************************
+static tRectangle g_psDamage[WIDGET_NUM_DAMAGE_RECTS];
+
+//*****************************************************************************
+//
+// The number of valid entries in g_psDamage.
+//
+//*****************************************************************************
+static volatile uint32_t g_ui32NumDamage = 0;
+
 //*****************************************************************************
 //
 //! Initializes a mutex to the unowned state.
@@ -340,6 +428,162 @@ WidgetMutexPut(uint8_t *pi8Mutex)
     *pi8Mutex = 0;
 }
 
+//*****************************************************************************
+//
+//! Atomically replaces a value if it has not been changed.
+//!
+//! \param pui32Value is a pointer to the value to be replaced.
+//! \param ui32Compare is the value that \e pui32Value is expected to hold.
+//! \param ui32Swap is the new value to be stored.
+//!
+//! This function stores \e ui32Swap into the location pointed to by
+//! \e pui32Value if, and only if, that location holds \e ui32Compare, as a
+//! single operation with respect to other contexts (such as interrupt
+//! handlers) which may modify the location.  This is used by the widget
+//! message queue to allow messages to be added from several contexts without
+//! a mutex.
+//!
+//! The store is not made, and non-zero is returned, if the location does not
+//! hold \e ui32Compare or if the operation is interrupted by another access to
+//! the location; the caller must check the location again to tell these
+//! apart.
+//!
+//! \return Returns 0 if the value was replaced and non-zero if it was not.
+//
+//*****************************************************************************
+#if defined(ewarm) || defined(DOXYGEN)
+uint32_t
+WidgetCompareSwap(volatile uint32_t *pui32Value, uint32_t ui32Compare,
+                  uint32_t ui32Swap)
+{
+    //
+    // Replace the value if it matches.
+    //
+    __asm("    ldrex   r3, [r0]\n"
+          "    subs    r3, r3, r1\n"
+          "    it      eq\n"
+          "    strexeq r3, r2, [r0]\n"
+          "    mov     r0, r3\n");
+
+    //
+    // "Warning[Pe940]: missing return statement at end of non-void function"
+    // is suppressed here to avoid putting a "bx lr" in the inline assembly
+    // above and a superfluous return statement here.
+    //
+#pragma diag_suppress=Pe940
+}
+#pragma diag_default=Pe940
+#endif
+#if defined(codered) || defined(gcc) || defined(sourcerygxx)
+uint32_t __attribute__((naked))
+WidgetCompareSwap(volatile uint32_t *pui32Value, uint32_t ui32Compare,
+                  uint32_t ui32Swap)
+{
+    uint32_t ui32Ret;
+
+    //
+    // Replace the value if it matches.
+    //
+    __asm("    ldrex    r3, [r0]\n"
+          "    subs     r3, r3, r1\n"
+          "    it       eq\n"
+          "    strexeq  r3, r2, [r0]\n"
+          "    mov      r0, r3\n"
+          "    bx       lr\n"
+          : "=r" (ui32Ret));
+
+    //
+    // The return is handled in the inline assembly, but the compiler will
+    // still complain if there is not an explicit return here (despite the fact
+    // that this does not result in any code being produced because of the
+    // naked attribute).
+    //
+    return(ui32Ret);
+}
+#endif
+#if defined(rvmdk) || defined(__ARMCC_VERSION)
+__asm uint32_t
+WidgetCompareSwap(volatile uint32_t *pui32Value, uint32_t ui32Compare,
+                  uint32_t ui32Swap)
+{
+    ldrex       r3, [r0]
+    subs        r3, r3, r1
+    it          eq
+    strexeq     r3, r2, [r0]
+    mov         r0, r3
+    bx          lr
+}
+#endif
+//
+// For CCS implement this function in pure assembly.  This prevents the TI
+// compiler from doing funny things with the optimizer.
+//
+#if defined(ccs)
+    __asm("    .sect \".text:WidgetCompareSwap\"\n"
+          "    .clink\n"
+          "    .thumbfunc WidgetCompareSwap\n"
+          "    .thumb\n"
+          "    .global WidgetCompareSwap\n"
+          "WidgetCompareSwap:\n"
+          "    ldrex       r3, [r0]\n"
+          "    subs        r3, r3, r1\n"
+          "    it          EQ\n" // TI assembler requires upper case cond
+          "    strexeq     r3, r2, [r0]\n"
+          "    mov         r0, r3\n"
+          "    bx          lr\n");
+#endif
+
+//*****************************************************************************
+//
+// Atomically replaces a value if it has not been changed.
+//
+// \param pui32Value is a pointer to the value to be replaced.
+// \param ui32Old is the value that \e pui32Value is expected to hold.
+// \param ui32New is the new value to be stored.
+//
+// This function uses WidgetCompareSwap() to replace a value, retrying if the
+// replacement was interrupted but the value still holds \e ui32Old.
+//
+// \return Returns \b true if the value was replaced and \b false if it did
+// not hold \e ui32Old.
+//
+//*****************************************************************************
+static bool
+WidgetAtomicUpdate(volatile uint32_t *pui32Value, uint32_t ui32Old,
+                   uint32_t ui32New)
+{
+    while(*pui32Value == ui32Old)
+    {
+        if(WidgetCompareSwap(pui32Value, ui32Old, ui32New) == 0)
+        {
+            return(true);
+        }
+    }
+
+    return(false);
+}
+
+//*****************************************************************************
+//
+// Atomically increments a message queue statistic.
+//
+// \param pui32Stat is a pointer to the statistic to be incremented.
+//
+// \return None.
+//
+//*****************************************************************************
+static void
+WidgetStatIncrement(volatile uint32_t *pui32Stat)
+{
+    uint32_t ui32Value;
+
+    do
+    {
+        ui32Value = *pui32Stat;
+    }
+    while(!WidgetAtomicUpdate(pui32Stat, ui32Value, ui32Value + 1));
+}
+
 //*****************************************************************************
 //
 // Determines if a widget exists in the tree below a given point.
@@ -970,226 +1214,1012 @@ WidgetMessageSendPostOrder(tWidget *psWidget, uint32_t ui32Message,
 
 //*****************************************************************************
 //
-//! Adds a message to the widget message queue.
-//!
-//! \param psWidget is the widget to which the message should be sent.
-//! \param ui32Message is the message to be sent.
-//! \param ui32Param1 is the first parameter to the message.
-//! \param ui32Param2 is the second parameter to the message.
-//! \param bPostOrder is \b true if the message should be sent via a post-order
-//! search, and \b false if it should be sent via a pre-order search.
-//! \param bStopOnSuccess is \b true if the message should be sent to widgets
-//! until one returns success, and \b false if it should be sent to all
-//! widgets.
-//!
-//! This function places a widget message into the message queue for later
-//! processing.  The messages are removed from the queue by
-//! WidgetMessageQueueProcess() and sent to the appropriate place.
-//!
-//! It is safe for code which interrupts WidgetMessageQueueProcess() (or called
-//! by it) to call this function to send a message.  It is not safe for code
-//! which interrupts this function to call this function as well; it is up to
-//! the caller to guarantee that the later sequence never occurs.
-//!
-//! \return Returns 1 if the message was added to the queue, and 0 if it could
-//! not be added since either the queue is full or another context is currently
-//! adding a message to the queue.
+// Determines the coalescing rule for a message.
+//
+// \param ui32Message is the message.
+//
+// This function returns the rule set for a message by
+// WidgetMessageCoalesceSet(), or the default rule for the message if none has
+// been set.
+//
+// \return Returns the coalescing rule, which is one of
+// \b WIDGET_COALESCE_NONE, \b WIDGET_COALESCE_DROP, or
+// \b WIDGET_COALESCE_REPLACE.
 //
 //*****************************************************************************
-int32_t
-WidgetMessageQueueAdd(tWidget *psWidget, uint32_t ui32Message,
-                      uint32_t ui32Param1, uint32_t ui32Param2,
-                      bool bPostOrder, bool bStopOnSuccess)
+static uint32_t
+WidgetCoalesceRuleGet(uint32_t ui32Message)
 {
-    uint32_t ui32Next;
-    uint32_t ui32Owned;
+    uint32_t ui32Idx;
 
     //
-    // Check the arguments.
+    // See if the application has set a rule for this message.
     //
-    ASSERT(psWidget);
+    for(ui32Idx = 0; ui32Idx < g_ui32NumCoalesceRules; ui32Idx++)
+    {
+        if(g_pui32CoalesceMsg[ui32Idx] == ui32Message)
+        {
+            return(g_pui8CoalesceRule[ui32Idx]);
+        }
+    }
 
     //
-    // Get the mutex we use to protect access to the message queue.
+    // Paint requests are discarded if the widget is already waiting to be
+    // painted, and only the most recent pointer position is needed.
     //
-    ui32Owned = WidgetMutexGet(&g_ui8MQMutex);
-    if(ui32Owned)
+    if(ui32Message == WIDGET_MSG_PAINT)
     {
-        //
-        // The mutex is already being held by some other caller so return a
-        // failure.
-        //
-#ifdef DEBUG_MSGQ
-        g_ui32MQMutexClash++;
-#endif
-        return(0);
+        return(WIDGET_COALESCE_DROP);
+    }
+    if(ui32Message == WIDGET_MSG_PTR_MOVE)
+    {
+        return(WIDGET_COALESCE_REPLACE);
     }
 
     //
-    // Compute the next value for the write pointer.
+    // All other messages are queued.
     //
-    ui32Next = (g_ui32MQWrite + 1) % QUEUE_SIZE;
+    return(WIDGET_COALESCE_NONE);
+}
+
+//*****************************************************************************
+//
+// Determines if a message is already waiting in the message queue.
+//
+// \param psWidget is the widget to which the message is to be sent.
+// \param ui32Message is the message to be sent.
+// \param ui32Param1 is the first parameter to the message.
+// \param ui32Param2 is the second parameter to the message.
+// \param ui32Flags is the set of MQ_FLAG_xxx flags for the message.
+//
+// This function searches the message queue for a message identical to the
+// one given.  For a paint message, a full paint of a parent of the widget is
+// also considered a match since it paints the widget as well.  Each entry is
+// checked to still hold the same message after it is examined, so that an
+// entry that is read or reused while being examined is not matched.
+//
+// \return Returns \b true if a matching message is waiting in the queue and
+// \b false otherwise.
+//
+//*****************************************************************************
+static bool
+WidgetMessageQueueFind(tWidget *psWidget, uint32_t ui32Message,
+                       uint32_t ui32Param1, uint32_t ui32Param2,
+                       uint32_t ui32Flags)
+{
+    volatile tWidgetMessageQueue *psEntry;
+    uint32_t ui32Offset, ui32Seq;
+    tWidget *psTarget, *psParent;
+    bool bMatch;
 
     //
-    // If the queue is not empty, and this is a pointer move message, see if
-    // the previous message was also a move and, if so, replace the
-    // coordinates.  Without this, the message queue can very quickly overflow
-    // if the application is busy doing something while the user keeps pressing
-    // the display.
+    // Loop through the messages waiting in the queue.
     //
-    if(ui32Message == WIDGET_MSG_PTR_MOVE)
+    for(ui32Offset = g_ui32MQRead; ui32Offset != g_ui32MQWrite; ui32Offset++)
     {
         //
-        // Is the message queue empty?
+        // Skip this entry if it does not hold a message that is ready to be
+        // read, or if it is a different message.
         //
-        if(g_ui32MQRead != g_ui32MQWrite)
+        psEntry = MQ_ENTRY(ui32Offset);
+        ui32Seq = MQ_SEQ(ui32Offset, MQ_STATE_READY);
+        if((psEntry->ui32Seq != ui32Seq) ||
+           (psEntry->ui32Message != ui32Message) ||
+           (psEntry->ui32Flags != ui32Flags))
         {
-            //
-            // No - what is the index of the previous message?
-            //
-            ui32Owned = (g_ui32MQWrite == 0) ? (QUEUE_SIZE - 1) :
-                                               (g_ui32MQWrite - 1);
-
-            //
-            // Was this a pointer move message?
-            //
-            if(g_psMQ[g_ui32MQWrite].ui32Message == WIDGET_MSG_PTR_MOVE)
-            {
-                //
-                // Yes - overwrite this message with the new
-                // coordinate information.
-                //
-                g_psMQ[ui32Owned].ui32Param1 = ui32Param1;
-                g_psMQ[ui32Owned].ui32Param2 = ui32Param2;
-#ifdef DEBUG_MSGQ
-                g_ui32MQMoveOverwrite++;
-#endif
+            continue;
+        }
 
-                //
-                // Release the message queue mutex.
-                //
-                WidgetMutexPut(&g_ui8MQMutex);
+        //
+        // See if this message is for the same widget with the same
+        // parameters.
+        //
+        psTarget = psEntry->psWidget;
+        bMatch = ((psTarget == psWidget) &&
+                  (psEntry->ui32Param1 == ui32Param1) &&
+                  (psEntry->ui32Param2 == ui32Param2));
 
-                //
-                // Success.
-                //
-                return(1);
+        //
+        // A full paint of a parent of the widget also paints the widget.
+        //
+        if(!bMatch && (ui32Message == WIDGET_MSG_PAINT) &&
+           (psEntry->ui32Param1 == 0) && (psEntry->ui32Param2 == 0))
+        {
+            for(psParent = psWidget->psParent; psParent;
+                psParent = psParent->psParent)
+            {
+                if(psParent == psTarget)
+                {
+                    bMatch = true;
+                    break;
+                }
             }
         }
+
+        //
+        // The message is found if it matches and the entry still holds it.
+        //
+        if(bMatch && (psEntry->ui32Seq == ui32Seq))
+        {
+            return(true);
+        }
     }
 
     //
-    // Return a failure if the message queue is full.
+    // The message is not waiting in the queue.
     //
-    if(ui32Next == g_ui32MQRead)
-    {
-#ifdef DEBUG_MSGQ
-        g_ui32MQOverflow++;
-        if(ui32Message != WIDGET_MSG_PTR_MOVE)
-        {
-            g_ui32MQNonMouseOverflow++;
-            g_ui32MQLastLostMsg = ui32Message;
-        }
-#endif
-        //
-        // Release the message queue mutex.
-        //
-        WidgetMutexPut(&g_ui8MQMutex);
+    return(false);
+}
 
-        return(0);
-    }
+//*****************************************************************************
+//
+// Replaces the parameters of the most recent message in the message queue.
+//
+// \param psWidget is the widget to which the message is to be sent.
+// \param ui32Message is the message to be sent.
+// \param ui32Param1 is the first parameter to the message.
+// \param ui32Param2 is the second parameter to the message.
+// \param ui32Flags is the set of MQ_FLAG_xxx flags for the message.
+//
+// This function checks if the most recent message in the message queue is
+// the same message for the same widget and, if so, replaces its parameters.
+// The entry is marked as busy while it is checked and updated so that it is
+// not read in the meantime; if it is already being read (or is still being
+// written) then it is left alone.
+//
+// \return Returns \b true if the parameters were replaced and \b false
+// otherwise.
+//
+//*****************************************************************************
+static bool
+WidgetMessageQueueReplace(tWidget *psWidget, uint32_t ui32Message,
+                          uint32_t ui32Param1, uint32_t ui32Param2,
+                          uint32_t ui32Flags)
+{
+    volatile tWidgetMessageQueue *psEntry;
+    uint32_t ui32Write;
+    bool bMatch;
 
     //
-    // Write this message into the next location in the message queue.
+    // There is nothing to replace if the message queue is empty.
     //
-    g_psMQ[g_ui32MQWrite].ui32Flags = ((bPostOrder ? MQ_FLAG_POST_ORDER : 0) |
-                                  (bStopOnSuccess ? MQ_FLAG_STOP_ON_SUCCESS :
-                                   0));
-    g_psMQ[g_ui32MQWrite].psWidget = psWidget;
-    g_psMQ[g_ui32MQWrite].ui32Message = ui32Message;
-    g_psMQ[g_ui32MQWrite].ui32Param1 = ui32Param1;
-    g_psMQ[g_ui32MQWrite].ui32Param2 = ui32Param2;
+    ui32Write = g_ui32MQWrite;
+    if(ui32Write == g_ui32MQRead)
+    {
+        return(false);
+    }
 
     //
-    // Update the message queue write pointer.
+    // Claim the entry that holds the most recent message.
     //
-    g_ui32MQWrite = ui32Next;
+    psEntry = MQ_ENTRY(ui32Write - 1);
+    if(!WidgetAtomicUpdate(&(psEntry->ui32Seq),
+                           MQ_SEQ(ui32Write - 1, MQ_STATE_READY),
+                           MQ_SEQ(ui32Write - 1, MQ_STATE_BUSY)))
+    {
+        return(false);
+    }
 
     //
-    // Release the message queue mutex.
+    // Replace the parameters if this is the same message for the same widget,
+    // and no other message has been added since it was claimed.
     //
-    WidgetMutexPut(&g_ui8MQMutex);
+    bMatch = ((psEntry->psWidget == psWidget) &&
+              (psEntry->ui32Message == ui32Message) &&
+              (psEntry->ui32Flags == ui32Flags) &&
+              (g_ui32MQWrite == ui32Write));
+    if(bMatch)
+    {
+        psEntry->ui32Param1 = ui32Param1;
+        psEntry->ui32Param2 = ui32Param2;
+    }
 
     //
-    // Success.
+    // Release the entry.
     //
-    return(1);
+    psEntry->ui32Seq = MQ_SEQ(ui32Write - 1, MQ_STATE_READY);
+
+    return(bMatch);
 }
 
 //*****************************************************************************
 //
-//! Processes the messages in the widget message queue.
-//!
-//! This function extracts messages from the widget message queue one at a time
-//! and processes them.  If the processing of a widget message requires that a
-//! new message be sent, it is acceptable to call WidgetMessageQueueAdd().  It
-//! is also acceptable for code which interrupts this function to call
-//! WidgetMessageQueueAdd() to send more messages.  In both cases, the newly
-//! added message will also be processed before this function returns.
+//! Adds a message to the widget message queue.
 //!
-//! \return None.
-//
-//*****************************************************************************
-void
-WidgetMessageQueueProcess(void)
+//! \param psWidget is the widget to which the message should be sent.
+//! \param ui32Message is the message to be sent.
+//! \param ui32Param1 is the first parameter to the message.
+//! \param ui32Param2 is the second parameter to the message.
+//! \param bPostOrder is \b true if the message should be sent via a post-order
+//! search, and \b false if it should be sent via a pre-order search.
+//! \param bStopOnSuccess is \b true if the message should be sent to widgets
+//! until one returns success, and \b false if it should be sent to all
+//! widgets.
+//!
+//! This function places a widget message into the message queue for later
+//! processing.  The messages are removed from the queue by
+//! WidgetMessageQueueProcess() and sent to the appropriate place.
+//!
+//! Before the message is added, it may be coalesced with a message already in
+//! the queue according to the coalescing rule for the message (see
+//! WidgetMessageCoalesceSet()).  By default, a paint message is discarded if
+//! the same widget (or one of its parents) is already waiting to be painted,
+//! and a pointer move message replaces the coordinates of the most recent
+//! message if that is also a pointer move.
+//!
+//! The message queue does not use a mutex, so this function may be called
+//! from any context, including interrupt handlers which interrupt another
+//! call to this function or to WidgetMessageQueueProcess().
+//!
+//! \return Returns 1 if the message was added to the queue (or coalesced with
+//! a message already in the queue), and 0 if it could not be added since the
+//! queue is full.
+//
+//*****************************************************************************
+int32_t
+WidgetMessageQueueAdd(tWidget *psWidget, uint32_t ui32Message,
+                      uint32_t ui32Param1, uint32_t ui32Param2,
+                      bool bPostOrder, bool bStopOnSuccess)
+{
+    volatile tWidgetMessageQueue *psEntry;
+    uint32_t ui32Flags, ui32Rule, ui32Read, ui32Write, ui32Count;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+
+    //
+    // Determine the flags that describe how this message is to be processed.
+    //
+    ui32Flags = ((bPostOrder ? MQ_FLAG_POST_ORDER : 0) |
+                 (bStopOnSuccess ? MQ_FLAG_STOP_ON_SUCCESS : 0));
+
+    //
+    // See if this message can be coalesced with a message that is already in
+    // the queue.
+    //
+    ui32Rule = WidgetCoalesceRuleGet(ui32Message);
+    if(((ui32Rule == WIDGET_COALESCE_DROP) &&
+        WidgetMessageQueueFind(psWidget, ui32Message, ui32Param1, ui32Param2,
+                               ui32Flags)) ||
+       ((ui32Rule == WIDGET_COALESCE_REPLACE) &&
+        WidgetMessageQueueReplace(psWidget, ui32Message, ui32Param1,
+                                  ui32Param2, ui32Flags)))
+    {
+        WidgetStatIncrement(&(g_sMQStats.ui32Coalesced));
+        return(1);
+    }
+
+    //
+    // Reserve the next entry in the message queue.
+    //
+    while(1)
+    {
+        //
+        // Read the read offset before the write offset, so that the number of
+        // messages in the queue is never underestimated.
+        //
+        ui32Read = g_ui32MQRead;
+        ui32Write = g_ui32MQWrite;
+
+        //
+        // Try to reserve the entry if the queue is not full.  This fails if
+        // another producer reserves it first, in which case try again.
+        //
+        if((ui32Write - ui32Read) < WIDGET_MSG_QUEUE_SIZE)
+        {
+            if(WidgetAtomicUpdate(&g_ui32MQWrite, ui32Write, ui32Write + 1))
+            {
+                break;
+            }
+        }
+
+        //
+        // Otherwise, return a failure if the queue is still full.
+        //
+        else if(ui32Read == g_ui32MQRead)
+        {
+            WidgetStatIncrement(&(g_sMQStats.ui32Dropped));
+            g_sMQStats.ui32LastDropped = ui32Message;
+            return(0);
+        }
+    }
+
+    //
+    // Write this message into the reserved entry.
+    //
+    psEntry = MQ_ENTRY(ui32Write);
+    ASSERT(psEntry->ui32Seq == MQ_SEQ(ui32Write, MQ_STATE_FREE));
+    psEntry->ui32Flags = ui32Flags;
+    psEntry->psWidget = psWidget;
+    psEntry->ui32Message = ui32Message;
+    psEntry->ui32Param1 = ui32Param1;
+    psEntry->ui32Param2 = ui32Param2;
+
+    //
+    // Mark the entry as ready to be read.
+    //
+    psEntry->ui32Seq = MQ_SEQ(ui32Write, MQ_STATE_READY);
+
+    //
+    // Update the high-water mark of the queue.
+    //
+    ui32Count = ui32Write + 1 - ui32Read;
+    do
+    {
+        ui32Read = g_sMQStats.ui32HighWater;
+    }
+    while((ui32Count > ui32Read) &&
+          !WidgetAtomicUpdate(&(g_sMQStats.ui32HighWater), ui32Read,
+                              ui32Count));
+
+    //
+    // Success.
+    //
+    return(1);
+}
+
+//*****************************************************************************
+//
+// Reads the next message from the widget message queue.
+//
+// \param psMessage is a pointer to the structure that is filled in with the
+// message.
+//
+// This function removes the oldest message from the message queue.  If the
+// entry that holds it is still being written or updated by a producer which
+// was interrupted by the caller, the message is left in the queue to be read
+// on a later call.
+//
+// \return Returns \b true if a message was read and \b false otherwise.
+//
+//*****************************************************************************
+static bool
+WidgetMessageQueueRead(tWidgetMessageQueue *psMessage)
+{
+    volatile tWidgetMessageQueue *psEntry;
+    uint32_t ui32Read;
+
+    //
+    // Return without a message if the queue is empty.
+    //
+    ui32Read = g_ui32MQRead;
+    if(ui32Read == g_ui32MQWrite)
+    {
+        return(false);
+    }
+
+    //
+    // Claim the entry that holds the oldest message, so that it is not
+    // updated while it is being read.
+    //
+    psEntry = MQ_ENTRY(ui32Read);
+    if(!WidgetAtomicUpdate(&(psEntry->ui32Seq),
+                           MQ_SEQ(ui32Read, MQ_STATE_READY),
+                           MQ_SEQ(ui32Read, MQ_STATE_BUSY)))
+    {
+        return(false);
+    }
+
+    //
+    // Copy the contents of this message.
+    //
+    psMessage->psWidget = psEntry->psWidget;
+    psMessage->ui32Flags = psEntry->ui32Flags;
+    psMessage->ui32Message = psEntry->ui32Message;
+    psMessage->ui32Param1 = psEntry->ui32Param1;
+    psMessage->ui32Param2 = psEntry->ui32Param2;
+
+    //
+    // Free the entry for the next pass around the queue, then remove the
+    // message from the queue.  This must be done in this order since
+    // producers treat any entry before the read offset as free.
+    //
+    psEntry->ui32Seq = MQ_SEQ(ui32Read + WIDGET_MSG_QUEUE_SIZE, MQ_STATE_FREE);
+    g_ui32MQRead = ui32Read + 1;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Determines the cost, in pixels, of merging a region with a damage region.
+//
+// \param psA is the existing damage region.
+// \param psB is the region being added.
+//
+// This function computes the number of pixels that are in the bounding box of
+// the two regions but in neither of them, which is the number of pixels that
+// would be needlessly repainted if the two were merged.  Overlapping pixels
+// are counted once for each region, which errs in favor of merging regions
+// that overlap.
+//
+// \return Returns the number of extra pixels that a merge would repaint.
+//
+//*****************************************************************************
+static int32_t
+WidgetDamageMergeCost(const tRectangle *psA, const tRectangle *psB)
+{
+    int32_t i32Bound, i32A, i32B;
+
+    i32Bound = ((WidgetMax(psA->i16XMax, psB->i16XMax) -
+                 WidgetMin(psA->i16XMin, psB->i16XMin) + 1) *
+                (WidgetMax(psA->i16YMax, psB->i16YMax) -
+                 WidgetMin(psA->i16YMin, psB->i16YMin) + 1));
+    i32A = ((psA->i16XMax - psA->i16XMin + 1) *
+            (psA->i16YMax - psA->i16YMin + 1));
+    i32B = ((psB->i16XMax - psB->i16XMin + 1) *
+            (psB->i16YMax - psB->i16YMin + 1));
+
+    return(i32Bound - i32A - i32B);
+}
+
+//*****************************************************************************
+//
+// Adds a region to the list of damaged regions.
+//
+// \param psRect is the region to be added.
+//
+// This function adds a region to the list of regions waiting to be repainted.
+// A region which touches or overlaps an existing region is merged with it,
+// as is a region which arrives when the list is full; in the latter case, it
+// is merged with the existing region whose bounding box grows the least.  The
+// caller must hold the message queue mutex.
+//
+// \return None.
+//
+//*****************************************************************************
+static void
+WidgetDamageAdd(const tRectangle *psRect)
+{
+    tRectangle sMerged;
+    uint32_t ui32Idx, ui32Best;
+    int32_t i32Cost, i32BestCost;
+
+    //
+    // Find the existing region that is cheapest to merge with.
+    //
+    ui32Best = 0;
+    i32BestCost = 0;
+    for(ui32Idx = 0; ui32Idx < g_ui32NumDamage; ui32Idx++)
+    {
+        i32Cost = WidgetDamageMergeCost(&g_psDamage[ui32Idx], psRect);
+        if((ui32Idx == 0) || (i32Cost < i32BestCost))
+        {
+            ui32Best = ui32Idx;
+            i32BestCost = i32Cost;
+        }
+    }
+
+    //
+    // Add this region as a new entry if it does not overlap an existing region
+    // and there is room in the list.
+    //
+    if((g_ui32NumDamage == 0) ||
+       ((i32BestCost > 0) && (g_ui32NumDamage < WIDGET_NUM_DAMAGE_RECTS)))
+    {
+        g_psDamage[g_ui32NumDamage] = *psRect;
+        g_ui32NumDamage++;
+        return;
+    }
+
+    //
+    // Merge this region into the chosen existing region.
+    //
+    sMerged.i16XMin = WidgetMin(g_psDamage[ui32Best].i16XMin, psRect->i16XMin);
+    sMerged.i16YMin = WidgetMin(g_psDamage[ui32Best].i16YMin, psRect->i16YMin);
+    sMerged.i16XMax = WidgetMax(g_psDamage[ui32Best].i16XMax, psRect->i16XMax);
+    sMerged.i16YMax = WidgetMax(g_psDamage[ui32Best].i16YMax, psRect->i16YMax);
+
+    //
+    // The merged region may now overlap other regions in the list, so remove
+    // it and add it back again.
+    //
+    g_ui32NumDamage--;
+    g_psDamage[ui32Best] = g_psDamage[g_ui32NumDamage];
+    WidgetDamageAdd(&sMerged);
+}
+
+//*****************************************************************************
+//
+// Repaints the portion of the widget tree within a region of the display.
+//
+// \param psRegion is the region of the display to be repainted.
+//
+// This function sends a paint message describing the given region to each
+// widget in the tree whose extents overlap the region.  The widgets are
+// visited in the same top-down order as is used by WidgetPaint(), so that
+// children are drawn over their parents.
+//
+// \return None.
+//
+//*****************************************************************************
+static void
+WidgetRegionPaint(tRectangle *psRegion)
 {
     tWidget *psWidget;
-    uint32_t ui32Flags, ui32Message, ui32Param1, ui32Param2;
+    uint32_t ui32Param1, ui32Param2;
 
     //
-    // Loop while there are more messages in the message queue.
+    // Pack the region into the paint message parameters.
     //
-    while(g_ui32MQRead != g_ui32MQWrite)
+    ui32Param1 = PAINT_PARAM(psRegion->i16XMin, psRegion->i16YMin);
+    ui32Param2 = PAINT_PARAM_END(psRegion->i16XMax, psRegion->i16YMax);
+
+    //
+    // Loop through the widget tree, starting with the first child of the
+    // root widget.
+    //
+    psWidget = g_sRoot.psChild;
+    while(psWidget)
     {
         //
-        // Copy the contents of this message into local variables.
+        // Send the paint message to this widget if it lies within the region.
         //
-        psWidget = g_psMQ[g_ui32MQRead].psWidget;
-        ui32Flags = g_psMQ[g_ui32MQRead].ui32Flags;
-        ui32Message = g_psMQ[g_ui32MQRead].ui32Message;
-        ui32Param1 = g_psMQ[g_ui32MQRead].ui32Param1;
-        ui32Param2 = g_psMQ[g_ui32MQRead].ui32Param2;
+        if(GrRectOverlapCheck(&(psWidget->sPosition), psRegion))
+        {
+            psWidget->pfnMsgProc(psWidget, WIDGET_MSG_PAINT, ui32Param1,
+                                 ui32Param2);
+        }
 
         //
-        // Remove this message from the queue.
+        // Move to the first child of this widget, if it has one.
         //
-        g_ui32MQRead = (g_ui32MQRead + 1) % QUEUE_SIZE;
+        if(psWidget->psChild)
+        {
+            psWidget = psWidget->psChild;
+            continue;
+        }
 
         //
-        // See if this message should be sent via a post-order or pre-order
-        // search.
+        // Move up the tree until a widget with a next sibling is found, or
+        // the root is reached (which has neither a parent nor a sibling).
         //
-        if(ui32Flags & MQ_FLAG_POST_ORDER)
+        while(psWidget && !psWidget->psNext)
         {
-            //
-            // Send this message with a post-order search of the widget tree.
-            //
-            WidgetMessageSendPostOrder(psWidget, ui32Message, ui32Param1,
-                                       ui32Param2,
-                                       ((ui32Flags & MQ_FLAG_STOP_ON_SUCCESS) ?
-                                        true : false));
+            psWidget = psWidget->psParent;
         }
-        else
+
+        //
+        // Move to the next sibling, if one was found.
+        //
+        if(psWidget)
+        {
+            psWidget = psWidget->psNext;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Repaints the regions of the display that have been invalidated.
+//
+// This function takes the current list of damaged regions (leaving it empty
+// so that paint handlers and interrupt handlers may invalidate further
+// regions) and repaints the widgets within each of them.
+//
+// \return Returns \b true if any regions were repainted and \b false if
+// there were none, or the list is currently being updated by another context.
+//
+//*****************************************************************************
+static bool
+WidgetDamageProcess(void)
+{
+    tRectangle psDamage[WIDGET_NUM_DAMAGE_RECTS];
+    uint32_t ui32Idx, ui32Num;
+
+    //
+    // Return without doing anything if there are no damaged regions.
+    //
+    if(g_ui32NumDamage == 0)
+    {
+        return(false);
+    }
+
+    //
+    // Get the mutex we use to protect access to the damage list.
+    //
+    if(WidgetMutexGet(&g_ui8MQMutex))
+    {
+        return(false);
+    }
+
+    //
+    // Take a copy of the damage list and empty it.
+    //
+    ui32Num = g_ui32NumDamage;
+    for(ui32Idx = 0; ui32Idx < ui32Num; ui32Idx++)
+    {
+        psDamage[ui32Idx] = g_psDamage[ui32Idx];
+    }
+    g_ui32NumDamage = 0;
+
+    //
+    // Release the mutex.
+    //
+    WidgetMutexPut(&g_ui8MQMutex);
+
+    //
+    // Repaint each of the damaged regions.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32Num; ui32Idx++)
+    {
+        WidgetRegionPaint(&psDamage[ui32Idx]);
+    }
+
+    //
+    // Some regions were repainted.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Processes the messages in the widget message queue.
+//!
+//! This function extracts messages from the widget message queue one at a time
+//! and processes them.  If the processing of a widget message requires that a
+//! new message be sent, it is acceptable to call WidgetMessageQueueAdd().  It
+//! is also acceptable for code which interrupts this function to call
+//! WidgetMessageQueueAdd() to send more messages.  In both cases, the newly
+//! added message will also be processed before this function returns.
+//!
+//! Once the message queue is empty, any regions of the display that have been
+//! invalidated by WidgetInvalidate() are repainted, which is done by sending
+//! paint messages to only those widgets that lie within each region.  This is
+//! repeated until both the message queue and the list of invalidated regions
+//! are empty.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+WidgetMessageQueueProcess(void)
+{
+    tWidgetMessageQueue sMessage;
+
+    //
+    // Loop until all messages have been processed and all invalidated regions
+    // of the display have been repainted.
+    //
+    do
+    {
+        //
+        // Loop while there are more messages in the message queue.
+        //
+        while(WidgetMessageQueueRead(&sMessage))
         {
             //
-            // Send this message with a pre-order search of the widget tree.
+            // See if this message should be sent via a post-order or pre-order
+            // search.
             //
-            WidgetMessageSendPreOrder(psWidget, ui32Message, ui32Param1,
-                                      ui32Param2,
-                                      ((ui32Flags & MQ_FLAG_STOP_ON_SUCCESS) ?
-                                       true : false));
+            if(sMessage.ui32Flags & MQ_FLAG_POST_ORDER)
+            {
+                //
+                // Send this message with a post-order search of the widget
+                // tree.
+                //
+                WidgetMessageSendPostOrder(sMessage.psWidget,
+                                           sMessage.ui32Message,
+                                           sMessage.ui32Param1,
+                                           sMessage.ui32Param2,
+                                           ((sMessage.ui32Flags &
+                                             MQ_FLAG_STOP_ON_SUCCESS) ?
+                                            true : false));
+            }
+            else
+            {
+                //
+                // Send this message with a pre-order search of the widget
+                // tree.
+                //
+                WidgetMessageSendPreOrder(sMessage.psWidget,
+                                          sMessage.ui32Message,
+                                          sMessage.ui32Param1,
+                                          sMessage.ui32Param2,
+                                          ((sMessage.ui32Flags &
+                                            MQ_FLAG_STOP_ON_SUCCESS) ?
+                                           true : false));
+            }
+        }
+    }
+    while(WidgetDamageProcess());
+}
+
+//*****************************************************************************
+//
+//! Invalidates a region of the display, causing it to be repainted.
+//!
+//! \param psWidget is the widget whose extents are to be repainted.
+//! \param psRect is the region of the widget to be repainted, or 0 if the
+//! entire widget is to be repainted.
+//!
+//! This function records a region of the display as needing to be repainted;
+//! the repaint happens the next time WidgetMessageQueueProcess() is called.
+//! Only those widgets whose extents overlap the region receive a paint
+//! message, and that message describes the region so that the widget can
+//! restrict its drawing to it (see WidgetPaintRegionGet()).  This is much
+//! cheaper than WidgetPaint() when a small part of the display changes, such
+//! as the value of a slider.
+//!
+//! If \e psRect is supplied, it is clipped to the extents of \e psWidget,
+//! unless \e psWidget is \b WIDGET_ROOT in which case \e psRect is used
+//! unchanged.  Invalidating \b WIDGET_ROOT with a 0 \e psRect is equivalent
+//! to calling WidgetPaint(\b WIDGET_ROOT).
+//!
+//! Up to \b WIDGET_NUM_DAMAGE_RECTS separate regions are held; regions which
+//! overlap, or which arrive once the list is full, are merged together.
+//!
+//! The list of regions is protected by a mutex, so it is not safe for code
+//! which interrupts this function to call this function as well; it is up to
+//! the caller to guarantee that this sequence never occurs.
+//!
+//! \return Returns 1 if the region was recorded (or was empty), and 0 if it
+//! could not be recorded since another context is currently adding a message
+//! or region.
+//
+//*****************************************************************************
+int32_t
+WidgetInvalidate(tWidget *psWidget, const tRectangle *psRect)
+{
+    tRectangle sRect;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+
+    //
+    // Determine the region to be repainted.
+    //
+    if(psWidget == WIDGET_ROOT)
+    {
+        //
+        // The root widget has no extents, so either repaint the entire tree
+        // or use the supplied region as it is.
+        //
+        if(!psRect)
+        {
+            return(WidgetPaint(WIDGET_ROOT));
         }
+        sRect = *psRect;
     }
+    else
+    {
+        //
+        // Start with the extents of the widget and clip them to the supplied
+        // region, if there is one.
+        //
+        sRect = psWidget->sPosition;
+        if(psRect)
+        {
+            sRect.i16XMin = WidgetMax(sRect.i16XMin, psRect->i16XMin);
+            sRect.i16YMin = WidgetMax(sRect.i16YMin, psRect->i16YMin);
+            sRect.i16XMax = WidgetMin(sRect.i16XMax, psRect->i16XMax);
+            sRect.i16YMax = WidgetMin(sRect.i16YMax, psRect->i16YMax);
+        }
+    }
+
+    //
+    // There is nothing to do if the region is empty.
+    //
+    if((sRect.i16XMin > sRect.i16XMax) || (sRect.i16YMin > sRect.i16YMax))
+    {
+        return(1);
+    }
+
+    //
+    // Get the mutex we use to protect access to the damage list.
+    //
+    if(WidgetMutexGet(&g_ui8MQMutex))
+    {
+        WidgetStatIncrement(&(g_sMQStats.ui32InvalidateBusy));
+        return(0);
+    }
+
+    //
+    // Add this region to the damage list.
+    //
+    WidgetDamageAdd(&sRect);
+
+    //
+    // Release the mutex.
+    //
+    WidgetMutexPut(&g_ui8MQMutex);
+
+    //
+    // Success.
+    //
+    return(1);
+}
+
+//*****************************************************************************
+//
+//! Determines the region of a widget to be drawn in response to a paint
+//! message.
+//!
+//! \param psWidget is the widget that received the paint message.
+//! \param ui32Param1 is the first parameter of the paint message.
+//! \param ui32Param2 is the second parameter of the paint message.
+//! \param psClip is a pointer to the rectangle that is filled in with the
+//! region to be drawn.
+//!
+//! This function is called by a widget's message procedure on receipt of a
+//! \b WIDGET_MSG_PAINT message to determine what to draw.  For a full paint
+//! (as requested by WidgetPaint()), the region is the extents of the widget.
+//! For a paint resulting from WidgetInvalidate(), it is the portion of the
+//! widget's extents that lies within the invalidated region.  The widget
+//! should use this region as the clipping region for its drawing.
+//!
+//! \return Returns \b true if there is anything to be drawn, and \b false if
+//! the region does not overlap the widget.
+//
+//*****************************************************************************
+bool
+WidgetPaintRegionGet(tWidget *psWidget, uint32_t ui32Param1,
+                     uint32_t ui32Param2, tRectangle *psClip)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psWidget);
+    ASSERT(psClip);
+
+    //
+    // Start with the extents of the widget.
+    //
+    *psClip = psWidget->sPosition;
+
+    //
+    // If this is a full paint then the entire widget is to be drawn.
+    //
+    if((ui32Param1 == 0) && (ui32Param2 == 0))
+    {
+        return(true);
+    }
+
+    //
+    // Clip the extents of the widget to the region being repainted.
+    //
+    psClip->i16XMin = WidgetMax(psClip->i16XMin, PAINT_PARAM_X(ui32Param1));
+    psClip->i16YMin = WidgetMax(psClip->i16YMin, PAINT_PARAM_Y(ui32Param1));
+    psClip->i16XMax = WidgetMin(psClip->i16XMax,
+                                PAINT_PARAM_END_X(ui32Param2));
+    psClip->i16YMax = WidgetMin(psClip->i16YMax,
+                                PAINT_PARAM_END_Y(ui32Param2));
+
+    //
+    // Indicate whether there is anything left to be drawn.
+    //
+    return((psClip->i16XMin <= psClip->i16XMax) &&
+           (psClip->i16YMin <= psClip->i16YMax));
+}
+
+//*****************************************************************************
+//
+//! Sets the coalescing rule for a message.
+//!
+//! \param ui32Message is the message.
+//! \param ui32Rule is the coalescing rule for the message, which must be one
+//! of \b #WIDGET_COALESCE_NONE, \b #WIDGET_COALESCE_DROP, or
+//! \b #WIDGET_COALESCE_REPLACE.
+//!
+//! This function sets the rule that WidgetMessageQueueAdd() uses to decide if
+//! a message can be coalesced with one already waiting in the message queue.
+//! This allows an application to prevent its own messages from filling the
+//! queue when they are sent repeatedly (for example, from a timer interrupt
+//! handler), and to override the default rules for \b #WIDGET_MSG_PAINT and
+//! \b #WIDGET_MSG_PTR_MOVE.  Rules can be set for up to
+//! \b WIDGET_NUM_COALESCE_RULES messages.
+//!
+//! The rules should be set before messages are sent from interrupt handlers.
+//!
+//! \return Returns \b true if the rule was set and \b false if there is no
+//! room for a rule for another message.
+//
+//*****************************************************************************
+bool
+WidgetMessageCoalesceSet(uint32_t ui32Message, uint32_t ui32Rule)
+{
+    uint32_t ui32Idx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT((ui32Rule == WIDGET_COALESCE_NONE) ||
+           (ui32Rule == WIDGET_COALESCE_DROP) ||
+           (ui32Rule == WIDGET_COALESCE_REPLACE));
+
+    //
+    // Find the existing rule for this message, if there is one.
+    //
+    for(ui32Idx = 0; ui32Idx < g_ui32NumCoalesceRules; ui32Idx++)
+    {
+        if(g_pui32CoalesceMsg[ui32Idx] == ui32Message)
+        {
+            break;
+        }
+    }
+
+    //
+    // Fail if this is a new message and there is no room for it.
+    //
+    if(ui32Idx == WIDGET_NUM_COALESCE_RULES)
+    {
+        return(false);
+    }
+
+    //
+    // Save the rule, adding the message to the list if it is new.  The count
+    // is updated last so that the new entry is complete before it is used.
+    //
+    g_pui32CoalesceMsg[ui32Idx] = ui32Message;
+    g_pui8CoalesceRule[ui32Idx] = ui32Rule;
+    if(ui32Idx == g_ui32NumCoalesceRules)
+    {
+        g_ui32NumCoalesceRules++;
+    }
+
+    //
+    // Success.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Gets the statistics for the widget message queue.
+//!
+//! \param psStats is a pointer to the structure that is filled in with the
+//! statistics.
+//!
+//! This function returns the statistics kept for the widget message queue
+//! since startup, or since the last call to WidgetMessageQueueStatsClear().
+//! These can be used to choose a suitable value for
+//! \b WIDGET_MSG_QUEUE_SIZE, and to check that messages are not being lost.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+WidgetMessageQueueStatsGet(tWidgetMessageQueueStats *psStats)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStats);
+
+    //
+    // Copy the statistics.
+    //
+    psStats->ui32HighWater = g_sMQStats.ui32HighWater;
+    psStats->ui32Dropped = g_sMQStats.ui32Dropped;
+    psStats->ui32LastDropped = g_sMQStats.ui32LastDropped;
+    psStats->ui32Coalesced = g_sMQStats.ui32Coalesced;
+    psStats->ui32InvalidateBusy = g_sMQStats.ui32InvalidateBusy;
+}
+
+//*****************************************************************************
+//
+//! Clears the statistics for the widget message queue.
+//!
+//! This function resets the statistics kept for the widget message queue.  The
+//! high-water mark is reset to the number of messages currently in the queue.
+//! A count made by a message which is being added at the same time may be
+//! lost.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+WidgetMessageQueueStatsClear(void)
+{
+    g_sMQStats.ui32HighWater = g_ui32MQWrite - g_ui32MQRead;
+    g_sMQStats.ui32Dropped = 0;
+    g_sMQStats.ui32LastDropped = 0;
+    g_sMQStats.ui32Coalesced = 0;
+    g_sMQStats.ui32InvalidateBusy = 0;
 }
 
 //*****************************************************************************
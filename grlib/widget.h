@@ -103,8 +103,12 @@ tWidget;
 //*****************************************************************************
 //
 //! This message is sent to indicate that the widget should draw itself on the
-//! display.  Neither \e ui32Param1 nor \e ui32Param2 are used by this message.
-//! This message is delivered in top-down order.
+//! display.  If \e ui32Param1 and \e ui32Param2 are both zero, the entire
+//! widget should be drawn.  Otherwise, they describe a region of the display
+//! that has been invalidated by WidgetInvalidate(), and only the portion of
+//! the widget within that region needs to be drawn; WidgetPaintRegionGet()
+//! returns the portion to be drawn in either case.  This message is delivered
+//! in top-down order.
 //
 //*****************************************************************************
 #define WIDGET_MSG_PAINT        0x00000001
@@ -207,6 +211,113 @@ tWidget;
 #define WidgetPaint(psWidget)                                                 \
         WidgetMessageQueueAdd(psWidget, WIDGET_MSG_PAINT, 0, 0, false, false)
 
+//*****************************************************************************
+//
+//! The maximum number of separate regions of the display which are held by
+//! WidgetInvalidate() waiting to be repainted.  Once this many regions are
+//! held, further regions are merged with the existing ones.  The regions are
+//! held within the graphics library, so a different value only takes effect
+//! when grlib is rebuilt with it defined (for example, on the compiler command
+//! line); defining it in the application alone has no effect.
+//
+//*****************************************************************************
+#ifndef WIDGET_NUM_DAMAGE_RECTS
+#define WIDGET_NUM_DAMAGE_RECTS 4
+#endif
+
+//*****************************************************************************
+//
+//! The number of messages that can be held in the widget message queue.  This
+//! must be a power of two, and at least four.  The queue is part of the
+//! graphics library, so its size is chosen when grlib is built; to change it,
+//! rebuild grlib with this label defined to the new size.
+//
+//*****************************************************************************
+#ifndef WIDGET_MSG_QUEUE_SIZE
+#define WIDGET_MSG_QUEUE_SIZE   16
+#endif
+
+//*****************************************************************************
+//
+//! The number of messages for which an application can set a coalescing rule
+//! with WidgetMessageCoalesceSet().  As with \b WIDGET_MSG_QUEUE_SIZE, this
+//! only changes when grlib is rebuilt with a different value.
+//
+//*****************************************************************************
+#ifndef WIDGET_NUM_COALESCE_RULES
+#define WIDGET_NUM_COALESCE_RULES 4
+#endif
+
+//*****************************************************************************
+//
+//! The coalescing rule which indicates that every instance of a message is
+//! added to the message queue.  This is the default for all messages other
+//! than \b #WIDGET_MSG_PAINT and \b #WIDGET_MSG_PTR_MOVE.
+//
+//*****************************************************************************
+#define WIDGET_COALESCE_NONE    0
+
+//*****************************************************************************
+//
+//! The coalescing rule which indicates that a message is discarded if an
+//! identical message (with the same widget, parameters, and search order) is
+//! already waiting in the message queue.  This is the default for
+//! \b #WIDGET_MSG_PAINT, for which a waiting paint of a parent of the widget
+//! also causes the message to be discarded.
+//
+//*****************************************************************************
+#define WIDGET_COALESCE_DROP    1
+
+//*****************************************************************************
+//
+//! The coalescing rule which indicates that, if the most recent message in the
+//! message queue is the same message for the same widget, its parameters are
+//! replaced with those of the new message instead of adding the new message.
+//! This is the default for \b #WIDGET_MSG_PTR_MOVE.
+//
+//*****************************************************************************
+#define WIDGET_COALESCE_REPLACE 2
+
+//*****************************************************************************
+//
+//! The statistics kept for the widget message queue, as returned by
+//! WidgetMessageQueueStatsGet().
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The largest number of messages that have been held in the message
+    //! queue at one time.
+    //
+    uint32_t ui32HighWater;
+
+    //
+    //! The number of messages that were discarded because the message queue
+    //! was full.
+    //
+    uint32_t ui32Dropped;
+
+    //
+    //! The most recent message that was discarded because the message queue
+    //! was full.
+    //
+    uint32_t ui32LastDropped;
+
+    //
+    //! The number of messages that were coalesced with a message already in
+    //! the message queue, rather than being added to it.
+    //
+    uint32_t ui32Coalesced;
+
+    //
+    //! The number of calls to WidgetInvalidate() that failed because another
+    //! context was updating the list of invalidated regions.
+    //
+    uint32_t ui32InvalidateBusy;
+}
+tWidgetMessageQueueStats;
+
 //*****************************************************************************
 //
 // Prototypes for the generic widget handling functions.
@@ -233,11 +344,19 @@ extern int32_t WidgetMessageQueueAdd(tWidget *psWidget, uint32_t ui32Message,
                                      bool bPostOrder,
                                      bool bStopOnSuccess);
 extern void WidgetMessageQueueProcess(void);
+extern bool WidgetMessageCoalesceSet(uint32_t ui32Message, uint32_t ui32Rule);
+extern void WidgetMessageQueueStatsGet(tWidgetMessageQueueStats *psStats);
+extern void WidgetMessageQueueStatsClear(void);
+extern int32_t WidgetInvalidate(tWidget *psWidget, const tRectangle *psRect);
+extern bool WidgetPaintRegionGet(tWidget *psWidget, uint32_t ui32Param1,
+                                 uint32_t ui32Param2, tRectangle *psClip);
 extern int32_t WidgetPointerMessage(uint32_t ui32Message, int32_t i32X,
                                     int32_t i32Y);
 extern void WidgetMutexInit(uint8_t *pi8Mutex);
 extern uint32_t WidgetMutexGet(uint8_t *pi8Mutex);
 extern void WidgetMutexPut(uint8_t *pi8Mutex);
+extern uint32_t WidgetCompareSwap(volatile uint32_t *pui32Value,
+                                  uint32_t ui32Compare, uint32_t ui32Swap);
 
 //*****************************************************************************
 //
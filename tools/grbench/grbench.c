@@ -0,0 +1,4391 @@
+//*****************************************************************************
+//
+// grbench.c - Host-side graphics library benchmark and rendering test.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+#include "grlib/canvas.h"
+#include "grlib/checkbox.h"
+#include "grlib/container.h"
+#include "grlib/keyboard.h"
+#include "grlib/listbox.h"
+#include "grlib/pushbutton.h"
+#include "grlib/radiobutton.h"
+#include "grlib/slider.h"
+#include "grlib/trendchart.h"
+#include "third_party/fatfs/src/ff.h"
+#include "utils/spi_flash.h"
+#include "utils/fontwrapper.h"
+#include "images.h"
+#include "language_ex.h"
+
+//*****************************************************************************
+//
+// This program renders a fixed workload using the graphics library and the
+// off-screen display drivers on the host machine.  It has two purposes:
+//
+// - To measure the throughput of each graphics library primitive, reported as
+//   calls per second and pixels per second, so that the effect of changes to
+//   the library can be quantified without target hardware.
+//
+// - To compare the output of a set of test scenes against stored golden
+//   images (binary PPM files), so that optimization work can not silently
+//   change what is drawn.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The dimensions of the frame buffer used for all rendering.
+//
+//*****************************************************************************
+#define WIDTH                   320
+#define HEIGHT                  240
+
+//*****************************************************************************
+//
+// The default number of seconds for which each benchmark is run.
+//
+//*****************************************************************************
+#define DEFAULT_DURATION        0.25
+
+//*****************************************************************************
+//
+// The frame buffers.  The golden images are rendered into a 24 BPP buffer so
+// that no color information is lost.  The benchmark may be run with either a
+// 16 BPP or 24 BPP buffer.
+//
+//*****************************************************************************
+static uint8_t g_pui8Frame24[GrOffScreen24BPPSize(WIDTH, HEIGHT)];
+static uint8_t g_pui8Frame16[GrOffScreen16BPPSize(WIDTH, HEIGHT)];
+
+//*****************************************************************************
+//
+// The off-screen display driver for the frame buffer currently in use.
+//
+//*****************************************************************************
+static tDisplay g_sDriverDisplay;
+
+//*****************************************************************************
+//
+// The display used for all rendering; it is a global so that the widget tree
+// can reference it statically.  This is either a copy of g_sDriverDisplay or,
+// while counting pixels, a wrapper which counts the pixels written by and the
+// calls made into g_sDriverDisplay.
+//
+//*****************************************************************************
+static tDisplay g_sFrameDisplay;
+
+//*****************************************************************************
+//
+// The counters maintained by the counting display.
+//
+//*****************************************************************************
+static uint64_t g_ui64Pixels;
+static uint64_t g_ui64DriverCalls;
+
+//*****************************************************************************
+//
+// The number of reads made from the simulated SPI flash.
+//
+//*****************************************************************************
+static uint64_t g_ui64FlashReads;
+
+//*****************************************************************************
+//
+// The glyph cache used by the cached string drawing benchmark and scene.
+//
+//*****************************************************************************
+#define GLYPH_CACHE_RUNS        128
+static tGlyphCache g_sGlyphCache;
+static uint32_t g_pui32GlyphCache[262144];
+static uint16_t g_pui16GlyphHash[256];
+
+//*****************************************************************************
+//
+// Images generated at startup in each of the uncompressed formats.
+//
+//*****************************************************************************
+#define IMG_WIDTH               48
+#define IMG_HEIGHT              40
+static uint8_t g_pui8Image1BPP[GrOffScreen1BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+static uint8_t g_pui8Image4BPP[GrOffScreen4BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+static uint8_t g_pui8Image8BPP[GrOffScreen8BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+static uint8_t g_pui8Image16BPP[GrOffScreen16BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+static uint8_t g_pui8Image24BPP[GrOffScreen24BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+
+//*****************************************************************************
+//
+// The fonts exercised by the string drawing tests.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *pcName;
+    const tFont *psFont;
+}
+tFontEntry;
+
+#define FONT(name)              { #name, (const tFont *)&g_sFont##name }
+
+static const tFontEntry g_psFonts[] =
+{
+    FONT(Cm12),
+    FONT(Cm12b),
+    FONT(Cm12i),
+    FONT(Cm14),
+    FONT(Cm14b),
+    FONT(Cm14i),
+    FONT(Cm16),
+    FONT(Cm16b),
+    FONT(Cm16i),
+    FONT(Cm18),
+    FONT(Cm18b),
+    FONT(Cm18i),
+    FONT(Cm20),
+    FONT(Cm20b),
+    FONT(Cm20i),
+    FONT(Cm22),
+    FONT(Cm22b),
+    FONT(Cm22i),
+    FONT(Cm24),
+    FONT(Cm24b),
+    FONT(Cm24i),
+    FONT(Cm26),
+    FONT(Cm26b),
+    FONT(Cm26i),
+    FONT(Cm28),
+    FONT(Cm28b),
+    FONT(Cm28i),
+    FONT(Cm30),
+    FONT(Cm30b),
+    FONT(Cm30i),
+    FONT(Cm32),
+    FONT(Cm32b),
+    FONT(Cm32i),
+    FONT(Cm34),
+    FONT(Cm34b),
+    FONT(Cm34i),
+    FONT(Cm36),
+    FONT(Cm36b),
+    FONT(Cm36i),
+    FONT(Cm38),
+    FONT(Cm38b),
+    FONT(Cm38i),
+    FONT(Cm40),
+    FONT(Cm40b),
+    FONT(Cm40i),
+    FONT(Cm42),
+    FONT(Cm42b),
+    FONT(Cm42i),
+    FONT(Cm44),
+    FONT(Cm44b),
+    FONT(Cm44i),
+    FONT(Cm46),
+    FONT(Cm46b),
+    FONT(Cm46i),
+    FONT(Cm48),
+    FONT(Cm48b),
+    FONT(Cm48i),
+    FONT(Cmsc12),
+    FONT(Cmsc14),
+    FONT(Cmsc16),
+    FONT(Cmsc18),
+    FONT(Cmsc20),
+    FONT(Cmsc22),
+    FONT(Cmsc24),
+    FONT(Cmsc26),
+    FONT(Cmsc28),
+    FONT(Cmsc30),
+    FONT(Cmsc32),
+    FONT(Cmsc34),
+    FONT(Cmsc36),
+    FONT(Cmsc38),
+    FONT(Cmsc40),
+    FONT(Cmsc42),
+    FONT(Cmsc44),
+    FONT(Cmsc46),
+    FONT(Cmsc48),
+    FONT(Cmss12),
+    FONT(Cmss12b),
+    FONT(Cmss12i),
+    FONT(Cmss14),
+    FONT(Cmss14b),
+    FONT(Cmss14i),
+    FONT(Cmss16),
+    FONT(Cmss16b),
+    FONT(Cmss16i),
+    FONT(Cmss18),
+    FONT(Cmss18b),
+    FONT(Cmss18i),
+    FONT(Cmss20),
+    FONT(Cmss20b),
+    FONT(Cmss20i),
+    FONT(Cmss22),
+    FONT(Cmss22b),
+    FONT(Cmss22i),
+    FONT(Cmss24),
+    FONT(Cmss24b),
+    FONT(Cmss24i),
+    FONT(Cmss26),
+    FONT(Cmss26b),
+    FONT(Cmss26i),
+    FONT(Cmss28),
+    FONT(Cmss28b),
+    FONT(Cmss28i),
+    FONT(Cmss30),
+    FONT(Cmss30b),
+    FONT(Cmss30i),
+    FONT(Cmss32),
+    FONT(Cmss32b),
+    FONT(Cmss32i),
+    FONT(Cmss34),
+    FONT(Cmss34b),
+    FONT(Cmss34i),
+    FONT(Cmss36),
+    FONT(Cmss36b),
+    FONT(Cmss36i),
+    FONT(Cmss38),
+    FONT(Cmss38b),
+    FONT(Cmss38i),
+    FONT(Cmss40),
+    FONT(Cmss40b),
+    FONT(Cmss40i),
+    FONT(Cmss42),
+    FONT(Cmss42b),
+    FONT(Cmss42i),
+    FONT(Cmss44),
+    FONT(Cmss44b),
+    FONT(Cmss44i),
+    FONT(Cmss46),
+    FONT(Cmss46b),
+    FONT(Cmss46i),
+    FONT(Cmss48),
+    FONT(Cmss48b),
+    FONT(Cmss48i),
+    FONT(Cmtt12),
+    FONT(Cmtt14),
+    FONT(Cmtt16),
+    FONT(Cmtt18),
+    FONT(Cmtt20),
+    FONT(Cmtt22),
+    FONT(Cmtt24),
+    FONT(Cmtt26),
+    FONT(Cmtt28),
+    FONT(Cmtt30),
+    FONT(Cmtt32),
+    FONT(Cmtt34),
+    FONT(Cmtt36),
+    FONT(Cmtt38),
+    FONT(Cmtt40),
+    FONT(Cmtt42),
+    FONT(Cmtt44),
+    FONT(Cmtt46),
+    FONT(Cmtt48),
+    FONT(Fixed6x8),
+};
+
+#define NUM_FONTS               (sizeof(g_psFonts) / sizeof(g_psFonts[0]))
+
+//*****************************************************************************
+//
+// An anti-aliased font, built at startup by downsampling the glyphs of a
+// large 1 BPP font, along with a 1 BPP font of a similar size to compare it
+// against.
+//
+//*****************************************************************************
+#define AA_SOURCE_FONT          g_sFontCmss48
+#define AA_SCALE                3
+#define AA_FIRST                32
+#define AA_LAST                 126
+#define AA_SOURCE_WIDTH         64
+#define AA_SOURCE_HEIGHT        64
+#define AA_COMPARE_FONT         g_sFontCmss16
+static uint8_t g_pui8FontAASource[GrOffScreen1BPPSize(AA_SOURCE_WIDTH,
+                                                      AA_SOURCE_HEIGHT)];
+static uint16_t g_pui16FontAAOffset[AA_LAST - AA_FIRST + 1];
+static uint8_t g_pui8FontAAData[16384];
+static tFontEx g_sFontAA;
+
+//*****************************************************************************
+//
+// A wide font with many blocks of codepoints, in the manner of a CJK font,
+// built at startup from the glyphs of a 1 BPP font.  Each block holds
+// WIDE_BLOCK_CHARS codepoints and successive blocks start WIDE_BLOCK_STEP
+// codepoints apart.  The index is used by the indexed scene and benchmarks.
+//
+//*****************************************************************************
+#define WIDE_SOURCE_FONT        g_sFontCm16
+#define WIDE_FIRST              0x4e00
+#define WIDE_BLOCKS             256
+#define WIDE_BLOCK_CHARS        48
+#define WIDE_BLOCK_STEP         64
+#define WIDE_GLYPHS             95
+#define WIDE_STRING_CHARS       16
+static uint32_t g_pui32FontWide[(sizeof(tFontWide) / 4) +
+                                ((WIDE_BLOCKS * sizeof(tFontBlock)) / 4) +
+                                (WIDE_BLOCKS * WIDE_BLOCK_CHARS) + 2048];
+static tFontIndex g_sFontIndex;
+static tCodePointMap g_psWideCodePointMap[] =
+{
+    { CODEPAGE_UTF_8, CODEPAGE_UNICODE, GrMapUTF8_Unicode },
+};
+
+//*****************************************************************************
+//
+// The wide font, loaded through the cached font wrapper from a simulated SPI
+// flash which holds the font at FLASH_FONT_ADDR.  The glyph cache is small
+// enough that most strings drawn by the benchmarks miss in it.
+//
+//*****************************************************************************
+#define FLASH_SSI_BASE          0x4000b000
+#define FLASH_FONT_ADDR         0x10000
+#define WRAPPED_CACHE_GLYPHS    64
+static tFontWrapperData g_sFontWrapperData;
+static uint32_t g_pui32FontWrapperBuffer[FontWrapperBufferSize(
+                                             WIDE_BLOCKS,
+                                             WRAPPED_CACHE_GLYPHS) / 4];
+static tFontWrapper g_sFontWrapped;
+
+//*****************************************************************************
+//
+// The images exercised by the image drawing tests.  The compressed images are
+// borrowed from the grlib_demo example application.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *pcName;
+    const uint8_t *pui8Image;
+}
+tImageEntry;
+
+static const tImageEntry g_psImages[] =
+{
+    { "1bpp", g_pui8Image1BPP },
+    { "4bpp", g_pui8Image4BPP },
+    { "8bpp", g_pui8Image8BPP },
+    { "16bpp", g_pui8Image16BPP },
+    { "24bpp", g_pui8Image24BPP },
+    { "4bpp_comp", g_ui8Logo },
+    { "4bpp_comp", g_pui8Blue50x50 },
+    { "8bpp_comp", g_pui8GreenSlider195x37 },
+    { "8bpp_comp", g_pui8GettingHotter28x148 },
+};
+
+#define NUM_IMAGES              (sizeof(g_psImages) / sizeof(g_psImages[0]))
+
+//*****************************************************************************
+//
+// Copies of the 1, 4 and 8 BPP images in the banded compressed format, built
+// at startup.  Images in other formats are used unchanged.
+//
+//*****************************************************************************
+#define IMG_BAND_ROWS           8
+static const uint8_t *g_ppui8Banded[NUM_IMAGES];
+
+//*****************************************************************************
+//
+// A set of colors used to distinguish the output of successive operations.
+//
+//*****************************************************************************
+static const uint32_t g_pui32Colors[] =
+{
+    ClrWhite, ClrRed, ClrLime, ClrBlue, ClrYellow, ClrCyan, ClrMagenta,
+    ClrOrange, ClrSilver, ClrPurple, ClrTeal, ClrOlive
+};
+
+#define NUM_COLORS              (sizeof(g_pui32Colors) /                      \
+                                 sizeof(g_pui32Colors[0]))
+
+//*****************************************************************************
+//
+// The widget tree drawn by the widget tests.
+//
+//*****************************************************************************
+static const char *g_ppcListText[] =
+{
+    "Lines", "Circles", "Rectangles", "Strings", "Images", "Widgets",
+    "Fonts", "Palettes"
+};
+
+#define NUM_LIST_ENTRIES        (sizeof(g_ppcListText) /                      \
+                                 sizeof(g_ppcListText[0]))
+
+extern tCanvasWidget g_sBackground;
+extern tContainerWidget g_sOptions;
+extern tListBoxWidget g_sListBox;
+extern tSliderWidget g_sSlider;
+extern tPushButtonWidget g_sRectButton;
+extern tPushButtonWidget g_sCircleButton;
+extern tCanvasWidget g_sLogo;
+extern tCheckBoxWidget g_sCheckBox1;
+extern tCheckBoxWidget g_sCheckBox2;
+extern tRadioButtonWidget g_sRadioButton1;
+
+RadioButton(g_sRadioButton2, &g_sOptions, 0, 0, &g_sFrameDisplay, 20, 110, 120,
+            22, RB_STYLE_TEXT, 10, ClrBlack, ClrWhite, ClrWhite,
+            (const tFont *)&g_sFontCmss14, "Fast", 0, 0);
+RadioButton(g_sRadioButton1, &g_sOptions, &g_sRadioButton2, 0,
+            &g_sFrameDisplay, 20, 88, 120, 22, RB_STYLE_TEXT | RB_STYLE_SELECTED,
+            10, ClrBlack, ClrWhite, ClrWhite, (const tFont *)&g_sFontCmss14,
+            "Accurate", 0, 0);
+CheckBox(g_sCheckBox2, &g_sOptions, &g_sRadioButton1, 0, &g_sFrameDisplay, 20,
+         66, 120, 22, CB_STYLE_OUTLINE | CB_STYLE_TEXT, 14, ClrBlack,
+         ClrSilver, ClrWhite, (const tFont *)&g_sFontCmss14, "Outline", 0, 0);
+CheckBox(g_sCheckBox1, &g_sOptions, &g_sCheckBox2, 0, &g_sFrameDisplay, 20, 44,
+         120, 22, CB_STYLE_OUTLINE | CB_STYLE_FILL | CB_STYLE_TEXT |
+         CB_STYLE_SELECTED, 14, ClrMidnightBlue, ClrSilver, ClrWhite,
+         (const tFont *)&g_sFontCmss14, "Fill", 0, 0);
+Canvas(g_sLogo, &g_sBackground, 0, 0, &g_sFrameDisplay, 260, 186, 50, 50,
+       CANVAS_STYLE_IMG, 0, 0, 0, 0, 0, g_ui8Logo, 0);
+CircularButton(g_sCircleButton, &g_sBackground, &g_sLogo, 0, &g_sFrameDisplay,
+               212, 211, 24, PB_STYLE_OUTLINE | PB_STYLE_FILL | PB_STYLE_TEXT,
+               ClrDarkRed, ClrRed, ClrWhite, ClrWhite,
+               (const tFont *)&g_sFontCmss18b, "Go", 0, 0, 0, 0, 0);
+RectangularButton(g_sRectButton, &g_sBackground, &g_sCircleButton, 0,
+                  &g_sFrameDisplay, 10, 190, 170, 42,
+                  PB_STYLE_OUTLINE | PB_STYLE_FILL | PB_STYLE_TEXT,
+                  ClrDarkGreen, ClrGreen, ClrWhite, ClrWhite,
+                  (const tFont *)&g_sFontCmss20, "Push Button", 0, 0, 0, 0,
+                  0);
+Slider(g_sSlider, &g_sBackground, &g_sRectButton, 0, &g_sFrameDisplay, 10, 148,
+       300, 32, 0, 100, 40, SL_STYLE_FILL | SL_STYLE_BACKG_FILL |
+       SL_STYLE_OUTLINE | SL_STYLE_TEXT | SL_STYLE_BACKG_TEXT, ClrBlue,
+       ClrBlack, ClrSilver, ClrWhite, ClrWhite, (const tFont *)&g_sFontCm18,
+       "40%", 0, 0, 0);
+ListBox(g_sListBox, &g_sBackground, &g_sSlider, 0, &g_sFrameDisplay, 170, 30,
+        140, 110, LISTBOX_STYLE_OUTLINE, ClrBlack, ClrDarkBlue, ClrSilver,
+        ClrWhite, ClrWhite, (const tFont *)&g_sFontCmss14, g_ppcListText,
+        NUM_LIST_ENTRIES, NUM_LIST_ENTRIES, 0);
+Container(g_sOptions, &g_sBackground, &g_sListBox, &g_sCheckBox1,
+          &g_sFrameDisplay, 10, 30, 150, 110,
+          CTR_STYLE_OUTLINE | CTR_STYLE_TEXT | CTR_STYLE_FILL, ClrBlack,
+          ClrWhite, ClrWhite, (const tFont *)&g_sFontCmss16, "Options");
+Canvas(g_sBackground, WIDGET_ROOT, 0, &g_sOptions, &g_sFrameDisplay, 0, 0,
+       WIDTH, HEIGHT, CANVAS_STYLE_FILL | CANVAS_STYLE_TEXT |
+       CANVAS_STYLE_TEXT_TOP, ClrDarkSlateGray, 0, ClrWhite,
+       (const tFont *)&g_sFontCmss20b, "grbench", 0, 0);
+
+//*****************************************************************************
+//
+// A listbox which shows a long log supplied by a data source, used to test
+// scrolling.  It is not part of the widget tree.
+//
+//*****************************************************************************
+#define LOG_ITEMS               5000
+
+static tListBoxWidget g_sLogBox;
+
+static const char *
+LogItemGet(tWidget *psWidget, uint32_t ui32Index)
+{
+    static char pcBuffer[32];
+
+    //
+    // Count each item fetched as a read, so that the benchmarks report the
+    // number of items fetched per scroll.
+    //
+    g_ui64FlashReads++;
+    snprintf(pcBuffer, sizeof(pcBuffer), "%04u %s", ui32Index,
+             g_ppcListText[(ui32Index * 7) % NUM_LIST_ENTRIES]);
+    return(pcBuffer);
+}
+
+static void
+LogBoxInit(void)
+{
+    ListBoxInit(&g_sLogBox, &g_sFrameDisplay, 0, 0, 0, 20, 30, 180, 151);
+    g_sLogBox.ui32Style = LISTBOX_STYLE_OUTLINE;
+    ListBoxBackgroundColorSet(&g_sLogBox, ClrBlack);
+    ListBoxSelectedBackgroundColorSet(&g_sLogBox, ClrDarkBlue);
+    ListBoxTextColorSet(&g_sLogBox, ClrSilver);
+    ListBoxSelectedTextColorSet(&g_sLogBox, ClrWhite);
+    ListBoxOutlineColorSet(&g_sLogBox, ClrWhite);
+    ListBoxFontSet(&g_sLogBox, (const tFont *)&g_sFontCmss14);
+    ListBoxDataSourceSet(&g_sLogBox, LogItemGet, LOG_ITEMS);
+}
+
+static void
+LogBoxDrag(int32_t i32Lines)
+{
+    int32_t i32Y;
+
+    //
+    // Drag the pointer up by the given number of lines, which scrolls the
+    // contents up (or down, for a negative number of lines).
+    //
+    i32Y = 100 - (i32Lines * GrFontHeightGet(g_sLogBox.psFont));
+    ListBoxMsgProc((tWidget *)&g_sLogBox, WIDGET_MSG_PTR_DOWN, 100, 100);
+    ListBoxMsgProc((tWidget *)&g_sLogBox, WIDGET_MSG_PTR_MOVE, 100, i32Y);
+    ListBoxMsgProc((tWidget *)&g_sLogBox, WIDGET_MSG_PTR_UP, 100, i32Y);
+}
+
+//*****************************************************************************
+//
+// An on-screen keyboard across the bottom half of the display, and the text
+// typed on it.  It is not part of the widget tree.
+//
+//*****************************************************************************
+#define KEYBOARD_TEXT_SIZE      32
+
+static tKeyboardWidget g_sKeyboard;
+static char g_pcKeyboardText[KEYBOARD_TEXT_SIZE];
+static uint32_t g_ui32KeyboardTextLen;
+
+static void
+KeyboardEvent(tWidget *psWidget, uint32_t ui32Key, uint32_t ui32Event)
+{
+    //
+    // Remember the characters typed, dropping any once the buffer is full.
+    //
+    if((ui32Key >= ' ') && (ui32Key < 0x7f) &&
+       (g_ui32KeyboardTextLen < (KEYBOARD_TEXT_SIZE - 1)))
+    {
+        g_pcKeyboardText[g_ui32KeyboardTextLen++] = (char)ui32Key;
+        g_pcKeyboardText[g_ui32KeyboardTextLen] = 0;
+    }
+}
+
+static void
+OnScreenKeyboardInit(void)
+{
+    KeyboardInit(&g_sKeyboard, &g_sFrameDisplay, 0, 120, WIDTH, 120);
+    g_sKeyboard.ui32Style = (KEYBOARD_STYLE_OUTLINE | KEYBOARD_STYLE_FILL |
+                             KEYBOARD_STYLE_TEXT | KEYBOARD_STYLE_BG |
+                             KEYBOARD_STYLE_PRESS_NOTIFY);
+    g_sKeyboard.ui32BackgroundColor = ClrBlack;
+    g_sKeyboard.ui32FillColor = ClrDarkBlue;
+    g_sKeyboard.ui32PressFillColor = ClrDarkOrange;
+    g_sKeyboard.ui32OutlineColor = ClrSilver;
+    g_sKeyboard.ui32TextColor = ClrWhite;
+    g_sKeyboard.psFont = (const tFont *)&g_sFontCmss16;
+    g_sKeyboard.ui32NumKeyboards = NUM_KEYBOARD_US_ENGLISH;
+    g_sKeyboard.psKeyboards = g_psKeyboardUSEnglish;
+    g_sKeyboard.pfnOnEvent = KeyboardEvent;
+    g_ui32KeyboardTextLen = 0;
+    g_pcKeyboardText[0] = 0;
+}
+
+static void
+OnScreenKeyboardPress(uint32_t ui32Msg, uint32_t ui32Key)
+{
+    const tKeyText *psKey;
+    int32_t i32X, i32Y;
+
+    //
+    // Send a pointer message at the center of the given key of the active
+    // keyboard.
+    //
+    psKey = &(g_sKeyboard.psKeyboards[g_sKeyboard.ui32Active].
+              uKeys.psKeysText[ui32Key]);
+    i32X = (WIDTH * (psKey->ui16XPos + (psKey->ui16Width / 2))) / 10000;
+    i32Y = 120 + ((120 * (psKey->ui16YPos + (psKey->ui16Height / 2))) /
+                  10000);
+    KeyboardMsgProc((tWidget *)&g_sKeyboard, ui32Msg, i32X, i32Y);
+}
+
+static void
+OnScreenKeyboardTap(uint32_t ui32Key)
+{
+    OnScreenKeyboardPress(WIDGET_MSG_PTR_DOWN, ui32Key);
+    OnScreenKeyboardPress(WIDGET_MSG_PTR_UP, ui32Key);
+}
+
+//*****************************************************************************
+//
+// A trend chart showing two series, and an off-screen display which may be
+// used to hold a copy of it.  It is not part of the widget tree.
+//
+//*****************************************************************************
+#define CHART_WIDTH             300
+#define CHART_HEIGHT            120
+
+static tTrendChartWidget g_sChart;
+static tTrendChartSeries g_psChartSeries[2];
+static uint8_t g_pui8ChartImage[GrOffScreen24BPPSize(CHART_WIDTH,
+                                                     CHART_HEIGHT)];
+static tDisplay g_sChartDisplay;
+
+static void
+ChartInit(bool bOffscreen, uint16_t ui16Decimation)
+{
+    GrOffScreen24BPPInit(&g_sChartDisplay, g_pui8ChartImage, CHART_WIDTH,
+                         CHART_HEIGHT);
+    TrendChartInit(&g_sChart, &g_sFrameDisplay, 10, 20, CHART_WIDTH,
+                   CHART_HEIGHT, bOffscreen ? &g_sChartDisplay : 0);
+    TrendChartBackgroundColorSet(&g_sChart, ClrBlack);
+    TrendChartGridColorSet(&g_sChart, ClrDarkGreen);
+    TrendChartRangeSet(&g_sChart, -1000, 1000);
+    TrendChartGridSet(&g_sChart, 250, 25);
+    TrendChartDecimationSet(&g_sChart, ui16Decimation);
+    g_psChartSeries[0].ui32Color = ClrYellow;
+    g_psChartSeries[1].ui32Color = ClrCyan;
+    TrendChartSeriesAdd(&g_sChart, &g_psChartSeries[0]);
+    TrendChartSeriesAdd(&g_sChart, &g_psChartSeries[1]);
+}
+
+static void
+ChartSampleAdd(uint32_t ui32Sample)
+{
+    int32_t pi32Values[2], i32Phase;
+
+    //
+    // The first series is a triangle wave with occasional spikes, and the
+    // second a square wave which goes off the top and bottom of the chart.
+    //
+    i32Phase = ui32Sample % 400;
+    pi32Values[0] = (i32Phase < 200) ? ((i32Phase * 8) - 800) :
+                                       (2400 - (i32Phase * 8));
+    if((ui32Sample % 97) == 0)
+    {
+        pi32Values[0] += 600;
+    }
+    pi32Values[1] = ((ui32Sample / 150) & 1) ? 1200 : -1200;
+    TrendChartSampleAdd(&g_sChart, pi32Values);
+}
+
+//*****************************************************************************
+//
+// The string table of the lang_demo example, both in the format generated by
+// the string compression utility and in the extended format generated by
+// mkstrtab, and a cache for the strings retrieved from either table.
+//
+//*****************************************************************************
+extern const uint8_t g_pui8Tablelanguage[];
+
+#define STRING_CACHE_ENTRIES    8
+
+static uint32_t g_pui32StringCache[GrStringCacheSize(STRING_CACHE_ENTRIES,
+                                                     SCOMP_MAX_STRLEN) / 4];
+static tStringCache g_sStringCache;
+
+//*****************************************************************************
+//
+// Selects the lang_demo string table in the legacy or extended format, with
+// or without the string cache.
+//
+//*****************************************************************************
+static void
+StringTableSelect(bool bExtended, bool bCached)
+{
+    if(bExtended)
+    {
+        GrStringTableExSet(&g_sTablelanguage_ex);
+    }
+    else
+    {
+        GrStringTableSet(g_pui8Tablelanguage);
+    }
+
+    GrStringCacheInit(&g_sStringCache, g_pui32StringCache,
+                      sizeof(g_pui32StringCache), SCOMP_MAX_STRLEN);
+    GrStringCacheSet(bCached ? &g_sStringCache : 0);
+}
+
+//*****************************************************************************
+//
+// A palette based off-screen display, with the palette of the test images,
+// and a color cache for it.  The colors are those typically used by widgets,
+// few of which are in the palette.
+//
+//*****************************************************************************
+static uint8_t g_pui8PaletteImage[GrOffScreen8BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+static tDisplay g_sPaletteDisplay;
+static tContext g_sPaletteContext;
+static tColorCache g_sColorCache;
+static tColorCacheEntry g_psColorCacheEntries[1024];
+#define COLOR_CACHE_SIZE        16
+
+static const uint32_t g_pui32WidgetColors[] =
+{
+    ClrBlack, ClrWhite, ClrGray, ClrSilver, ClrNavy, ClrDarkBlue, ClrRed,
+    ClrLightGrey
+};
+
+#define NUM_WIDGET_COLORS       (sizeof(g_pui32WidgetColors) /                \
+                                 sizeof(g_pui32WidgetColors[0]))
+
+//*****************************************************************************
+//
+// Initializes the palette based display as a 4 or 8 BPP display, with or
+// without the color cache.
+//
+//*****************************************************************************
+static void
+PaletteDisplayInit(uint32_t ui32BPP, bool bCached)
+{
+    if(ui32BPP == 4)
+    {
+        GrOffScreen4BPPInit(&g_sPaletteDisplay, g_pui8PaletteImage, IMG_WIDTH,
+                            IMG_HEIGHT);
+        GrOffScreen4BPPPaletteSet(&g_sPaletteDisplay,
+                                  (uint32_t *)g_pui32Colors, 0, NUM_COLORS);
+    }
+    else
+    {
+        GrOffScreen8BPPInit(&g_sPaletteDisplay, g_pui8PaletteImage, IMG_WIDTH,
+                            IMG_HEIGHT);
+        GrOffScreen8BPPPaletteSet(&g_sPaletteDisplay,
+                                  (uint32_t *)g_pui32Colors, 0, NUM_COLORS);
+    }
+
+    GrColorCacheInit(&g_sColorCache, g_psColorCacheEntries, COLOR_CACHE_SIZE);
+    GrDisplayColorCacheSet(&g_sPaletteDisplay, bCached ? &g_sColorCache : 0);
+    GrContextInit(&g_sPaletteContext, &g_sPaletteDisplay);
+}
+
+//*****************************************************************************
+//
+// A rotated display, and a 24 BPP buffer into which it draws.  The buffer
+// holds WIDTH x HEIGHT pixels, which is also HEIGHT x WIDTH pixels when the
+// display is rotated by a quarter turn.
+//
+//*****************************************************************************
+static uint8_t g_pui8RotatedImage[GrOffScreen24BPPSize(WIDTH, HEIGHT)];
+static tDisplay g_sRotatedBuffer;
+static tRotatedDisplay g_sRotated;
+static tDisplay g_sRotatedDisplay;
+
+//*****************************************************************************
+//
+// The buffers used to check off-screen blits.  Each is large enough for a
+// 24 BPP image, and word aligned so that it can also hold a 16 BPP image.
+// The destination is larger than the test images so that blits land at a
+// variety of positions within it.
+//
+//*****************************************************************************
+#define BLIT_WIDTH              64
+#define BLIT_HEIGHT             56
+#define BLIT_WORDS              ((GrOffScreen24BPPSize(BLIT_WIDTH,            \
+                                                       BLIT_HEIGHT) + 3) / 4)
+static uint32_t g_pui32BlitDst[BLIT_WORDS];
+static uint32_t g_pui32BlitRef[BLIT_WORDS];
+static uint32_t g_pui32BlitCopy[BLIT_WORDS];
+static tDisplay g_sBlitSource;
+
+//*****************************************************************************
+//
+// Initializes an off-screen display of the given pixel depth.
+//
+//*****************************************************************************
+static void
+BlitDisplayInit(tDisplay *psDisplay, uint8_t *pui8Image, uint32_t ui32BPP,
+                int32_t i32Width, int32_t i32Height)
+{
+    switch(ui32BPP)
+    {
+        case 1:
+        {
+            GrOffScreen1BPPInit(psDisplay, pui8Image, i32Width, i32Height);
+            break;
+        }
+
+        case 4:
+        {
+            GrOffScreen4BPPInit(psDisplay, pui8Image, i32Width, i32Height);
+            break;
+        }
+
+        case 8:
+        {
+            GrOffScreen8BPPInit(psDisplay, pui8Image, i32Width, i32Height);
+            break;
+        }
+
+        case 16:
+        {
+            GrOffScreen16BPPInit(psDisplay, pui8Image, i32Width, i32Height);
+            break;
+        }
+
+        default:
+        {
+            GrOffScreen24BPPInit(psDisplay, pui8Image, i32Width, i32Height);
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the test image with the given pixel depth.
+//
+//*****************************************************************************
+static uint8_t *
+BlitImageGet(uint32_t ui32BPP)
+{
+    switch(ui32BPP)
+    {
+        case 1:
+        {
+            return(g_pui8Image1BPP);
+        }
+
+        case 4:
+        {
+            return(g_pui8Image4BPP);
+        }
+
+        case 8:
+        {
+            return(g_pui8Image8BPP);
+        }
+
+        case 16:
+        {
+            return(g_pui8Image16BPP);
+        }
+
+        default:
+        {
+            return(g_pui8Image24BPP);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// The graphics library only provides WidgetMutexGet() and WidgetCompareSwap()
+// for ARM compilers, so provide host implementations for the widget message
+// queue.
+//
+//*****************************************************************************
+uint32_t
+WidgetMutexGet(uint8_t *pi8Mutex)
+{
+    return(__atomic_exchange_n(pi8Mutex, 1, __ATOMIC_ACQUIRE) ? 1 : 0);
+}
+
+uint32_t
+WidgetCompareSwap(volatile uint32_t *pui32Value, uint32_t ui32Compare,
+                  uint32_t ui32Swap)
+{
+    return(__atomic_compare_exchange_n(pui32Value, &ui32Compare, ui32Swap,
+                                       false, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST) ? 0 : 1);
+}
+
+//*****************************************************************************
+//
+// The driver callbacks of the counting display.  Each counts the pixels it
+// writes and then passes the operation on to the frame buffer display.
+//
+//*****************************************************************************
+static void
+CountPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+               uint32_t ui32Value)
+{
+    g_ui64Pixels++;
+    g_ui64DriverCalls++;
+    DpyPixelDraw(&g_sDriverDisplay, i32X, i32Y, ui32Value);
+}
+
+static void
+CountPixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                       int32_t i32X0, int32_t i32Count, int32_t i32BPP,
+                       const uint8_t *pui8Data, const uint8_t *pui8Palette)
+{
+    g_ui64Pixels += (i32Count > 0) ? i32Count : 0;
+    g_ui64DriverCalls++;
+    DpyPixelDrawMultiple(&g_sDriverDisplay, i32X, i32Y, i32X0, i32Count, i32BPP,
+                         pui8Data, pui8Palette);
+}
+
+static void
+CountLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y,
+               uint32_t ui32Value)
+{
+    g_ui64Pixels += (i32X2 >= i32X1) ? (i32X2 - i32X1 + 1) : 0;
+    g_ui64DriverCalls++;
+    DpyLineDrawH(&g_sDriverDisplay, i32X1, i32X2, i32Y, ui32Value);
+}
+
+static void
+CountLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2,
+               uint32_t ui32Value)
+{
+    g_ui64Pixels += (i32Y2 >= i32Y1) ? (i32Y2 - i32Y1 + 1) : 0;
+    g_ui64DriverCalls++;
+    DpyLineDrawV(&g_sDriverDisplay, i32X, i32Y1, i32Y2, ui32Value);
+}
+
+static void
+CountRectFill(void *pvDisplayData, const tRectangle *psRect,
+              uint32_t ui32Value)
+{
+    g_ui64Pixels += ((psRect->i16XMax - psRect->i16XMin + 1) *
+                     (psRect->i16YMax - psRect->i16YMin + 1));
+    g_ui64DriverCalls++;
+    DpyRectFill(&g_sDriverDisplay, psRect, ui32Value);
+}
+
+static void
+CountBlit(void *pvDisplayData, const tRectangle *psRect, int32_t i32X0,
+          int32_t i32BPP, const uint8_t *pui8Data, int32_t i32Stride,
+          const uint8_t *pui8Palette)
+{
+    g_ui64Pixels += ((psRect->i16XMax - psRect->i16XMin + 1) *
+                     (psRect->i16YMax - psRect->i16YMin + 1));
+    g_ui64DriverCalls++;
+    DpyBlit(&g_sDriverDisplay, psRect, i32X0, i32BPP, pui8Data, i32Stride,
+            pui8Palette);
+}
+
+static void
+CountBlitRotated(void *pvDisplayData, const tRectangle *psRect, int32_t i32X0,
+                 int32_t i32BPP, const uint8_t *pui8Data, int32_t i32Stride,
+                 const uint8_t *pui8Palette, uint32_t ui32Rotation)
+{
+    g_ui64Pixels += ((psRect->i16XMax - psRect->i16XMin + 1) *
+                     (psRect->i16YMax - psRect->i16YMin + 1));
+    g_ui64DriverCalls++;
+    g_sDriverDisplay.pfnBlitRotated(g_sDriverDisplay.pvDisplayData, psRect,
+                                    i32X0, i32BPP, pui8Data, i32Stride,
+                                    pui8Palette, ui32Rotation);
+}
+
+static void
+CountRectCopy(void *pvDisplayData, const tRectangle *psRect, int32_t i32X,
+              int32_t i32Y)
+{
+    g_ui64Pixels += ((psRect->i16XMax - psRect->i16XMin + 1) *
+                     (psRect->i16YMax - psRect->i16YMin + 1));
+    g_ui64DriverCalls++;
+    DpyRectCopy(&g_sDriverDisplay, psRect, i32X, i32Y);
+}
+
+static uint32_t
+CountColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    return(DpyColorTranslate(&g_sDriverDisplay, ui32Value));
+}
+
+static void
+CountFlush(void *pvDisplayData)
+{
+    DpyFlush(&g_sDriverDisplay);
+}
+
+//*****************************************************************************
+//
+// Enables or disables counting of the pixels drawn on the frame display.
+//
+//*****************************************************************************
+static void
+FrameCountSet(bool bCount)
+{
+    g_sFrameDisplay = g_sDriverDisplay;
+    if(bCount)
+    {
+        g_sFrameDisplay.pfnPixelDraw = CountPixelDraw;
+        g_sFrameDisplay.pfnPixelDrawMultiple = CountPixelDrawMultiple;
+        g_sFrameDisplay.pfnLineDrawH = CountLineDrawH;
+        g_sFrameDisplay.pfnLineDrawV = CountLineDrawV;
+        g_sFrameDisplay.pfnRectFill = CountRectFill;
+        g_sFrameDisplay.pfnColorTranslate = CountColorTranslate;
+        g_sFrameDisplay.pfnFlush = CountFlush;
+        g_sFrameDisplay.pfnBlit = g_sDriverDisplay.pfnBlit ? CountBlit : 0;
+        g_sFrameDisplay.pfnRectCopy = (g_sDriverDisplay.pfnRectCopy ?
+                                       CountRectCopy : 0);
+        g_sFrameDisplay.pfnBlitRotated = (g_sDriverDisplay.pfnBlitRotated ?
+                                          CountBlitRotated : 0);
+        g_ui64Pixels = 0;
+        g_ui64DriverCalls = 0;
+        g_ui64FlashReads = 0;
+    }
+}
+
+//*****************************************************************************
+//
+// Initializes the frame display to use the frame buffer of the given pixel
+// depth, with pixel counting disabled.
+//
+//*****************************************************************************
+static void
+FrameInit(uint32_t ui32BPP)
+{
+    if(ui32BPP == 16)
+    {
+        GrOffScreen16BPPInit(&g_sDriverDisplay, g_pui8Frame16, WIDTH, HEIGHT);
+    }
+    else
+    {
+        GrOffScreen24BPPInit(&g_sDriverDisplay, g_pui8Frame24, WIDTH, HEIGHT);
+    }
+
+    FrameCountSet(false);
+}
+
+//*****************************************************************************
+//
+// Clears the frame buffer to black.
+//
+//*****************************************************************************
+static void
+FrameClear(void)
+{
+    tContext sContext;
+    tRectangle sRect;
+
+    GrContextInit(&sContext, &g_sFrameDisplay);
+    GrContextForegroundSet(&sContext, ClrBlack);
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 0;
+    sRect.i16XMax = WIDTH - 1;
+    sRect.i16YMax = HEIGHT - 1;
+    GrRectFill(&sContext, &sRect);
+}
+
+//*****************************************************************************
+//
+// Draws a test pattern into an off-screen display, used to generate the
+// uncompressed images.
+//
+//*****************************************************************************
+static void
+PatternDraw(tDisplay *psDisplay)
+{
+    tContext sContext;
+    tRectangle sRect;
+    int32_t i32Idx;
+
+    GrContextInit(&sContext, psDisplay);
+    for(i32Idx = 0; i32Idx < IMG_HEIGHT; i32Idx += 4)
+    {
+        GrContextForegroundSet(&sContext,
+                               g_pui32Colors[(i32Idx / 4) % NUM_COLORS]);
+        sRect.i16XMin = 0;
+        sRect.i16YMin = i32Idx;
+        sRect.i16XMax = IMG_WIDTH - 1;
+        sRect.i16YMax = i32Idx + 3;
+        GrRectFill(&sContext, &sRect);
+    }
+    GrContextForegroundSet(&sContext, ClrBlack);
+    GrCircleFill(&sContext, IMG_WIDTH / 2, IMG_HEIGHT / 2, IMG_HEIGHT / 3);
+    GrContextForegroundSet(&sContext, ClrWhite);
+    GrLineDraw(&sContext, 0, 0, IMG_WIDTH - 1, IMG_HEIGHT - 1);
+    GrLineDraw(&sContext, IMG_WIDTH - 1, 0, 0, IMG_HEIGHT - 1);
+}
+
+//*****************************************************************************
+//
+// Decompresses a complete stream of compressed image data.  This is a simple
+// host implementation of the decoder in grlib/image.c.
+//
+//*****************************************************************************
+static void
+ImageDecompress(const uint8_t *pui8In, uint8_t *pui8Out, uint32_t ui32Count)
+{
+    uint8_t pui8Dictionary[32];
+    uint32_t ui32Idx, ui32Out, ui32Match, ui32Size;
+    int32_t i32Bit;
+    uint8_t ui8Flags;
+
+    memset(pui8Dictionary, 0, sizeof(pui8Dictionary));
+    ui32Idx = 0;
+    ui32Out = 0;
+    while(ui32Out < ui32Count)
+    {
+        ui8Flags = *pui8In++;
+        for(i32Bit = 7; (i32Bit >= 0) && (ui32Out < ui32Count); i32Bit--)
+        {
+            if(!(ui8Flags & (1 << i32Bit)))
+            {
+                pui8Dictionary[ui32Idx] = *pui8In++;
+                pui8Out[ui32Out++] = pui8Dictionary[ui32Idx];
+                ui32Idx = (ui32Idx + 1) % 32;
+                continue;
+            }
+            ui32Match = *pui8In >> 3;
+            ui32Size = (*pui8In++ & 7) + 2;
+            while(ui32Size-- && (ui32Out < ui32Count))
+            {
+                pui8Dictionary[ui32Idx] =
+                    pui8Dictionary[(ui32Idx + ui32Match) % 32];
+                pui8Out[ui32Out++] = pui8Dictionary[ui32Idx];
+                ui32Idx = (ui32Idx + 1) % 32;
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Compresses a block of image data as a single stream, starting with an empty
+// dictionary.  Returns the number of bytes of compressed data.
+//
+//*****************************************************************************
+static uint32_t
+ImageCompress(const uint8_t *pui8In, uint32_t ui32Count, uint8_t *pui8Out)
+{
+    uint32_t ui32Pos, ui32Out, ui32Flags, ui32Len, ui32Best, ui32Dist;
+    uint32_t ui32BestDist;
+    int32_t i32Bit, i32Src;
+
+    ui32Pos = 0;
+    ui32Out = 0;
+    while(ui32Pos < ui32Count)
+    {
+        //
+        // Reserve space for the encoding byte of the next eight items.
+        //
+        ui32Flags = ui32Out++;
+        pui8Out[ui32Flags] = 0;
+        for(i32Bit = 7; (i32Bit >= 0) && (ui32Pos < ui32Count); i32Bit--)
+        {
+            //
+            // Find the longest match within the last 32 bytes, treating the
+            // bytes before the start of the data as zero.
+            //
+            ui32Best = 0;
+            ui32BestDist = 0;
+            for(ui32Dist = 1; ui32Dist <= 32; ui32Dist++)
+            {
+                for(ui32Len = 0;
+                    (ui32Len < 9) && ((ui32Pos + ui32Len) < ui32Count);
+                    ui32Len++)
+                {
+                    i32Src = ui32Pos + ui32Len - ui32Dist;
+                    if(((i32Src < 0) ? 0 : pui8In[i32Src]) !=
+                       pui8In[ui32Pos + ui32Len])
+                    {
+                        break;
+                    }
+                }
+                if(ui32Len > ui32Best)
+                {
+                    ui32Best = ui32Len;
+                    ui32BestDist = ui32Dist;
+                }
+            }
+
+            //
+            // Encode a match of two or more bytes, otherwise a literal.
+            //
+            if(ui32Best >= 2)
+            {
+                pui8Out[ui32Flags] |= 1 << i32Bit;
+                pui8Out[ui32Out++] = ((32 - ui32BestDist) << 3) |
+                                     (ui32Best - 2);
+                ui32Pos += ui32Best;
+            }
+            else
+            {
+                pui8Out[ui32Out++] = pui8In[ui32Pos++];
+            }
+        }
+    }
+
+    return(ui32Out);
+}
+
+//*****************************************************************************
+//
+// Builds a copy of a 1, 4 or 8 BPP image (compressed or not) in the banded
+// compressed format.
+//
+//*****************************************************************************
+static const uint8_t *
+ImageBandedCreate(const uint8_t *pui8Image, uint32_t ui32BandRows)
+{
+    uint32_t ui32BPP, ui32Width, ui32Height, ui32Stride, ui32Header;
+    uint32_t ui32Bands, ui32Band, ui32Rows, ui32Offset;
+    uint8_t *pui8Raw, *pui8Banded, *pui8Table;
+
+    ui32BPP = pui8Image[0] & 0x7f;
+    ui32Width = GrImageWidthGet(pui8Image);
+    ui32Height = GrImageHeightGet(pui8Image);
+    ui32Stride = ((ui32Width * ui32BPP) + 7) / 8;
+    ui32Bands = (ui32Height + ui32BandRows - 1) / ui32BandRows;
+
+    //
+    // The header and palette are copied unchanged.
+    //
+    ui32Header = 5;
+    if(ui32BPP != 1)
+    {
+        ui32Header += (pui8Image[5] * 3) + 4;
+    }
+
+    //
+    // Get the uncompressed image data.
+    //
+    pui8Raw = malloc(ui32Stride * ui32Height);
+    if(pui8Image[0] & 0x80)
+    {
+        ImageDecompress(pui8Image + ui32Header, pui8Raw,
+                        ui32Stride * ui32Height);
+    }
+    else
+    {
+        memcpy(pui8Raw, pui8Image + ui32Header, ui32Stride * ui32Height);
+    }
+
+    //
+    // Allocate enough space for the worst case, where every byte is a
+    // literal, and copy the header.
+    //
+    pui8Banded = malloc(ui32Header + 1 + (ui32Bands * 4) +
+                        (((ui32Stride * ui32BandRows * 9) / 8) + 1) *
+                        ui32Bands);
+    memcpy(pui8Banded, pui8Image, ui32Header);
+    pui8Banded[0] = ui32BPP | 0xc0;
+
+    //
+    // Compress each band, recording its offset from the band size byte.
+    //
+    pui8Table = pui8Banded + ui32Header;
+    pui8Table[0] = ui32BandRows;
+    ui32Offset = 1 + (ui32Bands * 4);
+    for(ui32Band = 0; ui32Band < ui32Bands; ui32Band++)
+    {
+        pui8Table[1 + (ui32Band * 4)] = ui32Offset;
+        pui8Table[2 + (ui32Band * 4)] = ui32Offset >> 8;
+        pui8Table[3 + (ui32Band * 4)] = ui32Offset >> 16;
+        pui8Table[4 + (ui32Band * 4)] = ui32Offset >> 24;
+
+        ui32Rows = ui32Height - (ui32Band * ui32BandRows);
+        if(ui32Rows > ui32BandRows)
+        {
+            ui32Rows = ui32BandRows;
+        }
+        ui32Offset += ImageCompress(pui8Raw +
+                                    (ui32Band * ui32BandRows * ui32Stride),
+                                    ui32Rows * ui32Stride,
+                                    pui8Table + ui32Offset);
+    }
+
+    free(pui8Raw);
+    return(pui8Banded);
+}
+
+//*****************************************************************************
+//
+// Generates the uncompressed images, and the banded copies of the palette
+// based images.
+//
+//*****************************************************************************
+static void
+ImagesInit(void)
+{
+    tDisplay sDisplay;
+    uint32_t ui32Idx;
+
+    GrOffScreen1BPPInit(&sDisplay, g_pui8Image1BPP, IMG_WIDTH, IMG_HEIGHT);
+    PatternDraw(&sDisplay);
+
+    GrOffScreen4BPPInit(&sDisplay, g_pui8Image4BPP, IMG_WIDTH, IMG_HEIGHT);
+    GrOffScreen4BPPPaletteSet(&sDisplay, (uint32_t *)g_pui32Colors, 0,
+                              NUM_COLORS);
+    PatternDraw(&sDisplay);
+
+    GrOffScreen8BPPInit(&sDisplay, g_pui8Image8BPP, IMG_WIDTH, IMG_HEIGHT);
+    GrOffScreen8BPPPaletteSet(&sDisplay, (uint32_t *)g_pui32Colors, 0,
+                              NUM_COLORS);
+    PatternDraw(&sDisplay);
+
+    GrOffScreen16BPPInit(&sDisplay, g_pui8Image16BPP, IMG_WIDTH, IMG_HEIGHT);
+    PatternDraw(&sDisplay);
+
+    GrOffScreen24BPPInit(&sDisplay, g_pui8Image24BPP, IMG_WIDTH, IMG_HEIGHT);
+    PatternDraw(&sDisplay);
+
+    //
+    // Build the banded copies of the palette based images.
+    //
+    for(ui32Idx = 0; ui32Idx < NUM_IMAGES; ui32Idx++)
+    {
+        switch(g_psImages[ui32Idx].pui8Image[0] & 0x7f)
+        {
+            case 1:
+            case 4:
+            case 8:
+            {
+                g_ppui8Banded[ui32Idx] =
+                    ImageBandedCreate(g_psImages[ui32Idx].pui8Image,
+                                      IMG_BAND_ROWS);
+                break;
+            }
+
+            default:
+            {
+                g_ppui8Banded[ui32Idx] = g_psImages[ui32Idx].pui8Image;
+                break;
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Encodes the coverage values of an anti-aliased glyph in the
+// FONT_FMT_AA4_RLE format, returning the number of bytes written.  Runs of no
+// or full coverage and repeated partial coverage are run-length encoded, and
+// other partially covered pixels are stored as literals.
+//
+//*****************************************************************************
+static uint32_t
+FontAAGlyphEncode(const uint8_t *pui8Cov, uint32_t ui32Count,
+                  uint8_t *pui8Out)
+{
+    uint32_t ui32Idx, ui32Run, ui32Len, ui32Pixel;
+    uint8_t ui8Cov;
+
+    for(ui32Idx = 0, ui32Len = 0; ui32Idx < ui32Count; ui32Idx += ui32Run)
+    {
+        //
+        // Find the length of the run of identical coverage values here.
+        //
+        ui8Cov = pui8Cov[ui32Idx];
+        for(ui32Run = 1; (ui32Idx + ui32Run) < ui32Count; ui32Run++)
+        {
+            if(pui8Cov[ui32Idx + ui32Run] != ui8Cov)
+            {
+                break;
+            }
+        }
+
+        if(ui8Cov == 0)
+        {
+            ui32Run = (ui32Run > 63) ? 63 : ui32Run;
+            pui8Out[ui32Len++] = ui32Run;
+        }
+        else if(ui8Cov == 15)
+        {
+            ui32Run = (ui32Run > 64) ? 64 : ui32Run;
+            pui8Out[ui32Len++] = 0x40 | (ui32Run - 1);
+        }
+        else if(ui32Run > 1)
+        {
+            ui32Run = (ui32Run > 4) ? 4 : ui32Run;
+            pui8Out[ui32Len++] = 0xc0 | ((ui32Run - 1) << 4) | ui8Cov;
+        }
+        else
+        {
+            //
+            // Gather the partially covered pixels that follow into a literal.
+            //
+            for(ui32Run = 1; ((ui32Idx + ui32Run) < ui32Count) &&
+                             (ui32Run < 64); ui32Run++)
+            {
+                ui8Cov = pui8Cov[ui32Idx + ui32Run];
+                if((ui8Cov == 0) || (ui8Cov == 15))
+                {
+                    break;
+                }
+            }
+            pui8Out[ui32Len++] = 0x80 | (ui32Run - 1);
+            for(ui32Pixel = 0; ui32Pixel < ui32Run; ui32Pixel += 2)
+            {
+                pui8Out[ui32Len] = pui8Cov[ui32Idx + ui32Pixel] << 4;
+                if((ui32Pixel + 1) < ui32Run)
+                {
+                    pui8Out[ui32Len] |= pui8Cov[ui32Idx + ui32Pixel + 1];
+                }
+                ui32Len++;
+            }
+        }
+    }
+
+    //
+    // Terminate the glyph.
+    //
+    pui8Out[ui32Len++] = 0;
+
+    return(ui32Len);
+}
+
+//*****************************************************************************
+//
+// Builds the anti-aliased font by drawing each glyph of the source font into
+// a 1 BPP buffer and averaging each AA_SCALE by AA_SCALE block of pixels into
+// a 4-bit coverage value.
+//
+//*****************************************************************************
+static void
+FontAAInit(void)
+{
+    uint8_t pui8Cov[(AA_SOURCE_WIDTH / AA_SCALE) *
+                    (AA_SOURCE_HEIGHT / AA_SCALE)];
+    uint32_t ui32Char, ui32Data, ui32Sum, ui32Len;
+    int32_t i32X, i32Y, i32Width, i32Height, i32Bytes, i32Dx, i32Dy;
+    tDisplay sDisplay;
+    tContext sContext;
+    char pcChar[2];
+
+    GrOffScreen1BPPInit(&sDisplay, g_pui8FontAASource, AA_SOURCE_WIDTH,
+                        AA_SOURCE_HEIGHT);
+    GrContextInit(&sContext, &sDisplay);
+    GrContextFontSet(&sContext, &AA_SOURCE_FONT);
+
+    i32Height = (GrFontHeightGet(&AA_SOURCE_FONT) + AA_SCALE - 1) / AA_SCALE;
+    i32Bytes = (AA_SOURCE_WIDTH + 7) / 8;
+    pcChar[1] = 0;
+
+    for(ui32Char = AA_FIRST, ui32Data = 0; ui32Char <= AA_LAST; ui32Char++)
+    {
+        //
+        // Draw the glyph from the source font.
+        //
+        pcChar[0] = ui32Char;
+        GrContextForegroundSet(&sContext, ClrBlack);
+        GrRectFill(&sContext, &sContext.sClipRegion);
+        GrContextForegroundSet(&sContext, ClrWhite);
+        GrStringDraw(&sContext, pcChar, 1, 0, 0, false);
+        i32Width = ((GrStringWidthGet(&sContext, pcChar, 1) + AA_SCALE - 1) /
+                    AA_SCALE);
+
+        //
+        // Compute the coverage of each pixel of the scaled glyph.
+        //
+        for(i32Y = 0; i32Y < i32Height; i32Y++)
+        {
+            for(i32X = 0; i32X < i32Width; i32X++)
+            {
+                for(i32Dy = 0, ui32Sum = 0; i32Dy < AA_SCALE; i32Dy++)
+                {
+                    for(i32Dx = 0; i32Dx < AA_SCALE; i32Dx++)
+                    {
+                        ui32Sum += ((g_pui8FontAASource[5 +
+                            (((i32Y * AA_SCALE) + i32Dy) * i32Bytes) +
+                            (((i32X * AA_SCALE) + i32Dx) / 8)] >>
+                            (7 - (((i32X * AA_SCALE) + i32Dx) & 7))) & 1);
+                    }
+                }
+                pui8Cov[(i32Y * i32Width) + i32X] =
+                    ((ui32Sum * 15) + ((AA_SCALE * AA_SCALE) / 2)) /
+                    (AA_SCALE * AA_SCALE);
+            }
+        }
+
+        //
+        // Encode the glyph.
+        //
+        g_pui16FontAAOffset[ui32Char - AA_FIRST] = ui32Data;
+        ui32Len = FontAAGlyphEncode(pui8Cov, i32Width * i32Height,
+                                    g_pui8FontAAData + ui32Data + 2) + 2;
+        g_pui8FontAAData[ui32Data] = (ui32Len > 255) ? 255 : ui32Len;
+        g_pui8FontAAData[ui32Data + 1] = i32Width;
+        ui32Data += ui32Len;
+    }
+
+    g_sFontAA.ui8Format = FONT_FMT_EX_AA4_RLE;
+    g_sFontAA.ui8MaxWidth = ((GrFontMaxWidthGet(&AA_SOURCE_FONT) +
+                              AA_SCALE - 1) / AA_SCALE);
+    g_sFontAA.ui8Height = i32Height;
+    g_sFontAA.ui8Baseline = GrFontBaselineGet(&AA_SOURCE_FONT) / AA_SCALE;
+    g_sFontAA.ui8First = AA_FIRST;
+    g_sFontAA.ui8Last = AA_LAST;
+    g_sFontAA.pui16Offset = g_pui16FontAAOffset;
+    g_sFontAA.pui8Data = g_pui8FontAAData;
+}
+
+//*****************************************************************************
+//
+// Builds the wide font.  The glyphs of the source font are copied after the
+// offset tables, and each codepoint of the font uses one of them; every
+// sixteenth codepoint is left out of the font.
+//
+//*****************************************************************************
+static void
+FontWideInit(void)
+{
+    const uint8_t *ppui8Glyph[WIDE_GLYPHS], *pui8Glyph;
+    uint32_t ui32Block, ui32Char, ui32Idx, ui32Glyph;
+    tFontBlock *psBlock;
+    tFontWide *psFont;
+    uint32_t *pui32Table;
+    uint8_t *pui8Data;
+    uint8_t ui8Width;
+
+    psFont = (tFontWide *)g_pui32FontWide;
+    psBlock = (tFontBlock *)(psFont + 1);
+    pui32Table = (uint32_t *)(psBlock + WIDE_BLOCKS);
+    pui8Data = (uint8_t *)(pui32Table + (WIDE_BLOCKS * WIDE_BLOCK_CHARS));
+
+    //
+    // Copy the glyphs of the source font.
+    //
+    for(ui32Glyph = 0; ui32Glyph < WIDE_GLYPHS; ui32Glyph++)
+    {
+        pui8Glyph = GrFontGlyphDataGet(&WIDE_SOURCE_FONT, 0x20 + ui32Glyph,
+                                       &ui8Width);
+        ppui8Glyph[ui32Glyph] = pui8Data;
+        for(ui32Idx = 0; ui32Idx < pui8Glyph[0]; ui32Idx++)
+        {
+            *pui8Data++ = pui8Glyph[ui32Idx];
+        }
+    }
+    if(pui8Data > (uint8_t *)(g_pui32FontWide + (sizeof(g_pui32FontWide) /
+                                                 sizeof(uint32_t))))
+    {
+        fprintf(stderr, "Wide font buffer overflow\n");
+        exit(1);
+    }
+
+    //
+    // Fill in the block table and the offset table of each block.
+    //
+    for(ui32Block = 0; ui32Block < WIDE_BLOCKS; ui32Block++)
+    {
+        psBlock[ui32Block].ui32StartCodepoint = (WIDE_FIRST +
+                                                 (ui32Block *
+                                                  WIDE_BLOCK_STEP));
+        psBlock[ui32Block].ui32NumCodepoints = WIDE_BLOCK_CHARS;
+        psBlock[ui32Block].ui32GlyphTableOffset =
+            (uint8_t *)pui32Table - (uint8_t *)psFont;
+        for(ui32Char = 0; ui32Char < WIDE_BLOCK_CHARS; ui32Char++)
+        {
+            ui32Glyph = ui32Block + ui32Char;
+            pui32Table[ui32Char] = (((ui32Glyph % 16) == 15) ? 0 :
+                                    (ppui8Glyph[ui32Glyph % WIDE_GLYPHS] -
+                                     (uint8_t *)pui32Table));
+        }
+        pui32Table += WIDE_BLOCK_CHARS;
+    }
+
+    psFont->ui8Format = FONT_FMT_WIDE_PIXEL_RLE;
+    psFont->ui8MaxWidth = GrFontMaxWidthGet(&WIDE_SOURCE_FONT);
+    psFont->ui8Height = GrFontHeightGet(&WIDE_SOURCE_FONT);
+    psFont->ui8Baseline = GrFontBaselineGet(&WIDE_SOURCE_FONT);
+    psFont->ui16Codepage = CODEPAGE_UNICODE;
+    psFont->ui16NumBlocks = WIDE_BLOCKS;
+
+    //
+    // The font's block table is sorted, so the index needs no storage.
+    //
+    GrFontIndexInit(&g_sFontIndex, 0, 0);
+}
+
+//*****************************************************************************
+//
+// Selects the wide font, or the wrapped copy of it, into a context,
+// converting strings from UTF-8 and optionally using the font block index.
+//
+//*****************************************************************************
+static void
+FontWideSet(tContext *psContext, const tFont *psFont, bool bIndexed)
+{
+    GrCodepageMapTableSet(psContext, g_psWideCodePointMap, 1);
+    GrStringCodepageSet(psContext, CODEPAGE_UTF_8);
+    GrContextFontIndexSet(psContext, bIndexed ? &g_sFontIndex : 0);
+    GrContextFontSet(psContext, psFont);
+}
+
+//*****************************************************************************
+//
+// Builds a UTF-8 string of WIDE_STRING_CHARS codepoints of the wide font,
+// starting at the given codepoint and advancing by the given step.
+//
+//*****************************************************************************
+static void
+FontWideStringMake(char *pcString, uint32_t ui32CodePoint, uint32_t ui32Step)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < WIDE_STRING_CHARS; ui32Idx++)
+    {
+        *pcString++ = 0xe0 | (ui32CodePoint >> 12);
+        *pcString++ = 0x80 | ((ui32CodePoint >> 6) & 0x3f);
+        *pcString++ = 0x80 | (ui32CodePoint & 0x3f);
+        ui32CodePoint += ui32Step;
+    }
+    *pcString = 0;
+}
+
+//*****************************************************************************
+//
+// The SPI flash and FAT file system functions used by the cached font
+// wrapper.  The SPI flash holds only the wide font, and there is no FAT file
+// system.
+//
+//*****************************************************************************
+void
+SPIFlashRead(uint32_t ui32Base, uint32_t ui32Addr, uint8_t *pui8Data,
+             uint32_t ui32Count)
+{
+    const uint8_t *pui8Font;
+
+    g_ui64FlashReads++;
+    pui8Font = (const uint8_t *)g_pui32FontWide;
+    for(; ui32Count; ui32Count--, ui32Addr++)
+    {
+        *pui8Data++ = (((ui32Addr >= FLASH_FONT_ADDR) &&
+                        ((ui32Addr - FLASH_FONT_ADDR) <
+                         sizeof(g_pui32FontWide))) ?
+                       pui8Font[ui32Addr - FLASH_FONT_ADDR] : 0xff);
+    }
+}
+
+FRESULT
+f_open(FIL *psFile, const TCHAR *pcPath, BYTE ui8Mode)
+{
+    return(FR_NO_FILE);
+}
+
+FRESULT
+f_read(FIL *psFile, void *pvBuffer, UINT uiCount, UINT *puiRead)
+{
+    return(FR_INVALID_OBJECT);
+}
+
+FRESULT
+f_lseek(FIL *psFile, DWORD ui32Offset)
+{
+    return(FR_INVALID_OBJECT);
+}
+
+FRESULT
+f_close(FIL *psFile)
+{
+    return(FR_INVALID_OBJECT);
+}
+
+//*****************************************************************************
+//
+// Loads the wrapped font from the simulated SPI flash, starting with an
+// empty glyph cache.
+//
+//*****************************************************************************
+static void
+FontWrappedLoad(void)
+{
+    if(g_sFontWrapped.pui8FontId)
+    {
+        FontWrapperUnload(g_sFontWrapped.pui8FontId);
+    }
+    g_sFontWrapped.ui8Format = FONT_FMT_WRAPPED;
+    g_sFontWrapped.pFuncs = &g_sFontWrapperAccessFuncs;
+    g_sFontWrapped.pui8FontId =
+        FontWrapperSPIFlashLoad(&g_sFontWrapperData, FLASH_SSI_BASE,
+                                FLASH_FONT_ADDR, g_pui32FontWrapperBuffer,
+                                sizeof(g_pui32FontWrapperBuffer));
+    if(!g_sFontWrapped.pui8FontId)
+    {
+        fprintf(stderr, "Unable to load the wrapped font\n");
+        exit(1);
+    }
+}
+
+//*****************************************************************************
+//
+// A simple pseudo-random number generator, so that the workload is identical
+// on every host.
+//
+//*****************************************************************************
+static uint32_t g_ui32Seed;
+
+static uint32_t
+Random(uint32_t ui32Range)
+{
+    g_ui32Seed = (g_ui32Seed * 1664525) + 1013904223;
+    return((g_ui32Seed >> 8) % ui32Range);
+}
+
+//*****************************************************************************
+//
+// The benchmark workloads.  Each performs one call of the primitive being
+// measured, varying the parameters based on the iteration number.
+//
+//*****************************************************************************
+static void
+WorkStringDraw(tContext *psContext, uint32_t ui32Iter)
+{
+    const tFontEntry *psEntry;
+
+    psEntry = &g_psFonts[ui32Iter % NUM_FONTS];
+    GrContextFontSet(psContext, psEntry->psFont);
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrStringDraw(psContext, "Tiva Graphics", -1, Random(WIDTH) - 40,
+                 Random(HEIGHT) - 10, false);
+}
+
+static void
+WorkStringDrawOpaque(tContext *psContext, uint32_t ui32Iter)
+{
+    const tFontEntry *psEntry;
+
+    psEntry = &g_psFonts[ui32Iter % NUM_FONTS];
+    GrContextFontSet(psContext, psEntry->psFont);
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrContextBackgroundSet(psContext, ClrNavy);
+    GrStringDraw(psContext, "Tiva Graphics", -1, Random(WIDTH) - 40,
+                 Random(HEIGHT) - 10, true);
+}
+
+static void
+WorkStringDrawCached(tContext *psContext, uint32_t ui32Iter)
+{
+    if(ui32Iter == 0)
+    {
+        GrGlyphCacheInit(&g_sGlyphCache, g_pui32GlyphCache,
+                         sizeof(g_pui32GlyphCache), GLYPH_CACHE_RUNS,
+                         g_pui16GlyphHash,
+                         sizeof(g_pui16GlyphHash) / sizeof(uint16_t));
+    }
+    GrContextGlyphCacheSet(psContext, &g_sGlyphCache);
+    WorkStringDraw(psContext, ui32Iter);
+    GrContextGlyphCacheSet(psContext, 0);
+}
+
+static void
+WorkStringDrawFont(tContext *psContext, uint32_t ui32Iter,
+                   const tFont *psFont, bool bOpaque)
+{
+    GrContextFontSet(psContext, psFont);
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrContextBackgroundSet(psContext, ClrNavy);
+    GrStringDraw(psContext, "Tiva Graphics", -1, Random(WIDTH) - 40,
+                 Random(HEIGHT) - 10, bOpaque);
+}
+
+static void
+WorkStringDraw16(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawFont(psContext, ui32Iter, &AA_COMPARE_FONT, false);
+}
+
+static void
+WorkStringDraw16Opaque(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawFont(psContext, ui32Iter, &AA_COMPARE_FONT, true);
+}
+
+static void
+WorkStringDrawAA(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawFont(psContext, ui32Iter, (tFont *)&g_sFontAA, false);
+}
+
+static void
+WorkStringDrawAAOpaque(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawFont(psContext, ui32Iter, (tFont *)&g_sFontAA, true);
+}
+
+static void
+WorkGlyphLookupWide(tContext *psContext, uint32_t ui32Iter)
+{
+    uint8_t ui8Width;
+
+    GrFontGlyphDataGet((tFont *)g_pui32FontWide,
+                       WIDE_FIRST + Random(WIDE_BLOCKS * WIDE_BLOCK_STEP),
+                       &ui8Width);
+}
+
+static void
+WorkGlyphLookupWideIndexed(tContext *psContext, uint32_t ui32Iter)
+{
+    uint8_t ui8Width;
+
+    if(ui32Iter == 0)
+    {
+        GrFontIndexBuild(&g_sFontIndex, (tFont *)g_pui32FontWide);
+    }
+    GrFontIndexGlyphDataGet(&g_sFontIndex, (tFont *)g_pui32FontWide,
+                            WIDE_FIRST + Random(WIDE_BLOCKS * WIDE_BLOCK_STEP),
+                            &ui8Width);
+}
+
+static void
+WorkStringDrawWideFont(tContext *psContext, uint32_t ui32Iter,
+                       const tFont *psFont, bool bIndexed, bool bPrefetch)
+{
+    char pcString[(WIDE_STRING_CHARS * 3) + 1];
+
+    if(ui32Iter == 0)
+    {
+        if(psFont == (tFont *)&g_sFontWrapped)
+        {
+            FontWrappedLoad();
+        }
+        FontWideSet(psContext, psFont, bIndexed);
+    }
+    FontWideStringMake(pcString, (WIDE_FIRST +
+                                  (Random(WIDE_BLOCKS) * WIDE_BLOCK_STEP)), 1);
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    if(bPrefetch)
+    {
+        FontWrapperPrefetch(psContext, pcString, -1);
+    }
+    GrStringDraw(psContext, pcString, -1, Random(WIDTH) - 40,
+                 Random(HEIGHT) - 10, false);
+}
+
+static void
+WorkStringDrawWide(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawWideFont(psContext, ui32Iter, (tFont *)g_pui32FontWide,
+                           false, false);
+}
+
+static void
+WorkStringDrawWideIndexed(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawWideFont(psContext, ui32Iter, (tFont *)g_pui32FontWide,
+                           true, false);
+}
+
+static void
+WorkStringDrawWrapped(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawWideFont(psContext, ui32Iter, (tFont *)&g_sFontWrapped,
+                           false, false);
+}
+
+static void
+WorkStringDrawWrappedPrefetch(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringDrawWideFont(psContext, ui32Iter, (tFont *)&g_sFontWrapped,
+                           false, true);
+}
+
+static void
+WorkImageDraw(tContext *psContext, uint32_t ui32Iter, const char *pcFormat)
+{
+    uint32_t ui32Idx, ui32Count;
+
+    //
+    // Cycle through the images of the requested format.
+    //
+    for(ui32Idx = 0, ui32Count = 0; ui32Idx < NUM_IMAGES; ui32Idx++)
+    {
+        if(!strcmp(g_psImages[ui32Idx].pcName, pcFormat))
+        {
+            ui32Count++;
+        }
+    }
+    ui32Iter %= ui32Count;
+    for(ui32Idx = 0; ui32Idx < NUM_IMAGES; ui32Idx++)
+    {
+        if(!strcmp(g_psImages[ui32Idx].pcName, pcFormat) &&
+           (ui32Iter-- == 0))
+        {
+            break;
+        }
+    }
+
+    GrContextForegroundSet(psContext, ClrYellow);
+    GrContextBackgroundSet(psContext, ClrDarkBlue);
+    GrImageDraw(psContext, g_psImages[ui32Idx].pui8Image, Random(WIDTH) - 20,
+                Random(HEIGHT) - 20);
+}
+
+static void
+WorkImageDraw1BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "1bpp");
+}
+
+static void
+WorkImageDraw4BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "4bpp");
+}
+
+static void
+WorkImageDraw8BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "8bpp");
+}
+
+static void
+WorkImageDraw16BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "16bpp");
+}
+
+static void
+WorkImageDraw16BPPNoBlit(tContext *psContext, uint32_t ui32Iter)
+{
+    void (*pfnBlit)(void *, const tRectangle *, int32_t, int32_t,
+                    const uint8_t *, int32_t, const uint8_t *);
+
+    //
+    // Draw the image with the blit function removed from the display, so
+    // that it is drawn a row at a time.
+    //
+    pfnBlit = g_sFrameDisplay.pfnBlit;
+    g_sFrameDisplay.pfnBlit = 0;
+    WorkImageDraw(psContext, ui32Iter, "16bpp");
+    g_sFrameDisplay.pfnBlit = pfnBlit;
+}
+
+static void
+WorkImageDraw24BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "24bpp");
+}
+
+static void
+WorkImageDraw4BPPComp(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "4bpp_comp");
+}
+
+static void
+WorkImageDraw8BPPComp(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDraw(psContext, ui32Iter, "8bpp_comp");
+}
+
+static void
+WorkImageDrawClipped(tContext *psContext, const uint8_t *pui8Image)
+{
+    //
+    // Draw the image with only its bottom 16 rows on the screen.
+    //
+    GrImageDraw(psContext, pui8Image, Random(WIDTH) - 20,
+                16 - GrImageHeightGet(pui8Image));
+}
+
+static void
+WorkImageDraw8BPPCompClipped(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDrawClipped(psContext, g_pui8GettingHotter28x148);
+}
+
+static void
+WorkImageDraw8BPPBandClipped(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkImageDrawClipped(psContext, g_ppui8Banded[8]);
+}
+
+static void
+WorkTransparentImageDraw(tContext *psContext, uint32_t ui32Iter)
+{
+    GrTransparentImageDraw(psContext, g_ui8Logo, Random(WIDTH) - 20,
+                           Random(HEIGHT) - 20, 0);
+}
+
+static void
+WorkRectCopy(tContext *psContext, uint32_t ui32Iter)
+{
+    tRectangle sRect;
+
+    //
+    // Scroll a region of the screen by a varying amount in each direction.
+    //
+    sRect.i16XMin = Random(WIDTH / 2);
+    sRect.i16YMin = Random(HEIGHT / 2);
+    sRect.i16XMax = sRect.i16XMin + (WIDTH / 2) - 1;
+    sRect.i16YMax = sRect.i16YMin + (HEIGHT / 2) - 1;
+    GrRectCopy(psContext, &sRect, sRect.i16XMin + Random(33) - 16,
+               sRect.i16YMin + Random(33) - 16);
+}
+
+static void
+WorkCircleFill(tContext *psContext, uint32_t ui32Iter)
+{
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrCircleFill(psContext, Random(WIDTH), Random(HEIGHT), Random(60) + 1);
+}
+
+static void
+WorkCircleDraw(tContext *psContext, uint32_t ui32Iter)
+{
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrCircleDraw(psContext, Random(WIDTH), Random(HEIGHT), Random(60) + 1);
+}
+
+static void
+WorkLineDraw(tContext *psContext, uint32_t ui32Iter)
+{
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrLineDraw(psContext, Random(WIDTH + 40) - 20, Random(HEIGHT + 40) - 20,
+               Random(WIDTH + 40) - 20, Random(HEIGHT + 40) - 20);
+}
+
+static void
+WorkArcDraw(tContext *psContext, uint32_t ui32Iter)
+{
+    int32_t i32Start;
+
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    i32Start = Random(360);
+    GrArcDraw(psContext, Random(WIDTH), Random(HEIGHT), Random(60) + 1,
+              i32Start, i32Start + Random(360) + 1);
+}
+
+static void
+WorkPolygonFill(tContext *psContext, uint32_t ui32Iter)
+{
+    tPoint psPoints[6];
+    uint32_t ui32Idx;
+    int32_t i32X, i32Y;
+
+    //
+    // Fill a random hexagon, which is often concave or self-intersecting.
+    //
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    i32X = Random(WIDTH) - 20;
+    i32Y = Random(HEIGHT) - 20;
+    for(ui32Idx = 0; ui32Idx < 6; ui32Idx++)
+    {
+        psPoints[ui32Idx].i16X = i32X + Random(80);
+        psPoints[ui32Idx].i16Y = i32Y + Random(80);
+    }
+    GrPolygonFill(psContext, psPoints, 6);
+}
+
+static void
+WorkRoundRectFill(tContext *psContext, uint32_t ui32Iter)
+{
+    tRectangle sRect;
+
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    sRect.i16XMin = Random(WIDTH) - 20;
+    sRect.i16YMin = Random(HEIGHT) - 20;
+    sRect.i16XMax = sRect.i16XMin + Random(100);
+    sRect.i16YMax = sRect.i16YMin + Random(100);
+    GrRoundRectFill(psContext, &sRect, Random(16));
+}
+
+static void
+WorkLineDrawH(tContext *psContext, uint32_t ui32Iter)
+{
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrLineDrawH(psContext, Random(WIDTH), Random(WIDTH), Random(HEIGHT));
+}
+
+static void
+WorkLineDrawV(tContext *psContext, uint32_t ui32Iter)
+{
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    GrLineDrawV(psContext, Random(WIDTH), Random(HEIGHT), Random(HEIGHT));
+}
+
+static void
+WorkRectFill(tContext *psContext, uint32_t ui32Iter)
+{
+    tRectangle sRect;
+
+    GrContextForegroundSet(psContext, g_pui32Colors[ui32Iter % NUM_COLORS]);
+    sRect.i16XMin = Random(WIDTH) - 20;
+    sRect.i16YMin = Random(HEIGHT) - 20;
+    sRect.i16XMax = sRect.i16XMin + Random(100);
+    sRect.i16YMax = sRect.i16YMin + Random(100);
+    GrRectFill(psContext, &sRect);
+}
+
+static void
+WorkWidgetPaint(tContext *psContext, uint32_t ui32Iter)
+{
+    WidgetPaint(WIDGET_ROOT);
+    WidgetMessageQueueProcess();
+}
+
+static void
+WorkWidgetInvalidate(tContext *psContext, uint32_t ui32Iter)
+{
+    WidgetInvalidate((tWidget *)&g_sSlider, 0);
+    WidgetMessageQueueProcess();
+}
+
+static void
+WorkListBoxScroll(tContext *psContext, uint32_t ui32Iter)
+{
+    //
+    // Scroll the log one line at a time, one hundred lines up and then one
+    // hundred lines down.
+    //
+    if(ui32Iter == 0)
+    {
+        LogBoxInit();
+        WidgetPaint((tWidget *)&g_sLogBox);
+        WidgetMessageQueueProcess();
+    }
+    LogBoxDrag(((ui32Iter / 100) & 1) ? -1 : 1);
+    WidgetMessageQueueProcess();
+}
+
+static void
+WorkListBoxScrollNoCopy(tContext *psContext, uint32_t ui32Iter)
+{
+    //
+    // The same, on a display which can not copy pixels so that the listbox is
+    // repainted for every line scrolled.
+    //
+    g_sFrameDisplay.pfnRectCopy = 0;
+    WorkListBoxScroll(psContext, ui32Iter);
+}
+
+static void
+WorkKeyboardTap(tContext *psContext, uint32_t ui32Iter)
+{
+    uint32_t ui32Key, ui32Code;
+
+    //
+    // Tap the keys of the lower case keyboard in turn, other than those which
+    // change the keyboard.
+    //
+    if(ui32Iter == 0)
+    {
+        OnScreenKeyboardInit();
+        WidgetPaint((tWidget *)&g_sKeyboard);
+        WidgetMessageQueueProcess();
+    }
+    ui32Key = ui32Iter % g_psKeyboardUSEnglish[0].ui16NumKeys;
+    ui32Code = g_psKeyboardUSEnglish[0].uKeys.psKeysText[ui32Key].ui32Code;
+    if((ui32Code != UNICODE_CUSTOM_SHIFT) &&
+       (ui32Code != UNICODE_CUSTOM_MODE_TOG))
+    {
+        OnScreenKeyboardTap(ui32Key);
+        g_ui32KeyboardTextLen = 0;
+    }
+}
+
+static void
+WorkKeyboardShift(tContext *psContext, uint32_t ui32Iter)
+{
+    //
+    // Tap the shift key, which cycles between the lower case, upper case and
+    // caps lock keyboards.
+    //
+    if(ui32Iter == 0)
+    {
+        OnScreenKeyboardInit();
+        WidgetPaint((tWidget *)&g_sKeyboard);
+        WidgetMessageQueueProcess();
+    }
+    OnScreenKeyboardTap(19);
+}
+
+static void
+WorkKeyboardPointerMove(tContext *psContext, uint32_t ui32Iter)
+{
+    //
+    // Move the pointer around the keyboard, which only has to find the key
+    // under the pointer.
+    //
+    if(ui32Iter == 0)
+    {
+        OnScreenKeyboardInit();
+    }
+    KeyboardMsgProc((tWidget *)&g_sKeyboard, WIDGET_MSG_PTR_MOVE,
+                    Random(WIDTH), 120 + Random(120));
+}
+
+static void
+WorkTrendChart(tContext *psContext, uint32_t ui32Iter, bool bOffscreen,
+               uint16_t ui16Decimation)
+{
+    //
+    // Add a sample to the chart, which scrolls it every ui16Decimation
+    // samples.
+    //
+    if(ui32Iter == 0)
+    {
+        ChartInit(bOffscreen, ui16Decimation);
+        WidgetPaint((tWidget *)&g_sChart);
+        WidgetMessageQueueProcess();
+    }
+    ChartSampleAdd(ui32Iter);
+}
+
+static void
+WorkTrendChartSample(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkTrendChart(psContext, ui32Iter, false, 1);
+}
+
+static void
+WorkTrendChartDecimated(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkTrendChart(psContext, ui32Iter, false, 8);
+}
+
+static void
+WorkTrendChartOffscreen(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkTrendChart(psContext, ui32Iter, true, 1);
+}
+
+//
+// Returns the index of the string to retrieve in a string benchmark, changing
+// the language now and then.  The strings are those of a "screen" of six
+// strings, which changes every 256 strings, as the strings of the widgets on
+// a screen would be retrieved each time that the screen is repainted.
+//
+static uint32_t
+StringIndexGet(uint32_t ui32Iter)
+{
+    if((ui32Iter % 1024) == 0)
+    {
+        GrStringLanguageSet(g_sTablelanguage_ex.pui16Languages[
+                                (ui32Iter / 1024) %
+                                g_sTablelanguage_ex.ui16NumLanguages]);
+    }
+    return((((ui32Iter / 256) * 5) + Random(6)) %
+           g_sTablelanguage_ex.ui16NumStrings);
+}
+
+static void
+WorkStringGet(tContext *psContext, uint32_t ui32Iter, bool bExtended,
+              bool bCached)
+{
+    char pcBuffer[SCOMP_MAX_STRLEN];
+
+    if(ui32Iter == 0)
+    {
+        StringTableSelect(bExtended, bCached);
+    }
+
+    GrStringGet(StringIndexGet(ui32Iter), pcBuffer, sizeof(pcBuffer));
+}
+
+static void
+WorkStringGetLegacy(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringGet(psContext, ui32Iter, false, false);
+}
+
+static void
+WorkStringGetExtended(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringGet(psContext, ui32Iter, true, false);
+}
+
+static void
+WorkStringGetCached(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkStringGet(psContext, ui32Iter, true, true);
+}
+
+static void
+WorkStringCachedGet(tContext *psContext, uint32_t ui32Iter)
+{
+    if(ui32Iter == 0)
+    {
+        StringTableSelect(true, true);
+    }
+    GrStringCachedGet(StringIndexGet(ui32Iter));
+}
+
+static void
+WorkRotated(tContext *psContext, uint32_t ui32Iter,
+            void (*pfnWork)(tContext *psContext, uint32_t ui32Iter))
+{
+    tContext sContext;
+
+    //
+    // Perform the work on a portrait display drawn into the frame buffer.
+    //
+    GrRotatedDisplayInit(&g_sRotatedDisplay, &g_sRotated, psContext->psDisplay,
+                         GRLIB_ROTATE_90);
+    GrContextInit(&sContext, &g_sRotatedDisplay);
+    pfnWork(&sContext, ui32Iter);
+}
+
+static void
+WorkStringDrawRotated(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkRotated(psContext, ui32Iter, WorkStringDraw);
+}
+
+static void
+WorkImageDraw16BPPRotated(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkRotated(psContext, ui32Iter, WorkImageDraw16BPP);
+}
+
+static void
+WorkRectFillRotated(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkRotated(psContext, ui32Iter, WorkRectFill);
+}
+
+static void
+WorkOffScreenBlit(tContext *psContext, uint32_t ui32Iter, uint32_t ui32BPP)
+{
+    //
+    // Copy the test image of the given depth into the frame buffer.
+    //
+    BlitDisplayInit(&g_sBlitSource, BlitImageGet(ui32BPP), ui32BPP,
+                    IMG_WIDTH, IMG_HEIGHT);
+    GrOffScreenBlit(&g_sDriverDisplay, &g_sBlitSource, 0, Random(WIDTH) - 20,
+                    Random(HEIGHT) - 20);
+}
+
+static void
+WorkOffScreenBlit8BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkOffScreenBlit(psContext, ui32Iter, 8);
+}
+
+static void
+WorkOffScreenBlit16BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkOffScreenBlit(psContext, ui32Iter, 16);
+}
+
+static void
+WorkOffScreenBlit24BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkOffScreenBlit(psContext, ui32Iter, 24);
+}
+
+static void
+WorkForegroundSet(tContext *psContext, uint32_t ui32Iter, bool bCached)
+{
+    if(ui32Iter == 0)
+    {
+        PaletteDisplayInit(8, bCached);
+    }
+    GrContextForegroundSet(&g_sPaletteContext,
+                           g_pui32WidgetColors[ui32Iter % NUM_WIDGET_COLORS]);
+}
+
+static void
+WorkForegroundSet8BPP(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkForegroundSet(psContext, ui32Iter, false);
+}
+
+static void
+WorkForegroundSet8BPPCached(tContext *psContext, uint32_t ui32Iter)
+{
+    WorkForegroundSet(psContext, ui32Iter, true);
+}
+
+//*****************************************************************************
+//
+// The table of benchmarks.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *pcName;
+    void (*pfnWork)(tContext *psContext, uint32_t ui32Iter);
+}
+tBenchmark;
+
+static const tBenchmark g_psBenchmarks[] =
+{
+    { "GrStringDraw", WorkStringDraw },
+    { "GrStringDraw (opaque)", WorkStringDrawOpaque },
+    { "GrStringDraw (cached)", WorkStringDrawCached },
+    { "GrStringDraw Cmss16", WorkStringDraw16 },
+    { "GrStringDraw Cmss16 (opaque)", WorkStringDraw16Opaque },
+    { "GrStringDraw AA16", WorkStringDrawAA },
+    { "GrStringDraw AA16 (opaque)", WorkStringDrawAAOpaque },
+    { "GrFontGlyphDataGet wide", WorkGlyphLookupWide },
+    { "GrFontIndexGlyphDataGet wide", WorkGlyphLookupWideIndexed },
+    { "GrStringDraw wide", WorkStringDrawWide },
+    { "GrStringDraw wide (indexed)", WorkStringDrawWideIndexed },
+    { "GrStringDraw wrapped", WorkStringDrawWrapped },
+    { "GrStringDraw wrapped (prefetch)", WorkStringDrawWrappedPrefetch },
+    { "GrImageDraw 1bpp", WorkImageDraw1BPP },
+    { "GrImageDraw 4bpp", WorkImageDraw4BPP },
+    { "GrImageDraw 8bpp", WorkImageDraw8BPP },
+    { "GrImageDraw 16bpp", WorkImageDraw16BPP },
+    { "GrImageDraw 16bpp no blit", WorkImageDraw16BPPNoBlit },
+    { "GrImageDraw 24bpp", WorkImageDraw24BPP },
+    { "GrImageDraw 4bpp comp", WorkImageDraw4BPPComp },
+    { "GrImageDraw 8bpp comp", WorkImageDraw8BPPComp },
+    { "GrImageDraw 8bpp comp clip", WorkImageDraw8BPPCompClipped },
+    { "GrImageDraw 8bpp band clip", WorkImageDraw8BPPBandClipped },
+    { "GrTransparentImageDraw", WorkTransparentImageDraw },
+    { "GrCircleFill", WorkCircleFill },
+    { "GrCircleDraw", WorkCircleDraw },
+    { "GrArcDraw", WorkArcDraw },
+    { "GrLineDraw", WorkLineDraw },
+    { "GrLineDrawH", WorkLineDrawH },
+    { "GrLineDrawV", WorkLineDrawV },
+    { "GrRectFill", WorkRectFill },
+    { "GrRoundRectFill", WorkRoundRectFill },
+    { "GrPolygonFill", WorkPolygonFill },
+    { "GrRectCopy", WorkRectCopy },
+    { "WidgetPaint", WorkWidgetPaint },
+    { "WidgetInvalidate (slider)", WorkWidgetInvalidate },
+    { "ListBox scroll (data source)", WorkListBoxScroll },
+    { "ListBox scroll (no copy)", WorkListBoxScrollNoCopy },
+    { "Keyboard key tap", WorkKeyboardTap },
+    { "Keyboard shift", WorkKeyboardShift },
+    { "Keyboard pointer move", WorkKeyboardPointerMove },
+    { "TrendChart sample", WorkTrendChartSample },
+    { "TrendChart sample (1/8 columns)", WorkTrendChartDecimated },
+    { "TrendChart sample (off-screen)", WorkTrendChartOffscreen },
+    { "GrStringDraw (rotated 90)", WorkStringDrawRotated },
+    { "GrImageDraw 16bpp (rotated 90)", WorkImageDraw16BPPRotated },
+    { "GrRectFill (rotated 90)", WorkRectFillRotated },
+    { "GrOffScreenBlit 8bpp", WorkOffScreenBlit8BPP },
+    { "GrOffScreenBlit 16bpp", WorkOffScreenBlit16BPP },
+    { "GrOffScreenBlit 24bpp", WorkOffScreenBlit24BPP },
+    { "GrContextForegroundSet 8bpp", WorkForegroundSet8BPP },
+    { "GrContextForegroundSet (cached)", WorkForegroundSet8BPPCached },
+    { "GrStringGet (legacy table)", WorkStringGetLegacy },
+    { "GrStringGet (extended table)", WorkStringGetExtended },
+    { "GrStringGet (cached)", WorkStringGetCached },
+    { "GrStringCachedGet", WorkStringCachedGet },
+};
+
+#define NUM_BENCHMARKS          (sizeof(g_psBenchmarks) /                     \
+                                 sizeof(g_psBenchmarks[0]))
+
+//*****************************************************************************
+//
+// Returns the current time in seconds.
+//
+//*****************************************************************************
+static double
+TimeGet(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return((double)sTime.tv_sec + ((double)sTime.tv_nsec / 1e9));
+}
+
+//*****************************************************************************
+//
+// Runs each benchmark for the given number of seconds and prints the results.
+// The timed run draws directly into the frame buffer; the number of pixels is
+// then determined by repeating the same calls with pixel counting enabled.
+//
+//*****************************************************************************
+static void
+BenchmarksRun(uint32_t ui32BPP, double dDuration)
+{
+    tContext sContext;
+    uint32_t ui32Idx, ui32Iter, ui32Calls;
+    double dStart, dElapsed;
+
+    printf("%u BPP frame buffer, %dx%d\n\n", ui32BPP, WIDTH, HEIGHT);
+    printf("%-31s %12s %14s %12s %12s %11s\n", "Primitive", "Calls/s",
+           "Pixels/s", "Pixels/call", "Driver/call", "Reads/call");
+
+    for(ui32Idx = 0; ui32Idx < NUM_BENCHMARKS; ui32Idx++)
+    {
+        //
+        // Run the benchmark in batches until the duration has elapsed.
+        //
+        FrameInit(ui32BPP);
+        FrameClear();
+        GrContextInit(&sContext, &g_sFrameDisplay);
+        g_ui32Seed = 1;
+        ui32Calls = 0;
+        dStart = TimeGet();
+        do
+        {
+            for(ui32Iter = 0; ui32Iter < 16; ui32Iter++, ui32Calls++)
+            {
+                g_psBenchmarks[ui32Idx].pfnWork(&sContext, ui32Calls);
+            }
+            dElapsed = TimeGet() - dStart;
+        }
+        while(dElapsed < dDuration);
+
+        //
+        // Repeat the same calls with pixel counting enabled.
+        //
+        FrameCountSet(true);
+        g_ui32Seed = 1;
+        for(ui32Iter = 0; ui32Iter < ui32Calls; ui32Iter++)
+        {
+            g_psBenchmarks[ui32Idx].pfnWork(&sContext, ui32Iter);
+        }
+        FrameCountSet(false);
+
+        printf("%-31s %12.0f %14.0f %12.1f %12.1f %11.1f\n",
+               g_psBenchmarks[ui32Idx].pcName, ui32Calls / dElapsed,
+               g_ui64Pixels / dElapsed, (double)g_ui64Pixels / ui32Calls,
+               (double)g_ui64DriverCalls / ui32Calls,
+               (double)g_ui64FlashReads / ui32Calls);
+    }
+}
+
+//*****************************************************************************
+//
+// The test scenes.  Each is rendered into a cleared 24 BPP frame buffer and
+// compared against a golden image.
+//
+//*****************************************************************************
+static void
+SceneFonts(tContext *psContext)
+{
+    uint32_t ui32Idx;
+
+    g_ui32Seed = 1;
+    for(ui32Idx = 0; ui32Idx < NUM_FONTS; ui32Idx++)
+    {
+        GrContextFontSet(psContext, g_psFonts[ui32Idx].psFont);
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        GrContextBackgroundSet(psContext, ClrBlack);
+        GrStringDraw(psContext, g_psFonts[ui32Idx].pcName, -1,
+                     Random(WIDTH) - 40, Random(HEIGHT) - 10,
+                     (ui32Idx & 1) ? true : false);
+    }
+}
+
+static void
+SceneFontsCached(tContext *psContext)
+{
+    //
+    // Draw the fonts scene twice through a glyph cache, so that the second
+    // pass draws from the cache.  The cache is initialized with a limited
+    // number of runs so that the glyphs of the larger fonts are not cached.
+    //
+    GrGlyphCacheInit(&g_sGlyphCache, g_pui32GlyphCache,
+                     sizeof(g_pui32GlyphCache), 64, g_pui16GlyphHash,
+                     sizeof(g_pui16GlyphHash) / sizeof(uint16_t));
+    GrContextGlyphCacheSet(psContext, &g_sGlyphCache);
+    SceneFonts(psContext);
+    SceneFonts(psContext);
+    GrContextGlyphCacheSet(psContext, 0);
+}
+
+static void
+SceneFontsAA(tContext *psContext)
+{
+    tRectangle sRect;
+    uint32_t ui32Idx;
+
+    //
+    // Draw stripes behind the text, so that the difference between opaque
+    // and transparent text is visible.
+    //
+    for(ui32Idx = 0; ui32Idx < HEIGHT; ui32Idx += 32)
+    {
+        sRect.i16XMin = 0;
+        sRect.i16YMin = ui32Idx;
+        sRect.i16XMax = WIDTH - 1;
+        sRect.i16YMax = ui32Idx + 15;
+        GrContextForegroundSet(psContext, ClrNavy);
+        GrRectFill(psContext, &sRect);
+    }
+
+    //
+    // Draw the anti-aliased font in each color, alternating between opaque
+    // and transparent text, with some strings straddling the edges of the
+    // screen.
+    //
+    GrContextFontSet(psContext, (tFont *)&g_sFontAA);
+    GrContextBackgroundSet(psContext, ClrNavy);
+    g_ui32Seed = 1;
+    for(ui32Idx = 0; ui32Idx < (2 * NUM_COLORS); ui32Idx++)
+    {
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        GrStringDraw(psContext, "The quick brown fox 0123", -1,
+                     Random(WIDTH) - 40, Random(HEIGHT) - 10,
+                     (ui32Idx & 1) ? true : false);
+    }
+}
+
+static void
+SceneFontsWideDraw(tContext *psContext, const tFont *psFont, bool bIndexed,
+                   bool bPrefetch)
+{
+    char pcString[(WIDE_STRING_CHARS * 3) + 1];
+    uint32_t ui32Idx;
+
+    //
+    // Draw strings from randomly chosen blocks of the wide font, half of
+    // which take each character from a different block, along with the
+    // first and last codepoints of the font.
+    //
+    FontWideSet(psContext, psFont, bIndexed);
+    GrContextBackgroundSet(psContext, ClrNavy);
+    g_ui32Seed = 1;
+    for(ui32Idx = 0; ui32Idx < (2 * NUM_COLORS); ui32Idx++)
+    {
+        FontWideStringMake(pcString,
+                           WIDE_FIRST + Random(WIDE_BLOCKS * WIDE_BLOCK_STEP),
+                           (ui32Idx & 2) ? (WIDE_BLOCK_STEP + 5) : 1);
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        if(bPrefetch)
+        {
+            FontWrapperPrefetch(psContext, pcString, -1);
+        }
+        GrStringDraw(psContext, pcString, -1, Random(WIDTH) - 40,
+                     Random(HEIGHT) - 10, (ui32Idx & 1) ? true : false);
+    }
+    FontWideStringMake(pcString, WIDE_FIRST, 1);
+    GrStringDraw(psContext, pcString, -1, 0, 0, false);
+    FontWideStringMake(pcString, (WIDE_FIRST +
+                                  ((WIDE_BLOCKS - 1) * WIDE_BLOCK_STEP) +
+                                  WIDE_BLOCK_CHARS - WIDE_STRING_CHARS), 1);
+    GrStringDraw(psContext, pcString, -1, 0, HEIGHT - 16, false);
+}
+
+static void
+SceneFontsWide(tContext *psContext)
+{
+    SceneFontsWideDraw(psContext, (tFont *)g_pui32FontWide, false, false);
+}
+
+static void
+SceneFontsWideIndexed(tContext *psContext)
+{
+    SceneFontsWideDraw(psContext, (tFont *)g_pui32FontWide, true, false);
+}
+
+static void
+SceneFontsWrapped(tContext *psContext)
+{
+    FontWrappedLoad();
+    SceneFontsWideDraw(psContext, (tFont *)&g_sFontWrapped, false, false);
+}
+
+static void
+SceneFontsWrappedPrefetch(tContext *psContext)
+{
+    FontWrappedLoad();
+    SceneFontsWideDraw(psContext, (tFont *)&g_sFontWrapped, false, true);
+}
+
+static void
+SceneRectCopy(tContext *psContext)
+{
+    static uint8_t pui8Buffer[GrOffScreen24BPPSize(IMG_WIDTH, IMG_HEIGHT)];
+    static const uint32_t pui32BPP[] = { 1, 4, 8, 16, 24 };
+    tDisplay sDisplay;
+    tContext sContext;
+    tRectangle sRect;
+    uint32_t ui32Idx;
+
+    //
+    // Draw the test pattern into an off-screen buffer of each pixel depth,
+    // then copy parts of it over itself in each direction and partly off the
+    // edge of the buffer.
+    //
+    for(ui32Idx = 0; ui32Idx < 5; ui32Idx++)
+    {
+        switch(pui32BPP[ui32Idx])
+        {
+            case 1:
+            {
+                GrOffScreen1BPPInit(&sDisplay, pui8Buffer, IMG_WIDTH,
+                                    IMG_HEIGHT);
+                break;
+            }
+
+            case 4:
+            {
+                GrOffScreen4BPPInit(&sDisplay, pui8Buffer, IMG_WIDTH,
+                                    IMG_HEIGHT);
+                GrOffScreen4BPPPaletteSet(&sDisplay, (uint32_t *)g_pui32Colors,
+                                          0, NUM_COLORS);
+                break;
+            }
+
+            case 8:
+            {
+                GrOffScreen8BPPInit(&sDisplay, pui8Buffer, IMG_WIDTH,
+                                    IMG_HEIGHT);
+                GrOffScreen8BPPPaletteSet(&sDisplay, (uint32_t *)g_pui32Colors,
+                                          0, NUM_COLORS);
+                break;
+            }
+
+            case 16:
+            {
+                GrOffScreen16BPPInit(&sDisplay, pui8Buffer, IMG_WIDTH,
+                                     IMG_HEIGHT);
+                break;
+            }
+
+            default:
+            {
+                GrOffScreen24BPPInit(&sDisplay, pui8Buffer, IMG_WIDTH,
+                                     IMG_HEIGHT);
+                break;
+            }
+        }
+        PatternDraw(&sDisplay);
+        GrContextInit(&sContext, &sDisplay);
+
+        sRect.i16XMin = 3;
+        sRect.i16YMin = 2;
+        sRect.i16XMax = 22;
+        sRect.i16YMax = 17;
+        GrRectCopy(&sContext, &sRect, 9, 7);
+        sRect.i16XMin = 25;
+        sRect.i16YMin = 21;
+        sRect.i16XMax = 44;
+        sRect.i16YMax = 36;
+        GrRectCopy(&sContext, &sRect, 19, 15);
+        sRect.i16XMin = 0;
+        sRect.i16YMin = 24;
+        sRect.i16XMax = 13;
+        sRect.i16YMax = 39;
+        GrRectCopy(&sContext, &sRect, 39, 29);
+        sRect.i16XMin = 30;
+        sRect.i16YMin = 0;
+        sRect.i16XMax = 47;
+        sRect.i16YMax = 9;
+        GrRectCopy(&sContext, &sRect, -5, -3);
+
+        GrContextForegroundSet(psContext, ClrYellow);
+        GrContextBackgroundSet(psContext, ClrDarkBlue);
+        GrImageDraw(psContext, pui8Buffer, 8 + (ui32Idx * 62), 8);
+    }
+
+    //
+    // Copy the row of images down the frame buffer, with the clipping region
+    // cutting off part of the copy.
+    //
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 4;
+    sRect.i16XMax = WIDTH - 1;
+    sRect.i16YMax = 51;
+    GrRectCopy(psContext, &sRect, 6, 60);
+    sRect.i16XMin = 20;
+    sRect.i16YMin = 120;
+    sRect.i16XMax = WIDTH - 21;
+    sRect.i16YMax = HEIGHT - 21;
+    GrContextClipRegionSet(psContext, &sRect);
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 0;
+    sRect.i16XMax = WIDTH - 1;
+    sRect.i16YMax = 110;
+    GrRectCopy(psContext, &sRect, -10, 100);
+}
+
+static const uint8_t *
+SceneImageGet(uint32_t ui32Idx, bool bBanded)
+{
+    return(bBanded ? g_ppui8Banded[ui32Idx] : g_psImages[ui32Idx].pui8Image);
+}
+
+static void
+SceneImagesDraw(tContext *psContext, bool bBanded)
+{
+    const uint8_t *pui8Image;
+    tRectangle sRect;
+    uint32_t ui32Idx;
+    int32_t i32X, i32Y;
+
+    GrContextForegroundSet(psContext, ClrYellow);
+    GrContextBackgroundSet(psContext, ClrDarkBlue);
+
+    //
+    // Draw each image unclipped, then again straddling the edges of the
+    // screen.
+    //
+    i32X = 0;
+    i32Y = 0;
+    for(ui32Idx = 0; ui32Idx < NUM_IMAGES; ui32Idx++)
+    {
+        pui8Image = SceneImageGet(ui32Idx, bBanded);
+        if((i32X + GrImageWidthGet(pui8Image)) > WIDTH)
+        {
+            i32X = 0;
+            i32Y += 52;
+        }
+        GrImageDraw(psContext, pui8Image, i32X, i32Y);
+        i32X += GrImageWidthGet(pui8Image) + 4;
+    }
+    for(ui32Idx = 0; ui32Idx < NUM_IMAGES; ui32Idx++)
+    {
+        GrImageDraw(psContext, SceneImageGet(ui32Idx, bBanded),
+                    (ui32Idx & 1) ? -17 : (WIDTH - 23), 110 + (ui32Idx * 13));
+    }
+
+    //
+    // Draw a few rows from part way down each image, so that the rows above
+    // and below the clipping region are skipped.
+    //
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 224;
+    sRect.i16XMax = WIDTH - 1;
+    sRect.i16YMax = 234;
+    GrContextClipRegionSet(psContext, &sRect);
+    for(ui32Idx = 0; ui32Idx < NUM_IMAGES; ui32Idx++)
+    {
+        GrImageDraw(psContext, SceneImageGet(ui32Idx, bBanded),
+                    (ui32Idx * 34) - 5, 221 - (ui32Idx * 11));
+    }
+    sRect.i16YMin = 0;
+    sRect.i16YMax = HEIGHT - 1;
+    GrContextClipRegionSet(psContext, &sRect);
+
+    //
+    // Draw images with transparency.
+    //
+    GrTransparentImageDraw(psContext, SceneImageGet(5, bBanded), 140, 150, 0);
+    GrTransparentImageDraw(psContext, g_pui8Image16BPP, 200, 150,
+                           DpyColorTranslate(&g_sFrameDisplay, ClrBlack));
+    GrTransparentImageDraw(psContext, g_pui8Image24BPP, 200, 195,
+                           DpyColorTranslate(&g_sFrameDisplay, ClrBlack));
+}
+
+static void
+SceneImages(tContext *psContext)
+{
+    SceneImagesDraw(psContext, false);
+}
+
+static void
+SceneImagesBanded(tContext *psContext)
+{
+    //
+    // The same images, drawn from the banded compressed copies.
+    //
+    SceneImagesDraw(psContext, true);
+}
+
+static void
+SceneShapes(tContext *psContext)
+{
+    tRectangle sRect;
+    uint32_t ui32Idx;
+
+    //
+    // A fan of lines from the center of the screen, extending past the
+    // edges so that clipping is exercised.
+    //
+    for(ui32Idx = 0; ui32Idx < 64; ui32Idx++)
+    {
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        GrLineDraw(psContext, WIDTH / 2, HEIGHT / 2,
+                   (ui32Idx < 32) ? ((ui32Idx * 12) - 30) :
+                   (((ui32Idx - 32) * 12) - 30),
+                   (ui32Idx < 32) ? -10 : (HEIGHT + 10));
+    }
+
+    //
+    // Filled and outlined circles and rectangles, some partly off-screen.
+    //
+    g_ui32Seed = 1;
+    for(ui32Idx = 0; ui32Idx < 24; ui32Idx++)
+    {
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        sRect.i16XMin = Random(WIDTH) - 20;
+        sRect.i16YMin = Random(HEIGHT) - 20;
+        sRect.i16XMax = sRect.i16XMin + Random(60);
+        sRect.i16YMax = sRect.i16YMin + Random(60);
+        if(ui32Idx & 1)
+        {
+            GrRectFill(psContext, &sRect);
+            GrCircleDraw(psContext, sRect.i16XMin, sRect.i16YMax,
+                         Random(30) + 1);
+        }
+        else
+        {
+            GrRectDraw(psContext, &sRect);
+            GrCircleFill(psContext, sRect.i16XMax, sRect.i16YMin,
+                         Random(30) + 1);
+        }
+    }
+}
+
+static void
+SceneShapesFill(tContext *psContext)
+{
+    static const tPoint psStar[] =
+    {
+        { 60, 10 }, { 72, 45 }, { 108, 45 }, { 79, 66 }, { 90, 101 },
+        { 60, 80 }, { 30, 101 }, { 41, 66 }, { 12, 45 }, { 48, 45 },
+    };
+    static const tPoint psPentagram[] =
+    {
+        { 170, 10 }, { 199, 100 }, { 122, 44 }, { 218, 44 }, { 141, 100 },
+    };
+    static const tPoint psSteps[] =
+    {
+        { 230, 10 }, { 250, 10 }, { 250, 30 }, { 270, 30 }, { 270, 50 },
+        { 290, 50 }, { 290, 70 }, { 310, 70 }, { 310, 100 }, { 230, 100 },
+    };
+    static const tPoint psClipped[] =
+    {
+        { -30, 150 }, { 60, 120 }, { 40, 260 },
+    };
+    tRectangle sRect;
+    uint32_t ui32Idx;
+
+    //
+    // Polygons: a concave star, a self-intersecting pentagram which leaves
+    // its center unfilled, a staircase of horizontal and vertical edges and a
+    // triangle which is clipped by the edges of the screen.
+    //
+    GrContextForegroundSet(psContext, ClrYellow);
+    GrPolygonFill(psContext, psStar, sizeof(psStar) / sizeof(psStar[0]));
+    GrContextForegroundSet(psContext, ClrCyan);
+    GrPolygonFill(psContext, psPentagram,
+                  sizeof(psPentagram) / sizeof(psPentagram[0]));
+    GrContextForegroundSet(psContext, ClrOrange);
+    GrPolygonFill(psContext, psSteps, sizeof(psSteps) / sizeof(psSteps[0]));
+    GrContextForegroundSet(psContext, ClrLimeGreen);
+    GrPolygonFill(psContext, psClipped,
+                  sizeof(psClipped) / sizeof(psClipped[0]));
+
+    //
+    // A gauge made of concentric arcs, with segments that wrap through zero
+    // degrees and a full circle.
+    //
+    for(ui32Idx = 0; ui32Idx < 8; ui32Idx++)
+    {
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        GrArcDraw(psContext, 160, 170, 20 + (ui32Idx * 6), 135 + (ui32Idx * 5),
+                  405 - (ui32Idx * 30));
+    }
+    GrContextForegroundSet(psContext, ClrWhite);
+    GrArcDraw(psContext, 160, 170, 14, 300, 60);
+    GrArcDraw(psContext, 160, 170, 10, 0, 360);
+
+    //
+    // Rounded rectangles, including one too small for its radius and one
+    // which is partly off-screen.
+    //
+    for(ui32Idx = 0; ui32Idx < 4; ui32Idx++)
+    {
+        GrContextForegroundSet(psContext, g_pui32Colors[ui32Idx % NUM_COLORS]);
+        sRect.i16XMin = 230 + (ui32Idx * 6);
+        sRect.i16YMin = 115 + (ui32Idx * 20);
+        sRect.i16XMax = 300 + (ui32Idx * 8);
+        sRect.i16YMax = 130 + (ui32Idx * 22);
+        GrRoundRectFill(psContext, &sRect, ui32Idx * 4);
+    }
+    GrContextForegroundSet(psContext, ClrWhite);
+    sRect.i16XMin = 80;
+    sRect.i16YMin = 220;
+    sRect.i16XMax = 86;
+    sRect.i16YMax = 236;
+    GrRoundRectFill(psContext, &sRect, 10);
+}
+
+static void
+SceneWidgets(tContext *psContext)
+{
+    WidgetPaint(WIDGET_ROOT);
+    WidgetMessageQueueProcess();
+}
+
+static void
+SceneWidgetsDamage(tContext *psContext)
+{
+    static const tRectangle psDamage[] =
+    {
+        { 100, 20, 190, 60 },
+        { 150, 120, 250, 170 },
+        { 30, 90, 70, 100 },
+        { 200, 200, 239, 239 },
+        { 290, 100, 319, 239 },
+        { 5, 185, 20, 200 },
+    };
+    uint32_t ui32Idx;
+
+    //
+    // Draw the widget tree, then scribble over regions which straddle several
+    // widgets and invalidate them; there are more regions than the widget
+    // library holds, so some are merged.  The repaint must match a full paint.
+    //
+    WidgetPaint(WIDGET_ROOT);
+    WidgetMessageQueueProcess();
+    GrContextForegroundSet(psContext, ClrMagenta);
+    for(ui32Idx = 0; ui32Idx < (sizeof(psDamage) / sizeof(psDamage[0]));
+        ui32Idx++)
+    {
+        GrRectFill(psContext, &psDamage[ui32Idx]);
+        WidgetInvalidate(WIDGET_ROOT, &psDamage[ui32Idx]);
+    }
+    WidgetMessageQueueProcess();
+}
+
+static void
+SceneWidgetsQueued(tContext *psContext)
+{
+    static tWidget * const ppsWidgets[] =
+    {
+        (tWidget *)&g_sSlider, (tWidget *)&g_sListBox,
+        (tWidget *)&g_sCheckBox1, (tWidget *)&g_sRadioButton2,
+        (tWidget *)&g_sRectButton, (tWidget *)&g_sLogo,
+    };
+    uint32_t ui32Idx;
+    bool bLost;
+
+    //
+    // Request a paint of the widget tree followed by many more paint requests
+    // for widgets within it than the message queue can hold.  These are all
+    // coalesced with the first, so none are lost and the result must match a
+    // single paint.  Mark the display if any request is refused.
+    //
+    bLost = !WidgetPaint(WIDGET_ROOT);
+    for(ui32Idx = 0; ui32Idx < (WIDGET_MSG_QUEUE_SIZE * 4); ui32Idx++)
+    {
+        bLost |= !WidgetPaint(ppsWidgets[ui32Idx %
+                                         (sizeof(ppsWidgets) /
+                                          sizeof(ppsWidgets[0]))]);
+    }
+    WidgetMessageQueueProcess();
+    if(bLost)
+    {
+        GrContextForegroundSet(psContext, ClrMagenta);
+        GrRectFill(psContext, &(ppsWidgets[0]->sPosition));
+    }
+}
+
+static void
+SceneListBoxDraw(tContext *psContext, bool bCopy)
+{
+    static const int32_t pi32Drags[] = { 3, 1, 1, -2, 40, -1, 7, -3 };
+    uint32_t ui32Idx;
+
+    //
+    // Draw the log, then scroll it by a series of drags, one of which moves
+    // all of the lines out of view.  Whether scrolling copies pixels or
+    // repaints, the result must match.
+    //
+    LogBoxInit();
+    WidgetPaint((tWidget *)&g_sLogBox);
+    WidgetMessageQueueProcess();
+    if(!bCopy)
+    {
+        g_sFrameDisplay.pfnRectCopy = 0;
+    }
+    for(ui32Idx = 0; ui32Idx < (sizeof(pi32Drags) / sizeof(pi32Drags[0]));
+        ui32Idx++)
+    {
+        LogBoxDrag(pi32Drags[ui32Idx]);
+        WidgetMessageQueueProcess();
+    }
+
+    //
+    // Shrink the log so that it scrolls back to show the last items, then
+    // grow it, which keeps the last item in view.  Scroll back, select a line
+    // and scroll the selection along with the rest of the lines.
+    //
+    ListBoxItemCountSet(&g_sLogBox, 12);
+    ListBoxItemCountSet(&g_sLogBox, 20);
+    WidgetPaint((tWidget *)&g_sLogBox);
+    WidgetMessageQueueProcess();
+    LogBoxDrag(-2);
+    WidgetMessageQueueProcess();
+    ListBoxMsgProc((tWidget *)&g_sLogBox, WIDGET_MSG_PTR_DOWN, 60, 80);
+    ListBoxMsgProc((tWidget *)&g_sLogBox, WIDGET_MSG_PTR_UP, 60, 80);
+    WidgetMessageQueueProcess();
+    LogBoxDrag(1);
+    WidgetMessageQueueProcess();
+}
+
+static void
+SceneListBox(tContext *psContext)
+{
+    SceneListBoxDraw(psContext, false);
+}
+
+static void
+SceneListBoxCopy(tContext *psContext)
+{
+    SceneListBoxDraw(psContext, true);
+}
+
+static void
+SceneKeyboardDraw(tContext *psContext, bool bRepaint)
+{
+    static const uint8_t pui8Keys[] =
+    {
+        19, 15, 7, 29, 31, 28, 0, 1, 2, 29, 31, 19, 19, 8, 17, 19
+    };
+    uint32_t ui32Idx;
+
+    //
+    // Draw the keyboard and type on it, switching between the lower case,
+    // upper case, caps lock and numeric keyboards, then hold a key down.
+    //
+    OnScreenKeyboardInit();
+    WidgetPaint((tWidget *)&g_sKeyboard);
+    WidgetMessageQueueProcess();
+    for(ui32Idx = 0; ui32Idx < sizeof(pui8Keys); ui32Idx++)
+    {
+        OnScreenKeyboardTap(pui8Keys[ui32Idx]);
+    }
+    OnScreenKeyboardPress(WIDGET_MSG_PTR_DOWN, 12);
+
+    //
+    // Either leave the keyboard as drawn a key at a time, or repaint it all;
+    // the result must match.
+    //
+    if(bRepaint)
+    {
+        WidgetPaint((tWidget *)&g_sKeyboard);
+        WidgetMessageQueueProcess();
+    }
+
+    //
+    // Show the text that was typed.
+    //
+    GrContextFontSet(psContext, (const tFont *)&g_sFontCmss20);
+    GrContextForegroundSet(psContext, ClrWhite);
+    GrStringDraw(psContext, g_pcKeyboardText, -1, 10, 40, false);
+}
+
+static void
+SceneKeyboard(tContext *psContext)
+{
+    SceneKeyboardDraw(psContext, true);
+}
+
+static void
+SceneKeyboardIncremental(tContext *psContext)
+{
+    SceneKeyboardDraw(psContext, false);
+}
+
+static void
+SceneTrendChartDraw(tContext *psContext, bool bOffscreen)
+{
+    static const tRectangle sDamage = { 100, 60, 200, 100 };
+    uint32_t ui32Sample;
+
+    //
+    // Draw the chart and add enough samples to scroll it by more than its
+    // width, four samples to a column.  The chart is either scrolled on the
+    // display or, if it has an off-screen copy, the display is not allowed
+    // to copy so that it is drawn from that copy.
+    //
+    ChartInit(bOffscreen, 4);
+    WidgetPaint((tWidget *)&g_sChart);
+    WidgetMessageQueueProcess();
+    if(bOffscreen)
+    {
+        g_sFrameDisplay.pfnRectCopy = 0;
+    }
+    for(ui32Sample = 0; ui32Sample < ((CHART_WIDTH + 40) * 4); ui32Sample++)
+    {
+        ChartSampleAdd(ui32Sample);
+    }
+
+    //
+    // Scribble over the chart drawn from the off-screen copy and repaint it;
+    // the result must match the chart scrolled on the display.
+    //
+    if(bOffscreen)
+    {
+        GrContextForegroundSet(psContext, ClrMagenta);
+        GrRectFill(psContext, &sDamage);
+        WidgetPaint((tWidget *)&g_sChart);
+        WidgetMessageQueueProcess();
+    }
+}
+
+static void
+SceneTrendChart(tContext *psContext)
+{
+    SceneTrendChartDraw(psContext, false);
+}
+
+static void
+SceneTrendChartOffscreen(tContext *psContext)
+{
+    SceneTrendChartDraw(psContext, true);
+}
+
+//*****************************************************************************
+//
+// Returns the offset of a pixel of the screen within a buffer drawn by a
+// rotated display, in pixels from the start of the buffer's pixel data.  The
+// position is computed here, independently of the rotated display.
+//
+//*****************************************************************************
+static int32_t
+RotatedPixelOffset(uint32_t ui32Rotation, int32_t i32X, int32_t i32Y)
+{
+    switch(ui32Rotation)
+    {
+        case GRLIB_ROTATE_90:
+        {
+            return((i32X * HEIGHT) + (HEIGHT - 1 - i32Y));
+        }
+
+        case GRLIB_ROTATE_180:
+        {
+            return(((HEIGHT - 1 - i32Y) * WIDTH) + (WIDTH - 1 - i32X));
+        }
+
+        case GRLIB_ROTATE_270:
+        {
+            return(((WIDTH - 1 - i32X) * HEIGHT) + i32Y);
+        }
+
+        default:
+        {
+            return((i32Y * WIDTH) + i32X);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Draws a scene from a black screen on a rotated display, drawing into the
+// rotated buffer with the given driver.
+//
+//*****************************************************************************
+static void
+RotatedDraw(void (*pfnDraw)(tContext *psContext), uint32_t ui32Rotation,
+            void (*pfnBufferInit)(tDisplay *psDisplay, uint8_t *pui8Image,
+                                  int32_t i32Width, int32_t i32Height))
+{
+    tContext sContext;
+    tRectangle sRect;
+    int32_t i32BWidth;
+
+    i32BWidth = (ui32Rotation & 1) ? HEIGHT : WIDTH;
+    pfnBufferInit(&g_sRotatedBuffer, g_pui8RotatedImage, i32BWidth,
+                  (WIDTH * HEIGHT) / i32BWidth);
+    GrRotatedDisplayInit(&g_sRotatedDisplay, &g_sRotated, &g_sRotatedBuffer,
+                         ui32Rotation);
+    GrContextInit(&sContext, &g_sRotatedDisplay);
+    GrContextForegroundSet(&sContext, ClrBlack);
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 0;
+    sRect.i16XMax = WIDTH - 1;
+    sRect.i16YMax = HEIGHT - 1;
+    GrRectFill(&sContext, &sRect);
+    pfnDraw(&sContext);
+}
+
+//*****************************************************************************
+//
+// Draws a scene on a rotated display, then copies the rotated buffer into the
+// frame buffer in the unrotated order so that it can be compared against the
+// golden image of the scene.
+//
+//*****************************************************************************
+static void
+SceneRotatedDraw(void (*pfnDraw)(tContext *psContext), uint32_t ui32Rotation)
+{
+    uint8_t *pui8Src, *pui8Dst;
+    int32_t i32X, i32Y;
+
+    RotatedDraw(pfnDraw, ui32Rotation, GrOffScreen24BPPInit);
+
+    //
+    // Copy each pixel back from its rotated position in the buffer.
+    //
+    pui8Dst = g_pui8Frame24 + 6;
+    for(i32Y = 0; i32Y < HEIGHT; i32Y++)
+    {
+        for(i32X = 0; i32X < WIDTH; i32X++, pui8Dst += 3)
+        {
+            pui8Src = (g_pui8RotatedImage + 6 +
+                       (RotatedPixelOffset(ui32Rotation, i32X, i32Y) * 3));
+            pui8Dst[0] = pui8Src[0];
+            pui8Dst[1] = pui8Src[1];
+            pui8Dst[2] = pui8Src[2];
+        }
+    }
+}
+
+static void
+SceneFontsRotate270(tContext *psContext)
+{
+    SceneRotatedDraw(SceneFonts, GRLIB_ROTATE_270);
+}
+
+static void
+SceneImagesRotate90(tContext *psContext)
+{
+    SceneRotatedDraw(SceneImages, GRLIB_ROTATE_90);
+}
+
+static void
+SceneImagesRotate180(tContext *psContext)
+{
+    SceneRotatedDraw(SceneImages, GRLIB_ROTATE_180);
+}
+
+static void
+SceneImagesRotate270(tContext *psContext)
+{
+    SceneRotatedDraw(SceneImages, GRLIB_ROTATE_270);
+}
+
+static void
+SceneShapesRotate90(tContext *psContext)
+{
+    SceneRotatedDraw(SceneShapes, GRLIB_ROTATE_90);
+}
+
+static void
+SceneShapesRotate180(tContext *psContext)
+{
+    SceneRotatedDraw(SceneShapes, GRLIB_ROTATE_180);
+}
+
+static void
+SceneShapesRotate270(tContext *psContext)
+{
+    SceneRotatedDraw(SceneShapes, GRLIB_ROTATE_270);
+}
+
+static void
+SceneRectCopyRotate90(tContext *psContext)
+{
+    SceneRotatedDraw(SceneRectCopy, GRLIB_ROTATE_90);
+}
+
+typedef struct
+{
+    const char *pcName;
+    const char *pcGolden;
+    void (*pfnDraw)(tContext *psContext);
+}
+tScene;
+
+static const tScene g_psScenes[] =
+{
+    { "fonts", "fonts", SceneFonts },
+    { "fonts-cached", "fonts", SceneFontsCached },
+    { "fonts-rotate270", "fonts", SceneFontsRotate270 },
+    { "fonts-aa", "fonts-aa", SceneFontsAA },
+    { "fonts-wide", "fonts-wide", SceneFontsWide },
+    { "fonts-wide-indexed", "fonts-wide", SceneFontsWideIndexed },
+    { "fonts-wrapped", "fonts-wide", SceneFontsWrapped },
+    { "fonts-wrapped-prefetch", "fonts-wide", SceneFontsWrappedPrefetch },
+    { "images", "images", SceneImages },
+    { "images-banded", "images", SceneImagesBanded },
+    { "images-rotate90", "images", SceneImagesRotate90 },
+    { "images-rotate180", "images", SceneImagesRotate180 },
+    { "images-rotate270", "images", SceneImagesRotate270 },
+    { "shapes", "shapes", SceneShapes },
+    { "shapes-rotate90", "shapes", SceneShapesRotate90 },
+    { "shapes-rotate180", "shapes", SceneShapesRotate180 },
+    { "shapes-rotate270", "shapes", SceneShapesRotate270 },
+    { "shapes-fill", "shapes-fill", SceneShapesFill },
+    { "rect-copy", "rect-copy", SceneRectCopy },
+    { "rect-copy-rotate90", "rect-copy", SceneRectCopyRotate90 },
+    { "widgets", "widgets", SceneWidgets },
+    { "widgets-damage", "widgets", SceneWidgetsDamage },
+    { "widgets-queued", "widgets", SceneWidgetsQueued },
+    { "listbox", "listbox", SceneListBox },
+    { "listbox-copy", "listbox", SceneListBoxCopy },
+    { "keyboard", "keyboard", SceneKeyboard },
+    { "keyboard-incremental", "keyboard", SceneKeyboardIncremental },
+    { "trendchart", "trendchart", SceneTrendChart },
+    { "trendchart-offscreen", "trendchart", SceneTrendChartOffscreen },
+};
+
+#define NUM_SCENES              (sizeof(g_psScenes) / sizeof(g_psScenes[0]))
+
+//*****************************************************************************
+//
+// Writes the 24 BPP frame buffer to a binary PPM file.
+//
+//*****************************************************************************
+static int
+PPMWrite(const char *pcFilename)
+{
+    FILE *psFile;
+    uint8_t *pui8Pixel;
+    uint32_t ui32Idx;
+
+    psFile = fopen(pcFilename, "wb");
+    if(!psFile)
+    {
+        fprintf(stderr, "Unable to create %s\n", pcFilename);
+        return(-1);
+    }
+
+    fprintf(psFile, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+
+    //
+    // The frame buffer stores pixels as blue, green, red.
+    //
+    pui8Pixel = g_pui8Frame24 + 6;
+    for(ui32Idx = 0; ui32Idx < (WIDTH * HEIGHT); ui32Idx++, pui8Pixel += 3)
+    {
+        fputc(pui8Pixel[2], psFile);
+        fputc(pui8Pixel[1], psFile);
+        fputc(pui8Pixel[0], psFile);
+    }
+
+    fclose(psFile);
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Compares the 24 BPP frame buffer to a binary PPM file.  Returns the number
+// of differing pixels, or -1 if the file could not be read.
+//
+//*****************************************************************************
+static int32_t
+PPMCompare(const char *pcFilename)
+{
+    FILE *psFile;
+    uint8_t *pui8Pixel, pui8RGB[3];
+    uint32_t ui32Idx, ui32Width, ui32Height, ui32Max;
+    int32_t i32Diff;
+
+    psFile = fopen(pcFilename, "rb");
+    if(!psFile)
+    {
+        return(-1);
+    }
+
+    if((fscanf(psFile, "P6 %u %u %u", &ui32Width, &ui32Height, &ui32Max) !=
+        3) || (fgetc(psFile) == EOF) || (ui32Width != WIDTH) ||
+       (ui32Height != HEIGHT) || (ui32Max != 255))
+    {
+        fclose(psFile);
+        return(-1);
+    }
+
+    i32Diff = 0;
+    pui8Pixel = g_pui8Frame24 + 6;
+    for(ui32Idx = 0; ui32Idx < (WIDTH * HEIGHT); ui32Idx++, pui8Pixel += 3)
+    {
+        if(fread(pui8RGB, 1, 3, psFile) != 3)
+        {
+            fclose(psFile);
+            return(-1);
+        }
+        if((pui8RGB[0] != pui8Pixel[2]) || (pui8RGB[1] != pui8Pixel[1]) ||
+           (pui8RGB[2] != pui8Pixel[0]))
+        {
+            i32Diff++;
+        }
+    }
+
+    fclose(psFile);
+    return(i32Diff);
+}
+
+//*****************************************************************************
+//
+// Renders each test scene and either compares it against, or replaces, the
+// golden image.  Returns the number of scenes that did not match.
+//
+//*****************************************************************************
+static uint32_t
+ScenesRun(const char *pcDir, bool bUpdate)
+{
+    tContext sContext;
+    char pcFilename[256];
+    uint32_t ui32Idx, ui32Failed;
+    int32_t i32Diff;
+
+    ui32Failed = 0;
+    for(ui32Idx = 0; ui32Idx < NUM_SCENES; ui32Idx++)
+    {
+        //
+        // Render the scene.
+        //
+        FrameInit(24);
+        FrameClear();
+        GrContextInit(&sContext, &g_sFrameDisplay);
+        g_psScenes[ui32Idx].pfnDraw(&sContext);
+
+        snprintf(pcFilename, sizeof(pcFilename), "%s/%s.ppm", pcDir,
+                 g_psScenes[ui32Idx].pcGolden);
+
+        //
+        // Write a new golden image if requested.  Scenes which share the
+        // golden image of another scene do not replace it.
+        //
+        if(bUpdate)
+        {
+            if(strcmp(g_psScenes[ui32Idx].pcName,
+                      g_psScenes[ui32Idx].pcGolden))
+            {
+                continue;
+            }
+            if(PPMWrite(pcFilename) != 0)
+            {
+                ui32Failed++;
+            }
+            else
+            {
+                printf("%-22s updated %s\n", g_psScenes[ui32Idx].pcName,
+                       pcFilename);
+            }
+            continue;
+        }
+
+        //
+        // Compare against the golden image.  On a mismatch, save the actual
+        // output in the current directory for inspection.
+        //
+        i32Diff = PPMCompare(pcFilename);
+        if(i32Diff == 0)
+        {
+            printf("%-22s ok\n", g_psScenes[ui32Idx].pcName);
+            continue;
+        }
+
+        ui32Failed++;
+        if(i32Diff < 0)
+        {
+            printf("%-22s FAILED (unable to read %s)\n",
+                   g_psScenes[ui32Idx].pcName, pcFilename);
+        }
+        else
+        {
+            printf("%-22s FAILED (%d pixels differ)\n",
+                   g_psScenes[ui32Idx].pcName, i32Diff);
+        }
+        snprintf(pcFilename, sizeof(pcFilename), "%s-actual.ppm",
+                 g_psScenes[ui32Idx].pcName);
+        PPMWrite(pcFilename);
+    }
+
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// Checks that every string of the lang_demo string table is the same when
+// retrieved from the legacy table and from the extended table, directly and
+// through the string cache.  Returns the number of mismatches.
+//
+//*****************************************************************************
+static uint32_t
+StringsCheck(void)
+{
+    const tStringTableEx *psTable;
+    char *pcLegacy, *pcExpected, pcBuffer[SCOMP_MAX_STRLEN];
+    const char *pcCached;
+    uint32_t ui32Lang, ui32Idx, ui32Iter, ui32Pass, ui32Failed, ui32Len;
+    uint32_t ui32Size;
+
+    psTable = &g_sTablelanguage_ex;
+    pcLegacy = calloc(psTable->ui16NumLanguages * psTable->ui16NumStrings,
+                      SCOMP_MAX_STRLEN);
+    if(!pcLegacy)
+    {
+        printf("%-22s FAILED (out of memory)\n", "strings");
+        return(1);
+    }
+
+    //
+    // Retrieve each string from the legacy table, and compare it against the
+    // string decoded directly from the extended table, both in full and
+    // truncated.
+    //
+    ui32Failed = 0;
+    StringTableSelect(false, false);
+    for(ui32Lang = 0; ui32Lang < psTable->ui16NumLanguages; ui32Lang++)
+    {
+        GrStringLanguageSet(psTable->pui16Languages[ui32Lang]);
+        for(ui32Idx = 0; ui32Idx < psTable->ui16NumStrings; ui32Idx++)
+        {
+            pcExpected = pcLegacy + (((ui32Lang * psTable->ui16NumStrings) +
+                                      ui32Idx) * SCOMP_MAX_STRLEN);
+            GrStringGet(ui32Idx, pcExpected, SCOMP_MAX_STRLEN);
+
+            GrStringTableExGet(psTable, ui32Lang, ui32Idx, pcBuffer,
+                               sizeof(pcBuffer));
+            if(strcmp(pcBuffer, pcExpected))
+            {
+                ui32Failed++;
+            }
+
+            ui32Size = (ui32Idx % 8) + 1;
+            ui32Len = GrStringTableExGet(psTable, ui32Lang, ui32Idx,
+                                         pcBuffer, ui32Size);
+            if((ui32Len != ((strlen(pcExpected) < ui32Size) ?
+                            strlen(pcExpected) : ui32Size)) ||
+               memcmp(pcBuffer, pcExpected, ui32Len))
+            {
+                ui32Failed++;
+            }
+        }
+    }
+
+    //
+    // Retrieve strings at random through the cache of each table, favoring a
+    // few strings so that strings are both found in and evicted from the
+    // cache.
+    //
+    g_ui32Seed = 1;
+    for(ui32Pass = 0; ui32Pass < 2; ui32Pass++)
+    {
+        StringTableSelect(ui32Pass == 1, true);
+        for(ui32Iter = 0; ui32Iter < 2000; ui32Iter++)
+        {
+            ui32Lang = (ui32Iter / 100) % psTable->ui16NumLanguages;
+            GrStringLanguageSet(psTable->pui16Languages[ui32Lang]);
+            ui32Idx = Random(Random(psTable->ui16NumStrings) + 1);
+            pcExpected = pcLegacy + (((ui32Lang * psTable->ui16NumStrings) +
+                                      ui32Idx) * SCOMP_MAX_STRLEN);
+
+            if(ui32Iter & 1)
+            {
+                pcCached = GrStringCachedGet(ui32Idx);
+                if(!pcCached || strcmp(pcCached, pcExpected))
+                {
+                    ui32Failed++;
+                }
+                continue;
+            }
+
+            ui32Size = (ui32Iter & 2) ? ((ui32Iter % 8) + 1) :
+                                        sizeof(pcBuffer);
+            ui32Len = GrStringGet(ui32Idx, pcBuffer, ui32Size);
+            if((ui32Len != ((strlen(pcExpected) < ui32Size) ?
+                            strlen(pcExpected) : ui32Size)) ||
+               memcmp(pcBuffer, pcExpected, ui32Len))
+            {
+                ui32Failed++;
+            }
+        }
+
+        if(!g_sStringCache.ui32Hits || !g_sStringCache.ui32Misses)
+        {
+            ui32Failed++;
+        }
+    }
+    GrStringCacheSet(0);
+    free(pcLegacy);
+
+    if(ui32Failed)
+    {
+        printf("%-22s FAILED (%u mismatches)\n", "strings", ui32Failed);
+    }
+    else
+    {
+        printf("%-22s ok\n", "strings");
+    }
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// Checks that the colors translated through the color cache of a 4 BPP and an
+// 8 BPP display match those translated by the display driver, including after
+// the palette is changed.  Returns the number of mismatches.
+//
+//*****************************************************************************
+static uint32_t
+ColorCacheCheck(void)
+{
+    uint32_t ui32BPP, ui32Pass, ui32Idx, ui32Color, ui32Failed;
+
+    ui32Failed = 0;
+    for(ui32BPP = 4; ui32BPP <= 8; ui32BPP += 4)
+    {
+        PaletteDisplayInit(ui32BPP, true);
+        for(ui32Pass = 0; ui32Pass < 4; ui32Pass++)
+        {
+            //
+            // Rotate the palette on the later passes, so that colors cached
+            // with the previous palette would translate incorrectly.
+            //
+            if(ui32Pass >= 2)
+            {
+                for(ui32Idx = 0; ui32Idx < NUM_COLORS; ui32Idx++)
+                {
+                    ui32Color = g_pui32Colors[(ui32Idx + ui32Pass) %
+                                              NUM_COLORS];
+                    if(ui32BPP == 4)
+                    {
+                        GrOffScreen4BPPPaletteSet(&g_sPaletteDisplay,
+                                                  &ui32Color, ui32Idx, 1);
+                    }
+                    else
+                    {
+                        GrOffScreen8BPPPaletteSet(&g_sPaletteDisplay,
+                                                  &ui32Color, ui32Idx, 1);
+                    }
+                }
+            }
+
+            //
+            // Translate the palette colors, the widget colors, and a spread
+            // of other colors (including one which is not a 24-bit color).
+            //
+            for(ui32Idx = 0; ui32Idx < (NUM_COLORS + NUM_WIDGET_COLORS + 65);
+                ui32Idx++)
+            {
+                if(ui32Idx < NUM_COLORS)
+                {
+                    ui32Color = g_pui32Colors[ui32Idx];
+                }
+                else if(ui32Idx < (NUM_COLORS + NUM_WIDGET_COLORS))
+                {
+                    ui32Color = g_pui32WidgetColors[ui32Idx - NUM_COLORS];
+                }
+                else if(ui32Idx < (NUM_COLORS + NUM_WIDGET_COLORS + 64))
+                {
+                    ui32Color = ui32Idx * 0x030507;
+                }
+                else
+                {
+                    ui32Color = 0xffffffff;
+                }
+
+                if(DpyColorTranslate(&g_sPaletteDisplay, ui32Color) !=
+                   g_sPaletteDisplay.pfnColorTranslate(
+                       g_sPaletteDisplay.pvDisplayData, ui32Color))
+                {
+                    ui32Failed++;
+                }
+            }
+        }
+
+        if(!g_sColorCache.ui32Hits || !g_sColorCache.ui32Misses)
+        {
+            ui32Failed++;
+        }
+    }
+
+    //
+    // Check that a cache with more entries than there are values of the top
+    // byte of the hash spreads a large number of colors over all of them.
+    //
+    GrColorCacheInit(&g_sColorCache, g_psColorCacheEntries, 1024);
+    GrDisplayColorCacheSet(&g_sPaletteDisplay, &g_sColorCache);
+    for(ui32Idx = 0; ui32Idx < 4096; ui32Idx++)
+    {
+        DpyColorTranslate(&g_sPaletteDisplay, ui32Idx * 0x010203);
+    }
+    for(ui32Idx = 0; ui32Idx < 1024; ui32Idx += 256)
+    {
+        for(ui32Pass = 0; ui32Pass < 256; ui32Pass++)
+        {
+            if(g_psColorCacheEntries[ui32Idx + ui32Pass].ui32Color !=
+               0xffffffff)
+            {
+                break;
+            }
+        }
+        if(ui32Pass == 256)
+        {
+            ui32Failed++;
+        }
+    }
+    GrDisplayColorCacheSet(&g_sPaletteDisplay, 0);
+
+    if(ui32Failed)
+    {
+        printf("%-22s FAILED (%u mismatches)\n", "color-cache", ui32Failed);
+    }
+    else
+    {
+        printf("%-22s ok\n", "color-cache");
+    }
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// Reads a pixel of an uncompressed off-screen image, returning either its raw
+// value or its 24-bit RGB color.
+//
+//*****************************************************************************
+static uint32_t
+BlitPixelGet(const uint8_t *pui8Image, int32_t i32X, int32_t i32Y,
+             bool bColor)
+{
+    const uint8_t *pui8Data;
+    uint32_t ui32Value, ui32Width;
+
+    ui32Width = *(uint16_t *)(pui8Image + 1);
+    switch(pui8Image[0])
+    {
+        case 1:
+        {
+            pui8Data = pui8Image + 5 + (((ui32Width + 7) / 8) * i32Y);
+            ui32Value = (pui8Data[i32X / 8] >> (7 - (i32X % 8))) & 1;
+            if(bColor)
+            {
+                ui32Value = ui32Value ? ClrWhite : ClrBlack;
+            }
+            return(ui32Value);
+        }
+
+        case 4:
+        case 8:
+        {
+            if(pui8Image[0] == 4)
+            {
+                pui8Data = (pui8Image + 6 + (16 * 3) +
+                            (((ui32Width + 1) / 2) * i32Y));
+                ui32Value = (pui8Data[i32X / 2] >> ((i32X & 1) ? 0 : 4)) & 15;
+            }
+            else
+            {
+                pui8Data = pui8Image + 6 + (256 * 3) + (ui32Width * i32Y);
+                ui32Value = pui8Data[i32X];
+            }
+            if(bColor)
+            {
+                pui8Data = pui8Image + 6 + (ui32Value * 3);
+                ui32Value = (pui8Data[0] | (pui8Data[1] << 8) |
+                             (pui8Data[2] << 16));
+            }
+            return(ui32Value);
+        }
+
+        case 16:
+        {
+            ui32Value = ((uint16_t *)(pui8Image + 6))[(ui32Width * i32Y) +
+                                                      i32X];
+            if(bColor)
+            {
+                ui32Value = ((((ui32Value << 3) & 0xf8) |
+                              ((ui32Value >> 2) & 7)) |
+                             ((((ui32Value >> 3) & 0xfc) |
+                               ((ui32Value >> 9) & 3)) << 8) |
+                             ((((ui32Value >> 8) & 0xf8) |
+                               ((ui32Value >> 13) & 7)) << 16));
+            }
+            return(ui32Value);
+        }
+
+        default:
+        {
+            pui8Data = pui8Image + 6 + (((ui32Width * i32Y) + i32X) * 3);
+            return(pui8Data[0] | (pui8Data[1] << 8) | (pui8Data[2] << 16));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Performs a single off-screen blit and compares the result against the same
+// copy performed a pixel at a time.  The destination starts with a pattern
+// and, for palette based destinations, either the palette of the test images
+// or a rotated copy of it.  If bSelf is true the destination is also used as
+// the source.  Returns the number of pixels which differ in color.
+//
+//*****************************************************************************
+static uint32_t
+BlitCaseCheck(uint32_t ui32SrcBPP, uint32_t ui32DstBPP, bool bSamePalette,
+              const tRectangle *psRect, int32_t i32X, int32_t i32Y,
+              bool bSelf, bool bTransparent)
+{
+    uint8_t *pui8Dst, *pui8Ref, *pui8Src;
+    uint32_t pui32Palette[NUM_COLORS], ui32Idx, ui32Failed;
+    tDisplay sDst, sRef, sSrc;
+    tContext sContext;
+    tRectangle sRect;
+    int32_t i32SX, i32SY, i32DX, i32DY;
+
+    pui8Dst = (uint8_t *)g_pui32BlitDst;
+    pui8Ref = (uint8_t *)g_pui32BlitRef;
+
+    //
+    // Set up the destination with the chosen palette and draw a pattern.
+    //
+    memset(pui8Dst, 0, sizeof(g_pui32BlitDst));
+    BlitDisplayInit(&sDst, pui8Dst, ui32DstBPP, BLIT_WIDTH, BLIT_HEIGHT);
+    for(ui32Idx = 0; ui32Idx < NUM_COLORS; ui32Idx++)
+    {
+        pui32Palette[ui32Idx] = g_pui32Colors[(ui32Idx + (bSamePalette ? 0 :
+                                                          1)) % NUM_COLORS];
+    }
+    if(ui32DstBPP == 4)
+    {
+        GrOffScreen4BPPPaletteSet(&sDst, pui32Palette, 0, NUM_COLORS);
+    }
+    else if(ui32DstBPP == 8)
+    {
+        GrOffScreen8BPPPaletteSet(&sDst, pui32Palette, 0, NUM_COLORS);
+    }
+    GrContextInit(&sContext, &sDst);
+    GrContextForegroundSet(&sContext, ClrDarkBlue);
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 0;
+    sRect.i16XMax = BLIT_WIDTH - 1;
+    sRect.i16YMax = BLIT_HEIGHT - 1;
+    GrRectFill(&sContext, &sRect);
+    PatternDraw(&sDst);
+
+    //
+    // Make the reference copy of the destination, and a copy of the source
+    // from which the reference is drawn.
+    //
+    memcpy(pui8Ref, pui8Dst, sizeof(g_pui32BlitDst));
+    BlitDisplayInit(&sRef, pui8Ref, ui32DstBPP, BLIT_WIDTH, BLIT_HEIGHT);
+    if(bSelf)
+    {
+        memcpy(g_pui32BlitCopy, pui8Dst, sizeof(g_pui32BlitCopy));
+        pui8Src = (uint8_t *)g_pui32BlitCopy;
+        sSrc = sDst;
+    }
+    else
+    {
+        pui8Src = BlitImageGet(ui32SrcBPP);
+        BlitDisplayInit(&sSrc, pui8Src, ui32SrcBPP, IMG_WIDTH, IMG_HEIGHT);
+    }
+
+    //
+    // Perform the blit, with pixels of value zero being transparent.
+    //
+    if(bTransparent)
+    {
+        GrOffScreenTransparentBlit(&sDst, &sSrc, psRect, i32X, i32Y, 0);
+    }
+    else
+    {
+        GrOffScreenBlit(&sDst, &sSrc, psRect, i32X, i32Y);
+    }
+
+    //
+    // Draw the expected result into the reference, a pixel at a time.
+    //
+    if(psRect)
+    {
+        sRect = *psRect;
+    }
+    else
+    {
+        sRect.i16XMin = 0;
+        sRect.i16YMin = 0;
+        sRect.i16XMax = sSrc.ui16Width - 1;
+        sRect.i16YMax = sSrc.ui16Height - 1;
+    }
+    for(i32SY = sRect.i16YMin; i32SY <= sRect.i16YMax; i32SY++)
+    {
+        for(i32SX = sRect.i16XMin; i32SX <= sRect.i16XMax; i32SX++)
+        {
+            i32DX = i32X + i32SX - sRect.i16XMin;
+            i32DY = i32Y + i32SY - sRect.i16YMin;
+            if((i32SX < 0) || (i32SY < 0) || (i32SX >= sSrc.ui16Width) ||
+               (i32SY >= sSrc.ui16Height) || (i32DX < 0) || (i32DY < 0) ||
+               (i32DX >= BLIT_WIDTH) || (i32DY >= BLIT_HEIGHT) ||
+               (bTransparent && !BlitPixelGet(pui8Src, i32SX, i32SY, false)))
+            {
+                continue;
+            }
+            DpyPixelDraw(&sRef, i32DX, i32DY,
+                         DpyColorTranslate(&sRef,
+                                           BlitPixelGet(pui8Src, i32SX, i32SY,
+                                                        true)));
+        }
+    }
+
+    //
+    // Count the pixels whose colors differ.
+    //
+    ui32Failed = 0;
+    for(i32DY = 0; i32DY < BLIT_HEIGHT; i32DY++)
+    {
+        for(i32DX = 0; i32DX < BLIT_WIDTH; i32DX++)
+        {
+            if(BlitPixelGet(pui8Dst, i32DX, i32DY, true) !=
+               BlitPixelGet(pui8Ref, i32DX, i32DY, true))
+            {
+                ui32Failed++;
+            }
+        }
+    }
+
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// Checks off-screen blits between every pair of pixel depths, with and
+// without palette conversion and transparency, including blits that are
+// clipped and blits within a single display.  Returns the number of pixels
+// which differ from the expected result.
+//
+//*****************************************************************************
+static uint32_t
+BlitCheck(void)
+{
+    static const tRectangle psRects[] =
+    {
+        { 0, 0, 47, 39 },
+        { 3, 1, 40, 30 },
+        { 1, 2, 33, 20 },
+        { -4, -4, 20, 20 },
+        { 10, 10, 47, 39 },
+        { 0, 0, 47, 39 },
+        { 5, 5, 4, 4 },
+    };
+    static const int16_t pi16Pos[][2] =
+    {
+        { 5, 3 }, { 7, 9 }, { 9, 4 }, { -3, 30 }, { 40, 30 }, { 60, 50 },
+        { 0, 0 },
+    };
+    static const tRectangle psSelfRects[] =
+    {
+        { 0, 0, 30, 30 },
+        { 10, 10, 40, 40 },
+        { 0, 0, 63, 55 },
+    };
+    static const int16_t pi16SelfPos[][2] =
+    {
+        { 5, 6 }, { 2, 3 }, { 8, 0 },
+    };
+    static const uint32_t pui32BPP[] = { 1, 4, 8, 16, 24 };
+    uint32_t ui32Src, ui32Dst, ui32Pass, ui32Idx, ui32Failed;
+    bool bTransparent;
+
+    ui32Failed = 0;
+    for(ui32Dst = 0; ui32Dst < 5; ui32Dst++)
+    {
+        for(ui32Pass = 0; ui32Pass < 4; ui32Pass++)
+        {
+            bTransparent = (ui32Pass & 1) ? true : false;
+
+            //
+            // Blits from each test image, onto a destination with either
+            // the same palette or a different one.
+            //
+            for(ui32Src = 0; ui32Src < 5; ui32Src++)
+            {
+                for(ui32Idx = 0; ui32Idx < 7; ui32Idx++)
+                {
+                    ui32Failed += BlitCaseCheck(pui32BPP[ui32Src],
+                                                pui32BPP[ui32Dst],
+                                                (ui32Pass < 2),
+                                                psRects + ui32Idx,
+                                                pi16Pos[ui32Idx][0],
+                                                pi16Pos[ui32Idx][1], false,
+                                                bTransparent);
+                }
+                ui32Failed += BlitCaseCheck(pui32BPP[ui32Src],
+                                            pui32BPP[ui32Dst], (ui32Pass < 2),
+                                            0, 1, 2, false, bTransparent);
+            }
+
+            //
+            // Overlapping blits within the destination.
+            //
+            for(ui32Idx = 0; ui32Idx < 3; ui32Idx++)
+            {
+                ui32Failed += BlitCaseCheck(pui32BPP[ui32Dst],
+                                            pui32BPP[ui32Dst], (ui32Pass < 2),
+                                            psSelfRects + ui32Idx,
+                                            pi16SelfPos[ui32Idx][0],
+                                            pi16SelfPos[ui32Idx][1], true,
+                                            bTransparent);
+            }
+        }
+    }
+
+    if(ui32Failed)
+    {
+        printf("%-22s FAILED (%u pixels differ)\n", "offscreen-blit",
+               ui32Failed);
+    }
+    else
+    {
+        printf("%-22s ok\n", "offscreen-blit");
+    }
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// Checks the images and fonts scenes drawn on a rotated display into a 16 BPP
+// buffer, for each rotation, against the same scene drawn on an unrotated
+// 16 BPP display.  The golden images are only used for 24 BPP buffers, so
+// this covers the rotated drawing of the 16 BPP driver.  Returns the number
+// of pixels which differ.
+//
+//*****************************************************************************
+static uint32_t
+RotatedCheck(void)
+{
+    static void (* const ppfnScenes[])(tContext *psContext) =
+    {
+        SceneImages, SceneFonts,
+    };
+    tDisplay sDisplay;
+    tContext sContext;
+    tRectangle sRect;
+    uint16_t *pui16Ref, *pui16Rotated;
+    uint32_t ui32Scene, ui32Rotation, ui32Failed;
+    int32_t i32X, i32Y;
+
+    ui32Failed = 0;
+    pui16Ref = (uint16_t *)(g_pui8Frame16 + 6);
+    pui16Rotated = (uint16_t *)(g_pui8RotatedImage + 6);
+    for(ui32Scene = 0; ui32Scene < 2; ui32Scene++)
+    {
+        //
+        // Draw the scene unrotated, starting from a black screen.
+        //
+        GrOffScreen16BPPInit(&sDisplay, g_pui8Frame16, WIDTH, HEIGHT);
+        GrContextInit(&sContext, &sDisplay);
+        GrContextForegroundSet(&sContext, ClrBlack);
+        sRect.i16XMin = 0;
+        sRect.i16YMin = 0;
+        sRect.i16XMax = WIDTH - 1;
+        sRect.i16YMax = HEIGHT - 1;
+        GrRectFill(&sContext, &sRect);
+        ppfnScenes[ui32Scene](&sContext);
+
+        //
+        // Draw it at each rotation and compare each pixel with the pixel at
+        // its rotated position.
+        //
+        for(ui32Rotation = GRLIB_ROTATE_90; ui32Rotation <= GRLIB_ROTATE_270;
+            ui32Rotation++)
+        {
+            RotatedDraw(ppfnScenes[ui32Scene], ui32Rotation,
+                        GrOffScreen16BPPInit);
+            for(i32Y = 0; i32Y < HEIGHT; i32Y++)
+            {
+                for(i32X = 0; i32X < WIDTH; i32X++)
+                {
+                    if(pui16Ref[(i32Y * WIDTH) + i32X] !=
+                       pui16Rotated[RotatedPixelOffset(ui32Rotation, i32X,
+                                                       i32Y)])
+                    {
+                        ui32Failed++;
+                    }
+                }
+            }
+        }
+    }
+
+    if(ui32Failed)
+    {
+        printf("%-22s FAILED (%u pixels differ)\n", "rotated-16bpp",
+               ui32Failed);
+    }
+    else
+    {
+        printf("%-22s ok\n", "rotated-16bpp");
+    }
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// A widget in the top left corner of the display which records the region it
+// is asked to paint, used to check the paint messages sent by
+// WidgetInvalidate().
+//
+//*****************************************************************************
+static tRectangle g_sPaintRegion;
+
+static int32_t
+PaintProbeMsgProc(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1,
+                  uint32_t ui32Param2)
+{
+    if(ui32Msg == WIDGET_MSG_PAINT)
+    {
+        if(!WidgetPaintRegionGet(psWidget, ui32Param1, ui32Param2,
+                                 &g_sPaintRegion))
+        {
+            g_sPaintRegion.i16XMin = -1;
+        }
+        return(1);
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Checks that the region passed to a widget's paint message is the part of
+// the widget within the invalidated region, including the single pixel
+// region at the origin, and that a full paint covers the whole widget.
+// Returns the number of regions which differ from those expected.
+//
+//*****************************************************************************
+static uint32_t
+PaintRegionCheck(void)
+{
+    static const tRectangle psCases[][2] =
+    {
+        { { 0, 0, 0, 0 }, { 0, 0, 0, 0 } },
+        { { 3, 4, 20, 20 }, { 3, 4, 9, 9 } },
+        { { -5, -5, 2, 1 }, { 0, 0, 2, 1 } },
+        { { 9, 0, 9, 0 }, { 9, 0, 9, 0 } },
+    };
+    static const tRectangle sFull = { 0, 0, 9, 9 };
+    tWidget sProbe;
+    uint32_t ui32Idx, ui32Failed;
+
+    sProbe.i32Size = sizeof(sProbe);
+    sProbe.psParent = 0;
+    sProbe.psNext = 0;
+    sProbe.psChild = 0;
+    sProbe.psDisplay = &g_sFrameDisplay;
+    sProbe.sPosition = sFull;
+    sProbe.pfnMsgProc = PaintProbeMsgProc;
+    WidgetAdd(WIDGET_ROOT, &sProbe);
+
+    ui32Failed = 0;
+    for(ui32Idx = 0; ui32Idx <= (sizeof(psCases) / sizeof(psCases[0]));
+        ui32Idx++)
+    {
+        g_sPaintRegion.i16XMin = -1;
+        if(ui32Idx < (sizeof(psCases) / sizeof(psCases[0])))
+        {
+            WidgetInvalidate(WIDGET_ROOT, &psCases[ui32Idx][0]);
+        }
+        else
+        {
+            WidgetPaint(&sProbe);
+        }
+        WidgetMessageQueueProcess();
+
+        if(memcmp(&g_sPaintRegion,
+                  ((ui32Idx < (sizeof(psCases) / sizeof(psCases[0]))) ?
+                   &psCases[ui32Idx][1] : &sFull), sizeof(tRectangle)))
+        {
+            ui32Failed++;
+        }
+    }
+    WidgetRemove(&sProbe);
+
+    if(ui32Failed)
+    {
+        printf("%-22s FAILED (%u regions differ)\n", "paint-region",
+               ui32Failed);
+    }
+    else
+    {
+        printf("%-22s ok\n", "paint-region");
+    }
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// Prints the usage message.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    printf("Usage: %s [OPTION]...\n", pcProgram);
+    printf("Benchmarks the graphics library and checks its output against "
+           "golden images.\n\n");
+    printf("  -b BPP   Benchmark with a 16 or 24 BPP frame buffer "
+           "(default 16)\n");
+    printf("  -c       Only compare against the golden images\n");
+    printf("  -d DIR   Directory containing the golden images "
+           "(default golden)\n");
+    printf("  -s       Only run the benchmarks\n");
+    printf("  -t SEC   Run each benchmark for SEC seconds (default %.2f)\n",
+           DEFAULT_DURATION);
+    printf("  -u       Update the golden images from the current output\n");
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    const char *pcDir;
+    bool bBench, bCompare, bUpdate;
+    uint32_t ui32BPP, ui32Failed;
+    double dDuration;
+    int iOpt;
+
+    pcDir = "golden";
+    bBench = true;
+    bCompare = true;
+    bUpdate = false;
+    ui32BPP = 16;
+    dDuration = DEFAULT_DURATION;
+
+    while((iOpt = getopt(argc, argv, "b:cd:hst:u")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'b':
+            {
+                ui32BPP = strtoul(optarg, 0, 0);
+                if((ui32BPP != 16) && (ui32BPP != 24))
+                {
+                    fprintf(stderr, "Unsupported pixel depth %s\n", optarg);
+                    return(1);
+                }
+                break;
+            }
+
+            case 'c':
+            {
+                bBench = false;
+                break;
+            }
+
+            case 'd':
+            {
+                pcDir = optarg;
+                break;
+            }
+
+            case 's':
+            {
+                bCompare = false;
+                break;
+            }
+
+            case 't':
+            {
+                dDuration = strtod(optarg, 0);
+                break;
+            }
+
+            case 'u':
+            {
+                bUpdate = true;
+                bBench = false;
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+
+    //
+    // Generate the test images and fonts, and attach the widget tree.
+    //
+    ImagesInit();
+    FontAAInit();
+    FontWideInit();
+    WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sBackground);
+
+    ui32Failed = 0;
+    if(bCompare || bUpdate)
+    {
+        ui32Failed = ScenesRun(pcDir, bUpdate);
+        if(!bUpdate)
+        {
+            ui32Failed += StringsCheck();
+            ui32Failed += ColorCacheCheck();
+            ui32Failed += BlitCheck();
+            ui32Failed += RotatedCheck();
+            ui32Failed += PaintRegionCheck();
+        }
+        if(bBench)
+        {
+            printf("\n");
+        }
+    }
+
+    if(bBench)
+    {
+        BenchmarksRun(ui32BPP, dDuration);
+    }
+
+    return(ui32Failed ? 1 : 0);
+}
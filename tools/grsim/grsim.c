@@ -0,0 +1,674 @@
+//*****************************************************************************
+//
+// grsim.c - Host-side harness which runs example applications headless.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+#include "utils/ringbuf.h"
+#include "drivers/kentec320x240x16_ssd2119.h"
+#include "drivers/pinout.h"
+#include "drivers/sound.h"
+#include "drivers/touch.h"
+#include "grsim.h"
+#include "headless.h"
+
+//*****************************************************************************
+//
+// This harness is linked with an unmodified example application and runs it
+// on the host machine, drawing on the headless display in place of the
+// display on the development kit.  The linker is asked to route the calls to
+// main() and to the function that the application's main loop uses to
+// process its input through wrappers in this file:
+//
+// - The main() wrapper parses the command line and sets up the headless
+//   display before calling the application's main().
+//
+// - Each call to WidgetMessageQueueProcess(), or each call to RingBufEmpty()
+//   which finds the ring buffer empty, ends a frame.  The frame's statistics
+//   are recorded (and a snapshot of the display written, if requested), and
+//   the pointer events which the event script schedules for the next frame
+//   are passed to the touch screen callback that the application registered
+//   (which is usually WidgetPointerMessage()).
+//
+// Once the last scripted event has been delivered and the requested number
+// of idle frames has passed, the statistics are printed and the program
+// exits.  All of the drawing done before the first frame ends (the
+// application's initialization and its first pass through the main loop) is
+// counted in frame 0.
+//
+// The board drivers that the applications use, other than the display
+// driver, are replaced by stubs which do nothing.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The default number of frames which are run after the last scripted event.
+//
+//*****************************************************************************
+#define DEFAULT_IDLE_FRAMES     2
+
+//*****************************************************************************
+//
+// The maximum number of events in an event script.
+//
+//*****************************************************************************
+#define MAX_EVENTS              65536
+
+//*****************************************************************************
+//
+// A pointer event read from the event script.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Frame;
+    uint32_t ui32Message;
+    int32_t i32X;
+    int32_t i32Y;
+}
+tEvent;
+
+//*****************************************************************************
+//
+// The events in the event script, ordered by frame, and the index of the
+// next event to deliver.
+//
+//*****************************************************************************
+static tEvent g_psEvents[MAX_EVENTS];
+static uint32_t g_ui32NumEvents;
+static uint32_t g_ui32NextEvent;
+
+//*****************************************************************************
+//
+// The options given on the command line.
+//
+//*****************************************************************************
+static const char *g_pcSnapshotPrefix;
+static uint32_t g_ui32IdleFrames = DEFAULT_IDLE_FRAMES;
+static bool g_bAllFrames;
+
+//*****************************************************************************
+//
+// The number of the current frame, the number of events delivered in it, the
+// time at which it started, and the statistics accumulated over all frames.
+//
+//*****************************************************************************
+static uint32_t g_ui32Frame;
+static uint32_t g_ui32FrameEvents;
+static uint64_t g_ui64FrameStart;
+static uint64_t g_ui64TotalTime;
+static uint32_t g_ui32TotalEvents;
+static tHeadlessStats g_sTotals;
+
+//*****************************************************************************
+//
+// The touch screen callback registered by the application.
+//
+//*****************************************************************************
+static int32_t (*g_pfnTouchCallback)(uint32_t ui32Message, int32_t i32X,
+                                     int32_t i32Y) = WidgetPointerMessage;
+
+//*****************************************************************************
+//
+// The column headings for the display driver callbacks, indexed by
+// HEADLESS_*.
+//
+//*****************************************************************************
+static const char * const g_ppcColumns[HEADLESS_NUM_CALLBACKS] =
+{
+    "Pixel", "Multi", "LineH", "LineV", "Rect", "Blit", "Copy", "Flush"
+};
+
+//*****************************************************************************
+//
+// The words which stand in for the bits accessed with HWREGBITW().
+//
+//*****************************************************************************
+#define MAX_BIT_WORDS           64
+static struct
+{
+    void *pvAddr;
+    uint32_t ui32Bit;
+    volatile uint32_t ui32Word;
+}
+g_psBitWords[MAX_BIT_WORDS];
+static uint32_t g_ui32NumBitWords;
+
+//*****************************************************************************
+//
+// The real functions which are wrapped by this harness.
+//
+//*****************************************************************************
+extern int __real_main(void);
+extern void __real_WidgetMessageQueueProcess(void);
+extern bool __real_RingBufEmpty(tRingBufObject *psRingBuf);
+
+//*****************************************************************************
+//
+// Returns the current time in microseconds.
+//
+//*****************************************************************************
+static uint64_t
+TimeGet(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return(((uint64_t)sTime.tv_sec * 1000000) + (sTime.tv_nsec / 1000));
+}
+
+//*****************************************************************************
+//
+// The graphics library only provides WidgetMutexGet() and WidgetCompareSwap()
+// for ARM compilers, so provide host implementations for the widget message
+// queue.
+//
+//*****************************************************************************
+uint32_t
+WidgetMutexGet(uint8_t *pi8Mutex)
+{
+    return(__atomic_exchange_n(pi8Mutex, 1, __ATOMIC_ACQUIRE) ? 1 : 0);
+}
+
+uint32_t
+WidgetCompareSwap(volatile uint32_t *pui32Value, uint32_t ui32Compare,
+                  uint32_t ui32Swap)
+{
+    return(__atomic_compare_exchange_n(pui32Value, &ui32Compare, ui32Swap,
+                                       false, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST) ? 0 : 1);
+}
+
+//*****************************************************************************
+//
+// Returns the word which stands in for a bit accessed with HWREGBITW().
+//
+//*****************************************************************************
+volatile uint32_t *
+GrSimBitWord(void *pvAddr, uint32_t ui32Bit)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < g_ui32NumBitWords; ui32Idx++)
+    {
+        if((g_psBitWords[ui32Idx].pvAddr == pvAddr) &&
+           (g_psBitWords[ui32Idx].ui32Bit == ui32Bit))
+        {
+            return(&g_psBitWords[ui32Idx].ui32Word);
+        }
+    }
+
+    if(g_ui32NumBitWords == MAX_BIT_WORDS)
+    {
+        fprintf(stderr, "Too many bit-band accesses\n");
+        exit(1);
+    }
+
+    g_psBitWords[g_ui32NumBitWords].pvAddr = pvAddr;
+    g_psBitWords[g_ui32NumBitWords].ui32Bit = ui32Bit;
+    g_psBitWords[g_ui32NumBitWords].ui32Word =
+        ((*(uint32_t *)pvAddr) >> ui32Bit) & 1;
+    return(&g_psBitWords[g_ui32NumBitWords++].ui32Word);
+}
+
+//*****************************************************************************
+//
+// Stubs for the board drivers and peripheral driver library functions used
+// by the applications.  The display is replaced by the headless display, the
+// system clock frequency requested by the application is reported as the
+// frequency that was achieved, and everything else does nothing.  There are
+// no interrupts on the host, so they are reported as having been enabled.
+//
+//*****************************************************************************
+bool
+IntMasterEnable(void)
+{
+    return(false);
+}
+
+bool
+IntMasterDisable(void)
+{
+    return(false);
+}
+
+uint32_t
+SysCtlClockFreqSet(uint32_t ui32Config, uint32_t ui32SysClock)
+{
+    return(ui32SysClock);
+}
+
+void
+SysCtlDelay(uint32_t ui32Count)
+{
+}
+
+void
+SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+}
+
+void
+uDMAControlBaseSet(void *pControlTable)
+{
+}
+
+void
+uDMAEnable(void)
+{
+}
+
+void
+PinoutSet(void)
+{
+}
+
+void
+Kentec320x240x16_SSD2119Init(uint32_t ui32SysClock)
+{
+}
+
+void
+TouchScreenInit(uint32_t ui32SysClock)
+{
+}
+
+void
+TouchScreenCallbackSet(int32_t (*pfnCallback)(uint32_t ui32Message,
+                                              int32_t i32X, int32_t i32Y))
+{
+    g_pfnTouchCallback = pfnCallback;
+}
+
+void
+SoundInit(uint32_t ui32SysClock)
+{
+}
+
+void
+SoundVolumeSet(int32_t i32Volume)
+{
+}
+
+bool
+SoundStart(int16_t *pi16Buffer, uint32_t ui32Length, uint32_t ui32Rate,
+           void (*pfnCallback)(uint32_t ui32Half))
+{
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Reads the event script.  Each line holds the frame in which an event is
+// delivered, the event ("down", "move", or "up"), and the X and Y position
+// of the pointer; blank lines and everything after a '#' are ignored.
+//
+//*****************************************************************************
+static bool
+EventsRead(const char *pcFilename)
+{
+    FILE *psFile;
+    char pcLine[256], pcEvent[16], *pcComment;
+    uint32_t ui32Line, ui32Frame;
+    int32_t i32X, i32Y;
+    int iFields;
+
+    psFile = fopen(pcFilename, "r");
+    if(!psFile)
+    {
+        fprintf(stderr, "Unable to open %s\n", pcFilename);
+        return(false);
+    }
+
+    ui32Line = 0;
+    ui32Frame = 0;
+    while(fgets(pcLine, sizeof(pcLine), psFile))
+    {
+        ui32Line++;
+        pcComment = strchr(pcLine, '#');
+        if(pcComment)
+        {
+            *pcComment = 0;
+        }
+
+        iFields = sscanf(pcLine, "%u %15s %d %d", &ui32Frame, pcEvent, &i32X,
+                         &i32Y);
+        if(iFields <= 0)
+        {
+            continue;
+        }
+
+        if((iFields != 4) || (g_ui32NumEvents == MAX_EVENTS) ||
+           (g_ui32NumEvents &&
+            (ui32Frame < g_psEvents[g_ui32NumEvents - 1].ui32Frame)))
+        {
+            fprintf(stderr, "%s:%u: Invalid event\n", pcFilename, ui32Line);
+            fclose(psFile);
+            return(false);
+        }
+
+        if(!strcmp(pcEvent, "down"))
+        {
+            g_psEvents[g_ui32NumEvents].ui32Message = WIDGET_MSG_PTR_DOWN;
+        }
+        else if(!strcmp(pcEvent, "move"))
+        {
+            g_psEvents[g_ui32NumEvents].ui32Message = WIDGET_MSG_PTR_MOVE;
+        }
+        else if(!strcmp(pcEvent, "up"))
+        {
+            g_psEvents[g_ui32NumEvents].ui32Message = WIDGET_MSG_PTR_UP;
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: Unknown event %s\n", pcFilename,
+                    ui32Line, pcEvent);
+            fclose(psFile);
+            return(false);
+        }
+
+        g_psEvents[g_ui32NumEvents].ui32Frame = ui32Frame;
+        g_psEvents[g_ui32NumEvents].i32X = i32X;
+        g_psEvents[g_ui32NumEvents].i32Y = i32Y;
+        g_ui32NumEvents++;
+    }
+
+    fclose(psFile);
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Adds the statistics for a frame to the totals and returns the total number
+// of driver calls and pixels.
+//
+//*****************************************************************************
+static void
+StatsAccumulate(const tHeadlessStats *psStats, uint64_t *pui64Calls,
+                uint64_t *pui64Pixels)
+{
+    uint32_t ui32Idx;
+
+    *pui64Calls = 0;
+    *pui64Pixels = 0;
+    for(ui32Idx = 0; ui32Idx < HEADLESS_NUM_CALLBACKS; ui32Idx++)
+    {
+        *pui64Calls += psStats->pui64Calls[ui32Idx];
+        *pui64Pixels += psStats->pui64Pixels[ui32Idx];
+        g_sTotals.pui64Calls[ui32Idx] += psStats->pui64Calls[ui32Idx];
+        g_sTotals.pui64Pixels[ui32Idx] += psStats->pui64Pixels[ui32Idx];
+    }
+}
+
+//*****************************************************************************
+//
+// Prints the totals for all frames and exits.
+//
+//*****************************************************************************
+static void
+Finish(void)
+{
+    uint64_t ui64Calls, ui64Pixels;
+    uint32_t ui32Idx;
+
+    printf("\n%-20s %12s %12s\n", "Callback", "Calls", "Pixels");
+    ui64Calls = 0;
+    ui64Pixels = 0;
+    for(ui32Idx = 0; ui32Idx < HEADLESS_NUM_CALLBACKS; ui32Idx++)
+    {
+        printf("%-20s %12llu %12llu\n", HeadlessCallbackName(ui32Idx),
+               (unsigned long long)g_sTotals.pui64Calls[ui32Idx],
+               (unsigned long long)g_sTotals.pui64Pixels[ui32Idx]);
+        ui64Calls += g_sTotals.pui64Calls[ui32Idx];
+        ui64Pixels += g_sTotals.pui64Pixels[ui32Idx];
+    }
+    printf("%-20s %12llu %12llu\n", "Total", (unsigned long long)ui64Calls,
+           (unsigned long long)ui64Pixels);
+    printf("\n%u frames, %u events, %.3f ms drawing\n", g_ui32Frame,
+           g_ui32TotalEvents, (double)g_ui64TotalTime / 1000);
+
+    exit(0);
+}
+
+//*****************************************************************************
+//
+// Ends the current frame and starts the next one, delivering the events
+// that the script schedules for it.
+//
+//*****************************************************************************
+static void
+FrameNext(void)
+{
+    tHeadlessStats sStats;
+    uint64_t ui64Time, ui64Calls, ui64Pixels;
+    char pcFilename[256];
+    uint32_t ui32Idx;
+
+    //
+    // Record the statistics for the frame which has ended.
+    //
+    ui64Time = TimeGet() - g_ui64FrameStart;
+    HeadlessStatsGet(&sStats, true);
+    StatsAccumulate(&sStats, &ui64Calls, &ui64Pixels);
+    g_ui64TotalTime += ui64Time;
+
+    if(ui64Calls || g_ui32FrameEvents || g_bAllFrames)
+    {
+        printf("%6u %3u", g_ui32Frame, g_ui32FrameEvents);
+        for(ui32Idx = 0; ui32Idx < HEADLESS_NUM_CALLBACKS; ui32Idx++)
+        {
+            printf(" %6llu", (unsigned long long)sStats.pui64Calls[ui32Idx]);
+        }
+        printf(" %8llu %8llu\n", (unsigned long long)ui64Pixels,
+               (unsigned long long)ui64Time);
+
+        //
+        // Write a snapshot of the display if anything was drawn.
+        //
+        if(g_pcSnapshotPrefix && ui64Calls)
+        {
+            snprintf(pcFilename, sizeof(pcFilename), "%s%04u.ppm",
+                     g_pcSnapshotPrefix, g_ui32Frame);
+            HeadlessPPMWrite(pcFilename);
+        }
+    }
+
+    //
+    // Stop once the idle frames after the last event have been run.
+    //
+    g_ui32Frame++;
+    if((g_ui32NextEvent == g_ui32NumEvents) &&
+       (g_ui32Frame > ((g_ui32NumEvents ?
+                        g_psEvents[g_ui32NumEvents - 1].ui32Frame : 0) +
+                       g_ui32IdleFrames)))
+    {
+        Finish();
+    }
+
+    //
+    // Deliver the events for the new frame.
+    //
+    g_ui32FrameEvents = 0;
+    while((g_ui32NextEvent < g_ui32NumEvents) &&
+          (g_psEvents[g_ui32NextEvent].ui32Frame <= g_ui32Frame))
+    {
+        g_pfnTouchCallback(g_psEvents[g_ui32NextEvent].ui32Message,
+                           g_psEvents[g_ui32NextEvent].i32X,
+                           g_psEvents[g_ui32NextEvent].i32Y);
+        g_ui32NextEvent++;
+        g_ui32FrameEvents++;
+    }
+    g_ui32TotalEvents += g_ui32FrameEvents;
+
+    //
+    // The time taken to write the snapshot and deliver the events is not
+    // charged to the application.
+    //
+    g_ui64FrameStart = TimeGet();
+}
+
+//*****************************************************************************
+//
+// The wrapper for the widget message queue processing function, which is
+// called once per pass through the main loop by applications that use the
+// widget framework.
+//
+//*****************************************************************************
+void
+__wrap_WidgetMessageQueueProcess(void)
+{
+    __real_WidgetMessageQueueProcess();
+    FrameNext();
+}
+
+//*****************************************************************************
+//
+// The wrapper for the ring buffer empty check, which is used by applications
+// that queue touch screen events for their main loop themselves.  A frame
+// ends each time that the main loop finds the queue empty.
+//
+//*****************************************************************************
+bool
+__wrap_RingBufEmpty(tRingBufObject *psRingBuf)
+{
+    if(!__real_RingBufEmpty(psRingBuf))
+    {
+        return(false);
+    }
+
+    FrameNext();
+    return(__real_RingBufEmpty(psRingBuf));
+}
+
+//*****************************************************************************
+//
+// Prints the usage information for this program.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    fprintf(stderr, "Usage: %s [options]\n", pcProgram);
+    fprintf(stderr, "Runs the application on a headless display.\n\n");
+    fprintf(stderr, "  -a          Report every frame, including idle "
+            "frames.\n");
+    fprintf(stderr, "  -e <file>   Replay the pointer events in the given "
+            "script.\n");
+    fprintf(stderr, "  -f <file>   Render into the given file (24-bit "
+            "pixels, blue first).\n");
+    fprintf(stderr, "  -h          Print this help.\n");
+    fprintf(stderr, "  -n <frames> Run this many frames after the last event "
+            "(default %u).\n", DEFAULT_IDLE_FRAMES);
+    fprintf(stderr, "  -p <prefix> Write <prefix>NNNN.ppm after each frame "
+            "that draws.\n");
+}
+
+//*****************************************************************************
+//
+// The wrapper for the application's main function, which sets up the
+// headless display before running the application.
+//
+//*****************************************************************************
+int
+__wrap_main(int argc, char *argv[])
+{
+    const char *pcFramebuffer;
+    uint32_t ui32Idx;
+    int iOpt;
+
+    pcFramebuffer = 0;
+    while((iOpt = getopt(argc, argv, "ae:f:hn:p:")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'a':
+            {
+                g_bAllFrames = true;
+                break;
+            }
+
+            case 'e':
+            {
+                if(!EventsRead(optarg))
+                {
+                    return(1);
+                }
+                break;
+            }
+
+            case 'f':
+            {
+                pcFramebuffer = optarg;
+                break;
+            }
+
+            case 'n':
+            {
+                g_ui32IdleFrames = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            case 'p':
+            {
+                g_pcSnapshotPrefix = optarg;
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+
+    if(!HeadlessInit(pcFramebuffer))
+    {
+        return(1);
+    }
+
+    printf("%6s %3s", "Frame", "Ev");
+    for(ui32Idx = 0; ui32Idx < HEADLESS_NUM_CALLBACKS; ui32Idx++)
+    {
+        printf(" %6s", g_ppcColumns[ui32Idx]);
+    }
+    printf(" %8s %8s\n", "Pixels", "usec");
+
+    //
+    // Run the application.  It does not return; the program exits from
+    // FrameNext() once the event script has been replayed.
+    //
+    g_ui64FrameStart = TimeGet();
+    return(__real_main());
+}
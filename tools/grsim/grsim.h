@@ -0,0 +1,63 @@
+//*****************************************************************************
+//
+// grsim.h - Definitions used to build example applications for the host.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#ifndef __GRSIM_H__
+#define __GRSIM_H__
+
+//*****************************************************************************
+//
+// This file is included ahead of every source file of an example
+// application, so that the application can be built for the host without
+// modification.
+//
+//*****************************************************************************
+#include <stdint.h>
+#include "inc/hw_types.h"
+
+//*****************************************************************************
+//
+// The ROM is not present on the host, so route the ROM functions used by the
+// applications to the stubs provided by the simulator.
+//
+//*****************************************************************************
+#define ROM_SysCtlPeripheralEnable                                            \
+        SysCtlPeripheralEnable
+#define ROM_uDMAControlBaseSet                                                \
+        uDMAControlBaseSet
+#define ROM_uDMAEnable                                                        \
+        uDMAEnable
+
+//*****************************************************************************
+//
+// The bit-band alias region does not exist on the host.  Instead, each bit
+// accessed with HWREGBITW() is given a word of its own, which is a faithful
+// replacement as long as the application only accesses the bit through
+// HWREGBITW() (which is the reason for using bit-banding in the first place).
+//
+//*****************************************************************************
+#undef HWREGBITW
+#define HWREGBITW(x, b)         (*GrSimBitWord((void *)(x), (b)))
+extern volatile uint32_t *GrSimBitWord(void *pvAddr, uint32_t ui32Bit);
+
+#endif // __GRSIM_H__
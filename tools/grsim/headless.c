@@ -0,0 +1,374 @@
+//*****************************************************************************
+//
+// headless.c - A display driver which renders into a memory-mapped file.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "grlib/grlib.h"
+#include "headless.h"
+
+//*****************************************************************************
+//
+// This display driver draws into a 24 BPP frame buffer which is a shared
+// memory mapping of a file, so that another process (an image viewer, or a
+// script which samples the file) sees every pixel as soon as it is drawn.
+// The file holds HEADLESS_WIDTH * HEADLESS_HEIGHT pixels, row by row, with
+// three bytes per pixel stored blue, green, red; this is the pixel layout of
+// the 24 BPP off-screen display driver, which does the actual drawing.
+//
+// Every call made into the driver is counted, along with the number of
+// pixels that it writes, so that the cost of the drawing done by an
+// application can be measured.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The size of the header which the off-screen display driver places before
+// the pixel data in its buffer.
+//
+//*****************************************************************************
+#define HEADER_SIZE             (GrOffScreen24BPPSize(0, 0))
+
+//*****************************************************************************
+//
+// The size of the pixel data.
+//
+//*****************************************************************************
+#define PIXEL_SIZE              (GrOffScreen24BPPSize(HEADLESS_WIDTH,         \
+                                                      HEADLESS_HEIGHT) -      \
+                                 HEADER_SIZE)
+
+//*****************************************************************************
+//
+// The off-screen display which draws into the mapped file, and a pointer to
+// the start of the pixel data.
+//
+//*****************************************************************************
+static tDisplay g_sDriverDisplay;
+static uint8_t *g_pui8Pixels;
+
+//*****************************************************************************
+//
+// The statistics accumulated since they were last reset.
+//
+//*****************************************************************************
+static tHeadlessStats g_sStats;
+
+//*****************************************************************************
+//
+// The names of the driver callbacks, indexed by HEADLESS_*.
+//
+//*****************************************************************************
+static const char * const g_ppcCallbackNames[HEADLESS_NUM_CALLBACKS] =
+{
+    "PixelDraw",
+    "PixelDrawMultiple",
+    "LineDrawH",
+    "LineDrawV",
+    "RectFill",
+    "Blit",
+    "RectCopy",
+    "Flush"
+};
+
+//*****************************************************************************
+//
+// Counts a call to a driver callback which writes the given number of
+// pixels.
+//
+//*****************************************************************************
+static void
+Count(uint32_t ui32Callback, int32_t i32Pixels)
+{
+    g_sStats.pui64Calls[ui32Callback]++;
+    g_sStats.pui64Pixels[ui32Callback] += (i32Pixels > 0) ? i32Pixels : 0;
+}
+
+//*****************************************************************************
+//
+// Returns the number of pixels in a rectangle.
+//
+//*****************************************************************************
+static int32_t
+RectPixels(const tRectangle *psRect)
+{
+    return((psRect->i16XMax - psRect->i16XMin + 1) *
+           (psRect->i16YMax - psRect->i16YMin + 1));
+}
+
+//*****************************************************************************
+//
+// The display driver callbacks.  Each counts the call and then passes the
+// operation on to the off-screen display.
+//
+//*****************************************************************************
+static void
+HeadlessPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                  uint32_t ui32Value)
+{
+    Count(HEADLESS_PIXEL_DRAW, 1);
+    DpyPixelDraw(&g_sDriverDisplay, i32X, i32Y, ui32Value);
+}
+
+static void
+HeadlessPixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                          int32_t i32X0, int32_t i32Count, int32_t i32BPP,
+                          const uint8_t *pui8Data,
+                          const uint8_t *pui8Palette)
+{
+    Count(HEADLESS_PIXEL_MULTIPLE, i32Count);
+    DpyPixelDrawMultiple(&g_sDriverDisplay, i32X, i32Y, i32X0, i32Count,
+                         i32BPP, pui8Data, pui8Palette);
+}
+
+static void
+HeadlessLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2,
+                  int32_t i32Y, uint32_t ui32Value)
+{
+    Count(HEADLESS_LINE_DRAW_H, i32X2 - i32X1 + 1);
+    DpyLineDrawH(&g_sDriverDisplay, i32X1, i32X2, i32Y, ui32Value);
+}
+
+static void
+HeadlessLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1,
+                  int32_t i32Y2, uint32_t ui32Value)
+{
+    Count(HEADLESS_LINE_DRAW_V, i32Y2 - i32Y1 + 1);
+    DpyLineDrawV(&g_sDriverDisplay, i32X, i32Y1, i32Y2, ui32Value);
+}
+
+static void
+HeadlessRectFill(void *pvDisplayData, const tRectangle *psRect,
+                 uint32_t ui32Value)
+{
+    Count(HEADLESS_RECT_FILL, RectPixels(psRect));
+    DpyRectFill(&g_sDriverDisplay, psRect, ui32Value);
+}
+
+static void
+HeadlessBlit(void *pvDisplayData, const tRectangle *psRect, int32_t i32X0,
+             int32_t i32BPP, const uint8_t *pui8Data, int32_t i32Stride,
+             const uint8_t *pui8Palette)
+{
+    Count(HEADLESS_BLIT, RectPixels(psRect));
+    DpyBlit(&g_sDriverDisplay, psRect, i32X0, i32BPP, pui8Data, i32Stride,
+            pui8Palette);
+}
+
+static void
+HeadlessRectCopy(void *pvDisplayData, const tRectangle *psRect, int32_t i32X,
+                 int32_t i32Y)
+{
+    Count(HEADLESS_RECT_COPY, RectPixels(psRect));
+    DpyRectCopy(&g_sDriverDisplay, psRect, i32X, i32Y);
+}
+
+static uint32_t
+HeadlessColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    return(DpyColorTranslate(&g_sDriverDisplay, ui32Value));
+}
+
+static void
+HeadlessFlush(void *pvDisplayData)
+{
+    Count(HEADLESS_FLUSH, 0);
+    DpyFlush(&g_sDriverDisplay);
+}
+
+//*****************************************************************************
+//
+//! The headless display structure.  It is constant so that applications can
+//! reference it in the same way as the display structure of a real display
+//! driver; HeadlessInit() must be called before it is drawn on.
+//
+//*****************************************************************************
+const tDisplay g_sHeadlessDisplay =
+{
+    sizeof(tDisplay),
+    0,
+    HEADLESS_WIDTH,
+    HEADLESS_HEIGHT,
+    HeadlessPixelDraw,
+    HeadlessPixelDrawMultiple,
+    HeadlessLineDrawH,
+    HeadlessLineDrawV,
+    HeadlessRectFill,
+    HeadlessColorTranslate,
+    HeadlessFlush,
+    HeadlessBlit,
+    HeadlessRectCopy
+};
+
+//*****************************************************************************
+//
+//! Initializes the headless display.
+//!
+//! \param pcFilename is the name of the file into which the display is
+//! rendered, or 0 to render into anonymous memory.
+//!
+//! The file is created if it does not exist and is resized to hold the frame
+//! buffer.  Its existing contents are preserved, so an application which
+//! does not redraw the whole screen leaves the previous run's pixels behind,
+//! as a real display would.
+//!
+//! \return Returns \b true if the display was initialized and \b false if
+//! the file could not be mapped.
+//
+//*****************************************************************************
+bool
+HeadlessInit(const char *pcFilename)
+{
+    uint8_t *pui8Map;
+    long lPage;
+    int iFile;
+
+    //
+    // The off-screen display expects its header immediately before the
+    // pixel data, but the file should hold only pixels.  Reserve a page of
+    // anonymous memory ahead of the pixels to hold the header, and map the
+    // file (if any) over the remainder of the reservation.
+    //
+    lPage = sysconf(_SC_PAGESIZE);
+    pui8Map = mmap(0, lPage + PIXEL_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(pui8Map == MAP_FAILED)
+    {
+        return(false);
+    }
+    g_pui8Pixels = pui8Map + lPage;
+
+    if(pcFilename)
+    {
+        iFile = open(pcFilename, O_RDWR | O_CREAT, 0644);
+        if(iFile < 0)
+        {
+            fprintf(stderr, "Unable to open %s\n", pcFilename);
+            return(false);
+        }
+        if((ftruncate(iFile, PIXEL_SIZE) != 0) ||
+           (mmap(g_pui8Pixels, PIXEL_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_FIXED, iFile, 0) == MAP_FAILED))
+        {
+            fprintf(stderr, "Unable to map %s\n", pcFilename);
+            close(iFile);
+            return(false);
+        }
+
+        //
+        // The mapping remains valid after the file is closed.
+        //
+        close(iFile);
+    }
+
+    GrOffScreen24BPPInit(&g_sDriverDisplay, g_pui8Pixels - HEADER_SIZE,
+                         HEADLESS_WIDTH, HEADLESS_HEIGHT);
+    memset(&g_sStats, 0, sizeof(g_sStats));
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Gets the display driver statistics.
+//!
+//! \param psStats is a pointer to the structure which receives the number of
+//! calls made into, and pixels written by, each driver callback.
+//! \param bReset is \b true if the statistics should be reset once they have
+//! been read.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+HeadlessStatsGet(tHeadlessStats *psStats, bool bReset)
+{
+    *psStats = g_sStats;
+    if(bReset)
+    {
+        memset(&g_sStats, 0, sizeof(g_sStats));
+    }
+}
+
+//*****************************************************************************
+//
+//! Gets the name of a display driver callback.
+//!
+//! \param ui32Callback is one of the \b HEADLESS_* callback indices.
+//!
+//! \return Returns the name of the callback.
+//
+//*****************************************************************************
+const char *
+HeadlessCallbackName(uint32_t ui32Callback)
+{
+    return((ui32Callback < HEADLESS_NUM_CALLBACKS) ?
+           g_ppcCallbackNames[ui32Callback] : "?");
+}
+
+//*****************************************************************************
+//
+//! Writes the contents of the headless display to a binary PPM file.
+//!
+//! \param pcFilename is the name of the file to write.
+//!
+//! \return Returns \b true if the file was written and \b false otherwise.
+//
+//*****************************************************************************
+bool
+HeadlessPPMWrite(const char *pcFilename)
+{
+    FILE *psFile;
+    uint8_t *pui8Pixel;
+    uint32_t ui32Idx;
+
+    psFile = fopen(pcFilename, "wb");
+    if(!psFile)
+    {
+        fprintf(stderr, "Unable to create %s\n", pcFilename);
+        return(false);
+    }
+
+    fprintf(psFile, "P6\n%d %d\n255\n", HEADLESS_WIDTH, HEADLESS_HEIGHT);
+
+    //
+    // The frame buffer stores pixels as blue, green, red.
+    //
+    pui8Pixel = g_pui8Pixels;
+    for(ui32Idx = 0; ui32Idx < (HEADLESS_WIDTH * HEADLESS_HEIGHT);
+        ui32Idx++, pui8Pixel += 3)
+    {
+        fputc(pui8Pixel[2], psFile);
+        fputc(pui8Pixel[1], psFile);
+        fputc(pui8Pixel[0], psFile);
+    }
+
+    fclose(psFile);
+    return(true);
+}
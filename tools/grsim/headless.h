@@ -0,0 +1,80 @@
+//*****************************************************************************
+//
+// headless.h - Prototypes for the headless display driver.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#ifndef __HEADLESS_H__
+#define __HEADLESS_H__
+
+//*****************************************************************************
+//
+// The dimensions of the headless display, which match the display on the
+// development kit.
+//
+//*****************************************************************************
+#ifndef HEADLESS_WIDTH
+#define HEADLESS_WIDTH          320
+#endif
+#ifndef HEADLESS_HEIGHT
+#define HEADLESS_HEIGHT         240
+#endif
+
+//*****************************************************************************
+//
+// The display driver callbacks for which statistics are kept.
+//
+//*****************************************************************************
+#define HEADLESS_PIXEL_DRAW     0
+#define HEADLESS_PIXEL_MULTIPLE 1
+#define HEADLESS_LINE_DRAW_H    2
+#define HEADLESS_LINE_DRAW_V    3
+#define HEADLESS_RECT_FILL      4
+#define HEADLESS_BLIT           5
+#define HEADLESS_RECT_COPY      6
+#define HEADLESS_FLUSH          7
+#define HEADLESS_NUM_CALLBACKS  8
+
+//*****************************************************************************
+//
+// The statistics kept by the headless display.  The pixel counts are the
+// number of pixels written by each callback (or, for a flush, zero).
+//
+//*****************************************************************************
+typedef struct
+{
+    uint64_t pui64Calls[HEADLESS_NUM_CALLBACKS];
+    uint64_t pui64Pixels[HEADLESS_NUM_CALLBACKS];
+}
+tHeadlessStats;
+
+//*****************************************************************************
+//
+// Prototypes.
+//
+//*****************************************************************************
+extern const tDisplay g_sHeadlessDisplay;
+extern bool HeadlessInit(const char *pcFilename);
+extern void HeadlessStatsGet(tHeadlessStats *psStats, bool bReset);
+extern const char *HeadlessCallbackName(uint32_t ui32Callback);
+extern bool HeadlessPPMWrite(const char *pcFilename);
+
+#endif // __HEADLESS_H__
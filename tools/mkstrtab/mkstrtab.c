@@ -0,0 +1,1232 @@
+//*****************************************************************************
+//
+// mkstrtab.c - Generates an extended string table from a CSV file.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Graphics Library.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "grlib/grlib.h"
+
+//*****************************************************************************
+//
+// This program reads a CSV file in the format accepted by the string
+// compression utility and writes a C source file and header describing the
+// strings as an extended string table (tStringTableEx).  The first row of
+// the file holds the language identifier (GrLang*) of each column after the
+// first, and each following row holds the name of a string followed by the
+// string in each language.
+//
+// The strings are compressed with a dictionary shared by all languages.
+// The dictionary is built greedily: in each pass, every substring of the
+// text which has not yet been replaced by a dictionary reference is counted,
+// and the substrings which save the most space (after paying for their own
+// storage in the dictionary) are added to the dictionary and replaced
+// throughout the table.  Once no substring saves any space, the words are
+// sorted so that the most used words get the one byte references.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The maximum length of a dictionary word, and the maximum number of words
+// added to the dictionary in each pass.
+//
+//*****************************************************************************
+#define MAX_WORD_LEN            32
+#define WORDS_PER_PASS          32
+
+//*****************************************************************************
+//
+// A token of an encoded string, which is either a literal character (below
+// TOKEN_WORD) or a reference to dictionary word (token - TOKEN_WORD).
+//
+//*****************************************************************************
+#define TOKEN_WORD              0x100
+
+//*****************************************************************************
+//
+// A string from the input, and its encoding as a sequence of tokens.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint8_t *pui8Text;
+    uint32_t ui32Len;
+    uint32_t *pui32Tokens;
+    uint32_t ui32NumTokens;
+}
+tString;
+
+//*****************************************************************************
+//
+// A dictionary word, or a candidate for one.  For a candidate, i32Runs is
+// the change in the number of runs of literal characters (each of which
+// costs a code byte) if every occurrence is replaced by a reference.
+//
+//*****************************************************************************
+typedef struct
+{
+    const uint8_t *pui8Text;
+    uint32_t ui32Len;
+    uint32_t ui32Count;
+    int32_t i32Runs;
+    int32_t i32Saving;
+    uint32_t ui32Code;
+}
+tWord;
+
+//*****************************************************************************
+//
+// The strings, indexed by (language * g_ui32NumStrings) + string, the names
+// of the strings and the languages.
+//
+//*****************************************************************************
+static tString *g_psStrings;
+static char **g_ppcNames;
+static char **g_ppcLanguages;
+static uint32_t g_ui32NumStrings;
+static uint32_t g_ui32NumLanguages;
+
+//*****************************************************************************
+//
+// The dictionary.
+//
+//*****************************************************************************
+static tWord g_psWords[STRING_MAX_WORDS];
+static uint32_t g_ui32NumWords;
+static uint32_t g_ui32MaxWords = STRING_MAX_WORDS;
+
+//*****************************************************************************
+//
+// The hash table used to count the candidate words in each pass.
+//
+//*****************************************************************************
+static tWord *g_psCandidates;
+static uint32_t g_ui32HashSize;
+
+//*****************************************************************************
+//
+// Allocates memory, exiting if none is available.
+//
+//*****************************************************************************
+static void *
+Alloc(size_t sSize)
+{
+    void *pvMem;
+
+    pvMem = calloc(1, sSize ? sSize : 1);
+    if(!pvMem)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    return(pvMem);
+}
+
+//*****************************************************************************
+//
+// Reads a field from a CSV file.  Returns the field (which must be freed by
+// the caller), or 0 at the end of the file.  *pbEndOfRow is set if the field
+// is the last in its row.
+//
+//*****************************************************************************
+static char *
+CSVFieldRead(FILE *psFile, bool *pbEndOfRow)
+{
+    char *pcField;
+    uint32_t ui32Len, ui32Size;
+    bool bQuoted;
+    int iChar;
+
+    ui32Size = 64;
+    ui32Len = 0;
+    pcField = Alloc(ui32Size);
+    bQuoted = false;
+
+    iChar = fgetc(psFile);
+    if(iChar == EOF)
+    {
+        free(pcField);
+        return(0);
+    }
+
+    while(1)
+    {
+        if(bQuoted && (iChar == '"'))
+        {
+            //
+            // A doubled quote is a quote character; otherwise the quoted
+            // section ends.
+            //
+            iChar = fgetc(psFile);
+            if(iChar != '"')
+            {
+                bQuoted = false;
+                continue;
+            }
+        }
+        else if(!bQuoted && (iChar == '"'))
+        {
+            bQuoted = true;
+            iChar = fgetc(psFile);
+            continue;
+        }
+        else if(!bQuoted && (iChar == ','))
+        {
+            *pbEndOfRow = false;
+            break;
+        }
+        else if(!bQuoted && ((iChar == '\n') || (iChar == EOF)))
+        {
+            *pbEndOfRow = true;
+            break;
+        }
+        else if(!bQuoted && (iChar == '\r'))
+        {
+            iChar = fgetc(psFile);
+            continue;
+        }
+        else if(iChar == EOF)
+        {
+            *pbEndOfRow = true;
+            break;
+        }
+
+        if((ui32Len + 1) == ui32Size)
+        {
+            ui32Size *= 2;
+            pcField = realloc(pcField, ui32Size);
+            if(!pcField)
+            {
+                fprintf(stderr, "Out of memory\n");
+                exit(1);
+            }
+        }
+        pcField[ui32Len++] = iChar;
+        iChar = fgetc(psFile);
+    }
+
+    pcField[ui32Len] = 0;
+    return(pcField);
+}
+
+//*****************************************************************************
+//
+// Reads the strings from a CSV file.
+//
+//*****************************************************************************
+static bool
+CSVRead(const char *pcFilename)
+{
+    FILE *psFile;
+    char *pcField, **ppcRow;
+    uint32_t ui32Rows, ui32Col, ui32Idx;
+    bool bEndOfRow;
+
+    psFile = fopen(pcFilename, "rb");
+    if(!psFile)
+    {
+        fprintf(stderr, "Unable to open %s\n", pcFilename);
+        return(false);
+    }
+
+    //
+    // Skip a UTF-8 byte order mark, if there is one.
+    //
+    if((fgetc(psFile) != 0xef) || (fgetc(psFile) != 0xbb) ||
+       (fgetc(psFile) != 0xbf))
+    {
+        rewind(psFile);
+    }
+
+    //
+    // Read the language identifiers from the first row, ignoring the first
+    // column and any empty columns at the end of the row.
+    //
+    g_ppcLanguages = Alloc(sizeof(char *) * 256);
+    ui32Col = 0;
+    do
+    {
+        pcField = CSVFieldRead(psFile, &bEndOfRow);
+        if(!pcField)
+        {
+            break;
+        }
+        if(ui32Col && *pcField && (g_ui32NumLanguages < 256))
+        {
+            g_ppcLanguages[g_ui32NumLanguages++] = pcField;
+        }
+        else
+        {
+            free(pcField);
+        }
+        ui32Col++;
+    }
+    while(!bEndOfRow);
+
+    if(!g_ui32NumLanguages)
+    {
+        fprintf(stderr, "%s: No languages found\n", pcFilename);
+        fclose(psFile);
+        return(false);
+    }
+
+    //
+    // Read each row, holding the name and the string for each language.
+    // Rows are stored language by language once they have all been read, so
+    // keep them in row order for now.
+    //
+    ui32Rows = 0;
+    ppcRow = 0;
+    while(1)
+    {
+        pcField = CSVFieldRead(psFile, &bEndOfRow);
+        if(!pcField)
+        {
+            break;
+        }
+        if(!*pcField && bEndOfRow)
+        {
+            free(pcField);
+            continue;
+        }
+
+        ppcRow = realloc(ppcRow, sizeof(char *) * (ui32Rows + 1) *
+                         (g_ui32NumLanguages + 1));
+        if(!ppcRow)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        ppcRow[ui32Rows * (g_ui32NumLanguages + 1)] = pcField;
+
+        for(ui32Col = 1; ui32Col <= g_ui32NumLanguages; ui32Col++)
+        {
+            pcField = bEndOfRow ? 0 : CSVFieldRead(psFile, &bEndOfRow);
+            ppcRow[(ui32Rows * (g_ui32NumLanguages + 1)) + ui32Col] =
+                pcField ? pcField : Alloc(1);
+        }
+
+        //
+        // Ignore any extra columns.
+        //
+        while(!bEndOfRow)
+        {
+            pcField = CSVFieldRead(psFile, &bEndOfRow);
+            if(!pcField)
+            {
+                break;
+            }
+            free(pcField);
+        }
+
+        ui32Rows++;
+    }
+    fclose(psFile);
+
+    if(!ui32Rows || (ui32Rows > 0xffff))
+    {
+        fprintf(stderr, "%s: Invalid number of strings\n", pcFilename);
+        return(false);
+    }
+
+    //
+    // Store the strings by language.
+    //
+    g_ui32NumStrings = ui32Rows;
+    g_ppcNames = Alloc(sizeof(char *) * g_ui32NumStrings);
+    g_psStrings = Alloc(sizeof(tString) * g_ui32NumStrings *
+                        g_ui32NumLanguages);
+    for(ui32Idx = 0; ui32Idx < g_ui32NumStrings; ui32Idx++)
+    {
+        g_ppcNames[ui32Idx] = ppcRow[ui32Idx * (g_ui32NumLanguages + 1)];
+        for(ui32Col = 0; ui32Col < g_ui32NumLanguages; ui32Col++)
+        {
+            tString *psString;
+
+            psString = &g_psStrings[(ui32Col * g_ui32NumStrings) + ui32Idx];
+            psString->pui8Text =
+                (uint8_t *)ppcRow[(ui32Idx * (g_ui32NumLanguages + 1)) +
+                                  ui32Col + 1];
+            psString->ui32Len = strlen((char *)psString->pui8Text);
+        }
+    }
+    free(ppcRow);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Returns the number of bytes needed to encode a reference to a word.
+//
+//*****************************************************************************
+static uint32_t
+WordRefSize(uint32_t ui32Word)
+{
+    return((ui32Word < STRING_NUM_SHORT_WORDS) ? 1 : 2);
+}
+
+//*****************************************************************************
+//
+// Returns the number of bytes needed to encode a string: each run of literal
+// characters is preceded by a code byte for every STRING_MAX_RUN characters,
+// followed by the references to the words.
+//
+//*****************************************************************************
+static uint32_t
+EncodedSize(const tString *psString)
+{
+    uint32_t ui32Tok, ui32Run, ui32Size;
+
+    ui32Size = 0;
+    ui32Run = 0;
+    for(ui32Tok = 0; ui32Tok < psString->ui32NumTokens; ui32Tok++)
+    {
+        if(psString->pui32Tokens[ui32Tok] < TOKEN_WORD)
+        {
+            if((ui32Run++ % STRING_MAX_RUN) == 0)
+            {
+                ui32Size++;
+            }
+            ui32Size++;
+        }
+        else
+        {
+            ui32Run = 0;
+            ui32Size += WordRefSize(psString->pui32Tokens[ui32Tok] -
+                                    TOKEN_WORD);
+        }
+    }
+    return(ui32Size);
+}
+
+//*****************************************************************************
+//
+// Returns the hash of a sequence of bytes.
+//
+//*****************************************************************************
+static uint32_t
+Hash(const uint8_t *pui8Text, uint32_t ui32Len)
+{
+    uint32_t ui32Hash;
+
+    ui32Hash = 2166136261u;
+    while(ui32Len--)
+    {
+        ui32Hash = (ui32Hash ^ *pui8Text++) * 16777619u;
+    }
+    return(ui32Hash);
+}
+
+//*****************************************************************************
+//
+// Counts an occurrence of a candidate word, which changes the number of runs
+// of literals by i32Runs if it is replaced.  Returns false if the hash table
+// is full.
+//
+//*****************************************************************************
+static bool
+CandidateCount(const uint8_t *pui8Text, uint32_t ui32Len, int32_t i32Runs)
+{
+    tWord *psWord;
+    uint32_t ui32Idx;
+
+    ui32Idx = Hash(pui8Text, ui32Len) & (g_ui32HashSize - 1);
+    while(1)
+    {
+        psWord = &g_psCandidates[ui32Idx];
+        if(!psWord->ui32Len)
+        {
+            psWord->pui8Text = pui8Text;
+            psWord->ui32Len = ui32Len;
+            psWord->ui32Count = 1;
+            psWord->i32Runs = i32Runs;
+            return(true);
+        }
+        if((psWord->ui32Len == ui32Len) &&
+           !memcmp(psWord->pui8Text, pui8Text, ui32Len))
+        {
+            psWord->ui32Count++;
+            psWord->i32Runs += i32Runs;
+            return(true);
+        }
+        ui32Idx = (ui32Idx + 1) & (g_ui32HashSize - 1);
+    }
+}
+
+//*****************************************************************************
+//
+// Sorts candidate words by decreasing saving.
+//
+//*****************************************************************************
+static int
+CandidateCompare(const void *pvA, const void *pvB)
+{
+    const tWord *psA = pvA, *psB = pvB;
+
+    if(psA->i32Saving != psB->i32Saving)
+    {
+        return((psA->i32Saving > psB->i32Saving) ? -1 : 1);
+    }
+    return((int)psB->ui32Len - (int)psA->ui32Len);
+}
+
+//*****************************************************************************
+//
+// Returns true if one sequence of bytes contains the other.
+//
+//*****************************************************************************
+static bool
+Overlaps(const tWord *psA, const tWord *psB)
+{
+    const tWord *psShort, *psLong;
+    uint32_t ui32Idx;
+
+    psShort = (psA->ui32Len <= psB->ui32Len) ? psA : psB;
+    psLong = (psShort == psA) ? psB : psA;
+    for(ui32Idx = 0; (ui32Idx + psShort->ui32Len) <= psLong->ui32Len;
+        ui32Idx++)
+    {
+        if(!memcmp(psLong->pui8Text + ui32Idx, psShort->pui8Text,
+                   psShort->ui32Len))
+        {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+//*****************************************************************************
+//
+// Replaces each occurrence of a word in the literal tokens of the strings by
+// a reference to the word.  Returns the number of occurrences replaced.
+//
+//*****************************************************************************
+static uint32_t
+WordReplace(uint32_t ui32Word)
+{
+    const tWord *psWord;
+    tString *psString;
+    uint32_t ui32Idx, ui32In, ui32Out, ui32Len, ui32Count;
+
+    psWord = &g_psWords[ui32Word];
+    ui32Count = 0;
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        ui32In = 0;
+        ui32Out = 0;
+        while(ui32In < psString->ui32NumTokens)
+        {
+            //
+            // See if the word starts here, as a run of literals.
+            //
+            for(ui32Len = 0;
+                (ui32Len < psWord->ui32Len) &&
+                ((ui32In + ui32Len) < psString->ui32NumTokens) &&
+                (psString->pui32Tokens[ui32In + ui32Len] ==
+                 psWord->pui8Text[ui32Len]);
+                ui32Len++)
+            {
+            }
+
+            if(ui32Len == psWord->ui32Len)
+            {
+                psString->pui32Tokens[ui32Out++] = TOKEN_WORD + ui32Word;
+                ui32In += ui32Len;
+                ui32Count++;
+            }
+            else
+            {
+                psString->pui32Tokens[ui32Out++] =
+                    psString->pui32Tokens[ui32In++];
+            }
+        }
+        psString->ui32NumTokens = ui32Out;
+    }
+
+    return(ui32Count);
+}
+
+//*****************************************************************************
+//
+// Runs one pass of the dictionary construction.  Returns the number of words
+// added to the dictionary.
+//
+//*****************************************************************************
+static uint32_t
+DictionaryPass(void)
+{
+    tString *psString;
+    tWord *psWord, psPicked[WORDS_PER_PASS];
+    uint32_t ui32Idx, ui32Start, ui32End, ui32Num, ui32Picked;
+    uint32_t ui32Pick, ui32RefSize;
+    int32_t i32Runs;
+    bool bOverlap;
+
+    //
+    // Count every substring of each run of literal tokens.
+    //
+    memset(g_psCandidates, 0, sizeof(tWord) * g_ui32HashSize);
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        for(ui32Start = 0; ui32Start < psString->ui32NumTokens; ui32Start++)
+        {
+            for(ui32End = ui32Start;
+                (ui32End < psString->ui32NumTokens) &&
+                (psString->pui32Tokens[ui32End] < TOKEN_WORD) &&
+                ((ui32End - ui32Start) < MAX_WORD_LEN); ui32End++)
+            {
+                //
+                // Candidates are built from the original text, which the
+                // literal tokens match.  Replacing the candidate splits the
+                // run of literals holding it in two, unless it is at the
+                // start or end of the run; if it is the whole run then the
+                // run disappears.
+                //
+                psString->pui8Text[ui32End] = psString->pui32Tokens[ui32End];
+                i32Runs = -1;
+                if((ui32Start > 0) &&
+                   (psString->pui32Tokens[ui32Start - 1] < TOKEN_WORD))
+                {
+                    i32Runs++;
+                }
+                if(((ui32End + 1) < psString->ui32NumTokens) &&
+                   (psString->pui32Tokens[ui32End + 1] < TOKEN_WORD))
+                {
+                    i32Runs++;
+                }
+                CandidateCount(psString->pui8Text + ui32Start,
+                               ui32End - ui32Start + 1, i32Runs);
+            }
+        }
+    }
+
+    //
+    // Compute the saving for each candidate: the bytes saved by replacing
+    // each occurrence by a reference (including the codes of the runs of
+    // literals which are removed or added), less the storage for the word
+    // and its offset.
+    //
+    ui32RefSize = (g_ui32NumWords < STRING_NUM_SHORT_WORDS) ? 1 : 2;
+    ui32Num = 0;
+    for(ui32Idx = 0; ui32Idx < g_ui32HashSize; ui32Idx++)
+    {
+        psWord = &g_psCandidates[ui32Idx];
+        if(!psWord->ui32Len || (psWord->ui32Count < 2))
+        {
+            continue;
+        }
+        psWord->i32Saving = (((int32_t)psWord->ui32Count *
+                              ((int32_t)psWord->ui32Len -
+                               (int32_t)ui32RefSize)) - psWord->i32Runs -
+                             (int32_t)(psWord->ui32Len + 2));
+        if(psWord->i32Saving > 0)
+        {
+            g_psCandidates[ui32Num++] = *psWord;
+        }
+    }
+    qsort(g_psCandidates, ui32Num, sizeof(tWord), CandidateCompare);
+
+    //
+    // Pick the best candidates which do not overlap each other (since the
+    // saving of one would be reduced by replacing the other).
+    //
+    ui32Picked = 0;
+    for(ui32Idx = 0; (ui32Idx < ui32Num) && (ui32Picked < WORDS_PER_PASS) &&
+                     ((g_ui32NumWords + ui32Picked) < g_ui32MaxWords);
+        ui32Idx++)
+    {
+        bOverlap = false;
+        for(ui32Pick = 0; ui32Pick < ui32Picked; ui32Pick++)
+        {
+            if(Overlaps(&g_psCandidates[ui32Idx], &psPicked[ui32Pick]))
+            {
+                bOverlap = true;
+                break;
+            }
+        }
+        if(!bOverlap)
+        {
+            psPicked[ui32Picked++] = g_psCandidates[ui32Idx];
+        }
+    }
+
+    //
+    // Add the picked words to the dictionary, copying their text since the
+    // text of the strings is reused on the next pass.
+    //
+    for(ui32Pick = 0; ui32Pick < ui32Picked; ui32Pick++)
+    {
+        psWord = &g_psWords[g_ui32NumWords];
+        *psWord = psPicked[ui32Pick];
+        psWord->pui8Text = Alloc(psWord->ui32Len);
+        memcpy((uint8_t *)psWord->pui8Text, psPicked[ui32Pick].pui8Text,
+               psWord->ui32Len);
+        psWord->ui32Count = 0;
+        g_ui32NumWords++;
+    }
+    for(ui32Pick = 0; ui32Pick < ui32Picked; ui32Pick++)
+    {
+        WordReplace(g_ui32NumWords - ui32Picked + ui32Pick);
+    }
+
+    return(ui32Picked);
+}
+
+//*****************************************************************************
+//
+// Sorts the dictionary words by decreasing use.
+//
+//*****************************************************************************
+static int
+WordCompare(const void *pvA, const void *pvB)
+{
+    const tWord *psA = pvA, *psB = pvB;
+
+    if(psA->ui32Count != psB->ui32Count)
+    {
+        return((psA->ui32Count > psB->ui32Count) ? -1 : 1);
+    }
+    return((int)psA->ui32Code - (int)psB->ui32Code);
+}
+
+//*****************************************************************************
+//
+// Builds the dictionary and encodes the strings.
+//
+//*****************************************************************************
+static void
+Compress(void)
+{
+    tString *psString;
+    uint32_t ui32Idx, ui32Tok, ui32Total, *pui32Map;
+    tWord *psSorted;
+
+    //
+    // Start with every string as a sequence of literals, and size the hash
+    // table for the largest possible number of candidates.
+    //
+    ui32Total = 0;
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        psString->pui32Tokens = Alloc(sizeof(uint32_t) *
+                                      psString->ui32Len);
+        for(ui32Tok = 0; ui32Tok < psString->ui32Len; ui32Tok++)
+        {
+            psString->pui32Tokens[ui32Tok] = psString->pui8Text[ui32Tok];
+        }
+        psString->ui32NumTokens = psString->ui32Len;
+        ui32Total += psString->ui32Len;
+    }
+    for(g_ui32HashSize = 1024; g_ui32HashSize < (ui32Total * MAX_WORD_LEN * 2);
+        g_ui32HashSize *= 2)
+    {
+    }
+    g_psCandidates = Alloc(sizeof(tWord) * g_ui32HashSize);
+
+    //
+    // Add words to the dictionary until no more space can be saved.
+    //
+    while((g_ui32NumWords < g_ui32MaxWords) && DictionaryPass())
+    {
+    }
+
+    //
+    // Count the uses of each word, and sort the words by use so that the most
+    // used have the shortest references.
+    //
+    for(ui32Idx = 0; ui32Idx < g_ui32NumWords; ui32Idx++)
+    {
+        g_psWords[ui32Idx].ui32Count = 0;
+        g_psWords[ui32Idx].ui32Code = ui32Idx;
+    }
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        for(ui32Tok = 0; ui32Tok < psString->ui32NumTokens; ui32Tok++)
+        {
+            if(psString->pui32Tokens[ui32Tok] >= TOKEN_WORD)
+            {
+                g_psWords[psString->pui32Tokens[ui32Tok] -
+                          TOKEN_WORD].ui32Count++;
+            }
+        }
+    }
+    psSorted = g_psWords;
+    qsort(psSorted, g_ui32NumWords, sizeof(tWord), WordCompare);
+    pui32Map = Alloc(sizeof(uint32_t) * (g_ui32NumWords + 1));
+    for(ui32Idx = 0; ui32Idx < g_ui32NumWords; ui32Idx++)
+    {
+        pui32Map[psSorted[ui32Idx].ui32Code] = ui32Idx;
+    }
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        for(ui32Tok = 0; ui32Tok < psString->ui32NumTokens; ui32Tok++)
+        {
+            if(psString->pui32Tokens[ui32Tok] >= TOKEN_WORD)
+            {
+                psString->pui32Tokens[ui32Tok] =
+                    TOKEN_WORD + pui32Map[psString->pui32Tokens[ui32Tok] -
+                                          TOKEN_WORD];
+            }
+        }
+    }
+    free(pui32Map);
+
+    //
+    // Restore the original text of the strings, which was overwritten while
+    // counting candidates.
+    //
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        psString->ui32Len = 0;
+        for(ui32Tok = 0; ui32Tok < psString->ui32NumTokens; ui32Tok++)
+        {
+            if(psString->pui32Tokens[ui32Tok] < TOKEN_WORD)
+            {
+                psString->pui8Text[psString->ui32Len++] =
+                    psString->pui32Tokens[ui32Tok];
+            }
+            else
+            {
+                const tWord *psWord;
+
+                psWord = &g_psWords[psString->pui32Tokens[ui32Tok] -
+                                    TOKEN_WORD];
+                memcpy(psString->pui8Text + psString->ui32Len,
+                       psWord->pui8Text, psWord->ui32Len);
+                psString->ui32Len += psWord->ui32Len;
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Writes a byte of an array initializer, ten bytes to a line.  Printable
+// ASCII characters are written as character constants if bChar is true.
+//
+//*****************************************************************************
+static uint32_t g_ui32Column;
+
+static void
+ByteWrite(FILE *psFile, uint8_t ui8Byte, bool bChar)
+{
+    fprintf(psFile, "%s", g_ui32Column ? " " : "    ");
+    if(bChar && (ui8Byte >= ' ') && (ui8Byte < 0x7f) && (ui8Byte != '\'') &&
+       (ui8Byte != '\\'))
+    {
+        fprintf(psFile, " '%c',", ui8Byte);
+    }
+    else
+    {
+        fprintf(psFile, "0x%02x,", ui8Byte);
+    }
+
+    if(++g_ui32Column == 10)
+    {
+        fprintf(psFile, "\n");
+        g_ui32Column = 0;
+    }
+}
+
+//*****************************************************************************
+//
+// Ends the current line of an array initializer.
+//
+//*****************************************************************************
+static void
+LineEnd(FILE *psFile)
+{
+    if(g_ui32Column)
+    {
+        fprintf(psFile, "\n");
+        g_ui32Column = 0;
+    }
+}
+
+//*****************************************************************************
+//
+// Writes the C source file for the string table.
+//
+//*****************************************************************************
+static bool
+SourceWrite(const char *pcDir, const char *pcName, uint32_t *pui32Size)
+{
+    FILE *psFile;
+    tString *psString;
+    char pcFilename[1024];
+    uint32_t ui32Lang, ui32Idx, ui32Tok, ui32Offset, ui32Token;
+    uint32_t ui32Chars, ui32Run;
+
+    snprintf(pcFilename, sizeof(pcFilename), "%s/%s.c", pcDir, pcName);
+    psFile = fopen(pcFilename, "w");
+    if(!psFile)
+    {
+        fprintf(stderr, "Unable to create %s\n", pcFilename);
+        return(false);
+    }
+
+    fprintf(psFile,
+            "//*****************************************************"
+            "************************\n"
+            "//\n"
+            "// %s.c - Source file for an extended string table.\n"
+            "//\n"
+            "// This is an auto-generated file.  Do not edit by hand.\n"
+            "//\n"
+            "//*****************************************************"
+            "************************\n\n"
+            "#include <stdint.h>\n"
+            "#include <stdbool.h>\n"
+            "#include \"grlib/grlib.h\"\n\n", pcName);
+
+    //
+    // Write the language identifiers.
+    //
+    fprintf(psFile, "//\n// The language identifiers.\n//\n"
+            "static const uint16_t g_pui16Languages%s[] =\n{\n", pcName);
+    for(ui32Lang = 0; ui32Lang < g_ui32NumLanguages; ui32Lang++)
+    {
+        fprintf(psFile, "    %s,\n", g_ppcLanguages[ui32Lang]);
+    }
+    fprintf(psFile, "};\n\n");
+    *pui32Size = g_ui32NumLanguages * 2;
+
+    //
+    // Write the offset of each string.
+    //
+    fprintf(psFile, "//\n// The offset of each string within the string "
+            "data.\n//\n"
+            "static const uint32_t g_pui32StringOffsets%s[] =\n{\n", pcName);
+    ui32Offset = 0;
+    for(ui32Lang = 0; ui32Lang < g_ui32NumLanguages; ui32Lang++)
+    {
+        fprintf(psFile, "    //\n    // Language %s\n    //\n",
+                g_ppcLanguages[ui32Lang]);
+        for(ui32Idx = 0; ui32Idx < g_ui32NumStrings; ui32Idx++)
+        {
+            psString = &g_psStrings[(ui32Lang * g_ui32NumStrings) + ui32Idx];
+            fprintf(psFile, "    0x%08x, // %s\n", ui32Offset,
+                    g_ppcNames[ui32Idx]);
+            ui32Offset += EncodedSize(psString);
+        }
+        fprintf(psFile, "\n");
+    }
+    fprintf(psFile, "    0x%08x\n};\n\n", ui32Offset);
+    *pui32Size += ((g_ui32NumLanguages * g_ui32NumStrings) + 1) * 4;
+    *pui32Size += ui32Offset;
+
+    //
+    // Write the encoded strings.
+    //
+    fprintf(psFile, "//\n// The encoded strings.\n//\n"
+            "static const uint8_t g_pui8Strings%s[] =\n{\n", pcName);
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumLanguages * g_ui32NumStrings);
+        ui32Idx++)
+    {
+        psString = &g_psStrings[ui32Idx];
+        for(ui32Tok = 0; ui32Tok < psString->ui32NumTokens; ui32Tok++)
+        {
+            ui32Token = psString->pui32Tokens[ui32Tok];
+            if(ui32Token < TOKEN_WORD)
+            {
+                //
+                // Write the code for a run of literals, up to the longest
+                // run that a code can hold, followed by the literals.
+                //
+                for(ui32Run = 1;
+                    (ui32Run < STRING_MAX_RUN) &&
+                    ((ui32Tok + ui32Run) < psString->ui32NumTokens) &&
+                    (psString->pui32Tokens[ui32Tok + ui32Run] < TOKEN_WORD);
+                    ui32Run++)
+                {
+                }
+                ByteWrite(psFile, ui32Run - 1, false);
+                for(; ui32Run; ui32Run--)
+                {
+                    ByteWrite(psFile, psString->pui32Tokens[ui32Tok++], true);
+                }
+                ui32Tok--;
+            }
+            else if((ui32Token - TOKEN_WORD) < STRING_NUM_SHORT_WORDS)
+            {
+                ByteWrite(psFile, STRING_CODE_WORD + ui32Token - TOKEN_WORD,
+                          false);
+            }
+            else
+            {
+                ui32Token -= TOKEN_WORD + STRING_NUM_SHORT_WORDS;
+                ByteWrite(psFile, STRING_CODE_LONG_WORD + (ui32Token >> 8),
+                          false);
+                ByteWrite(psFile, ui32Token & 0xff, false);
+            }
+        }
+    }
+    ByteWrite(psFile, 0, false);
+    LineEnd(psFile);
+    fprintf(psFile, "};\n\n");
+
+    //
+    // Write the dictionary, one word per line.
+    //
+    fprintf(psFile, "//\n// The offset of each dictionary word.\n//\n"
+            "static const uint16_t g_pui16WordOffsets%s[] =\n{\n", pcName);
+    ui32Chars = 0;
+    for(ui32Idx = 0; ui32Idx <= g_ui32NumWords; ui32Idx++)
+    {
+        fprintf(psFile, "    0x%04x,\n", ui32Chars);
+        if(ui32Idx < g_ui32NumWords)
+        {
+            ui32Chars += g_psWords[ui32Idx].ui32Len;
+        }
+    }
+    fprintf(psFile, "};\n\n");
+    *pui32Size += ((g_ui32NumWords + 1) * 2) + ui32Chars;
+
+    fprintf(psFile, "//\n// The dictionary words.\n//\n"
+            "static const uint8_t g_pui8Words%s[] =\n{\n", pcName);
+    for(ui32Idx = 0; ui32Idx < g_ui32NumWords; ui32Idx++)
+    {
+        for(ui32Tok = 0; ui32Tok < g_psWords[ui32Idx].ui32Len; ui32Tok++)
+        {
+            ByteWrite(psFile, g_psWords[ui32Idx].pui8Text[ui32Tok], true);
+        }
+        LineEnd(psFile);
+    }
+    fprintf(psFile, "    0x00\n};\n\n");
+
+    //
+    // Write the table structure.
+    //
+    fprintf(psFile, "//\n// The string table.\n//\n"
+            "const tStringTableEx g_sTable%s =\n{\n"
+            "    %u,\n    %u,\n    %u,\n"
+            "    g_pui16Languages%s,\n"
+            "    g_pui32StringOffsets%s,\n"
+            "    g_pui8Strings%s,\n"
+            "    g_pui16WordOffsets%s,\n"
+            "    g_pui8Words%s\n};\n", pcName, g_ui32NumStrings,
+            g_ui32NumLanguages, g_ui32NumWords, pcName, pcName, pcName,
+            pcName, pcName);
+
+    fclose(psFile);
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Writes the header file for the string table.  This defines the same names
+// as the header written by the string compression utility, so that an
+// application can switch between the two formats.
+//
+//*****************************************************************************
+static bool
+HeaderWrite(const char *pcDir, const char *pcName)
+{
+    FILE *psFile;
+    char pcFilename[1024];
+    uint32_t ui32Idx, ui32MaxLen;
+
+    snprintf(pcFilename, sizeof(pcFilename), "%s/%s.h", pcDir, pcName);
+    psFile = fopen(pcFilename, "w");
+    if(!psFile)
+    {
+        fprintf(stderr, "Unable to create %s\n", pcFilename);
+        return(false);
+    }
+
+    ui32MaxLen = 0;
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        if(g_psStrings[ui32Idx].ui32Len > ui32MaxLen)
+        {
+            ui32MaxLen = g_psStrings[ui32Idx].ui32Len;
+        }
+    }
+
+    fprintf(psFile,
+            "//*****************************************************"
+            "************************\n"
+            "//\n"
+            "// %s.h - Header file for an extended string table.\n"
+            "//\n"
+            "// This is an auto-generated file.  Do not edit by hand.\n"
+            "//\n"
+            "//*****************************************************"
+            "************************\n\n"
+            "#define SCOMP_MAX_STRLEN         %u   // The maximum size of "
+            "any string.\n\n"
+            "extern const tStringTableEx g_sTable%s;\n\n"
+            "//*****************************************************"
+            "************************\n"
+            "//\n"
+            "// SCOMP_STR_INDEX is an enumeration list that is used to select "
+            "a string\n"
+            "// from the string table using the GrStringGet() function.\n"
+            "//\n"
+            "//*****************************************************"
+            "************************\n"
+            "enum SCOMP_STR_INDEX\n{\n", pcName, ui32MaxLen + 1, pcName);
+    for(ui32Idx = 0; ui32Idx < g_ui32NumStrings; ui32Idx++)
+    {
+        fprintf(psFile, "    %s,\n", g_ppcNames[ui32Idx]);
+    }
+    fprintf(psFile, "};\n");
+
+    fclose(psFile);
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Prints the usage information for this program.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    fprintf(stderr, "Usage: %s [options] <file.csv>\n", pcProgram);
+    fprintf(stderr, "Generates an extended string table from a CSV file.\n\n");
+    fprintf(stderr, "  -d <dir>    Write the output files to this directory "
+            "(default .).\n");
+    fprintf(stderr, "  -h          Print this help.\n");
+    fprintf(stderr, "  -n <name>   Name the table g_sTable<name> and the "
+            "files <name>.c and\n"
+            "              <name>.h (default is the name of the CSV "
+            "file).\n");
+    fprintf(stderr, "  -w <words>  Limit the dictionary to this many words "
+            "(default %u).\n", STRING_MAX_WORDS);
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    const char *pcDir, *pcBase;
+    char *pcName, *pcDot;
+    uint32_t ui32Idx, ui32Raw, ui32Size;
+    int iOpt;
+
+    pcDir = ".";
+    pcName = 0;
+    while((iOpt = getopt(argc, argv, "d:hn:w:")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'd':
+            {
+                pcDir = optarg;
+                break;
+            }
+
+            case 'n':
+            {
+                pcName = optarg;
+                break;
+            }
+
+            case 'w':
+            {
+                g_ui32MaxWords = strtoul(optarg, 0, 0);
+                if(g_ui32MaxWords > STRING_MAX_WORDS)
+                {
+                    g_ui32MaxWords = STRING_MAX_WORDS;
+                }
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+
+    if(optind != (argc - 1))
+    {
+        Usage(argv[0]);
+        return(1);
+    }
+
+    //
+    // Name the table after the input file if no name was given.
+    //
+    if(!pcName)
+    {
+        pcBase = strrchr(argv[optind], '/');
+        pcName = strdup(pcBase ? pcBase + 1 : argv[optind]);
+        pcDot = strrchr(pcName, '.');
+        if(pcDot)
+        {
+            *pcDot = 0;
+        }
+    }
+
+    if(!CSVRead(argv[optind]))
+    {
+        return(1);
+    }
+
+    ui32Raw = 0;
+    for(ui32Idx = 0; ui32Idx < (g_ui32NumStrings * g_ui32NumLanguages);
+        ui32Idx++)
+    {
+        ui32Raw += g_psStrings[ui32Idx].ui32Len + 1;
+    }
+
+    Compress();
+
+    if(!SourceWrite(pcDir, pcName, &ui32Size) || !HeaderWrite(pcDir, pcName))
+    {
+        return(1);
+    }
+
+    printf("%u strings in %u languages, %u bytes of text\n",
+           g_ui32NumStrings, g_ui32NumLanguages, ui32Raw);
+    printf("%u dictionary words, %u bytes in total\n", g_ui32NumWords,
+           ui32Size);
+
+    return(0);
+}
@@ -0,0 +1,755 @@
+//*****************************************************************************
+//
+// ringbench.c - Host-side ring buffer stress test and throughput benchmark.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "utils/ringbuf.h"
+
+//*****************************************************************************
+//
+// This program exercises the ring buffers of the utility library on the host
+// machine.  It has two purposes:
+//
+// - To stress the single-producer, single-consumer ring buffer with a
+//   producer and a consumer running concurrently in separate threads, using
+//   every combination of the copying, single byte, and zero-copy calls, and
+//   to check that every byte arrives intact and in order.
+//
+// - To measure the throughput of the single-producer, single-consumer ring
+//   buffer against the interrupt-masking ring buffer for the same workloads,
+//   so that the effect of changes can be quantified without target hardware.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The default number of seconds for which each benchmark is run.
+//
+//*****************************************************************************
+#define DEFAULT_DURATION        0.25
+
+//*****************************************************************************
+//
+// The default number of bytes passed through the ring buffer by each stress
+// test.
+//
+//*****************************************************************************
+#define DEFAULT_STRESS_BYTES    (1024 * 1024)
+
+//*****************************************************************************
+//
+// The size of the ring buffers used by the benchmarks, and the largest ring
+// buffer used by the stress tests.
+//
+//*****************************************************************************
+#define RING_SIZE               4096
+
+//*****************************************************************************
+//
+// The size of the blocks copied into and out of the ring buffer by the
+// block benchmarks.
+//
+//*****************************************************************************
+#define BLOCK_SIZE              256
+
+//*****************************************************************************
+//
+// The ways in which the producer and consumer of a stress test move data.
+//
+//*****************************************************************************
+#define MODE_COPY               0
+#define MODE_ONE                1
+#define MODE_ZERO_COPY          2
+#define MODE_MIXED              3
+
+//*****************************************************************************
+//
+// The interrupt-masking ring buffer disables interrupts around each index
+// update; on the host there are no interrupts to disable, and it is only ever
+// used from a single thread.
+//
+//*****************************************************************************
+bool
+IntMasterEnable(void)
+{
+    return(false);
+}
+
+bool
+IntMasterDisable(void)
+{
+    return(false);
+}
+
+//*****************************************************************************
+//
+// The state shared by the producer and consumer threads of a stress test.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The ring buffer under test.
+    //
+    tRingBufSPSC *psRingBuf;
+
+    //
+    // The number of bytes to pass through the ring buffer.
+    //
+    uint32_t ui32Bytes;
+
+    //
+    // The way in which the producer writes and the consumer reads.
+    //
+    uint32_t ui32ProducerMode;
+    uint32_t ui32ConsumerMode;
+
+    //
+    // The seed for the chunk sizes chosen by each thread.
+    //
+    uint32_t ui32Seed;
+
+    //
+    // The number of bytes received out of sequence by the consumer.
+    //
+    uint32_t ui32Errors;
+}
+tStress;
+
+//*****************************************************************************
+//
+// Returns the byte at a given position in the sequence passed through the
+// ring buffer by the stress tests.  The sequence does not repeat with any
+// power of two period, so a byte delivered to the wrong place is detected.
+//
+//*****************************************************************************
+static uint8_t
+SequenceByte(uint32_t ui32Pos)
+{
+    return((uint8_t)((ui32Pos * 0x9e3779b1) >> 24) ^ (uint8_t)(ui32Pos / 251));
+}
+
+//*****************************************************************************
+//
+// Returns a pseudo-random number less than the given range, updating the
+// given seed.
+//
+//*****************************************************************************
+static uint32_t
+Random(uint32_t *pui32Seed, uint32_t ui32Range)
+{
+    *pui32Seed = (*pui32Seed * 1664525) + 1013904223;
+    return((*pui32Seed >> 8) % ui32Range);
+}
+
+//*****************************************************************************
+//
+// Returns the current time in seconds.
+//
+//*****************************************************************************
+static double
+TimeGet(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return((double)sTime.tv_sec + ((double)sTime.tv_nsec / 1e9));
+}
+
+//*****************************************************************************
+//
+// The producer thread of a stress test, which writes the sequence in chunks
+// of random size.
+//
+//*****************************************************************************
+static void *
+StressProducer(void *pvArg)
+{
+    tStress *psStress = pvArg;
+    uint8_t pui8Chunk[RING_SIZE * 2], *pui8Data;
+    uint32_t ui32Pos, ui32Seed, ui32Mode, ui32Count, ui32Idx;
+
+    ui32Seed = psStress->ui32Seed;
+    ui32Pos = 0;
+    while(ui32Pos < psStress->ui32Bytes)
+    {
+        //
+        // Give up the processor while the ring buffer is full, in case the
+        // consumer is not running on another one.
+        //
+        if(RingBufSPSCFree(psStress->psRingBuf) == 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        //
+        // Choose how to write the next chunk.
+        //
+        ui32Mode = psStress->ui32ProducerMode;
+        if(ui32Mode == MODE_MIXED)
+        {
+            ui32Mode = Random(&ui32Seed, MODE_MIXED);
+        }
+
+        switch(ui32Mode)
+        {
+            //
+            // Copy a chunk which may be larger than the ring buffer, and
+            // continue from wherever the copy stopped.
+            //
+            case MODE_COPY:
+            {
+                ui32Count = Random(&ui32Seed, sizeof(pui8Chunk)) + 1;
+                if(ui32Count > (psStress->ui32Bytes - ui32Pos))
+                {
+                    ui32Count = psStress->ui32Bytes - ui32Pos;
+                }
+                for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+                {
+                    pui8Chunk[ui32Idx] = SequenceByte(ui32Pos + ui32Idx);
+                }
+                ui32Pos += RingBufSPSCWrite(psStress->psRingBuf, pui8Chunk,
+                                            ui32Count);
+                break;
+            }
+
+            //
+            // Write a single byte.
+            //
+            case MODE_ONE:
+            {
+                if(RingBufSPSCWriteOne(psStress->psRingBuf,
+                                       SequenceByte(ui32Pos)))
+                {
+                    ui32Pos++;
+                }
+                break;
+            }
+
+            //
+            // Fill part of the reserved space in place.
+            //
+            default:
+            {
+                ui32Count = RingBufSPSCWriteReserve(psStress->psRingBuf,
+                                                    &pui8Data);
+                if(ui32Count == 0)
+                {
+                    break;
+                }
+                ui32Count = Random(&ui32Seed, ui32Count) + 1;
+                if(ui32Count > (psStress->ui32Bytes - ui32Pos))
+                {
+                    ui32Count = psStress->ui32Bytes - ui32Pos;
+                }
+                for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+                {
+                    pui8Data[ui32Idx] = SequenceByte(ui32Pos + ui32Idx);
+                }
+                RingBufSPSCWriteCommit(psStress->psRingBuf, ui32Count);
+                ui32Pos += ui32Count;
+                break;
+            }
+        }
+    }
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+// The consumer thread of a stress test, which reads the sequence in chunks of
+// random size and counts the bytes which do not match.
+//
+//*****************************************************************************
+static void *
+StressConsumer(void *pvArg)
+{
+    tStress *psStress = pvArg;
+    uint8_t pui8Chunk[RING_SIZE * 2], *pui8Data;
+    uint32_t ui32Pos, ui32Seed, ui32Mode, ui32Count, ui32Idx, ui32Errors;
+
+    ui32Seed = psStress->ui32Seed ^ 0x5a5a5a5a;
+    ui32Errors = 0;
+    ui32Pos = 0;
+    while(ui32Pos < psStress->ui32Bytes)
+    {
+        //
+        // Give up the processor while the ring buffer is empty, in case the
+        // producer is not running on another one.
+        //
+        if(RingBufSPSCUsed(psStress->psRingBuf) == 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        //
+        // Choose how to read the next chunk.
+        //
+        ui32Mode = psStress->ui32ConsumerMode;
+        if(ui32Mode == MODE_MIXED)
+        {
+            ui32Mode = Random(&ui32Seed, MODE_MIXED);
+        }
+
+        switch(ui32Mode)
+        {
+            //
+            // Copy out a chunk which may be larger than the ring buffer.
+            //
+            case MODE_COPY:
+            {
+                ui32Count = RingBufSPSCRead(psStress->psRingBuf, pui8Chunk,
+                                            Random(&ui32Seed,
+                                                   sizeof(pui8Chunk)) + 1);
+                pui8Data = pui8Chunk;
+                break;
+            }
+
+            //
+            // Read a single byte.
+            //
+            case MODE_ONE:
+            {
+                ui32Count = RingBufSPSCReadOne(psStress->psRingBuf,
+                                               pui8Chunk) ? 1 : 0;
+                pui8Data = pui8Chunk;
+                break;
+            }
+
+            //
+            // Check part of the data in place, then release it.
+            //
+            default:
+            {
+                ui32Count = RingBufSPSCReadPeek(psStress->psRingBuf,
+                                                &pui8Data);
+                if(ui32Count != 0)
+                {
+                    ui32Count = Random(&ui32Seed, ui32Count) + 1;
+                }
+                break;
+            }
+        }
+
+        //
+        // Check the bytes against the sequence.
+        //
+        if((ui32Pos + ui32Count) > psStress->ui32Bytes)
+        {
+            ui32Errors += ui32Pos + ui32Count - psStress->ui32Bytes;
+            ui32Count = psStress->ui32Bytes - ui32Pos;
+        }
+        for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+        {
+            if(pui8Data[ui32Idx] != SequenceByte(ui32Pos + ui32Idx))
+            {
+                ui32Errors++;
+            }
+        }
+        if(ui32Mode == MODE_ZERO_COPY)
+        {
+            RingBufSPSCReadRelease(psStress->psRingBuf, ui32Count);
+        }
+        ui32Pos += ui32Count;
+    }
+
+    //
+    // Nothing should be left behind once the whole sequence has been read.
+    //
+    ui32Errors += RingBufSPSCUsed(psStress->psRingBuf);
+    psStress->ui32Errors = ui32Errors;
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Runs a single stress test and returns the number of errors found.
+//
+//*****************************************************************************
+static uint32_t
+StressRun(uint32_t ui32Size, uint32_t ui32Start, uint32_t ui32ProducerMode,
+          uint32_t ui32ConsumerMode, uint32_t ui32Bytes)
+{
+    static const char *ppcModes[] =
+    {
+        "copy", "one", "zero-copy", "mixed"
+    };
+    static uint8_t pui8Buf[RING_SIZE];
+    tRingBufSPSC sRingBuf;
+    pthread_t sProducer, sConsumer;
+    tStress sStress;
+
+    //
+    // Start the counts at the given value, so that their wrap at 2^32 can be
+    // exercised.
+    //
+    RingBufSPSCInit(&sRingBuf, pui8Buf, ui32Size);
+    sRingBuf.ui32WriteCount = sRingBuf.ui32ReadCount = ui32Start;
+
+    sStress.psRingBuf = &sRingBuf;
+    sStress.ui32Bytes = ui32Bytes;
+    sStress.ui32ProducerMode = ui32ProducerMode;
+    sStress.ui32ConsumerMode = ui32ConsumerMode;
+    sStress.ui32Seed = ui32Size ^ ui32Start ^ (ui32ProducerMode << 4) ^
+                       (ui32ConsumerMode << 8);
+    sStress.ui32Errors = 0;
+
+    if(pthread_create(&sConsumer, 0, StressConsumer, &sStress) ||
+       pthread_create(&sProducer, 0, StressProducer, &sStress))
+    {
+        fprintf(stderr, "Unable to create the stress test threads\n");
+        exit(1);
+    }
+    pthread_join(sProducer, 0);
+    pthread_join(sConsumer, 0);
+
+    printf("%-6s %4u bytes, start %08x, %-9s to %-9s: %s\n",
+           (sStress.ui32Errors == 0) ? "ok" : "FAILED", ui32Size, ui32Start,
+           ppcModes[ui32ProducerMode], ppcModes[ui32ConsumerMode],
+           (sStress.ui32Errors == 0) ? "intact" : "corrupted");
+
+    return(sStress.ui32Errors ? 1 : 0);
+}
+
+//*****************************************************************************
+//
+// Runs the stress tests and returns the number which failed.  Every
+// combination of producer and consumer calls is run through a small ring
+// buffer, where the indices wrap constantly, and through a large one, with
+// the counts starting just short of their wrap at 2^32.
+//
+//*****************************************************************************
+static uint32_t
+StressCheck(uint32_t ui32Bytes)
+{
+    uint32_t ui32Producer, ui32Consumer, ui32Failed;
+
+    ui32Failed = 0;
+    for(ui32Producer = 0; ui32Producer <= MODE_MIXED; ui32Producer++)
+    {
+        for(ui32Consumer = 0; ui32Consumer <= MODE_MIXED; ui32Consumer++)
+        {
+            ui32Failed += StressRun(16, 0, ui32Producer, ui32Consumer,
+                                    ui32Bytes);
+            ui32Failed += StressRun(RING_SIZE, 0xfffff000, ui32Producer,
+                                    ui32Consumer, ui32Bytes);
+        }
+    }
+
+    return(ui32Failed);
+}
+
+//*****************************************************************************
+//
+// The ring buffers and data used by the benchmarks.
+//
+//*****************************************************************************
+static uint8_t g_pui8RingBuf[RING_SIZE];
+static uint8_t g_pui8Block[BLOCK_SIZE];
+static tRingBufObject g_sRingBuf;
+static tRingBufSPSC g_sRingBufSPSC;
+
+//*****************************************************************************
+//
+// The benchmark workloads.  Each one passes a number of bytes through a ring
+// buffer from a single thread and returns the number of bytes passed, so
+// that the per-byte cost of each interface can be compared.
+//
+//*****************************************************************************
+static uint32_t
+WorkBlock(uint32_t ui32Iter)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Iter; ui32Idx++)
+    {
+        RingBufWrite(&g_sRingBuf, g_pui8Block, BLOCK_SIZE);
+        RingBufRead(&g_sRingBuf, g_pui8Block, BLOCK_SIZE);
+    }
+    return(ui32Iter * BLOCK_SIZE);
+}
+
+static uint32_t
+WorkBlockSPSC(uint32_t ui32Iter)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Iter; ui32Idx++)
+    {
+        RingBufSPSCWrite(&g_sRingBufSPSC, g_pui8Block, BLOCK_SIZE);
+        RingBufSPSCRead(&g_sRingBufSPSC, g_pui8Block, BLOCK_SIZE);
+    }
+    return(ui32Iter * BLOCK_SIZE);
+}
+
+static uint32_t
+WorkBlockZeroCopy(uint32_t ui32Iter)
+{
+    uint32_t ui32Idx, ui32Count, ui32Done;
+    uint8_t *pui8Data;
+
+    for(ui32Idx = 0; ui32Idx < ui32Iter; ui32Idx++)
+    {
+        for(ui32Done = 0; ui32Done < BLOCK_SIZE; ui32Done += ui32Count)
+        {
+            ui32Count = RingBufSPSCWriteReserve(&g_sRingBufSPSC, &pui8Data);
+            if(ui32Count > (BLOCK_SIZE - ui32Done))
+            {
+                ui32Count = BLOCK_SIZE - ui32Done;
+            }
+            memcpy(pui8Data, g_pui8Block + ui32Done, ui32Count);
+            RingBufSPSCWriteCommit(&g_sRingBufSPSC, ui32Count);
+        }
+        for(ui32Done = 0; ui32Done < BLOCK_SIZE; ui32Done += ui32Count)
+        {
+            ui32Count = RingBufSPSCReadPeek(&g_sRingBufSPSC, &pui8Data);
+            if(ui32Count > (BLOCK_SIZE - ui32Done))
+            {
+                ui32Count = BLOCK_SIZE - ui32Done;
+            }
+            memcpy(g_pui8Block + ui32Done, pui8Data, ui32Count);
+            RingBufSPSCReadRelease(&g_sRingBufSPSC, ui32Count);
+        }
+    }
+    return(ui32Iter * BLOCK_SIZE);
+}
+
+static uint32_t
+WorkOne(uint32_t ui32Iter)
+{
+    uint32_t ui32Idx;
+    uint8_t ui8Data;
+
+    for(ui32Idx = 0; ui32Idx < ui32Iter; ui32Idx++)
+    {
+        RingBufWriteOne(&g_sRingBuf, (uint8_t)ui32Idx);
+        ui8Data = RingBufReadOne(&g_sRingBuf);
+        g_pui8Block[0] += ui8Data;
+    }
+    return(ui32Iter);
+}
+
+static uint32_t
+WorkOneSPSC(uint32_t ui32Iter)
+{
+    uint32_t ui32Idx;
+    uint8_t ui8Data;
+
+    for(ui32Idx = 0; ui32Idx < ui32Iter; ui32Idx++)
+    {
+        RingBufSPSCWriteOne(&g_sRingBufSPSC, (uint8_t)ui32Idx);
+        RingBufSPSCReadOne(&g_sRingBufSPSC, &ui8Data);
+        g_pui8Block[0] += ui8Data;
+    }
+    return(ui32Iter);
+}
+
+//*****************************************************************************
+//
+// The table of benchmarks.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *pcName;
+    uint32_t (*pfnWork)(uint32_t ui32Iter);
+}
+tBenchmark;
+
+static const tBenchmark g_psBenchmarks[] =
+{
+    { "RingBufWrite/Read (256 byte blocks)", WorkBlock },
+    { "RingBufSPSCWrite/Read (256 byte blocks)", WorkBlockSPSC },
+    { "RingBufSPSC reserve/peek (256 byte blocks)", WorkBlockZeroCopy },
+    { "RingBufWriteOne/ReadOne", WorkOne },
+    { "RingBufSPSCWriteOne/ReadOne", WorkOneSPSC },
+};
+
+#define NUM_BENCHMARKS          (sizeof(g_psBenchmarks) /                     \
+                                 sizeof(g_psBenchmarks[0]))
+
+//*****************************************************************************
+//
+// Runs each benchmark for the given number of seconds and prints the results,
+// followed by the throughput of the single-producer, single-consumer ring
+// buffer with the producer and consumer in separate threads.
+//
+//*****************************************************************************
+static void
+BenchmarksRun(double dDuration)
+{
+    uint32_t ui32Idx, ui32Iter;
+    double dStart, dTime, dBytes;
+    pthread_t sProducer, sConsumer;
+    tStress sStress;
+
+    printf("%-44s %12s\n", "Benchmark", "MB/s");
+    for(ui32Idx = 0; ui32Idx < NUM_BENCHMARKS; ui32Idx++)
+    {
+        RingBufInit(&g_sRingBuf, g_pui8RingBuf, RING_SIZE);
+        RingBufSPSCInit(&g_sRingBufSPSC, g_pui8RingBuf, RING_SIZE);
+
+        //
+        // Double the number of iterations until the run is long enough.
+        //
+        for(ui32Iter = 64; ; ui32Iter *= 2)
+        {
+            dStart = TimeGet();
+            dBytes = g_psBenchmarks[ui32Idx].pfnWork(ui32Iter);
+            dTime = TimeGet() - dStart;
+            if(dTime >= dDuration)
+            {
+                break;
+            }
+        }
+
+        printf("%-44s %12.1f\n", g_psBenchmarks[ui32Idx].pcName,
+               dBytes / dTime / 1e6);
+    }
+
+    //
+    // Pass data between two threads through the zero-copy calls.
+    //
+    RingBufSPSCInit(&g_sRingBufSPSC, g_pui8RingBuf, RING_SIZE);
+    sStress.psRingBuf = &g_sRingBufSPSC;
+    sStress.ui32Bytes = (uint32_t)(dDuration * 256e6);
+    sStress.ui32ProducerMode = MODE_ZERO_COPY;
+    sStress.ui32ConsumerMode = MODE_ZERO_COPY;
+    sStress.ui32Seed = 1;
+    sStress.ui32Errors = 0;
+    dStart = TimeGet();
+    if(pthread_create(&sConsumer, 0, StressConsumer, &sStress) ||
+       pthread_create(&sProducer, 0, StressProducer, &sStress))
+    {
+        fprintf(stderr, "Unable to create the benchmark threads\n");
+        exit(1);
+    }
+    pthread_join(sProducer, 0);
+    pthread_join(sConsumer, 0);
+    dTime = TimeGet() - dStart;
+    printf("%-44s %12.1f\n", "RingBufSPSC reserve/peek (two threads)",
+           sStress.ui32Bytes / dTime / 1e6);
+}
+
+//*****************************************************************************
+//
+// Prints the usage message.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    printf("Usage: %s [OPTION]...\n", pcProgram);
+    printf("Stress tests and benchmarks the utility library ring "
+           "buffers.\n\n");
+    printf("  -c       Only run the stress tests\n");
+    printf("  -n BYTES Pass BYTES bytes through each stress test "
+           "(default %u)\n", DEFAULT_STRESS_BYTES);
+    printf("  -s       Only run the benchmarks\n");
+    printf("  -t SEC   Run each benchmark for SEC seconds (default %.2f)\n",
+           DEFAULT_DURATION);
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    bool bBench, bStress;
+    uint32_t ui32Bytes, ui32Failed;
+    double dDuration;
+    int iOpt;
+
+    bBench = true;
+    bStress = true;
+    ui32Bytes = DEFAULT_STRESS_BYTES;
+    dDuration = DEFAULT_DURATION;
+
+    while((iOpt = getopt(argc, argv, "chn:st:")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'c':
+            {
+                bBench = false;
+                break;
+            }
+
+            case 'n':
+            {
+                ui32Bytes = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            case 's':
+            {
+                bStress = false;
+                break;
+            }
+
+            case 't':
+            {
+                dDuration = strtod(optarg, 0);
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+
+    ui32Failed = 0;
+    if(bStress)
+    {
+        ui32Failed = StressCheck(ui32Bytes);
+        if(bBench)
+        {
+            printf("\n");
+        }
+    }
+
+    if(bBench)
+    {
+        BenchmarksRun(dDuration);
+    }
+
+    return(ui32Failed ? 1 : 0);
+}
@@ -0,0 +1,1487 @@
+//*****************************************************************************
+//
+// schedtest.c - Host-side test of the deadline-ordered scheduler tasks.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+//
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+//
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "inc/hw_types.h"
+#include "inc/hw_nvic.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+#include "utils/scheduler.h"
+
+//*****************************************************************************
+//
+// This program links utils/scheduler.c with a simulation of the SysTick timer
+// and of the processor's interrupt masking and sleep, in place of the driver
+// library functions which it calls.  SchedulerIdle() also writes the SysTick
+// and interrupt control registers directly, so the page of the address space
+// holding them is mapped, and the simulation reads the values written there.
+//
+// The simulation counts system clocks, and no time passes while the code
+// under test runs unless a task asks for it.  As on the processor, a pending
+// interrupt is taken one clock after it is raised, so the SysTick interrupt
+// finds the timer already reloaded.  A timer which is enabled with its counter
+// cleared is reloaded on the next clock, before the code which follows can
+// change the reload value, so that value is latched when it is enabled.
+//
+// Each time the SysTick interrupt is taken the tick count is checked against
+// the number of tick periods which have passed, so any tick lost or gained by
+// stretching the SysTick period in SchedulerIdle() is caught when it happens.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The default number of ticks for which the randomized tests run.
+//
+//*****************************************************************************
+#define DEFAULT_TICKS           100000
+
+//*****************************************************************************
+//
+// The simulated system clock and tick rate, and the number of system clocks
+// in each tick.
+//
+//*****************************************************************************
+#define SYSTEM_CLOCK            1000000
+#define TICKS_PER_SECOND        1000
+#define TICK_PERIOD             (SYSTEM_CLOCK / TICKS_PER_SECOND)
+
+//*****************************************************************************
+//
+// The page holding the SysTick and interrupt control registers, and the value
+// kept in the SysTick current value register so that a write to it (which
+// clears the counter) can be seen.
+//
+//*****************************************************************************
+#define NVIC_PAGE               0xE000E000
+#define NVIC_PAGE_SIZE          0x1000
+#define ST_CURRENT_UNWRITTEN    0xA5A5A5A5
+
+//*****************************************************************************
+//
+// The size of the deadline queue, and the number of tasks used by the
+// randomized test, which is more than the queue holds.
+//
+//*****************************************************************************
+#define QUEUE_SIZE              16
+#define NUM_TASKS               24
+
+//*****************************************************************************
+//
+// The state of the simulation: the number of system clocks which have passed,
+// the SysTick counter and whether it is enabled, the reload value latched
+// when it was enabled (if any), whether interrupts are masked, and the clock
+// at which another interrupt is to wake the processor (or zero if none is
+// to).
+//
+//*****************************************************************************
+static uint64_t g_ui64Clock;
+static uint32_t g_ui32Counter;
+static bool g_bSysTickEnabled;
+static bool g_bReloadLatched;
+static uint32_t g_ui32Reload;
+static bool g_bMasked;
+static uint64_t g_ui64WakeClock;
+static bool g_bWakePending;
+
+//*****************************************************************************
+//
+// The number of SysTick and other interrupts taken, and the clock and tick
+// count from which the tick count is checked.
+//
+//*****************************************************************************
+static uint32_t g_ui32SysTickInts;
+static uint32_t g_ui32WakeInts;
+static uint64_t g_ui64ClockBase;
+static uint32_t g_ui32TickBase;
+
+//*****************************************************************************
+//
+// The number of failed checks.
+//
+//*****************************************************************************
+static uint32_t g_ui32Failed;
+
+//*****************************************************************************
+//
+// The task table used by SchedulerRun(), which is empty since only the
+// deadline-ordered tasks are tested, and the deadline queue.
+//
+//*****************************************************************************
+tSchedulerTask g_psSchedulerTable[1];
+uint32_t g_ui32SchedulerNumTasks = 0;
+static tSchedulerDeadlineTask *g_ppsQueue[QUEUE_SIZE];
+
+//*****************************************************************************
+//
+// Reports a failed check.
+//
+//*****************************************************************************
+static void
+Fail(const char *pcTest, const char *pcFormat, ...)
+{
+    va_list vaArgP;
+
+    printf("FAILED %s: ", pcTest);
+    va_start(vaArgP, pcFormat);
+    vprintf(pcFormat, vaArgP);
+    va_end(vaArgP);
+    printf("\n");
+    g_ui32Failed++;
+}
+
+//*****************************************************************************
+//
+// Called by the driver library when an ASSERT fails.
+//
+//*****************************************************************************
+void
+__error__(char *pcFilename, uint32_t ui32Line)
+{
+    printf("FAILED assertion at %s:%u\n", pcFilename, ui32Line);
+    exit(1);
+}
+
+//*****************************************************************************
+//
+// Clears the SysTick counter if the current value register has been written
+// since it was last checked.
+//
+//*****************************************************************************
+static void
+CurrentCheck(void)
+{
+    if(HWREG(NVIC_ST_CURRENT) != ST_CURRENT_UNWRITTEN)
+    {
+        g_ui32Counter = 0;
+        HWREG(NVIC_ST_CURRENT) = ST_CURRENT_UNWRITTEN;
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the value with which the SysTick counter is next reloaded.
+//
+//*****************************************************************************
+static uint32_t
+ReloadGet(void)
+{
+    return(g_bReloadLatched ? g_ui32Reload :
+           (HWREG(NVIC_ST_RELOAD) & 0x00ffffff));
+}
+
+//*****************************************************************************
+//
+// Takes any pending interrupts, unless interrupts are masked.  The SysTick
+// interrupt checks that it occurs one clock after the end of a tick, and that
+// the tick count is then the number of whole ticks since the check began.
+//
+//*****************************************************************************
+static void
+Service(void)
+{
+    uint64_t ui64Elapsed;
+    uint32_t ui32Expected;
+
+    if(g_bMasked)
+    {
+        return;
+    }
+
+    if(HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_PENDSTSET)
+    {
+        HWREG(NVIC_INT_CTRL) &= ~NVIC_INT_CTRL_PENDSTSET;
+        SchedulerSysTickIntHandler();
+        g_ui32SysTickInts++;
+
+        ui64Elapsed = g_ui64Clock - g_ui64ClockBase;
+        ui32Expected = g_ui32TickBase + (uint32_t)(ui64Elapsed / TICK_PERIOD);
+        if(((ui64Elapsed % TICK_PERIOD) != 1) ||
+           (SchedulerTickCountGet() != ui32Expected))
+        {
+            Fail("tick count", "tick %u at clock %llu, expected tick %u at "
+                 "one clock past a multiple of %u", SchedulerTickCountGet(),
+                 (unsigned long long)ui64Elapsed, ui32Expected, TICK_PERIOD);
+
+            //
+            // Check from here on, so that one lost tick is reported once.
+            //
+            g_ui64ClockBase = g_ui64Clock - 1;
+            g_ui32TickBase = SchedulerTickCountGet();
+        }
+    }
+
+    if(g_bWakePending)
+    {
+        g_bWakePending = false;
+        g_ui32WakeInts++;
+    }
+}
+
+//*****************************************************************************
+//
+// Advances the simulation by the given number of system clocks, counting
+// down the SysTick timer and taking interrupts as they occur.  When the
+// counter reaches zero it raises the interrupt, and on the following clock it
+// is reloaded; an interrupt is not taken while the counter is zero, so that it
+// is taken once the counter has been reloaded.
+//
+//*****************************************************************************
+static void
+Advance(uint64_t ui64Clocks)
+{
+    uint64_t ui64Step;
+
+    CurrentCheck();
+    while(ui64Clocks)
+    {
+        //
+        // Find how far to go before something happens: a reload, the counter
+        // reaching zero, or another interrupt.
+        //
+        if(!g_bSysTickEnabled)
+        {
+            ui64Step = ui64Clocks;
+        }
+        else if(g_ui32Counter == 0)
+        {
+            ui64Step = 1;
+        }
+        else
+        {
+            ui64Step = (g_ui32Counter < ui64Clocks) ? g_ui32Counter :
+                       ui64Clocks;
+        }
+        if(g_ui64WakeClock && ((g_ui64WakeClock - g_ui64Clock) < ui64Step))
+        {
+            ui64Step = g_ui64WakeClock - g_ui64Clock;
+        }
+
+        //
+        // Count down, or reload, the counter.
+        //
+        if(g_bSysTickEnabled)
+        {
+            if(g_ui32Counter == 0)
+            {
+                g_ui32Counter = ReloadGet();
+                g_bReloadLatched = false;
+            }
+            else
+            {
+                g_ui32Counter -= ui64Step;
+                if(g_ui32Counter == 0)
+                {
+                    HWREG(NVIC_INT_CTRL) |= NVIC_INT_CTRL_PENDSTSET;
+                }
+            }
+        }
+        g_ui64Clock += ui64Step;
+        ui64Clocks -= ui64Step;
+
+        if(g_ui64WakeClock && (g_ui64Clock == g_ui64WakeClock))
+        {
+            g_ui64WakeClock = 0;
+            g_bWakePending = true;
+        }
+
+        if(!g_bSysTickEnabled || (g_ui32Counter != 0))
+        {
+            Service();
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Returns true if an interrupt is pending.
+//
+//*****************************************************************************
+static bool
+IntPending(void)
+{
+    return(g_bWakePending ||
+           (HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_PENDSTSET));
+}
+
+//*****************************************************************************
+//
+// Stubs of the driver library functions called by utils/scheduler.c.
+//
+//*****************************************************************************
+uint32_t
+SysCtlClockGet(void)
+{
+    return(SYSTEM_CLOCK);
+}
+
+void
+SysCtlSleep(void)
+{
+    uint64_t ui64Clocks;
+
+    //
+    // Advance to the next interrupt, taking any which are not masked.
+    //
+    while(!IntPending())
+    {
+        if(g_bSysTickEnabled)
+        {
+            ui64Clocks = g_ui32Counter ? g_ui32Counter : (ReloadGet() + 1);
+        }
+        else if(g_ui64WakeClock)
+        {
+            ui64Clocks = g_ui64WakeClock - g_ui64Clock;
+        }
+        else
+        {
+            Fail("sleep", "no interrupt can wake the processor");
+            exit(1);
+        }
+        if(g_ui64WakeClock && ((g_ui64WakeClock - g_ui64Clock) < ui64Clocks))
+        {
+            ui64Clocks = g_ui64WakeClock - g_ui64Clock;
+        }
+        Advance(ui64Clocks);
+        if(!g_bMasked)
+        {
+            break;
+        }
+    }
+}
+
+void
+SysTickEnable(void)
+{
+    CurrentCheck();
+    g_bSysTickEnabled = true;
+    if(g_ui32Counter == 0)
+    {
+        g_ui32Reload = HWREG(NVIC_ST_RELOAD) & 0x00ffffff;
+        g_bReloadLatched = true;
+    }
+}
+
+void
+SysTickDisable(void)
+{
+    CurrentCheck();
+    g_bSysTickEnabled = false;
+}
+
+void
+SysTickIntEnable(void)
+{
+}
+
+void
+SysTickPeriodSet(uint32_t ui32Period)
+{
+    HWREG(NVIC_ST_RELOAD) = ui32Period - 1;
+}
+
+uint32_t
+SysTickValueGet(void)
+{
+    CurrentCheck();
+    return(g_ui32Counter);
+}
+
+bool
+IntMasterDisable(void)
+{
+    bool bWasMasked;
+
+    bWasMasked = g_bMasked;
+    g_bMasked = true;
+    return(bWasMasked);
+}
+
+bool
+IntMasterEnable(void)
+{
+    bool bWasMasked;
+
+    //
+    // A pending interrupt is taken a clock after it is unmasked.
+    //
+    bWasMasked = g_bMasked;
+    g_bMasked = false;
+    if(IntPending())
+    {
+        Advance(1);
+    }
+    return(bWasMasked);
+}
+
+//*****************************************************************************
+//
+// Advances the simulation by the given number of ticks.
+//
+//*****************************************************************************
+static void
+TicksAdvance(uint32_t ui32Ticks)
+{
+    Advance((uint64_t)ui32Ticks * TICK_PERIOD);
+}
+
+//*****************************************************************************
+//
+// Initializes a task, and the queue if requested.
+//
+//*****************************************************************************
+static void
+TaskInit(tSchedulerDeadlineTask *psTask, void (*pfnFunction)(void *),
+         uint32_t ui32Id, uint32_t ui32Period, uint32_t ui32Priority)
+{
+    memset(psTask, 0, sizeof(*psTask));
+    psTask->pfnFunction = pfnFunction;
+    psTask->pvParam = (void *)(uintptr_t)ui32Id;
+    psTask->ui32PeriodTicks = ui32Period;
+    psTask->ui32Priority = ui32Priority;
+}
+
+//*****************************************************************************
+//
+// A log of the tasks run, each given by its identifier and the tick on which
+// it ran.
+//
+//*****************************************************************************
+#define LOG_SIZE                256
+static uint32_t g_pui32LogId[LOG_SIZE];
+static uint32_t g_pui32LogTick[LOG_SIZE];
+static uint32_t g_ui32LogLen;
+
+static void
+LogTask(void *pvParam)
+{
+    if(g_ui32LogLen < LOG_SIZE)
+    {
+        g_pui32LogId[g_ui32LogLen] = (uint32_t)(uintptr_t)pvParam;
+        g_pui32LogTick[g_ui32LogLen] = SchedulerTickCountGet();
+    }
+    g_ui32LogLen++;
+}
+
+//*****************************************************************************
+//
+// Returns the identifiers of the logged tasks as a string, with the
+// identifiers taken as characters, and empties the log.
+//
+//*****************************************************************************
+static const char *
+LogString(void)
+{
+    static char pcBuf[LOG_SIZE + 1];
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; (ui32Idx < g_ui32LogLen) && (ui32Idx < LOG_SIZE);
+        ui32Idx++)
+    {
+        pcBuf[ui32Idx] = (char)g_pui32LogId[ui32Idx];
+    }
+    pcBuf[ui32Idx] = '\0';
+    g_ui32LogLen = 0;
+    return(pcBuf);
+}
+
+//*****************************************************************************
+//
+// Checks that tasks due on the same tick run in order of priority, and tasks
+// due on different ticks in order of their due tick, whatever the order in
+// which they were started.
+//
+//*****************************************************************************
+static void
+PriorityTest(void)
+{
+    static const struct
+    {
+        char cId;
+        uint32_t ui32Priority;
+        uint32_t ui32Delay;
+    }
+    psTasks[] =
+    {
+        { 'A', 2, 5 }, { 'B', 0, 5 }, { 'C', 1, 5 }, { 'D', 9, 4 },
+        { 'E', 0, 6 }, { 'F', 3, 5 }, { 'G', 7, 3 },
+    };
+    tSchedulerDeadlineTask psTask[sizeof(psTasks) / sizeof(psTasks[0])];
+    uint32_t ui32Failed, ui32Pass, ui32Idx, ui32Task, ui32Num;
+    const char *pcOrder;
+
+    ui32Failed = g_ui32Failed;
+    ui32Num = sizeof(psTasks) / sizeof(psTasks[0]);
+    for(ui32Pass = 0; ui32Pass < 2; ui32Pass++)
+    {
+        SchedulerDeadlineInit(g_ppsQueue, QUEUE_SIZE);
+        for(ui32Idx = 0; ui32Idx < ui32Num; ui32Idx++)
+        {
+            TaskInit(&psTask[ui32Idx], LogTask, psTasks[ui32Idx].cId, 0,
+                     psTasks[ui32Idx].ui32Priority);
+        }
+
+        //
+        // Start the tasks forwards on the first pass and backwards on the
+        // second.
+        //
+        for(ui32Idx = 0; ui32Idx < ui32Num; ui32Idx++)
+        {
+            ui32Task = ui32Pass ? (ui32Num - ui32Idx - 1) : ui32Idx;
+            SchedulerDeadlineTaskStart(&psTask[ui32Task],
+                                       psTasks[ui32Task].ui32Delay);
+        }
+        if(SchedulerNextDeadlineGet() != 3)
+        {
+            Fail("priority", "next deadline %u, expected 3",
+                 SchedulerNextDeadlineGet());
+        }
+
+        //
+        // Run the tasks together, then check that the one-shot tasks do not
+        // run again.
+        //
+        TicksAdvance(10);
+        SchedulerRun();
+        SchedulerRun();
+        pcOrder = LogString();
+        if(strcmp(pcOrder, "GDBCAFE") != 0)
+        {
+            Fail("priority", "tasks ran in the order %s, expected GDBCAFE",
+                 pcOrder);
+        }
+        if(SchedulerNextDeadlineGet() != 0xFFFFFFFF)
+        {
+            Fail("priority", "tasks remain queued");
+        }
+    }
+    printf("%-6s priority\n", (g_ui32Failed != ui32Failed) ? "FAILED" : "ok");
+}
+
+//*****************************************************************************
+//
+// Tasks which restart or stop themselves, or other tasks, while they run.
+//
+//*****************************************************************************
+static tSchedulerDeadlineTask g_sRestart, g_sStopper, g_sRephase;
+static tSchedulerDeadlineTask g_sKiller, g_sVictim, g_sLate;
+
+static void
+RestartTask(void *pvParam)
+{
+    LogTask(pvParam);
+    SchedulerDeadlineTaskStart(&g_sRestart, 0);
+}
+
+static void
+StopperTask(void *pvParam)
+{
+    LogTask(pvParam);
+    if(g_sStopper.ui32RunCount == 2)
+    {
+        SchedulerDeadlineTaskStop(&g_sStopper);
+    }
+}
+
+static void
+RephaseTask(void *pvParam)
+{
+    LogTask(pvParam);
+    SchedulerDeadlineTaskStart(&g_sRephase, 3);
+}
+
+static void
+KillerTask(void *pvParam)
+{
+    LogTask(pvParam);
+    SchedulerDeadlineTaskStop(&g_sVictim);
+    SchedulerDeadlineTaskStart(&g_sLate, 1);
+}
+
+//*****************************************************************************
+//
+// Checks tasks which restart or stop themselves or other tasks from within
+// their functions.
+//
+//*****************************************************************************
+static void
+SelfTest(void)
+{
+    uint32_t ui32Failed, ui32Start, ui32Idx;
+    const char *pcOrder;
+
+    ui32Failed = g_ui32Failed;
+    SchedulerDeadlineInit(g_ppsQueue, QUEUE_SIZE);
+
+    //
+    // A one-shot task which restarts itself with no delay runs once on each
+    // call to SchedulerRun(), not repeatedly within one call.
+    //
+    TaskInit(&g_sRestart, RestartTask, 'R', 0, 0);
+    SchedulerDeadlineTaskStart(&g_sRestart, 0);
+    SchedulerRun();
+    SchedulerRun();
+    SchedulerRun();
+    pcOrder = LogString();
+    if(strcmp(pcOrder, "RRR") != 0)
+    {
+        Fail("self restart", "ran %s, expected RRR", pcOrder);
+    }
+    SchedulerDeadlineTaskStop(&g_sRestart);
+
+    //
+    // A periodic task which stops itself on its third run is not run again,
+    // and a periodic task which restarts itself takes its new phase rather
+    // than its period.
+    //
+    ui32Start = SchedulerTickCountGet();
+    TaskInit(&g_sStopper, StopperTask, 'S', 2, 1);
+    TaskInit(&g_sRephase, RephaseTask, 'P', 5, 2);
+    SchedulerDeadlineTaskStart(&g_sStopper, 2);
+    SchedulerDeadlineTaskStart(&g_sRephase, 1);
+    for(ui32Idx = 0; ui32Idx < 12; ui32Idx++)
+    {
+        TicksAdvance(1);
+        SchedulerRun();
+    }
+    for(ui32Idx = 0; ui32Idx < g_ui32LogLen; ui32Idx++)
+    {
+        g_pui32LogTick[ui32Idx] -= ui32Start;
+    }
+    if((g_ui32LogLen != 7) ||
+       (g_pui32LogId[0] != 'P') || (g_pui32LogTick[0] != 1) ||
+       (g_pui32LogId[1] != 'S') || (g_pui32LogTick[1] != 2) ||
+       (g_pui32LogId[2] != 'S') || (g_pui32LogTick[2] != 4) ||
+       (g_pui32LogId[3] != 'P') || (g_pui32LogTick[3] != 4) ||
+       (g_pui32LogId[4] != 'S') || (g_pui32LogTick[4] != 6) ||
+       (g_pui32LogId[5] != 'P') || (g_pui32LogTick[5] != 7) ||
+       (g_pui32LogId[6] != 'P') || (g_pui32LogTick[6] != 10))
+    {
+        Fail("self stop", "ran %s", LogString());
+    }
+    g_ui32LogLen = 0;
+    SchedulerDeadlineTaskStop(&g_sRephase);
+
+    //
+    // A task which stops a task due on the same tick after it, and moves
+    // another task from far in the future to the next tick.
+    //
+    TaskInit(&g_sKiller, KillerTask, 'K', 0, 0);
+    TaskInit(&g_sVictim, LogTask, 'V', 4, 1);
+    TaskInit(&g_sLate, LogTask, 'L', 0, 0);
+    SchedulerDeadlineTaskStart(&g_sLate, 100);
+    SchedulerDeadlineTaskStart(&g_sVictim, 1);
+    SchedulerDeadlineTaskStart(&g_sKiller, 1);
+    for(ui32Idx = 0; ui32Idx < 8; ui32Idx++)
+    {
+        TicksAdvance(1);
+        SchedulerRun();
+    }
+    pcOrder = LogString();
+    if((strcmp(pcOrder, "KL") != 0) || (g_sVictim.ui32RunCount != 0) ||
+       (SchedulerNextDeadlineGet() != 0xFFFFFFFF))
+    {
+        Fail("stop other", "ran %s, expected KL", pcOrder);
+    }
+
+    printf("%-6s restart and stop\n", (g_ui32Failed != ui32Failed) ?
+           "FAILED" : "ok");
+}
+
+//*****************************************************************************
+//
+// A task which takes a long time to run.
+//
+//*****************************************************************************
+#define LONG_TASK_CLOCKS        ((7 * TICK_PERIOD) + 123)
+
+static void
+LongTask(void *pvParam)
+{
+    LogTask(pvParam);
+    Advance(LONG_TASK_CLOCKS);
+}
+
+//*****************************************************************************
+//
+// Checks that a periodic task which is run late skips the periods it missed,
+// counting them as overruns, and that the time taken by a task is measured.
+//
+//*****************************************************************************
+static void
+OverrunTest(void)
+{
+    tSchedulerDeadlineTask sPeriodic, sLong, sAfter;
+    uint32_t ui32Failed;
+
+    ui32Failed = g_ui32Failed;
+    SchedulerDeadlineInit(g_ppsQueue, QUEUE_SIZE);
+
+    //
+    // A task with a period of three ticks which is not run for ten ticks
+    // runs once, misses the periods due on the sixth and ninth ticks, and is
+    // next due on the twelfth.
+    //
+    TaskInit(&sPeriodic, LogTask, 'T', 3, 0);
+    SchedulerDeadlineTaskStart(&sPeriodic, 3);
+    TicksAdvance(10);
+    SchedulerRun();
+    if((sPeriodic.ui32RunCount != 1) || (sPeriodic.ui32Overruns != 2) ||
+       (SchedulerNextDeadlineGet() != 2))
+    {
+        Fail("overrun", "%u runs, %u overruns, next due in %u ticks",
+             sPeriodic.ui32RunCount, sPeriodic.ui32Overruns,
+             SchedulerNextDeadlineGet());
+    }
+    SchedulerDeadlineTaskStop(&sPeriodic);
+
+    //
+    // A task which runs for over seven ticks delays a task with a period of
+    // two due on the same tick, which misses three periods.  The time taken
+    // by the long task is measured exactly, since the simulated timer stops
+    // while the scheduler runs.
+    //
+    TaskInit(&sLong, LongTask, 'L', 0, 0);
+    TaskInit(&sAfter, LogTask, 'A', 2, 1);
+    SchedulerDeadlineTaskStart(&sAfter, 1);
+    SchedulerDeadlineTaskStart(&sLong, 1);
+    TicksAdvance(1);
+    SchedulerRun();
+    if((sAfter.ui32RunCount != 1) || (sAfter.ui32Overruns != 3) ||
+       (SchedulerNextDeadlineGet() != 1) ||
+       (sLong.ui32RunTimeMax != LONG_TASK_CLOCKS) ||
+       (sLong.ui32RunTimeTotal != LONG_TASK_CLOCKS))
+    {
+        Fail("long task", "%u overruns, next due in %u ticks, ran for %u "
+             "clocks", sAfter.ui32Overruns, SchedulerNextDeadlineGet(),
+             sLong.ui32RunTimeMax);
+    }
+    SchedulerDeadlineTaskStop(&sAfter);
+    g_ui32LogLen = 0;
+
+    //
+    // Move back to the point in a tick at which the SysTick interrupt is
+    // taken.
+    //
+    Advance((TICK_PERIOD + 1 - ((g_ui64Clock - g_ui64ClockBase) %
+                                TICK_PERIOD)) % TICK_PERIOD);
+
+    printf("%-6s overruns\n", (g_ui32Failed != ui32Failed) ? "FAILED" : "ok");
+}
+
+//*****************************************************************************
+//
+// The model of the deadline queue used by the randomized test, holding
+// whether each task is queued and the tick on which it is due, along with
+// the tasks and their number of runs and overruns, and the task which is
+// running (or NUM_TASKS if none is).
+//
+//*****************************************************************************
+static tSchedulerDeadlineTask g_psTasks[NUM_TASKS];
+static bool g_pbModelQueued[NUM_TASKS];
+static uint32_t g_pui32ModelDue[NUM_TASKS];
+static uint32_t g_pui32ModelRuns[NUM_TASKS];
+static uint32_t g_pui32ModelOverruns[NUM_TASKS];
+static bool g_pbModelTouched[NUM_TASKS];
+static uint32_t g_ui32ModelCount;
+static uint32_t g_ui32ModelNow;
+static uint32_t g_ui32ModelRunning = NUM_TASKS;
+
+//*****************************************************************************
+//
+// The action taken by a task of the randomized test each time it runs, which
+// depends only on the task and the number of times it has run, so that it can
+// be repeated in the model.  Returns zero for none, or the action in the low
+// byte (1 to start a task, 2 to stop it) followed by the task and the delay.
+//
+//*****************************************************************************
+static uint32_t
+TaskAction(uint32_t ui32Task, uint32_t ui32Run)
+{
+    uint32_t ui32Hash;
+
+    ui32Hash = ((ui32Task * 0x9e3779b1) ^ (ui32Run * 0x85ebca6b)) * 0xc2b2ae35;
+    ui32Hash ^= ui32Hash >> 15;
+    switch((ui32Hash >> 8) & 7)
+    {
+        case 0:
+        case 1:
+        {
+            return(1 | (((ui32Hash >> 12) % NUM_TASKS) << 8) |
+                   (((ui32Hash >> 20) & 3) << 16));
+        }
+
+        case 2:
+        {
+            return(2 | (((ui32Hash >> 12) % NUM_TASKS) << 8));
+        }
+
+        default:
+        {
+            return(0);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Starts or stops a task in the model, returning false if it could not be
+// started because the queue is full.  A running periodic task which has not
+// restarted or stopped itself keeps its place in the queue.
+//
+//*****************************************************************************
+static bool
+ModelStart(uint32_t ui32Task, uint32_t ui32Delay)
+{
+    uint32_t ui32Used;
+
+    ui32Used = g_ui32ModelCount;
+    if((g_ui32ModelRunning != NUM_TASKS) && (g_ui32ModelRunning != ui32Task) &&
+       !g_pbModelTouched[g_ui32ModelRunning] &&
+       g_psTasks[g_ui32ModelRunning].ui32PeriodTicks)
+    {
+        ui32Used++;
+    }
+    g_pbModelTouched[ui32Task] = true;
+    if(g_pbModelQueued[ui32Task])
+    {
+        g_pbModelQueued[ui32Task] = false;
+        g_ui32ModelCount--;
+        ui32Used--;
+    }
+    if(ui32Used == QUEUE_SIZE)
+    {
+        return(false);
+    }
+    g_pbModelQueued[ui32Task] = true;
+    g_pui32ModelDue[ui32Task] = g_ui32ModelNow + ui32Delay;
+    g_ui32ModelCount++;
+    return(true);
+}
+
+static void
+ModelStop(uint32_t ui32Task)
+{
+    g_pbModelTouched[ui32Task] = true;
+    if(g_pbModelQueued[ui32Task])
+    {
+        g_pbModelQueued[ui32Task] = false;
+        g_ui32ModelCount--;
+    }
+}
+
+//*****************************************************************************
+//
+// Runs the model of SchedulerRun(), logging the tasks which it runs.  The task
+// which is due first, and of those the one with the highest priority, runs
+// next, and no more tasks run than were queued at the start.
+//
+//*****************************************************************************
+static void
+ModelRun(uint32_t *pui32Log, uint32_t *pui32LogLen)
+{
+    uint32_t ui32Loop, ui32Idx, ui32Best, ui32Action, ui32Missed;
+    tSchedulerDeadlineTask *psTask;
+    int32_t i32Diff;
+
+    for(ui32Loop = g_ui32ModelCount; ui32Loop != 0; ui32Loop--)
+    {
+        //
+        // Find the task to run, if any is due.
+        //
+        ui32Best = NUM_TASKS;
+        for(ui32Idx = 0; ui32Idx < NUM_TASKS; ui32Idx++)
+        {
+            if(!g_pbModelQueued[ui32Idx] ||
+               ((int32_t)(g_pui32ModelDue[ui32Idx] - g_ui32ModelNow) > 0))
+            {
+                continue;
+            }
+            if(ui32Best != NUM_TASKS)
+            {
+                i32Diff = (int32_t)(g_pui32ModelDue[ui32Idx] -
+                                    g_pui32ModelDue[ui32Best]);
+                if((i32Diff > 0) ||
+                   ((i32Diff == 0) &&
+                    (g_psTasks[ui32Idx].ui32Priority >
+                     g_psTasks[ui32Best].ui32Priority)))
+                {
+                    continue;
+                }
+            }
+            ui32Best = ui32Idx;
+        }
+        if(ui32Best == NUM_TASKS)
+        {
+            break;
+        }
+
+        //
+        // Run it, taking the same action as the task.
+        //
+        psTask = &g_psTasks[ui32Best];
+        g_pbModelQueued[ui32Best] = false;
+        g_ui32ModelCount--;
+        pui32Log[(*pui32LogLen)++] = ui32Best;
+        memset(g_pbModelTouched, 0, sizeof(g_pbModelTouched));
+        g_ui32ModelRunning = ui32Best;
+        ui32Action = TaskAction(ui32Best, g_pui32ModelRuns[ui32Best]++);
+        if((ui32Action & 0xff) == 1)
+        {
+            ModelStart((ui32Action >> 8) & 0xff, ui32Action >> 16);
+        }
+        else if((ui32Action & 0xff) == 2)
+        {
+            ModelStop((ui32Action >> 8) & 0xff);
+        }
+        g_ui32ModelRunning = NUM_TASKS;
+
+        //
+        // Requeue a periodic task which did not restart or stop itself.
+        //
+        if(!g_pbModelTouched[ui32Best] && psTask->ui32PeriodTicks)
+        {
+            g_pui32ModelDue[ui32Best] += psTask->ui32PeriodTicks;
+            if((int32_t)(g_pui32ModelDue[ui32Best] - g_ui32ModelNow) <= 0)
+            {
+                ui32Missed = (((g_ui32ModelNow - g_pui32ModelDue[ui32Best]) /
+                               psTask->ui32PeriodTicks) + 1);
+                g_pui32ModelOverruns[ui32Best] += ui32Missed;
+                g_pui32ModelDue[ui32Best] +=
+                    ui32Missed * psTask->ui32PeriodTicks;
+            }
+            g_pbModelQueued[ui32Best] = true;
+            g_ui32ModelCount++;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the number of ticks until the first task in the model is due.
+//
+//*****************************************************************************
+static uint32_t
+ModelNextDeadline(void)
+{
+    uint32_t ui32Idx, ui32Ticks;
+    int32_t i32Diff;
+
+    ui32Ticks = 0xFFFFFFFF;
+    for(ui32Idx = 0; ui32Idx < NUM_TASKS; ui32Idx++)
+    {
+        if(g_pbModelQueued[ui32Idx])
+        {
+            i32Diff = (int32_t)(g_pui32ModelDue[ui32Idx] - g_ui32ModelNow);
+            if(i32Diff <= 0)
+            {
+                return(0);
+            }
+            if((uint32_t)i32Diff < ui32Ticks)
+            {
+                ui32Ticks = (uint32_t)i32Diff;
+            }
+        }
+    }
+    return(ui32Ticks);
+}
+
+//*****************************************************************************
+//
+// The function of each task of the randomized test, which logs the task and
+// takes its action.
+//
+//*****************************************************************************
+static uint32_t g_pui32RunLog[NUM_TASKS * 2];
+static uint32_t g_ui32RunLogLen;
+
+static void
+RandomTask(void *pvParam)
+{
+    uint32_t ui32Task, ui32Action;
+
+    ui32Task = (uint32_t)(uintptr_t)pvParam;
+    if(g_ui32RunLogLen < (NUM_TASKS * 2))
+    {
+        g_pui32RunLog[g_ui32RunLogLen] = ui32Task;
+    }
+    g_ui32RunLogLen++;
+
+    ui32Action = TaskAction(ui32Task, g_psTasks[ui32Task].ui32RunCount);
+    if((ui32Action & 0xff) == 1)
+    {
+        SchedulerDeadlineTaskStart(&g_psTasks[(ui32Action >> 8) & 0xff],
+                                   ui32Action >> 16);
+    }
+    else if((ui32Action & 0xff) == 2)
+    {
+        SchedulerDeadlineTaskStop(&g_psTasks[(ui32Action >> 8) & 0xff]);
+    }
+}
+
+//*****************************************************************************
+//
+// Starts, stops, and runs tasks at random, some of which start and stop
+// tasks (including themselves) as they run, and checks that the tasks run in
+// the same order as in a model which searches all the tasks for the next to
+// run.  The queue is smaller than the number of tasks, so it is often full.
+// Some ticks are skipped, so that periodic tasks overrun.
+//
+//*****************************************************************************
+static void
+RandomTest(uint32_t ui32Ticks)
+{
+    uint32_t pui32ModelLog[NUM_TASKS * 2], ui32ModelLogLen;
+    uint32_t ui32Tick, ui32Idx, ui32Task, ui32Delay, ui32Failed, ui32Runs;
+    bool bStarted;
+
+    ui32Failed = g_ui32Failed;
+    SchedulerDeadlineInit(g_ppsQueue, QUEUE_SIZE);
+    g_ui32ModelCount = 0;
+    ui32Runs = 0;
+    for(ui32Idx = 0; ui32Idx < NUM_TASKS; ui32Idx++)
+    {
+        TaskInit(&g_psTasks[ui32Idx], RandomTask, ui32Idx, rand() % 8,
+                 NUM_TASKS - ui32Idx);
+        g_pbModelQueued[ui32Idx] = false;
+        g_pui32ModelRuns[ui32Idx] = 0;
+        g_pui32ModelOverruns[ui32Idx] = 0;
+    }
+
+    for(ui32Tick = 0;
+        (ui32Tick < ui32Ticks) && (g_ui32Failed == ui32Failed); ui32Tick++)
+    {
+        //
+        // Start or stop a few tasks.
+        //
+        g_ui32ModelNow = SchedulerTickCountGet();
+        for(ui32Idx = rand() % 4; ui32Idx != 0; ui32Idx--)
+        {
+            ui32Task = rand() % NUM_TASKS;
+            if(rand() % 4)
+            {
+                ui32Delay = rand() % 12;
+                bStarted = SchedulerDeadlineTaskStart(&g_psTasks[ui32Task],
+                                                      ui32Delay);
+                if(bStarted != ModelStart(ui32Task, ui32Delay))
+                {
+                    Fail("random", "start of task %u returned %d on tick %u",
+                         ui32Task, bStarted, ui32Tick);
+                }
+            }
+            else
+            {
+                SchedulerDeadlineTaskStop(&g_psTasks[ui32Task]);
+                ModelStop(ui32Task);
+            }
+        }
+
+        //
+        // Advance by a tick, or occasionally several, and run the tasks which
+        // are due.
+        //
+        TicksAdvance((rand() % 16) ? 1 : (2 + (rand() % 6)));
+        g_ui32ModelNow = SchedulerTickCountGet();
+        g_ui32RunLogLen = 0;
+        SchedulerRun();
+        ui32ModelLogLen = 0;
+        ModelRun(pui32ModelLog, &ui32ModelLogLen);
+        ui32Runs += g_ui32RunLogLen;
+
+        //
+        // Check that the same tasks ran in the same order.
+        //
+        if((g_ui32RunLogLen != ui32ModelLogLen) ||
+           memcmp(g_pui32RunLog, pui32ModelLog,
+                  ui32ModelLogLen * sizeof(uint32_t)))
+        {
+            Fail("random", "%u tasks ran on tick %u, expected %u",
+                 g_ui32RunLogLen, ui32Tick, ui32ModelLogLen);
+        }
+        if(SchedulerNextDeadlineGet() != ModelNextDeadline())
+        {
+            Fail("random", "next deadline %u on tick %u, expected %u",
+                 SchedulerNextDeadlineGet(), ui32Tick, ModelNextDeadline());
+        }
+    }
+
+    //
+    // Check the statistics kept for each task.
+    //
+    for(ui32Idx = 0; ui32Idx < NUM_TASKS; ui32Idx++)
+    {
+        if((g_psTasks[ui32Idx].ui32RunCount != g_pui32ModelRuns[ui32Idx]) ||
+           (g_psTasks[ui32Idx].ui32Overruns != g_pui32ModelOverruns[ui32Idx]))
+        {
+            Fail("random", "task %u ran %u times with %u overruns, expected "
+                 "%u with %u", ui32Idx, g_psTasks[ui32Idx].ui32RunCount,
+                 g_psTasks[ui32Idx].ui32Overruns, g_pui32ModelRuns[ui32Idx],
+                 g_pui32ModelOverruns[ui32Idx]);
+        }
+        SchedulerDeadlineTaskStop(&g_psTasks[ui32Idx]);
+    }
+
+    printf("%-6s random (%u runs over %u ticks)\n",
+           (g_ui32Failed != ui32Failed) ? "FAILED" : "ok", ui32Runs,
+           ui32Tick);
+}
+
+//*****************************************************************************
+//
+// The tasks of the tickless idle tests, each of which checks that it runs on
+// the tick on which it is due, and the longest delay with which the one-shot
+// task restarts itself.
+//
+//*****************************************************************************
+static tSchedulerDeadlineTask g_psIdleTasks[4];
+static uint32_t g_pui32IdleDue[4];
+static uint32_t g_ui32IdleLate;
+static uint32_t g_ui32IdleShotMax;
+
+static void
+IdleTask(void *pvParam)
+{
+    uint32_t ui32Task;
+
+    ui32Task = (uint32_t)(uintptr_t)pvParam;
+    if(SchedulerTickCountGet() != g_pui32IdleDue[ui32Task])
+    {
+        if(!g_ui32IdleLate++)
+        {
+            Fail("idle", "task %u ran on tick %u, due on tick %u", ui32Task,
+                 SchedulerTickCountGet(), g_pui32IdleDue[ui32Task]);
+        }
+    }
+    g_pui32IdleDue[ui32Task] = (SchedulerTickCountGet() +
+                                g_psIdleTasks[ui32Task].ui32PeriodTicks);
+
+    //
+    // The one-shot task restarts itself with a varying delay.
+    //
+    if(g_psIdleTasks[ui32Task].ui32PeriodTicks == 0)
+    {
+        g_pui32IdleDue[ui32Task] = (SchedulerTickCountGet() + 1 +
+                                    (rand() % g_ui32IdleShotMax));
+        SchedulerDeadlineTaskStart(&g_psIdleTasks[ui32Task],
+                                   g_pui32IdleDue[ui32Task] -
+                                   SchedulerTickCountGet());
+    }
+}
+
+//*****************************************************************************
+//
+// Sleeps with SchedulerIdle() and runs the tasks until the tick count reaches
+// the given tick, with other interrupts waking the processor at random times
+// once every so many sleeps on average (or never, if zero).
+//
+//*****************************************************************************
+static void
+IdleRun(uint32_t ui32Until, uint32_t ui32WakeRate)
+{
+    uint32_t ui32Phase;
+
+    while((int32_t)(SchedulerTickCountGet() - ui32Until) < 0)
+    {
+        if(ui32WakeRate && ((rand() % ui32WakeRate) == 0))
+        {
+            //
+            // Wake within the next few ticks.  Sometimes wake on the last
+            // clock of a tick, where the rest of the tick is too short to
+            // count, or on the clock at which a tick ends.
+            //
+            g_ui64WakeClock = g_ui64Clock + 1 +
+                              (rand() % (TICK_PERIOD * 4));
+            ui32Phase = (g_ui64WakeClock - g_ui64ClockBase) % TICK_PERIOD;
+            switch(rand() % 4)
+            {
+                case 0:
+                {
+                    g_ui64WakeClock += TICK_PERIOD - 1 - ui32Phase;
+                    break;
+                }
+
+                case 1:
+                {
+                    g_ui64WakeClock += (TICK_PERIOD - ui32Phase) % TICK_PERIOD;
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+        SchedulerIdle();
+        g_ui64WakeClock = 0;
+        SchedulerRun();
+    }
+}
+
+//*****************************************************************************
+//
+// Starts the tasks of a tickless idle test.
+//
+//*****************************************************************************
+static void
+IdleTasksStart(const uint32_t *pui32Periods)
+{
+    uint32_t ui32Idx;
+
+    SchedulerDeadlineInit(g_ppsQueue, QUEUE_SIZE);
+    for(ui32Idx = 0; ui32Idx < 4; ui32Idx++)
+    {
+        TaskInit(&g_psIdleTasks[ui32Idx], IdleTask, ui32Idx,
+                 pui32Periods[ui32Idx], ui32Idx);
+        SchedulerDeadlineTaskStart(&g_psIdleTasks[ui32Idx],
+                                   pui32Periods[ui32Idx] + 1);
+        g_pui32IdleDue[ui32Idx] = (SchedulerTickCountGet() +
+                                   pui32Periods[ui32Idx] + 1);
+    }
+    g_ui32IdleLate = 0;
+}
+
+static void
+IdleTasksStop(void)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < 4; ui32Idx++)
+    {
+        if(g_psIdleTasks[ui32Idx].ui32Overruns)
+        {
+            Fail("idle", "task %u overran", ui32Idx);
+        }
+        SchedulerDeadlineTaskStop(&g_psIdleTasks[ui32Idx]);
+    }
+}
+
+//*****************************************************************************
+//
+// Checks that SchedulerIdle() keeps the tick count right while it stretches
+// the SysTick period, with and without other interrupts ending the sleep
+// early, and reports the SysTick interrupts taken for each thousand ticks.
+//
+//*****************************************************************************
+static void
+IdleTest(uint32_t ui32Ticks)
+{
+    static const uint32_t pui32Periods[4] = { 7, 50, 0, 1000 };
+    uint32_t ui32Failed, ui32Pass, ui32Start, ui32Ints, ui32Wakes;
+
+    for(ui32Pass = 0; ui32Pass < 2; ui32Pass++)
+    {
+        ui32Failed = g_ui32Failed;
+        g_ui32IdleShotMax = 300;
+        IdleTasksStart(pui32Periods);
+        ui32Start = SchedulerTickCountGet();
+        ui32Ints = g_ui32SysTickInts;
+        ui32Wakes = g_ui32WakeInts;
+        IdleRun(ui32Start + ui32Ticks, ui32Pass ? 2 : 0);
+        IdleTasksStop();
+        ui32Ints = g_ui32SysTickInts - ui32Ints;
+        ui32Wakes = g_ui32WakeInts - ui32Wakes;
+        printf("%-6s tickless idle%s (%.1f SysTick interrupts per 1000 "
+               "ticks", (g_ui32Failed != ui32Failed) ? "FAILED" : "ok",
+               ui32Pass ? " with wakes" : "",
+               (ui32Ints * 1000.0) / (SchedulerTickCountGet() - ui32Start));
+        if(ui32Pass)
+        {
+            printf(", %u early wakes", ui32Wakes);
+        }
+        printf(")\n");
+    }
+}
+
+//*****************************************************************************
+//
+// The tasks of the tick count wrap test.  The marker task is due shortly
+// before the wrap, and starts a task which is due after it.
+//
+//*****************************************************************************
+static tSchedulerDeadlineTask g_sWrapMark, g_sWrapAcross, g_sWrapLong;
+
+static void
+WrapMarkTask(void *pvParam)
+{
+    LogTask(pvParam);
+    SchedulerDeadlineTaskStart(&g_sWrapAcross, 0x180);
+}
+
+//*****************************************************************************
+//
+// Checks that tasks are run on time as the tick count wraps from 0xFFFFFFFF
+// to zero.  The scheduler is idle between tasks, which are a long way apart,
+// so that the tick count reaches the wrap quickly.  Two tasks are due on the
+// tick 0x80: one started a quarter of the way around the tick count before
+// it, and one started 0x180 ticks before it, from a task run shortly before
+// the wrap.  They must both run on that tick, in order of priority.
+//
+//*****************************************************************************
+static void
+WrapTest(void)
+{
+    static const uint32_t pui32Periods[4] = { 0x08000000, 0x00fedcba, 0,
+                                              0x0badcafe };
+    uint32_t ui32Failed;
+
+    ui32Failed = g_ui32Failed;
+    g_ui32IdleShotMax = 0x00100000;
+    IdleTasksStart(pui32Periods);
+    TaskInit(&g_sWrapMark, WrapMarkTask, 'M', 0, 0);
+    TaskInit(&g_sWrapAcross, LogTask, 'A', 0, 1);
+    TaskInit(&g_sWrapLong, LogTask, 'L', 0, 2);
+
+    //
+    // Run until three quarters of the way to the wrap, then start the tasks
+    // which run around it.
+    //
+    IdleRun(0x80000000, 64);
+    IdleRun(0xC0000000, 64);
+    SchedulerDeadlineTaskStart(&g_sWrapMark,
+                               0xFFFFFF00 - SchedulerTickCountGet());
+    SchedulerDeadlineTaskStart(&g_sWrapLong,
+                               0x00000080 - SchedulerTickCountGet());
+    g_ui32LogLen = 0;
+
+    //
+    // Run until well after the wrap.
+    //
+    IdleRun(0x10000000, 64);
+    IdleTasksStop();
+    if((g_ui32LogLen != 3) ||
+       (g_pui32LogId[0] != 'M') || (g_pui32LogTick[0] != 0xFFFFFF00) ||
+       (g_pui32LogId[1] != 'A') || (g_pui32LogTick[1] != 0x00000080) ||
+       (g_pui32LogId[2] != 'L') || (g_pui32LogTick[2] != 0x00000080))
+    {
+        Fail("wrap", "ran %s around the wrap", LogString());
+    }
+    g_ui32LogLen = 0;
+
+    printf("%-6s tick count wrap\n", (g_ui32Failed != ui32Failed) ?
+           "FAILED" : "ok");
+}
+
+//*****************************************************************************
+//
+// Prints the usage of the program.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    printf("Usage: %s [OPTION]...\n", pcProgram);
+    printf("Tests the deadline-ordered tasks and tickless idle of the "
+           "scheduler.\n\n");
+    printf("  -n TICKS Run the randomized tests for TICKS ticks "
+           "(default %u)\n", DEFAULT_TICKS);
+    printf("  -s SEED  Seed the random number generator with SEED "
+           "(default 1)\n");
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    uint32_t ui32Ticks, ui32Seed;
+    void *pvPage;
+    int iOpt;
+
+    ui32Ticks = DEFAULT_TICKS;
+    ui32Seed = 1;
+
+    while((iOpt = getopt(argc, argv, "hn:s:")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'n':
+            {
+                ui32Ticks = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            case 's':
+            {
+                ui32Seed = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+    if(ui32Ticks == 0)
+    {
+        Usage(argv[0]);
+        return(1);
+    }
+    srand(ui32Seed);
+
+    //
+    // Map the page holding the SysTick and interrupt control registers.
+    //
+    pvPage = mmap((void *)(uintptr_t)NVIC_PAGE, NVIC_PAGE_SIZE,
+                  PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if(pvPage != (void *)(uintptr_t)NVIC_PAGE)
+    {
+        printf("Unable to map the SysTick registers at 0x%08x.\n", NVIC_PAGE);
+        return(1);
+    }
+    HWREG(NVIC_ST_CURRENT) = ST_CURRENT_UNWRITTEN;
+
+    //
+    // Start the scheduler, and move to the point in the first tick at which
+    // the SysTick interrupt would have been taken, which is where each of the
+    // tests starts and ends.
+    //
+    SchedulerInit(TICKS_PER_SECOND);
+    g_ui64ClockBase = g_ui64Clock;
+    g_ui32TickBase = SchedulerTickCountGet();
+    Advance(1);
+
+    PriorityTest();
+    SelfTest();
+    OverrunTest();
+    RandomTest(ui32Ticks);
+    IdleTest(ui32Ticks);
+    WrapTest();
+
+    return(g_ui32Failed ? 1 : 0);
+}
@@ -0,0 +1,947 @@
+//*****************************************************************************
+//
+// uartbench.c - Host-side simulation of the buffered UART console.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "utils/uartstdio.h"
+
+//*****************************************************************************
+//
+// This program links utils/uartstdio.c, built in buffered mode, with a
+// simulation of the UART, its FIFOs, and the uDMA controller, in place of the
+// driver library functions which it calls.  It is built twice, with and
+// without UART_DMA, and for each of its tests it counts the UART interrupts
+// taken to move the data, so that the two modes can be compared.  Each test
+// also checks that the data arrives intact.
+//
+// The simulation advances in steps of one character time on the line, in
+// which the UART transmits one character and may receive one.  The interrupt
+// handler and the application run between the steps, so the results are
+// those of a processor fast enough to keep up with the line, and do not
+// depend on the baud rate.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The default number of bytes moved by each test.
+//
+//*****************************************************************************
+#define DEFAULT_BYTES           65536
+
+//*****************************************************************************
+//
+// The size of the UART FIFOs, and the number of character times for which
+// the receive line must be idle before the receive timeout interrupt occurs
+// (the hardware waits for 32 bit times).
+//
+//*****************************************************************************
+#define FIFO_SIZE               16
+#define RX_TIMEOUT              4
+
+//*****************************************************************************
+//
+// The uDMA channels used for UART0.
+//
+//*****************************************************************************
+#define RX_CHANNEL              (UDMA_CH8_UART0RX & 0x1f)
+#define TX_CHANNEL              (UDMA_CH9_UART0TX & 0x1f)
+
+//*****************************************************************************
+//
+// A simulated UART FIFO.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint8_t pui8Data[FIFO_SIZE];
+    uint32_t ui32Read;
+    uint32_t ui32Count;
+}
+tFIFO;
+
+//*****************************************************************************
+//
+// A simulated uDMA control structure.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Mode;
+    uint32_t ui32Count;
+    uint32_t ui32Control;
+    uint8_t *pui8Data;
+}
+tDMAStruct;
+
+//*****************************************************************************
+//
+// The state of the simulated UART: its FIFOs and their trigger levels, its
+// raw interrupt status and interrupt mask, the uDMA requests which it is
+// allowed to make, and the number of character times for which the receive
+// line has been idle.
+//
+//*****************************************************************************
+static tFIFO g_sTxFIFO;
+static tFIFO g_sRxFIFO;
+static uint32_t g_ui32TxLevel;
+static uint32_t g_ui32RxLevel;
+static uint32_t g_ui32IntRaw;
+static uint32_t g_ui32IntMask;
+static uint32_t g_ui32DMAFlags;
+static uint32_t g_ui32RxIdle;
+static uint32_t g_ui32RxOverruns;
+
+//*****************************************************************************
+//
+// The state of the simulated interrupt controller: whether the UART
+// interrupt is enabled, whether it has been pended by software or by the end
+// of a uDMA transfer, and the number of times the handler has been called.
+//
+//*****************************************************************************
+static bool g_bIntEnabled;
+static bool g_bIntPending;
+static uint32_t g_ui32Interrupts;
+
+//*****************************************************************************
+//
+// The state of the simulated uDMA controller: its control structures (the
+// alternate structure of each channel following the primary structures of
+// all 32 channels), and the channels which are enabled, use their alternate
+// control structure, and only respond to burst requests.
+//
+//*****************************************************************************
+static tDMAStruct g_psDMA[64];
+static uint32_t g_ui32DMAEnabled;
+static uint32_t g_ui32DMAAlt;
+static uint32_t g_ui32DMABurst;
+
+//*****************************************************************************
+//
+// The characters transmitted on the line, and the characters to be received
+// from it with the number of idle character times before each of them.
+//
+//*****************************************************************************
+static uint8_t *g_pui8Line;
+static uint32_t g_ui32LineLen;
+static const uint8_t *g_pui8Input;
+static const uint8_t *g_pui8InputGap;
+static uint32_t g_ui32InputLen;
+static uint32_t g_ui32InputPos;
+static uint32_t g_ui32InputWait;
+
+//*****************************************************************************
+//
+// The number of failed tests.
+//
+//*****************************************************************************
+static uint32_t g_ui32Failed;
+
+//*****************************************************************************
+//
+// The UART interrupt handler in utils/uartstdio.c.
+//
+//*****************************************************************************
+extern void UARTStdioIntHandler(void);
+
+//*****************************************************************************
+//
+// Adds a character to, or removes one from, a simulated FIFO.
+//
+//*****************************************************************************
+static void
+FIFOPut(tFIFO *psFIFO, uint8_t ui8Data)
+{
+    psFIFO->pui8Data[(psFIFO->ui32Read + psFIFO->ui32Count++) % FIFO_SIZE] =
+        ui8Data;
+}
+
+static uint8_t
+FIFOGet(tFIFO *psFIFO)
+{
+    uint8_t ui8Data;
+
+    ui8Data = psFIFO->pui8Data[psFIFO->ui32Read];
+    psFIFO->ui32Read = (psFIFO->ui32Read + 1) % FIFO_SIZE;
+    psFIFO->ui32Count--;
+
+    return(ui8Data);
+}
+
+//*****************************************************************************
+//
+// Stubs of the driver library functions called by utils/uartstdio.c, which
+// operate on the simulated hardware.
+//
+//*****************************************************************************
+bool
+SysCtlPeripheralPresent(uint32_t ui32Peripheral)
+{
+    return(true);
+}
+
+void
+SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+}
+
+void
+UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk,
+                    uint32_t ui32Baud, uint32_t ui32Config)
+{
+}
+
+void
+UARTEnable(uint32_t ui32Base)
+{
+}
+
+void
+UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel,
+                 uint32_t ui32RxLevel)
+{
+    static const uint8_t pui8Levels[5] = { 2, 4, 8, 12, 14 };
+
+    g_ui32TxLevel = pui8Levels[ui32TxLevel];
+    g_ui32RxLevel = pui8Levels[ui32RxLevel >> 3];
+}
+
+bool
+UARTSpaceAvail(uint32_t ui32Base)
+{
+    return(g_sTxFIFO.ui32Count < FIFO_SIZE);
+}
+
+bool
+UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData)
+{
+    if(g_sTxFIFO.ui32Count == FIFO_SIZE)
+    {
+        return(false);
+    }
+    FIFOPut(&g_sTxFIFO, ucData);
+    return(true);
+}
+
+bool
+UARTCharsAvail(uint32_t ui32Base)
+{
+    return(g_sRxFIFO.ui32Count != 0);
+}
+
+int32_t
+UARTCharGetNonBlocking(uint32_t ui32Base)
+{
+    return(g_sRxFIFO.ui32Count ? FIFOGet(&g_sRxFIFO) : -1);
+}
+
+void
+UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32IntMask |= ui32IntFlags;
+}
+
+void
+UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32IntMask &= ~ui32IntFlags;
+}
+
+uint32_t
+UARTIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    return(bMasked ? (g_ui32IntRaw & g_ui32IntMask) : g_ui32IntRaw);
+}
+
+void
+UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32IntRaw &= ~ui32IntFlags;
+}
+
+void
+UARTDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    g_ui32DMAFlags |= ui32DMAFlags;
+}
+
+void
+UARTDMADisable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    g_ui32DMAFlags &= ~ui32DMAFlags;
+}
+
+void
+IntEnable(uint32_t ui32Interrupt)
+{
+    g_bIntEnabled = true;
+}
+
+void
+IntDisable(uint32_t ui32Interrupt)
+{
+    g_bIntEnabled = false;
+}
+
+void
+IntPendSet(uint32_t ui32Interrupt)
+{
+    g_bIntPending = true;
+}
+
+bool
+IntMasterDisable(void)
+{
+    return(false);
+}
+
+bool
+IntMasterEnable(void)
+{
+    return(false);
+}
+
+void *
+uDMAControlBaseGet(void)
+{
+    return(g_psDMA);
+}
+
+void
+uDMAChannelAssign(uint32_t ui32Mapping)
+{
+}
+
+void
+uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    ui32ChannelNum &= 0x1f;
+    if(ui32Attr & UDMA_ATTR_ALTSELECT)
+    {
+        g_ui32DMAAlt |= 1 << ui32ChannelNum;
+    }
+    if(ui32Attr & UDMA_ATTR_USEBURST)
+    {
+        g_ui32DMABurst |= 1 << ui32ChannelNum;
+    }
+}
+
+void
+uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    ui32ChannelNum &= 0x1f;
+    if(ui32Attr & UDMA_ATTR_ALTSELECT)
+    {
+        g_ui32DMAAlt &= ~(1 << ui32ChannelNum);
+    }
+    if(ui32Attr & UDMA_ATTR_USEBURST)
+    {
+        g_ui32DMABurst &= ~(1 << ui32ChannelNum);
+    }
+}
+
+uint32_t
+uDMAChannelAttributeGet(uint32_t ui32ChannelNum)
+{
+    ui32ChannelNum &= 0x1f;
+    return(((g_ui32DMAAlt & (1 << ui32ChannelNum)) ?
+            UDMA_ATTR_ALTSELECT : 0) |
+           ((g_ui32DMABurst & (1 << ui32ChannelNum)) ?
+            UDMA_ATTR_USEBURST : 0));
+}
+
+void
+uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    g_psDMA[ui32ChannelStructIndex & 0x3f].ui32Control = ui32Control;
+}
+
+void
+uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                       void *pvSrcAddr, void *pvDstAddr,
+                       uint32_t ui32TransferSize)
+{
+    tDMAStruct *psStruct;
+
+    //
+    // Only transfers between the UART data register and memory are used, so
+    // only the address in memory is kept.
+    //
+    psStruct = &g_psDMA[ui32ChannelStructIndex & 0x3f];
+    psStruct->ui32Mode = ui32Mode;
+    psStruct->ui32Count = ui32TransferSize;
+    psStruct->pui8Data = ((psStruct->ui32Control & UDMA_DST_INC_NONE) ==
+                          UDMA_DST_INC_NONE) ? pvSrcAddr : pvDstAddr;
+}
+
+uint32_t
+uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    return(g_psDMA[ui32ChannelStructIndex & 0x3f].ui32Mode);
+}
+
+uint32_t
+uDMAChannelSizeGet(uint32_t ui32ChannelStructIndex)
+{
+    tDMAStruct *psStruct;
+
+    psStruct = &g_psDMA[ui32ChannelStructIndex & 0x3f];
+    return((psStruct->ui32Mode == UDMA_MODE_STOP) ? 0 : psStruct->ui32Count);
+}
+
+bool
+uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    return((g_ui32DMAEnabled & (1 << (ui32ChannelNum & 0x1f))) ? true : false);
+}
+
+void
+uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    g_ui32DMAEnabled |= 1 << (ui32ChannelNum & 0x1f);
+}
+
+//*****************************************************************************
+//
+// Performs one arbitration cycle of a simulated uDMA channel, given whether
+// the UART is making a single request or a burst request, transferring a
+// character to or from the given FIFO.  When a transfer finishes, the
+// controller interrupts, and in ping-pong mode moves on to the other control
+// structure, stopping if it is not in use.  Returns false if no characters
+// were transferred.
+//
+//*****************************************************************************
+static bool
+DMAChannelRun(uint32_t ui32Channel, tFIFO *psFIFO, bool bTx, bool bSingle,
+              bool bBurst)
+{
+    tDMAStruct *psStruct;
+    uint32_t ui32Count, ui32Moved, ui32Bit, ui32Mode;
+
+    //
+    // See if the channel is enabled, and is being asked for a transfer that
+    // it responds to.
+    //
+    ui32Bit = 1 << ui32Channel;
+    if(!(g_ui32DMAEnabled & ui32Bit) ||
+       !(bBurst || (bSingle && !(g_ui32DMABurst & ui32Bit))))
+    {
+        return(false);
+    }
+
+    //
+    // A channel whose control structure is not in use stops.
+    //
+    psStruct = &g_psDMA[ui32Channel | ((g_ui32DMAAlt & ui32Bit) ? 32 : 0)];
+    if(psStruct->ui32Mode == UDMA_MODE_STOP)
+    {
+        g_ui32DMAEnabled &= ~ui32Bit;
+        return(false);
+    }
+
+    //
+    // Transfer up to the arbitration size for a burst request, or a single
+    // character, as far as the FIFO allows.
+    //
+    ui32Count = bBurst ? (1 << ((psStruct->ui32Control >> 14) & 0xf)) : 1;
+    if(ui32Count > psStruct->ui32Count)
+    {
+        ui32Count = psStruct->ui32Count;
+    }
+    for(ui32Moved = 0; ui32Moved < ui32Count; ui32Moved++)
+    {
+        if(bTx)
+        {
+            if(psFIFO->ui32Count == FIFO_SIZE)
+            {
+                break;
+            }
+            FIFOPut(psFIFO, *psStruct->pui8Data++);
+        }
+        else
+        {
+            if(psFIFO->ui32Count == 0)
+            {
+                break;
+            }
+            *psStruct->pui8Data++ = FIFOGet(psFIFO);
+        }
+        psStruct->ui32Count--;
+    }
+
+    //
+    // Handle the end of the transfer.
+    //
+    if(psStruct->ui32Count == 0)
+    {
+        g_bIntPending = true;
+        ui32Mode = psStruct->ui32Mode;
+        psStruct->ui32Mode = UDMA_MODE_STOP;
+        if(ui32Mode == UDMA_MODE_PINGPONG)
+        {
+            g_ui32DMAAlt ^= ui32Bit;
+            if(g_psDMA[ui32Channel |
+                       ((g_ui32DMAAlt & ui32Bit) ? 32 : 0)].ui32Mode ==
+               UDMA_MODE_STOP)
+            {
+                g_ui32DMAEnabled &= ~ui32Bit;
+            }
+        }
+        else
+        {
+            g_ui32DMAEnabled &= ~ui32Bit;
+        }
+    }
+
+    return(ui32Moved ? true : false);
+}
+
+//*****************************************************************************
+//
+// Lets the simulated uDMA controller make the transfers requested by the
+// UART, and calls the interrupt handler whenever the interrupt is raised,
+// until there is nothing more to do.
+//
+//*****************************************************************************
+static void
+Service(void)
+{
+    bool bBusy;
+
+    do
+    {
+        bBusy = false;
+        while((g_ui32DMAFlags & UART_DMA_TX) &&
+              DMAChannelRun(TX_CHANNEL, &g_sTxFIFO, true,
+                            g_sTxFIFO.ui32Count < FIFO_SIZE,
+                            g_sTxFIFO.ui32Count <= g_ui32TxLevel))
+        {
+        }
+        while((g_ui32DMAFlags & UART_DMA_RX) &&
+              DMAChannelRun(RX_CHANNEL, &g_sRxFIFO, false,
+                            g_sRxFIFO.ui32Count != 0,
+                            g_sRxFIFO.ui32Count >= g_ui32RxLevel))
+        {
+        }
+        if(g_bIntEnabled && (g_bIntPending || (g_ui32IntRaw & g_ui32IntMask)))
+        {
+            g_bIntPending = false;
+            g_ui32Interrupts++;
+            UARTStdioIntHandler();
+            bBusy = true;
+        }
+    }
+    while(bBusy);
+}
+
+//*****************************************************************************
+//
+// Advances the simulation by one character time, in which the UART transmits
+// a character from its TX FIFO, and receives the next character of the input
+// once the line has been idle for long enough before it.
+//
+//*****************************************************************************
+static uint32_t g_ui32Steps;
+
+static void
+Step(void)
+{
+    //
+    // Transmit a character, interrupting when the TX FIFO falls to its
+    // trigger level.
+    //
+    if(g_sTxFIFO.ui32Count)
+    {
+        g_pui8Line[g_ui32LineLen++] = FIFOGet(&g_sTxFIFO);
+        if(g_sTxFIFO.ui32Count == g_ui32TxLevel)
+        {
+            g_ui32IntRaw |= UART_INT_TX;
+        }
+    }
+
+    //
+    // Receive a character, interrupting when the RX FIFO rises to its
+    // trigger level, or when it is not empty and the line has been idle for
+    // long enough.
+    //
+    if((g_ui32InputPos < g_ui32InputLen) &&
+       (g_ui32InputWait++ >= g_pui8InputGap[g_ui32InputPos]))
+    {
+        if(g_sRxFIFO.ui32Count == FIFO_SIZE)
+        {
+            g_ui32RxOverruns++;
+        }
+        else
+        {
+            FIFOPut(&g_sRxFIFO, g_pui8Input[g_ui32InputPos]);
+            if(g_sRxFIFO.ui32Count == g_ui32RxLevel)
+            {
+                g_ui32IntRaw |= UART_INT_RX;
+            }
+        }
+        g_ui32InputPos++;
+        g_ui32InputWait = 0;
+        g_ui32RxIdle = 0;
+    }
+    else if((++g_ui32RxIdle >= RX_TIMEOUT) && g_sRxFIFO.ui32Count)
+    {
+        g_ui32IntRaw |= UART_INT_RT;
+    }
+
+    g_ui32Steps++;
+    Service();
+}
+
+//*****************************************************************************
+//
+// Sets the characters to be received, with the number of idle character
+// times before each of them.
+//
+//*****************************************************************************
+static void
+InputSet(const uint8_t *pui8Input, const uint8_t *pui8Gap, uint32_t ui32Len)
+{
+    g_pui8Input = pui8Input;
+    g_pui8InputGap = pui8Gap;
+    g_ui32InputLen = ui32Len;
+    g_ui32InputPos = 0;
+    g_ui32InputWait = 0;
+}
+
+//*****************************************************************************
+//
+// Starts a test, and reports its result along with the number of interrupts
+// taken for each kilobyte of data moved.
+//
+//*****************************************************************************
+static void
+TestStart(void)
+{
+    g_ui32Interrupts = 0;
+    g_ui32Steps = 0;
+    g_ui32LineLen = 0;
+    g_ui32RxOverruns = 0;
+}
+
+static void
+TestEnd(const char *pcName, uint32_t ui32Bytes, bool bPassed)
+{
+    printf("%-6s %-16s %8u %10u %10.1f %9.1f%%\n", bPassed ? "ok" : "FAILED",
+           pcName, ui32Bytes, g_ui32Interrupts,
+           (g_ui32Interrupts * 1024.0) / ui32Bytes,
+           (ui32Bytes * 100.0) / g_ui32Steps);
+    if(!bPassed)
+    {
+        g_ui32Failed++;
+    }
+}
+
+//*****************************************************************************
+//
+// Transmits a stream of text with UARTwrite(), filling the transmit buffer
+// each time that it is half empty, and checks that it is transmitted intact.
+//
+//*****************************************************************************
+static void
+TransmitTest(uint32_t ui32Bytes)
+{
+    uint32_t ui32Idx, ui32Sent, ui32Len;
+    uint8_t *pui8Data;
+
+    pui8Data = malloc(ui32Bytes);
+    for(ui32Idx = 0; ui32Idx < ui32Bytes; ui32Idx++)
+    {
+        pui8Data[ui32Idx] = ' ' + (rand() % 95);
+    }
+
+    TestStart();
+    for(ui32Sent = 0; (ui32Sent < ui32Bytes) ||
+        (UARTTxBytesFree() != UART_TX_BUFFER_SIZE); )
+    {
+        if(UARTTxBytesFree() >= (UART_TX_BUFFER_SIZE / 2))
+        {
+            ui32Len = ui32Bytes - ui32Sent;
+            ui32Sent += UARTwrite((const char *)pui8Data + ui32Sent, ui32Len);
+        }
+        Step();
+        if(g_ui32Steps > (ui32Bytes * 2))
+        {
+            break;
+        }
+    }
+    while(g_sTxFIFO.ui32Count)
+    {
+        Step();
+    }
+    TestEnd("transmit", ui32Bytes,
+            (g_ui32LineLen == ui32Bytes) &&
+            (memcmp(g_pui8Line, pui8Data, ui32Bytes) == 0));
+
+    free(pui8Data);
+}
+
+//*****************************************************************************
+//
+// Receives a stream of binary data with echo disabled, either continuously
+// or in bursts separated by idle times of random lengths, reading it with
+// UARTgetc() as it arrives, and checks that it is received intact.
+//
+//*****************************************************************************
+static void
+ReceiveTest(uint32_t ui32Bytes, bool bBursts)
+{
+    uint32_t ui32Idx, ui32Burst, ui32Received;
+    uint8_t *pui8Data, *pui8Gap;
+    bool bPassed;
+
+    pui8Data = malloc(ui32Bytes);
+    pui8Gap = calloc(ui32Bytes, 1);
+    for(ui32Idx = ui32Burst = 0; ui32Idx < ui32Bytes; ui32Idx++)
+    {
+        pui8Data[ui32Idx] = rand();
+        if(bBursts && (ui32Burst-- == 0))
+        {
+            ui32Burst = rand() % 256;
+            pui8Gap[ui32Idx] = rand() % 64;
+        }
+    }
+
+    UARTEchoSet(false);
+    InputSet(pui8Data, pui8Gap, ui32Bytes);
+    TestStart();
+    bPassed = true;
+    for(ui32Received = 0; ui32Received < ui32Bytes; )
+    {
+        Step();
+        while(UARTRxBytesAvail() && (ui32Received < ui32Bytes))
+        {
+            if(UARTgetc() != pui8Data[ui32Received++])
+            {
+                bPassed = false;
+            }
+        }
+        if(g_ui32Steps > (ui32Bytes * 64))
+        {
+            break;
+        }
+    }
+    TestEnd(bBursts ? "receive bursts" : "receive", ui32Bytes,
+            bPassed && (ui32Received == ui32Bytes) && !UARTRxBytesAvail() &&
+            !g_ui32RxOverruns);
+    UARTEchoSet(true);
+
+    free(pui8Data);
+    free(pui8Gap);
+}
+
+//*****************************************************************************
+//
+// Types a line with a correction in it, and checks the line read by
+// UARTgets() and the characters echoed back.
+//
+//*****************************************************************************
+static void
+EchoTest(void)
+{
+    static const uint8_t pui8Typed[] = "helo\bp\r\n";
+    static const uint8_t pui8Gap[sizeof(pui8Typed)];
+    static const char pcEcho[] = "helo\b \bp\r\n\r";
+    char pcLine[16];
+    uint32_t ui32Idx;
+
+    InputSet(pui8Typed, pui8Gap, sizeof(pui8Typed) - 1);
+    TestStart();
+    for(ui32Idx = 0; ui32Idx < 64; ui32Idx++)
+    {
+        Step();
+    }
+    UARTgets(pcLine, sizeof(pcLine));
+    TestEnd("echo", sizeof(pui8Typed) - 1,
+            (strcmp(pcLine, "help") == 0) && !UARTRxBytesAvail() &&
+            (g_ui32LineLen == (sizeof(pcEcho) - 1)) &&
+            (memcmp(g_pui8Line, pcEcho, g_ui32LineLen) == 0));
+}
+
+//*****************************************************************************
+//
+// Writes a mixture of text and deferred log records, and checks that each
+// record is transmitted whole, between the characters of the text, and that
+// the text and records are transmitted intact and in order.
+//
+//*****************************************************************************
+static void
+LogTest(uint32_t ui32Bytes)
+{
+    static const char *pcFormat = "record %u %s";
+    uint32_t ui32Idx, ui32Text, ui32Record, ui32Value, ui32Len;
+    char *pcText, pcBuf[32];
+    uint8_t ui8Sum;
+    bool bPassed;
+
+    //
+    // Write lines of text and records in a random order, giving each time
+    // to be sent before the next so that the buffers do not overflow.
+    //
+    pcText = malloc(ui32Bytes + 32);
+    ui32Text = ui32Record = 0;
+    TestStart();
+    for(ui32Idx = 0; ui32Text < ui32Bytes; ui32Idx++)
+    {
+        if(rand() & 1)
+        {
+            ui32Len = snprintf(pcBuf, sizeof(pcBuf), "line %u\n", ui32Idx);
+            UARTwrite(pcBuf, ui32Len);
+            memcpy(pcText + ui32Text, pcBuf, ui32Len);
+            ui32Text += ui32Len;
+        }
+        else
+        {
+            UARTlog(pcFormat, ui32Idx, "abc");
+        }
+        for(ui32Len = rand() % 32; ui32Len; ui32Len--)
+        {
+            Step();
+        }
+    }
+    while((UARTTxBytesFree() != UART_TX_BUFFER_SIZE) || UARTLogDrain() ||
+          g_sTxFIFO.ui32Count)
+    {
+        Step();
+    }
+
+    //
+    // Separate the records from the text, checking each of them.
+    //
+    bPassed = (UARTLogDropped() == 0);
+    for(ui32Idx = ui32Value = 0; ui32Idx < g_ui32LineLen; )
+    {
+        if(g_pui8Line[ui32Idx] != UART_LOG_SYNC)
+        {
+            if(g_pui8Line[ui32Idx] != '\r')
+            {
+                bPassed &= ((ui32Value < ui32Text) &&
+                            (g_pui8Line[ui32Idx] == pcText[ui32Value++]));
+            }
+            ui32Idx++;
+            continue;
+        }
+        ui32Len = g_pui8Line[ui32Idx + UART_LOG_O_LENGTH];
+        for(ui32Record = 1, ui8Sum = 0; ui32Record < ui32Len; ui32Record++)
+        {
+            ui8Sum += g_pui8Line[ui32Idx + ui32Record];
+        }
+        bPassed &= ((ui8Sum == 0) &&
+                    (memcmp(g_pui8Line + ui32Idx + UART_LOG_O_FORMAT,
+                            &pcFormat, 4) == 0));
+        ui32Idx += ui32Len;
+    }
+    TestEnd("log", g_ui32LineLen, bPassed && (ui32Value == ui32Text));
+
+    free(pcText);
+}
+
+//*****************************************************************************
+//
+// Prints the usage of the program.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    printf("Usage: %s [OPTION]...\n", pcProgram);
+    printf("Simulates the buffered UART console, counting its "
+           "interrupts.\n\n");
+    printf("  -n BYTES Move BYTES bytes in each test (default %u)\n",
+           DEFAULT_BYTES);
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    uint32_t ui32Bytes;
+    int iOpt;
+
+    ui32Bytes = DEFAULT_BYTES;
+
+    while((iOpt = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'n':
+            {
+                ui32Bytes = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+    if(ui32Bytes == 0)
+    {
+        Usage(argv[0]);
+        return(1);
+    }
+
+    //
+    // Set up the console on the simulated UART, with room to capture all
+    // that it transmits.
+    //
+    g_pui8Line = malloc((ui32Bytes * 4) + 4096);
+    UARTStdioConfig(0, 921600, 80000000);
+    srand(1);
+
+#ifdef UART_DMA
+    printf("uDMA mode\n");
+#else
+    printf("FIFO mode\n");
+#endif
+    printf("%-6s %-16s %8s %10s %10s %10s\n", "", "test", "bytes",
+           "interrupts", "per KB", "line use");
+    TransmitTest(ui32Bytes);
+    ReceiveTest(ui32Bytes, false);
+    ReceiveTest(ui32Bytes, true);
+    EchoTest();
+    LogTest(ui32Bytes);
+
+    free(g_pui8Line);
+    return(g_ui32Failed ? 1 : 0);
+}
@@ -0,0 +1,395 @@
+//*****************************************************************************
+//
+// logdecode.c - Decoder for the deferred UART log records.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "utils/uartstdio.h"
+#include "logdecode.h"
+
+//*****************************************************************************
+//
+// A mapping from an integer between 0 and 15 to its ASCII character
+// equivalent.
+//
+//*****************************************************************************
+static const char * const g_pcHex = "0123456789abcdef";
+
+//*****************************************************************************
+//
+// Returns a 32-bit value stored least significant byte first.
+//
+//*****************************************************************************
+static uint32_t
+LogWordGet(const uint8_t *pui8Data)
+{
+    return((uint32_t)pui8Data[0] | ((uint32_t)pui8Data[1] << 8) |
+           ((uint32_t)pui8Data[2] << 16) | ((uint32_t)pui8Data[3] << 24));
+}
+
+//*****************************************************************************
+//
+// Writes the text of a log record, formatting its arguments in exactly the
+// same way as UARTvprintf() in utils/uartstdio.c.  If the record runs out of
+// arguments (because they did not fit in it), "..." is written and the rest
+// of the format string is ignored.
+//
+//*****************************************************************************
+static void
+LogFormat(FILE *psOut, const char *pcString, const uint8_t *pui8Args,
+          uint32_t ui32Len)
+{
+    uint32_t ui32Idx, ui32Value, ui32Pos, ui32Count, ui32Base, ui32Neg;
+    char pcBuf[16], cFill;
+
+    while(*pcString)
+    {
+        //
+        // Write the characters up to the next %, or the end of the string.
+        //
+        for(ui32Idx = 0;
+            (pcString[ui32Idx] != '%') && (pcString[ui32Idx] != '\0');
+            ui32Idx++)
+        {
+        }
+        fwrite(pcString, 1, ui32Idx, psOut);
+        pcString += ui32Idx;
+        if(*pcString != '%')
+        {
+            break;
+        }
+        pcString++;
+
+        //
+        // Find the digit count and the fill character.
+        //
+        ui32Count = 0;
+        cFill = ' ';
+        while((*pcString >= '0') && (*pcString <= '9'))
+        {
+            if((*pcString == '0') && (ui32Count == 0))
+            {
+                cFill = '0';
+            }
+            ui32Count = (ui32Count * 10) + (*pcString++ - '0');
+        }
+
+        //
+        // Handle the %% command, and those which take no argument.
+        //
+        if(*pcString == '%')
+        {
+            fputc('%', psOut);
+            pcString++;
+            continue;
+        }
+        if(!strchr("cdiuxXps", *pcString) || (*pcString == '\0'))
+        {
+            fputs("ERROR", psOut);
+            if(*pcString++ == '\0')
+            {
+                break;
+            }
+            continue;
+        }
+
+        //
+        // Stop if the argument is not in the record.
+        //
+        if((ui32Len < ((*pcString == 's') ? 1 : 4)) ||
+           ((*pcString == 's') && (ui32Len < (1 + (uint32_t)pui8Args[0]))))
+        {
+            fputs("...", psOut);
+            break;
+        }
+
+        //
+        // Handle the %s command, which pads the string after it.
+        //
+        if(*pcString == 's')
+        {
+            ui32Idx = pui8Args[0];
+            fwrite(pui8Args + 1, 1, ui32Idx, psOut);
+            for(; ui32Count > ui32Idx; ui32Count--)
+            {
+                fputc(' ', psOut);
+            }
+            pui8Args += ui32Idx + 1;
+            ui32Len -= ui32Idx + 1;
+            pcString++;
+            continue;
+        }
+
+        //
+        // Get the value of the remaining commands.
+        //
+        ui32Value = LogWordGet(pui8Args);
+        pui8Args += 4;
+        ui32Len -= 4;
+        ui32Pos = 0;
+        ui32Neg = 0;
+        ui32Base = 16;
+        switch(*pcString++)
+        {
+            case 'c':
+            {
+                fputc(ui32Value & 0xFF, psOut);
+                continue;
+            }
+
+            case 'd':
+            case 'i':
+            {
+                if((int32_t)ui32Value < 0)
+                {
+                    ui32Value = 0 - ui32Value;
+                    ui32Neg = 1;
+                }
+                ui32Base = 10;
+                break;
+            }
+
+            case 'u':
+            {
+                ui32Base = 10;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        //
+        // Convert the value, with the same padding as UARTvprintf().
+        //
+        for(ui32Idx = 1;
+            (((ui32Idx * ui32Base) <= ui32Value) &&
+             (((ui32Idx * ui32Base) / ui32Base) == ui32Idx));
+            ui32Idx *= ui32Base, ui32Count--)
+        {
+        }
+        if(ui32Neg)
+        {
+            ui32Count--;
+        }
+        if(ui32Neg && (cFill == '0'))
+        {
+            pcBuf[ui32Pos++] = '-';
+            ui32Neg = 0;
+        }
+        if((ui32Count > 1) && (ui32Count < 16))
+        {
+            for(ui32Count--; ui32Count; ui32Count--)
+            {
+                pcBuf[ui32Pos++] = cFill;
+            }
+        }
+        if(ui32Neg)
+        {
+            pcBuf[ui32Pos++] = '-';
+        }
+        for(; ui32Idx; ui32Idx /= ui32Base)
+        {
+            pcBuf[ui32Pos++] = g_pcHex[(ui32Value / ui32Idx) % ui32Base];
+        }
+        fwrite(pcBuf, 1, ui32Pos, psOut);
+    }
+}
+
+//*****************************************************************************
+//
+// Writes the text of a complete, valid log record.
+//
+//*****************************************************************************
+static void
+LogRecord(tLogDecoder *psDecoder)
+{
+    const char *pcFormat;
+    uint32_t ui32Addr, ui32Time;
+
+    //
+    // Find the format string.
+    //
+    ui32Addr = LogWordGet(psDecoder->pui8Record + UART_LOG_O_FORMAT);
+    ui32Time = LogWordGet(psDecoder->pui8Record + UART_LOG_O_TIMESTAMP);
+    pcFormat = psDecoder->pfnLookup(psDecoder->pvLookupData, ui32Addr);
+
+    //
+    // Write the timestamp.
+    //
+    if(psDecoder->bTimestamps)
+    {
+        if(psDecoder->dTimestampHz > 0)
+        {
+            fprintf(psDecoder->psOut, "[%12.6f] ",
+                    ui32Time / psDecoder->dTimestampHz);
+        }
+        else
+        {
+            fprintf(psDecoder->psOut, "[%10u] ", ui32Time);
+        }
+    }
+
+    //
+    // Write the text, or a note if the format string could not be found
+    // (which usually means that the image does not match the firmware).
+    //
+    if(pcFormat)
+    {
+        LogFormat(psDecoder->psOut, pcFormat,
+                  psDecoder->pui8Record + UART_LOG_O_ARGS,
+                  psDecoder->ui32Len - UART_LOG_O_ARGS - 1);
+        psDecoder->ui32Records++;
+    }
+    else
+    {
+        fprintf(psDecoder->psOut, "<no format string at 0x%08x>\n",
+                ui32Addr);
+        psDecoder->ui32Unknown++;
+    }
+}
+
+//*****************************************************************************
+//
+// Discards the sync byte of the bytes received so far, which are not a valid
+// record, and decodes the remaining bytes again as text and records.
+//
+//*****************************************************************************
+static void
+LogReject(tLogDecoder *psDecoder)
+{
+    uint8_t pui8Bytes[256];
+    uint32_t ui32Len, ui32Idx;
+
+    psDecoder->ui32Corrupt++;
+    ui32Len = psDecoder->ui32Len - 1;
+    memcpy(pui8Bytes, psDecoder->pui8Record + 1, ui32Len);
+    psDecoder->ui32Len = 0;
+    for(ui32Idx = 0; ui32Idx < ui32Len; ui32Idx++)
+    {
+        LogDecodeByte(psDecoder, pui8Bytes[ui32Idx]);
+    }
+}
+
+//*****************************************************************************
+//
+// Initializes a decoder.
+//
+//*****************************************************************************
+void
+LogDecodeInit(tLogDecoder *psDecoder, tLogFormatLookup pfnLookup,
+              void *pvLookupData, FILE *psOut)
+{
+    memset(psDecoder, 0, sizeof(*psDecoder));
+    psDecoder->pfnLookup = pfnLookup;
+    psDecoder->pvLookupData = pvLookupData;
+    psDecoder->psOut = psOut;
+    psDecoder->bTimestamps = true;
+}
+
+//*****************************************************************************
+//
+// Decodes the next byte received from the UART.  Text is written as it is,
+// without the carriage returns added by the UART output functions, and each
+// record is written as its formatted text once all of it is received and its
+// checksum is verified.
+//
+//*****************************************************************************
+void
+LogDecodeByte(tLogDecoder *psDecoder, uint8_t ui8Byte)
+{
+    uint32_t ui32Idx;
+    uint8_t ui8Sum;
+
+    //
+    // Outside a record, write the text and look for the start of a record.
+    //
+    if(psDecoder->ui32Len == 0)
+    {
+        if(ui8Byte == UART_LOG_SYNC)
+        {
+            psDecoder->pui8Record[psDecoder->ui32Len++] = ui8Byte;
+        }
+        else if(ui8Byte != '\r')
+        {
+            fputc(ui8Byte, psDecoder->psOut);
+        }
+        return;
+    }
+
+    //
+    // Add the byte to the record, checking that the length is possible.
+    //
+    psDecoder->pui8Record[psDecoder->ui32Len++] = ui8Byte;
+    if(psDecoder->ui32Len <= UART_LOG_O_LENGTH)
+    {
+        return;
+    }
+    if(psDecoder->pui8Record[UART_LOG_O_LENGTH] < (UART_LOG_O_ARGS + 1))
+    {
+        LogReject(psDecoder);
+        return;
+    }
+    if(psDecoder->ui32Len < psDecoder->pui8Record[UART_LOG_O_LENGTH])
+    {
+        return;
+    }
+
+    //
+    // The record is complete, so write it if the checksum is correct.
+    //
+    for(ui32Idx = UART_LOG_O_LENGTH, ui8Sum = 0; ui32Idx < psDecoder->ui32Len;
+        ui32Idx++)
+    {
+        ui8Sum += psDecoder->pui8Record[ui32Idx];
+    }
+    if(ui8Sum == 0)
+    {
+        LogRecord(psDecoder);
+        psDecoder->ui32Len = 0;
+    }
+    else
+    {
+        LogReject(psDecoder);
+    }
+}
+
+//*****************************************************************************
+//
+// Finishes decoding, writing any incomplete record at the end of the input
+// as text.
+//
+//*****************************************************************************
+void
+LogDecodeEnd(tLogDecoder *psDecoder)
+{
+    while(psDecoder->ui32Len)
+    {
+        LogReject(psDecoder);
+    }
+    fflush(psDecoder->psOut);
+}
@@ -0,0 +1,87 @@
+//*****************************************************************************
+//
+// logdecode.h - Definitions for the deferred UART log decoder.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#ifndef __LOGDECODE_H__
+#define __LOGDECODE_H__
+
+//*****************************************************************************
+//
+// The function which finds the format string at an address in the firmware
+// image, returning 0 if there is no string there.
+//
+//*****************************************************************************
+typedef const char *(* tLogFormatLookup)(void *pvData, uint32_t ui32Addr);
+
+//*****************************************************************************
+//
+// The state of the decoder of a stream of text and log records.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The function which finds format strings, and its data pointer.
+    //
+    tLogFormatLookup pfnLookup;
+    void *pvLookupData;
+
+    //
+    // The file to which the decoded text is written.
+    //
+    FILE *psOut;
+
+    //
+    // The frequency of the timestamps, or zero to print them as given, and
+    // whether they are printed at all.
+    //
+    double dTimestampHz;
+    bool bTimestamps;
+
+    //
+    // The bytes of the record being received, and how many there are.
+    //
+    uint8_t pui8Record[256];
+    uint32_t ui32Len;
+
+    //
+    // The number of records decoded, and the number which were discarded
+    // because they were corrupt or their format string could not be found.
+    //
+    uint32_t ui32Records;
+    uint32_t ui32Corrupt;
+    uint32_t ui32Unknown;
+}
+tLogDecoder;
+
+//*****************************************************************************
+//
+// Prototypes for the decoder.
+//
+//*****************************************************************************
+extern void LogDecodeInit(tLogDecoder *psDecoder, tLogFormatLookup pfnLookup,
+                          void *pvLookupData, FILE *psOut);
+extern void LogDecodeByte(tLogDecoder *psDecoder, uint8_t ui8Byte);
+extern void LogDecodeEnd(tLogDecoder *psDecoder);
+
+#endif // __LOGDECODE_H__
@@ -0,0 +1,576 @@
+//*****************************************************************************
+//
+// logtest.c - Host-side test of the deferred UART log.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "utils/uartstdio.h"
+#include "logdecode.h"
+
+//*****************************************************************************
+//
+// This program links utils/uartstdio.c, built with UART_DEFERRED_LOG, with
+// stubs of the driver library functions which it calls, so that its output
+// can be captured on the host.  Each test writes the same text with
+// UARTprintf() and with UARTlog(), and checks that the decoder expands the
+// log records into exactly the text that UARTprintf() wrote.  Further tests
+// cover the timestamps, records which are too long, a full log buffer, and
+// corruption of the records.
+//
+// It is built twice: once with utils/uartstdio.c in unbuffered mode, where
+// UARTLogDrain() sends the records, and once in buffered mode, where the
+// stubs simulate the transmit FIFO and interrupt of the UART so that the
+// records are sent by UARTStdioIntHandler().
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The output written to the UART.
+//
+//*****************************************************************************
+static uint8_t g_pui8Output[65536];
+static uint32_t g_ui32OutputLen;
+
+//*****************************************************************************
+//
+// The format string of the last record, which is the one the decoder is
+// asked to find, and the number of failed tests.
+//
+//*****************************************************************************
+static const char *g_pcFormat;
+static uint32_t g_ui32Failed;
+
+//*****************************************************************************
+//
+// Stubs of the driver library functions called by utils/uartstdio.c.
+//
+//*****************************************************************************
+bool
+SysCtlPeripheralPresent(uint32_t ui32Peripheral)
+{
+    return(true);
+}
+
+void
+SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+}
+
+void
+UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk,
+                    uint32_t ui32Baud, uint32_t ui32Config)
+{
+}
+
+void
+UARTEnable(uint32_t ui32Base)
+{
+}
+
+void
+UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    if(g_ui32OutputLen < sizeof(g_pui8Output))
+    {
+        g_pui8Output[g_ui32OutputLen++] = ucData;
+    }
+}
+
+int32_t
+UARTCharGet(uint32_t ui32Base)
+{
+    return('\r');
+}
+
+bool
+IntMasterDisable(void)
+{
+    return(false);
+}
+
+bool
+IntMasterEnable(void)
+{
+    return(false);
+}
+
+#ifdef UART_BUFFERED
+//*****************************************************************************
+//
+// The simulated UART transmit FIFO, which holds the number of bytes given
+// here and raises the transmit interrupt when its level falls to an eighth
+// of that.  When g_bFifoDrains is set, the UART transmits a byte each time
+// the FIFO is found to be full, so that there is space again by the next
+// time it is checked.
+//
+//*****************************************************************************
+#define FIFO_SIZE               16
+static uint32_t g_ui32FifoLevel;
+static bool g_bFifoDrains;
+static uint32_t g_ui32IntEnabled;
+static uint32_t g_ui32IntRaw;
+static bool g_bIntPending;
+
+//*****************************************************************************
+//
+// The UART interrupt handler in utils/uartstdio.c.
+//
+//*****************************************************************************
+extern void UARTStdioIntHandler(void);
+
+//*****************************************************************************
+//
+// Stubs of the driver library functions called by utils/uartstdio.c in
+// buffered mode.
+//
+//*****************************************************************************
+bool
+UARTSpaceAvail(uint32_t ui32Base)
+{
+    if(g_ui32FifoLevel < FIFO_SIZE)
+    {
+        return(true);
+    }
+    if(g_bFifoDrains)
+    {
+        g_ui32FifoLevel--;
+    }
+    return(false);
+}
+
+bool
+UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData)
+{
+    UARTCharPut(ui32Base, ucData);
+    g_ui32FifoLevel++;
+    return(true);
+}
+
+bool
+UARTCharsAvail(uint32_t ui32Base)
+{
+    return(false);
+}
+
+int32_t
+UARTCharGetNonBlocking(uint32_t ui32Base)
+{
+    return(-1);
+}
+
+void
+UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel,
+                 uint32_t ui32RxLevel)
+{
+}
+
+void
+UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32IntEnabled |= ui32IntFlags;
+}
+
+void
+UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32IntEnabled &= ~ui32IntFlags;
+}
+
+uint32_t
+UARTIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    return(bMasked ? (g_ui32IntRaw & g_ui32IntEnabled) : g_ui32IntRaw);
+}
+
+void
+UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32IntRaw &= ~ui32IntFlags;
+}
+
+void
+IntEnable(uint32_t ui32Interrupt)
+{
+}
+
+void
+IntDisable(uint32_t ui32Interrupt)
+{
+}
+
+void
+IntPendSet(uint32_t ui32Interrupt)
+{
+    g_bIntPending = true;
+}
+
+//*****************************************************************************
+//
+// Runs the simulated UART, transmitting the bytes in its FIFO and calling
+// the interrupt handler when the interrupt is pended or the transmit
+// interrupt is raised, until the given number of bytes have been
+// transmitted or there is nothing left to do.
+//
+//*****************************************************************************
+static void
+UARTRun(uint32_t ui32Bytes)
+{
+    while(1)
+    {
+        if(g_bIntPending || (g_ui32IntRaw & g_ui32IntEnabled))
+        {
+            g_bIntPending = false;
+            UARTStdioIntHandler();
+        }
+        else if(g_ui32FifoLevel && ui32Bytes)
+        {
+            if(g_ui32FifoLevel-- == ((FIFO_SIZE / 8) + 1))
+            {
+                g_ui32IntRaw |= UART_INT_TX;
+            }
+            ui32Bytes--;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+#endif
+
+//*****************************************************************************
+//
+// Sends all the text and log records which are waiting.
+//
+//*****************************************************************************
+static void
+Flush(void)
+{
+    UARTLogDrain();
+#ifdef UART_BUFFERED
+    UARTRun(0xFFFFFFFF);
+#endif
+}
+
+//*****************************************************************************
+//
+// The timestamp source given to UARTLogTimestampSet().
+//
+//*****************************************************************************
+static uint32_t g_ui32Time;
+
+static uint32_t
+TimestampGet(void)
+{
+    return(g_ui32Time);
+}
+
+//*****************************************************************************
+//
+// Finds the format string of the last record.  On the host, only the lower
+// 32 bits of its address are in the record.
+//
+//*****************************************************************************
+static const char *
+FormatLookup(void *pvData, uint32_t ui32Addr)
+{
+    if(g_pcFormat && ((uint32_t)(uintptr_t)g_pcFormat == ui32Addr))
+    {
+        return(g_pcFormat);
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Decodes the captured output, returning the text (and optionally its size)
+// in a buffer which must be freed by the caller.
+//
+//*****************************************************************************
+static char *
+Decode(bool bTimestamps, double dHz, tLogDecoder *psDecoder, size_t *pnSize)
+{
+    tLogDecoder sDecoder;
+    uint32_t ui32Idx;
+    size_t nSize;
+    char *pcText;
+    FILE *psOut;
+
+    if(!psDecoder)
+    {
+        psDecoder = &sDecoder;
+    }
+    psOut = open_memstream(&pcText, &nSize);
+    LogDecodeInit(psDecoder, FormatLookup, 0, psOut);
+    psDecoder->bTimestamps = bTimestamps;
+    psDecoder->dTimestampHz = dHz;
+    for(ui32Idx = 0; ui32Idx < g_ui32OutputLen; ui32Idx++)
+    {
+        LogDecodeByte(psDecoder, g_pui8Output[ui32Idx]);
+    }
+    LogDecodeEnd(psDecoder);
+    fclose(psOut);
+    g_ui32OutputLen = 0;
+    if(pnSize)
+    {
+        *pnSize = nSize;
+    }
+
+    return(pcText);
+}
+
+//*****************************************************************************
+//
+// Checks the decoded text against the expected text.
+//
+//*****************************************************************************
+static void
+Expect(const char *pcName, char *pcText, const char *pcExpected)
+{
+    if(strcmp(pcText, pcExpected) != 0)
+    {
+        printf("FAILED %s: expected \"%s\", got \"%s\"\n", pcName,
+               pcExpected, pcText);
+        g_ui32Failed++;
+    }
+    free(pcText);
+}
+
+//*****************************************************************************
+//
+// Checks that a record written by UARTlog() decodes to the text written by
+// UARTprintf() for the same arguments.
+//
+//*****************************************************************************
+static void
+Check(const char *pcFormat, ...)
+{
+    char *pcExpected, *pcText;
+    va_list vaArgP, vaCopy;
+
+    va_start(vaArgP, pcFormat);
+
+    //
+    // Capture the text written by UARTprintf(), without the carriage
+    // returns it adds.
+    //
+    va_copy(vaCopy, vaArgP);
+    UARTvprintf(pcFormat, vaCopy);
+    va_end(vaCopy);
+    Flush();
+    g_pcFormat = 0;
+    pcExpected = Decode(false, 0, 0, 0);
+
+    //
+    // Capture and decode the log record.
+    //
+    va_copy(vaCopy, vaArgP);
+    UARTvlog(pcFormat, vaCopy);
+    va_end(vaCopy);
+    Flush();
+    g_pcFormat = pcFormat;
+    pcText = Decode(false, 0, 0, 0);
+
+    Expect(pcFormat, pcText, pcExpected);
+    free(pcExpected);
+    va_end(vaArgP);
+}
+
+//*****************************************************************************
+//
+// Checks every formatting character against UARTprintf().
+//
+//*****************************************************************************
+static void
+FormatCheck(void)
+{
+    Check("plain text\n");
+    Check("%c%c%c", 'a', 'b', '\n');
+    Check("%d %i %d %d %d", 0, 42, -42, 2147483647, (int)0x80000000);
+    Check("[%5d] [%05d] [%5d] [%05d] [%1d] [%15d]", 42, 42, -42, -42, 123,
+          -7);
+    Check("%u %u %10u %15u %16u", 0u, 4294967295u, 77u, 5u, 5u);
+    Check("%x %X %p %08x %4x", 0xdeadbeefu, 0xabcu, 0x20000000u, 0x1fu,
+          0x12345u);
+    Check("%s, %s! [%8s] [%2s]", "Hello", "world", "pad", "long");
+    Check("%s", "line one\nline two\n");
+    Check("100%% %d%%", 50);
+    Check("%q %d", 5);
+}
+
+//*****************************************************************************
+//
+// Checks the other features of the log.
+//
+//*****************************************************************************
+static void
+FeatureCheck(void)
+{
+    static const char pcLong[] = "0123456789abcdefghijklmnopqrstuvwxyz"
+                                 "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static const char *pcFormat;
+    uint32_t ui32Idx, ui32Records, ui32Dropped;
+    tLogDecoder sDecoder;
+    char pcBuf[256], *pcText;
+    size_t nSize;
+
+    //
+    // Timestamps are printed as given, or as seconds.
+    //
+    UARTLogTimestampSet(TimestampGet);
+    g_ui32Time = 123456;
+    g_pcFormat = pcFormat = "tick\n";
+    UARTlog(pcFormat);
+    Flush();
+    Expect("timestamp", Decode(true, 0, 0, 0), "[    123456] tick\n");
+    UARTlog(pcFormat);
+    Flush();
+    Expect("timestamp seconds", Decode(true, 1e6, 0, 0),
+           "[    0.123456] tick\n");
+    UARTLogTimestampSet(0);
+
+    //
+    // Arguments which do not fit in a record are discarded, and a string is
+    // cut short to fit.
+    //
+    g_pcFormat = pcFormat = "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d";
+    UARTlog(pcFormat, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    Flush();
+    Expect("too many arguments", Decode(false, 0, 0, 0),
+           "1 2 3 4 5 6 7 8 9 10 11 12 13 ...");
+    g_pcFormat = pcFormat = "%s! %d";
+    UARTlog(pcFormat, pcLong, 7);
+    Flush();
+    snprintf(pcBuf, sizeof(pcBuf), "%.*s! ...",
+             UART_LOG_RECORD_SIZE - UART_LOG_O_ARGS - 2, pcLong);
+    Expect("long string", Decode(false, 0, 0, 0), pcBuf);
+
+    //
+    // Records are discarded, and counted, once the buffer is full.
+    //
+    g_pcFormat = pcFormat = "record %d\n";
+    ui32Dropped = UARTLogDropped();
+    for(ui32Idx = 0; ui32Idx < UART_LOG_BUFFER_SIZE; ui32Idx++)
+    {
+        UARTlog(pcFormat, ui32Idx);
+    }
+    Flush();
+    ui32Records = UART_LOG_BUFFER_SIZE / (UART_LOG_O_ARGS + 5);
+    free(Decode(false, 0, &sDecoder, 0));
+    if((sDecoder.ui32Records != ui32Records) ||
+       ((UARTLogDropped() - ui32Dropped) !=
+        (UART_LOG_BUFFER_SIZE - ui32Records)))
+    {
+        printf("FAILED full buffer: %u records, %u dropped\n",
+               sDecoder.ui32Records, UARTLogDropped() - ui32Dropped);
+        g_ui32Failed++;
+    }
+
+    //
+    // Text around the records passes through, and a corrupt record is
+    // skipped (its bytes being decoded again as text) without losing the
+    // text or records after it.
+    //
+    g_pcFormat = pcFormat = "<%d>";
+    UARTprintf("abc");
+    UARTlog(pcFormat, 1);
+    Flush();
+    UARTprintf("def\n");
+    Flush();
+    ui32Idx = g_ui32OutputLen;
+    UARTlog(pcFormat, 2);
+    Flush();
+    g_pui8Output[ui32Idx + UART_LOG_O_ARGS] ^= 0x40;
+    UARTprintf("%c ghi", UART_LOG_SYNC);
+    Flush();
+    UARTlog(pcFormat, 3);
+    Flush();
+    pcText = Decode(false, 0, &sDecoder, &nSize);
+    if((nSize < 17) || (memcmp(pcText, "abc<1>def\n", 10) != 0) ||
+       (memcmp(pcText + nSize - 7, " ghi<3>", 7) != 0) ||
+       (sDecoder.ui32Records != 2) || (sDecoder.ui32Corrupt < 2))
+    {
+        printf("FAILED corruption: %u records, %u corrupt\n",
+               sDecoder.ui32Records, sDecoder.ui32Corrupt);
+        g_ui32Failed++;
+    }
+    free(pcText);
+
+#ifdef UART_BUFFERED
+    //
+    // Text written while a record is being sent follows the record, and a
+    // record waits for the text written before it.
+    //
+    g_pcFormat = pcFormat = "[%s]";
+    UARTlog(pcFormat, pcLong);
+    UARTRun(4);
+    UARTprintf("text");
+    UARTRun(0xFFFFFFFF);
+    UARTprintf("more text");
+    UARTlog(pcFormat, "x");
+    UARTRun(0xFFFFFFFF);
+    snprintf(pcBuf, sizeof(pcBuf), "[%.*s]textmore text[x]",
+             UART_LOG_RECORD_SIZE - UART_LOG_O_ARGS - 2, pcLong);
+    Expect("interleaving", Decode(false, 0, 0, 0), pcBuf);
+
+    //
+    // Text written when the FIFO filled part way through a record, but has
+    // since made space, still follows the record.
+    //
+    g_bFifoDrains = true;
+    UARTlog(pcFormat, pcLong);
+    UARTRun(0);
+    UARTprintf("text");
+    g_bFifoDrains = false;
+    UARTRun(0xFFFFFFFF);
+    snprintf(pcBuf, sizeof(pcBuf), "[%.*s]text",
+             UART_LOG_RECORD_SIZE - UART_LOG_O_ARGS - 2, pcLong);
+    Expect("interleaving with a draining FIFO", Decode(false, 0, 0, 0),
+           pcBuf);
+#endif
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    UARTStdioConfig(0, 115200, 16000000);
+
+    FormatCheck();
+    FeatureCheck();
+
+    printf("%-6s deferred log\n", g_ui32Failed ? "FAILED" : "ok");
+    return(g_ui32Failed ? 1 : 0);
+}
@@ -0,0 +1,294 @@
+//*****************************************************************************
+//
+// uartlog.c - Host-side decoder for the deferred UART log.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <elf.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "logdecode.h"
+
+//*****************************************************************************
+//
+// This program expands the binary records written by UARTlog() in
+// utils/uartstdio.c into text.  It reads the output of the UART, either from
+// a capture file or from the serial device itself, and writes the text with
+// each record replaced by its formatted text, using the format strings found
+// in the firmware image which is running on the target.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The firmware image, which is either an ELF file (such as the .axf files
+// produced by the TivaWare makefiles) or a binary image loaded at a given
+// address.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint8_t *pui8Data;
+    uint32_t ui32Size;
+    bool bElf;
+    uint32_t ui32Base;
+}
+tImage;
+
+//*****************************************************************************
+//
+// Returns the string starting at an offset in the image, if it lies between
+// the offset and the given end of its section.
+//
+//*****************************************************************************
+static const char *
+ImageString(tImage *psImage, uint32_t ui32Offset, uint32_t ui32End)
+{
+    if((ui32End > psImage->ui32Size) || (ui32Offset >= ui32End) ||
+       !memchr(psImage->pui8Data + ui32Offset, 0, ui32End - ui32Offset))
+    {
+        return(0);
+    }
+    return((const char *)psImage->pui8Data + ui32Offset);
+}
+
+//*****************************************************************************
+//
+// Finds the format string at an address in the firmware.  For an ELF file,
+// this is found in the section which is loaded at that address.
+//
+//*****************************************************************************
+static const char *
+ImageLookup(void *pvData, uint32_t ui32Addr)
+{
+    tImage *psImage;
+    Elf32_Ehdr sHeader;
+    Elf32_Shdr sSection;
+    uint32_t ui32Idx, ui32Offset;
+
+    psImage = pvData;
+    if(!psImage->bElf)
+    {
+        if(ui32Addr < psImage->ui32Base)
+        {
+            return(0);
+        }
+        return(ImageString(psImage, ui32Addr - psImage->ui32Base,
+                           psImage->ui32Size));
+    }
+
+    //
+    // Search the sections which are loaded into memory and have contents in
+    // the file.
+    //
+    memcpy(&sHeader, psImage->pui8Data, sizeof(sHeader));
+    for(ui32Idx = 0; ui32Idx < sHeader.e_shnum; ui32Idx++)
+    {
+        ui32Offset = sHeader.e_shoff + (ui32Idx * sHeader.e_shentsize);
+        if((ui32Offset + sizeof(sSection)) > psImage->ui32Size)
+        {
+            break;
+        }
+        memcpy(&sSection, psImage->pui8Data + ui32Offset, sizeof(sSection));
+        if((sSection.sh_flags & SHF_ALLOC) &&
+           (sSection.sh_type != SHT_NOBITS) &&
+           (ui32Addr >= sSection.sh_addr) &&
+           ((ui32Addr - sSection.sh_addr) < sSection.sh_size))
+        {
+            return(ImageString(psImage,
+                               sSection.sh_offset +
+                               (ui32Addr - sSection.sh_addr),
+                               sSection.sh_offset + sSection.sh_size));
+        }
+    }
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Reads the firmware image.
+//
+//*****************************************************************************
+static bool
+ImageLoad(tImage *psImage, const char *pcFile, uint32_t ui32Base)
+{
+    FILE *psFile;
+    long lSize;
+
+    psFile = fopen(pcFile, "rb");
+    if(!psFile)
+    {
+        perror(pcFile);
+        return(false);
+    }
+    fseek(psFile, 0, SEEK_END);
+    lSize = ftell(psFile);
+    fseek(psFile, 0, SEEK_SET);
+    psImage->pui8Data = malloc(lSize ? lSize : 1);
+    if(!psImage->pui8Data ||
+       (fread(psImage->pui8Data, 1, lSize, psFile) != (size_t)lSize))
+    {
+        fprintf(stderr, "%s: Unable to read the image\n", pcFile);
+        fclose(psFile);
+        return(false);
+    }
+    fclose(psFile);
+    psImage->ui32Size = (uint32_t)lSize;
+    psImage->ui32Base = ui32Base;
+
+    //
+    // Only little-endian 32-bit ELF files are produced for the target;
+    // anything else is treated as a binary image.
+    //
+    psImage->bElf = ((psImage->ui32Size >= sizeof(Elf32_Ehdr)) &&
+                     !memcmp(psImage->pui8Data, ELFMAG, SELFMAG) &&
+                     (psImage->pui8Data[EI_CLASS] == ELFCLASS32) &&
+                     (psImage->pui8Data[EI_DATA] == ELFDATA2LSB));
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Prints the usage message.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    printf("Usage: %s [OPTION]... IMAGE [CAPTURE]\n", pcProgram);
+    printf("Expands the deferred log records in the UART output read from "
+           "CAPTURE (or the\nstandard input), using the format strings in "
+           "the firmware IMAGE (an ELF file\nor a binary image).\n\n");
+    printf("  -a ADDR  Load a binary image at ADDR (default 0)\n");
+    printf("  -f HZ    Print timestamps as seconds, given their frequency\n");
+    printf("  -n       Do not print timestamps\n");
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    tLogDecoder sDecoder;
+    uint8_t pui8Buf[256];
+    uint32_t ui32Base;
+    tImage sImage;
+    bool bTimestamps;
+    double dHz;
+    ssize_t iCount, iIdx;
+    int iOpt, iFile;
+
+    ui32Base = 0;
+    dHz = 0;
+    bTimestamps = true;
+
+    while((iOpt = getopt(argc, argv, "a:f:hn")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'a':
+            {
+                ui32Base = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            case 'f':
+            {
+                dHz = strtod(optarg, 0);
+                break;
+            }
+
+            case 'n':
+            {
+                bTimestamps = false;
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+    if((optind != (argc - 1)) && (optind != (argc - 2)))
+    {
+        Usage(argv[0]);
+        return(1);
+    }
+
+    //
+    // Read the image, and open the capture.
+    //
+    if(!ImageLoad(&sImage, argv[optind], ui32Base))
+    {
+        return(1);
+    }
+    iFile = 0;
+    if((optind == (argc - 2)) && (strcmp(argv[optind + 1], "-") != 0))
+    {
+        if(!freopen(argv[optind + 1], "rb", stdin))
+        {
+            perror(argv[optind + 1]);
+            return(1);
+        }
+        iFile = fileno(stdin);
+    }
+
+    //
+    // Decode the capture as it is read, so that the output of a serial
+    // device is shown as it arrives.
+    //
+    LogDecodeInit(&sDecoder, ImageLookup, &sImage, stdout);
+    sDecoder.bTimestamps = bTimestamps;
+    sDecoder.dTimestampHz = dHz;
+    while((iCount = read(iFile, pui8Buf, sizeof(pui8Buf))) > 0)
+    {
+        for(iIdx = 0; iIdx < iCount; iIdx++)
+        {
+            LogDecodeByte(&sDecoder, pui8Buf[iIdx]);
+        }
+        fflush(stdout);
+    }
+    LogDecodeEnd(&sDecoder);
+
+    //
+    // Report any records which could not be decoded.
+    //
+    if(sDecoder.ui32Corrupt || sDecoder.ui32Unknown)
+    {
+        fprintf(stderr, "%u records decoded, %u corrupt, %u with unknown "
+                "format strings\n", sDecoder.ui32Records,
+                sDecoder.ui32Corrupt, sDecoder.ui32Unknown);
+    }
+
+    free(sImage.pui8Data);
+    return(0);
+}
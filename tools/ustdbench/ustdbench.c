@@ -0,0 +1,737 @@
+//*****************************************************************************
+//
+// ustdbench.c - Host-side uvsnprintf() conformance test and benchmark.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "utils/ustdlib.h"
+
+//*****************************************************************************
+//
+// This program exercises the uvsnprintf() function of the utility library
+// on the host machine.  It has two purposes:
+//
+// - To check the output of each conversion against the C library, for fixed
+//   cases covering the flags, widths, precisions, and length modifiers, for
+//   truncated output, and for a large number of random values.
+//
+// - To measure the time taken to format a single field with uvsnprintf(),
+//   with the previous implementation of uvsnprintf(), and with the C library,
+//   so that the effect of changes can be quantified without target hardware.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The default number of seconds for which each benchmark is run.
+//
+//*****************************************************************************
+#define DEFAULT_DURATION        0.25
+
+//*****************************************************************************
+//
+// The default number of random values checked for each conversion.
+//
+//*****************************************************************************
+#define DEFAULT_RANDOM_COUNT    100000
+
+//*****************************************************************************
+//
+// The previous implementation of uvsnprintf(), from uvsnprintf_old.c.
+//
+//*****************************************************************************
+extern int uvsnprintf_old(char * restrict s, size_t n,
+                          const char * restrict format, va_list arg);
+
+//*****************************************************************************
+//
+// The implementations which are compared.
+//
+//*****************************************************************************
+#define IMPL_NEW                0
+#define IMPL_OLD                1
+#define IMPL_LIBC               2
+
+//*****************************************************************************
+//
+// The number of checks which have failed.
+//
+//*****************************************************************************
+static uint32_t g_ui32Failed;
+
+//*****************************************************************************
+//
+// Formats the arguments with the given implementation.
+//
+//*****************************************************************************
+static int
+Format(uint32_t ui32Impl, char *pcBuf, size_t n, const char *pcFormat, ...)
+{
+    va_list vaArgs;
+    int iRet;
+
+    va_start(vaArgs, pcFormat);
+    if(ui32Impl == IMPL_NEW)
+    {
+        iRet = uvsnprintf(pcBuf, n, pcFormat, vaArgs);
+    }
+    else if(ui32Impl == IMPL_OLD)
+    {
+        iRet = uvsnprintf_old(pcBuf, n, pcFormat, vaArgs);
+    }
+    else
+    {
+        iRet = vsnprintf(pcBuf, n, pcFormat, vaArgs);
+    }
+    va_end(vaArgs);
+
+    return(iRet);
+}
+
+//*****************************************************************************
+//
+// Compares the output of uvsnprintf() against the expected output, both into
+// a large buffer and into buffers too small to hold all of it.
+//
+//*****************************************************************************
+static void
+Check(const char *pcExpected, const char *pcFormat, ...)
+{
+    char pcBuf[512];
+    va_list vaArgs, vaCopy;
+    size_t n, nLen;
+    int iRet;
+
+    nLen = strlen(pcExpected);
+    va_start(vaArgs, pcFormat);
+    for(n = sizeof(pcBuf); ; n = (n > nLen) ? nLen : (n - 1))
+    {
+        //
+        // Format into a buffer of this size, with a guard byte after it.
+        //
+        memset(pcBuf, 0x55, sizeof(pcBuf));
+        va_copy(vaCopy, vaArgs);
+        iRet = uvsnprintf(pcBuf, n, pcFormat, vaCopy);
+        va_end(vaCopy);
+
+        //
+        // Check the return value, the truncated output, and that nothing was
+        // written after the end of the buffer.
+        //
+        if((iRet != (int)nLen) ||
+           (strncmp(pcBuf, pcExpected, n - 1) != 0) ||
+           (pcBuf[(n - 1 < nLen) ? (n - 1) : nLen] != '\0') ||
+           ((n < sizeof(pcBuf)) && (pcBuf[n] != 0x55)))
+        {
+            printf("FAILED \"%s\" into %u bytes: expected \"%s\" (%u), got "
+                   "\"%s\" (%d)\n", pcFormat, (unsigned)n, pcExpected,
+                   (unsigned)nLen, pcBuf, iRet);
+            g_ui32Failed++;
+            break;
+        }
+
+        if(n == 1)
+        {
+            break;
+        }
+    }
+    va_end(vaArgs);
+}
+
+//*****************************************************************************
+//
+// Compares the output of uvsnprintf() against that of the C library.
+//
+//*****************************************************************************
+#define CheckLibc(...)                                                        \
+    do                                                                        \
+    {                                                                         \
+        char pcExpected[512];                                                 \
+        snprintf(pcExpected, sizeof(pcExpected), __VA_ARGS__);                \
+        Check(pcExpected, __VA_ARGS__);                                       \
+    }                                                                         \
+    while(0)
+
+//*****************************************************************************
+//
+// Checks fixed cases for every conversion.
+//
+//*****************************************************************************
+static void
+FixedCheck(void)
+{
+    //
+    // Characters, strings, and literal text.
+    //
+    CheckLibc("plain text");
+    CheckLibc("%c%c%%%c", 'a', 'b', 'c');
+    CheckLibc("[%3c] [%-3c]", 'x', 'y');
+    CheckLibc("%s, %s!", "Hello", "world");
+    CheckLibc("%.3s|%.*s|%.0s", "abcdef", 2, "xyz", "gone");
+    CheckLibc("%-8s|%-2s|", "left", "long");
+    CheckLibc("%-*s|", 6, "ab");
+
+    //
+    // As before, strings are padded after the text even without the - flag.
+    //
+    Check("ab    |", "%6s|", "ab");
+    Check("(d) name        ", "(%c) %12s", 'd', "name");
+
+    //
+    // Signed and unsigned decimal values, with flags, widths, and
+    // precisions.
+    //
+    CheckLibc("%d %i %d %d", 0, 42, -42, 2147483647);
+    CheckLibc("%d", (int)0x80000000);
+    CheckLibc("%u %u", 0u, 4294967295u);
+    CheckLibc("[%5d] [%-5d] [%05d] [%+d] [% d] [%+d]", 42, 42, 42, 42, 42,
+              -42);
+    CheckLibc("[%08d] [%+08d] [% 8d]", -123, 123, 123);
+    CheckLibc("[%.5d] [%8.5d] [%-8.5d]", 42, -42, 42);
+
+    //
+    // The 0 flag is ignored with the - flag or a precision.
+    //
+    Check("[-123    ] [   00042]", "[%-08d] [%08.5d]", -123, 42);
+    CheckLibc("[%.0d] [%5.0d] [%.0u]", 0, 0, 0u);
+    CheckLibc("[%*d] [%-*d] [%*d]", 6, 7, 6, 7, -6, 7);
+    CheckLibc("[%.*d] [%.*d]", 4, 7, -1, 7);
+    CheckLibc("%ld %lu", -1234567L, 1234567UL);
+
+    //
+    // 64-bit values, including those which need every digit.
+    //
+    CheckLibc("%lld %lld %lld", 0LL, 9223372036854775807LL,
+              (long long)0x8000000000000000ULL);
+    CheckLibc("%llu %llu %llu", 4294967296ULL, 99999999999999999ULL,
+              18446744073709551615ULL);
+    CheckLibc("%llu %llu %llu", 100000000ULL, 10000000000000000ULL,
+              10000000000000000000ULL);
+    CheckLibc("[%25lld] [%-+25lld] [%025llu]", -1234567890123LL,
+              1234567890123LL, 98765432109876543ULL);
+    CheckLibc("%llx %llx", 0x0123456789abcdefULL, 0xffffffffffffffffULL);
+
+    //
+    // Hexadecimal values, which are printed in lower case for both %x and
+    // %X, and pointers, which are printed without a prefix.
+    //
+    CheckLibc("%x %x %08x %-8x| %#x %#x", 0u, 0xdeadbeefu, 0xbeefu, 0xbeefu,
+              0x1234u, 0u);
+    CheckLibc("[%#10x] [%#010x] [%.6x]", 0xabcu, 0xabcu, 0xabcu);
+    Check("deadbeef", "%X", 0xdeadbeefu);
+    Check("1234abcd", "%p", (void *)0x1234abcd);
+
+    //
+    // Fixed-point floating-point values, including rounding ties, which
+    // round to even, and carries into a new digit.
+    //
+    CheckLibc("%f %f %f %f", 0.0, -0.0, 1.0, -1.5);
+    CheckLibc("%f %f", 3.14159265358979, 123456.789);
+    CheckLibc("%.0f %.0f %.0f %.0f %.0f", 0.5, 1.5, 2.5, 3.5, -0.5);
+    CheckLibc("%.2f %.2f %.2f %.1f", 0.125, 0.375, 2.675, 0.25);
+    CheckLibc("%.3f %.1f %.0f", 9.9995, 99.96, 999.5);
+    CheckLibc("%.10f %.15f %.17f", 1.0 / 3.0, 0.1, 2.0 / 3.0);
+    CheckLibc("%f %f", 1e-7, 123456789012345678.0);
+    CheckLibc("%f %.3f %f", 1e22, 1e-300, 4.9e-324);
+    CheckLibc("[%10.3f] [%-10.3f] [%010.3f] [%+.3f] [% .3f]", 3.14159,
+              3.14159, -3.14159, 3.14159, 3.14159);
+    CheckLibc("[%#.0f] [%.0f] [%*.*f]", 3.0, 3.0, 9, 2, 2.5);
+    CheckLibc("%F", 1.5);
+
+    //
+    // Digits beyond the first 19 significant digits are printed as zeros.
+    //
+    Check("1180591620717411303000.00", "%.2f", 1180591620717411303424.0);
+    Check("0.1000000000000000056000", "%.22f", 0.1);
+
+    //
+    // Exponential floating-point values.
+    //
+    CheckLibc("%e %e %e %e", 0.0, 1.0, -1.5, 123456.789);
+    CheckLibc("%.0e %.1e %.3e %.10e", 12345.0, 0.000123456, 9.9996,
+              1.0 / 7.0);
+    CheckLibc("%e %e %e", 1e100, 1e-100, 1.7976931348623157e308);
+    CheckLibc("%e %e", 2.2250738585072014e-308, 4.9e-324);
+    CheckLibc("%.0e %.0e %#.0e", 2.5, 3.5, 2.0);
+    CheckLibc("[%15.3e] [%-15.3E] [%015.3e]", 6.02214076e23, 6.02214076e23,
+              -1.602176634e-19);
+
+    //
+    // General floating-point values.
+    //
+    CheckLibc("%g %g %g %g %g", 0.0, 1.0, 0.5, 100000.0, 1000000.0);
+    CheckLibc("%g %g %g %g", 0.0001, 0.00001, 123456789.0, 1.5e-10);
+    CheckLibc("%g %G %g", 3.14159265358979, 1e-20, 9.9999995);
+    CheckLibc("%.0g %.1g %.3g %.10g %.17g", 123.0, 0.15, 99.95, 1.0 / 3.0,
+              0.1);
+    CheckLibc("%#g %#g %#.3g", 1.0, 0.0001, 100.0);
+    CheckLibc("[%12g] [%-12g] [%012g] [%+g]", -2.5e-5, 2.5e-5, 2.5e-5, 7.0);
+
+    //
+    // Infinities and NaNs, which are never zero padded.
+    //
+    CheckLibc("%f %e %g %F %E %G", 1.0 / 0.0, -1.0 / 0.0, 1.0 / 0.0,
+              1.0 / 0.0, -1.0 / 0.0, 1.0 / 0.0);
+    CheckLibc("[%6f] [%-6f] [%06f]", 1.0 / 0.0, -1.0 / 0.0, 1.0 / 0.0);
+    Check("nan NAN", "%f %G", __builtin_nan(""), __builtin_nan(""));
+
+    //
+    // Unsupported conversions, and a format string which ends in the middle
+    // of a conversion.
+    //
+    Check("ERROR 7", "%q %d", 7);
+    Check("x", "x%");
+    Check("x", "x%-08.3l");
+}
+
+//*****************************************************************************
+//
+// Returns a random 64-bit value.
+//
+//*****************************************************************************
+static uint64_t
+Random64(void)
+{
+    static uint64_t ui64State = 0x0123456789abcdefULL;
+
+    ui64State ^= ui64State << 13;
+    ui64State ^= ui64State >> 7;
+    ui64State ^= ui64State << 17;
+    return(ui64State);
+}
+
+//*****************************************************************************
+//
+// Returns a random double, with a random sign and exponent, and either a
+// random mantissa or a value with a short decimal representation (which is
+// where rounding ties occur).
+//
+//*****************************************************************************
+static double
+RandomDouble(void)
+{
+    union
+    {
+        double d;
+        uint64_t ui64;
+    }
+    uValue;
+    uint64_t ui64Bits;
+
+    ui64Bits = Random64();
+    if(ui64Bits & 1)
+    {
+        uValue.d = (double)(int32_t)(ui64Bits >> 32) /
+                   (double)(1 << ((ui64Bits >> 1) & 15));
+        return(uValue.d);
+    }
+
+    //
+    // Use every exponent except the one for infinities and NaNs.
+    //
+    do
+    {
+        uValue.ui64 = Random64();
+    }
+    while(((uValue.ui64 >> 52) & 0x7ff) == 0x7ff);
+
+    return(uValue.d);
+}
+
+//*****************************************************************************
+//
+// Checks random values against the C library.
+//
+//*****************************************************************************
+static void
+RandomCheck(uint32_t ui32Count)
+{
+    static const char * const ppcIntFormats[] =
+    {
+        "%d", "%-12d", "%+012d", "%.9d", "% 5d", "%u", "%010u", "%x", "%#x",
+        "%.8x"
+    };
+    static const char * const ppcLongFormats[] =
+    {
+        "%lld", "%-+25lld", "%025lld", "%.20lld", "%llu", "%30llu", "%llx",
+        "%#llx"
+    };
+    static const char * const ppcFloatFormats[] =
+    {
+        "%e", "%.0e", "%.3e", "%.10e", "%.14e", "%E", "%g", "%.1g", "%.8g",
+        "%.15g", "%#g", "%G", "%+-15.4e", "%015g", "%.17g", "%.18e"
+    };
+    static const struct
+    {
+        const char *pcFormat;
+        double dLimit;
+    }
+    psFixedFormats[] =
+    {
+        { "%f", 1e13 }, { "%.0f", 1e19 }, { "%.2f", 1e17 }, { "%.9f", 1e10 },
+        { "%+f", 1e13 }, { "%-20.3f", 1e16 }, { "%020.5f", 1e14 },
+        { "%#.0f", 1e19 }
+    };
+    uint32_t ui32Loop, ui32Idx, ui32Before;
+    uint64_t ui64Value;
+    double dValue;
+
+    ui32Before = g_ui32Failed;
+    for(ui32Loop = 0; ui32Loop < ui32Count; ui32Loop++)
+    {
+        //
+        // Check a random 32-bit value, and a random 64-bit value of random
+        // magnitude.
+        //
+        ui64Value = Random64();
+        ui32Idx = ui32Loop % (sizeof(ppcIntFormats) / sizeof(char *));
+        CheckLibc(ppcIntFormats[ui32Idx], (int)ui64Value);
+        ui64Value >>= ui64Value & 63;
+        ui32Idx = ui32Loop % (sizeof(ppcLongFormats) / sizeof(char *));
+        CheckLibc(ppcLongFormats[ui32Idx], (long long)ui64Value);
+
+        //
+        // Check a random double with the exponential and general
+        // conversions.
+        //
+        dValue = RandomDouble();
+        ui32Idx = ui32Loop % (sizeof(ppcFloatFormats) / sizeof(char *));
+        CheckLibc(ppcFloatFormats[ui32Idx], dValue);
+
+        //
+        // Check the fixed-point conversion with the values it prints in
+        // full, which have no more than 19 digits at its precision (beyond
+        // which the digits are printed as zeros).
+        //
+        ui32Idx = ui32Loop % (sizeof(psFixedFormats) /
+                              sizeof(psFixedFormats[0]));
+        if((dValue < psFixedFormats[ui32Idx].dLimit) &&
+           (dValue > -psFixedFormats[ui32Idx].dLimit))
+        {
+            CheckLibc(psFixedFormats[ui32Idx].pcFormat, dValue);
+        }
+
+        //
+        // Stop after a few failures rather than flooding the output.
+        //
+        if((g_ui32Failed - ui32Before) >= 10)
+        {
+            break;
+        }
+    }
+
+    printf("%-6s %u random values\n",
+           (g_ui32Failed == ui32Before) ? "ok" : "FAILED", ui32Count);
+}
+
+//*****************************************************************************
+//
+// The types of argument used by the benchmarks.
+//
+//*****************************************************************************
+#define ARG_INT                 0
+#define ARG_LONG_LONG           1
+#define ARG_DOUBLE              2
+#define ARG_STRING              3
+
+//*****************************************************************************
+//
+// The table of benchmarks, each of which formats a single field.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *pcFormat;
+    uint32_t ui32Arg;
+    bool bOld;
+}
+tBenchmark;
+
+static const tBenchmark g_psBenchmarks[] =
+{
+    { "%d", ARG_INT, true },
+    { "%08x", ARG_INT, true },
+    { "%-12s", ARG_STRING, true },
+    { "%lld", ARG_LONG_LONG, false },
+    { "%f", ARG_DOUBLE, false },
+    { "%.3f", ARG_DOUBLE, false },
+    { "%e", ARG_DOUBLE, false },
+    { "%g", ARG_DOUBLE, false },
+};
+
+#define NUM_BENCHMARKS          (sizeof(g_psBenchmarks) /                     \
+                                 sizeof(g_psBenchmarks[0]))
+
+//*****************************************************************************
+//
+// The values formatted by the benchmarks, which are varied so that the
+// number of digits is not always the same.
+//
+//*****************************************************************************
+#define NUM_VALUES              64
+static int g_piValues[NUM_VALUES];
+static long long g_pllValues[NUM_VALUES];
+static double g_pdValues[NUM_VALUES];
+static const char *g_ppcValues[4] =
+{
+    "a", "short", "a longer one", "a string longer than the field"
+};
+
+//*****************************************************************************
+//
+// Returns the current time in seconds.
+//
+//*****************************************************************************
+static double
+TimeGet(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return((double)sTime.tv_sec + ((double)sTime.tv_nsec / 1e9));
+}
+
+//*****************************************************************************
+//
+// Returns the processor's time stamp counter, where there is one, to give
+// the number of cycles taken.
+//
+//*****************************************************************************
+static uint64_t
+CyclesGet(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return(__builtin_ia32_rdtsc());
+#else
+    return(0);
+#endif
+}
+
+//*****************************************************************************
+//
+// Formats the field of a benchmark a number of times with an implementation.
+//
+//*****************************************************************************
+static void
+BenchmarkWork(uint32_t ui32Impl, const tBenchmark *psBench, uint32_t ui32Iter)
+{
+    char pcBuf[64];
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Iter; ui32Idx++)
+    {
+        switch(psBench->ui32Arg)
+        {
+            case ARG_INT:
+            {
+                Format(ui32Impl, pcBuf, sizeof(pcBuf), psBench->pcFormat,
+                       g_piValues[ui32Idx % NUM_VALUES]);
+                break;
+            }
+
+            case ARG_LONG_LONG:
+            {
+                Format(ui32Impl, pcBuf, sizeof(pcBuf), psBench->pcFormat,
+                       g_pllValues[ui32Idx % NUM_VALUES]);
+                break;
+            }
+
+            case ARG_DOUBLE:
+            {
+                Format(ui32Impl, pcBuf, sizeof(pcBuf), psBench->pcFormat,
+                       g_pdValues[ui32Idx % NUM_VALUES]);
+                break;
+            }
+
+            default:
+            {
+                Format(ui32Impl, pcBuf, sizeof(pcBuf), psBench->pcFormat,
+                       g_ppcValues[ui32Idx % 4]);
+                break;
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Runs each benchmark for the given number of seconds with each
+// implementation, and prints the time and cycles taken per field.
+//
+//*****************************************************************************
+static void
+BenchmarksRun(double dDuration)
+{
+    static const char * const ppcImpls[] =
+    {
+        "uvsnprintf", "previous", "C library"
+    };
+    uint32_t ui32Idx, ui32Impl, ui32Iter;
+    uint64_t ui64Cycles;
+    double dStart, dTime;
+
+    //
+    // Choose the values to be formatted.
+    //
+    for(ui32Idx = 0; ui32Idx < NUM_VALUES; ui32Idx++)
+    {
+        g_piValues[ui32Idx] = (int)(Random64() >> (32 + (ui32Idx % 32)));
+        g_pllValues[ui32Idx] = (long long)(Random64() >> (ui32Idx % 64));
+        g_pdValues[ui32Idx] = ((double)(int32_t)Random64() /
+                               (double)(1 << (ui32Idx % 24)));
+    }
+
+    printf("%-10s %-12s %12s %12s\n", "Field", "Function", "ns/field",
+           "cycles/field");
+    for(ui32Idx = 0; ui32Idx < NUM_BENCHMARKS; ui32Idx++)
+    {
+        for(ui32Impl = IMPL_NEW; ui32Impl <= IMPL_LIBC; ui32Impl++)
+        {
+            //
+            // The previous implementation only supports some fields.
+            //
+            if((ui32Impl == IMPL_OLD) && !g_psBenchmarks[ui32Idx].bOld)
+            {
+                continue;
+            }
+
+            //
+            // Double the number of iterations until the run is long enough.
+            //
+            for(ui32Iter = 64; ; ui32Iter *= 2)
+            {
+                dStart = TimeGet();
+                ui64Cycles = CyclesGet();
+                BenchmarkWork(ui32Impl, &g_psBenchmarks[ui32Idx], ui32Iter);
+                ui64Cycles = CyclesGet() - ui64Cycles;
+                dTime = TimeGet() - dStart;
+                if(dTime >= dDuration)
+                {
+                    break;
+                }
+            }
+
+            printf("%-10s %-12s %12.1f %12.1f\n",
+                   g_psBenchmarks[ui32Idx].pcFormat, ppcImpls[ui32Impl],
+                   dTime * 1e9 / ui32Iter, (double)ui64Cycles / ui32Iter);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Prints the usage message.
+//
+//*****************************************************************************
+static void
+Usage(const char *pcProgram)
+{
+    printf("Usage: %s [OPTION]...\n", pcProgram);
+    printf("Checks and benchmarks the utility library uvsnprintf() "
+           "function.\n\n");
+    printf("  -c       Only run the checks\n");
+    printf("  -n COUNT Check COUNT random values of each type "
+           "(default %u)\n", DEFAULT_RANDOM_COUNT);
+    printf("  -s       Only run the benchmarks\n");
+    printf("  -t SEC   Run each benchmark for SEC seconds (default %.2f)\n",
+           DEFAULT_DURATION);
+}
+
+//*****************************************************************************
+//
+// The main entry point.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    bool bBench, bCheck;
+    uint32_t ui32Count;
+    double dDuration;
+    int iOpt;
+
+    bBench = true;
+    bCheck = true;
+    ui32Count = DEFAULT_RANDOM_COUNT;
+    dDuration = DEFAULT_DURATION;
+
+    while((iOpt = getopt(argc, argv, "chn:st:")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'c':
+            {
+                bBench = false;
+                break;
+            }
+
+            case 'n':
+            {
+                ui32Count = strtoul(optarg, 0, 0);
+                break;
+            }
+
+            case 's':
+            {
+                bCheck = false;
+                break;
+            }
+
+            case 't':
+            {
+                dDuration = strtod(optarg, 0);
+                break;
+            }
+
+            default:
+            {
+                Usage(argv[0]);
+                return((iOpt == 'h') ? 0 : 1);
+            }
+        }
+    }
+
+    if(bCheck)
+    {
+        FixedCheck();
+        printf("%-6s fixed cases\n", g_ui32Failed ? "FAILED" : "ok");
+        RandomCheck(ui32Count);
+        if(bBench)
+        {
+            printf("\n");
+        }
+    }
+
+    if(bBench)
+    {
+        BenchmarksRun(dDuration);
+    }
+
+    return(g_ui32Failed ? 1 : 0);
+}
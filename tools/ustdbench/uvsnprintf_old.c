@@ -0,0 +1,578 @@
+//*****************************************************************************
+//
+// uvsnprintf_old.c - The previous uvsnprintf(), kept for comparison.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "driverlib/debug.h"
+#include "utils/ustdlib.h"
+
+//*****************************************************************************
+//
+// This is the implementation of uvsnprintf() from the utility library before
+// the 64-bit integer and floating-point conversions were added, renamed so
+// that the benchmark can compare the two.  It supports only \%c, \%d, \%i,
+// \%p, \%s, \%u, \%x, and \%X, with a field width.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// A mapping from an integer between 0 and 15 to its ASCII character
+// equivalent.
+//
+//*****************************************************************************
+static const char * const g_pcHex = "0123456789abcdef";
+
+int
+uvsnprintf_old(char * restrict s, size_t n, const char * restrict format,
+               va_list arg)
+{
+    unsigned long ulIdx, ulValue, ulCount, ulBase, ulNeg;
+    char *pcStr, cFill;
+    int iConvertCount = 0;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(s);
+    ASSERT(n);
+    ASSERT(format);
+
+    //
+    // Adjust buffer size limit to allow one space for null termination.
+    //
+    if(n)
+    {
+        n--;
+    }
+
+    //
+    // Initialize the count of characters converted.
+    //
+    iConvertCount = 0;
+
+    //
+    // Loop while there are more characters in the format string.
+    //
+    while(*format)
+    {
+        //
+        // Find the first non-% character, or the end of the string.
+        //
+        for(ulIdx = 0; (format[ulIdx] != '%') && (format[ulIdx] != '\0');
+            ulIdx++)
+        {
+        }
+
+        //
+        // Write this portion of the string to the output buffer.  If there are
+        // more characters to write than there is space in the buffer, then
+        // only write as much as will fit in the buffer.
+        //
+        if(ulIdx > n)
+        {
+            ustrncpy(s, format, n);
+            s += n;
+            n = 0;
+        }
+        else
+        {
+            ustrncpy(s, format, ulIdx);
+            s += ulIdx;
+            n -= ulIdx;
+        }
+
+        //
+        // Update the conversion count.  This will be the number of characters
+        // that should have been written, even if there was not room in the
+        // buffer.
+        //
+        iConvertCount += ulIdx;
+
+        //
+        // Skip the portion of the format string that was written.
+        //
+        format += ulIdx;
+
+        //
+        // See if the next character is a %.
+        //
+        if(*format == '%')
+        {
+            //
+            // Skip the %.
+            //
+            format++;
+
+            //
+            // Set the digit count to zero, and the fill character to space
+            // (that is, to the defaults).
+            //
+            ulCount = 0;
+            cFill = ' ';
+
+            //
+            // It may be necessary to get back here to process more characters.
+            // Goto's aren't pretty, but effective.  I feel extremely dirty for
+            // using not one but two of the beasts.
+            //
+again:
+
+            //
+            // Determine how to handle the next character.
+            //
+            switch(*format++)
+            {
+                //
+                // Handle the digit characters.
+                //
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                case '8':
+                case '9':
+                {
+                    //
+                    // If this is a zero, and it is the first digit, then the
+                    // fill character is a zero instead of a space.
+                    //
+                    if((format[-1] == '0') && (ulCount == 0))
+                    {
+                        cFill = '0';
+                    }
+
+                    //
+                    // Update the digit count.
+                    //
+                    ulCount *= 10;
+                    ulCount += format[-1] - '0';
+
+                    //
+                    // Get the next character.
+                    //
+                    goto again;
+                }
+
+                //
+                // Handle the %c command.
+                //
+                case 'c':
+                {
+                    //
+                    // Get the value from the varargs.
+                    //
+                    ulValue = va_arg(arg, unsigned long);
+
+                    //
+                    // Copy the character to the output buffer, if there is
+                    // room.  Update the buffer size remaining.
+                    //
+                    if(n != 0)
+                    {
+                        *s++ = (char)ulValue;
+                        n--;
+                    }
+
+                    //
+                    // Update the conversion count.
+                    //
+                    iConvertCount++;
+
+                    //
+                    // This command has been handled.
+                    //
+                    break;
+                }
+
+                //
+                // Handle the %d and %i commands.
+                //
+                case 'd':
+                case 'i':
+                {
+                    //
+                    // Get the value from the varargs.
+                    //
+                    ulValue = va_arg(arg, unsigned long);
+
+                    //
+                    // If the value is negative, make it positive and indicate
+                    // that a minus sign is needed.
+                    //
+                    if((long)ulValue < 0)
+                    {
+                        //
+                        // Make the value positive.
+                        //
+                        ulValue = -(long)ulValue;
+
+                        //
+                        // Indicate that the value is negative.
+                        //
+                        ulNeg = 1;
+                    }
+                    else
+                    {
+                        //
+                        // Indicate that the value is positive so that a
+                        // negative sign isn't inserted.
+                        //
+                        ulNeg = 0;
+                    }
+
+                    //
+                    // Set the base to 10.
+                    //
+                    ulBase = 10;
+
+                    //
+                    // Convert the value to ASCII.
+                    //
+                    goto convert;
+                }
+
+                //
+                // Handle the %s command.
+                //
+                case 's':
+                {
+                    //
+                    // Get the string pointer from the varargs.
+                    //
+                    pcStr = va_arg(arg, char *);
+
+                    //
+                    // Determine the length of the string.
+                    //
+                    for(ulIdx = 0; pcStr[ulIdx] != '\0'; ulIdx++)
+                    {
+                    }
+
+                    //
+                    // Update the convert count to include any padding that
+                    // should be necessary (regardless of whether we have space
+                    // to write it or not).
+                    //
+                    if(ulCount > ulIdx)
+                    {
+                        iConvertCount += (ulCount - ulIdx);
+                    }
+
+                    //
+                    // Copy the string to the output buffer.  Only copy as much
+                    // as will fit in the buffer.  Update the output buffer
+                    // pointer and the space remaining.
+                    //
+                    if(ulIdx > n)
+                    {
+                        ustrncpy(s, pcStr, n);
+                        s += n;
+                        n = 0;
+                    }
+                    else
+                    {
+                        ustrncpy(s, pcStr, ulIdx);
+                        s += ulIdx;
+                        n -= ulIdx;
+
+                        //
+                        // Write any required padding spaces assuming there is
+                        // still space in the buffer.
+                        //
+                        if(ulCount > ulIdx)
+                        {
+                            ulCount -= ulIdx;
+                            if(ulCount > n)
+                            {
+                                ulCount = n;
+                            }
+                            n = -ulCount;
+
+                            while(ulCount--)
+                            {
+                                *s++ = ' ';
+                            }
+                        }
+                    }
+
+                    //
+                    // Update the conversion count.  This will be the number of
+                    // characters that should have been written, even if there
+                    // was not room in the buffer.
+                    //
+                    iConvertCount += ulIdx;
+
+                    //
+                    // This command has been handled.
+                    //
+                    break;
+                }
+
+                //
+                // Handle the %u command.
+                //
+                case 'u':
+                {
+                    //
+                    // Get the value from the varargs.
+                    //
+                    ulValue = va_arg(arg, unsigned long);
+
+                    //
+                    // Set the base to 10.
+                    //
+                    ulBase = 10;
+
+                    //
+                    // Indicate that the value is positive so that a minus sign
+                    // isn't inserted.
+                    //
+                    ulNeg = 0;
+
+                    //
+                    // Convert the value to ASCII.
+                    //
+                    goto convert;
+                }
+
+                //
+                // Handle the %x and %X commands.  Note that they are treated
+                // identically; that is, %X will use lower case letters for a-f
+                // instead of the upper case letters is should use.  We also
+                // alias %p to %x.
+                //
+                case 'x':
+                case 'X':
+                case 'p':
+                {
+                    //
+                    // Get the value from the varargs.
+                    //
+                    ulValue = va_arg(arg, unsigned long);
+
+                    //
+                    // Set the base to 16.
+                    //
+                    ulBase = 16;
+
+                    //
+                    // Indicate that the value is positive so that a minus sign
+                    // isn't inserted.
+                    //
+                    ulNeg = 0;
+
+                    //
+                    // Determine the number of digits in the string version of
+                    // the value.
+                    //
+convert:
+                    for(ulIdx = 1;
+                        (((ulIdx * ulBase) <= ulValue) &&
+                         (((ulIdx * ulBase) / ulBase) == ulIdx));
+                        ulIdx *= ulBase, ulCount--)
+                    {
+                    }
+
+                    //
+                    // If the value is negative, reduce the count of padding
+                    // characters needed.
+                    //
+                    if(ulNeg)
+                    {
+                        ulCount--;
+                    }
+
+                    //
+                    // If the value is negative and the value is padded with
+                    // zeros, then place the minus sign before the padding.
+                    //
+                    if(ulNeg && (n != 0) && (cFill == '0'))
+                    {
+                        //
+                        // Place the minus sign in the output buffer.
+                        //
+                        *s++ = '-';
+                        n--;
+
+                        //
+                        // Update the conversion count.
+                        //
+                        iConvertCount++;
+
+                        //
+                        // The minus sign has been placed, so turn off the
+                        // negative flag.
+                        //
+                        ulNeg = 0;
+                    }
+
+                    //
+                    // See if there are more characters in the specified field
+                    // width than there are in the conversion of this value.
+                    //
+                    if((ulCount > 1) && (ulCount < 65536))
+                    {
+                        //
+                        // Loop through the required padding characters.
+                        //
+                        for(ulCount--; ulCount; ulCount--)
+                        {
+                            //
+                            // Copy the character to the output buffer if there
+                            // is room.
+                            //
+                            if(n != 0)
+                            {
+                                *s++ = cFill;
+                                n--;
+                            }
+
+                            //
+                            // Update the conversion count.
+                            //
+                            iConvertCount++;
+                        }
+                    }
+
+                    //
+                    // If the value is negative, then place the minus sign
+                    // before the number.
+                    //
+                    if(ulNeg && (n != 0))
+                    {
+                        //
+                        // Place the minus sign in the output buffer.
+                        //
+                        *s++ = '-';
+                        n--;
+
+                        //
+                        // Update the conversion count.
+                        //
+                        iConvertCount++;
+                    }
+
+                    //
+                    // Convert the value into a string.
+                    //
+                    for(; ulIdx; ulIdx /= ulBase)
+                    {
+                        //
+                        // Copy the character to the output buffer if there is
+                        // room.
+                        //
+                        if(n != 0)
+                        {
+                            *s++ = g_pcHex[(ulValue / ulIdx) % ulBase];
+                            n--;
+                        }
+
+                        //
+                        // Update the conversion count.
+                        //
+                        iConvertCount++;
+                    }
+
+                    //
+                    // This command has been handled.
+                    //
+                    break;
+                }
+
+                //
+                // Handle the %% command.
+                //
+                case '%':
+                {
+                    //
+                    // Simply write a single %.
+                    //
+                    if(n != 0)
+                    {
+                        *s++ = format[-1];
+                        n--;
+                    }
+
+                    //
+                    // Update the conversion count.
+                    //
+                    iConvertCount++;
+
+                    //
+                    // This command has been handled.
+                    //
+                    break;
+                }
+
+                //
+                // Handle all other commands.
+                //
+                default:
+                {
+                    //
+                    // Indicate an error.
+                    //
+                    if(n >= 5)
+                    {
+                        ustrncpy(s, "ERROR", 5);
+                        s += 5;
+                        n -= 5;
+                    }
+                    else
+                    {
+                        ustrncpy(s, "ERROR", n);
+                        s += n;
+                        n = 0;
+                    }
+
+                    //
+                    // Update the conversion count.
+                    //
+                    iConvertCount += 5;
+
+                    //
+                    // This command has been handled.
+                    //
+                    break;
+                }
+            }
+        }
+    }
+
+    //
+    // Null terminate the string in the buffer.
+    //
+    *s = 0;
+
+    //
+    // Return the number of characters in the full converted string.
+    //
+    return(iConvertCount);
+}
@@ -0,0 +1,1121 @@
+//*****************************************************************************
+//
+// fontwrapper.c - A font wrapper which caches glyphs read from a FAT file
+//               system or SPI flash.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib/debug.h"
+#include "grlib/grlib.h"
+#include "third_party/fatfs/src/ff.h"
+#include "utils/spi_flash.h"
+#include "utils/fontwrapper.h"
+
+//*****************************************************************************
+//
+//! \addtogroup fontwrapper_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The value used to indicate the absence of an entry in the hash chains and
+// the least recently used list.
+//
+//*****************************************************************************
+#define ENTRY_NONE              0xffff
+
+//*****************************************************************************
+//
+// Returns a pointer to the glyph cache entry with the given index.
+//
+//*****************************************************************************
+#define EntryGet(psData, ui32Idx)                                             \
+        ((tFontWrapperEntry *)((psData)->pui8Entries +                        \
+                               ((ui32Idx) * FONT_WRAPPER_ENTRY_SIZE)))
+
+//*****************************************************************************
+//
+// Returns a pointer to the glyph data that follows an entry header.  The
+// first byte is zero if the glyph is not present in the font.
+//
+//*****************************************************************************
+#define EntryDataGet(psEntry)   ((uint8_t *)((psEntry) + 1))
+
+//*****************************************************************************
+//
+// A glyph which is to be read by FontWrapperPrefetch().
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The codepoint of the glyph.
+    //
+    uint32_t ui32CodePoint;
+
+    //
+    // The offset of the glyph's entry in the glyph offset table, and then the
+    // offset of the glyph data, within the font storage.  This is zero once
+    // the glyph has been dealt with.
+    //
+    uint32_t ui32Offset;
+
+    //
+    // The offset of the glyph offset table within the font storage.
+    //
+    uint32_t ui32TableOffset;
+}
+tPrefetch;
+
+//*****************************************************************************
+//
+// Reads data from the font storage, returning the number of bytes read.
+//
+//*****************************************************************************
+static uint32_t
+FontRead(tFontWrapperData *psData, uint32_t ui32Offset, void *pvData,
+         uint32_t ui32Count)
+{
+    UINT uiRead;
+
+    psData->ui32Reads++;
+
+    //
+    // Read from the SPI flash if the font is stored there.
+    //
+    if(psData->ui32SSIBase)
+    {
+        SPIFlashRead(psData->ui32SSIBase, psData->ui32FlashAddr + ui32Offset,
+                     pvData, ui32Count);
+        return(ui32Count);
+    }
+
+    //
+    // Otherwise, read from the font file.
+    //
+    if((f_lseek(&psData->sFile, ui32Offset) != FR_OK) ||
+       (f_read(&psData->sFile, pvData, ui32Count, &uiRead) != FR_OK))
+    {
+        return(0);
+    }
+    return(uiRead);
+}
+
+//*****************************************************************************
+//
+// Computes the hash bucket for a codepoint.
+//
+//*****************************************************************************
+static uint32_t
+HashGet(uint32_t ui32CodePoint)
+{
+    return(((ui32CodePoint * 0x9e3779b1) >> 16) &
+           (FONT_WRAPPER_HASH_BUCKETS - 1));
+}
+
+//*****************************************************************************
+//
+// Removes an entry from the least recently used list.
+//
+//*****************************************************************************
+static void
+ListRemove(tFontWrapperData *psData, uint32_t ui32Idx)
+{
+    tFontWrapperEntry *psEntry;
+
+    psEntry = EntryGet(psData, ui32Idx);
+
+    if(psEntry->ui16Newer == ENTRY_NONE)
+    {
+        psData->ui16Newest = psEntry->ui16Older;
+    }
+    else
+    {
+        EntryGet(psData, psEntry->ui16Newer)->ui16Older = psEntry->ui16Older;
+    }
+
+    if(psEntry->ui16Older == ENTRY_NONE)
+    {
+        psData->ui16Oldest = psEntry->ui16Newer;
+    }
+    else
+    {
+        EntryGet(psData, psEntry->ui16Older)->ui16Newer = psEntry->ui16Newer;
+    }
+}
+
+//*****************************************************************************
+//
+// Inserts an entry at either the most or least recently used end of the
+// least recently used list.
+//
+//*****************************************************************************
+static void
+ListInsert(tFontWrapperData *psData, uint32_t ui32Idx, bool bNewest)
+{
+    tFontWrapperEntry *psEntry;
+
+    psEntry = EntryGet(psData, ui32Idx);
+
+    if(bNewest)
+    {
+        psEntry->ui16Newer = ENTRY_NONE;
+        psEntry->ui16Older = psData->ui16Newest;
+        if(psData->ui16Newest == ENTRY_NONE)
+        {
+            psData->ui16Oldest = ui32Idx;
+        }
+        else
+        {
+            EntryGet(psData, psData->ui16Newest)->ui16Newer = ui32Idx;
+        }
+        psData->ui16Newest = ui32Idx;
+    }
+    else
+    {
+        psEntry->ui16Older = ENTRY_NONE;
+        psEntry->ui16Newer = psData->ui16Oldest;
+        if(psData->ui16Oldest == ENTRY_NONE)
+        {
+            psData->ui16Newest = ui32Idx;
+        }
+        else
+        {
+            EntryGet(psData, psData->ui16Oldest)->ui16Older = ui32Idx;
+        }
+        psData->ui16Oldest = ui32Idx;
+    }
+}
+
+//*****************************************************************************
+//
+// Removes an entry from its hash chain, if it is in one.
+//
+//*****************************************************************************
+static void
+HashRemove(tFontWrapperData *psData, uint32_t ui32Idx)
+{
+    tFontWrapperEntry *psEntry;
+    uint16_t *pui16Link;
+
+    psEntry = EntryGet(psData, ui32Idx);
+
+    //
+    // Entries which do not hold a glyph are not in any hash chain.
+    //
+    if(!psEntry->ui32CodePoint)
+    {
+        return;
+    }
+
+    //
+    // Find the link which refers to this entry and replace it with the link
+    // to the following entry.
+    //
+    pui16Link = &psData->pui16Hash[HashGet(psEntry->ui32CodePoint)];
+    while(*pui16Link != ENTRY_NONE)
+    {
+        if(*pui16Link == ui32Idx)
+        {
+            *pui16Link = psEntry->ui16HashNext;
+            break;
+        }
+        pui16Link = &EntryGet(psData, *pui16Link)->ui16HashNext;
+    }
+}
+
+//*****************************************************************************
+//
+// Finds the glyph cache entry holding a codepoint, making it the most
+// recently used entry.  Returns ENTRY_NONE if the codepoint is not cached.
+//
+//*****************************************************************************
+static uint32_t
+EntryFind(tFontWrapperData *psData, uint32_t ui32CodePoint)
+{
+    tFontWrapperEntry *psEntry;
+    uint32_t ui32Idx;
+
+    for(ui32Idx = psData->pui16Hash[HashGet(ui32CodePoint)];
+        ui32Idx != ENTRY_NONE; ui32Idx = psEntry->ui16HashNext)
+    {
+        psEntry = EntryGet(psData, ui32Idx);
+        if(psEntry->ui32CodePoint == ui32CodePoint)
+        {
+            ListRemove(psData, ui32Idx);
+            ListInsert(psData, ui32Idx, true);
+            return(ui32Idx);
+        }
+    }
+
+    return(ENTRY_NONE);
+}
+
+//*****************************************************************************
+//
+// Allocates a glyph cache entry for a codepoint, discarding the least
+// recently used entry if there are no unused entries, and makes it the most
+// recently used entry.
+//
+//*****************************************************************************
+static tFontWrapperEntry *
+EntryAlloc(tFontWrapperData *psData, uint32_t ui32CodePoint)
+{
+    tFontWrapperEntry *psEntry;
+    uint32_t ui32Idx, ui32Hash;
+
+    //
+    // Use an unused entry if there is one, otherwise discard the least
+    // recently used entry.
+    //
+    if(psData->ui16NumUsed < psData->ui16NumEntries)
+    {
+        ui32Idx = psData->ui16NumUsed++;
+    }
+    else
+    {
+        ui32Idx = psData->ui16Oldest;
+        ListRemove(psData, ui32Idx);
+        HashRemove(psData, ui32Idx);
+    }
+    psEntry = EntryGet(psData, ui32Idx);
+
+    //
+    // Add the entry to the cache as the most recently used.
+    //
+    ui32Hash = HashGet(ui32CodePoint);
+    psEntry->ui32CodePoint = ui32CodePoint;
+    psEntry->ui16HashNext = psData->pui16Hash[ui32Hash];
+    psData->pui16Hash[ui32Hash] = ui32Idx;
+    ListInsert(psData, ui32Idx, true);
+
+    return(psEntry);
+}
+
+//*****************************************************************************
+//
+// Discards the glyph held in a glyph cache entry, making the entry the first
+// to be reused.  This is used when the glyph could not be read.
+//
+//*****************************************************************************
+static void
+EntryDiscard(tFontWrapperData *psData, tFontWrapperEntry *psEntry)
+{
+    uint32_t ui32Idx;
+
+    ui32Idx = ((uint8_t *)psEntry - psData->pui8Entries) /
+              FONT_WRAPPER_ENTRY_SIZE;
+    HashRemove(psData, ui32Idx);
+    psEntry->ui32CodePoint = 0;
+    ListRemove(psData, ui32Idx);
+    ListInsert(psData, ui32Idx, false);
+}
+
+//*****************************************************************************
+//
+// Finds the block of the font which contains a codepoint, returning 0 if
+// the codepoint is not in any block.  The block which contained the previous
+// codepoint is checked first, and the sorted block table is then binary
+// searched.
+//
+//*****************************************************************************
+static const tFontBlock *
+BlockFind(tFontWrapperData *psData, uint32_t ui32CodePoint)
+{
+    const tFontBlock *psBlock;
+    uint32_t ui32Low, ui32High, ui32Mid;
+
+    psBlock = psData->psBlocks + psData->ui16LastBlock;
+    if((ui32CodePoint - psBlock->ui32StartCodepoint) <
+       psBlock->ui32NumCodepoints)
+    {
+        return(psBlock);
+    }
+
+    ui32Low = 0;
+    ui32High = psData->sFontHeader.ui16NumBlocks;
+    while(ui32Low < ui32High)
+    {
+        ui32Mid = (ui32Low + ui32High) / 2;
+        psBlock = psData->psBlocks + ui32Mid;
+        if(ui32CodePoint < psBlock->ui32StartCodepoint)
+        {
+            ui32High = ui32Mid;
+        }
+        else if((ui32CodePoint - psBlock->ui32StartCodepoint) >=
+                psBlock->ui32NumCodepoints)
+        {
+            ui32Low = ui32Mid + 1;
+        }
+        else
+        {
+            psData->ui16LastBlock = ui32Mid;
+            return(psBlock);
+        }
+    }
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Copies a glyph from the read buffer into a glyph cache entry, given the
+// number of bytes of the read buffer which are valid from the start of the
+// glyph.  Returns false if the read buffer does not hold the whole glyph.
+//
+//*****************************************************************************
+static bool
+GlyphCopy(uint8_t *pui8Dst, const uint8_t *pui8Src, uint32_t ui32Avail)
+{
+    uint32_t ui32Idx;
+
+    //
+    // Glyphs which are too large to cache are treated as absent.
+    //
+    if(ui32Avail && ((pui8Src[0] < 2) ||
+                     (pui8Src[0] > FONT_WRAPPER_MAX_GLYPH_SIZE)))
+    {
+        pui8Dst[0] = 0;
+        return(true);
+    }
+
+    //
+    // Make sure that the whole glyph was read.
+    //
+    if(!ui32Avail || (pui8Src[0] > ui32Avail))
+    {
+        return(false);
+    }
+
+    for(ui32Idx = 0; ui32Idx < pui8Src[0]; ui32Idx++)
+    {
+        pui8Dst[ui32Idx] = pui8Src[ui32Idx];
+    }
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Reads a single glyph from the font storage into a glyph cache entry.  The
+// glyph offset table entry is read first, followed by enough data to hold
+// the largest glyph so that the glyph is read in a single operation.
+// Returns false if the font storage could not be read.
+//
+//*****************************************************************************
+static bool
+GlyphRead(tFontWrapperData *psData, const tFontBlock *psBlock,
+          uint32_t ui32CodePoint, uint8_t *pui8Glyph)
+{
+    uint32_t ui32Offset, ui32Avail;
+
+    //
+    // Read the offset of the glyph from the block's glyph offset table.
+    //
+    if(FontRead(psData, (psBlock->ui32GlyphTableOffset +
+                         ((ui32CodePoint - psBlock->ui32StartCodepoint) *
+                          sizeof(uint32_t))),
+                &ui32Offset, sizeof(uint32_t)) != sizeof(uint32_t))
+    {
+        return(false);
+    }
+
+    //
+    // An offset of zero indicates that the glyph is not in the font.
+    //
+    if(!ui32Offset)
+    {
+        pui8Glyph[0] = 0;
+        return(true);
+    }
+
+    //
+    // Read the glyph data, which is relative to the glyph offset table, and
+    // copy it into the entry.
+    //
+    ui32Avail = FontRead(psData, psBlock->ui32GlyphTableOffset + ui32Offset,
+                         psData->pui8Read, FONT_WRAPPER_MAX_GLYPH_SIZE);
+    return(GlyphCopy(pui8Glyph, psData->pui8Read, ui32Avail));
+}
+
+//*****************************************************************************
+//
+// Returns information about a font loaded by the cached font wrapper.
+//
+//*****************************************************************************
+static void
+FontWrapperInfoGet(uint8_t *pui8FontId, uint8_t *pui8Format,
+                   uint8_t *pui8Width, uint8_t *pui8Height,
+                   uint8_t *pui8Baseline)
+{
+    tFontWrapperData *psData;
+
+    ASSERT(pui8FontId);
+    ASSERT(pui8Format);
+    ASSERT(pui8Width);
+    ASSERT(pui8Height);
+    ASSERT(pui8Baseline);
+
+    psData = (tFontWrapperData *)pui8FontId;
+    ASSERT(psData->bInUse);
+
+    *pui8Format = psData->sFontHeader.ui8Format;
+    *pui8Width = psData->sFontHeader.ui8MaxWidth;
+    *pui8Height = psData->sFontHeader.ui8Height;
+    *pui8Baseline = psData->sFontHeader.ui8Baseline;
+}
+
+//*****************************************************************************
+//
+// Retrieves the data for a glyph of a font loaded by the cached font wrapper,
+// reading it from the font storage if it is not in the glyph cache.  The
+// returned pointer remains valid until the glyph is discarded from the
+// cache, which does not happen before another glyph is requested.
+//
+//*****************************************************************************
+static const uint8_t *
+FontWrapperGlyphDataGet(uint8_t *pui8FontId, uint32_t ui32CodePoint,
+                        uint8_t *pui8Width)
+{
+    tFontWrapperData *psData;
+    tFontWrapperEntry *psEntry;
+    const tFontBlock *psBlock;
+    uint8_t *pui8Glyph;
+    uint32_t ui32Idx;
+
+    ASSERT(pui8FontId);
+    ASSERT(pui8Width);
+
+    //
+    // The null codepoint never has a glyph.
+    //
+    if(!ui32CodePoint)
+    {
+        return(0);
+    }
+
+    psData = (tFontWrapperData *)pui8FontId;
+    ASSERT(psData->bInUse);
+
+    //
+    // Look for the glyph in the cache.
+    //
+    ui32Idx = EntryFind(psData, ui32CodePoint);
+    if(ui32Idx != ENTRY_NONE)
+    {
+        psData->ui32Hits++;
+        psEntry = EntryGet(psData, ui32Idx);
+    }
+    else
+    {
+        //
+        // Codepoints outside every block are not in the font, and are not
+        // cached since this is known without reading the font storage.
+        //
+        psBlock = BlockFind(psData, ui32CodePoint);
+        if(!psBlock)
+        {
+            return(0);
+        }
+
+        //
+        // Read the glyph into a new cache entry.
+        //
+        psData->ui32Misses++;
+        psEntry = EntryAlloc(psData, ui32CodePoint);
+        if(!GlyphRead(psData, psBlock, ui32CodePoint, EntryDataGet(psEntry)))
+        {
+            EntryDiscard(psData, psEntry);
+            return(0);
+        }
+    }
+
+    //
+    // Return the glyph, unless it is not present in the font.
+    //
+    pui8Glyph = EntryDataGet(psEntry);
+    if(!pui8Glyph[0])
+    {
+        return(0);
+    }
+    *pui8Width = pui8Glyph[1];
+    return(pui8Glyph);
+}
+
+//*****************************************************************************
+//
+// Returns the codepage used by a font loaded by the cached font wrapper.
+//
+//*****************************************************************************
+static uint16_t
+FontWrapperCodepageGet(uint8_t *pui8FontId)
+{
+    ASSERT(pui8FontId);
+    ASSERT(((tFontWrapperData *)pui8FontId)->bInUse);
+
+    return(((tFontWrapperData *)pui8FontId)->sFontHeader.ui16Codepage);
+}
+
+//*****************************************************************************
+//
+// Returns the number of codepoint blocks in a font loaded by the cached font
+// wrapper.
+//
+//*****************************************************************************
+static uint16_t
+FontWrapperNumBlocksGet(uint8_t *pui8FontId)
+{
+    ASSERT(pui8FontId);
+    ASSERT(((tFontWrapperData *)pui8FontId)->bInUse);
+
+    return(((tFontWrapperData *)pui8FontId)->sFontHeader.ui16NumBlocks);
+}
+
+//*****************************************************************************
+//
+// Returns the codepoints held in a block of a font loaded by the cached font
+// wrapper.  Blocks are numbered in order of their starting codepoints.
+//
+//*****************************************************************************
+static uint32_t
+FontWrapperBlockCodepointsGet(uint8_t *pui8FontId, uint16_t ui16BlockIndex,
+                              uint32_t *pui32Start)
+{
+    tFontWrapperData *psData;
+
+    ASSERT(pui8FontId);
+    ASSERT(pui32Start);
+
+    psData = (tFontWrapperData *)pui8FontId;
+    ASSERT(psData->bInUse);
+
+    if(ui16BlockIndex >= psData->sFontHeader.ui16NumBlocks)
+    {
+        return(0);
+    }
+
+    *pui32Start = psData->psBlocks[ui16BlockIndex].ui32StartCodepoint;
+    return(psData->psBlocks[ui16BlockIndex].ui32NumCodepoints);
+}
+
+//*****************************************************************************
+//
+//! The access functions which are placed in the tFontWrapper structure of a
+//! font loaded by the cached font wrapper.
+//
+//*****************************************************************************
+const tFontAccessFuncs g_sFontWrapperAccessFuncs =
+{
+    FontWrapperInfoGet,
+    FontWrapperGlyphDataGet,
+    FontWrapperCodepageGet,
+    FontWrapperNumBlocksGet,
+    FontWrapperBlockCodepointsGet
+};
+
+//*****************************************************************************
+//
+// Reads the header and block table of a font from its storage and prepares
+// the glyph cache.  Returns the font identifier, or 0 on error.
+//
+//*****************************************************************************
+static uint8_t *
+FontLoad(tFontWrapperData *psData, void *pvBuffer, uint32_t ui32Size)
+{
+    uint32_t ui32Loop, ui32Pos, ui32Count, ui32NumEntries;
+    tFontBlock sBlock;
+
+    //
+    // Read the font header and check that the font is in a supported
+    // format.  Anti-aliased fonts are not supported since the size of their
+    // glyphs is not limited to 255 bytes.
+    //
+    psData->ui32Reads = 0;
+    psData->ui32Hits = 0;
+    psData->ui32Misses = 0;
+    if((FontRead(psData, 0, &psData->sFontHeader, sizeof(tFontWide)) !=
+        sizeof(tFontWide)) ||
+       ((psData->sFontHeader.ui8Format != FONT_FMT_WIDE_UNCOMPRESSED) &&
+        (psData->sFontHeader.ui8Format != FONT_FMT_WIDE_PIXEL_RLE)) ||
+       !psData->sFontHeader.ui16NumBlocks)
+    {
+        return(0);
+    }
+
+    //
+    // The block table is held at the start of the buffer, and the rest of
+    // the buffer holds the glyph cache, which must hold at least one entry.
+    //
+    ui32Count = psData->sFontHeader.ui16NumBlocks * sizeof(tFontBlock);
+    if(ui32Size < (ui32Count + FONT_WRAPPER_ENTRY_SIZE))
+    {
+        return(0);
+    }
+    ui32NumEntries = (ui32Size - ui32Count) / FONT_WRAPPER_ENTRY_SIZE;
+    if(ui32NumEntries > (ENTRY_NONE - 1))
+    {
+        ui32NumEntries = ENTRY_NONE - 1;
+    }
+
+    //
+    // Read the whole block table in a single operation.
+    //
+    psData->psBlocks = pvBuffer;
+    if(FontRead(psData, sizeof(tFontWide), psData->psBlocks, ui32Count) !=
+       ui32Count)
+    {
+        return(0);
+    }
+
+    //
+    // Sort the block table by starting codepoint so that it can be binary
+    // searched.  The fonts produced by ftrasterize are already sorted, so
+    // this normally does nothing.
+    //
+    for(ui32Loop = 1; ui32Loop < psData->sFontHeader.ui16NumBlocks;
+        ui32Loop++)
+    {
+        sBlock = psData->psBlocks[ui32Loop];
+        for(ui32Pos = ui32Loop;
+            (ui32Pos > 0) &&
+            (psData->psBlocks[ui32Pos - 1].ui32StartCodepoint >
+             sBlock.ui32StartCodepoint); ui32Pos--)
+        {
+            psData->psBlocks[ui32Pos] = psData->psBlocks[ui32Pos - 1];
+        }
+        psData->psBlocks[ui32Pos] = sBlock;
+    }
+
+    //
+    // Start with an empty glyph cache.
+    //
+    psData->pui8Entries = (uint8_t *)pvBuffer + ui32Count;
+    psData->ui16NumEntries = ui32NumEntries;
+    psData->ui16NumUsed = 0;
+    psData->ui16Newest = ENTRY_NONE;
+    psData->ui16Oldest = ENTRY_NONE;
+    psData->ui16LastBlock = 0;
+    for(ui32Loop = 0; ui32Loop < FONT_WRAPPER_HASH_BUCKETS; ui32Loop++)
+    {
+        psData->pui16Hash[ui32Loop] = ENTRY_NONE;
+    }
+
+    psData->bInUse = true;
+    return((uint8_t *)psData);
+}
+
+//*****************************************************************************
+//
+//! Loads a font from the FAT file system.
+//!
+//! \param psData is a pointer to the structure which holds the state of the
+//! loaded font.
+//! \param pcFilename is the name of the font file.
+//! \param pvBuffer is a pointer to the buffer which holds the font's block
+//! table and glyph cache.
+//! \param ui32Size is the size of the buffer in bytes.
+//!
+//! This function opens a font in the binary format produced by ftrasterize
+//! (as found in grlib/binfonts) and prepares it for use by the graphics
+//! library.  The FAT file system must already be mounted.  The returned
+//! value should be written into the \e pui8FontId field of a tFontWrapper
+//! structure whose \e pFuncs field points to g_sFontWrapperAccessFuncs and
+//! whose \e ui8Format field is FONT_FMT_WRAPPED.
+//!
+//! The font's block table is read into the start of \e pvBuffer, so that the
+//! block containing a glyph is found without reading the file, and the
+//! remainder of the buffer is used to cache the most recently used glyphs.
+//! FontWrapperBufferSize() may be used to determine the size of buffer
+//! required for a given number of cached glyphs.  \e pvBuffer must be
+//! aligned to a 4 byte boundary.
+//!
+//! \return Returns a non-zero pointer identifying the font on success, or 0
+//! if the file could not be read, is not in a supported format, or its block
+//! table and at least one glyph do not fit in the buffer.
+//
+//*****************************************************************************
+uint8_t *
+FontWrapperFATLoad(tFontWrapperData *psData, const char *pcFilename,
+                   void *pvBuffer, uint32_t ui32Size)
+{
+    uint8_t *pui8FontId;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psData);
+    ASSERT(pcFilename);
+    ASSERT(pvBuffer);
+    ASSERT(((uint32_t)pvBuffer & 3) == 0);
+
+    //
+    // Open the font file.
+    //
+    psData->bInUse = false;
+    psData->ui32SSIBase = 0;
+    psData->ui32FlashAddr = 0;
+    if(f_open(&psData->sFile, pcFilename, FA_READ) != FR_OK)
+    {
+        return(0);
+    }
+
+    //
+    // Read the font, closing the file if it could not be read.
+    //
+    pui8FontId = FontLoad(psData, pvBuffer, ui32Size);
+    if(!pui8FontId)
+    {
+        f_close(&psData->sFile);
+    }
+
+    return(pui8FontId);
+}
+
+//*****************************************************************************
+//
+//! Loads a font from SPI flash.
+//!
+//! \param psData is a pointer to the structure which holds the state of the
+//! loaded font.
+//! \param ui32Base is the base address of the SSI module connected to the SPI
+//! flash.
+//! \param ui32Addr is the address of the font within the SPI flash.
+//! \param pvBuffer is a pointer to the buffer which holds the font's block
+//! table and glyph cache.
+//! \param ui32Size is the size of the buffer in bytes.
+//!
+//! This function prepares a font in the binary format produced by
+//! ftrasterize (as found in grlib/binfonts), which has been programmed into
+//! SPI flash, for use by the graphics library.  The SSI module must already
+//! be configured for use with the SPI flash by SPIFlashInit().  The returned
+//! value is used in the same way as that of FontWrapperFATLoad(), and
+//! \e pvBuffer is used in the same way.
+//!
+//! \return Returns a non-zero pointer identifying the font on success, or 0
+//! if the font is not in a supported format or its block table and at least
+//! one glyph do not fit in the buffer.
+//
+//*****************************************************************************
+uint8_t *
+FontWrapperSPIFlashLoad(tFontWrapperData *psData, uint32_t ui32Base,
+                        uint32_t ui32Addr, void *pvBuffer, uint32_t ui32Size)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psData);
+    ASSERT(ui32Base);
+    ASSERT(pvBuffer);
+    ASSERT(((uint32_t)pvBuffer & 3) == 0);
+
+    //
+    // Read the font from the SPI flash.
+    //
+    psData->bInUse = false;
+    psData->ui32SSIBase = ui32Base;
+    psData->ui32FlashAddr = ui32Addr;
+    return(FontLoad(psData, pvBuffer, ui32Size));
+}
+
+//*****************************************************************************
+//
+//! Releases a font loaded by the cached font wrapper.
+//!
+//! \param pui8FontId is the font identifier returned when the font was
+//! loaded.
+//!
+//! This function closes the font file of a font loaded from the FAT file
+//! system.  The font must not be used after this call, and the buffer
+//! provided when it was loaded may be reused.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FontWrapperUnload(uint8_t *pui8FontId)
+{
+    tFontWrapperData *psData;
+
+    ASSERT(pui8FontId);
+
+    psData = (tFontWrapperData *)pui8FontId;
+    if(!psData->bInUse)
+    {
+        return;
+    }
+
+    if(!psData->ui32SSIBase)
+    {
+        f_close(&psData->sFile);
+    }
+    psData->bInUse = false;
+}
+
+//*****************************************************************************
+//
+// Sorts the glyphs to be read by FontWrapperPrefetch() by their offset
+// within the font storage.
+//
+//*****************************************************************************
+static void
+PrefetchSort(tPrefetch *psPrefetch, uint32_t ui32Num)
+{
+    uint32_t ui32Loop, ui32Pos;
+    tPrefetch sPrefetch;
+
+    for(ui32Loop = 1; ui32Loop < ui32Num; ui32Loop++)
+    {
+        sPrefetch = psPrefetch[ui32Loop];
+        for(ui32Pos = ui32Loop;
+            (ui32Pos > 0) &&
+            (psPrefetch[ui32Pos - 1].ui32Offset > sPrefetch.ui32Offset);
+            ui32Pos--)
+        {
+            psPrefetch[ui32Pos] = psPrefetch[ui32Pos - 1];
+        }
+        psPrefetch[ui32Pos] = sPrefetch;
+    }
+}
+
+//*****************************************************************************
+//
+//! Reads the glyphs needed to draw a string into the glyph cache.
+//!
+//! \param psContext is a pointer to the drawing context whose font is a
+//! font loaded by the cached font wrapper.
+//! \param pcString is a pointer to the string to be drawn.
+//! \param i32Length is the number of bytes of the string to be considered, or
+//! -1 to consider the whole of a NULL terminated string.
+//!
+//! This function may be called before drawing a string to read the glyphs of
+//! all of its characters which are not already in the glyph cache in as few
+//! operations on the font storage as possible, rather than reading each
+//! glyph as it is drawn.  The glyph offset table entries of the missing
+//! glyphs are read first, combining entries which lie close together in the
+//! font into a single read, and the glyph data is then read in the same way.
+//! Characters are mapped to the font's codepoints using the context's
+//! codepage mapping, exactly as they are when the string is drawn.
+//!
+//! At most FONT_WRAPPER_PREFETCH_GLYPHS glyphs, and no more glyphs than the
+//! glyph cache holds, are read by each call.
+//!
+//! \return Returns the number of glyphs read into the glyph cache.
+//
+//*****************************************************************************
+uint32_t
+FontWrapperPrefetch(const tContext *psContext, const char *pcString,
+                    int32_t i32Length)
+{
+    tPrefetch psPrefetch[FONT_WRAPPER_PREFETCH_GLYPHS];
+    uint32_t ui32Num, ui32Max, ui32Count, ui32Skip, ui32Char, ui32Loop;
+    uint32_t ui32First, ui32Last, ui32Avail, ui32Pos, ui32Loaded;
+    tFontWrapperData *psData;
+    tFontWrapperEntry *psEntry;
+    const tFontBlock *psBlock;
+    const uint8_t *pui8Entry;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psContext);
+    ASSERT(pcString);
+    ASSERT(psContext->psFont->ui8Format == FONT_FMT_WRAPPED);
+    ASSERT(((tFontWrapper *)psContext->psFont)->pFuncs ==
+           &g_sFontWrapperAccessFuncs);
+
+    psData = (tFontWrapperData *)((tFontWrapper *)psContext->psFont)->
+             pui8FontId;
+    ASSERT(psData->bInUse);
+
+    //
+    // Find the characters of the string which are in the font but not in
+    // the glyph cache.  Those which are in the cache are made the most
+    // recently used, so that they are not discarded to make room for the
+    // others.
+    //
+    ui32Max = ((psData->ui16NumEntries < FONT_WRAPPER_PREFETCH_GLYPHS) ?
+               psData->ui16NumEntries : FONT_WRAPPER_PREFETCH_GLYPHS);
+    ui32Count = (uint32_t)i32Length;
+    ui32Num = 0;
+    while(ui32Count && (ui32Num < ui32Max))
+    {
+        ui32Char = GrStringNextCharGet(psContext, pcString, ui32Count,
+                                       &ui32Skip);
+        if(!ui32Char)
+        {
+            break;
+        }
+        pcString += ui32Skip;
+        ui32Count -= ui32Skip;
+
+        if(EntryFind(psData, ui32Char) != ENTRY_NONE)
+        {
+            continue;
+        }
+        psBlock = BlockFind(psData, ui32Char);
+        if(!psBlock)
+        {
+            continue;
+        }
+        for(ui32Loop = 0; ui32Loop < ui32Num; ui32Loop++)
+        {
+            if(psPrefetch[ui32Loop].ui32CodePoint == ui32Char)
+            {
+                break;
+            }
+        }
+        if(ui32Loop == ui32Num)
+        {
+            psPrefetch[ui32Num].ui32CodePoint = ui32Char;
+            psPrefetch[ui32Num].ui32TableOffset =
+                psBlock->ui32GlyphTableOffset;
+            psPrefetch[ui32Num].ui32Offset =
+                (psBlock->ui32GlyphTableOffset +
+                 ((ui32Char - psBlock->ui32StartCodepoint) *
+                  sizeof(uint32_t)));
+            ui32Num++;
+        }
+    }
+
+    //
+    // Read the glyph offset table entries, combining entries which are close
+    // together into a single read, and replace the offset of each entry with
+    // the offset of its glyph.
+    //
+    PrefetchSort(psPrefetch, ui32Num);
+    for(ui32First = 0; ui32First < ui32Num; ui32First = ui32Last)
+    {
+        for(ui32Last = ui32First + 1;
+            ((ui32Last < ui32Num) &&
+             ((psPrefetch[ui32Last].ui32Offset -
+               psPrefetch[ui32Last - 1].ui32Offset) <=
+              (sizeof(uint32_t) + FONT_WRAPPER_COALESCE_GAP)) &&
+             ((psPrefetch[ui32Last].ui32Offset + sizeof(uint32_t) -
+               psPrefetch[ui32First].ui32Offset) <= FONT_WRAPPER_READ_SIZE));
+            ui32Last++)
+        {
+        }
+
+        ui32Avail = FontRead(psData, psPrefetch[ui32First].ui32Offset,
+                             psData->pui8Read,
+                             (psPrefetch[ui32Last - 1].ui32Offset +
+                              sizeof(uint32_t) -
+                              psPrefetch[ui32First].ui32Offset));
+        for(ui32Loop = ui32Last; ui32Loop > ui32First; ui32Loop--)
+        {
+            ui32Pos = (psPrefetch[ui32Loop - 1].ui32Offset -
+                       psPrefetch[ui32First].ui32Offset);
+            if((ui32Pos + sizeof(uint32_t)) > ui32Avail)
+            {
+                psPrefetch[ui32Loop - 1].ui32Offset = 0;
+                continue;
+            }
+            pui8Entry = psData->pui8Read + ui32Pos;
+            psPrefetch[ui32Loop - 1].ui32Offset = (pui8Entry[0] |
+                                                   (pui8Entry[1] << 8) |
+                                                   (pui8Entry[2] << 16) |
+                                                   (pui8Entry[3] << 24));
+
+            //
+            // Glyphs which are not in the font are cached immediately.
+            //
+            if(!psPrefetch[ui32Loop - 1].ui32Offset)
+            {
+                psEntry = EntryAlloc(psData,
+                                     psPrefetch[ui32Loop - 1].ui32CodePoint);
+                EntryDataGet(psEntry)[0] = 0;
+            }
+            else
+            {
+                psPrefetch[ui32Loop - 1].ui32Offset +=
+                    psPrefetch[ui32Loop - 1].ui32TableOffset;
+            }
+        }
+    }
+
+    //
+    // Read the glyph data in the same way.  The size of each glyph is not
+    // known until it has been read, so each read extends far enough past the
+    // start of its last glyph to hold the largest glyph.
+    //
+    PrefetchSort(psPrefetch, ui32Num);
+    ui32Loaded = 0;
+    for(ui32First = 0; ui32First < ui32Num; ui32First = ui32Last)
+    {
+        //
+        // Skip glyphs which have already been dealt with.
+        //
+        if(!psPrefetch[ui32First].ui32Offset)
+        {
+            ui32Last = ui32First + 1;
+            continue;
+        }
+
+        for(ui32Last = ui32First + 1;
+            ((ui32Last < ui32Num) &&
+             ((psPrefetch[ui32Last].ui32Offset -
+               psPrefetch[ui32Last - 1].ui32Offset) <=
+              (FONT_WRAPPER_MAX_GLYPH_SIZE + FONT_WRAPPER_COALESCE_GAP)) &&
+             ((psPrefetch[ui32Last].ui32Offset + FONT_WRAPPER_MAX_GLYPH_SIZE -
+               psPrefetch[ui32First].ui32Offset) <= FONT_WRAPPER_READ_SIZE));
+            ui32Last++)
+        {
+        }
+
+        ui32Avail = FontRead(psData, psPrefetch[ui32First].ui32Offset,
+                             psData->pui8Read,
+                             (psPrefetch[ui32Last - 1].ui32Offset +
+                              FONT_WRAPPER_MAX_GLYPH_SIZE -
+                              psPrefetch[ui32First].ui32Offset));
+
+        //
+        // Copy each glyph into the cache.  A glyph which was not completely
+        // read is left to be read when it is drawn.
+        //
+        for(ui32Loop = ui32First; ui32Loop < ui32Last; ui32Loop++)
+        {
+            ui32Pos = (psPrefetch[ui32Loop].ui32Offset -
+                       psPrefetch[ui32First].ui32Offset);
+            psEntry = EntryAlloc(psData, psPrefetch[ui32Loop].ui32CodePoint);
+            if(GlyphCopy(EntryDataGet(psEntry), psData->pui8Read + ui32Pos,
+                         (ui32Pos < ui32Avail) ? (ui32Avail - ui32Pos) : 0))
+            {
+                ui32Loaded++;
+            }
+            else
+            {
+                EntryDiscard(psData, psEntry);
+            }
+        }
+    }
+
+    return(ui32Loaded);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
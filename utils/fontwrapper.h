@@ -0,0 +1,304 @@
+//*****************************************************************************
+//
+// fontwrapper.h - Prototypes for the cached font wrapper.
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+
+#ifndef __FONTWRAPPER_H__
+#define __FONTWRAPPER_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \addtogroup fontwrapper_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! The largest glyph, in bytes, which can be held in the glyph cache.  Glyphs
+//! in the font which are larger than this are treated as absent.  The size
+//! of a glyph is held in its first byte, so no glyph is larger than 255
+//! bytes; an application using fonts with small glyphs may reduce this value
+//! by defining it prior to including this header.
+//
+//*****************************************************************************
+#ifndef FONT_WRAPPER_MAX_GLYPH_SIZE
+#define FONT_WRAPPER_MAX_GLYPH_SIZE 256
+#endif
+
+//*****************************************************************************
+//
+//! The number of hash buckets used to find glyphs in the glyph cache.  This
+//! must be a power of two.
+//
+//*****************************************************************************
+#ifndef FONT_WRAPPER_HASH_BUCKETS
+#define FONT_WRAPPER_HASH_BUCKETS 32
+#endif
+
+//*****************************************************************************
+//
+//! The size, in bytes, of the buffer used to read the glyphs of several
+//! characters from the font storage in a single operation.
+//
+//*****************************************************************************
+#ifndef FONT_WRAPPER_READ_SIZE
+#define FONT_WRAPPER_READ_SIZE  1024
+#endif
+
+//*****************************************************************************
+//
+//! The maximum number of glyphs loaded by a single call to
+//! FontWrapperPrefetch().
+//
+//*****************************************************************************
+#ifndef FONT_WRAPPER_PREFETCH_GLYPHS
+#define FONT_WRAPPER_PREFETCH_GLYPHS 32
+#endif
+
+//*****************************************************************************
+//
+//! The number of bytes by which two reads from the font storage may be
+//! separated and still be combined into a single read.
+//
+//*****************************************************************************
+#ifndef FONT_WRAPPER_COALESCE_GAP
+#define FONT_WRAPPER_COALESCE_GAP 128
+#endif
+
+//*****************************************************************************
+//
+//! This structure is the header of each entry in the glyph cache of a font
+//! loaded by the cached font wrapper.  The glyph data follows the header.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The codepoint of the glyph held in the entry, or 0 if the entry is
+    //! unused.
+    //
+    uint32_t ui32CodePoint;
+
+    //
+    //! The index of the next entry in the same hash bucket.
+    //
+    uint16_t ui16HashNext;
+
+    //
+    //! The index of the next more recently used entry.
+    //
+    uint16_t ui16Newer;
+
+    //
+    //! The index of the next less recently used entry.
+    //
+    uint16_t ui16Older;
+
+    //
+    //! Reserved for future expansion.
+    //
+    uint16_t ui16Reserved;
+}
+tFontWrapperEntry;
+
+//*****************************************************************************
+//
+//! The number of bytes of memory used by each entry of the glyph cache of a
+//! font loaded by the cached font wrapper.
+//
+//*****************************************************************************
+#define FONT_WRAPPER_ENTRY_SIZE                                               \
+        ((sizeof(tFontWrapperEntry) + FONT_WRAPPER_MAX_GLYPH_SIZE + 3) & ~3)
+
+//*****************************************************************************
+//
+//! This structure holds the state of a font loaded by the cached font
+//! wrapper.  The application provides the memory for this structure, and a
+//! buffer holding the font's block table and the glyph cache, when loading
+//! the font; the fields should not be accessed directly other than to read
+//! the statistics.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The FAT file system file holding the font, if it is read from the
+    //! FAT file system.
+    //
+    FIL sFile;
+
+    //
+    //! The base address of the SSI module connected to the SPI flash, or 0 if
+    //! the font is read from the FAT file system.
+    //
+    uint32_t ui32SSIBase;
+
+    //
+    //! The address of the font within the SPI flash.
+    //
+    uint32_t ui32FlashAddr;
+
+    //
+    //! The font header, as read from the font storage.
+    //
+    tFontWide sFontHeader;
+
+    //
+    //! The font's block table, sorted by starting codepoint.
+    //
+    tFontBlock *psBlocks;
+
+    //
+    //! The memory holding the glyph cache entries.
+    //
+    uint8_t *pui8Entries;
+
+    //
+    //! The number of entries in the glyph cache.
+    //
+    uint16_t ui16NumEntries;
+
+    //
+    //! The number of glyph cache entries currently in use.
+    //
+    uint16_t ui16NumUsed;
+
+    //
+    //! The index of the most recently used glyph cache entry.
+    //
+    uint16_t ui16Newest;
+
+    //
+    //! The index of the least recently used glyph cache entry.
+    //
+    uint16_t ui16Oldest;
+
+    //
+    //! The position within the block table of the block which contained the
+    //! most recently loaded glyph.
+    //
+    uint16_t ui16LastBlock;
+
+    //
+    //! A marker indicating whether or not the structure holds a loaded font.
+    //
+    bool bInUse;
+
+    //
+    //! The index of the first glyph cache entry in each hash bucket.
+    //
+    uint16_t pui16Hash[FONT_WRAPPER_HASH_BUCKETS];
+
+    //
+    //! The buffer used to read several glyphs in a single operation.
+    //
+    uint8_t pui8Read[FONT_WRAPPER_READ_SIZE];
+
+    //
+    //! The number of glyph requests satisfied by the glyph cache.
+    //
+    uint32_t ui32Hits;
+
+    //
+    //! The number of glyph requests which required the glyph to be read from
+    //! the font storage.
+    //
+    uint32_t ui32Misses;
+
+    //
+    //! The number of read operations made on the font storage.
+    //
+    uint32_t ui32Reads;
+}
+tFontWrapperData;
+
+//*****************************************************************************
+//
+//! Determines the size of the buffer needed by a font loaded by the cached
+//! font wrapper.
+//!
+//! \param ui32NumBlocks is the number of codepoint blocks in the font.
+//! \param ui32NumGlyphs is the number of glyphs to be held in the glyph
+//! cache.
+//!
+//! This macro determines the size of the buffer to be passed to
+//! FontWrapperFATLoad() or FontWrapperSPIFlashLoad() for a font with the
+//! given number of blocks, such that the given number of glyphs are cached.
+//!
+//! \return Returns the number of bytes required.
+//
+//*****************************************************************************
+#define FontWrapperBufferSize(ui32NumBlocks, ui32NumGlyphs)                   \
+        (((ui32NumBlocks) * sizeof(tFontBlock)) +                             \
+         ((ui32NumGlyphs) * FONT_WRAPPER_ENTRY_SIZE))
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Exported globals.
+//
+//*****************************************************************************
+extern const tFontAccessFuncs g_sFontWrapperAccessFuncs;
+
+//*****************************************************************************
+//
+// Prototypes.
+//
+//*****************************************************************************
+extern uint8_t *FontWrapperFATLoad(tFontWrapperData *psData,
+                                   const char *pcFilename, void *pvBuffer,
+                                   uint32_t ui32Size);
+extern uint8_t *FontWrapperSPIFlashLoad(tFontWrapperData *psData,
+                                        uint32_t ui32Base, uint32_t ui32Addr,
+                                        void *pvBuffer, uint32_t ui32Size);
+extern void FontWrapperUnload(uint8_t *pui8FontId);
+extern uint32_t FontWrapperPrefetch(const tContext *psContext,
+                                    const char *pcString, int32_t i32Length);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FONTWRAPPER_H__
@@ -45,6 +45,28 @@
 #define NULL                    ((void *)0)
 #endif
 
+//*****************************************************************************
+//
+// A memory barrier, used by the single-producer, single-consumer ring buffer
+// to ensure that the data in the buffer is written (or read) before the index
+// which hands it over to the other side is updated.  Only acquire and release
+// ordering is needed, so GCC emits a DMB on Cortex-M but just a compiler
+// barrier on hosts whose stores are already ordered.
+//
+//*****************************************************************************
+#if defined(ewarm)
+#include <intrinsics.h>
+#define RingBufBarrier()        __DMB()
+#elif defined(rvmdk) || defined(__ARMCC_VERSION)
+#define RingBufBarrier()        __dmb(0xf)
+#elif defined(ccs)
+#define RingBufBarrier()        __asm("    dmb")
+#elif defined(__GNUC__)
+#define RingBufBarrier()        __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#else
+#define RingBufBarrier()
+#endif
+
 //*****************************************************************************
 //
 // Change the value of a variable atomically.
@@ -704,6 +726,496 @@ RingBufInit(tRingBufObject *psRingBuf, uint8_t *pui8Buf,
     psRingBuf->ui32WriteIndex = psRingBuf->ui32ReadIndex = 0;
 }
 
+//*****************************************************************************
+//
+//! Initializes a single-producer, single-consumer ring buffer.
+//!
+//! \param psRingBuf points to the ring buffer to be initialized.
+//! \param pui8Buf points to the data buffer to be used for the ring buffer.
+//! \param ui32Size is the size of the buffer in bytes, which must be a power
+//! of two.
+//!
+//! This function initializes a ring buffer which may be written by exactly
+//! one context (for example, an application task) and read by exactly one
+//! other context (for example, an interrupt handler), without disabling
+//! interrupts.  Each index is only ever changed by one side, and a memory
+//! barrier ensures that the data is in the buffer before the index that
+//! hands it over is updated.  Unlike the ring buffers initialized by
+//! RingBufInit(), every byte of the buffer can hold data.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RingBufSPSCInit(tRingBufSPSC *psRingBuf, uint8_t *pui8Buf, uint32_t ui32Size)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(pui8Buf != NULL);
+    ASSERT(ui32Size != 0);
+    ASSERT((ui32Size & (ui32Size - 1)) == 0);
+
+    //
+    // Initialize the ring buffer object.
+    //
+    psRingBuf->pui8Buf = pui8Buf;
+    psRingBuf->ui32Mask = ui32Size - 1;
+    psRingBuf->ui32WriteCount = psRingBuf->ui32ReadCount = 0;
+}
+
+//*****************************************************************************
+//
+//! Returns the number of bytes stored in a single-producer, single-consumer
+//! ring buffer.
+//!
+//! \param psRingBuf is the ring buffer object to check.
+//!
+//! This function may be called from either side.  The value returned is
+//! exact when called by the consumer, and a lower bound when called by the
+//! producer since the consumer may remove data at any time.
+//!
+//! \return Returns the number of bytes stored in the ring buffer.
+//
+//*****************************************************************************
+uint32_t
+RingBufSPSCUsed(tRingBufSPSC *psRingBuf)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+
+    //
+    // The counts run freely, so their difference is the number of bytes
+    // stored even after they have wrapped.
+    //
+    return(psRingBuf->ui32WriteCount - psRingBuf->ui32ReadCount);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of free bytes in a single-producer, single-consumer
+//! ring buffer.
+//!
+//! \param psRingBuf is the ring buffer object to check.
+//!
+//! This function may be called from either side.  The value returned is
+//! exact when called by the producer, and a lower bound when called by the
+//! consumer since the producer may add data at any time.
+//!
+//! \return Returns the number of free bytes in the ring buffer.
+//
+//*****************************************************************************
+uint32_t
+RingBufSPSCFree(tRingBufSPSC *psRingBuf)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+
+    return((psRingBuf->ui32Mask + 1) -
+           (psRingBuf->ui32WriteCount - psRingBuf->ui32ReadCount));
+}
+
+//*****************************************************************************
+//
+//! Empties a single-producer, single-consumer ring buffer.
+//!
+//! \param psRingBuf is the ring buffer object to empty.
+//!
+//! This function discards all data in the ring buffer.  It must only be
+//! called by the consumer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RingBufSPSCFlush(tRingBufSPSC *psRingBuf)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+
+    //
+    // Release everything that the producer has written so far.
+    //
+    RingBufBarrier();
+    psRingBuf->ui32ReadCount = psRingBuf->ui32WriteCount;
+}
+
+//*****************************************************************************
+//
+//! Reserves contiguous space in a single-producer, single-consumer ring
+//! buffer for writing.
+//!
+//! \param psRingBuf is the ring buffer object to write to.
+//! \param ppui8Data is a pointer to a location which receives a pointer to
+//! the reserved space.
+//!
+//! This function returns the largest block of free space which starts at the
+//! current write position and does not straddle the end of the buffer.  The
+//! producer may fill any part of the block directly (for example, with memcpy
+//! or a uDMA transfer) and then make the data available to the consumer by
+//! calling RingBufSPSCWriteCommit().  When the free space wraps around the end
+//! of the buffer, a second call after the commit returns the remainder.  It
+//! must only be called by the producer.
+//!
+//! \return Returns the number of bytes in the reserved block, which is zero
+//! if the ring buffer is full.
+//
+//*****************************************************************************
+uint32_t
+RingBufSPSCWriteReserve(tRingBufSPSC *psRingBuf, uint8_t **ppui8Data)
+{
+    uint32_t ui32Write, ui32Free, ui32Contig;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(ppui8Data != NULL);
+
+    //
+    // Find the free space, then make sure that any reads of the space by the
+    // consumer are complete before it is written.
+    //
+    ui32Write = psRingBuf->ui32WriteCount;
+    ui32Free = (psRingBuf->ui32Mask + 1) -
+               (ui32Write - psRingBuf->ui32ReadCount);
+    RingBufBarrier();
+
+    //
+    // Limit the block to the end of the buffer.
+    //
+    ui32Write &= psRingBuf->ui32Mask;
+    ui32Contig = (psRingBuf->ui32Mask + 1) - ui32Write;
+    *ppui8Data = psRingBuf->pui8Buf + ui32Write;
+
+    return((ui32Free < ui32Contig) ? ui32Free : ui32Contig);
+}
+
+//*****************************************************************************
+//
+//! Makes data written into reserved space available to the consumer.
+//!
+//! \param psRingBuf is the ring buffer object being written to.
+//! \param ui32Length is the number of bytes written, which must not exceed
+//! the value returned by the preceding call to RingBufSPSCWriteReserve().
+//!
+//! This function publishes the first \e ui32Length bytes of the space
+//! returned by RingBufSPSCWriteReserve() to the consumer.  It must only be
+//! called by the producer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RingBufSPSCWriteCommit(tRingBufSPSC *psRingBuf, uint32_t ui32Length)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(ui32Length <= RingBufSPSCFree(psRingBuf));
+
+    //
+    // Make sure that the data is in the buffer before the consumer can see
+    // it.
+    //
+    RingBufBarrier();
+    psRingBuf->ui32WriteCount += ui32Length;
+}
+
+//*****************************************************************************
+//
+//! Returns contiguous data from a single-producer, single-consumer ring
+//! buffer without removing it.
+//!
+//! \param psRingBuf is the ring buffer object to read from.
+//! \param ppui8Data is a pointer to a location which receives a pointer to
+//! the data.
+//!
+//! This function returns the largest block of data which starts at the
+//! current read position and does not straddle the end of the buffer.  The
+//! consumer may read the block directly (for example, as the source of a uDMA
+//! transfer) and then free the space by calling RingBufSPSCReadRelease().
+//! When the data wraps around the end of the buffer, a second call after the
+//! release returns the remainder.  It must only be called by the consumer.
+//!
+//! \return Returns the number of bytes in the block, which is zero if the
+//! ring buffer is empty.
+//
+//*****************************************************************************
+uint32_t
+RingBufSPSCReadPeek(tRingBufSPSC *psRingBuf, uint8_t **ppui8Data)
+{
+    uint32_t ui32Read, ui32Used, ui32Contig;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(ppui8Data != NULL);
+
+    //
+    // Find the data available, then make sure that it is not read before
+    // the count which published it.
+    //
+    ui32Read = psRingBuf->ui32ReadCount;
+    ui32Used = psRingBuf->ui32WriteCount - ui32Read;
+    RingBufBarrier();
+
+    //
+    // Limit the block to the end of the buffer.
+    //
+    ui32Read &= psRingBuf->ui32Mask;
+    ui32Contig = (psRingBuf->ui32Mask + 1) - ui32Read;
+    *ppui8Data = psRingBuf->pui8Buf + ui32Read;
+
+    return((ui32Used < ui32Contig) ? ui32Used : ui32Contig);
+}
+
+//*****************************************************************************
+//
+//! Removes data which has been read from a single-producer, single-consumer
+//! ring buffer.
+//!
+//! \param psRingBuf is the ring buffer object being read from.
+//! \param ui32Length is the number of bytes to remove, which must not exceed
+//! the value returned by the preceding call to RingBufSPSCReadPeek().
+//!
+//! This function frees the first \e ui32Length bytes of the data returned by
+//! RingBufSPSCReadPeek(), allowing the producer to reuse the space.  It must
+//! only be called by the consumer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RingBufSPSCReadRelease(tRingBufSPSC *psRingBuf, uint32_t ui32Length)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(ui32Length <= RingBufSPSCUsed(psRingBuf));
+
+    //
+    // Make sure that the data has been read before the producer can reuse
+    // the space.
+    //
+    RingBufBarrier();
+    psRingBuf->ui32ReadCount += ui32Length;
+}
+
+//*****************************************************************************
+//
+//! Writes data to a single-producer, single-consumer ring buffer.
+//!
+//! \param psRingBuf points to the ring buffer to be written to.
+//! \param pui8Data points to the data to be written.
+//! \param ui32Length is the number of bytes to be written.
+//!
+//! This function copies as much of the data as will fit into the ring buffer
+//! and makes it available to the consumer in a single update.  It must only
+//! be called by the producer.
+//!
+//! \return Returns the number of bytes written, which is less than
+//! \e ui32Length if the ring buffer became full.
+//
+//*****************************************************************************
+uint32_t
+RingBufSPSCWrite(tRingBufSPSC *psRingBuf, const uint8_t *pui8Data,
+                 uint32_t ui32Length)
+{
+    uint32_t ui32Write, ui32Free, ui32Count;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(pui8Data != NULL);
+
+    //
+    // Limit the write to the free space.
+    //
+    ui32Write = psRingBuf->ui32WriteCount;
+    ui32Free = (psRingBuf->ui32Mask + 1) -
+               (ui32Write - psRingBuf->ui32ReadCount);
+    if(ui32Length > ui32Free)
+    {
+        ui32Length = ui32Free;
+    }
+    RingBufBarrier();
+
+    //
+    // Copy the data, wrapping at the end of the buffer.
+    //
+    for(ui32Count = 0; ui32Count < ui32Length; ui32Count++)
+    {
+        psRingBuf->pui8Buf[(ui32Write + ui32Count) & psRingBuf->ui32Mask] =
+            pui8Data[ui32Count];
+    }
+
+    //
+    // Publish the data.
+    //
+    RingBufBarrier();
+    psRingBuf->ui32WriteCount = ui32Write + ui32Length;
+
+    return(ui32Length);
+}
+
+//*****************************************************************************
+//
+//! Reads data from a single-producer, single-consumer ring buffer.
+//!
+//! \param psRingBuf points to the ring buffer to be read from.
+//! \param pui8Data points to where the data should be stored.
+//! \param ui32Length is the maximum number of bytes to be read.
+//!
+//! This function copies up to \e ui32Length bytes out of the ring buffer and
+//! frees their space in a single update.  It must only be called by the
+//! consumer.
+//!
+//! \return Returns the number of bytes read, which is less than
+//! \e ui32Length if the ring buffer became empty.
+//
+//*****************************************************************************
+uint32_t
+RingBufSPSCRead(tRingBufSPSC *psRingBuf, uint8_t *pui8Data,
+                uint32_t ui32Length)
+{
+    uint32_t ui32Read, ui32Used, ui32Count;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(pui8Data != NULL);
+
+    //
+    // Limit the read to the data available.
+    //
+    ui32Read = psRingBuf->ui32ReadCount;
+    ui32Used = psRingBuf->ui32WriteCount - ui32Read;
+    if(ui32Length > ui32Used)
+    {
+        ui32Length = ui32Used;
+    }
+    RingBufBarrier();
+
+    //
+    // Copy the data, wrapping at the end of the buffer.
+    //
+    for(ui32Count = 0; ui32Count < ui32Length; ui32Count++)
+    {
+        pui8Data[ui32Count] =
+            psRingBuf->pui8Buf[(ui32Read + ui32Count) & psRingBuf->ui32Mask];
+    }
+
+    //
+    // Free the space.
+    //
+    RingBufBarrier();
+    psRingBuf->ui32ReadCount = ui32Read + ui32Length;
+
+    return(ui32Length);
+}
+
+//*****************************************************************************
+//
+//! Writes a single byte to a single-producer, single-consumer ring buffer.
+//!
+//! \param psRingBuf points to the ring buffer to be written to.
+//! \param ui8Data is the byte to be written.
+//!
+//! This function writes one byte into the ring buffer if there is space for
+//! it.  It must only be called by the producer.
+//!
+//! \return Returns \b true if the byte was written or \b false if the ring
+//! buffer is full.
+//
+//*****************************************************************************
+bool
+RingBufSPSCWriteOne(tRingBufSPSC *psRingBuf, uint8_t ui8Data)
+{
+    uint32_t ui32Write;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+
+    //
+    // Fail if the ring buffer is full.
+    //
+    ui32Write = psRingBuf->ui32WriteCount;
+    if((ui32Write - psRingBuf->ui32ReadCount) > psRingBuf->ui32Mask)
+    {
+        return(false);
+    }
+    RingBufBarrier();
+
+    //
+    // Write the byte and publish it.
+    //
+    psRingBuf->pui8Buf[ui32Write & psRingBuf->ui32Mask] = ui8Data;
+    RingBufBarrier();
+    psRingBuf->ui32WriteCount = ui32Write + 1;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Reads a single byte from a single-producer, single-consumer ring buffer.
+//!
+//! \param psRingBuf points to the ring buffer to be read from.
+//! \param pui8Data points to where the byte should be stored.
+//!
+//! This function reads one byte from the ring buffer if it is not empty.  It
+//! must only be called by the consumer.
+//!
+//! \return Returns \b true if a byte was read or \b false if the ring buffer
+//! is empty.
+//
+//*****************************************************************************
+bool
+RingBufSPSCReadOne(tRingBufSPSC *psRingBuf, uint8_t *pui8Data)
+{
+    uint32_t ui32Read;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psRingBuf != NULL);
+    ASSERT(pui8Data != NULL);
+
+    //
+    // Fail if the ring buffer is empty.
+    //
+    ui32Read = psRingBuf->ui32ReadCount;
+    if(psRingBuf->ui32WriteCount == ui32Read)
+    {
+        return(false);
+    }
+    RingBufBarrier();
+
+    //
+    // Read the byte and free its space.
+    //
+    *pui8Data = psRingBuf->pui8Buf[ui32Read & psRingBuf->ui32Mask];
+    RingBufBarrier();
+    psRingBuf->ui32ReadCount = ui32Read + 1;
+
+    return(true);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -67,6 +67,37 @@ typedef struct
 }
 tRingBufObject;
 
+//*****************************************************************************
+//
+// The structure used for encapsulating all the items associated with a
+// single-producer, single-consumer ring buffer.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The ring buffer, whose size is a power of two.
+    //
+    uint8_t *pui8Buf;
+
+    //
+    // The ring buffer size minus one, used to wrap the counts into indices.
+    //
+    uint32_t ui32Mask;
+
+    //
+    // The total number of bytes written, which is only changed by the
+    // producer.
+    //
+    volatile uint32_t ui32WriteCount;
+
+    //
+    // The total number of bytes read, which is only changed by the consumer.
+    //
+    volatile uint32_t ui32ReadCount;
+}
+tRingBufSPSC;
+
 //*****************************************************************************
 //
 // API Function prototypes
@@ -92,6 +123,26 @@ extern void RingBufAdvanceRead(tRingBufObject *psRingBuf,
                                 uint32_t ui32NumBytes);
 extern void RingBufInit(tRingBufObject *psRingBuf, uint8_t *pui8Buf,
                         uint32_t ui32Size);
+extern void RingBufSPSCInit(tRingBufSPSC *psRingBuf, uint8_t *pui8Buf,
+                            uint32_t ui32Size);
+extern uint32_t RingBufSPSCUsed(tRingBufSPSC *psRingBuf);
+extern uint32_t RingBufSPSCFree(tRingBufSPSC *psRingBuf);
+extern void RingBufSPSCFlush(tRingBufSPSC *psRingBuf);
+extern uint32_t RingBufSPSCWriteReserve(tRingBufSPSC *psRingBuf,
+                                        uint8_t **ppui8Data);
+extern void RingBufSPSCWriteCommit(tRingBufSPSC *psRingBuf,
+                                   uint32_t ui32Length);
+extern uint32_t RingBufSPSCReadPeek(tRingBufSPSC *psRingBuf,
+                                    uint8_t **ppui8Data);
+extern void RingBufSPSCReadRelease(tRingBufSPSC *psRingBuf,
+                                   uint32_t ui32Length);
+extern uint32_t RingBufSPSCWrite(tRingBufSPSC *psRingBuf,
+                                 const uint8_t *pui8Data,
+                                 uint32_t ui32Length);
+extern uint32_t RingBufSPSCRead(tRingBufSPSC *psRingBuf, uint8_t *pui8Data,
+                                uint32_t ui32Length);
+extern bool RingBufSPSCWriteOne(tRingBufSPSC *psRingBuf, uint8_t ui8Data);
+extern bool RingBufSPSCReadOne(tRingBufSPSC *psRingBuf, uint8_t *pui8Data);
 
 //*****************************************************************************
 //
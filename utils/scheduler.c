@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include "inc/hw_types.h"
 #include "inc/hw_ints.h"
+#include "inc/hw_nvic.h"
 #include "driverlib/systick.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/interrupt.h"
@@ -41,6 +42,228 @@
 
 static volatile uint32_t g_ui32SchedulerTickCount;
 
+//*****************************************************************************
+//
+// The number of ticks represented by the current SysTick period.  This is
+// one except while SchedulerIdle() has stretched the period to sleep through
+// several ticks.
+//
+//*****************************************************************************
+static volatile uint32_t g_ui32SchedulerTickStep = 1;
+
+//*****************************************************************************
+//
+// The number of SysTick clocks in each tick, and the largest number of ticks
+// that fit in a single SysTick period.
+//
+//*****************************************************************************
+static uint32_t g_ui32SchedulerTickPeriod;
+static uint32_t g_ui32SchedulerIdleMax;
+
+//*****************************************************************************
+//
+// The queue of deadline-ordered tasks, held as a binary min-heap on the tick
+// at which each task is next due, so that the next task to run is always at
+// the top.
+//
+//*****************************************************************************
+static tSchedulerDeadlineTask **g_ppsSchedulerQueue;
+static uint32_t g_ui32SchedulerQueueSize;
+static uint32_t g_ui32SchedulerQueueCount;
+
+//*****************************************************************************
+//
+// The deadline-ordered task that is currently being run, if any.  It is out
+// of the queue while it runs, but a periodic task keeps its place so that it
+// can be queued again when it returns.
+//
+//*****************************************************************************
+static tSchedulerDeadlineTask *g_psSchedulerRunning;
+
+//*****************************************************************************
+//
+// The value of the ui32QueueIndex field of a deadline-ordered task which is
+// not in the queue, and of the task that is currently being run.
+//
+//*****************************************************************************
+#define SCHEDULER_TASK_STOPPED  0xFFFFFFFF
+#define SCHEDULER_TASK_RUNNING  0xFFFFFFFE
+
+//*****************************************************************************
+//
+// Returns the current time in SysTick clocks.  This wraps frequently and is
+// only used to measure the time taken by a task.
+//
+//*****************************************************************************
+static uint32_t
+SchedulerClockGet(void)
+{
+    uint32_t ui32Ticks, ui32Value;
+
+    //
+    // Read the tick count and the SysTick counter, retrying if a tick ended
+    // in between.
+    //
+    do
+    {
+        ui32Ticks = g_ui32SchedulerTickCount;
+        ui32Value = SysTickValueGet();
+    }
+    while(ui32Ticks != g_ui32SchedulerTickCount);
+
+    //
+    // The SysTick counter counts down through each tick.
+    //
+    return((ui32Ticks * g_ui32SchedulerTickPeriod) +
+           (g_ui32SchedulerTickPeriod - ui32Value));
+}
+
+//*****************************************************************************
+//
+// Returns true if the first deadline-ordered task should run before the
+// second: when it is due sooner, or when both are due on the same tick and it
+// has the higher priority (the lower value).
+//
+//*****************************************************************************
+static bool
+SchedulerTaskBefore(tSchedulerDeadlineTask *psTask1,
+                    tSchedulerDeadlineTask *psTask2)
+{
+    int32_t i32Diff;
+
+    i32Diff = (int32_t)(psTask1->ui32DueTick - psTask2->ui32DueTick);
+    if(i32Diff != 0)
+    {
+        return(i32Diff < 0);
+    }
+    return(psTask1->ui32Priority < psTask2->ui32Priority);
+}
+
+//*****************************************************************************
+//
+// Moves the task at the given position of the deadline queue towards the top
+// until it is not due before its parent.
+//
+//*****************************************************************************
+static void
+SchedulerQueueSiftUp(uint32_t ui32Index)
+{
+    tSchedulerDeadlineTask *psTask;
+    uint32_t ui32Parent;
+
+    psTask = g_ppsSchedulerQueue[ui32Index];
+    while(ui32Index != 0)
+    {
+        ui32Parent = (ui32Index - 1) / 2;
+        if(!SchedulerTaskBefore(psTask, g_ppsSchedulerQueue[ui32Parent]))
+        {
+            break;
+        }
+        g_ppsSchedulerQueue[ui32Index] = g_ppsSchedulerQueue[ui32Parent];
+        g_ppsSchedulerQueue[ui32Index]->ui32QueueIndex = ui32Index;
+        ui32Index = ui32Parent;
+    }
+    g_ppsSchedulerQueue[ui32Index] = psTask;
+    psTask->ui32QueueIndex = ui32Index;
+}
+
+//*****************************************************************************
+//
+// Moves the task at the given position of the deadline queue towards the
+// bottom until neither of its children is due before it.
+//
+//*****************************************************************************
+static void
+SchedulerQueueSiftDown(uint32_t ui32Index)
+{
+    tSchedulerDeadlineTask *psTask;
+    uint32_t ui32Child;
+
+    psTask = g_ppsSchedulerQueue[ui32Index];
+    while(1)
+    {
+        //
+        // Find the child which is due first, if there are any children.
+        //
+        ui32Child = (ui32Index * 2) + 1;
+        if(ui32Child >= g_ui32SchedulerQueueCount)
+        {
+            break;
+        }
+        if(((ui32Child + 1) < g_ui32SchedulerQueueCount) &&
+           SchedulerTaskBefore(g_ppsSchedulerQueue[ui32Child + 1],
+                               g_ppsSchedulerQueue[ui32Child]))
+        {
+            ui32Child++;
+        }
+
+        //
+        // Stop once the task is not due after that child.
+        //
+        if(!SchedulerTaskBefore(g_ppsSchedulerQueue[ui32Child], psTask))
+        {
+            break;
+        }
+        g_ppsSchedulerQueue[ui32Index] = g_ppsSchedulerQueue[ui32Child];
+        g_ppsSchedulerQueue[ui32Index]->ui32QueueIndex = ui32Index;
+        ui32Index = ui32Child;
+    }
+    g_ppsSchedulerQueue[ui32Index] = psTask;
+    psTask->ui32QueueIndex = ui32Index;
+}
+
+//*****************************************************************************
+//
+// Returns true if a task is in the deadline queue.  A task whose fields have
+// only been zeroed is not, even though its queue index looks valid.
+//
+//*****************************************************************************
+static bool
+SchedulerTaskQueued(tSchedulerDeadlineTask *psTask)
+{
+    return((psTask->ui32QueueIndex < g_ui32SchedulerQueueCount) &&
+           (g_ppsSchedulerQueue[psTask->ui32QueueIndex] == psTask));
+}
+
+//*****************************************************************************
+//
+// Adds a task to the deadline queue.  The caller must ensure that there is
+// space for it.
+//
+//*****************************************************************************
+static void
+SchedulerQueueInsert(tSchedulerDeadlineTask *psTask)
+{
+    g_ppsSchedulerQueue[g_ui32SchedulerQueueCount] = psTask;
+    SchedulerQueueSiftUp(g_ui32SchedulerQueueCount++);
+}
+
+//*****************************************************************************
+//
+// Removes the task at the given position from the deadline queue, filling
+// the gap with the last task in the queue.
+//
+//*****************************************************************************
+static void
+SchedulerQueueRemove(uint32_t ui32Index)
+{
+    tSchedulerDeadlineTask *psLast;
+
+    g_ppsSchedulerQueue[ui32Index]->ui32QueueIndex = SCHEDULER_TASK_STOPPED;
+    g_ui32SchedulerQueueCount--;
+    if(ui32Index != g_ui32SchedulerQueueCount)
+    {
+        //
+        // Move the last task into the gap, then restore the heap order in
+        // whichever direction it is out of place.
+        //
+        psLast = g_ppsSchedulerQueue[g_ui32SchedulerQueueCount];
+        g_ppsSchedulerQueue[ui32Index] = psLast;
+        SchedulerQueueSiftDown(ui32Index);
+        SchedulerQueueSiftUp(psLast->ui32QueueIndex);
+    }
+}
+
 //*****************************************************************************
 //
 //! Handles the SysTick interrupt on behalf of the scheduler module.
@@ -54,7 +277,12 @@ static volatile uint32_t g_ui32SchedulerTickCount;
 void
 SchedulerSysTickIntHandler(void)
 {
-    g_ui32SchedulerTickCount++;
+    //
+    // Count the ticks represented by the SysTick period which has just ended,
+    // which is more than one if SchedulerIdle() stretched it.
+    //
+    g_ui32SchedulerTickCount += g_ui32SchedulerTickStep;
+    g_ui32SchedulerTickStep = 1;
 }
 
 //*****************************************************************************
@@ -85,10 +313,17 @@ SchedulerInit(uint32_t ui32TicksPerSecond)
 {
     ASSERT(ui32TicksPerSecond);
 
+    //
+    // Remember the length of a tick, and how many of them SchedulerIdle() can
+    // sleep through in a single SysTick period.
+    //
+    g_ui32SchedulerTickPeriod = SysCtlClockGet() / ui32TicksPerSecond;
+    g_ui32SchedulerIdleMax = 0x01000000 / g_ui32SchedulerTickPeriod;
+
     //
     // Configure SysTick for a periodic interrupt.
     //
-    SysTickPeriodSet(SysCtlClockGet() / ui32TicksPerSecond);
+    SysTickPeriodSet(g_ui32SchedulerTickPeriod);
     SysTickEnable();
     SysTickIntEnable();
 }
@@ -107,14 +342,20 @@ SchedulerInit(uint32_t ui32TicksPerSecond)
 //! functions configured in \e g_psSchedulerTable are made in the context of
 //! SchedulerRun().
 //!
+//! After the table, any deadline-ordered tasks which are due are run, in order
+//! of their due tick and then their priority.  Only the tasks at the top of
+//! the deadline queue are examined, so the cost of a call does not depend on
+//! the number of tasks which are waiting.
+//!
 //! \return None.
 //
 //*****************************************************************************
 void
 SchedulerRun(void)
 {
-    uint32_t ui32Loop;
+    uint32_t ui32Loop, ui32Now, ui32Start, ui32Time;
     tSchedulerTask *pi16Task;
+    tSchedulerDeadlineTask *psTask;
 
     //
     // Loop through each task in the task table.
@@ -144,6 +385,82 @@ SchedulerRun(void)
             pi16Task->pfnFunction(pi16Task->pvParam);
         }
     }
+
+    //
+    // Run each deadline-ordered task which is due.  No more tasks are run
+    // than were queued at the start, so a task which restarts itself with no
+    // delay is not run again until the next call.
+    //
+    ui32Now = g_ui32SchedulerTickCount;
+    for(ui32Loop = g_ui32SchedulerQueueCount; ui32Loop != 0; ui32Loop--)
+    {
+        //
+        // Stop if the task at the top of the queue is not yet due.
+        //
+        if((g_ui32SchedulerQueueCount == 0) ||
+           ((int32_t)(g_ppsSchedulerQueue[0]->ui32DueTick - ui32Now) > 0))
+        {
+            break;
+        }
+
+        //
+        // Remove the task from the queue and call its function, timing the
+        // call.
+        //
+        psTask = g_ppsSchedulerQueue[0];
+        SchedulerQueueRemove(0);
+        psTask->ui32QueueIndex = SCHEDULER_TASK_RUNNING;
+        g_psSchedulerRunning = psTask;
+        ui32Start = SchedulerClockGet();
+        psTask->pfnFunction(psTask->pvParam);
+        ui32Time = SchedulerClockGet() - ui32Start;
+        g_psSchedulerRunning = 0;
+
+        //
+        // Update the run-time statistics for the task.
+        //
+        psTask->ui32RunCount++;
+        psTask->ui32RunTimeTotal += ui32Time;
+        if(ui32Time > psTask->ui32RunTimeMax)
+        {
+            psTask->ui32RunTimeMax = ui32Time;
+        }
+
+        //
+        // Nothing more needs to be done if the task was restarted or stopped
+        // by its own function.
+        //
+        if(psTask->ui32QueueIndex != SCHEDULER_TASK_RUNNING)
+        {
+            continue;
+        }
+
+        //
+        // A one-shot task is finished once it has run.
+        //
+        if(psTask->ui32PeriodTicks == 0)
+        {
+            psTask->ui32QueueIndex = SCHEDULER_TASK_STOPPED;
+            continue;
+        }
+
+        //
+        // Queue a periodic task for its next period.  If that has already
+        // passed, the task has overrun; count each period that was missed and
+        // skip to the next one which is still to come rather than running the
+        // task repeatedly to catch up.
+        //
+        psTask->ui32DueTick += psTask->ui32PeriodTicks;
+        ui32Now = g_ui32SchedulerTickCount;
+        if((int32_t)(psTask->ui32DueTick - ui32Now) <= 0)
+        {
+            ui32Time = (((ui32Now - psTask->ui32DueTick) /
+                         psTask->ui32PeriodTicks) + 1);
+            psTask->ui32Overruns += ui32Time;
+            psTask->ui32DueTick += ui32Time * psTask->ui32PeriodTicks;
+        }
+        SchedulerQueueInsert(psTask);
+    }
 }
 
 //*****************************************************************************
@@ -302,6 +619,342 @@ SchedulerElapsedTicksCalc(uint32_t ui32TickStart, uint32_t ui32TickEnd)
            ((0xFFFFFFFF - ui32TickStart) + ui32TickEnd + 1));
 }
 
+//*****************************************************************************
+//
+//! Initializes the queue of deadline-ordered tasks.
+//!
+//! \param ppsQueue points to storage for the queue, which is an array of
+//! pointers to tasks.
+//! \param ui32Size is the number of entries in the \e ppsQueue array, which is
+//! the largest number of deadline-ordered tasks that can be started at once.
+//!
+//! This function must be called before any deadline-ordered task is started.
+//! Unlike the tasks in \e g_psSchedulerTable, which are checked on every call
+//! to SchedulerRun(), deadline-ordered tasks are kept in order of the tick at
+//! which each is next due, so SchedulerRun() only looks at the tasks which
+//! are due and SchedulerNextDeadlineGet() can tell when the next one will be.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SchedulerDeadlineInit(tSchedulerDeadlineTask **ppsQueue, uint32_t ui32Size)
+{
+    ASSERT(ppsQueue);
+    ASSERT(ui32Size);
+
+    g_ppsSchedulerQueue = ppsQueue;
+    g_ui32SchedulerQueueSize = ui32Size;
+    g_ui32SchedulerQueueCount = 0;
+}
+
+//*****************************************************************************
+//
+//! Starts a deadline-ordered task.
+//!
+//! \param psTask points to the task which is to be started.
+//! \param ui32DelayTicks is the number of ticks from now at which the task is
+//! to be run for the first time.  If this is 0, the task is run on the next
+//! call to SchedulerRun().
+//!
+//! This function queues a task to be called by SchedulerRun() once the given
+//! number of ticks has elapsed.  If the \e ui32PeriodTicks field of the task
+//! is 0, the task is called once and then stopped; otherwise it is called
+//! every \e ui32PeriodTicks ticks from then on until it is stopped.  If the
+//! task has already been started, it is rescheduled for the new time.  The
+//! run-time statistics in the task are not changed.
+//!
+//! The fields of the task which are not updated by the scheduler must be
+//! initialized before the task is first started, and those which are must
+//! be initialized to zero.  This function may be called by the function of
+//! any deadline-ordered task, including the task itself, but must not be
+//! called from an interrupt handler.
+//!
+//! \return Returns \b true if the task was started or \b false if the queue
+//! is full.  While a periodic task is running its place in the queue is kept
+//! for it, so another task cannot be started in that place.
+//
+//*****************************************************************************
+bool
+SchedulerDeadlineTaskStart(tSchedulerDeadlineTask *psTask,
+                           uint32_t ui32DelayTicks)
+{
+    uint32_t ui32Used;
+
+    ASSERT(psTask);
+    ASSERT(psTask->pfnFunction);
+
+    //
+    // If the task is already queued, remove it so that it can be queued
+    // again for its new due tick.
+    //
+    if(SchedulerTaskQueued(psTask))
+    {
+        SchedulerQueueRemove(psTask->ui32QueueIndex);
+    }
+
+    //
+    // Fail if there is no space in the queue, counting the place kept for a
+    // periodic task which is running and is to be queued again.
+    //
+    ui32Used = g_ui32SchedulerQueueCount;
+    if(g_psSchedulerRunning && (g_psSchedulerRunning != psTask) &&
+       (g_psSchedulerRunning->ui32QueueIndex == SCHEDULER_TASK_RUNNING) &&
+       (g_psSchedulerRunning->ui32PeriodTicks != 0))
+    {
+        ui32Used++;
+    }
+    if(ui32Used == g_ui32SchedulerQueueSize)
+    {
+        psTask->ui32QueueIndex = SCHEDULER_TASK_STOPPED;
+        return(false);
+    }
+
+    //
+    // Queue the task.
+    //
+    psTask->ui32DueTick = g_ui32SchedulerTickCount + ui32DelayTicks;
+    SchedulerQueueInsert(psTask);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Stops a deadline-ordered task.
+//!
+//! \param psTask points to the task which is to be stopped.
+//!
+//! This function removes a task from the deadline queue, so that it is not
+//! called again until it is restarted with SchedulerDeadlineTaskStart().  It
+//! may be called by the function of any deadline-ordered task, including the
+//! task itself, but must not be called from an interrupt handler.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SchedulerDeadlineTaskStop(tSchedulerDeadlineTask *psTask)
+{
+    ASSERT(psTask);
+
+    if(SchedulerTaskQueued(psTask))
+    {
+        SchedulerQueueRemove(psTask->ui32QueueIndex);
+    }
+    psTask->ui32QueueIndex = SCHEDULER_TASK_STOPPED;
+}
+
+//*****************************************************************************
+//
+//! Returns the number of ticks until the scheduler next has a task to run.
+//!
+//! This function may be called by the client to determine how long it may
+//! sleep before it must call SchedulerRun() again, for example to decide
+//! whether it is worth entering deep-sleep mode.  Both the deadline-ordered
+//! tasks and the active tasks in \e g_psSchedulerTable are considered.
+//!
+//! \return Returns the number of ticks until the next task is due, which is
+//! 0 if a task is due now, or 0xFFFFFFFF if there are no tasks to run.
+//
+//*****************************************************************************
+uint32_t
+SchedulerNextDeadlineGet(void)
+{
+    uint32_t ui32Loop, ui32Now, ui32Ticks, ui32Elapsed;
+    int32_t i32Diff;
+
+    ui32Now = g_ui32SchedulerTickCount;
+    ui32Ticks = 0xFFFFFFFF;
+
+    //
+    // The first deadline-ordered task to run is at the top of the queue.
+    //
+    if(g_ui32SchedulerQueueCount != 0)
+    {
+        i32Diff = (int32_t)(g_ppsSchedulerQueue[0]->ui32DueTick - ui32Now);
+        if(i32Diff <= 0)
+        {
+            return(0);
+        }
+        ui32Ticks = (uint32_t)i32Diff;
+    }
+
+    //
+    // Find the active task in the table which is due first.
+    //
+    for(ui32Loop = 0; ui32Loop < g_ui32SchedulerNumTasks; ui32Loop++)
+    {
+        if(g_psSchedulerTable[ui32Loop].bActive)
+        {
+            ui32Elapsed = SchedulerElapsedTicksCalc(
+                              g_psSchedulerTable[ui32Loop].ui32LastCall,
+                              ui32Now);
+            if(ui32Elapsed >= g_psSchedulerTable[ui32Loop].ui32FrequencyTicks)
+            {
+                return(0);
+            }
+            ui32Elapsed = (g_psSchedulerTable[ui32Loop].ui32FrequencyTicks -
+                           ui32Elapsed);
+            if(ui32Elapsed < ui32Ticks)
+            {
+                ui32Ticks = ui32Elapsed;
+            }
+        }
+    }
+
+    return(ui32Ticks);
+}
+
+//*****************************************************************************
+//
+//! Sleeps until the scheduler next has a task to run.
+//!
+//! This function may be called by the client in place of a busy loop between
+//! calls to SchedulerRun().  It puts the processor into sleep mode until the
+//! next task is due or until an interrupt occurs, returning immediately if a
+//! task is already due.  When the next task is more than one tick away, the
+//! SysTick period is stretched so that the processor is not woken on every
+//! tick in between; the tick count is then brought up to date when the
+//! processor wakes.  Each stretched sleep that is ended early by another
+//! interrupt loses the few SysTick clocks taken to reprogram the timer.
+//!
+//! The SysTick timer may not count at the same rate, if at all, in deep-sleep
+//! mode, so applications which use deep-sleep mode should instead use
+//! SchedulerNextDeadlineGet() to program a wake-up timer for the next task.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SchedulerIdle(void)
+{
+    uint32_t ui32Ticks, ui32Value, ui32Remaining;
+    bool bIntsOff;
+
+    //
+    // Prevent the SysTick interrupt while its period is being changed.  The
+    // processor still wakes from sleep when an interrupt is pending.
+    //
+    bIntsOff = IntMasterDisable();
+
+    //
+    // Do not sleep if a task is already due.
+    //
+    ui32Ticks = SchedulerNextDeadlineGet();
+    if(ui32Ticks == 0)
+    {
+        if(!bIntsOff)
+        {
+            IntMasterEnable();
+        }
+        return;
+    }
+
+    //
+    // Stretch the SysTick period to end on the tick at which the next task is
+    // due, if that is more than one tick away.
+    //
+    if(ui32Ticks > g_ui32SchedulerIdleMax)
+    {
+        ui32Ticks = g_ui32SchedulerIdleMax;
+    }
+    if(ui32Ticks > 1)
+    {
+        //
+        // Stop SysTick, and find how many clocks remain in the current tick.
+        // If the tick has just ended, let the interrupt count it instead.
+        //
+        SysTickDisable();
+        ui32Value = SysTickValueGet();
+        if((ui32Value != 0) &&
+           !(HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_PENDSTSET))
+        {
+            //
+            // Load a single period which covers the rest of this tick and the
+            // following ones, then restore the normal reload value, which
+            // takes effect once the stretched period has ended.
+            //
+            HWREG(NVIC_ST_RELOAD) = (ui32Value - 1 +
+                                     ((ui32Ticks - 1) *
+                                      g_ui32SchedulerTickPeriod));
+            HWREG(NVIC_ST_CURRENT) = 0;
+            SysTickEnable();
+            HWREG(NVIC_ST_RELOAD) = g_ui32SchedulerTickPeriod - 1;
+            g_ui32SchedulerTickStep = ui32Ticks;
+        }
+        else
+        {
+            SysTickEnable();
+        }
+    }
+
+    //
+    // Sleep until an interrupt occurs.
+    //
+    SysCtlSleep();
+
+    //
+    // If the processor was woken by another interrupt before the end of a
+    // stretched period, count the ticks which have passed and end the period
+    // early at the next tick.
+    //
+    if(g_ui32SchedulerTickStep != 1)
+    {
+        SysTickDisable();
+        ui32Value = SysTickValueGet();
+        if((ui32Value != 0) &&
+           !(HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_PENDSTSET))
+        {
+            //
+            // Find the number of ticks, whole or partial, which remain in the
+            // stretched period, and the clocks to the end of the first.
+            //
+            ui32Remaining = ((ui32Value + g_ui32SchedulerTickPeriod - 1) /
+                             g_ui32SchedulerTickPeriod);
+            ui32Value -= (ui32Remaining - 1) * g_ui32SchedulerTickPeriod;
+            g_ui32SchedulerTickCount += (g_ui32SchedulerTickStep -
+                                         ui32Remaining);
+            g_ui32SchedulerTickStep = 1;
+
+            //
+            // A period of a single clock would not interrupt, so count a tick
+            // which ends on the next clock now and end the period at the
+            // following tick instead.  This keeps the period to one tick, as
+            // the stretching above expects if the processor sleeps again
+            // before it ends.
+            //
+            if(ui32Value < 2)
+            {
+                ui32Value += g_ui32SchedulerTickPeriod;
+                g_ui32SchedulerTickCount++;
+            }
+
+            //
+            // End the period at the next tick, then restore the normal reload
+            // value.
+            //
+            HWREG(NVIC_ST_RELOAD) = ui32Value - 1;
+            HWREG(NVIC_ST_CURRENT) = 0;
+            SysTickEnable();
+            HWREG(NVIC_ST_RELOAD) = g_ui32SchedulerTickPeriod - 1;
+        }
+        else
+        {
+            SysTickEnable();
+        }
+    }
+
+    //
+    // Allow the SysTick interrupt, and any which woke the processor, to be
+    // handled.
+    //
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -106,6 +106,78 @@ extern tSchedulerTask g_psSchedulerTable[];
 //*****************************************************************************
 extern uint32_t g_ui32SchedulerNumTasks;
 
+//*****************************************************************************
+//
+//! The structure defining a function which the scheduler will call once or
+//! periodically at a given tick, kept in a queue ordered by the tick at which
+//! it is next due.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! A pointer to the function which is to be called by the scheduler.
+    //
+    void (*pfnFunction)(void *);
+
+    //
+    //! The parameter which is to be passed to this function when it is called.
+    //
+    void *pvParam;
+
+    //
+    //! The number of ticks between calls to the function.  If this value is
+    //! 0, the function is called once each time the task is started.
+    //
+    uint32_t ui32PeriodTicks;
+
+    //
+    //! The priority of the task.  When several tasks are due on the same
+    //! tick, those with lower values are called first.
+    //
+    uint32_t ui32Priority;
+
+    //
+    //! The tick count at which this function is next due to be called.  This
+    //! field is updated by the scheduler.
+    //
+    uint32_t ui32DueTick;
+
+    //
+    //! The position of this task in the deadline queue.  This field is
+    //! updated by the scheduler.
+    //
+    uint32_t ui32QueueIndex;
+
+    //
+    //! The number of times that the function has been called.  This field is
+    //! updated by the scheduler.
+    //
+    uint32_t ui32RunCount;
+
+    //
+    //! The total time spent in the function, in SysTick clocks (which are
+    //! system clocks).  This wraps, so the average time should be found from
+    //! the change in this and ui32RunCount over an interval.  This field is
+    //! updated by the scheduler.
+    //
+    uint32_t ui32RunTimeTotal;
+
+    //
+    //! The longest time spent in a single call to the function, in SysTick
+    //! clocks.  This field is updated by the scheduler.
+    //
+    uint32_t ui32RunTimeMax;
+
+    //
+    //! The number of periods for which a periodic function was not called
+    //! because it, or the tasks due before it, ran for too long.  This field
+    //! is updated by the scheduler.
+    //
+    uint32_t ui32Overruns;
+}
+tSchedulerDeadlineTask;
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -127,6 +199,13 @@ extern uint32_t SchedulerTickCountGet(void);
 extern uint32_t SchedulerElapsedTicksGet(uint32_t ui32TickCount);
 extern uint32_t SchedulerElapsedTicksCalc(uint32_t ui32TickStart,
                                                uint32_t ui32TickEnd);
+extern void SchedulerDeadlineInit(tSchedulerDeadlineTask **ppsQueue,
+                                  uint32_t ui32Size);
+extern bool SchedulerDeadlineTaskStart(tSchedulerDeadlineTask *psTask,
+                                       uint32_t ui32DelayTicks);
+extern void SchedulerDeadlineTaskStop(tSchedulerDeadlineTask *psTask);
+extern uint32_t SchedulerNextDeadlineGet(void);
+extern void SchedulerIdle(void);
 
 //*****************************************************************************
 //
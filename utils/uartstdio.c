@@ -27,6 +27,7 @@
 #include <stdarg.h>
 #include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
+#include "inc/hw_sysctl.h"
 #include "inc/hw_types.h"
 #include "inc/hw_uart.h"
 #include "driverlib/debug.h"
@@ -35,6 +36,7 @@
 #include "driverlib/rom_map.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/uart.h"
+#include "driverlib/udma.h"
 #include "utils/uartstdio.h"
 
 //*****************************************************************************
@@ -118,6 +120,147 @@ static volatile uint32_t g_ui32UARTRxReadIndex = 0;
                                 (Index) = ((Index) + 1) % UART_RX_BUFFER_SIZE
 #endif
 
+//*****************************************************************************
+//
+// If the deferred log is defined, set aside a buffer for the log records and
+// counts to control it.
+//
+//*****************************************************************************
+#ifdef UART_DEFERRED_LOG
+
+//*****************************************************************************
+//
+// The log record buffer.  The counts of bytes written and read run freely
+// and are masked to find the index in the buffer, so the buffer size must be
+// a power of two; every byte of the buffer can then be used.  A record is
+// placed in the buffer whole, so the read count only reaches the start of a
+// record once all of it is present.
+//
+//*****************************************************************************
+#if ((UART_LOG_BUFFER_SIZE & (UART_LOG_BUFFER_SIZE - 1)) != 0)
+#error "UART_LOG_BUFFER_SIZE must be a power of two!"
+#endif
+#if ((UART_LOG_RECORD_SIZE < (UART_LOG_O_ARGS + 1)) ||                        \
+     (UART_LOG_RECORD_SIZE > 255) ||                                          \
+     (UART_LOG_RECORD_SIZE > UART_LOG_BUFFER_SIZE))
+#error "UART_LOG_RECORD_SIZE must be between 11 and 255 bytes!"
+#endif
+static unsigned char g_pcUARTLogBuffer[UART_LOG_BUFFER_SIZE];
+static volatile uint32_t g_ui32UARTLogWriteCount = 0;
+static volatile uint32_t g_ui32UARTLogReadCount = 0;
+
+//*****************************************************************************
+//
+// The number of bytes of the log record currently being sent that remain to
+// be sent.  Text from the transmit buffer is not sent until this is zero, so
+// that it is never placed in the middle of a record.
+//
+//*****************************************************************************
+#ifdef UART_BUFFERED
+static uint32_t g_ui32UARTLogRecordLeft = 0;
+#endif
+
+//*****************************************************************************
+//
+// The function which provides the timestamp of each log record, and the
+// number of records which were discarded because the buffer was full.
+//
+//*****************************************************************************
+static uint32_t (*g_pfnUARTLogTimestamp)(void);
+static volatile uint32_t g_ui32UARTLogDropped = 0;
+
+//*****************************************************************************
+//
+// Macros to determine the number of used bytes in the log buffer, and to
+// read the byte at a given count.
+//
+//*****************************************************************************
+#define LOG_BUFFER_USED         (GetLogCount(&g_ui32UARTLogReadCount,         \
+                                             &g_ui32UARTLogWriteCount))
+#define LOG_BUFFER_EMPTY        (LOG_BUFFER_USED == 0)
+#define LOG_BUFFER_BYTE(Count)  g_pcUARTLogBuffer[(Count) &                   \
+                                                  (UART_LOG_BUFFER_SIZE - 1)]
+#endif
+
+//*****************************************************************************
+//
+// If uDMA mode is defined, set aside the buffers into which characters are
+// received and the state of the transfers.
+//
+//*****************************************************************************
+#ifdef UART_DMA
+#ifndef UART_BUFFERED
+#error "UART_DMA requires UART_BUFFERED!"
+#endif
+#if ((UART_RX_DMA_SIZE < 1) || (UART_RX_DMA_SIZE > 1024))
+#error "UART_RX_DMA_SIZE must be between 1 and 1024 bytes!"
+#endif
+
+//*****************************************************************************
+//
+// The largest number of bytes that the uDMA controller can transfer at once.
+//
+//*****************************************************************************
+#define DMA_MAX_TRANSFER        1024
+
+//*****************************************************************************
+//
+// The receive buffers, which the uDMA controller fills in turn using the
+// primary and alternate control structures of the receive channel.  The
+// characters in them are processed by the interrupt handler, which tracks
+// the buffer being filled and the number of characters in it which it has
+// already processed.
+//
+//*****************************************************************************
+static unsigned char g_ppcUARTRxDMABuffer[2][UART_RX_DMA_SIZE];
+static uint32_t g_ui32UARTRxDMASelect;
+static uint32_t g_ui32UARTRxDMARead;
+
+//*****************************************************************************
+//
+// The transmit channel sends the transmit buffer directly, using its primary
+// and alternate control structures in turn so that the next transfer is
+// ready before the current one finishes.  These hold the number of bytes in
+// each of the transfers (or zero if the control structure is not in use),
+// which of them is the oldest, and the index of the first byte in the
+// transmit buffer which has not yet been given to the uDMA controller.  The
+// read index of the transmit buffer is moved past the bytes of each transfer
+// only when it has finished.
+//
+//*****************************************************************************
+static uint32_t g_pui32UARTTxDMASize[2];
+static uint32_t g_ui32UARTTxDMAHead;
+static uint32_t g_ui32UARTTxDMAIndex;
+
+//*****************************************************************************
+//
+// When the deferred log is also defined, the log records are sent by the
+// same channel.  These hold which of the transfers are of log records, and
+// the count of the first byte in the log buffer which has not yet been given
+// to the uDMA controller.
+//
+//*****************************************************************************
+#ifdef UART_DEFERRED_LOG
+static bool g_pbUARTTxDMALog[2];
+static uint32_t g_ui32UARTLogDMACount;
+#endif
+
+//*****************************************************************************
+//
+// The uDMA channels in use, and macros to find their primary and alternate
+// control structures.
+//
+//*****************************************************************************
+static uint32_t g_ui32UARTRxChannel;
+static uint32_t g_ui32UARTTxChannel;
+#define RX_DMA_STRUCT(Select)   (g_ui32UARTRxChannel |                        \
+                                 ((Select) ? UDMA_ALT_SELECT :                \
+                                  UDMA_PRI_SELECT))
+#define TX_DMA_STRUCT(Select)   (g_ui32UARTTxChannel |                        \
+                                 ((Select) ? UDMA_ALT_SELECT :                \
+                                  UDMA_PRI_SELECT))
+#endif
+
 //*****************************************************************************
 //
 // The base address of the chosen UART.
@@ -162,6 +305,23 @@ static const uint32_t g_ui32UARTInt[3] =
 static uint32_t g_ui32PortNum;
 #endif
 
+#ifdef UART_DMA
+//*****************************************************************************
+//
+// The uDMA channel assignments for receiving and transmitting on each of the
+// console UARTs.
+//
+//*****************************************************************************
+static const uint32_t g_ui32UARTRxDMA[3] =
+{
+    UDMA_CH8_UART0RX, UDMA_CH22_UART1RX, UDMA_CH0_UART2RX
+};
+static const uint32_t g_ui32UARTTxDMA[3] =
+{
+    UDMA_CH9_UART0TX, UDMA_CH23_UART1TX, UDMA_CH1_UART2TX
+};
+#endif
+
 //*****************************************************************************
 //
 // The list of UART peripherals.
@@ -267,20 +427,94 @@ GetBufferCount(volatile uint32_t *pui32Read,
 }
 #endif
 
+//*****************************************************************************
+//
+//! Determines the number of bytes of data contained in the log buffer.
+//!
+//! \param pui32Read points to the read count for the buffer.
+//! \param pui32Write points to the write count for the buffer.
+//!
+//! This function is used to determine how many bytes of log records the log
+//! buffer currently contains.  The structure of the code is specifically to
+//! ensure that we do not see warnings from the compiler related to the order
+//! of volatile accesses being undefined.
+//!
+//! \return Returns the number of bytes of data currently in the buffer.
+//
+//*****************************************************************************
+#ifdef UART_DEFERRED_LOG
+static uint32_t
+GetLogCount(volatile uint32_t *pui32Read, volatile uint32_t *pui32Write)
+{
+    uint32_t ui32Write;
+    uint32_t ui32Read;
+
+    ui32Write = *pui32Write;
+    ui32Read = *pui32Read;
+
+    return(ui32Write - ui32Read);
+}
+#endif
+
+//*****************************************************************************
+//
+// Move bytes of log records into the UART transmit FIFO while there is space
+// for them, finishing the record that is being sent and, if requested,
+// starting further records.  This must be called with the UART interrupt
+// disabled.
+//
+//*****************************************************************************
+#if defined(UART_BUFFERED) && defined(UART_DEFERRED_LOG) && !defined(UART_DMA)
+static void
+UARTLogTransmit(uint32_t ui32Base, bool bStart)
+{
+    uint32_t ui32Read;
+
+    ui32Read = g_ui32UARTLogReadCount;
+    while(MAP_UARTSpaceAvail(ui32Base))
+    {
+        //
+        // If the previous record has been sent, start the next one if there
+        // is one and starting records is allowed.
+        //
+        if(g_ui32UARTLogRecordLeft == 0)
+        {
+            if(!bStart || LOG_BUFFER_EMPTY)
+            {
+                break;
+            }
+            g_ui32UARTLogRecordLeft = LOG_BUFFER_BYTE(ui32Read +
+                                                      UART_LOG_O_LENGTH);
+        }
+
+        //
+        // Send the next byte of the record.
+        //
+        MAP_UARTCharPutNonBlocking(ui32Base, LOG_BUFFER_BYTE(ui32Read));
+        g_ui32UARTLogReadCount = ++ui32Read;
+        g_ui32UARTLogRecordLeft--;
+    }
+}
+#endif
+
 //*****************************************************************************
 //
 // Take as many bytes from the transmit buffer as we have space for and move
 // them into the UART transmit FIFO.
 //
 //*****************************************************************************
-#ifdef UART_BUFFERED
+#if defined(UART_BUFFERED) && !defined(UART_DMA)
 static void
 UARTPrimeTransmit(uint32_t ui32Base)
 {
     //
     // Do we have any data to transmit?
     //
+#ifdef UART_DEFERRED_LOG
+    if(!TX_BUFFER_EMPTY || !LOG_BUFFER_EMPTY)
+#else
     if(!TX_BUFFER_EMPTY)
+#endif
     {
         //
         // Disable the UART interrupt.  If we don't do this there is a race
@@ -288,15 +522,274 @@ UARTPrimeTransmit(uint32_t ui32Base)
         //
         MAP_IntDisable(g_ui32UARTInt[g_ui32PortNum]);
 
+#ifdef UART_DEFERRED_LOG
         //
-        // Yes - take some characters out of the transmit buffer and feed
-        // them to the UART transmit FIFO.
+        // Finish sending any log record that has been started, so that the
+        // text is not placed in the middle of it.
         //
-        while(MAP_UARTSpaceAvail(ui32Base) && !TX_BUFFER_EMPTY)
+        UARTLogTransmit(ui32Base, false);
+#endif
+
+#ifdef UART_DEFERRED_LOG
+        //
+        // If the FIFO filled before the record was finished, the text must
+        // wait for the rest of it, even if the UART has since made space.
+        //
+        if(g_ui32UARTLogRecordLeft == 0)
+#endif
         {
-            MAP_UARTCharPutNonBlocking(ui32Base,
+            //
+            // Yes - take some characters out of the transmit buffer and feed
+            // them to the UART transmit FIFO.
+            //
+            while(MAP_UARTSpaceAvail(ui32Base) && !TX_BUFFER_EMPTY)
+            {
+                MAP_UARTCharPutNonBlocking(ui32Base,
                                       g_pcUARTTxBuffer[g_ui32UARTTxReadIndex]);
-            ADVANCE_TX_BUFFER_INDEX(g_ui32UARTTxReadIndex);
+                ADVANCE_TX_BUFFER_INDEX(g_ui32UARTTxReadIndex);
+            }
+
+#ifdef UART_DEFERRED_LOG
+            //
+            // Once all the text has been sent, send the log records.
+            //
+            if(TX_BUFFER_EMPTY)
+            {
+                UARTLogTransmit(ui32Base, true);
+            }
+#endif
+        }
+
+        //
+        // Reenable the UART interrupt.
+        //
+        MAP_IntEnable(g_ui32UARTInt[g_ui32PortNum]);
+    }
+}
+#endif
+
+//*****************************************************************************
+//
+// Set up a transfer of the next block of bytes in the transmit buffer, which
+// ends at the end of the buffer or at the last byte written to it, using the
+// given control structure of the transmit channel.  Returns false if there
+// are no bytes to transfer.
+//
+//*****************************************************************************
+#ifdef UART_DMA
+static bool
+UARTTxDMAQueue(uint32_t ui32Select)
+{
+    uint32_t ui32Index, ui32Size;
+
+    //
+    // Find the bytes which have not yet been given to the uDMA controller.
+    //
+    ui32Index = g_ui32UARTTxDMAIndex;
+    ui32Size = g_ui32UARTTxWriteIndex;
+    if(ui32Size == ui32Index)
+    {
+        return(false);
+    }
+    ui32Size = ((ui32Size > ui32Index) ? ui32Size : UART_TX_BUFFER_SIZE) -
+               ui32Index;
+    if(ui32Size > DMA_MAX_TRANSFER)
+    {
+        ui32Size = DMA_MAX_TRANSFER;
+    }
+
+    //
+    // Transfer them to the UART.
+    //
+    MAP_uDMAChannelTransferSet(TX_DMA_STRUCT(ui32Select), UDMA_MODE_PINGPONG,
+                               g_pcUARTTxBuffer + ui32Index,
+                               (void *)(uintptr_t)(g_ui32Base + UART_O_DR),
+                               ui32Size);
+    g_pui32UARTTxDMASize[ui32Select] = ui32Size;
+    g_ui32UARTTxDMAIndex = (ui32Index + ui32Size) % UART_TX_BUFFER_SIZE;
+
+    return(true);
+}
+#endif
+
+//*****************************************************************************
+//
+// Set up a transfer of the next block of bytes in the log buffer, using the
+// given control structure of the transmit channel, if the rest of a record
+// is waiting to be sent or if there is no text waiting to be sent.  Returns
+// false if there are no bytes to transfer.
+//
+//*****************************************************************************
+#if defined(UART_DMA) && defined(UART_DEFERRED_LOG)
+static bool
+UARTLogDMAQueue(uint32_t ui32Select)
+{
+    uint32_t ui32Count, ui32Size, ui32Idx;
+
+    //
+    // Records are not started until the text before them has been sent.
+    //
+    if((g_ui32UARTLogRecordLeft == 0) &&
+       (g_ui32UARTTxDMAIndex != g_ui32UARTTxWriteIndex))
+    {
+        return(false);
+    }
+
+    //
+    // Find the bytes which have not yet been given to the uDMA controller,
+    // up to the end of the log buffer.
+    //
+    ui32Count = g_ui32UARTLogDMACount;
+    ui32Size = g_ui32UARTLogWriteCount - ui32Count;
+    if(ui32Size == 0)
+    {
+        return(false);
+    }
+    ui32Idx = UART_LOG_BUFFER_SIZE - (ui32Count & (UART_LOG_BUFFER_SIZE - 1));
+    if(ui32Size > ui32Idx)
+    {
+        ui32Size = ui32Idx;
+    }
+    if(ui32Size > DMA_MAX_TRANSFER)
+    {
+        ui32Size = DMA_MAX_TRANSFER;
+    }
+
+    //
+    // Transfer the rest of the record that is being sent, or as many whole
+    // records as there are followed by as much of the last as will fit,
+    // remembering how much of it is left for the next transfer so that text
+    // is not sent in the middle of it.
+    //
+    if(g_ui32UARTLogRecordLeft)
+    {
+        if(ui32Size > g_ui32UARTLogRecordLeft)
+        {
+            ui32Size = g_ui32UARTLogRecordLeft;
+        }
+        g_ui32UARTLogRecordLeft -= ui32Size;
+    }
+    else
+    {
+        for(ui32Idx = 0; ui32Idx < ui32Size; )
+        {
+            ui32Idx += LOG_BUFFER_BYTE(ui32Count + ui32Idx +
+                                       UART_LOG_O_LENGTH);
+        }
+        g_ui32UARTLogRecordLeft = ui32Idx - ui32Size;
+    }
+    MAP_uDMAChannelTransferSet(TX_DMA_STRUCT(ui32Select), UDMA_MODE_PINGPONG,
+                               &LOG_BUFFER_BYTE(ui32Count),
+                               (void *)(uintptr_t)(g_ui32Base + UART_O_DR),
+                               ui32Size);
+    g_pui32UARTTxDMASize[ui32Select] = ui32Size;
+    g_pbUARTTxDMALog[ui32Select] = true;
+    g_ui32UARTLogDMACount = ui32Count + ui32Size;
+
+    return(true);
+}
+#endif
+
+//*****************************************************************************
+//
+// Release the space in the transmit buffer (and log buffer) used by the uDMA
+// transfers which have finished, and give the uDMA controller as much of the
+// rest as it can take.
+//
+//*****************************************************************************
+#ifdef UART_DMA
+static void
+UARTPrimeTransmit(uint32_t ui32Base)
+{
+    uint32_t ui32Select;
+
+    //
+    // Do we have any data to transmit, or any transfers under way?
+    //
+#ifdef UART_DEFERRED_LOG
+    if(!TX_BUFFER_EMPTY || !LOG_BUFFER_EMPTY)
+#else
+    if(!TX_BUFFER_EMPTY)
+#endif
+    {
+        //
+        // Disable the UART interrupt.  If we don't do this there is a race
+        // condition which can cause the transfers to be corrupted.
+        //
+        MAP_IntDisable(g_ui32UARTInt[g_ui32PortNum]);
+
+        //
+        // Release the space used by the transfers which have finished.  The
+        // controller marks the control structure of each of them as stopped,
+        // and they finish in the order in which they were set up.
+        //
+        for(ui32Select = g_ui32UARTTxDMAHead;
+            g_pui32UARTTxDMASize[ui32Select] &&
+            (MAP_uDMAChannelModeGet(TX_DMA_STRUCT(ui32Select)) ==
+             UDMA_MODE_STOP);
+            ui32Select ^= 1)
+        {
+#ifdef UART_DEFERRED_LOG
+            if(g_pbUARTTxDMALog[ui32Select])
+            {
+                g_ui32UARTLogReadCount += g_pui32UARTTxDMASize[ui32Select];
+                g_pbUARTTxDMALog[ui32Select] = false;
+            }
+            else
+#endif
+            {
+                g_ui32UARTTxReadIndex = ((g_ui32UARTTxReadIndex +
+                                          g_pui32UARTTxDMASize[ui32Select]) %
+                                         UART_TX_BUFFER_SIZE);
+            }
+            g_pui32UARTTxDMASize[ui32Select] = 0;
+            g_ui32UARTTxDMAHead = ui32Select ^ 1;
+        }
+
+        //
+        // Set up transfers in the control structures which are free, in the
+        // order in which the controller will use them.  In ping-pong mode,
+        // it moves on to the other control structure when a transfer
+        // finishes, and stops if that one is not in use.
+        //
+        ui32Select = g_ui32UARTTxDMAHead;
+        if(g_pui32UARTTxDMASize[ui32Select])
+        {
+            ui32Select ^= 1;
+        }
+        while(!g_pui32UARTTxDMASize[ui32Select])
+        {
+#ifdef UART_DEFERRED_LOG
+            if(!UARTLogDMAQueue(ui32Select) && !UARTTxDMAQueue(ui32Select))
+#else
+            if(!UARTTxDMAQueue(ui32Select))
+#endif
+            {
+                break;
+            }
+            ui32Select ^= 1;
+        }
+
+        //
+        // If the controller has stopped (because it reached the end of the
+        // transfers before the next one was set up, or had not been started)
+        // and there is a transfer waiting, start it with the oldest one.
+        //
+        ui32Select = g_ui32UARTTxDMAHead;
+        if(g_pui32UARTTxDMASize[ui32Select] &&
+           !MAP_uDMAChannelIsEnabled(g_ui32UARTTxChannel))
+        {
+            if(ui32Select)
+            {
+                MAP_uDMAChannelAttributeEnable(g_ui32UARTTxChannel,
+                                               UDMA_ATTR_ALTSELECT);
+            }
+            else
+            {
+                MAP_uDMAChannelAttributeDisable(g_ui32UARTTxChannel,
+                                                UDMA_ATTR_ALTSELECT);
+            }
+            MAP_uDMAChannelEnable(g_ui32UARTTxChannel);
         }
 
         //
@@ -327,6 +820,14 @@ UARTPrimeTransmit(uint32_t ui32Base)
 //! caller has previously configured the relevant UART pins for operation as a
 //! UART rather than as GPIOs.
 //!
+//! When the module is built with \b UART_DMA (in addition to
+//! \b UART_BUFFERED), the uDMA controller moves the data between the UART
+//! FIFOs and the transmit and receive buffers, so that the UART interrupt
+//! occurs only once for each transfer rather than every few characters.  In
+//! this case, the caller must also have enabled the uDMA controller and set
+//! its control table, using uDMAEnable() and uDMAControlBaseSet(), and this
+//! function takes over the uDMA channels of the UART.
+//!
 //! \return None.
 //
 //*****************************************************************************
@@ -371,12 +872,21 @@ UARTStdioConfig(uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock)
                             (UART_CONFIG_PAR_NONE | UART_CONFIG_STOP_ONE |
                              UART_CONFIG_WLEN_8));
 
-#ifdef UART_BUFFERED
+#ifdef UART_DMA
+    //
+    // Set the UART to request a burst of transfers from the uDMA controller
+    // whenever the TX FIFO is half empty or the RX FIFO is half full.
+    //
+    MAP_UARTFIFOLevelSet(g_ui32Base, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+#elif defined(UART_BUFFERED)
     //
     // Set the UART to interrupt whenever the TX FIFO is almost empty or
     // when any character is received.
     //
     MAP_UARTFIFOLevelSet(g_ui32Base, UART_FIFO_TX1_8, UART_FIFO_RX1_8);
+#endif
+
+#ifdef UART_BUFFERED
 
     //
     // Flush both the buffers.
@@ -396,10 +906,76 @@ UARTStdioConfig(uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock)
     // in the transmit buffer.
     //
     MAP_UARTIntDisable(g_ui32Base, 0xFFFFFFFF);
+#ifdef UART_DMA
+    MAP_UARTIntEnable(g_ui32Base, UART_INT_RT);
+#else
     MAP_UARTIntEnable(g_ui32Base, UART_INT_RX | UART_INT_RT);
+#endif
     MAP_IntEnable(g_ui32UARTInt[ui32PortNum]);
 #endif
 
+#ifdef UART_DMA
+    //
+    // Assign the uDMA channels to the UART.  The application must already
+    // have enabled the uDMA controller and given it its control table.
+    //
+    ASSERT(MAP_uDMAControlBaseGet() != 0);
+    g_ui32UARTRxChannel = g_ui32UARTRxDMA[ui32PortNum];
+    g_ui32UARTTxChannel = g_ui32UARTTxDMA[ui32PortNum];
+    MAP_uDMAChannelAssign(g_ui32UARTRxChannel);
+    MAP_uDMAChannelAssign(g_ui32UARTTxChannel);
+
+    //
+    // Set the receive channel to receive into the two receive buffers in
+    // turn, in ping-pong mode.  It only responds to burst requests, which
+    // the UART makes when the RX FIFO is half full, and then takes four
+    // characters at a time, so that at least four are always left in the
+    // FIFO.  The last characters of a message therefore cause a receive
+    // timeout interrupt when the line goes idle.
+    //
+    MAP_uDMAChannelAttributeDisable(g_ui32UARTRxChannel, UDMA_ATTR_ALL);
+    MAP_uDMAChannelAttributeEnable(g_ui32UARTRxChannel, UDMA_ATTR_USEBURST);
+    for(g_ui32UARTRxDMASelect = 0; g_ui32UARTRxDMASelect < 2;
+        g_ui32UARTRxDMASelect++)
+    {
+        MAP_uDMAChannelControlSet(RX_DMA_STRUCT(g_ui32UARTRxDMASelect),
+                                  (UDMA_SIZE_8 | UDMA_SRC_INC_NONE |
+                                   UDMA_DST_INC_8 | UDMA_ARB_4));
+        MAP_uDMAChannelTransferSet(RX_DMA_STRUCT(g_ui32UARTRxDMASelect),
+                                   UDMA_MODE_PINGPONG,
+                                   (void *)(uintptr_t)(g_ui32Base +
+                                                       UART_O_DR),
+                                   g_ppcUARTRxDMABuffer[g_ui32UARTRxDMASelect],
+                                   UART_RX_DMA_SIZE);
+    }
+    g_ui32UARTRxDMASelect = 0;
+    g_ui32UARTRxDMARead = 0;
+    MAP_uDMAChannelEnable(g_ui32UARTRxChannel);
+
+    //
+    // Set the transmit channel to transmit from the transmit buffer.  The
+    // transfers are set up when there is data to transmit.
+    //
+    MAP_uDMAChannelAttributeDisable(g_ui32UARTTxChannel, UDMA_ATTR_ALL);
+    MAP_uDMAChannelControlSet(TX_DMA_STRUCT(0),
+                              (UDMA_SIZE_8 | UDMA_SRC_INC_8 |
+                               UDMA_DST_INC_NONE | UDMA_ARB_4));
+    MAP_uDMAChannelControlSet(TX_DMA_STRUCT(1),
+                              (UDMA_SIZE_8 | UDMA_SRC_INC_8 |
+                               UDMA_DST_INC_NONE | UDMA_ARB_4));
+
+    //
+    // Let the UART request transfers.  On parts which report the end of
+    // the transfers in the UART interrupt status, enable those interrupts
+    // as well.
+    //
+    MAP_UARTDMAEnable(g_ui32Base, UART_DMA_RX | UART_DMA_TX);
+    if(CLASS_IS_TM4C129)
+    {
+        MAP_UARTIntEnable(g_ui32Base, UART_INT_DMARX | UART_INT_DMATX);
+    }
+#endif
+
     //
     // Enable the UART operation.
     //
@@ -493,7 +1069,9 @@ UARTwrite(const char *pcBuf, uint32_t ui32Len)
     if(!TX_BUFFER_EMPTY)
     {
         UARTPrimeTransmit(g_ui32Base);
+#ifndef UART_DMA
         MAP_UARTIntEnable(g_ui32Base, UART_INT_TX);
+#endif
     }
 
     //
@@ -1294,17 +1872,370 @@ UARTprintf(const char *pcString, ...)
     va_list vaArgP;
 
     //
-    // Start the varargs processing.
+    // Start the varargs processing.
+    //
+    va_start(vaArgP, pcString);
+
+    UARTvprintf(pcString, vaArgP);
+
+    //
+    // We're finished with the varargs now.
+    //
+    va_end(vaArgP);
+}
+
+//*****************************************************************************
+//
+// Stores a 32-bit value in a log record, least significant byte first.
+//
+//*****************************************************************************
+#ifdef UART_DEFERRED_LOG
+static void
+UARTLogWordPut(unsigned char *pcRecord, uint32_t ui32Value)
+{
+    pcRecord[0] = (unsigned char)ui32Value;
+    pcRecord[1] = (unsigned char)(ui32Value >> 8);
+    pcRecord[2] = (unsigned char)(ui32Value >> 16);
+    pcRecord[3] = (unsigned char)(ui32Value >> 24);
+}
+#endif
+
+//*****************************************************************************
+//
+//! A UART based printf function which defers the formatting to the host.
+//!
+//! \param pcString is the format string, which must be a constant string in
+//! the firmware image.
+//! \param vaArgP is a variable argument list pointer whose content will depend
+//! upon the format string passed in \e pcString.
+//!
+//! This function, available only when the module is built with
+//! \b UART_DEFERRED_LOG, records the address of the format string, a
+//! timestamp, and the arguments in a binary log record instead of formatting
+//! the text, so that it takes little time and can be used from time-critical
+//! code and interrupt handlers.  It supports the same formatting characters
+//! as UARTvprintf(); the characters of each \%s string are copied into the
+//! record (so the string need not remain valid afterwards), and the other
+//! arguments are copied as 32-bit values.  Arguments which do not fit in the
+//! \b UART_LOG_RECORD_SIZE bytes of a record are discarded, as are records
+//! which do not fit in the log buffer.
+//!
+//! The records are sent on the UART in binary, each starting with the byte
+//! \b UART_LOG_SYNC, and are expanded into text by the uartlog tool using the
+//! format strings in the firmware image.  In buffered mode, the records are
+//! sent by UARTStdioIntHandler() whenever no text is waiting to be sent; this
+//! function pends the UART interrupt to start them.  In unbuffered mode,
+//! UARTLogDrain() must be called, typically from a low priority task, to send
+//! them.
+//!
+//! The timestamp of each record is provided by the function given to
+//! UARTLogTimestampSet(), and is zero if none has been given.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#if defined(UART_DEFERRED_LOG) || defined(DOXYGEN)
+void
+UARTvlog(const char *pcString, va_list vaArgP)
+{
+    unsigned char pcRecord[UART_LOG_RECORD_SIZE], ucSum;
+    uint32_t ui32Len, ui32Idx, ui32Write, ui32Int;
+    const char *pcStr;
+    bool bFull;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pcString != 0);
+
+    //
+    // Fill in the address of the format string and the timestamp.
+    //
+    UARTLogWordPut(pcRecord + UART_LOG_O_FORMAT,
+                   (uint32_t)(uintptr_t)pcString);
+    UARTLogWordPut(pcRecord + UART_LOG_O_TIMESTAMP,
+                   g_pfnUARTLogTimestamp ? g_pfnUARTLogTimestamp() : 0);
+    ui32Len = UART_LOG_O_ARGS;
+    bFull = false;
+
+    //
+    // Find the conversions in the format string in the same way as
+    // UARTvprintf(), and copy their arguments into the record.  Once an
+    // argument does not fit, no further arguments are stored, so that the
+    // host does not confuse one argument for another.
+    //
+    while(*pcString)
+    {
+        //
+        // Skip to the character after the next %, and then past any digits.
+        //
+        if(*pcString++ != '%')
+        {
+            continue;
+        }
+        while((*pcString >= '0') && (*pcString <= '9'))
+        {
+            pcString++;
+        }
+
+        switch(*pcString)
+        {
+            //
+            // Copy the value of the commands which take an integer.
+            //
+            case 'c':
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'p':
+            {
+                ui32Idx = va_arg(vaArgP, uint32_t);
+                if(bFull || ((ui32Len + 4) >= UART_LOG_RECORD_SIZE))
+                {
+                    bFull = true;
+                    break;
+                }
+                UARTLogWordPut(pcRecord + ui32Len, ui32Idx);
+                ui32Len += 4;
+                break;
+            }
+
+            //
+            // Copy as much of the string of the %s command as will fit.
+            //
+            case 's':
+            {
+                pcStr = va_arg(vaArgP, const char *);
+                if(bFull || ((ui32Len + 1) >= UART_LOG_RECORD_SIZE))
+                {
+                    bFull = true;
+                    break;
+                }
+                for(ui32Idx = 0;
+                    pcStr[ui32Idx] &&
+                    ((ui32Len + 2 + ui32Idx) < UART_LOG_RECORD_SIZE);
+                    ui32Idx++)
+                {
+                    pcRecord[ui32Len + 1 + ui32Idx] = pcStr[ui32Idx];
+                }
+                pcRecord[ui32Len] = (unsigned char)ui32Idx;
+                ui32Len += ui32Idx + 1;
+                break;
+            }
+
+            //
+            // The format string ended in the middle of a command.
+            //
+            case '\0':
+            {
+                continue;
+            }
+
+            //
+            // All other commands take no arguments.
+            //
+            default:
+            {
+                break;
+            }
+        }
+        pcString++;
+    }
+
+    //
+    // Fill in the sync byte, the length, and the checksum.
+    //
+    pcRecord[0] = UART_LOG_SYNC;
+    pcRecord[UART_LOG_O_LENGTH] = (unsigned char)(ui32Len + 1);
+    for(ui32Idx = UART_LOG_O_LENGTH, ucSum = 0; ui32Idx < ui32Len; ui32Idx++)
+    {
+        ucSum += pcRecord[ui32Idx];
+    }
+    pcRecord[ui32Len++] = (unsigned char)-ucSum;
+
+    //
+    // Copy the record into the log buffer if there is space for it.  This is
+    // done with interrupts disabled so that the records of different
+    // interrupt handlers are not mixed.
+    //
+    ui32Int = MAP_IntMasterDisable();
+    ui32Write = g_ui32UARTLogWriteCount;
+    if((UART_LOG_BUFFER_SIZE - LOG_BUFFER_USED) >= ui32Len)
+    {
+        for(ui32Idx = 0; ui32Idx < ui32Len; ui32Idx++)
+        {
+            LOG_BUFFER_BYTE(ui32Write + ui32Idx) = pcRecord[ui32Idx];
+        }
+        g_ui32UARTLogWriteCount = ui32Write + ui32Len;
+    }
+    else
+    {
+        g_ui32UARTLogDropped++;
+    }
+    if(!ui32Int)
+    {
+        MAP_IntMasterEnable();
+    }
+
+#ifdef UART_BUFFERED
+    //
+    // Have the UART interrupt handler send the record.
+    //
+    MAP_IntPendSet(g_ui32UARTInt[g_ui32PortNum]);
+#endif
+}
+#endif
+
+//*****************************************************************************
+//
+//! A UART based printf function which defers the formatting to the host.
+//!
+//! \param pcString is the format string, which must be a constant string in
+//! the firmware image.
+//! \param ... are the optional arguments, which depend on the contents of the
+//! format string.
+//!
+//! This function, available only when the module is built with
+//! \b UART_DEFERRED_LOG, records a log record in the same way as UARTvlog().
+//!
+//! \return None.
+//
+//*****************************************************************************
+#if defined(UART_DEFERRED_LOG) || defined(DOXYGEN)
+void
+UARTlog(const char *pcString, ...)
+{
+    va_list vaArgP;
+
+    //
+    // Start the varargs processing.
+    //
+    va_start(vaArgP, pcString);
+
+    UARTvlog(pcString, vaArgP);
+
+    //
+    // We're finished with the varargs now.
+    //
+    va_end(vaArgP);
+}
+#endif
+
+//*****************************************************************************
+//
+//! Sets the function which provides the timestamps of log records.
+//!
+//! \param pfnTimestamp is a pointer to the function, or 0 for none.
+//!
+//! This function, available only when the module is built with
+//! \b UART_DEFERRED_LOG, sets the function called by UARTvlog() to get the
+//! timestamp of each record.  It is typically a function returning the value
+//! of a free-running timer, and must be callable from any context in which
+//! UARTlog() is called.  The uartlog tool prints the timestamps as given, or
+//! as seconds if it is told their frequency.
+//!
+//! \return None.
+//
+//*****************************************************************************
+#if defined(UART_DEFERRED_LOG) || defined(DOXYGEN)
+void
+UARTLogTimestampSet(uint32_t (*pfnTimestamp)(void))
+{
+    g_pfnUARTLogTimestamp = pfnTimestamp;
+}
+#endif
+
+//*****************************************************************************
+//
+//! Sends the log records waiting in the log buffer.
+//!
+//! This function, available only when the module is built with
+//! \b UART_DEFERRED_LOG, sends the records placed in the log buffer by
+//! UARTlog().  In unbuffered mode, it must be called to send the records,
+//! typically from a low priority task, and does not return until all of
+//! them have been written to the UART; text should not be written by
+//! UARTprintf() while it runs, since the text would be placed in the middle
+//! of a record.  In buffered mode, the records are sent by the UART
+//! interrupt handler, so this function only starts sending them if they are
+//! not already being sent.
+//!
+//! \return Returns the number of bytes of log records still waiting to be
+//! sent.
+//
+//*****************************************************************************
+#if defined(UART_DEFERRED_LOG) || defined(DOXYGEN)
+uint32_t
+UARTLogDrain(void)
+{
+#ifdef UART_BUFFERED
+    //
+    // Check for a valid UART base address.
+    //
+    ASSERT(g_ui32Base != 0);
+
+    //
+    // If there is anything waiting to be sent, make sure that the UART is
+    // set up to transmit it.
+    //
+    if(!LOG_BUFFER_EMPTY)
+    {
+        UARTPrimeTransmit(g_ui32Base);
+#ifndef UART_DMA
+        MAP_UARTIntEnable(g_ui32Base, UART_INT_TX);
+#endif
+    }
+
+    //
+    // Return the number of bytes still waiting.
     //
-    va_start(vaArgP, pcString);
+    return(LOG_BUFFER_USED);
+#else
+    uint32_t ui32Read;
 
-    UARTvprintf(pcString, vaArgP);
+    //
+    // Check for a valid UART base address.
+    //
+    ASSERT(g_ui32Base != 0);
 
     //
-    // We're finished with the varargs now.
+    // Send the records, including any added while this is running.
     //
-    va_end(vaArgP);
+    for(ui32Read = g_ui32UARTLogReadCount; !LOG_BUFFER_EMPTY; )
+    {
+        MAP_UARTCharPut(g_ui32Base, LOG_BUFFER_BYTE(ui32Read));
+        g_ui32UARTLogReadCount = ++ui32Read;
+    }
+
+    //
+    // All the records have been sent.
+    //
+    return(0);
+#endif
+}
+#endif
+
+//*****************************************************************************
+//
+//! Returns the number of log records which have been discarded.
+//!
+//! This function, available only when the module is built with
+//! \b UART_DEFERRED_LOG, may be used to determine how many records UARTlog()
+//! has discarded because there was not enough space for them in the log
+//! buffer.  If this happens often, \b UART_LOG_BUFFER_SIZE should be
+//! increased or the records should be drained more often.
+//!
+//! \return Returns the number of discarded records.
+//
+//*****************************************************************************
+#if defined(UART_DEFERRED_LOG) || defined(DOXYGEN)
+uint32_t
+UARTLogDropped(void)
+{
+    return(g_ui32UARTLogDropped);
 }
+#endif
 
 //*****************************************************************************
 //
@@ -1456,7 +2387,9 @@ UARTFlushRx(void)
 //! buffered mode using \b UART_BUFFERED, may be used to flush the transmit
 //! buffer, either discarding or transmitting any data received via calls to
 //! UARTprintf() that is waiting to be transmitted.  On return, the transmit
-//! buffer will be empty.
+//! buffer will be empty, except that when the module is built to use the uDMA
+//! controller using \b UART_DMA, data being transmitted by the controller is
+//! not discarded.
 //!
 //! \return None.
 //
@@ -1479,10 +2412,15 @@ UARTFlushTx(bool bDiscard)
         ui32Int = MAP_IntMasterDisable();
 
         //
-        // Flush the transmit buffer.
+        // Flush the transmit buffer.  In uDMA mode, the data which has
+        // already been given to the uDMA controller is still transmitted.
         //
+#ifdef UART_DMA
+        g_ui32UARTTxWriteIndex = g_ui32UARTTxDMAIndex;
+#else
         g_ui32UARTTxReadIndex = 0;
         g_ui32UARTTxWriteIndex = 0;
+#endif
 
         //
         // If interrupts were enabled when we turned them off, turn them
@@ -1533,6 +2471,270 @@ UARTEchoSet(bool bEnable)
 }
 #endif
 
+//*****************************************************************************
+//
+// Process a character received from the UART, handling the line editing and
+// echo if echo is enabled, and store it in the receive buffer.
+//
+//*****************************************************************************
+#ifdef UART_BUFFERED
+static void
+UARTReceiveChar(int32_t i32Char)
+{
+    int8_t cChar;
+    static bool bLastWasCR = false;
+
+    cChar = (unsigned char)(i32Char & 0xFF);
+
+    //
+    // If echo is disabled, we skip the various text filtering
+    // operations that would typically be required when supporting a
+    // command line.
+    //
+    if(!g_bDisableEcho)
+    {
+        //
+        // Handle backspace by erasing the last character in the
+        // buffer.
+        //
+        if(cChar == '\b')
+        {
+            //
+            // If there are any characters already in the buffer, then
+            // delete the last.
+            //
+            if(!RX_BUFFER_EMPTY)
+            {
+                //
+                // Rub out the previous character on the users
+                // terminal.
+                //
+                UARTwrite("\b \b", 3);
+
+                //
+                // Decrement the number of characters in the buffer.
+                //
+                if(g_ui32UARTRxWriteIndex == 0)
+                {
+                    g_ui32UARTRxWriteIndex = UART_RX_BUFFER_SIZE - 1;
+                }
+                else
+                {
+                    g_ui32UARTRxWriteIndex--;
+                }
+            }
+
+            //
+            // Skip ahead to read the next character.
+            //
+            return;
+        }
+
+        //
+        // If this character is LF and last was CR, then just gobble up
+        // the character since we already echoed the previous CR and we
+        // don't want to store 2 characters in the buffer if we don't
+        // need to.
+        //
+        if((cChar == '\n') && bLastWasCR)
+        {
+            bLastWasCR = false;
+            return;
+        }
+
+        //
+        // See if a newline or escape character was received.
+        //
+        if((cChar == '\r') || (cChar == '\n') || (cChar == 0x1b))
+        {
+            //
+            // If the character is a CR, then it may be followed by an
+            // LF which should be paired with the CR.  So remember that
+            // a CR was received.
+            //
+            if(cChar == '\r')
+            {
+                bLastWasCR = 1;
+            }
+
+            //
+            // Regardless of the line termination character received,
+            // put a CR in the receive buffer as a marker telling
+            // UARTgets() where the line ends.  We also send an
+            // additional LF to ensure that the local terminal echo
+            // receives both CR and LF.
+            //
+            cChar = '\r';
+            UARTwrite("\n", 1);
+        }
+    }
+
+    //
+    // If there is space in the receive buffer, put the character
+    // there, otherwise throw it away.
+    //
+    if(!RX_BUFFER_FULL)
+    {
+        //
+        // Store the new character in the receive buffer
+        //
+        g_pcUARTRxBuffer[g_ui32UARTRxWriteIndex] =
+            (unsigned char)(i32Char & 0xFF);
+        ADVANCE_RX_BUFFER_INDEX(g_ui32UARTRxWriteIndex);
+
+        //
+        // If echo is enabled, write the character to the transmit
+        // buffer so that the user gets some immediate feedback.
+        //
+        if(!g_bDisableEcho)
+        {
+            UARTwrite((const char *)&cChar, 1);
+        }
+    }
+}
+#endif
+
+//*****************************************************************************
+//
+// Process the characters which the uDMA controller has received since this
+// was last called, and set up the receive buffers that it has filled to be
+// filled again.
+//
+//*****************************************************************************
+#ifdef UART_DMA
+static void
+UARTDMAReceiveBuffers(void)
+{
+    uint32_t ui32Select, ui32Count;
+    bool bFull;
+
+    while(1)
+    {
+        //
+        // Find how many characters have been received into the buffer being
+        // filled.  The controller marks its control structure as stopped
+        // once it is full.
+        //
+        ui32Select = g_ui32UARTRxDMASelect;
+        bFull = ((MAP_uDMAChannelModeGet(RX_DMA_STRUCT(ui32Select)) ==
+                  UDMA_MODE_STOP) ? true : false);
+        ui32Count = (bFull ? UART_RX_DMA_SIZE :
+                     (UART_RX_DMA_SIZE -
+                      MAP_uDMAChannelSizeGet(RX_DMA_STRUCT(ui32Select))));
+
+        //
+        // Process the characters which have not been processed yet.
+        //
+        while(g_ui32UARTRxDMARead < ui32Count)
+        {
+            UARTReceiveChar(g_ppcUARTRxDMABuffer[ui32Select]
+                                                [g_ui32UARTRxDMARead++]);
+        }
+
+        //
+        // Stop once the buffer being filled is reached.
+        //
+        if(!bFull)
+        {
+            break;
+        }
+
+        //
+        // Set up the full buffer to be filled again once the other has been
+        // filled, and move on to the other.
+        //
+        MAP_uDMAChannelTransferSet(RX_DMA_STRUCT(ui32Select),
+                                   UDMA_MODE_PINGPONG,
+                                   (void *)(uintptr_t)(g_ui32Base +
+                                                       UART_O_DR),
+                                   g_ppcUARTRxDMABuffer[ui32Select],
+                                   UART_RX_DMA_SIZE);
+        g_ui32UARTRxDMASelect = ui32Select ^ 1;
+        g_ui32UARTRxDMARead = 0;
+    }
+
+    //
+    // If both buffers were filled before either could be set up again, the
+    // controller has stopped, so start it again with the buffer that is to
+    // be filled next.
+    //
+    if(!MAP_uDMAChannelIsEnabled(g_ui32UARTRxChannel))
+    {
+        if(g_ui32UARTRxDMASelect)
+        {
+            MAP_uDMAChannelAttributeEnable(g_ui32UARTRxChannel,
+                                           UDMA_ATTR_ALTSELECT);
+        }
+        else
+        {
+            MAP_uDMAChannelAttributeDisable(g_ui32UARTRxChannel,
+                                            UDMA_ATTR_ALTSELECT);
+        }
+        MAP_uDMAChannelEnable(g_ui32UARTRxChannel);
+    }
+}
+#endif
+
+//*****************************************************************************
+//
+// Process the characters which have been received in uDMA mode.  The uDMA
+// controller always leaves some characters in the receive FIFO, so once the
+// line has gone idle (and the receive timeout interrupt has occurred), the
+// characters left in the FIFO are read here.
+//
+//*****************************************************************************
+#ifdef UART_DMA
+static void
+UARTDMAReceive(uint32_t ui32Base, bool bIdle)
+{
+    unsigned char pcFIFO[16];
+    uint32_t ui32Count, ui32Idx;
+
+    //
+    // If the line is not idle, only process the characters in the receive
+    // buffers.
+    //
+    if(!bIdle)
+    {
+        UARTDMAReceiveBuffers();
+        return;
+    }
+
+    //
+    // Stop the UART requesting transfers, so that no character in the
+    // receive FIFO is received into a buffer after it is read here.
+    //
+    MAP_UARTDMADisable(ui32Base, UART_DMA_RX);
+
+    //
+    // Read the characters left in the receive FIFO.
+    //
+    for(ui32Count = 0;
+        (ui32Count < sizeof(pcFIFO)) && MAP_UARTCharsAvail(ui32Base);
+        ui32Count++)
+    {
+        pcFIFO[ui32Count] = MAP_UARTCharGetNonBlocking(ui32Base);
+    }
+
+    //
+    // Process the characters in the receive buffers, which arrived before
+    // those in the FIFO.  This is done after reading the FIFO so that it
+    // includes the characters of a burst that the controller had already
+    // started when the requests were stopped.
+    //
+    UARTDMAReceiveBuffers();
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        UARTReceiveChar(pcFIFO[ui32Idx]);
+    }
+
+    //
+    // Let the UART request transfers again.
+    //
+    MAP_UARTDMAEnable(ui32Base, UART_DMA_RX);
+}
+#endif
+
 //*****************************************************************************
 //
 //! Handles UART interrupts.
@@ -1540,7 +2742,15 @@ UARTEchoSet(bool bEnable)
 //! This function handles interrupts from the UART.  It will copy data from the
 //! transmit buffer to the UART transmit FIFO if space is available, and it
 //! will copy data from the UART receive FIFO to the receive buffer if data is
-//! available.
+//! available.  When built with \b UART_DEFERRED_LOG, it also copies the log
+//! records written by UARTlog() to the UART transmit FIFO once there is no
+//! data in the transmit buffer.
+//!
+//! When built with \b UART_DMA, the uDMA controller moves the data instead,
+//! and this function is called only when one of its transfers finishes or
+//! when the receive line goes idle.  It then processes the data received
+//! into the receive buffer, and sets up the next transfers of the data in
+//! the transmit buffer.
 //!
 //! \return None.
 //
@@ -1550,9 +2760,6 @@ void
 UARTStdioIntHandler(void)
 {
     uint32_t ui32Ints;
-    int8_t cChar;
-    int32_t i32Char;
-    static bool bLastWasCR = false;
 
     //
     // Get and clear the current interrupt source(s)
@@ -1560,6 +2767,22 @@ UARTStdioIntHandler(void)
     ui32Ints = MAP_UARTIntStatus(g_ui32Base, true);
     MAP_UARTIntClear(g_ui32Base, ui32Ints);
 
+#ifdef UART_DMA
+    //
+    // The uDMA controller signals the end of each transfer with this
+    // interrupt, but not every part reports it in the interrupt status, so
+    // both channels are checked every time.  Process the characters that
+    // have been received, and any left in the receive FIFO if the line has
+    // gone idle.
+    //
+    UARTDMAReceive(g_ui32Base, (ui32Ints & UART_INT_RT) ? true : false);
+
+    //
+    // Release the space used by the transfers that have finished, and start
+    // the next ones.
+    //
+    UARTPrimeTransmit(g_ui32Base);
+#else
     //
     // Are we being interrupted because the TX FIFO has space available?
     //
@@ -1573,11 +2796,29 @@ UARTStdioIntHandler(void)
         //
         // If the output buffer is empty, turn off the transmit interrupt.
         //
+#ifdef UART_DEFERRED_LOG
+        if(TX_BUFFER_EMPTY && LOG_BUFFER_EMPTY &&
+           (g_ui32UARTLogRecordLeft == 0))
+#else
         if(TX_BUFFER_EMPTY)
+#endif
         {
             MAP_UARTIntDisable(g_ui32Base, UART_INT_TX);
         }
     }
+#ifdef UART_DEFERRED_LOG
+
+    //
+    // If this interrupt was pended by UARTvlog() (or the transmit interrupt
+    // was turned off before a record was added), start sending the log
+    // records and turn on the transmit interrupt to send the rest.
+    //
+    else if(!LOG_BUFFER_EMPTY)
+    {
+        UARTPrimeTransmit(g_ui32Base);
+        MAP_UARTIntEnable(g_ui32Base, UART_INT_TX);
+    }
+#endif
 
     //
     // Are we being interrupted due to a received character?
@@ -1589,117 +2830,7 @@ UARTStdioIntHandler(void)
         //
         while(MAP_UARTCharsAvail(g_ui32Base))
         {
-            //
-            // Read a character
-            //
-            i32Char = MAP_UARTCharGetNonBlocking(g_ui32Base);
-            cChar = (unsigned char)(i32Char & 0xFF);
-
-            //
-            // If echo is disabled, we skip the various text filtering
-            // operations that would typically be required when supporting a
-            // command line.
-            //
-            if(!g_bDisableEcho)
-            {
-                //
-                // Handle backspace by erasing the last character in the
-                // buffer.
-                //
-                if(cChar == '\b')
-                {
-                    //
-                    // If there are any characters already in the buffer, then
-                    // delete the last.
-                    //
-                    if(!RX_BUFFER_EMPTY)
-                    {
-                        //
-                        // Rub out the previous character on the users
-                        // terminal.
-                        //
-                        UARTwrite("\b \b", 3);
-
-                        //
-                        // Decrement the number of characters in the buffer.
-                        //
-                        if(g_ui32UARTRxWriteIndex == 0)
-                        {
-                            g_ui32UARTRxWriteIndex = UART_RX_BUFFER_SIZE - 1;
-                        }
-                        else
-                        {
-                            g_ui32UARTRxWriteIndex--;
-                        }
-                    }
-
-                    //
-                    // Skip ahead to read the next character.
-                    //
-                    continue;
-                }
-
-                //
-                // If this character is LF and last was CR, then just gobble up
-                // the character since we already echoed the previous CR and we
-                // don't want to store 2 characters in the buffer if we don't
-                // need to.
-                //
-                if((cChar == '\n') && bLastWasCR)
-                {
-                    bLastWasCR = false;
-                    continue;
-                }
-
-                //
-                // See if a newline or escape character was received.
-                //
-                if((cChar == '\r') || (cChar == '\n') || (cChar == 0x1b))
-                {
-                    //
-                    // If the character is a CR, then it may be followed by an
-                    // LF which should be paired with the CR.  So remember that
-                    // a CR was received.
-                    //
-                    if(cChar == '\r')
-                    {
-                        bLastWasCR = 1;
-                    }
-
-                    //
-                    // Regardless of the line termination character received,
-                    // put a CR in the receive buffer as a marker telling
-                    // UARTgets() where the line ends.  We also send an
-                    // additional LF to ensure that the local terminal echo
-                    // receives both CR and LF.
-                    //
-                    cChar = '\r';
-                    UARTwrite("\n", 1);
-                }
-            }
-
-            //
-            // If there is space in the receive buffer, put the character
-            // there, otherwise throw it away.
-            //
-            if(!RX_BUFFER_FULL)
-            {
-                //
-                // Store the new character in the receive buffer
-                //
-                g_pcUARTRxBuffer[g_ui32UARTRxWriteIndex] =
-                    (unsigned char)(i32Char & 0xFF);
-                ADVANCE_RX_BUFFER_INDEX(g_ui32UARTRxWriteIndex);
-
-                //
-                // If echo is enabled, write the character to the transmit
-                // buffer so that the user gets some immediate feedback.
-                //
-                if(!g_bDisableEcho)
-                {
-                    UARTwrite((const char *)&cChar, 1);
-                }
-            }
+            UARTReceiveChar(MAP_UARTCharGetNonBlocking(g_ui32Base));
         }
 
         //
@@ -1709,6 +2840,7 @@ UARTStdioIntHandler(void)
         UARTPrimeTransmit(g_ui32Base);
         MAP_UARTIntEnable(g_ui32Base, UART_INT_TX);
     }
+#endif
 }
 #endif
 
@@ -53,6 +53,52 @@ extern "C"
 #endif
 #endif
 
+//*****************************************************************************
+//
+// If built for uDMA operation (which also requires buffered operation), the
+// following label defines the size of each of the two buffers into which the
+// uDMA controller receives characters, taking turns.
+//
+//*****************************************************************************
+#ifdef UART_DMA
+#ifndef UART_RX_DMA_SIZE
+#define UART_RX_DMA_SIZE        64
+#endif
+#endif
+
+//*****************************************************************************
+//
+// If built with the deferred log, the following labels define the size of
+// the buffer holding the log records (which must be a power of two) and the
+// largest size of a single record.
+//
+//*****************************************************************************
+#ifdef UART_DEFERRED_LOG
+#ifndef UART_LOG_BUFFER_SIZE
+#define UART_LOG_BUFFER_SIZE    1024
+#endif
+#ifndef UART_LOG_RECORD_SIZE
+#define UART_LOG_RECORD_SIZE    64
+#endif
+#endif
+
+//*****************************************************************************
+//
+// The layout of a deferred log record as sent on the UART.  Each record
+// starts with the sync byte, which never appears in text, followed by the
+// length of the whole record, the address of the format string and the
+// timestamp (both 32-bit little-endian values), the arguments, and a
+// checksum which makes the sum of the bytes after the sync byte zero.  Each
+// argument is a 32-bit little-endian value, except for that of %s, which is
+// a byte giving the length of the string followed by its characters.
+//
+//*****************************************************************************
+#define UART_LOG_SYNC           0xFE
+#define UART_LOG_O_LENGTH       1
+#define UART_LOG_O_FORMAT       2
+#define UART_LOG_O_TIMESTAMP    6
+#define UART_LOG_O_ARGS         10
+
 //*****************************************************************************
 //
 // Prototypes for the APIs.
@@ -73,6 +119,13 @@ extern int UARTRxBytesAvail(void);
 extern int UARTTxBytesFree(void);
 extern void UARTEchoSet(bool bEnable);
 #endif
+#ifdef UART_DEFERRED_LOG
+extern void UARTlog(const char *pcString, ...);
+extern void UARTvlog(const char *pcString, va_list vaArgP);
+extern void UARTLogTimestampSet(uint32_t (*pfnTimestamp)(void));
+extern uint32_t UARTLogDrain(void);
+extern uint32_t UARTLogDropped(void);
+#endif
 
 //*****************************************************************************
 //
@@ -22,6 +22,7 @@
 //
 //*****************************************************************************
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "driverlib/debug.h"
 #include "utils/ustdlib.h"
@@ -105,8 +106,851 @@ ustrncpy(char * restrict s1, const char * restrict s2, size_t n)
 
 //*****************************************************************************
 //
-//! A simple vsnprintf function supporting \%c, \%d, \%p, \%s, \%u, \%x, and
-//! \%X.
+// The two digit decimal representations of the numbers from 0 to 99, used to
+// convert values to decimal two digits at a time.
+//
+//*****************************************************************************
+static const char g_pcDecimalPairs[200] =
+    "000102030405060708091011121314151617181920212223242526272829"
+    "303132333435363738394041424344454647484950515253545556575859"
+    "606162636465666768697071727374757677787980818283848586878889"
+    "90919293949596979899";
+
+//*****************************************************************************
+//
+// The flags which modify a conversion in the format string of uvsnprintf().
+//
+//*****************************************************************************
+#define FLAG_LEFT               0x00000001
+#define FLAG_PLUS               0x00000002
+#define FLAG_SPACE              0x00000004
+#define FLAG_ALT                0x00000008
+#define FLAG_ZERO               0x00000010
+#define FLAG_UPPER              0x00000020
+
+//*****************************************************************************
+//
+// The size of the buffer needed to hold the digits of any 64-bit value.
+//
+//*****************************************************************************
+#define DIGITS_MAX              24
+
+//*****************************************************************************
+//
+// The state of the output buffer of uvsnprintf().
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The position in the buffer at which the next character is stored.
+    //
+    char *pcBuf;
+
+    //
+    // The number of characters which can still be stored in the buffer.
+    //
+    size_t n;
+
+    //
+    // The number of characters which would have been stored in the buffer if
+    // it had been large enough.
+    //
+    int iCount;
+}
+tOutput;
+
+//*****************************************************************************
+//
+// Stores characters in the output buffer, as many as will fit.
+//
+//*****************************************************************************
+static void
+OutputChars(tOutput *psOut, const char *pcChars, size_t n)
+{
+    psOut->iCount += n;
+    if(n > psOut->n)
+    {
+        n = psOut->n;
+    }
+    psOut->n -= n;
+    while(n--)
+    {
+        *psOut->pcBuf++ = *pcChars++;
+    }
+}
+
+//*****************************************************************************
+//
+// Stores copies of a character in the output buffer, as many as will fit.
+//
+//*****************************************************************************
+static void
+OutputFill(tOutput *psOut, char cFill, size_t n)
+{
+    psOut->iCount += n;
+    if(n > psOut->n)
+    {
+        n = psOut->n;
+    }
+    psOut->n -= n;
+    while(n--)
+    {
+        *psOut->pcBuf++ = cFill;
+    }
+}
+
+//*****************************************************************************
+//
+// Starts a field of the given length, storing the padding which precedes it
+// (if it is right justified) and its prefix (a sign or radix indicator).
+// Returns the number of spaces which must follow the field, which are stored
+// by OutputFieldEnd().
+//
+//*****************************************************************************
+static uint32_t
+OutputFieldStart(tOutput *psOut, uint32_t ui32Flags, uint32_t ui32Width,
+                 const char *pcPrefix, uint32_t ui32Length)
+{
+    uint32_t ui32Prefix, ui32Pad;
+
+    //
+    // Find the number of padding characters needed to reach the width.
+    //
+    for(ui32Prefix = 0; pcPrefix[ui32Prefix]; ui32Prefix++)
+    {
+    }
+    ui32Length += ui32Prefix;
+    ui32Pad = (ui32Width > ui32Length) ? (ui32Width - ui32Length) : 0;
+
+    //
+    // A left justified field is padded afterwards.
+    //
+    if(ui32Flags & FLAG_LEFT)
+    {
+        OutputChars(psOut, pcPrefix, ui32Prefix);
+        return(ui32Pad);
+    }
+
+    //
+    // Zero padding goes between the prefix and the field, and space padding
+    // before both.
+    //
+    if(ui32Flags & FLAG_ZERO)
+    {
+        OutputChars(psOut, pcPrefix, ui32Prefix);
+        OutputFill(psOut, '0', ui32Pad);
+    }
+    else
+    {
+        OutputFill(psOut, ' ', ui32Pad);
+        OutputChars(psOut, pcPrefix, ui32Prefix);
+    }
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Ends a field started by OutputFieldStart().
+//
+//*****************************************************************************
+static void
+OutputFieldEnd(tOutput *psOut, uint32_t ui32Pad)
+{
+    OutputFill(psOut, ' ', ui32Pad);
+}
+
+//*****************************************************************************
+//
+// Stores a run of characters from a string of digits, given the index of the
+// first one.  Indices before the start or past the end of the digits are
+// stored as zeros.
+//
+//*****************************************************************************
+static void
+OutputDigits(tOutput *psOut, const char *pcDigits, int32_t i32Len,
+             int32_t i32Start, int32_t i32Count)
+{
+    int32_t i32Run;
+
+    //
+    // Store the zeros which come before the digits.
+    //
+    if((i32Start < 0) && (i32Count > 0))
+    {
+        i32Run = (-i32Start < i32Count) ? -i32Start : i32Count;
+        OutputFill(psOut, '0', i32Run);
+        i32Start += i32Run;
+        i32Count -= i32Run;
+    }
+
+    //
+    // Store the digits.
+    //
+    if((i32Start < i32Len) && (i32Count > 0))
+    {
+        i32Run = ((i32Len - i32Start) < i32Count) ? (i32Len - i32Start) :
+                 i32Count;
+        OutputChars(psOut, pcDigits + i32Start, i32Run);
+        i32Count -= i32Run;
+    }
+
+    //
+    // Store the zeros which come after the digits.
+    //
+    if(i32Count > 0)
+    {
+        OutputFill(psOut, '0', i32Count);
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the upper 64 bits of the 128-bit product of two 64-bit values,
+// computed from 32-bit by 32-bit multiplies (which take a single cycle on a
+// Cortex-M4).
+//
+//*****************************************************************************
+static uint64_t
+MultiplyHigh64(uint64_t ui64A, uint64_t ui64B)
+{
+    uint64_t ui64LL, ui64LH, ui64HL, ui64HH, ui64Mid;
+
+    ui64LL = (uint64_t)(uint32_t)ui64A * (uint32_t)ui64B;
+    ui64LH = (uint64_t)(uint32_t)ui64A * (uint32_t)(ui64B >> 32);
+    ui64HL = (uint64_t)(uint32_t)(ui64A >> 32) * (uint32_t)ui64B;
+    ui64HH = (uint64_t)(uint32_t)(ui64A >> 32) * (uint32_t)(ui64B >> 32);
+
+    ui64Mid = (ui64LL >> 32) + (uint32_t)ui64LH + (uint32_t)ui64HL;
+
+    return(ui64HH + (ui64LH >> 32) + (ui64HL >> 32) + (ui64Mid >> 32));
+}
+
+//*****************************************************************************
+//
+// Converts a value to decimal, storing the digits so that the last one is
+// just before the given end of a buffer.  Returns a pointer to the first
+// digit.
+//
+// The value is split into eight digit pieces by multiplying by the reciprocal
+// of 10^8, since a 64-bit divide is a slow library call on Cortex-M, and each
+// piece is converted two digits at a time.  The divides by 100 of 32-bit
+// values are turned into multiplies by the compiler.
+//
+//*****************************************************************************
+static char *
+DecimalConvert(uint64_t ui64Value, char *pcEnd)
+{
+    uint64_t ui64Quotient;
+    uint32_t ui32Value, ui32Quotient, ui32Pair, ui32Idx;
+
+    //
+    // Convert eight digits at a time while the value needs more than 32 bits.
+    //
+    while(ui64Value >> 32)
+    {
+        ui64Quotient = MultiplyHigh64(ui64Value, 0xABCC77118461CEFDULL) >> 26;
+        ui32Value = (uint32_t)(ui64Value - (ui64Quotient * 100000000));
+        ui64Value = ui64Quotient;
+
+        for(ui32Idx = 0; ui32Idx < 4; ui32Idx++)
+        {
+            ui32Quotient = ui32Value / 100;
+            ui32Pair = (ui32Value - (ui32Quotient * 100)) * 2;
+            pcEnd -= 2;
+            pcEnd[0] = g_pcDecimalPairs[ui32Pair];
+            pcEnd[1] = g_pcDecimalPairs[ui32Pair + 1];
+            ui32Value = ui32Quotient;
+        }
+    }
+
+    //
+    // Convert the remainder two digits at a time.
+    //
+    ui32Value = (uint32_t)ui64Value;
+    while(ui32Value >= 100)
+    {
+        ui32Quotient = ui32Value / 100;
+        ui32Pair = (ui32Value - (ui32Quotient * 100)) * 2;
+        pcEnd -= 2;
+        pcEnd[0] = g_pcDecimalPairs[ui32Pair];
+        pcEnd[1] = g_pcDecimalPairs[ui32Pair + 1];
+        ui32Value = ui32Quotient;
+    }
+
+    //
+    // Convert the last one or two digits.
+    //
+    if(ui32Value >= 10)
+    {
+        pcEnd -= 2;
+        pcEnd[0] = g_pcDecimalPairs[ui32Value * 2];
+        pcEnd[1] = g_pcDecimalPairs[(ui32Value * 2) + 1];
+    }
+    else
+    {
+        *--pcEnd = '0' + ui32Value;
+    }
+
+    return(pcEnd);
+}
+
+//*****************************************************************************
+//
+// Converts a value to hexadecimal, storing the digits so that the last one is
+// just before the given end of a buffer.  Returns a pointer to the first
+// digit.
+//
+//*****************************************************************************
+static char *
+HexConvert(uint64_t ui64Value, char *pcEnd)
+{
+    do
+    {
+        *--pcEnd = g_pcHex[ui64Value & 15];
+        ui64Value >>= 4;
+    }
+    while(ui64Value);
+
+    return(pcEnd);
+}
+
+#ifndef USTDLIB_NO_FLOAT
+//*****************************************************************************
+//
+// The powers of ten which fit in 64 bits, and the powers of five which fit
+// in 32 bits.
+//
+//*****************************************************************************
+static const uint64_t g_pui64Pow10[20] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+static const uint32_t g_pui32Pow5[14] =
+{
+    1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+    48828125, 244140625, 1220703125
+};
+
+//*****************************************************************************
+//
+// The largest number of significant digits generated for a floating-point
+// value; any further digits are printed as zeros.  This is the most that
+// fit in 64 bits.
+//
+//*****************************************************************************
+#define FLOAT_DIGITS_MAX        19
+
+//*****************************************************************************
+//
+// The number of 32-bit words in the integers used to scale floating-point
+// values by powers of ten.  The largest is the mantissa of the smallest
+// denormal value multiplied by 5^343, which needs 850 bits.
+//
+//*****************************************************************************
+#define FLOAT_WORDS             28
+
+//*****************************************************************************
+//
+// Splits a non-negative value into an integer mantissa and a power of two.
+// A non-zero mantissa is normalized so that bit 52 is its most significant.
+//
+//*****************************************************************************
+static int32_t
+FloatSplit(double dValue, uint64_t *pui64Mant)
+{
+    union
+    {
+        double d;
+        uint64_t ui64;
+    }
+    uValue;
+    uint64_t ui64Mant;
+    int32_t i32Exp2;
+
+    uValue.d = dValue;
+    ui64Mant = uValue.ui64 & 0x000FFFFFFFFFFFFFULL;
+    i32Exp2 = (int32_t)(uValue.ui64 >> 52);
+    if(i32Exp2)
+    {
+        ui64Mant |= 0x0010000000000000ULL;
+        i32Exp2 -= 1075;
+    }
+    else
+    {
+        //
+        // Normalize the mantissa of a denormal value.
+        //
+        i32Exp2 = -1074;
+        while(ui64Mant && !(ui64Mant & 0x0010000000000000ULL))
+        {
+            ui64Mant <<= 1;
+            i32Exp2--;
+        }
+    }
+
+    *pui64Mant = ui64Mant;
+    return(i32Exp2);
+}
+
+//*****************************************************************************
+//
+// Returns the power of ten of the first digit of a value split by
+// FloatSplit(), or one less.  This is the power of two of the first bit
+// multiplied by log10(2), which is just above 78913 / 2^18, rounded down.
+//
+//*****************************************************************************
+static int32_t
+FloatLog10(int32_t i32Exp2)
+{
+    i32Exp2 += 52;
+    if(i32Exp2 >= 0)
+    {
+        return((i32Exp2 * 78913) >> 18);
+    }
+    return(-(((-i32Exp2 * 78913) + (1 << 18) - 1) >> 18));
+}
+
+//*****************************************************************************
+//
+// Returns the word at the given index of a long integer, or zero if it is
+// beyond the end of the integer.
+//
+//*****************************************************************************
+#define FloatWord(pui32Int, ui32Len, ui32Idx)                                 \
+    (((ui32Idx) < (ui32Len)) ? (pui32Int)[ui32Idx] : 0)
+
+//*****************************************************************************
+//
+// Multiplies a value, given as the mantissa and power of two from
+// FloatSplit(), by a power of ten and rounds it to an integer, with ties
+// rounded to even.  Returns false if the result does not fit in 64 bits.
+//
+// The scaling is exact.  A value is multiplied by 10^p as a long integer
+// multiplied by 5^p, with the power of two folded into the position of the
+// binary point; it is divided by 10^p as a long integer divided by 5^p,
+// with enough bits below the binary point to find the rounding direction.
+// The division is done 5^6 at a time, so that the remainder and the next
+// 16 bits of the integer fit in a 32-bit divide instruction; it is only
+// needed for values of 10^19 and above.
+//
+//*****************************************************************************
+static bool
+FloatScale(uint64_t ui64Mant, int32_t i32Exp2, int32_t i32Pow10,
+           uint64_t *pui64Result)
+{
+    uint32_t pui32Int[FLOAT_WORDS], ui32Len, ui32Idx, ui32Bit, ui32Mult;
+    uint32_t ui32Rem, ui32Part;
+    uint64_t ui64Result;
+    int32_t i32Shift;
+    bool bHalf, bSticky;
+
+    if(i32Pow10 >= 0)
+    {
+        //
+        // Multiply the mantissa by 5^p, 5^13 at a time.  The result is the
+        // integer shifted left by p plus the power of two.
+        //
+        pui32Int[0] = (uint32_t)ui64Mant;
+        pui32Int[1] = (uint32_t)(ui64Mant >> 32);
+        ui32Len = pui32Int[1] ? 2 : (pui32Int[0] ? 1 : 0);
+        i32Shift = i32Pow10 + i32Exp2;
+        for(; i32Pow10 > 0; i32Pow10 -= 13)
+        {
+            ui32Mult = g_pui32Pow5[(i32Pow10 < 13) ? i32Pow10 : 13];
+            for(ui32Idx = 0, ui64Result = 0; ui32Idx < ui32Len; ui32Idx++)
+            {
+                ui64Result += (uint64_t)pui32Int[ui32Idx] * ui32Mult;
+                pui32Int[ui32Idx] = (uint32_t)ui64Result;
+                ui64Result >>= 32;
+            }
+            if(ui64Result)
+            {
+                ASSERT(ui32Len < FLOAT_WORDS);
+                pui32Int[ui32Len++] = (uint32_t)ui64Result;
+            }
+        }
+        bSticky = false;
+    }
+    else
+    {
+        //
+        // Shift the mantissa left by the power of two less p, keeping at
+        // least one bit below the binary point for the rounding.
+        //
+        i32Pow10 = -i32Pow10;
+        i32Shift = i32Exp2 - i32Pow10;
+        i32Shift = (i32Shift >= 0) ? (i32Shift + 1) : 1;
+        ui32Idx = (uint32_t)i32Shift / 32;
+        ui32Bit = (uint32_t)i32Shift % 32;
+        ASSERT(ui32Idx + 3 <= FLOAT_WORDS);
+        for(ui32Len = 0; ui32Len < ui32Idx; ui32Len++)
+        {
+            pui32Int[ui32Len] = 0;
+        }
+        pui32Int[ui32Len++] = (uint32_t)ui64Mant << ui32Bit;
+        pui32Int[ui32Len++] = (uint32_t)((ui64Mant << ui32Bit) >> 32);
+        pui32Int[ui32Len++] = (ui32Bit ?
+                               (uint32_t)(ui64Mant >> (64 - ui32Bit)) : 0);
+        i32Shift = (i32Exp2 - i32Pow10) - i32Shift;
+
+        //
+        // Divide by 5^p, remembering whether there was any remainder.
+        //
+        bSticky = false;
+        for(; i32Pow10 > 0; i32Pow10 -= 6)
+        {
+            ui32Mult = g_pui32Pow5[(i32Pow10 < 6) ? i32Pow10 : 6];
+            for(ui32Idx = ui32Len, ui32Rem = 0; ui32Idx--; )
+            {
+                ui32Part = (ui32Rem << 16) | (pui32Int[ui32Idx] >> 16);
+                ui32Rem = ui32Part % ui32Mult;
+                ui32Bit = (ui32Part / ui32Mult) << 16;
+                ui32Part = (ui32Rem << 16) | (pui32Int[ui32Idx] & 0xFFFF);
+                ui32Rem = ui32Part % ui32Mult;
+                pui32Int[ui32Idx] = ui32Bit | (ui32Part / ui32Mult);
+            }
+            bSticky |= (ui32Rem != 0);
+        }
+    }
+
+    //
+    // Remove the leading zero words.
+    //
+    while(ui32Len && !pui32Int[ui32Len - 1])
+    {
+        ui32Len--;
+    }
+
+    //
+    // When there are no bits below the binary point, the result is the
+    // integer shifted left.
+    //
+    if(i32Shift >= 0)
+    {
+        ui64Result = ((uint64_t)FloatWord(pui32Int, ui32Len, 1) << 32) |
+                     FloatWord(pui32Int, ui32Len, 0);
+        if((ui32Len > 2) || (i32Shift >= 64) ||
+           (i32Shift && (ui64Result >> (64 - i32Shift))))
+        {
+            return(false);
+        }
+        *pui64Result = ui64Result << i32Shift;
+        return(true);
+    }
+
+    //
+    // Otherwise, take the 64 bits above the binary point, failing if there
+    // are any more.
+    //
+    i32Shift = -i32Shift;
+    ui32Idx = (uint32_t)i32Shift / 32;
+    ui32Bit = (uint32_t)i32Shift % 32;
+    ui32Part = FloatWord(pui32Int, ui32Len, ui32Idx + 2);
+    if((ui32Len > (ui32Idx + 3)) ||
+       (ui32Bit ? (ui32Part >> ui32Bit) : ui32Part))
+    {
+        return(false);
+    }
+    ui64Result = (((uint64_t)FloatWord(pui32Int, ui32Len, ui32Idx + 1) << 32) |
+                  FloatWord(pui32Int, ui32Len, ui32Idx));
+    if(ui32Bit)
+    {
+        ui64Result = ((ui64Result >> ui32Bit) |
+                      ((uint64_t)ui32Part << (64 - ui32Bit)));
+    }
+
+    //
+    // Find the first bit below the binary point, and whether any of the
+    // bits (or the remainder of a division) below that are set.
+    //
+    i32Shift--;
+    ui32Idx = (uint32_t)i32Shift / 32;
+    ui32Bit = (uint32_t)i32Shift % 32;
+    ui32Part = FloatWord(pui32Int, ui32Len, ui32Idx);
+    bHalf = (ui32Part >> ui32Bit) & 1;
+    bSticky |= (ui32Part & ((1UL << ui32Bit) - 1)) != 0;
+    while(!bSticky && ui32Idx--)
+    {
+        bSticky = FloatWord(pui32Int, ui32Len, ui32Idx) != 0;
+    }
+
+    //
+    // Round up if above the half-way point, or to even if on it.
+    //
+    if(bHalf && (bSticky || (ui64Result & 1)))
+    {
+        if(++ui64Result == 0)
+        {
+            return(false);
+        }
+    }
+
+    *pui64Result = ui64Result;
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Finds the given number of significant decimal digits (at most
+// FLOAT_DIGITS_MAX) of a positive value split by FloatSplit(), returned as
+// an integer with exactly that many digits.  Returns the power of ten of
+// the first digit.
+//
+//*****************************************************************************
+static int32_t
+FloatDecimal(uint64_t ui64Mant, int32_t i32Exp2, uint32_t ui32Digits,
+             uint64_t *pui64Digits)
+{
+    int32_t i32Exp, i32Loop;
+    uint64_t ui64Digits;
+
+    //
+    // Scale the value to the required number of digits, increasing the
+    // estimated power of ten until the result has no more than that many.
+    // This takes at most three attempts, as the estimate may be one too
+    // small and rounding may then carry into a further digit.
+    //
+    i32Exp = FloatLog10(i32Exp2);
+    for(i32Loop = 0; i32Loop < 3; i32Loop++)
+    {
+        if(FloatScale(ui64Mant, i32Exp2, (int32_t)ui32Digits - 1 - i32Exp,
+                      &ui64Digits) &&
+           (ui64Digits < g_pui64Pow10[ui32Digits]))
+        {
+            break;
+        }
+        i32Exp++;
+    }
+
+    *pui64Digits = ui64Digits;
+    return(i32Exp);
+}
+
+//*****************************************************************************
+//
+// Stores a floating-point value formatted by one of the \%e, \%f, or \%g
+// conversions.
+//
+//*****************************************************************************
+static void
+OutputFloat(tOutput *psOut, double dValue, uint32_t ui32Flags,
+            uint32_t ui32Width, int32_t i32Prec, char cConvert)
+{
+    union
+    {
+        double d;
+        uint64_t ui64;
+    }
+    uValue;
+    char pcBuf[DIGITS_MAX], *pcDigits, *pcPrefix, cExpSign;
+    int32_t i32Len, i32Exp, i32Exp2, i32Frac, i32Count;
+    uint64_t ui64Digits, ui64Mant;
+    uint32_t ui32Pad;
+    bool bExp;
+
+    //
+    // Choose the sign prefix, and work with the magnitude from here on.  The
+    // sign is taken from the sign bit so that -0.0 is printed as such.
+    //
+    uValue.d = dValue;
+    if(uValue.ui64 >> 63)
+    {
+        pcPrefix = "-";
+        dValue = -dValue;
+    }
+    else
+    {
+        pcPrefix = ((ui32Flags & FLAG_PLUS) ? "+" :
+                    ((ui32Flags & FLAG_SPACE) ? " " : ""));
+    }
+
+    //
+    // Handle infinities and NaNs, which are never zero padded.
+    //
+    if(((uValue.ui64 >> 52) & 0x7FF) == 0x7FF)
+    {
+        if(uValue.ui64 & 0x000FFFFFFFFFFFFFULL)
+        {
+            pcDigits = (ui32Flags & FLAG_UPPER) ? "NAN" : "nan";
+        }
+        else
+        {
+            pcDigits = (ui32Flags & FLAG_UPPER) ? "INF" : "inf";
+        }
+        ui32Pad = OutputFieldStart(psOut, ui32Flags & ~FLAG_ZERO, ui32Width,
+                                   pcPrefix, 3);
+        OutputChars(psOut, pcDigits, 3);
+        OutputFieldEnd(psOut, ui32Pad);
+        return;
+    }
+
+    //
+    // The default precision is six.
+    //
+    if(i32Prec < 0)
+    {
+        i32Prec = 6;
+    }
+
+    //
+    // Find the digits to be printed, and the power of ten of the first.
+    //
+    i32Exp2 = FloatSplit(dValue, &ui64Mant);
+    if(cConvert == 'f')
+    {
+        //
+        // Round the value to the precision directly if it fits in 64 bits,
+        // otherwise take as many significant digits as are available.
+        //
+        if(((FloatLog10(i32Exp2) + i32Prec) < FLOAT_DIGITS_MAX) &&
+           FloatScale(ui64Mant, i32Exp2, i32Prec, &ui64Digits))
+        {
+            pcDigits = DecimalConvert(ui64Digits, pcBuf + DIGITS_MAX);
+            i32Len = (pcBuf + DIGITS_MAX) - pcDigits;
+            i32Exp = i32Len - 1 - i32Prec;
+        }
+        else
+        {
+            i32Exp = FloatDecimal(ui64Mant, i32Exp2, FLOAT_DIGITS_MAX,
+                                  &ui64Digits);
+            pcDigits = DecimalConvert(ui64Digits, pcBuf + DIGITS_MAX);
+            i32Len = FLOAT_DIGITS_MAX;
+        }
+        bExp = false;
+        i32Frac = i32Prec;
+    }
+    else
+    {
+        //
+        // The precision of \%e is the number of digits after the first, and
+        // that of \%g is the number of significant digits.
+        //
+        if(cConvert == 'e')
+        {
+            i32Count = i32Prec + 1;
+        }
+        else
+        {
+            i32Count = i32Prec ? i32Prec : 1;
+        }
+        i32Len = ((i32Count < FLOAT_DIGITS_MAX) ? i32Count :
+                  FLOAT_DIGITS_MAX);
+        if(ui64Mant == 0)
+        {
+            ui64Digits = 0;
+            i32Len = 1;
+            i32Exp = 0;
+        }
+        else
+        {
+            i32Exp = FloatDecimal(ui64Mant, i32Exp2, i32Len, &ui64Digits);
+        }
+        pcDigits = DecimalConvert(ui64Digits, pcBuf + DIGITS_MAX);
+
+        //
+        // \%g uses the style of \%e for very large and small exponents, and
+        // that of \%f otherwise.  Unless the alternate form is requested,
+        // trailing zeros are removed.
+        //
+        if(cConvert == 'e')
+        {
+            bExp = true;
+            i32Frac = i32Prec;
+        }
+        else
+        {
+            bExp = (i32Exp < -4) || (i32Exp >= i32Count);
+            if(ui32Flags & FLAG_ALT)
+            {
+                i32Frac = bExp ? (i32Count - 1) : (i32Count - 1 - i32Exp);
+            }
+            else
+            {
+                while((i32Len > 1) && (pcDigits[i32Len - 1] == '0'))
+                {
+                    i32Len--;
+                }
+                i32Frac = bExp ? (i32Len - 1) : (i32Len - 1 - i32Exp);
+                if(i32Frac < 0)
+                {
+                    i32Frac = 0;
+                }
+            }
+        }
+    }
+
+    //
+    // Find the length of the field.
+    //
+    i32Count = i32Frac + (((i32Frac != 0) || (ui32Flags & FLAG_ALT)) ? 1 : 0);
+    if(bExp)
+    {
+        //
+        // The exponent has a sign and at least two digits.
+        //
+        cExpSign = (i32Exp < 0) ? '-' : '+';
+        if(i32Exp < 0)
+        {
+            i32Exp = -i32Exp;
+        }
+        i32Count += 3 + ((i32Exp >= 100) ? 3 : 2);
+    }
+    else
+    {
+        i32Count += (i32Exp >= 0) ? (i32Exp + 1) : 1;
+    }
+
+    //
+    // Store the field.
+    //
+    ui32Pad = OutputFieldStart(psOut, ui32Flags, ui32Width, pcPrefix,
+                               i32Count);
+    if(bExp)
+    {
+        OutputDigits(psOut, pcDigits, i32Len, 0, 1);
+        if((i32Frac != 0) || (ui32Flags & FLAG_ALT))
+        {
+            OutputChars(psOut, ".", 1);
+        }
+        OutputDigits(psOut, pcDigits, i32Len, 1, i32Frac);
+        OutputChars(psOut, (ui32Flags & FLAG_UPPER) ? "E" : "e", 1);
+        OutputChars(psOut, &cExpSign, 1);
+        pcDigits = DecimalConvert(i32Exp, pcBuf + DIGITS_MAX);
+        if(i32Exp < 10)
+        {
+            *--pcDigits = '0';
+        }
+        OutputChars(psOut, pcDigits, (pcBuf + DIGITS_MAX) - pcDigits);
+    }
+    else
+    {
+        if(i32Exp >= 0)
+        {
+            OutputDigits(psOut, pcDigits, i32Len, 0, i32Exp + 1);
+        }
+        else
+        {
+            OutputChars(psOut, "0", 1);
+        }
+        if((i32Frac != 0) || (ui32Flags & FLAG_ALT))
+        {
+            OutputChars(psOut, ".", 1);
+        }
+        OutputDigits(psOut, pcDigits, i32Len, i32Exp + 1, i32Frac);
+    }
+    OutputFieldEnd(psOut, ui32Pad);
+}
+#endif
+
+//*****************************************************************************
+//
+//! A vsnprintf function supporting the common integer, string, and
+//! floating-point conversions.
 //!
 //! \param s points to the buffer where the converted string is stored.
 //! \param n is the size of the buffer.
@@ -115,7 +959,7 @@ ustrncpy(char * restrict s1, const char * restrict s2, size_t n)
 //! contents of the format string.
 //!
 //! This function is very similar to the C library <tt>vsnprintf()</tt>
-//! function.  Only the following formatting characters are supported:
+//! function.  The following formatting characters are supported:
 //!
 //! - \%c to print a character
 //! - \%d or \%i to print a decimal value
@@ -125,15 +969,50 @@ ustrncpy(char * restrict s1, const char * restrict s2, size_t n)
 //! - \%X to print a hexadecimal value using lower case letters (not upper case
 //! letters as would typically be used)
 //! - \%p to print a pointer as a hexadecimal value
+//! - \%f or \%F to print a floating-point value in fixed-point notation
+//! - \%e or \%E to print a floating-point value in exponential notation
+//! - \%g or \%G to print a floating-point value in whichever of those
+//! notations is more compact, without trailing zeros
 //! - \%\% to print out a \% character
 //!
-//! For \%d, \%i, \%p, \%s, \%u, \%x, and \%X, an optional number may reside
-//! between the \% and the format character, which specifies the minimum number
-//! of characters to use for that value; if preceded by a 0 then the extra
-//! characters will be filled with zeros instead of spaces.  For example,
-//! ``\%8d'' will use eight characters to print the decimal value with spaces
-//! added to reach eight; ``\%08d'' will use eight characters as well but will
-//! add zeroes instead of spaces.
+//! Each conversion may be modified by, in order:
+//!
+//! - Any of the flags \b - (left justify the value in its field), \b + (print
+//! a plus sign before positive values), space (print a space before positive
+//! values), \b # (print the decimal point of a floating-point value even if
+//! no digits follow it, keep trailing zeros with \%g, and print 0x before a
+//! non-zero hexadecimal value), and \b 0 (pad the field with zeros instead of
+//! spaces).
+//! - The minimum number of characters to use for the value, either as a
+//! number or as \b * to take it from the next argument.
+//! - A precision, as \b . followed by a number or by \b * to take it from the
+//! next argument.  This is the minimum number of digits of an integer, the
+//! number of digits after the decimal point for \%e and \%f (six if it is not
+//! given), the number of significant digits for \%g, and the maximum number
+//! of characters to print from a string.
+//! - \b l for a \e long argument or \b ll for a <tt>long long</tt> (64-bit)
+//! argument to the integer conversions.
+//!
+//! For example, ``\%8d'' will use eight characters to print the decimal value
+//! with spaces added to reach eight; ``\%08d'' will use eight characters as
+//! well but will add zeroes instead of spaces; ``\%-+8.2f'' will print a
+//! floating-point value with a sign and two decimal places, followed by
+//! spaces to reach eight characters; and ``\%.*s'' will print no more than
+//! the number of characters given by the argument before the string.
+//!
+//! As in earlier versions of this function, a string which is shorter than
+//! its field is always followed by the padding, as if the \b - flag was
+//! given.
+//!
+//! Floating-point values are converted exactly, with correct rounding, to up
+//! to 19 significant digits and any further digits are printed as zeros, so
+//! very long conversions differ from those of the C library in their final
+//! digits.  The digits of all values are generated without divide
+//! instructions or library calls, other than the scaling of floating-point
+//! values of 10^19 and above; the floating-point conversions may be removed,
+//! to avoid linking the double-precision floating-point library, by defining
+//! \b USTDLIB_NO_FLOAT when building this file, in which case they print
+//! ``ERROR''.
 //!
 //! The type of the arguments after \e format must match the requirements of
 //! the format string.  For example, if an integer was passed where a string
@@ -158,9 +1037,11 @@ int
 uvsnprintf(char * restrict s, size_t n, const char * restrict format,
            va_list arg)
 {
-    unsigned long ulIdx, ulValue, ulCount, ulBase, ulNeg;
-    char *pcStr, cFill;
-    int iConvertCount = 0;
+    uint32_t ui32Idx, ui32Flags, ui32Width, ui32Length, ui32Pad;
+    int32_t i32Prec, i32Value;
+    uint64_t ui64Value;
+    char pcBuf[DIGITS_MAX], *pcStr, *pcPrefix;
+    tOutput sOut;
 
     //
     // Check the arguments.
@@ -178,9 +1059,11 @@ uvsnprintf(char * restrict s, size_t n, const char * restrict format,
     }
 
     //
-    // Initialize the count of characters converted.
+    // Initialize the output buffer and the count of characters converted.
     //
-    iConvertCount = 0;
+    sOut.pcBuf = s;
+    sOut.n = n;
+    sOut.iCount = 0;
 
     //
     // Loop while there are more characters in the format string.
@@ -190,487 +1073,412 @@ uvsnprintf(char * restrict s, size_t n, const char * restrict format,
         //
         // Find the first non-% character, or the end of the string.
         //
-        for(ulIdx = 0; (format[ulIdx] != '%') && (format[ulIdx] != '\0');
-            ulIdx++)
+        for(ui32Idx = 0; (format[ui32Idx] != '%') && (format[ui32Idx] != '\0');
+            ui32Idx++)
+        {
+        }
+
+        //
+        // Write this portion of the string to the output buffer, as much of it
+        // as will fit, and skip it in the format string.
+        //
+        OutputChars(&sOut, format, ui32Idx);
+        format += ui32Idx;
+
+        //
+        // Nothing more needs to be done unless the next character is a %.
+        //
+        if(*format != '%')
+        {
+            continue;
+        }
+
+        //
+        // Skip the %.
+        //
+        format++;
+
+        //
+        // Read the flags.
+        //
+        for(ui32Flags = 0; ; format++)
+        {
+            if(*format == '-')
+            {
+                ui32Flags |= FLAG_LEFT;
+            }
+            else if(*format == '+')
+            {
+                ui32Flags |= FLAG_PLUS;
+            }
+            else if(*format == ' ')
+            {
+                ui32Flags |= FLAG_SPACE;
+            }
+            else if(*format == '#')
+            {
+                ui32Flags |= FLAG_ALT;
+            }
+            else if(*format == '0')
+            {
+                ui32Flags |= FLAG_ZERO;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        //
+        // Read the field width, either from the format string or from the
+        // arguments.  A negative width from the arguments left justifies the
+        // value.
+        //
+        if(*format == '*')
+        {
+            i32Value = va_arg(arg, int);
+            if(i32Value < 0)
+            {
+                ui32Flags |= FLAG_LEFT;
+                i32Value = -i32Value;
+            }
+            ui32Width = i32Value;
+            format++;
+        }
+        else
         {
+            for(ui32Width = 0; (*format >= '0') && (*format <= '9'); format++)
+            {
+                ui32Width = (ui32Width * 10) + (*format - '0');
+            }
         }
 
         //
-        // Write this portion of the string to the output buffer.  If there are
-        // more characters to write than there is space in the buffer, then
-        // only write as much as will fit in the buffer.
+        // Read the precision, if there is one.  A negative precision from the
+        // arguments is ignored.
         //
-        if(ulIdx > n)
-        {
-            ustrncpy(s, format, n);
-            s += n;
-            n = 0;
-        }
-        else
+        i32Prec = -1;
+        if(*format == '.')
         {
-            ustrncpy(s, format, ulIdx);
-            s += ulIdx;
-            n -= ulIdx;
+            format++;
+            if(*format == '*')
+            {
+                i32Prec = va_arg(arg, int);
+                format++;
+            }
+            else
+            {
+                for(i32Prec = 0; (*format >= '0') && (*format <= '9');
+                    format++)
+                {
+                    i32Prec = (i32Prec * 10) + (*format - '0');
+                }
+            }
         }
 
         //
-        // Update the conversion count.  This will be the number of characters
-        // that should have been written, even if there was not room in the
-        // buffer.
+        // Read the length modifier, counting the number of l characters.
         //
-        iConvertCount += ulIdx;
+        for(ui32Length = 0; *format == 'l'; format++)
+        {
+            ui32Length++;
+        }
 
         //
-        // Skip the portion of the format string that was written.
+        // Stop if the format string ends before the conversion character.
         //
-        format += ulIdx;
+        if(*format == '\0')
+        {
+            break;
+        }
 
         //
-        // See if the next character is a %.
+        // Determine how to handle the conversion character.
         //
-        if(*format == '%')
+        switch(*format++)
         {
             //
-            // Skip the %.
-            //
-            format++;
-
-            //
-            // Set the digit count to zero, and the fill character to space
-            // (that is, to the defaults).
+            // Handle the %c command.
             //
-            ulCount = 0;
-            cFill = ' ';
+            case 'c':
+            {
+                //
+                // Get the character from the varargs and store it in its
+                // field.
+                //
+                pcBuf[0] = (char)va_arg(arg, int);
+                ui32Pad = OutputFieldStart(&sOut, ui32Flags & ~FLAG_ZERO,
+                                           ui32Width, "", 1);
+                OutputChars(&sOut, pcBuf, 1);
+                OutputFieldEnd(&sOut, ui32Pad);
 
-            //
-            // It may be necessary to get back here to process more characters.
-            // Goto's aren't pretty, but effective.  I feel extremely dirty for
-            // using not one but two of the beasts.
-            //
-again:
+                //
+                // This command has been handled.
+                //
+                break;
+            }
 
             //
-            // Determine how to handle the next character.
+            // Handle the %d and %i commands.
             //
-            switch(*format++)
+            case 'd':
+            case 'i':
             {
                 //
-                // Handle the digit characters.
+                // Get the value from the varargs, with the size given by the
+                // length modifier.
                 //
-                case '0':
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9':
+                if(ui32Length >= 2)
                 {
-                    //
-                    // If this is a zero, and it is the first digit, then the
-                    // fill character is a zero instead of a space.
-                    //
-                    if((format[-1] == '0') && (ulCount == 0))
-                    {
-                        cFill = '0';
-                    }
-
-                    //
-                    // Update the digit count.
-                    //
-                    ulCount *= 10;
-                    ulCount += format[-1] - '0';
-
-                    //
-                    // Get the next character.
-                    //
-                    goto again;
+                    ui64Value = (uint64_t)va_arg(arg, long long);
+                }
+                else if(ui32Length == 1)
+                {
+                    ui64Value = (uint64_t)(long long)va_arg(arg, long);
+                }
+                else
+                {
+                    ui64Value = (uint64_t)(long long)va_arg(arg, int);
                 }
 
                 //
-                // Handle the %c command.
+                // If the value is negative, make it positive and indicate
+                // that a minus sign is needed.
                 //
-                case 'c':
+                if((long long)ui64Value < 0)
                 {
-                    //
-                    // Get the value from the varargs.
-                    //
-                    ulValue = va_arg(arg, unsigned long);
-
-                    //
-                    // Copy the character to the output buffer, if there is
-                    // room.  Update the buffer size remaining.
-                    //
-                    if(n != 0)
-                    {
-                        *s++ = (char)ulValue;
-                        n--;
-                    }
-
-                    //
-                    // Update the conversion count.
-                    //
-                    iConvertCount++;
-
-                    //
-                    // This command has been handled.
-                    //
-                    break;
+                    ui64Value = -ui64Value;
+                    pcPrefix = "-";
+                }
+                else
+                {
+                    pcPrefix = ((ui32Flags & FLAG_PLUS) ? "+" :
+                                ((ui32Flags & FLAG_SPACE) ? " " : ""));
                 }
 
                 //
-                // Handle the %d and %i commands.
+                // Convert the value to decimal.
                 //
-                case 'd':
-                case 'i':
-                {
-                    //
-                    // Get the value from the varargs.
-                    //
-                    ulValue = va_arg(arg, unsigned long);
-
-                    //
-                    // If the value is negative, make it positive and indicate
-                    // that a minus sign is needed.
-                    //
-                    if((long)ulValue < 0)
-                    {
-                        //
-                        // Make the value positive.
-                        //
-                        ulValue = -(long)ulValue;
-
-                        //
-                        // Indicate that the value is negative.
-                        //
-                        ulNeg = 1;
-                    }
-                    else
-                    {
-                        //
-                        // Indicate that the value is positive so that a
-                        // negative sign isn't inserted.
-                        //
-                        ulNeg = 0;
-                    }
-
-                    //
-                    // Set the base to 10.
-                    //
-                    ulBase = 10;
+                pcStr = DecimalConvert(ui64Value, pcBuf + DIGITS_MAX);
+                goto convert;
+            }
 
-                    //
-                    // Convert the value to ASCII.
-                    //
-                    goto convert;
-                }
+            //
+            // Handle the %s command.
+            //
+            case 's':
+            {
+                //
+                // Get the string pointer from the varargs.
+                //
+                pcStr = va_arg(arg, char *);
 
                 //
-                // Handle the %s command.
+                // Determine the length of the string, up to the precision if
+                // one was given.
                 //
-                case 's':
+                for(ui32Idx = 0;
+                    (((i32Prec < 0) || (ui32Idx < (uint32_t)i32Prec)) &&
+                     (pcStr[ui32Idx] != '\0'));
+                    ui32Idx++)
                 {
-                    //
-                    // Get the string pointer from the varargs.
-                    //
-                    pcStr = va_arg(arg, char *);
-
-                    //
-                    // Determine the length of the string.
-                    //
-                    for(ulIdx = 0; pcStr[ulIdx] != '\0'; ulIdx++)
-                    {
-                    }
-
-                    //
-                    // Update the convert count to include any padding that
-                    // should be necessary (regardless of whether we have space
-                    // to write it or not).
-                    //
-                    if(ulCount > ulIdx)
-                    {
-                        iConvertCount += (ulCount - ulIdx);
-                    }
-
-                    //
-                    // Copy the string to the output buffer.  Only copy as much
-                    // as will fit in the buffer.  Update the output buffer
-                    // pointer and the space remaining.
-                    //
-                    if(ulIdx > n)
-                    {
-                        ustrncpy(s, pcStr, n);
-                        s += n;
-                        n = 0;
-                    }
-                    else
-                    {
-                        ustrncpy(s, pcStr, ulIdx);
-                        s += ulIdx;
-                        n -= ulIdx;
-
-                        //
-                        // Write any required padding spaces assuming there is
-                        // still space in the buffer.
-                        //
-                        if(ulCount > ulIdx)
-                        {
-                            ulCount -= ulIdx;
-                            if(ulCount > n)
-                            {
-                                ulCount = n;
-                            }
-                            n = -ulCount;
-
-                            while(ulCount--)
-                            {
-                                *s++ = ' ';
-                            }
-                        }
-                    }
-
-                    //
-                    // Update the conversion count.  This will be the number of
-                    // characters that should have been written, even if there
-                    // was not room in the buffer.
-                    //
-                    iConvertCount += ulIdx;
-
-                    //
-                    // This command has been handled.
-                    //
-                    break;
                 }
 
                 //
-                // Handle the %u command.
+                // Store the string, followed by any padding that is needed.
                 //
-                case 'u':
-                {
-                    //
-                    // Get the value from the varargs.
-                    //
-                    ulValue = va_arg(arg, unsigned long);
-
-                    //
-                    // Set the base to 10.
-                    //
-                    ulBase = 10;
+                ui32Pad = OutputFieldStart(&sOut, ui32Flags | FLAG_LEFT,
+                                           ui32Width, "", ui32Idx);
+                OutputChars(&sOut, pcStr, ui32Idx);
+                OutputFieldEnd(&sOut, ui32Pad);
 
-                    //
-                    // Indicate that the value is positive so that a minus sign
-                    // isn't inserted.
-                    //
-                    ulNeg = 0;
+                //
+                // This command has been handled.
+                //
+                break;
+            }
 
-                    //
-                    // Convert the value to ASCII.
-                    //
-                    goto convert;
+            //
+            // Handle the %u command.
+            //
+            case 'u':
+            {
+                //
+                // Get the value from the varargs, with the size given by the
+                // length modifier.
+                //
+                if(ui32Length >= 2)
+                {
+                    ui64Value = va_arg(arg, unsigned long long);
+                }
+                else if(ui32Length == 1)
+                {
+                    ui64Value = va_arg(arg, unsigned long);
+                }
+                else
+                {
+                    ui64Value = va_arg(arg, unsigned int);
                 }
 
                 //
-                // Handle the %x and %X commands.  Note that they are treated
-                // identically; that is, %X will use lower case letters for a-f
-                // instead of the upper case letters is should use.  We also
-                // alias %p to %x.
+                // Convert the value to decimal, without a sign.
                 //
-                case 'x':
-                case 'X':
-                case 'p':
-                {
-                    //
-                    // Get the value from the varargs.
-                    //
-                    ulValue = va_arg(arg, unsigned long);
+                pcStr = DecimalConvert(ui64Value, pcBuf + DIGITS_MAX);
+                pcPrefix = "";
+                goto convert;
+            }
 
-                    //
-                    // Set the base to 16.
-                    //
-                    ulBase = 16;
+            //
+            // Handle the %x and %X commands.  Note that they are treated
+            // identically; that is, %X will use lower case letters for a-f
+            // instead of the upper case letters is should use.  We also
+            // alias %p to %x.
+            //
+            case 'x':
+            case 'X':
+            case 'p':
+            {
+                //
+                // Get the value from the varargs, with the size given by the
+                // length modifier (a pointer is the size of a long).
+                //
+                if(format[-1] == 'p')
+                {
+                    ui64Value = (uintptr_t)va_arg(arg, void *);
+                }
+                else if(ui32Length >= 2)
+                {
+                    ui64Value = va_arg(arg, unsigned long long);
+                }
+                else if(ui32Length == 1)
+                {
+                    ui64Value = va_arg(arg, unsigned long);
+                }
+                else
+                {
+                    ui64Value = va_arg(arg, unsigned int);
+                }
 
-                    //
-                    // Indicate that the value is positive so that a minus sign
-                    // isn't inserted.
-                    //
-                    ulNeg = 0;
+                //
+                // Convert the value to hexadecimal, with a radix prefix if
+                // the alternate form was requested.
+                //
+                pcStr = HexConvert(ui64Value, pcBuf + DIGITS_MAX);
+                pcPrefix = ((ui32Flags & FLAG_ALT) && ui64Value) ? "0x" : "";
 
-                    //
-                    // Determine the number of digits in the string version of
-                    // the value.
-                    //
+                //
+                // Store the digits of the value, with zeros added to reach the
+                // precision and padding added to reach the width.
+                //
 convert:
-                    for(ulIdx = 1;
-                        (((ulIdx * ulBase) <= ulValue) &&
-                         (((ulIdx * ulBase) / ulBase) == ulIdx));
-                        ulIdx *= ulBase, ulCount--)
-                    {
-                    }
-
-                    //
-                    // If the value is negative, reduce the count of padding
-                    // characters needed.
-                    //
-                    if(ulNeg)
-                    {
-                        ulCount--;
-                    }
-
-                    //
-                    // If the value is negative and the value is padded with
-                    // zeros, then place the minus sign before the padding.
-                    //
-                    if(ulNeg && (n != 0) && (cFill == '0'))
-                    {
-                        //
-                        // Place the minus sign in the output buffer.
-                        //
-                        *s++ = '-';
-                        n--;
-
-                        //
-                        // Update the conversion count.
-                        //
-                        iConvertCount++;
-
-                        //
-                        // The minus sign has been placed, so turn off the
-                        // negative flag.
-                        //
-                        ulNeg = 0;
-                    }
-
-                    //
-                    // See if there are more characters in the specified field
-                    // width than there are in the conversion of this value.
-                    //
-                    if((ulCount > 1) && (ulCount < 65536))
-                    {
-                        //
-                        // Loop through the required padding characters.
-                        //
-                        for(ulCount--; ulCount; ulCount--)
-                        {
-                            //
-                            // Copy the character to the output buffer if there
-                            // is room.
-                            //
-                            if(n != 0)
-                            {
-                                *s++ = cFill;
-                                n--;
-                            }
-
-                            //
-                            // Update the conversion count.
-                            //
-                            iConvertCount++;
-                        }
-                    }
-
+                ui32Idx = (pcBuf + DIGITS_MAX) - pcStr;
+                if(i32Prec >= 0)
+                {
                     //
-                    // If the value is negative, then place the minus sign
-                    // before the number.
+                    // The zero flag is ignored when there is a precision, and
+                    // a zero value has no digits when the precision is zero.
                     //
-                    if(ulNeg && (n != 0))
+                    ui32Flags &= ~FLAG_ZERO;
+                    if((i32Prec == 0) && (ui64Value == 0))
                     {
-                        //
-                        // Place the minus sign in the output buffer.
-                        //
-                        *s++ = '-';
-                        n--;
-
-                        //
-                        // Update the conversion count.
-                        //
-                        iConvertCount++;
+                        ui32Idx = 0;
                     }
+                    i32Prec = (i32Prec > (int32_t)ui32Idx) ?
+                              (i32Prec - ui32Idx) : 0;
+                }
+                else
+                {
+                    i32Prec = 0;
+                }
+                ui32Pad = OutputFieldStart(&sOut, ui32Flags, ui32Width,
+                                           pcPrefix, i32Prec + ui32Idx);
+                OutputFill(&sOut, '0', i32Prec);
+                OutputChars(&sOut, pcStr, ui32Idx);
+                OutputFieldEnd(&sOut, ui32Pad);
 
-                    //
-                    // Convert the value into a string.
-                    //
-                    for(; ulIdx; ulIdx /= ulBase)
-                    {
-                        //
-                        // Copy the character to the output buffer if there is
-                        // room.
-                        //
-                        if(n != 0)
-                        {
-                            *s++ = g_pcHex[(ulValue / ulIdx) % ulBase];
-                            n--;
-                        }
-
-                        //
-                        // Update the conversion count.
-                        //
-                        iConvertCount++;
-                    }
+                //
+                // This command has been handled.
+                //
+                break;
+            }
 
-                    //
-                    // This command has been handled.
-                    //
-                    break;
+#ifndef USTDLIB_NO_FLOAT
+            //
+            // Handle the floating-point commands.
+            //
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            {
+                //
+                // The upper case commands print the exponent character and
+                // the names of infinity and NaN in upper case.
+                //
+                if(format[-1] < 'a')
+                {
+                    ui32Flags |= FLAG_UPPER;
                 }
 
                 //
-                // Handle the %% command.
+                // Get the value from the varargs, where it has been promoted
+                // to a double, and store it in its field.
                 //
-                case '%':
-                {
-                    //
-                    // Simply write a single %.
-                    //
-                    if(n != 0)
-                    {
-                        *s++ = format[-1];
-                        n--;
-                    }
+                OutputFloat(&sOut, va_arg(arg, double), ui32Flags, ui32Width,
+                            i32Prec, format[-1] | 0x20);
 
-                    //
-                    // Update the conversion count.
-                    //
-                    iConvertCount++;
+                //
+                // This command has been handled.
+                //
+                break;
+            }
+#endif
 
-                    //
-                    // This command has been handled.
-                    //
-                    break;
-                }
+            //
+            // Handle the %% command.
+            //
+            case '%':
+            {
+                //
+                // Simply write a single %.
+                //
+                OutputChars(&sOut, "%", 1);
+
+                //
+                // This command has been handled.
+                //
+                break;
+            }
 
+            //
+            // Handle all other commands.
+            //
+            default:
+            {
+#ifdef USTDLIB_NO_FLOAT
                 //
-                // Handle all other commands.
+                // Skip the value of a floating-point command, so that the
+                // arguments which follow are still printed correctly.
                 //
-                default:
+                if(((format[-1] | 0x20) == 'e') ||
+                   ((format[-1] | 0x20) == 'f') ||
+                   ((format[-1] | 0x20) == 'g'))
                 {
-                    //
-                    // Indicate an error.
-                    //
-                    if(n >= 5)
-                    {
-                        ustrncpy(s, "ERROR", 5);
-                        s += 5;
-                        n -= 5;
-                    }
-                    else
-                    {
-                        ustrncpy(s, "ERROR", n);
-                        s += n;
-                        n = 0;
-                    }
+                    va_arg(arg, double);
+                }
+#endif
 
-                    //
-                    // Update the conversion count.
-                    //
-                    iConvertCount += 5;
+                //
+                // Indicate an error.
+                //
+                OutputChars(&sOut, "ERROR", 5);
 
-                    //
-                    // This command has been handled.
-                    //
-                    break;
-                }
+                //
+                // This command has been handled.
+                //
+                break;
             }
         }
     }
@@ -678,17 +1486,18 @@ convert:
     //
     // Null terminate the string in the buffer.
     //
-    *s = 0;
+    *sOut.pcBuf = 0;
 
     //
     // Return the number of characters in the full converted string.
     //
-    return(iConvertCount);
+    return(sOut.iCount);
 }
 
 //*****************************************************************************
 //
-//! A simple sprintf function supporting \%c, \%d, \%p, \%s, \%u, \%x, and \%X.
+//! A sprintf function supporting the common integer, string, and
+//! floating-point conversions.
 //!
 //! \param s is the buffer where the converted string is stored.
 //! \param format is the format string.
@@ -696,25 +1505,8 @@ convert:
 //! format string.
 //!
 //! This function is very similar to the C library <tt>sprintf()</tt> function.
-//! Only the following formatting characters are supported:
-//!
-//! - \%c to print a character
-//! - \%d or \%i to print a decimal value
-//! - \%s to print a string
-//! - \%u to print an unsigned decimal value
-//! - \%x to print a hexadecimal value using lower case letters
-//! - \%X to print a hexadecimal value using lower case letters (not upper case
-//! letters as would typically be used)
-//! - \%p to print a pointer as a hexadecimal value
-//! - \%\% to print out a \% character
-//!
-//! For \%d, \%i, \%p, \%s, \%u, \%x, and \%X, an optional number may reside
-//! between the \% and the format character, which specifies the minimum number
-//! of characters to use for that value; if preceded by a 0 then the extra
-//! characters will be filled with zeros instead of spaces.  For example,
-//! ``\%8d'' will use eight characters to print the decimal value with spaces
-//! added to reach eight; ``\%08d'' will use eight characters as well but will
-//! add zeros instead of spaces.
+//! The formatting characters, flags, field widths, precisions, and length
+//! modifiers supported are those described for uvsnprintf().
 //!
 //! The type of the arguments after \e format must match the requirements of
 //! the format string.  For example, if an integer was passed where a string
@@ -757,8 +1549,8 @@ usprintf(char * restrict s, const char *format, ...)
 
 //*****************************************************************************
 //
-//! A simple snprintf function supporting \%c, \%d, \%p, \%s, \%u, \%x, and
-//! \%X.
+//! A snprintf function supporting the common integer, string, and
+//! floating-point conversions.
 //!
 //! \param s is the buffer where the converted string is stored.
 //! \param n is the size of the buffer.
@@ -767,25 +1559,8 @@ usprintf(char * restrict s, const char *format, ...)
 //! format string.
 //!
 //! This function is very similar to the C library <tt>sprintf()</tt> function.
-//! Only the following formatting characters are supported:
-//!
-//! - \%c to print a character
-//! - \%d or \%i to print a decimal value
-//! - \%s to print a string
-//! - \%u to print an unsigned decimal value
-//! - \%x to print a hexadecimal value using lower case letters
-//! - \%X to print a hexadecimal value using lower case letters (not upper case
-//! letters as would typically be used)
-//! - \%p to print a pointer as a hexadecimal value
-//! - \%\% to print out a \% character
-//!
-//! For \%d, \%i, \%p, \%s, \%u, \%x, and \%X, an optional number may reside
-//! between the \% and the format character, which specifies the minimum number
-//! of characters to use for that value; if preceded by a 0 then the extra
-//! characters will be filled with zeros instead of spaces.  For example,
-//! ``\%8d'' will use eight characters to print the decimal value with spaces
-//! added to reach eight; ``\%08d'' will use eight characters as well but will
-//! add zeros instead of spaces.
+//! The formatting characters, flags, field widths, precisions, and length
+//! modifiers supported are those described for uvsnprintf().
 //!
 //! The type of the arguments after \e format must match the requirements of
 //! the format string.  For example, if an integer was passed where a string